@@ -0,0 +1,59 @@
+/**
+ * @file    BackpressurePolicy.h
+ * @author  Longwei Lai<lailongwei@126.com>
+ * @date    2026/10/18
+ * @version 1.0
+ *
+ * @brief
+ */
+#ifndef __LLBC_COMM_BACKPRESSURE_POLICY_H__
+#define __LLBC_COMM_BACKPRESSURE_POLICY_H__
+
+#include "llbc/common/Common.h"
+#include "llbc/core/Core.h"
+
+__LLBC_NS_BEGIN
+
+/**
+ * \brief The session send backpressure policy enumerations.
+ *        The policy applied to the packets sent to backpressured session(send queue
+ *        exceed high water mark, and not yet drain to low water mark).
+ */
+class LLBC_EXPORT LLBC_BackpressurePolicy
+{
+public:
+    enum
+    {
+        Begin,
+
+        // Still queue packet, only signal facades.
+        None = Begin,
+        // Drop packet.
+        Drop,
+        // Keep the latest packet per opcode, the kept packets will be sent when session leave backpressure state.
+        Coalesce,
+        // Disconnect session.
+        Disconnect,
+
+        End
+    };
+
+public:
+    /**
+     * Check given backpressure policy legal or not.
+     * @param[in] policy - the backpressure policy.
+     * @return bool - return true if validate, otherwise return false.
+     */
+    static bool IsValid(int policy);
+
+    /**
+     * Get the backpressure policy string representation.
+     * @param[in] policy - the backpressure policy.
+     * @return const LLBC_String & - the backpressure policy string representation.
+     */
+    static const LLBC_String &Policy2Str(int policy);
+};
+
+__LLBC_NS_END
+
+#endif // !__LLBC_COMM_BACKPRESSURE_POLICY_H__
@@ -15,6 +15,11 @@
 
 #include "llbc/comm/PollerEvent.h"
 #include "llbc/comm/AsyncConnInfo.h"
+#include "llbc/comm/SessionTable.h"
+#include "llbc/comm/RecvSlab.h"
+#include "llbc/comm/SendStat.h"
+#include "llbc/comm/RecvStat.h"
+#include "llbc/comm/ReliableUdpOptions.h"
 
 __LLBC_NS_BEGIN
 
@@ -37,10 +42,6 @@ class LLBC_HIDDEN LLBC_BasePoller : public LLBC_BaseTask
 {
     typedef LLBC_BasePoller This;
 
-public:
-    // Public Task::Push method, hide other Task methods.
-    using LLBC_BaseTask::Push;
-
 public:
     /**
      * Constructor & Destructor.
@@ -81,6 +82,38 @@ public:
      */
     void SetPollerMgr(LLBC_PollerMgr *mgr);
 
+    /**
+     * Set recv budget of one session readable event, must call before poller start.
+     * @param[in] budget - the recv budget(in bytes), 0 means unlimited.
+     */
+    void SetRecvBudget(size_t budget);
+
+    /**
+     * Get recv budget of one session readable event.
+     * @return size_t - the recv budget(in bytes), 0 means unlimited.
+     */
+    size_t GetRecvBudget() const;
+
+    /**
+     * Set session send queue water marks, must call before poller start.
+     * @param[in] lowWaterMark  - the low water mark(in bytes).
+     * @param[in] highWaterMark - the high water mark(in bytes), 0 means disable backpressure.
+     */
+    void SetSendWaterMarks(size_t lowWaterMark, size_t highWaterMark);
+
+    /**
+     * Set backpressure policies, must call before poller start.
+     * @param[in] policy         - the default backpressure policy.
+     * @param[in] opcodePolicies - the opcode specified backpressure policies.
+     */
+    void SetBackpressurePolicies(int policy, const std::map<int, int> &opcodePolicies);
+
+    /**
+     * Set reliable udp session options, must call before poller start.
+     * @param[in] opts - the reliable udp options.
+     */
+    void SetReliableUdpOptions(const LLBC_ReliableUdpOptions &opts);
+
 public:
     /**
      * Startup poller to work.
@@ -98,23 +131,113 @@ public:
      */
     virtual void Cleanup();
 
+public:
+    /**
+     * Push event to poller lock-free event queue, thread safe.
+     * If event queue is empty before push, will wake up poller.
+     * @param[in] ev - the poller event, build by LLBC_PollerEvUtil, will be stolen.
+     */
+    void Push(LLBC_PollerEvent *ev);
+
+    /**
+     * Push send event to poller lock-free send queue, thread safe.
+     * If send queue is empty before push, will push a FlushSend event to wake up poller.
+     * @param[in] ev - the send event, build by LLBC_PollerEvUtil::BuildSendEv()/BuildMulticastEv()/BuildSendBatchEv().
+     */
+    void PushSend(LLBC_PollerEvent *ev);
+
+    /**
+     * Get poller receive slab pool, only can call in poller thread.
+     * @return LLBC_RecvSlabPool * - the receive slab pool.
+     */
+    LLBC_RecvSlabPool *GetRecvSlabPool();
+
+    /**
+     * Accumulate poller all sessions send statistic to given statistic, thread safe.
+     * @param[out] stat - the send statistic.
+     */
+    void GetSendStat(LLBC_SendStat &stat) const;
+
+    /**
+     * Accumulate poller all sessions receive statistic to given statistic, thread safe.
+     * @param[out] stat - the receive statistic.
+     */
+    void GetRecvStat(LLBC_RecvStat &stat) const;
+
 protected:
     /**
      * Handle queued events.
      */
-    virtual void HandleQueuedEvents(int waitTime);
+    virtual void HandleQueuedEvents();
     virtual void HandleEv_AddSock(LLBC_PollerEvent &ev);
     virtual void HandleEv_AsyncConn(LLBC_PollerEvent &ev);
     virtual void HandleEv_Send(LLBC_PollerEvent &ev);
     virtual void HandleEv_Close(LLBC_PollerEvent &ev);
     virtual void HandleEv_Monitor(LLBC_PollerEvent &ev);
     virtual void HandleEv_TakeOverSession(LLBC_PollerEvent &ev);
+    virtual void HandleEv_FlushSend(LLBC_PollerEvent &ev);
+    virtual void HandleEv_Multicast(LLBC_PollerEvent &ev);
+    virtual void HandleEv_SendBatch(LLBC_PollerEvent &ev);
+
+    /**
+     * Send packet to the packet's session, if session not found, will delete the packet.
+     * @param[in] packet - the packet, will be stolen.
+     */
+    void SendPacket(LLBC_Packet *packet);
+
+    /**
+     * Flush all queued send events in lock-free send queue.
+     */
+    void FlushSendQueue();
+
+    /**
+     * Check has recv budget exhausted sessions waiting for re-arm or not.
+     * @return bool - return true if has pending receive sessions.
+     */
+    bool HasPendingRecvs() const;
+
+    /**
+     * Continue receive all recv budget exhausted sessions(one budget per session),
+     * the sessions which exhausted budget again will be re-armed to next call.
+     */
+    void HandlePendingRecvs();
+
+    /**
+     * Get poller wait time, if has pending receive sessions, not wait, if has reliable udp sessions,
+     * wait at most reliable udp update interval.
+     * @param[in] maxWaitTime - the max wait time(in milli-seconds).
+     * @return int - the wait time(in milli-seconds).
+     */
+    int GetWaitTime(int maxWaitTime) const;
+
+    /**
+     * Accept reliable udp peers, the open datagram(new peer) received by listen socket will create new
+     * session(stay in this poller), the new session socket bind to listen address and connect to peer.
+     * The datagrams arrived before peer session socket connected will be forwarded to peer session.
+     * @param[in] listenSession - the reliable udp listen session.
+     */
+    void AcceptReliableUdp(LLBC_Session *listenSession);
+
+    /**
+     * Update all reliable udp sessions(retransmission, ack flush, keepalive, dead link check).
+     */
+    void UpdateReliableUdpSessions();
 
     /**
      * Create new session from socket.
      */
     LLBC_Session *CreateSession(LLBC_Socket *socket, int sessionId = 0);
 
+    /**
+     * Create new session from accepted socket, if listen socket is port reusable(each poller has
+     * its own listen socket), the new session Id will be allocated to this poller, session will not
+     * be taken over by brother poller.
+     * @param[in] listenSock - the listen socket.
+     * @param[in] newSock    - the accepted socket.
+     * @return LLBC_Session * - the new session.
+     */
+    LLBC_Session *CreateAcceptedSession(LLBC_Socket *listenSock, LLBC_Socket *newSock);
+
 protected:
     /**
      * Add session to poller.
@@ -143,12 +266,92 @@ protected:
      */
     void SetConnectedSocketDftOpts(LLBC_Socket *sock);
 
+    /**
+     * Add session sent statistic to poller send statistic, only can call in poller thread.
+     * @param[in] stat - the session sent statistic.
+     */
+    void AddSendStat(const LLBC_SendStat &stat);
+
+    /**
+     * Check poller is flushing send queue or not.
+     * @return bool - the flushing flag.
+     */
+    bool IsFlushingSendQueue() const;
+
+    /**
+     * Add session to pending flush list, the session's OnSend() will be called when send queue flush finished.
+     * @param[in] sessionId - the session Id.
+     */
+    void AddPendingFlushSession(int sessionId);
+
+    /**
+     * Add session receive statistic to poller receive statistic, only can call in poller thread.
+     * @param[in] stat - the session receive statistic.
+     */
+    void AddRecvStat(const LLBC_RecvStat &stat);
+
+    /**
+     * Add recv budget exhausted session to pending receive list, the session will continue
+     * receive in HandlePendingRecvs() call.
+     * @param[in] sessionId - the session Id.
+     */
+    void AddPendingRecvSession(int sessionId);
+
+    /**
+     * Get session send queue water marks.
+     * @return size_t - the low/high water mark, high water mark is 0 means backpressure disabled.
+     */
+    size_t GetSendLowWaterMark() const;
+    size_t GetSendHighWaterMark() const;
+
+    /**
+     * Get the default backpressure policy.
+     * @return int - the default backpressure policy.
+     */
+    int GetBackpressurePolicy() const;
+
+    /**
+     * Get the specified opcode's backpressure policy, if not set, return the default policy.
+     * @param[in] opcode - the opcode.
+     * @return int - the backpressure policy.
+     */
+    int GetBackpressurePolicy(int opcode) const;
+
+    /**
+     * Update session send queue size to poller manager, use to support thread safe queue size query.
+     * @param[in] sessionId - the session Id.
+     * @param[in] queueSize - the session send queue size.
+     */
+    void UpdateSendQueueSize(int sessionId, size_t queueSize);
+
+    /**
+     * Update session receive statistic to poller manager, use to support thread safe live receive statistic query.
+     * @param[in] sessionId - the session Id.
+     * @param[in] stat      - the session accumulated receive statistic.
+     */
+    void UpdateSessionRecvStat(int sessionId, const LLBC_RecvStat &stat);
+
+    /**
+     * Wake up poller thread if it blocking in waiting, default do nothing.
+     * The poller which blocking wait(eg: EpollPoller, IocpPoller) need override it.
+     */
+    virtual void Wakeup();
+
 private:
     /**
      * Decleare friend class: LLBC_Session.
      * Access method list:
      *      AddSession(LLBC_Session *)
      *      RemoveSession(LLBC_Session *)
+     *      AddSendStat(const LLBC_SendStat &)
+     *      IsFlushingSendQueue()
+     *      AddPendingFlushSession(int)
+     *      AddRecvStat(const LLBC_RecvStat &)
+     *      AddPendingRecvSession(int)
+     *      GetSendLowWaterMark()/GetSendHighWaterMark()
+     *      GetBackpressurePolicy()/GetBackpressurePolicy(int)
+     *      UpdateSendQueueSize(int, size_t)
+     *      UpdateSessionRecvStat(int, const LLBC_RecvStat &)
      */
     friend class LLBC_Session;
 
@@ -161,14 +364,43 @@ protected:
     LLBC_IService *_svc;
     LLBC_PollerMgr *_pollerMgr;
     
-    typedef std::map<LLBC_SocketHandle, LLBC_Session *> _Sockets;
-    _Sockets _sockets;
-    typedef std::map<int, LLBC_Session *> _Sessions;
-    _Sessions _sessions;
+    LLBC_SessionTable _sessions;
 
     typedef std::map<LLBC_SocketHandle, LLBC_AsyncConnInfo> _Connecting;
     _Connecting _connecting;
 
+    LLBC_MPSCQueue<LLBC_PollerEvent> _evQueue;
+    LLBC_MPSCQueue<LLBC_PollerEvent> _sendQueue;
+    LLBC_RecvSlabPool *_recvSlabPool;
+
+    bool _flushingSendQueue;
+    std::vector<int> _pendingFlushSessionIds;
+
+    size_t _recvBudget;
+    std::vector<int> _pendingRecvSessionIds;
+    std::vector<int> _handlingRecvSessionIds;
+
+    size_t _sendLowWaterMark;
+    size_t _sendHighWaterMark;
+    int _backpressurePolicy;
+    std::map<int, int> _opcodeBackpressurePolicies;
+
+    LLBC_ReliableUdpOptions _rudpOpts;
+    std::vector<int> _rudpSessionIds;
+    std::vector<int> _updatingRudpSessionIds;
+    std::map<uint64, int> _rudpPeers;
+
+    // Poller send statistic, only write in poller thread, read by other threads.
+    volatile sint64 _sendCalls;
+    volatile sint64 _sentBlocks;
+    volatile sint64 _sentBytes;
+
+    // Poller receive statistic, only write in poller thread, read by other threads.
+    volatile sint64 _recvEvents;
+    volatile sint64 _recvCalls;
+    volatile sint64 _recvBytes;
+    volatile sint64 _recvBudgetExhausts;
+
 protected:
     typedef LLBC_PollerEvent _Ev;
     typedef void (LLBC_BasePoller::*_Handler)(_Ev &);
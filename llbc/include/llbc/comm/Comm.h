@@ -13,22 +13,32 @@
 #include "llbc/core/Core.h"
 #include "llbc/objbase/ObjBase.h"
 
+#include "llbc/comm/SendStat.h"
+#include "llbc/comm/RecvStat.h"
+#include "llbc/comm/TrafficStat.h"
+#include "llbc/comm/TrafficStatCollector.h"
+#include "llbc/comm/ReliableUdpOptions.h"
 #include "llbc/comm/Socket.h"
 #include "llbc/comm/Session.h"
 #include "llbc/comm/Packet.h"
 #include "llbc/comm/ICoder.h"
 #include "llbc/comm/IFacade.h"
 #include "llbc/comm/PollerType.h"
+#include "llbc/comm/BackpressurePolicy.h"
+#include "llbc/comm/OpcodeDispatchTable.h"
 #include "llbc/comm/BasePoller.h"
 #include "llbc/comm/IService.h"
 #include "llbc/comm/ServiceMgr.h"
 #include "llbc/comm/PacketHeaderParts.h"
 #include "llbc/comm/LibPacketHeaderDescFactory.h"
+#include "llbc/comm/PacketHeaderAssembler.h"
 #include "llbc/comm/protocol/ProtocolLayer.h"
 #include "llbc/comm/protocol/ProtoReportLevel.h"
+#include "llbc/comm/protocol/CompressPolicy.h"
 #include "llbc/comm/protocol/IProtocol.h"
 #include "llbc/comm/protocol/IProtocolFilter.h"
 #include "llbc/comm/headerdesc/PacketHeaderDesc.h"
+#include "llbc/comm/headerdesc/PacketHeaderLayout.h"
 
 __LLBC_NS_BEGIN
 
@@ -19,17 +19,11 @@
 
 __LLBC_NS_BEGIN
 
-/**
- * Previous declare some classes.
- */
-class LLBC_PollerMonitor;
-
-__LLBC_NS_END
-
-__LLBC_NS_BEGIN
-
 /**
  * \brief The Epoll poller class encapsulation.
+ *
+ * Poller thread wait socket events by epoll_wait() directly, and drain queued events after every wait,
+ * the cross-thread events(AddSock/AsyncConn/Close/FlushSend, ...) pusher will wake up poller by eventfd.
  */
 class LLBC_HIDDEN LLBC_EpollPoller : public LLBC_BasePoller
 {
@@ -62,7 +56,6 @@ protected:
     virtual void HandleEv_AsyncConn(LLBC_PollerEvent &ev);
     virtual void HandleEv_Send(LLBC_PollerEvent &ev);
     virtual void HandleEv_Close(LLBC_PollerEvent &ev);
-    virtual void HandleEv_Monitor(LLBC_PollerEvent &ev);
     virtual void HandleEv_TakeOverSession(LLBC_PollerEvent &ev);
 
     /**
@@ -75,21 +68,28 @@ protected:
      */
     virtual void RemoveSession(LLBC_Session *session);
 
+    /**
+     * Wake up poller thread from epoll_wait().
+     */
+    virtual void Wakeup();
+
 private:
     /**
-     * Startup monitor.
+     * Create wakeup eventfd and add it to epoll.
+     * @return int - return 0 if success, otherwise return -1.
      */
-    int StartupMonitor();
+    int CreateWakeupFd();
 
     /**
-     * Stop monitor.
+     * Close wakeup eventfd, wait all in-flight writers left before close, call after poller thread stopped.
      */
-    void StopMonitor();
+    void CloseWakeupFd();
 
     /**
-     * The monitor thread service method.
+     * Handle epoll waited events.
+     * @param[in] count - the waited events count.
      */
-    void MonitorSvc();
+    void HandleEpollEvents(int count);
 
     /**
      * Handle connecting sockets.
@@ -103,7 +103,10 @@ private:
 
 private:
     LLBC_Handle _epoll;
-    LLBC_PollerMonitor *_monitor;
+
+    int _wakeupFd;
+    volatile sint32 _wakeupPending;
+    volatile sint32 _wakeupWriters;
 
     LLBC_EpollEvent _events[LLBC_CFG_COMM_MAX_EVENT_COUNT];
 };
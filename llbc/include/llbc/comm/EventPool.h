@@ -0,0 +1,51 @@
+/**
+ * @file    EventPool.h
+ * @author  Longwei Lai<lailongwei@126.com>
+ * @date    2026/10/18
+ * @version 1.0
+ *
+ * @brief   The service/poller event node pool.
+ */
+#ifndef __LLBC_COMM_EVENT_POOL_H__
+#define __LLBC_COMM_EVENT_POOL_H__
+
+#include "llbc/common/Common.h"
+#include "llbc/core/Core.h"
+
+__LLBC_NS_BEGIN
+
+/**
+ * \brief The service/poller event node pool class encapsulation.
+ *
+ * Service events and poller events are allocated in producer threads and freed in consumer
+ * thread, pool split nodes into size classes(16 bytes granularity), every size class is an
+ * intrusive free list protected by spin lock, the freed nodes are linked by their own memory,
+ * so pool self never allocate any extra memory.
+ * The nodes larger than LLBC_CFG_COMM_EVENT_POOL_MAX_NODE_SIZE are not pooled.
+ */
+class LLBC_HIDDEN LLBC_EventPool
+{
+public:
+    /**
+     * Allocate node memory, thread safe.
+     * @param[in] size - the node size.
+     * @return void * - the node memory.
+     */
+    static void *Alloc(size_t size);
+
+    /**
+     * Free node memory, thread safe.
+     * @param[in] node - the node memory.
+     * @param[in] size - the node size, must same as allocate size.
+     */
+    static void Free(void *node, size_t size);
+
+    /**
+     * Free all cached nodes, call at communication module cleanup.
+     */
+    static void Purge();
+};
+
+__LLBC_NS_END
+
+#endif // !__LLBC_COMM_EVENT_POOL_H__
@@ -13,6 +13,8 @@
 #include "llbc/core/Core.h"
 #include "llbc/objbase/ObjBase.h"
 
+#include "llbc/comm/RecvStat.h"
+
 __LLBC_NS_BEGIN
 
 /**
@@ -117,7 +119,8 @@ class LLBC_EXPORT LLBC_SessionDestroyInfo
 {
 public:
     LLBC_SessionDestroyInfo(LLBC_SessionInfo *sessionInfo, 
-                            LLBC_SessionCloseInfo *closeInfo);
+                            LLBC_SessionCloseInfo *closeInfo,
+                            const LLBC_RecvStat &recvStat = LLBC_RecvStat());
     ~LLBC_SessionDestroyInfo();
 
 public:
@@ -158,6 +161,13 @@ public:
     */
     const LLBC_String &GetReason() const;
 
+public:
+    /**
+     * Get destroyed session's socket receive statistic.
+     * @return const LLBC_RecvStat & - the receive statistic.
+     */
+    const LLBC_RecvStat &GetRecvStat() const;
+
 public:
     /**
      * Get the class object string representation.
@@ -168,6 +178,7 @@ public:
 private:
     LLBC_SessionInfo *_sessionInfo;
     LLBC_SessionCloseInfo *_closeInfo;
+    LLBC_RecvStat _recvStat;
 };
 
 /**
@@ -229,6 +240,66 @@ private:
     LLBC_SockAddr_IN _peerAddr;
 };
 
+/**
+ * \brief The session backpressure info class encapsulation.
+ */
+class LLBC_EXPORT LLBC_SessionBackpressureInfo
+{
+public:
+    /**
+     * Constructor & Destructor.
+     */
+    LLBC_SessionBackpressureInfo();
+    ~LLBC_SessionBackpressureInfo();
+
+public:
+    /**
+     * Session Id getter & setter.
+     */
+    int GetSessionId() const;
+    void SetSessionId(int sessionId);
+
+    /**
+     * Backpressured flag getter & setter.
+     * If true, session send queue reach high water mark, otherwise session send queue drain to low water mark.
+     */
+    bool IsBackpressured() const;
+    void SetIsBackpressured(bool backpressured);
+
+    /**
+     * Session send queue size(queued not sent bytes) getter & setter.
+     */
+    size_t GetQueueSize() const;
+    void SetQueueSize(size_t queueSize);
+
+    /**
+     * Dropped packets count(in backpressure state) getter & setter, only available when leave backpressure state.
+     */
+    size_t GetDroppedPackets() const;
+    void SetDroppedPackets(size_t droppedPackets);
+
+    /**
+     * Coalesced(replaced by same opcode's later packet) packets count(in backpressure state) getter & setter,
+     * only available when leave backpressure state.
+     */
+    size_t GetCoalescedPackets() const;
+    void SetCoalescedPackets(size_t coalescedPackets);
+
+public:
+    /**
+     * Get this class object string representation.
+     * @return LLBC_String - the string representation.
+     */
+    LLBC_String ToString() const;
+
+private:
+    int _sessionId;
+    bool _backpressured;
+    size_t _queueSize;
+    size_t _droppedPackets;
+    size_t _coalescedPackets;
+};
+
 /**
  * \brief The protocol stack report class encapsulation.
  */
@@ -357,6 +428,13 @@ public:
      */
     virtual void OnAsyncConnResult(const LLBC_AsyncConnResult &result);
 
+    /**
+     * When session send queue reach high water mark or drain to low water mark, will call this event handler.
+     * see LLBC_IService::SetSendWaterMarks() method.
+     * @param[in] info - the session backpressure info.
+     */
+    virtual void OnSessionBackpressure(const LLBC_SessionBackpressureInfo &info);
+
 public:
     /**
      * When protocol layer report something, will call this event handler.
@@ -400,6 +478,7 @@ __LLBC_NS_END
 LLBC_EXTERN LLBC_EXPORT std::ostream &operator <<(std::ostream &o, const LLBC_NS LLBC_SessionInfo &si);
 LLBC_EXTERN LLBC_EXPORT std::ostream &operator <<(std::ostream &o, const LLBC_NS LLBC_SessionDestroyInfo &destroy);
 LLBC_EXTERN LLBC_EXPORT std::ostream &operator <<(std::ostream &o, const LLBC_NS LLBC_AsyncConnResult &result);
+LLBC_EXTERN LLBC_EXPORT std::ostream &operator <<(std::ostream &o, const LLBC_NS LLBC_SessionBackpressureInfo &info);
 LLBC_EXTERN LLBC_EXPORT std::ostream &operator <<(std::ostream &o, const LLBC_NS LLBC_ProtoReport &report);
 
 #endif // !__LLBC_COMM_IFACADE_H__
@@ -13,6 +13,11 @@
 #include "llbc/core/Core.h"
 #include "llbc/objbase/ObjBase.h"
 
+#include "llbc/comm/SendStat.h"
+#include "llbc/comm/RecvStat.h"
+#include "llbc/comm/TrafficStat.h"
+#include "llbc/comm/ReliableUdpOptions.h"
+
 __LLBC_NS_BEGIN
 
 /**
@@ -28,6 +33,7 @@ class LLBC_IProtocolFilter;
 class LLBC_PacketHeaderDesc;
 class LLBC_IPacketHeaderDescFactory;
 class LLBC_PacketHeaderParts;
+struct LLBC_ServiceEvent;
 
 __LLBC_NS_END
 
@@ -57,11 +63,13 @@ public:
     {
         SelfDrive,
         ExternalDrive,
+        // Self drive, but service thread block wait events in frame remaining time(instead of sleep),
+        // the arrived events will be handled immediately, facades still update on the frame cadence.
+        EventDrive,
     };
 
 public:
-    // Import Base::Push/Base::Wait method to service.
-    using LLBC_BaseTask::Push;
+    // Import Base::Wait method to service.
     using LLBC_BaseTask::Wait;
 
 public:
@@ -128,6 +136,177 @@ public:
      */
     virtual int SuppressCoderNotFoundWarning() = 0;
 
+    /**
+     * Set the Compress-Layer compress policy, only available in Non-Raw type service,
+     * and must be called before service start.
+     * @param[in] policy    - the compress policy, see LLBC_CompressPolicy.
+     * @param[in] threshold - the compress threshold(payload length), use in LLBC_CompressPolicy::Threshold policy.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    virtual int SetCompressPolicy(int policy, size_t threshold = LLBC_CFG_COMM_DFT_COMPRESS_THRESHOLD) = 0;
+
+    /**
+     * Set the opcode specific compress policy, it will override service compress policy,
+     * must be called before service start.
+     * @param[in] opcode - the opcode.
+     * @param[in] policy - the compress policy, see LLBC_CompressPolicy.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    virtual int SetOpcodeCompressPolicy(int opcode, int policy) = 0;
+
+    /**
+     * Set the max packet length(header + payload), only available in Non-Raw type service,
+     * and must be called before service start.
+     * The packet which length exceed it will be rejected when packet header received(not wait payload),
+     * and session will be removed, the packets received before it still be delivered.
+     * @param[in] maxPacketLen - the max packet length, 0 means no limit.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    virtual int SetMaxPacketLength(size_t maxPacketLen) = 0;
+
+    /**
+     * Enable/Disable chunked receive mode, only available in Non-Raw type service,
+     * and must be called before service start.
+     * In chunked receive mode, the packet which payload length exceed chunk size will not be buffered whole,
+     * the payload will be delivered to handler as chunks(see LLBC_Packet::IsChunk()), every chunk packet has
+     * same header, and chunk packets will not be decompressed and decoded(the compressed packet always be
+     * received whole).
+     * @param[in] enabled   - enable chunked receive mode or not.
+     * @param[in] chunkSize - the chunk size, must be greater than 0.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    virtual int SetChunkedRecv(bool enabled, size_t chunkSize = LLBC_CFG_COMM_DFT_RECV_CHUNK_SIZE) = 0;
+
+    /**
+     * Enable/Disable coalesced send mode, must be called before service start.
+     * In coalesced send mode, the packets sent in service thread(in service frame) will be accumulated
+     * per session, and flushed to pollers as batches at service frame end, the session which pending
+     * bytes/latency exceed limit will be flushed alone, the packets sent in other threads still send immediately.
+     * @param[in] enabled    - enable coalesced send mode or not.
+     * @param[in] maxBytes   - the session max pending bytes(payload length), must be greater than 0.
+     * @param[in] maxLatency - the session max pending latency, in milli-seconds, 0 means no latency limit,
+     *                         latency checked between event batches with frame cached time.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    virtual int SetCoalescedSend(bool enabled,
+                                 size_t maxBytes = LLBC_CFG_COMM_DFT_COALESCED_SEND_MAX_BYTES,
+                                 int maxLatency = LLBC_CFG_COMM_DFT_COALESCED_SEND_MAX_LATENCY) = 0;
+
+    /**
+     * Set the recv budget of one session readable event, must be called before service start.
+     * Session at most receive budget bytes in one readable event, if budget exhausted, session will be
+     * re-armed and continue receive after other sessions in same poller serviced, so one fast client
+     * can not monopolize poller.
+     * @param[in] budget - the recv budget(in bytes), 0 means unlimited(receive until would-block).
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    virtual int SetRecvBudget(size_t budget = LLBC_CFG_COMM_DFT_RECV_BUDGET) = 0;
+
+    /**
+     * Set the session send queue water marks, must be called before service start.
+     * When session queued not sent bytes reach high water mark, session enter backpressure state,
+     * when drain to low water mark, session leave backpressure state, facades will receive
+     * OnSessionBackpressure() event in both cases.
+     * Note: high water mark should greater than the max packet size.
+     * @param[in] lowWaterMark  - the low water mark(in bytes), must less than high water mark.
+     * @param[in] highWaterMark - the high water mark(in bytes), 0 means disable backpressure.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    virtual int SetSendWaterMarks(size_t lowWaterMark = LLBC_CFG_COMM_DFT_SEND_LOW_WATER_MARK,
+                                  size_t highWaterMark = LLBC_CFG_COMM_DFT_SEND_HIGH_WATER_MARK) = 0;
+
+    /**
+     * Set the default backpressure policy, must be called before service start.
+     * The policy applied to the packets sent to backpressured session, if policy is
+     * LLBC_BackpressurePolicy::Disconnect, session will be disconnected when enter backpressure state.
+     * @param[in] policy - the backpressure policy, see LLBC_BackpressurePolicy, default is None.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    virtual int SetBackpressurePolicy(int policy) = 0;
+
+    /**
+     * Set the specified opcode's backpressure policy, it will override the default backpressure policy,
+     * must be called before service start.
+     * eg: set state-sync opcodes to Coalesce, set droppable notify opcodes to Drop.
+     * @param[in] opcode - the opcode.
+     * @param[in] policy - the backpressure policy, see LLBC_BackpressurePolicy.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    virtual int SetOpcodeBackpressurePolicy(int opcode, int policy) = 0;
+
+    /**
+     * Set the reliable udp session options, must be called before service start.
+     * Use options loss/latency simulator fields can test reliable udp sessions in loopback.
+     * @param[in] opts - the reliable udp options.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    virtual int SetReliableUdpOptions(const LLBC_ReliableUdpOptions &opts) = 0;
+
+    /**
+     * Enable/Disable per-opcode and per-session traffic statistic, must be called before service start.
+     * If dump interval greater than 0, service will dump statistic snapshot to logger periodically
+     * in service thread(logger manager must be initialized).
+     * @param[in] enabled      - enable traffic statistic or not.
+     * @param[in] dumpInterval - the dump interval, in milli-seconds, 0 means not dump.
+     * @param[in] loggerName   - the dump logger name, NULL or empty means root logger.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    virtual int SetTrafficStat(bool enabled, int dumpInterval = 0, const char *loggerName = NULL) = 0;
+
+    /**
+     * Set the session-affine dispatch workers count, must be called before service start.
+     * When enabled, the session-local opcode packets(see SetOpcodeSessionLocal()) will be dispatched
+     * to workers by session Id(sessionId % workerCount), so the hot service can use multi cores.
+     * Threading contract:
+     *  1. Session-local opcode packets are decoded and handled(status handlers, pre-handlers, handler,
+     *     facades OnUnHandledPacket()) in worker thread, one session's packets always be handled in
+     *     same worker in arrival order, but not ordered with other opcodes packets handled in service thread.
+     *  2. Other opcodes packets, all facades callbacks(OnUpdate/OnIdle/OnSessionCreate/OnSessionDestroy/...),
+     *     frame tasks, events and timers are still handled in service thread.
+     *  3. Session-local handlers can call thread safe methods(Send/Multicast/Forward/RemoveSession/...),
+     *     the packets sent in worker are not coalesced, handlers must synchronize the states shared
+     *     with service thread or other sessions by self, and can't use timers and auto-release pool.
+     *  4. Session destroy is handled in service thread, worker maybe still handle the session packets
+     *     queued before destroy.
+     * @param[in] workerCount - the workers count, 0 means disable(all packets handled in service thread).
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    virtual int SetDispatchWorkers(int workerCount) = 0;
+
+    /**
+     * Declare opcode handler is session-local or not, must be called before service start.
+     * The session-local handler only access session-local states, it's packets can be handled in
+     * dispatch worker(see SetDispatchWorkers()), default all handlers need service thread.
+     * @param[in] opcode       - the opcode.
+     * @param[in] sessionLocal - the session-local flag.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    virtual int SetOpcodeSessionLocal(int opcode, bool sessionLocal = true) = 0;
+
+    /**
+     * Get the session send queue size(queued not sent bytes), thread safe.
+     * Game logic can use it to throttle sync frequency for laggy sessions.
+     * @param[in] sessionId  - the session Id.
+     * @param[out] queueSize - the send queue size.
+     * @return int - return 0 if success, otherwise return -1(session not found).
+     */
+    virtual int GetSendQueueSize(int sessionId, size_t &queueSize) const = 0;
+
+    /**
+     * Get the service poller type(see LLBC_PollerType), default is LLBC_CFG_COMM_POLLER_MODEL_ENV_NAME
+     * environment variable specified poller model(if set), otherwise is LLBC_CFG_COMM_POLLER_MODEL config.
+     * @return int - the poller type.
+     */
+    virtual int GetPollerType() const = 0;
+
+    /**
+     * Set the service poller type(see LLBC_PollerType), must be called before service start.
+     * If kernel not support io_uring, set to LLBC_PollerType::IoUringPoller will fallback to epoll poller.
+     * @param[in] type - the poller type.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    virtual int SetPollerType(int type) = 0;
+
 public:
     /**
      * Startup service, default will startup one poller to work.
@@ -166,6 +345,46 @@ public:
      */
     virtual int GetFrameInterval() const = 0;
 
+    /**
+     * Get service all pollers send statistic(send system calls, sent blocks and bytes).
+     * @param[out] stat - the send statistic.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    virtual int GetSendStat(LLBC_SendStat &stat) const = 0;
+
+    /**
+     * Get service all pollers receive statistic(readable events, recv system calls, received bytes
+     * and recv budget exhausted times).
+     * Note: Live per-session receive statistic can get from GetSessionRecvStat(), destroyed session's
+     *       final receive statistic can get from LLBC_SessionDestroyInfo::GetRecvStat().
+     * @param[out] stat - the receive statistic.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    virtual int GetRecvStat(LLBC_RecvStat &stat) const = 0;
+
+    /**
+     * Get the live session receive statistic, thread safe.
+     * @param[in] sessionId - the session Id.
+     * @param[out] stat     - the session receive statistic.
+     * @return int - return 0 if success, otherwise return -1(session not found).
+     */
+    virtual int GetSessionRecvStat(int sessionId, LLBC_RecvStat &stat) const = 0;
+
+    /**
+     * Get service coalesced send statistic.
+     * @param[out] stat - the coalesced send statistic.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    virtual int GetCoalescedSendStat(LLBC_CoalescedSendStat &stat) const = 0;
+
+    /**
+     * Get service traffic statistic snapshot(per-opcode and per-session bytes, packets,
+     * encode/decode time and handler time), thread safe.
+     * @param[out] stat - the traffic statistic snapshot.
+     * @return int - return 0 if success, otherwise return -1(traffic statistic not enabled).
+     */
+    virtual int GetTrafficStat(LLBC_TrafficStat &stat) const = 0;
+
 public:
     /**
      * Create a session and listening.
@@ -175,6 +394,19 @@ public:
      */
     virtual int Listen(const char *ip, uint16 port) = 0;
 
+    /**
+     * Create multi-acceptor listen sessions, every poller create its own SO_REUSEPORT listen socket,
+     * kernel will load-balance incoming connections to all pollers, accept is no longer bottleneck
+     * on one poller thread, and accepted sessions stay in accepting poller.
+     * Note: - Must call after service started.
+     *       - Only available in the platform which support SO_REUSEPORT(Linux 3.9+ kernel for load-balance).
+     * @param[in] ip          - the ip address.
+     * @param[in] port        - the port number.
+     * @param[out] sessionIds - the listen session Ids, one session per poller.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    virtual int ListenReusePort(const char *ip, uint16 port, LLBC_SessionIdList &sessionIds) = 0;
+
     /**
      * Establisthes a connection to a specified address.
      * @param[in] ip      - the ip address.
@@ -195,6 +427,29 @@ public:
      */
     virtual int AsyncConn(const char *ip, uint16 port, double timeout = -1) = 0;
 
+    /**
+     * Create a reliable udp listen session, the reliable udp sessions use same protocol stack
+     * as tcp sessions, every peer has its own session(connected udp socket).
+     * Note: Only available in SelectPoller/EpollPoller, if use other pollers, will return 0 and
+     *       last error is LLBC_ERROR_NOT_IMPL.
+     * @param[in] ip   - the ip address.
+     * @param[in] port - the port number.
+     * @return int - the new session Id, if return 0, means failed, see LLBC_GetLastError().
+     */
+    virtual int ListenReliableUdp(const char *ip, uint16 port) = 0;
+
+    /**
+     * Create a reliable udp session to a specified address.
+     * Note: - Udp connect not handshake, the session will be created immediately, if peer not listen,
+     *         session will be removed when ICMP port unreachable received or dead link detected.
+     *       - Only available in SelectPoller/EpollPoller, if use other pollers, will return 0 and
+     *         last error is LLBC_ERROR_NOT_IMPL.
+     * @param[in] ip   - the ip address.
+     * @param[in] port - the port number.
+     * @return int - the new session Id, if return 0, means failed, see LLBC_GetLastError().
+     */
+    virtual int ConnectReliableUdp(const char *ip, uint16 port) = 0;
+
     /**
      * Check given sessionId is validate or not.
      * @param[in] sessionId - the given session Id.
@@ -219,6 +474,8 @@ public:
      *      no matter this method success or not, coder will be managed by this call,
      *      it means no matter this call success or not, delete coder operation will
      *      execute by llbc framework.
+     *      Send not hold service lock, coder Encode() called in the calling thread, multi threads
+     *      sending concurrently, coder must not share unsynchronized state with other coders.
      * @param[in] svcId     - the service Id.
      * @param[in] sessionId - the session Id.
      * @param[in] opcode    - the opcode.
@@ -369,6 +626,24 @@ public:
     template <typename T>
     int Broadcast2(int svcId, int opcode, const T &data, int status, LLBC_PacketHeaderParts *parts);
 
+    /**
+     * Forward the received packet to the target service session without copy and re-encode,
+     * the packet header will be rewrite in place(service Id set to target service Id), and
+     * the packet data(header + payload) will be hand over to target service poller directly.
+     * Note:
+     *  1. After forward success, packet payload is taken over by target service, the packet
+     *     only keep header(payload length become 0).
+     *  2. Payload chunk packet(see SetChunkedRecv()) can't be forwarded.
+     *  3. The decoded object(if exist) will not be forwarded, target service send raw packet data.
+     * @param[in] packet          - the received packet.
+     * @param[in] targetSvcId     - the target service Id, service must registered in service manager.
+     * @param[in] targetSvc       - the target service.
+     * @param[in] targetSessionId - the target service session Id.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    virtual int Forward(LLBC_Packet &packet, int targetSvcId, int targetSessionId) = 0;
+    virtual int Forward(LLBC_Packet &packet, LLBC_IService *targetSvc, int targetSessionId) = 0;
+
     /**
      * Remove session, always success.
      * @param[in] sessionId - the will close session Id.
@@ -385,6 +660,8 @@ public:
 
     /**
      * Register coder.
+     * Note: Received packets decoded in service thread or dispatch worker threads(see SetDispatchWorkers()),
+     *       coder factory Create() maybe called in multi threads concurrently, must be thread safe.
      */
     virtual int RegisterCoder(int opcode, LLBC_ICoderFactory *coder) = 0;
 
@@ -406,6 +683,19 @@ public:
     template <typename ObjType>
     int Subscribe(int opcode, ObjType *obj, void (ObjType::*method)(LLBC_Packet &));
 
+    /**
+     * Subscribe message to specified delegate, the handler run in new service coroutine(see Go()),
+     * so it can await response packet/timer/posted result, the packet is valid until coroutine finished.
+     * Coroutine handler always handled in service thread, even if opcode is session-local.
+     */
+    virtual int SubscribeCoro(int opcode, LLBC_IDelegate1<LLBC_Packet &> *deleg) = 0;
+
+    /**
+     * Subscribe message to specified coroutine handler method.
+     */
+    template <typename ObjType>
+    int SubscribeCoro(int opcode, ObjType *obj, void (ObjType::*method)(LLBC_Packet &));
+
     /**
      * Previous subscribe message to specified delegate, if method return NULL, will stop packet process flow.
      */
@@ -445,6 +735,9 @@ public:
 
     /**
      * Set protocol filter to service's specified protocol layer.
+     * Note: Send() not hold service lock, codec layer runs in all sending threads concurrently, the
+     *       other layers run in poller threads(all pollers share one filter), dispatch workers also
+     *       decode packets concurrently(see SetDispatchWorkers()), so filter must be thread safe.
      * @param[in] filter  - the protocol filter.
      * @param[in] toLayer - which layer will add to.
      * @return int - return 0 if success, otherwise return -1.
@@ -505,6 +798,78 @@ public:
     template <typename ObjType>
     int Post(ObjType *obj, void (ObjType::*method)(This *));
 
+public:
+    /**
+     * Set the coroutine correlation header part, must be called before service start.
+     * The received packet which correlation part value equal to the coroutine awaiting correlation Id
+     * (see AwaitPacket()) will resume the coroutine, instead of dispatch to handlers.
+     * @param[in] serialNo - the correlation header part serial No, -1 means disable.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    virtual int SetCoroCorrelationPart(int serialNo) = 0;
+
+    /**
+     * Start service coroutine to run task, must call in service thread(in service frame).
+     * Coroutine run immediately until first await, then resumed by service in later frame when the
+     * awaited packet/timer/result arrived, all service coroutines run in service thread.
+     * When service stopping, the awaiting coroutines will be resumed and awaits fail with LLBC_ERROR_NOT_ALLOW.
+     * @param[in] task - the coroutine task, service will take over it(even if failed).
+     * @return int - return coroutine Id if success, otherwise return 0.
+     */
+    virtual int Go(LLBC_IDelegate0 *task) = 0;
+
+    /**
+     * Start service coroutine to run task method.
+     * @param[in] obj    - the task object.
+     * @param[in] method - the task method.
+     * @return int - return coroutine Id if success, otherwise return 0.
+     */
+    template <typename ObjType>
+    int Go(ObjType *obj, void (ObjType::*method)());
+
+    /**
+     * Await the packet which received from sessionId and correlation part value equal to correlationId,
+     * must call in service coroutine.
+     * If the awaited packet decode failed, await fail with LLBC_ERROR_DECODE, if the session destroyed
+     * before packet arrived(or not connected), await fail with LLBC_ERROR_NOT_FOUND.
+     * @param[in] sessionId     - the session Id.
+     * @param[in] correlationId - the correlation Id, one session correlation Id only can be awaited by one coroutine.
+     * @param[in] timeout       - the timeout, in milli-seconds, -1 means never timeout.
+     * @return LLBC_Packet * - the awaited packet, caller take over it, return NULL if failed(timeout is LLBC_ERROR_TIMEOUT).
+     */
+    virtual LLBC_Packet *AwaitPacket(int sessionId, sint64 correlationId, int timeout = -1) = 0;
+
+    /**
+     * Await specified milli-seconds, must call in service coroutine.
+     * @param[in] milliSeconds - the milli-seconds.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    virtual int AwaitTimer(int milliSeconds) = 0;
+
+    /**
+     * Await the result posted by PostCoroResult(), must call in service coroutine.
+     * If result already posted before await, return immediately.
+     * @param[out] result  - the posted result.
+     * @param[in]  timeout - the timeout, in milli-seconds, -1 means never timeout.
+     * @return int - return 0 if success, otherwise return -1(timeout is LLBC_ERROR_TIMEOUT).
+     */
+    virtual int AwaitResult(void *&result, int timeout = -1) = 0;
+
+    /**
+     * Post result to service coroutine, thread safe, result will be passed to coroutine in service thread.
+     * Note: If coroutine finished before result arrived, result will be discarded(not freed).
+     * @param[in] coroId - the coroutine Id(see LLBC_Coro::GetCurrent()->GetId()).
+     * @param[in] result - the result.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    virtual int PostCoroResult(int coroId, void *result) = 0;
+
+    /**
+     * Get the alive service coroutines count, must call in service thread.
+     * @return size_t - the coroutines count.
+     */
+    virtual size_t GetCoroCount() const = 0;
+
 public:
     /**
      * One time service call routine, if service drive mode is ExternalDrive, you must manual call this method.
@@ -512,6 +877,14 @@ public:
      */
     virtual void OnSvc(bool fullFrame = true) = 0;
 
+public:
+    /**
+     * Push service event to service, thread safe, library internal use.
+     * Service events are built by LLBC_SvcEvUtil, and linked to service event queue directly.
+     * @param[in] ev - the service event, will be stolen.
+     */
+    virtual void Push(LLBC_ServiceEvent *ev) = 0;
+
 protected:
     /**
      * Declare friend class: LLBC_Session.
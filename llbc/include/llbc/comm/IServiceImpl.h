@@ -121,6 +121,20 @@ inline int LLBC_IService::Subscribe(int opcode, ObjType *obj, void (ObjType::*me
     return LLBC_OK;
 }
 
+template <typename ObjType>
+inline int LLBC_IService::SubscribeCoro(int opcode, ObjType *obj, void (ObjType::*method)(LLBC_Packet &))
+{
+    LLBC_IDelegate1<LLBC_Packet &> *deleg =
+        new LLBC_Delegate1<ObjType, LLBC_Packet &>(obj, method);
+    if (this->SubscribeCoro(opcode, deleg) != LLBC_OK)
+    {
+        delete deleg;
+        return LLBC_FAILED;
+    }
+
+    return LLBC_OK;
+}
+
 template <typename ObjType>
 inline int LLBC_IService::PreSubscribe(int opcode, ObjType *obj, void *(ObjType::*method)(LLBC_Packet &))
 {
@@ -192,6 +206,12 @@ inline int LLBC_IService::Post(ObjType *obj, void (ObjType::*method)(LLBC_IServi
     return LLBC_OK;
 }
 
+template <typename ObjType>
+inline int LLBC_IService::Go(ObjType *obj, void (ObjType::*method)())
+{
+    return this->Go(new LLBC_Delegate0<ObjType>(obj, method));
+}
+
 __LLBC_NS_END
 
 #endif // __LLBC_COMM_ISERVICE_H__
@@ -0,0 +1,230 @@
+/**
+ * @file    IoUringPoller.h
+ * @author  Longwei Lai<lailongwei@126.com>
+ * @date    2026/10/18
+ * @version 1.0
+ *
+ * @brief
+ */
+#ifndef __LLBC_COMM_IO_URING_POLLER_H__
+#define __LLBC_COMM_IO_URING_POLLER_H__
+
+#include "llbc/common/Common.h"
+#include "llbc/core/Core.h"
+#include "llbc/objbase/ObjBase.h"
+
+#include "llbc/comm/BasePoller.h"
+
+#if LLBC_TARGET_PLATFORM_LINUX
+
+__LLBC_NS_BEGIN
+
+/**
+ * Pre-declare some classes.
+ */
+class LLBC_Session;
+
+/**
+ * \brief The io_uring poller send request structure encapsulation.
+ */
+struct LLBC_HIDDEN LLBC_IoUringSendReq
+{
+    int sessionId;                    // If session closed while request in-flight, set to 0.
+    LLBC_MessageBlock *orphanBlocks;  // The blocks taken over from closed session socket.
+
+    struct msghdr msg;
+    int vecCount;
+    LLBC_IoVec vecs[LLBC_IOV_MAX];
+};
+
+/**
+ * \brief The io_uring poller class encapsulation.
+ *
+ * Poller drive io_uring by raw system calls(not depend liburing):
+ *  - Listen session use multishot accept, every accepted connection post one completion.
+ *  - Connected session use multishot recv with provided buffer ring, received data will be copied
+ *    to poller receive slab and the buffer recycled to kernel immediately.
+ *  - Session at most has one in-flight sendmsg request, the data queued while request in-flight
+ *    will be sent by next request after completion.
+ * All requests prepared in one loop are submitted by one io_uring_enter() call(with completions wait),
+ * the cross-thread events pusher will wake up poller by eventfd(multishot poll).
+ *
+ * If kernel not support io_uring(or required features), poller manager will fallback to epoll poller,
+ * see IsSupported() method.
+ */
+class LLBC_HIDDEN LLBC_IoUringPoller : public LLBC_BasePoller
+{
+public:
+    LLBC_IoUringPoller();
+    virtual ~LLBC_IoUringPoller();
+
+public:
+    /**
+     * Check current kernel support io_uring poller required features or not.
+     * Required: io_uring, ext arg wait, fast poll, provided buffer ring and multishot recv(6.0+ kernel).
+     * @return bool - return true if supported, otherwise return false.
+     */
+    static bool IsSupported();
+
+public:
+    /**
+     * Startup poller.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    virtual int Start();
+
+    /**
+     * Task startup method.
+     */
+    virtual void Svc();
+
+    /**
+     * Task cleanup method.
+     */
+    virtual void Cleanup();
+
+public:
+    /**
+     * Post session send request, if session already has in-flight send request, do nothing.
+     * @param[in] session - the session.
+     */
+    void PostSend(LLBC_Session *session);
+
+    /**
+     * Cancel session all requests, must be called before session socket close.
+     * @param[in] session - the session.
+     */
+    void CancelRequests(LLBC_Session *session);
+
+protected:
+    /**
+     * Queued event handlers.
+     */
+    virtual void HandleEv_AsyncConn(LLBC_PollerEvent &ev);
+
+    /**
+     * Add session to poller.
+     */
+    virtual void AddSession(LLBC_Session *session);
+
+    /**
+     * Wake up poller thread from io_uring_enter().
+     */
+    virtual void Wakeup();
+
+private:
+    /**
+     * The request types, stored in user_data low bits.
+     */
+    enum
+    {
+        _Op_Wakeup,
+        _Op_Accept,
+        _Op_Recv,
+        _Op_Send,
+        _Op_Connect,
+        _Op_Cancel,
+
+        _Op_Bits = 3,
+        _Op_Mask = (1 << _Op_Bits) - 1
+    };
+
+private:
+    /**
+     * Setup/Destroy io_uring and provided buffer ring.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    int SetupRing();
+    void DestroyRing();
+
+    /**
+     * Get a free submission queue entry, if queue full, submit prepared entries first.
+     * @return struct io_uring_sqe * - the submission queue entry.
+     */
+    struct io_uring_sqe *GetSqe(int op, uint64 data);
+
+    /**
+     * Submit prepared entries and wait completions.
+     * @param[in] waitTime - the wait time(in milli-seconds), 0 means not wait.
+     */
+    void Submit(int waitTime);
+
+    /**
+     * Reap and handle completions.
+     */
+    void HandleCompletions();
+
+    /**
+     * Completion handlers.
+     */
+    void HandleWakeup(sint32 res, uint32 flags);
+    void HandleAccept(int sessionId, sint32 res, uint32 flags);
+    void HandleRecv(int sessionId, sint32 res, uint32 flags);
+    void HandleSend(LLBC_IoUringSendReq *req, sint32 res);
+    void HandleConnect(LLBC_SocketHandle handle, sint32 res);
+
+    /**
+     * Close wakeup eventfd, wait all in-flight writers left before close, call after poller thread stopped.
+     */
+    void CloseWakeupFd();
+
+    /**
+     * Prepare requests.
+     */
+    void PrepareWakeup();
+    void PrepareAccept(LLBC_Session *session);
+    void PrepareRecv(LLBC_Session *session);
+
+    /**
+     * Recycle provided buffer(the buffer id current slab) to ring, and publish recycled buffers to kernel.
+     */
+    void RecycleBuffer(uint16 bufId);
+    void PublishBuffers();
+
+    /**
+     * Send request allocate/release methods.
+     */
+    LLBC_IoUringSendReq *AllocSendReq();
+    void ReleaseSendReq(LLBC_IoUringSendReq *req);
+
+private:
+    int _ringFd;
+
+    void *_sqRing;
+    size_t _sqRingSize;
+    volatile uint32 *_sqHead;
+    volatile uint32 *_sqTail;
+    uint32 _sqMask;
+    uint32 _sqEntries;
+    uint32 _sqPrepared;
+    struct io_uring_sqe *_sqes;
+    size_t _sqesSize;
+
+    void *_cqRing;
+    size_t _cqRingSize;
+    volatile uint32 *_cqHead;
+    volatile uint32 *_cqTail;
+    uint32 _cqMask;
+    struct io_uring_cqe *_cqes;
+
+    struct io_uring_buf *_bufRing;
+    size_t _bufRingSize;
+    LLBC_RecvSlabPool *_bufSlabPool;
+    std::vector<LLBC_RecvSlab *> _bufSlabs;
+    uint16 _bufRingTail;
+    uint16 _bufRingPublished;
+    std::vector<int> _noBufSessionIds;
+
+    int _wakeupFd;
+    volatile sint32 _wakeupPending;
+    volatile sint32 _wakeupWriters;
+
+    int _inflightSendReqs;
+    std::vector<LLBC_IoUringSendReq *> _freeSendReqs;
+};
+
+__LLBC_NS_END
+
+#endif // LLBC_TARGET_PLATFORM_LINUX
+
+#endif // !__LLBC_COMM_IO_URING_POLLER_H__
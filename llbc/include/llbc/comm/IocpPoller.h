@@ -75,6 +75,11 @@ protected:
      */
     virtual void RemoveSession(LLBC_Session *session);
 
+    /**
+     * Wake up poller thread from waiting queued events.
+     */
+    virtual void Wakeup();
+
 private:
     /**
      * Startup monitor.
@@ -104,6 +109,8 @@ private:
 private:
     LLBC_IocpHandle _iocp;
     LLBC_PollerMonitor *_monitor;
+
+    LLBC_Semaphore _wakeupSem;
 };
 
 __LLBC_NS_END
@@ -23,11 +23,11 @@ __LLBC_NS_BEGIN
  *   |    Type   | Offset |  Len |
  * --|-----------|--------|------|--
  *   |   Length  |    0   |   4  |
- *   |   Opcode  |    4   |   2  |
- *   |   Status  |    6   |   2  |
- *   | ServiceId |    8   |   4  |
+ *   |   Opcode  |    4   |   4  |
+ *   |   Status  |    8   |   2  |
+ *   | ServiceId |   10   |   2  |
  *   |   Flags   |   12   |   2  |
- *Header total length: 14 bytes.
+ *Header total length: 14 bytes, same as LLBC_LibPacketHeaderLayout.
  */
 class LLBC_EXPORT LLBC_LibPacketHeaderDescFactory : public LLBC_IPacketHeaderDescFactory
 {
@@ -0,0 +1,157 @@
+/**
+ * @file    OpcodeDispatchTable.h
+ * @author  Longwei Lai<lailongwei@126.com>
+ * @date    2026/10/18
+ * @version 1.0
+ *
+ * @brief   The service compiled opcode dispatch table.
+ */
+#ifndef __LLBC_COMM_OPCODE_DISPATCH_TABLE_H__
+#define __LLBC_COMM_OPCODE_DISPATCH_TABLE_H__
+
+#include "llbc/common/Common.h"
+#include "llbc/core/Core.h"
+
+__LLBC_NS_BEGIN
+
+/**
+ * Previous declare some classes.
+ */
+class LLBC_Packet;
+class LLBC_ICoderFactory;
+
+__LLBC_NS_END
+
+__LLBC_NS_BEGIN
+
+/**
+ * \brief The opcode dispatch entry, hold all dispatch objects of one opcode together,
+ *        entry padded to cache line size, entries array is cache line aligned, so one
+ *        packet's dispatch(include status desc lookup) touch only one cache line.
+ *        Entry not own any object.
+ */
+struct LLBC_EXPORT LLBC_OpcodeDispatchEntry
+{
+    typedef std::map<int, LLBC_IDelegate1<LLBC_Packet &> *> StatusHandlers;
+    typedef std::map<int, LLBC_String> StatusDescs;
+
+    LLBC_IDelegate1<LLBC_Packet &> *handler;
+    LLBC_IDelegateEx<LLBC_Packet &> *preHandler;
+    LLBC_ICoderFactory *coder;
+    StatusHandlers *statusHandlers;
+    // The service status descs, all entries(include not subscribed opcodes) point to same descs.
+    const StatusDescs *statusDescs;
+
+    // The opcode handler is session-local or not(can dispatch to service worker).
+    bool sessionLocal;
+    // The opcode handler run in service coroutine or not.
+    bool coro;
+
+    // Pad entry to cache line size.
+    char padding[64 - 5 * sizeof(void *) - 2 * sizeof(bool)];
+};
+
+/**
+ * \brief The opcode dispatch table class encapsulation.
+ *
+ * Service compile all subscriptions into this table once at start:
+ *  - dense:  opcodes in [0, denseLimit) store in directly indexed entries array,
+ *            array size is max dense opcode + 1.
+ *  - sparse: other opcodes(negative or >= denseLimit) store in open-addressing hash table,
+ *            the compact keys array and cache line aligned entries array are separated.
+ * Table is immutable after compiled, so lookup is lock-free and can call in any thread.
+ */
+class LLBC_EXPORT LLBC_OpcodeDispatchTable
+{
+public:
+    typedef std::map<int, LLBC_OpcodeDispatchEntry> Entries;
+
+public:
+    LLBC_OpcodeDispatchTable();
+    ~LLBC_OpcodeDispatchTable();
+
+public:
+    /**
+     * Compile dispatch entries to table, old compiled entries will be cleared.
+     * @param[in] entries    - the opcode->entry map.
+     * @param[in] dftEntry   - the default entry, not found opcodes return it(eg: only hold status descs),
+     *                         if NULL, use empty entry(all members are NULL).
+     * @param[in] denseLimit - the dense opcode limit, opcodes in [0, denseLimit) use dense array.
+     */
+    void Compile(const Entries &entries,
+                 const LLBC_OpcodeDispatchEntry *dftEntry = NULL,
+                 int denseLimit = LLBC_CFG_COMM_OPCODE_DISPATCH_DENSE_LIMIT);
+
+    /**
+     * Clear the table.
+     */
+    void Clear();
+
+public:
+    /**
+     * Find opcode dispatch entry.
+     * @param[in] opcode - the opcode.
+     * @return const LLBC_OpcodeDispatchEntry & - the entry, if not found, return default entry(see Compile()).
+     */
+    const LLBC_OpcodeDispatchEntry &Find(int opcode) const;
+
+    /**
+     * Get dense entries array size.
+     * @return size_t - the dense size.
+     */
+    size_t GetDenseSize() const;
+
+    /**
+     * Get sparse entries count.
+     * @return size_t - the sparse count.
+     */
+    size_t GetSparseCount() const;
+
+    LLBC_DISABLE_ASSIGNMENT(LLBC_OpcodeDispatchTable);
+
+private:
+    /**
+     * Find sparse opcode dispatch entry.
+     */
+    const LLBC_OpcodeDispatchEntry &FindSparse(int opcode) const;
+
+    /**
+     * Sparse opcode hash.
+     */
+    static uint32 HashSparse(int opcode);
+
+private:
+    /**
+     * Allocate cache line aligned entries array.
+     */
+    static LLBC_OpcodeDispatchEntry *AllocEntries(size_t count, void *&mem);
+
+private:
+    /**
+     * The sparse hash table key structure, entry stored in same index of sparse entries array.
+     */
+    struct _SparseKey
+    {
+        int opcode;
+        bool used;
+    };
+
+private:
+    void *_denseMem;
+    LLBC_OpcodeDispatchEntry *_dense;
+    uint32 _denseSize;
+
+    _SparseKey *_sparseKeys;
+    void *_sparseMem;
+    LLBC_OpcodeDispatchEntry *_sparse;
+    uint32 _sparseMask;
+    size_t _sparseCount;
+
+    LLBC_OpcodeDispatchEntry _dftEntry;
+};
+
+__LLBC_NS_END
+
+#include "llbc/comm/OpcodeDispatchTableImpl.h"
+
+#endif // !__LLBC_COMM_OPCODE_DISPATCH_TABLE_H__
@@ -0,0 +1,53 @@
+/**
+ * @file    OpcodeDispatchTableImpl.h
+ * @author  Longwei Lai<lailongwei@126.com>
+ * @date    2026/10/18
+ * @version 1.0
+ *
+ * @brief   The opcode dispatch table inline lookup implementations.
+ */
+#ifdef __LLBC_COMM_OPCODE_DISPATCH_TABLE_H__
+
+__LLBC_NS_BEGIN
+
+inline const LLBC_OpcodeDispatchEntry &LLBC_OpcodeDispatchTable::Find(int opcode) const
+{
+    if (LIKELY(static_cast<uint32>(opcode) < _denseSize))
+        return _dense[opcode];
+    else if (LIKELY(_sparseCount == 0))
+        return _dftEntry;
+
+    return FindSparse(opcode);
+}
+
+inline const LLBC_OpcodeDispatchEntry &LLBC_OpcodeDispatchTable::FindSparse(int opcode) const
+{
+    for (uint32 idx = HashSparse(opcode) & _sparseMask; ; idx = (idx + 1) & _sparseMask)
+    {
+        const _SparseKey &key = _sparseKeys[idx];
+        if (!key.used)
+            return _dftEntry;
+        else if (key.opcode == opcode)
+            return _sparse[idx];
+    }
+}
+
+inline uint32 LLBC_OpcodeDispatchTable::HashSparse(int opcode)
+{
+    // Fibonacci hashing.
+    return (static_cast<uint32>(opcode) * 2654435761U) >> 7;
+}
+
+inline size_t LLBC_OpcodeDispatchTable::GetDenseSize() const
+{
+    return _denseSize;
+}
+
+inline size_t LLBC_OpcodeDispatchTable::GetSparseCount() const
+{
+    return _sparseCount;
+}
+
+__LLBC_NS_END
+
+#endif // __LLBC_COMM_OPCODE_DISPATCH_TABLE_H__
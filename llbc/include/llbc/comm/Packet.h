@@ -19,6 +19,7 @@
 __LLBC_NS_BEGIN
 class LLBC_ICoder;
 class LLBC_Session;
+class LLBC_RecvSlab;
 class LLBC_PacketHeaderDesc;
 __LLBC_NS_END
 
@@ -118,6 +119,13 @@ public:
      */
     void RemoveFlags(int flags);
 
+    /**
+     * Check packet header parts access by fixed header layout or not(see LLBC_FixedPacketHeaderLayout),
+     * if not, access by runtime packet header describe.
+     * @return bool - the fixed header layout flag.
+     */
+    bool IsFixedHeaderLayout() const;
+
 public:
     /**
      * Get special header part value APIs.
@@ -334,6 +342,33 @@ public:
      */
     size_t GetPayloadLength() const;
 
+public:
+    /**
+     * Check this packet is payload chunk or not, in service chunked receive mode, the packet
+     * which payload length exceed chunk size will be delivered as payload chunks(share same header),
+     * the chunk packet will not be decompressed and decoded.
+     * @return bool - return true if is payload chunk, otherwise return false.
+     */
+    bool IsChunk() const;
+
+    /**
+     * Get the chunk offset in whole payload, only available in chunk packet.
+     * @return size_t - the chunk offset.
+     */
+    size_t GetChunkOffset() const;
+
+    /**
+     * Get the whole payload length, only available in chunk packet.
+     * @return size_t - the whole payload length.
+     */
+    size_t GetChunkTotalLength() const;
+
+    /**
+     * Check this packet is the last chunk of whole payload or not.
+     * @return bool - return true if is last chunk, otherwise return false.
+     */
+    bool IsLastChunk() const;
+
 public:
     /**
      * Get encoder.
@@ -436,7 +471,7 @@ private:
     template <typename _RawTy>
     void RawGetFloatTypeHeaderPartVal(const char *buf, size_t bufLen, _RawTy &val) const;
     template <typename _RawTy>
-    void RawGetNonFloatTypeHeaderPartVal(const char *buf, size_t bufLen, _RawTy &val) const;
+    static void RawGetNonFloatTypeHeaderPartVal(const char *buf, size_t bufLen, _RawTy &val);
 
     /**
      * Raw set header part value to packet.
@@ -481,10 +516,68 @@ private:
      */
     void CleanupPreHandleResult();
 
+private:
+    /**
+     * Declare friend class: LLBC_PacketProtocol.
+     *  Access method list:
+     *      LLBC_Packet(LLBC_RecvSlab *, const void *, size_t)
+     *      _block
+     *      _chunkOffset
+     *      _chunkTotalLen
+     */
+    friend class LLBC_PacketProtocol;
+
+    /**
+     * Declare friend class: LLBC_PacketHeaderAssembler.
+     *  Access method list:
+     *      RawGetNonFloatTypeHeaderPartVal(const char *, size_t, _RawTy &)
+     */
+    friend class LLBC_PacketHeaderAssembler;
+
+    /**
+     * Declare friend class: LLBC_CompressProtocol.
+     *  Access method list:
+     *      ReplaceBlock(LLBC_MessageBlock *)
+     *      _block
+     */
+    friend class LLBC_CompressProtocol;
+
+    /**
+     * Declare friend class: LLBC_Service.
+     *  Access method list:
+     *      MoveDataTo(LLBC_Packet &)
+     */
+    friend class LLBC_Service;
+
+    /**
+     * Construct packet which data reference receive slab, packet will retain
+     * slab until destroyed, internal method.
+     * @param[in] slab - the receive slab.
+     * @param[in] data - the packet data(header + payload), must lie in slab.
+     * @param[in] len  - the packet data length.
+     */
+    LLBC_Packet(LLBC_RecvSlab *slab, const void *data, size_t len);
+
+    /**
+     * Replace packet data block, old block will be deleted(and release receive slab),
+     * packet length part will be updated, internal method.
+     * @param[in] block - the new data block(header + payload), packet will take over it.
+     */
+    void ReplaceBlock(LLBC_MessageBlock *block);
+
+    /**
+     * Move packet data(header + payload, include receive slab reference) to another packet
+     * without copy, the another packet old data block will hold by self, self only keep the
+     * header copy(payload become empty), internal method.
+     * @param[in] packet - the another packet, must be new created packet(no payload).
+     */
+    void MoveDataTo(LLBC_Packet &packet);
+
 private:
     const LLBC_PacketHeaderDesc *_headerDesc;
     const size_t _lenSize;
     const size_t _lenOffset;
+    const bool _fixedLayout;
 
 private:
     int _sessionId;
@@ -501,7 +594,11 @@ private:
     LLBC_IDelegate1<void *> *_resultClearDeleg;
 
     LLBC_MessageBlock *_block;
+    LLBC_RecvSlab *_slab;
     LLBC_String *_codecError;
+
+    size_t _chunkOffset;
+    size_t _chunkTotalLen;
 };
 
 __LLBC_NS_END
@@ -64,11 +64,37 @@ public:
      */
     size_t GetHeaderLen() const;
 
+    /**
+     * Get the already assembled header data length.
+     * @return size_t - the assembled length.
+     */
+    size_t GetAssembledLen() const;
+
+public:
+    /**
+     * Get the assembled packet header's length part value, must call after header assembled.
+     * @return int - the packet length part value.
+     */
+    int GetLength() const;
+
+    /**
+     * Read the packet length part value from given header buffer.
+     * If header describe match library fixed header layout, read by fixed offset and width,
+     * otherwise read by runtime header describe.
+     * @param[in] header - the header buffer, must hold whole header.
+     * @return int - the packet length part value.
+     */
+    int ReadLength(const void *header) const;
+
 private:
     char *_header;
     size_t _headerLen;
 
     size_t _curRecved;
+
+    size_t _lenOffset;
+    size_t _lenSize;
+    bool _fixedLayout;
 };
 
 __LLBC_NS_END
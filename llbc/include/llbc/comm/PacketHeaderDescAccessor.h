@@ -44,14 +44,28 @@ public:
      */
     static int SetPacketDesc(LLBC_PacketHeaderDesc *headerDesc);
 
+    /**
+     * Check the packet header describe is match library compiled fixed packet header layout or not.
+     * Note: Must call after header describe created(GetHeaderDesc()).
+     * @return bool - return true if match, otherwise return false.
+     */
+    static bool IsFixedLayout();
+
 public:
     /**
      * Cleanup the packet header describe.
      */
     static void CleanupHeaderDesc();
 
+private:
+    /**
+     * Update fixed layout flag after header describe changed.
+     */
+    static void UpdateFixedLayout();
+
 private:
     static LLBC_PacketHeaderDesc *_headerDesc;
+    static bool _fixedLayout;
 };
 
 __LLBC_NS_END
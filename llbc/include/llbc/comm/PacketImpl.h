@@ -97,6 +97,11 @@ inline int LLBC_Packet::SetHeaderPartVal(int serialNo, const LLBC_String &val)
     return this->SetHeaderPartVal(serialNo, val.data(), val.size());
 }
 
+inline bool LLBC_Packet::IsFixedHeaderLayout() const
+{
+    return _fixedLayout;
+}
+
 inline int LLBC_Packet::GetSessionId() const
 {
     return _sessionId;
@@ -127,6 +132,26 @@ inline void LLBC_Packet::SetPeerAddr(const LLBC_SockAddr_IN &addr)
     _peerAddr = addr;
 }
 
+inline bool LLBC_Packet::IsChunk() const
+{
+    return _chunkTotalLen != 0;
+}
+
+inline size_t LLBC_Packet::GetChunkOffset() const
+{
+    return _chunkOffset;
+}
+
+inline size_t LLBC_Packet::GetChunkTotalLength() const
+{
+    return _chunkTotalLen;
+}
+
+inline bool LLBC_Packet::IsLastChunk() const
+{
+    return _chunkTotalLen != 0 && _chunkOffset + GetPayloadLength() == _chunkTotalLen;
+}
+
 template <typename _Ty>
 inline int LLBC_Packet::Read(std::vector<_Ty> &val)
 {
@@ -455,7 +480,7 @@ inline void LLBC_Packet::RawGetFloatTypeHeaderPartVal(const char *buf, size_t bu
 }
 
 template <typename _RawTy>
-inline void LLBC_Packet::RawGetNonFloatTypeHeaderPartVal(const char *buf, size_t bufLen, _RawTy &val) const
+inline void LLBC_Packet::RawGetNonFloatTypeHeaderPartVal(const char *buf, size_t bufLen, _RawTy &val)
 {
     // Try test 'bufLen' variable order: 2->4->8->1->others(3,5,6,7)
     if (bufLen == 2)
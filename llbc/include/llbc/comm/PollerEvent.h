@@ -21,6 +21,7 @@ __LLBC_NS_BEGIN
 class LLBC_Packet;
 class LLBC_Socket;
 class LLBC_Session;
+class LLBC_SharedBuffer;
 
 __LLBC_NS_END
 
@@ -28,6 +29,8 @@ __LLBC_NS_BEGIN
 
 /**
  * \brief The poller event structure encapsulation.
+ *        Poller events are intrusive queue nodes(linked by next member), and all
+ *        allocate from event pool.
  */
 struct LLBC_HIDDEN LLBC_PollerEvent
 {
@@ -46,6 +49,15 @@ struct LLBC_HIDDEN LLBC_PollerEvent
         // Take over session request, once poller found it can't process the new session,
         // poller will create this event and post to appropriate brother.
         TakeOverSession,
+        // Flush send queue request, generate by Service layer, when poller send queue
+        // changed from empty to non-empty, will create this event to wake up poller.
+        FlushSend,
+        // Multicast send request, generate by Service layer, all target sessions in same poller
+        // share one encoded buffer.
+        Multicast,
+        // Send packets batch request, generate by Service layer coalesced send, all packets
+        // belong to same poller, packets will be sent in order.
+        SendBatch,
 
         // Sentinel.
         End
@@ -61,7 +73,17 @@ struct LLBC_HIDDEN LLBC_PollerEvent
         LLBC_Session *session;
         char *monitorEv;
         char *closeReason;
+        char *multicastEv;
+        char *sendBatchEv;
     } un;
+
+    LLBC_PollerEvent *next;
+
+    /**
+     * Pooled allocation/deallocation.
+     */
+    static void *operator new(size_t size);
+    static void operator delete(void *ev, size_t size);
 };
 
 /**
@@ -74,55 +96,64 @@ public:
     /**
      * Build AddSock event.
      */
-    static LLBC_MessageBlock *BuildAddSockEv(int sessionId, LLBC_Socket *sock);
+    static LLBC_PollerEvent *BuildAddSockEv(int sessionId, LLBC_Socket *sock);
     
     /**
      * Build Async-Conn event.
      */
-    static LLBC_MessageBlock *BuildAsyncConnEv(int sessionId, 
-                                               const LLBC_SockAddr_IN &peerAddr);
+    static LLBC_PollerEvent *BuildAsyncConnEv(int sessionId, 
+                                              const LLBC_SockAddr_IN &peerAddr);
 
     /**
      * Build Send event.
      */
-    static LLBC_MessageBlock *BuildSendEv(LLBC_Packet *packet);
+    static LLBC_PollerEvent *BuildSendEv(LLBC_Packet *packet);
 
     /**
      * Build close event.
      */
-    static LLBC_MessageBlock *BuildCloseEv(int sessionId, const char *reason);
+    static LLBC_PollerEvent *BuildCloseEv(int sessionId, const char *reason);
 
     /**
      * Build Iocp monitor event.
      */
 #if LLBC_TARGET_PLATFORM_WIN32
-    static LLBC_MessageBlock *BuildIocpMonitorEv(int ret, LLBC_POverlapped ol, int errNo, int subErrNo);
+    static LLBC_PollerEvent *BuildIocpMonitorEv(int ret, LLBC_POverlapped ol, int errNo, int subErrNo);
 #endif
+
     /**
-     * Build Epoll monitor event.
+     * Build take over session event.
      */
-#if LLBC_TARGET_PLATFORM_LINUX || LLBC_TARGET_PLATFORM_ANDROID
-    static LLBC_MessageBlock *BuildEpollMonitorEv(const LLBC_EpollEvent *evs, int count);
-#endif
+    static LLBC_PollerEvent *BuildTakeOverSessionEv(LLBC_Session *session);
 
     /**
-     * Build take over session event.
+     * Build flush send queue event.
+     */
+    static LLBC_PollerEvent *BuildFlushSendEv();
+
+    /**
+     * Build multicast event, event will retain the shared buffer.
+     */
+    static LLBC_PollerEvent *BuildMulticastEv(LLBC_SharedBuffer *buffer, int opcode, const int *sessionIds, int count);
+
+    /**
+     * Build send batch event, event will steal all packets.
      */
-    static LLBC_MessageBlock *BuildTakeOverSessionEv(LLBC_Session *session);
+    static LLBC_PollerEvent *BuildSendBatchEv(LLBC_Packet * const *packets, int count);
 
     /**
      * Build take over socket event(only available in WIN32 platform).
      */
 #if LLBC_TARGET_PLATFORM_WIN32
-    static LLBC_MessageBlock *BuildTakeOverSocketEv(int sessionId, LLBC_Socket *sock);
+    static LLBC_PollerEvent *BuildTakeOverSocketEv(int sessionId, LLBC_Socket *sock);
 #endif
 
 public:
     /**
-     * Destroy poller event.
+     * Destroy poller event, DestroyEv(LLBC_PollerEvent &) only destroy event attached data.
      */
     static void DestroyEv(LLBC_PollerEvent &ev);
-    static void DestroyEv(LLBC_MessageBlock *block);
+    static void DestroyEv(LLBC_PollerEvent *ev);
 };
 
 __LLBC_NS_END
@@ -13,6 +13,10 @@
 #include "llbc/core/Core.h"
 #include "llbc/objbase/ObjBase.h"
 
+#include "llbc/comm/SendStat.h"
+#include "llbc/comm/ReliableUdpOptions.h"
+#include "llbc/comm/SessionIdTable.h"
+
 __LLBC_NS_BEGIN
 
 /**
@@ -22,6 +26,8 @@ class LLBC_Packet;
 class LLBC_Socket;
 class LLBC_IService;
 class LLBC_BasePoller;
+class LLBC_SharedBuffer;
+struct LLBC_PollerEvent;
 
 __LLBC_NS_END
 
@@ -38,17 +44,55 @@ public:
 
 public:
     /**
-     * Set poller type.
+     * Set poller type, if poller type not supported by current kernel(io_uring poller), fallback to epoll poller.
      * @param[in] type - the poller type.
      */
     void SetPollerType(int type);
 
+    /**
+     * Get poller type.
+     * @return int - the poller type(the fallback poller type if fallback occurred).
+     */
+    int GetPollerType() const;
+
     /**
      * Set service.
      * @param[in] svc - the service.
      */
     void SetService(LLBC_IService *svc);
 
+    /**
+     * Set pollers recv budget of one session readable event, must call before poller manager start.
+     * @param[in] budget - the recv budget(in bytes), 0 means unlimited.
+     */
+    void SetRecvBudget(size_t budget);
+
+    /**
+     * Set pollers session send queue water marks, must call before poller manager start.
+     * @param[in] lowWaterMark  - the low water mark(in bytes).
+     * @param[in] highWaterMark - the high water mark(in bytes), 0 means disable backpressure.
+     */
+    void SetSendWaterMarks(size_t lowWaterMark, size_t highWaterMark);
+
+    /**
+     * Set pollers default backpressure policy, must call before poller manager start.
+     * @param[in] policy - the backpressure policy.
+     */
+    void SetBackpressurePolicy(int policy);
+
+    /**
+     * Set pollers specified opcode's backpressure policy, must call before poller manager start.
+     * @param[in] opcode - the opcode.
+     * @param[in] policy - the backpressure policy.
+     */
+    void SetOpcodeBackpressurePolicy(int opcode, int policy);
+
+    /**
+     * Set pollers reliable udp session options, must call before poller manager start.
+     * @param[in] opts - the reliable udp options.
+     */
+    void SetReliableUdpOptions(const LLBC_ReliableUdpOptions &opts);
+
 public:
     /**
      * Startup poller manager.
@@ -72,6 +116,17 @@ public:
      */
     int Listen(const char *ip, uint16 port);
 
+    /**
+     * Listen in specified local address, every poller create its own SO_REUSEPORT listen socket(call by service),
+     * kernel will load-balance incoming connections to all pollers, accepted sessions stay in accepting poller.
+     * Note: must call after poller manager started.
+     * @param[in] ip          - the ip address.
+     * @param[in] port        - the port number.
+     * @param[out] sessionIds - the listen session Ids, one session per poller.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    int ListenReusePort(const char *ip, uint16 port, LLBC_SessionIdList &sessionIds);
+
     /**
      * Connect to peer address(call by service).
      * @param[in] ip   - the ip address.
@@ -81,6 +136,22 @@ public:
      */
     int Connect(const char *ip, uint16 port);
 
+    /**
+     * Listen reliable udp sessions in specified local address(call by service).
+     * @param[in] ip   - the ip address.
+     * @param[in] port - the port number.
+     * @return int - the new session Id, if return 0, means listen failed.
+     */
+    int ListenReliableUdp(const char *ip, uint16 port);
+
+    /**
+     * Connect to reliable udp peer address(call by service).
+     * @param[in] ip   - the ip address.
+     * @param[in] port - the port number.
+     * @return int - the new session Id, if return 0, means connect failed.
+     */
+    int ConnectReliableUdp(const char *ip, uint16 port);
+
     /**
      * Asynchronous connect to peer address(call by service).
      * @param[in] ip   - the ip address.
@@ -92,12 +163,30 @@ public:
     int AsyncConn(const char *ip, uint16 port);
 
     /**
-     * Send packet.
+     * Send packet, thread safe, packet will push to the session's poller lock-free send queue.
      * @param[in] packet - the packet.
      * @return int - return 0 if success, otherwise return -1.
      */
     int Send(LLBC_Packet *packet);
 
+    /**
+     * Multicast shared buffer, thread safe, session Ids will be grouped by poller,
+     * every poller only push one multicast event to its lock-free send queue.
+     * @param[in] buffer     - the shared buffer, pollers will retain it.
+     * @param[in] opcode     - the multicast packet opcode, use to apply backpressure policy.
+     * @param[in] sessionIds - the target session Ids.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    int Multicast(LLBC_SharedBuffer *buffer, int opcode, const LLBC_SessionIdList &sessionIds);
+
+    /**
+     * Send packets batch, thread safe, packets will be grouped by poller, every poller
+     * only push one send batch event to its lock-free send queue, packets order will be kept.
+     * @param[in] packets - the packets, all packets will be stolen.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    int SendBatch(const std::vector<LLBC_Packet *> &packets);
+
     /**
      * Close session.
      * @param[in] sessionId - the session Id.
@@ -105,6 +194,34 @@ public:
      */
     void Close(int sessionId, const char *reason = NULL);
 
+    /**
+     * Get all pollers send statistic, thread safe.
+     * @param[out] stat - the send statistic, all pollers statistic will accumulate to it.
+     */
+    void GetSendStat(LLBC_SendStat &stat);
+
+    /**
+     * Get all pollers receive statistic, thread safe.
+     * @param[out] stat - the receive statistic, all pollers statistic will accumulate to it.
+     */
+    void GetRecvStat(LLBC_RecvStat &stat);
+
+    /**
+     * Get session send queue size(queued not sent bytes), thread safe.
+     * @param[in] sessionId  - the session Id.
+     * @param[out] queueSize - the send queue size.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    int GetSendQueueSize(int sessionId, size_t &queueSize) const;
+
+    /**
+     * Get session live receive statistic, thread safe.
+     * @param[in] sessionId - the session Id.
+     * @param[out] stat     - the session receive statistic.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    int GetSessionRecvStat(int sessionId, LLBC_RecvStat &stat) const;
+
 private:
     /**
      * Allocate new session Id, call by self or Poller.
@@ -113,13 +230,20 @@ private:
     int AllocSessionId();
 
     /**
-     * Push specific message to poller, call by Poller.
-     * @param[in] id    - the poller Id.
-     * @param[in] block - the message block.
+     * Allocate new session Id which belong to specific poller(sessionId % pollerCount == pollerId), call by Poller.
+     * @param[in] pollerId - the poller Id.
+     * @return int - the new session Id.
+     */
+    int AllocSessionId(int pollerId);
+
+    /**
+     * Push specific event to poller, call by Poller.
+     * @param[in] id - the poller Id.
+     * @param[in] ev - the poller event.
      * @return int - return 0 if success, otherwise return -1.
      *               Note, this method not set last(for performance sake).
      */
-    int PushMsgToPoller(int id, LLBC_MessageBlock *block);
+    int PushMsgToPoller(int id, LLBC_PollerEvent *ev);
 
     /**
      * When poller stop, will call this method.
@@ -138,15 +262,39 @@ private:
      */
     friend class LLBC_BasePoller;
 
+    /**
+     * The session statistic values index in session statistic table.
+     */
+    struct _SessionStatIdx
+    {
+        enum
+        {
+            SendQueueSize,
+            RecvEvents,
+            RecvCalls,
+            RecvBytes,
+            RecvBudgetExhausts,
+
+            End
+        };
+    };
+
 private:
     int _type;
     LLBC_IService *_svc;
 
     int _pollerCount;
+    size_t _recvBudget;
+    size_t _sendLowWaterMark;
+    size_t _sendHighWaterMark;
+    int _backpressurePolicy;
+    std::map<int, int> _opcodeBackpressurePolicies;
+    LLBC_ReliableUdpOptions _rudpOpts;
     LLBC_BasePoller **_pollers;
     LLBC_SpinLock _pollerLock;
 
     int _maxSessionId;
+    LLBC_SessionIdTable _sessionStats;
 
     typedef std::map<int, LLBC_Socket *> _PendingAddSocks;
     _PendingAddSocks _pendingAddSocks;
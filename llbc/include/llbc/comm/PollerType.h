@@ -30,6 +30,9 @@ public:
         IocpPoller,     // Iocp poller only availables in WIN32 platform.
 #elif LLBC_TARGET_PLATFORM_LINUX || LLBC_TARGET_PLATFORM_ANDROID
         EpollPoller,    // Epoll poller availables on LINUX & ANDROID platforms.
+ #if LLBC_TARGET_PLATFORM_LINUX
+        IoUringPoller,  // io_uring poller availables on LINUX platform(kernel 6.0+, otherwise fallback to EpollPoller).
+ #endif // LLBC_TARGET_PLATFORM_LINUX
 #endif // LLBC_TARGET_PLATFORM_WIN32
 
         End
@@ -0,0 +1,218 @@
+/**
+ * @file    RecvSlab.h
+ * @author  Longwei Lai<lailongwei@126.com>
+ * @date    2026/10/18
+ * @version 1.0
+ *
+ * @brief   The poller receive slab & slab pool.
+ */
+#ifndef __LLBC_COMM_RECV_SLAB_H__
+#define __LLBC_COMM_RECV_SLAB_H__
+
+#include "llbc/common/Common.h"
+#include "llbc/core/Core.h"
+
+__LLBC_NS_BEGIN
+
+/**
+ * Previous declare some classes.
+ */
+class LLBC_RecvSlabPool;
+
+__LLBC_NS_END
+
+__LLBC_NS_BEGIN
+
+/**
+ * \brief The receive slab class encapsulation.
+ *
+ * Receive slab is a fixed-size, reference counted buffer, poller sockets receive
+ * data into slab one by one(bump allocate), the packets which data entirely lie in
+ * one slab will reference the slab without copy.
+ * Slab write operations only can call in poller thread, Retain/Release are thread safe,
+ * when reference count reach zero, slab will recycle to its pool.
+ */
+class LLBC_HIDDEN LLBC_RecvSlab
+{
+public:
+    /**
+     * Retain slab, thread safe.
+     */
+    void Retain();
+
+    /**
+     * Release slab, thread safe, if reference count reach zero, slab will recycle to pool.
+     */
+    void Release();
+
+public:
+    /**
+     * Get slab buffer.
+     * @return char * - the slab buffer.
+     */
+    char *GetBuf() const;
+
+    /**
+     * Get slab buffer size.
+     * @return size_t - the buffer size.
+     */
+    size_t GetSize() const;
+
+    /**
+     * Get slab write position.
+     * @return size_t - the write position.
+     */
+    size_t GetWritePos() const;
+
+    /**
+     * Get slab writable buffer.
+     * @return char * - the writable buffer.
+     */
+    char *GetWritable() const;
+
+    /**
+     * Get slab writable size.
+     * @return size_t - the writable size.
+     */
+    size_t GetWritableSize() const;
+
+    /**
+     * Shift slab write position.
+     * @param[in] len - the shift length, must less than or equal to writable size.
+     */
+    void ShiftWritePos(size_t len);
+
+private:
+    friend class LLBC_RecvSlabPool;
+
+    /**
+     * Constructor & Destructor, only slab pool can create/destroy slab.
+     */
+    LLBC_RecvSlab(LLBC_RecvSlabPool *pool, size_t size);
+    ~LLBC_RecvSlab();
+
+    LLBC_DISABLE_ASSIGNMENT(LLBC_RecvSlab);
+
+private:
+    LLBC_RecvSlabPool *_pool;
+    volatile sint32 _refCount;
+
+    char *_buf;
+    size_t _size;
+    size_t _writePos;
+};
+
+/**
+ * \brief The receive slab pool class encapsulation.
+ *
+ * Every poller own one slab pool, the pool hold a current slab, sockets receive data
+ * into current slab, when current slab writable size less than min receive size,
+ * pool will switch to a recycled slab(or create new slab).
+ * Slabs maybe released in service thread(the packets destroyed), so recycle operation is
+ * thread safe. Pool self is reference counted by owner and all in-use slabs, after owner
+ * destroy pool, pool will delete self when the last in-use slab released.
+ */
+class LLBC_HIDDEN LLBC_RecvSlabPool
+{
+public:
+    /**
+     * Constructor.
+     * @param[in] slabSize       - the slab size.
+     * @param[in] minRecvSize    - the min receive size, if current slab writable size less than it,
+     *                             pool will switch to next slab.
+     * @param[in] maxRecycledNum - the max recycled slabs count.
+     */
+    LLBC_RecvSlabPool(size_t slabSize = LLBC_CFG_COMM_RECV_SLAB_SIZE,
+                      size_t minRecvSize = LLBC_CFG_COMM_RECV_SLAB_MIN_RECV_SIZE,
+                      size_t maxRecycledNum = LLBC_CFG_COMM_RECV_SLAB_POOL_SIZE);
+
+public:
+    /**
+     * Get current slab, current slab writable size always greater than or equal to min receive size,
+     * only can call in owner thread.
+     * @return LLBC_RecvSlab * - the current slab.
+     */
+    LLBC_RecvSlab *GetCurrent();
+
+    /**
+     * Get current slab, current slab writable size always greater than or equal to given min writable size
+     * (if exceed slab size, use slab size), only can call in owner thread.
+     * @param[in] minWritable - the min writable size.
+     * @return LLBC_RecvSlab * - the current slab.
+     */
+    LLBC_RecvSlab *GetCurrent(size_t minWritable);
+
+    /**
+     * Acquire a free slab(not the current slab), caller own one slab reference and write slab
+     * directly(eg: provide slab buffer to kernel), only can call in owner thread.
+     * @return LLBC_RecvSlab * - the empty slab, call slab Release() when not use any more.
+     */
+    LLBC_RecvSlab *Acquire();
+
+    /**
+     * Destroy pool, only owner can call, after call, owner can't use pool any more.
+     */
+    void Destroy();
+
+private:
+    friend class LLBC_RecvSlab;
+
+    /**
+     * Destructor, pool delete self when reference count reach zero.
+     */
+    ~LLBC_RecvSlabPool();
+
+    /**
+     * Recycle slab, thread safe, call by slab when slab reference count reach zero.
+     * @param[in] slab - the slab.
+     */
+    void Recycle(LLBC_RecvSlab *slab);
+
+    /**
+     * Release pool reference, if reference count reach zero, delete self.
+     */
+    void ReleaseRef();
+
+    LLBC_DISABLE_ASSIGNMENT(LLBC_RecvSlabPool);
+
+private:
+    const size_t _slabSize;
+    const size_t _minRecvSize;
+    const size_t _maxRecycledNum;
+
+    volatile sint32 _refCount;
+    LLBC_RecvSlab *_current;
+
+    LLBC_SpinLock _lock;
+    std::vector<LLBC_RecvSlab *> _recycled;
+};
+
+/**
+ * \brief The receive slab block class encapsulation.
+ *
+ * Attached to packet data which lie in receive slab, retain slab until destroyed,
+ * use to hand over slab referenced packet data to poller without copy.
+ */
+class LLBC_HIDDEN LLBC_RecvSlabBlock : public LLBC_MessageBlock
+{
+public:
+    /**
+     * Constructor & Destructor.
+     * @param[in] slab - the receive slab.
+     * @param[in] data - the data, must lie in slab.
+     * @param[in] len  - the data length.
+     */
+    LLBC_RecvSlabBlock(LLBC_RecvSlab *slab, void *data, size_t len);
+    virtual ~LLBC_RecvSlabBlock();
+
+    LLBC_DISABLE_ASSIGNMENT(LLBC_RecvSlabBlock);
+
+private:
+    LLBC_RecvSlab *_slab;
+};
+
+__LLBC_NS_END
+
+#include "llbc/comm/RecvSlabImpl.h"
+
+#endif // !__LLBC_COMM_RECV_SLAB_H__
@@ -0,0 +1,57 @@
+/**
+ * @file    RecvSlabImpl.h
+ * @author  Longwei Lai<lailongwei@126.com>
+ * @date    2026/10/18
+ * @version 1.0
+ *
+ * @brief   The receive slab inline implementations.
+ */
+#ifdef __LLBC_COMM_RECV_SLAB_H__
+
+__LLBC_NS_BEGIN
+
+inline void LLBC_RecvSlab::Retain()
+{
+    LLBC_AtomicFetchAndAdd(&_refCount, 1);
+}
+
+inline void LLBC_RecvSlab::Release()
+{
+    if (LLBC_AtomicFetchAndSub(&_refCount, 1) == 1)
+        _pool->Recycle(this);
+}
+
+inline char *LLBC_RecvSlab::GetBuf() const
+{
+    return _buf;
+}
+
+inline size_t LLBC_RecvSlab::GetSize() const
+{
+    return _size;
+}
+
+inline size_t LLBC_RecvSlab::GetWritePos() const
+{
+    return _writePos;
+}
+
+inline char *LLBC_RecvSlab::GetWritable() const
+{
+    return _buf + _writePos;
+}
+
+inline size_t LLBC_RecvSlab::GetWritableSize() const
+{
+    return _size - _writePos;
+}
+
+inline void LLBC_RecvSlab::ShiftWritePos(size_t len)
+{
+    ASSERT(len <= GetWritableSize() && "LLBC_RecvSlab shift write pos out of range!");
+    _writePos += len;
+}
+
+__LLBC_NS_END
+
+#endif // __LLBC_COMM_RECV_SLAB_H__
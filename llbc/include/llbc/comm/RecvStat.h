@@ -0,0 +1,64 @@
+/**
+ * @file    RecvStat.h
+ * @author  Longwei Lai<lailongwei@126.com>
+ * @date    2026/10/18
+ * @version 1.0
+ *
+ * @brief
+ */
+#ifndef __LLBC_COMM_RECV_STAT_H__
+#define __LLBC_COMM_RECV_STAT_H__
+
+#include "llbc/common/Common.h"
+#include "llbc/core/Core.h"
+
+__LLBC_NS_BEGIN
+
+/**
+ * \brief The socket receive statistic structure encapsulation.
+ *
+ * Every readable event, socket receive at most poller recv budget bytes, if budget exhausted
+ * and data still remain, the session will be re-armed and continue receive in next poller loop,
+ * budgetExhausts shows how many times the session be cut off for fairness.
+ */
+struct LLBC_EXPORT LLBC_RecvStat
+{
+    uint64 recvEvents;     // The readable events count.
+    uint64 recvCalls;      // The recv system calls count(include would-block calls).
+    uint64 recvBytes;      // The received bytes.
+    uint64 budgetExhausts; // The recv budget exhausted times.
+
+    LLBC_RecvStat();
+
+    /**
+     * Reset all counters to zero.
+     */
+    void Reset();
+
+    /**
+     * Get average received bytes per readable event.
+     * @return double - the average received bytes per event, if no event, return 0.
+     */
+    double GetBytesPerEvent() const;
+
+    /**
+     * Get average received bytes per recv call.
+     * @return double - the average received bytes per call, if no recv call, return 0.
+     */
+    double GetBytesPerCall() const;
+
+    /**
+     * Accumulate other statistic.
+     */
+    LLBC_RecvStat &operator +=(const LLBC_RecvStat &other);
+
+    /**
+     * Get the statistic string representation.
+     * @return LLBC_String - the string representation.
+     */
+    LLBC_String ToString() const;
+};
+
+__LLBC_NS_END
+
+#endif // !__LLBC_COMM_RECV_STAT_H__
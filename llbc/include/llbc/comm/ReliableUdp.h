@@ -0,0 +1,247 @@
+/**
+ * @file    ReliableUdp.h
+ * @author  Longwei Lai<lailongwei@126.com>
+ * @date    2026/10/18
+ * @version 1.0
+ *
+ * @brief   The reliable udp ARQ engine.
+ */
+#ifndef __LLBC_COMM_RELIABLE_UDP_H__
+#define __LLBC_COMM_RELIABLE_UDP_H__
+
+#include "llbc/common/Common.h"
+#include "llbc/core/Core.h"
+
+#include "llbc/comm/ReliableUdpOptions.h"
+
+__LLBC_NS_BEGIN
+
+/**
+ * \brief The reliable udp ARQ engine encapsulation(KCP-like, stream mode).
+ *
+ * Every datagram contains one or more segments, segment header layout(little endian, 24 bytes):
+ *      conv(4) | cmd(1) | frg(1) | wnd(2) | ts(4) | sn(4) | una(4) | len(4)
+ * Engine acknowledges every received push segment(selective ack), and carry the cumulative
+ * ack(una) in all segments, the segment skipped by fastResend later acks will be fast retransmitted,
+ * the segment not acked in rto will be retransmitted(rto backoff 1.5x).
+ * The first push segment(sn == 0) send by the connecting side is the open marker, the listen side
+ * use it to create session.
+ * Engine write datagrams to connected udp socket directly, all methods only can call in poller thread.
+ */
+class LLBC_HIDDEN LLBC_ReliableUdp
+{
+public:
+    /**
+     * The segment commands.
+     */
+    enum
+    {
+        CmdPush = 81,
+        CmdAck = 82,
+        CmdWndAsk = 83,
+        CmdWndTell = 84,
+        CmdFin = 85
+    };
+
+    /**
+     * The segment header size.
+     */
+    static const size_t HeaderSize = 24;
+
+public:
+    /**
+     * Construct reliable udp engine.
+     * @param[in] conv   - the conversation Id, both sides must same.
+     * @param[in] handle - the connected udp socket handle.
+     * @param[in] opts   - the reliable udp options.
+     */
+    LLBC_ReliableUdp(uint32 conv, LLBC_SocketHandle handle, const LLBC_ReliableUdpOptions &opts);
+    ~LLBC_ReliableUdp();
+
+public:
+    /**
+     * Get conversation Id.
+     * @return uint32 - the conversation Id.
+     */
+    uint32 GetConv() const;
+
+    /**
+     * Check the datagram is open datagram(contains open marker) or not.
+     * @param[in]  data - the datagram data.
+     * @param[in]  len  - the datagram length.
+     * @param[out] conv - the conversation Id.
+     * @return bool - return true if is open datagram, otherwise return false.
+     */
+    static bool IsOpenDatagram(const char *data, size_t len, uint32 &conv);
+
+public:
+    /**
+     * Queue stream data to send, if len is 0, will queue the open marker.
+     * @param[in] data - the data.
+     * @param[in] len  - the data length.
+     */
+    void Send(const char *data, size_t len);
+
+    /**
+     * Input received datagram.
+     * @param[in] data - the datagram data.
+     * @param[in] len  - the datagram length.
+     * @return int - return 0 if success, otherwise return -1(bad datagram, ignored).
+     */
+    int Input(const char *data, size_t len);
+
+    /**
+     * Get received in-order stream data size.
+     * @return size_t - the receivable size.
+     */
+    size_t GetRecvableSize() const;
+
+    /**
+     * Receive in-order stream data.
+     * @param[in] buf - the buffer.
+     * @param[in] len - the buffer length.
+     * @return size_t - the received bytes.
+     */
+    size_t Recv(char *buf, size_t len);
+
+    /**
+     * Flush acks, window probes, new push segments and the segments need retransmit.
+     */
+    void Flush();
+
+    /**
+     * Update engine, flush if update interval reached, and output the simulator delayed datagrams.
+     */
+    void Update();
+
+    /**
+     * Send fin datagram(best-effort, not retransmit) to peer.
+     */
+    void SendFin();
+
+public:
+    /**
+     * Get the not acked data size(include queued data).
+     * @return size_t - the wait send size.
+     */
+    size_t GetWaitSendSize() const;
+
+    /**
+     * Check peer sent fin or not.
+     * @return bool - the peer closed flag.
+     */
+    bool IsPeerClosed() const;
+
+    /**
+     * Check the link is dead or not(retransmit times reach dead link or idle timeout).
+     * @return bool - the dead flag.
+     */
+    bool IsDead() const;
+
+    /**
+     * Get statistic.
+     */
+    uint64 GetSentDatagrams() const;
+    uint64 GetSentBytes() const;
+    uint64 GetRetransmits() const;
+    uint64 GetFastRetransmits() const;
+    uint64 GetSimulatedLosses() const;
+
+private:
+    /**
+     * The segment structure, data stored after structure(capacity is mss).
+     */
+    struct _Segment
+    {
+        uint32 conv;
+        uint32 cmd;
+        uint32 frg;
+        uint32 wnd;
+        uint32 ts;
+        uint32 sn;
+        uint32 una;
+        uint32 len;
+
+        uint32 resendTs;
+        uint32 rto;
+        uint32 fastAck;
+        uint32 xmit;
+
+        char *Data();
+    };
+
+    typedef std::deque<_Segment *> _Segments;
+
+private:
+    _Segment *NewSegment(size_t dataLen);
+    void DeleteSegment(_Segment *seg);
+    void DeleteSegments(_Segments &segs);
+
+    static char *EncodeSegment(char *ptr, const _Segment &seg);
+    static const char *DecodeSegment(const char *ptr, _Segment &seg);
+
+    void UpdateAck(sint32 rtt);
+    void ShrinkBuf();
+    void ParseAck(uint32 sn);
+    void ParseUna(uint32 una);
+    void ParseFastAck(uint32 sn);
+    void ParseData(_Segment *newSeg);
+    void MoveRecvedSegments();
+    uint32 GetUnusedWnd() const;
+
+    void Output(const char *data, size_t len);
+    void RawOutput(const char *data, size_t len);
+    void FlushDelayedDatagrams();
+
+    static uint32 Now();
+
+private:
+    uint32 _conv;
+    LLBC_SocketHandle _handle;
+    LLBC_ReliableUdpOptions _opts;
+    uint32 _mss;
+
+    uint32 _sndUna;
+    uint32 _sndNxt;
+    uint32 _rcvNxt;
+    uint32 _rmtWnd;
+
+    sint32 _rxRttVal;
+    sint32 _rxSrtt;
+    sint32 _rxRto;
+
+    uint32 _current;
+    uint32 _tsFlush;
+    uint32 _tsLastRecv;
+    uint32 _tsLastOutput;
+
+    int _probe;
+    uint32 _tsProbe;
+    uint32 _probeWait;
+
+    bool _peerClosed;
+    bool _dead;
+
+    _Segments _sndQueue;
+    _Segments _sndBuf;
+    _Segments _rcvQueue;
+    _Segments _rcvBuf;
+    size_t _rcvQueueOffset;
+    size_t _rcvQueueSize;
+    size_t _waitSendSize;
+
+    std::vector<std::pair<uint32, uint32> > _ackList;
+    char *_buf;
+
+    std::multimap<sint64, LLBC_String> _delayedDatagrams;
+
+    uint64 _sentDatagrams;
+    uint64 _sentBytes;
+    uint64 _retransmits;
+    uint64 _fastRetransmits;
+    uint64 _simulatedLosses;
+};
+
+__LLBC_NS_END
+
+#endif // !__LLBC_COMM_RELIABLE_UDP_H__
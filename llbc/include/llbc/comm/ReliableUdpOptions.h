@@ -0,0 +1,62 @@
+/**
+ * @file    ReliableUdpOptions.h
+ * @author  Longwei Lai<lailongwei@126.com>
+ * @date    2026/10/18
+ * @version 1.0
+ *
+ * @brief
+ */
+#ifndef __LLBC_COMM_RELIABLE_UDP_OPTIONS_H__
+#define __LLBC_COMM_RELIABLE_UDP_OPTIONS_H__
+
+#include "llbc/common/Common.h"
+#include "llbc/core/Core.h"
+
+__LLBC_NS_BEGIN
+
+/**
+ * \brief The reliable udp session options structure encapsulation.
+ *
+ * Reliable udp session use ARQ(selective ack + fast retransmit) over connected udp socket,
+ * the loss/latency simulator fields only use to test reliable udp session in lossless network(eg: loopback),
+ * simulator applied to the datagrams sent by the session, must keep zero in production.
+ */
+struct LLBC_EXPORT LLBC_ReliableUdpOptions
+{
+    uint32 mtu;          // The datagram max size(include segment header).
+    uint32 sendWnd;      // The send window size(in segments).
+    uint32 recvWnd;      // The receive window size(in segments).
+    uint32 interval;     // The update interval(in milli-seconds).
+    uint32 fastResend;   // The fast retransmit threshold, 0 means disable fast retransmit.
+    uint32 minRto;       // The min retransmission timeout(in milli-seconds).
+    uint32 deadLink;     // The dead link threshold(segment max transmit times).
+    uint32 idleTimeout;  // The idle timeout(in milli-seconds), 0 means no idle check.
+
+    double lossRate;     // The simulator datagram loss rate, in [0.0, 1.0).
+    uint32 latency;      // The simulator datagram fixed latency(in milli-seconds).
+    uint32 jitter;       // The simulator datagram random extra latency(in milli-seconds), cause datagrams reordering.
+
+    LLBC_ReliableUdpOptions();
+
+    /**
+     * Check options is valid or not.
+     * @return bool - return true if valid, otherwise return false.
+     */
+    bool IsValid() const;
+
+    /**
+     * Check loss/latency simulator enabled or not.
+     * @return bool - the simulator enabled flag.
+     */
+    bool IsSimulatorEnabled() const;
+
+    /**
+     * Get the options string representation.
+     * @return LLBC_String - the string representation.
+     */
+    LLBC_String ToString() const;
+};
+
+__LLBC_NS_END
+
+#endif // !__LLBC_COMM_RELIABLE_UDP_OPTIONS_H__
@@ -0,0 +1,100 @@
+/**
+ * @file    SendStat.h
+ * @author  Longwei Lai<lailongwei@126.com>
+ * @date    2026/10/18
+ * @version 1.0
+ *
+ * @brief
+ */
+#ifndef __LLBC_COMM_SEND_STAT_H__
+#define __LLBC_COMM_SEND_STAT_H__
+
+#include "llbc/common/Common.h"
+#include "llbc/core/Core.h"
+
+__LLBC_NS_BEGIN
+
+/**
+ * \brief The socket send statistic structure encapsulation.
+ *
+ * Socket flush queued blocks with gather-send API(writev), one send call can send many blocks,
+ * compare sendCalls with sentBlocks can see the syscalls saved by gather-send.
+ */
+struct LLBC_EXPORT LLBC_SendStat
+{
+    uint64 sendCalls;  // The send system calls count(include would-block calls).
+    uint64 sentBlocks; // The fully sent message blocks count.
+    uint64 sentBytes;  // The sent bytes.
+
+    LLBC_SendStat();
+
+    /**
+     * Reset all counters to zero.
+     */
+    void Reset();
+
+    /**
+     * Get average sent blocks count per send call.
+     * @return double - the average sent blocks per call, if no send call, return 0.
+     */
+    double GetBlocksPerCall() const;
+
+    /**
+     * Get average sent bytes per send call.
+     * @return double - the average sent bytes per call, if no send call, return 0.
+     */
+    double GetBytesPerCall() const;
+
+    /**
+     * Accumulate other statistic.
+     */
+    LLBC_SendStat &operator +=(const LLBC_SendStat &other);
+
+    /**
+     * Get the statistic string representation.
+     * @return LLBC_String - the string representation.
+     */
+    LLBC_String ToString() const;
+};
+
+/**
+ * \brief The service coalesced send statistic structure encapsulation.
+ *
+ * In coalesced send mode, packets sent in service thread will be accumulated, and flushed to pollers
+ * as batches(one event per poller), compare coalescedPackets with flushes can see the poller queue
+ * traffic saved by coalesced send.
+ */
+struct LLBC_EXPORT LLBC_CoalescedSendStat
+{
+    uint64 coalescedPackets;    // The coalesced packets count.
+    uint64 flushes;             // The flushes count.
+    uint64 frameEndFlushes;     // The flushes triggered by service frame end.
+    uint64 bytesLimitFlushes;   // The flushes triggered by session pending bytes limit.
+    uint64 bytesLimitPackets;   // The packets flushed by session pending bytes limit(only the exceeded session).
+    uint64 latencyLimitFlushes; // The flushes triggered by pending latency limit.
+    uint64 forceFlushes;        // The flushes triggered by keep order operations(multicast, remove session).
+    sint64 maxLatency;          // The max pending latency of flushed packets, in milli-seconds.
+
+    LLBC_CoalescedSendStat();
+
+    /**
+     * Reset all counters to zero.
+     */
+    void Reset();
+
+    /**
+     * Get average flushed packets count per flush.
+     * @return double - the average flushed packets per flush, if no flush, return 0.
+     */
+    double GetPacketsPerFlush() const;
+
+    /**
+     * Get the statistic string representation.
+     * @return LLBC_String - the string representation.
+     */
+    LLBC_String ToString() const;
+};
+
+__LLBC_NS_END
+
+#endif // !__LLBC_COMM_SEND_STAT_H__
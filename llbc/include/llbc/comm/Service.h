@@ -16,6 +16,10 @@
 #include "llbc/comm/IService.h"
 #include "llbc/comm/ServiceEvent.h"
 #include "llbc/comm/PollerMgr.h"
+#include "llbc/comm/SessionIdTable.h"
+#include "llbc/comm/OpcodeDispatchTable.h"
+#include "llbc/comm/TrafficStatCollector.h"
+#include "llbc/comm/ServiceWorker.h"
 #if !LLBC_CFG_COMM_USE_FULL_STACK
 #include "llbc/comm/protocol/ProtocolStack.h"
 #endif
@@ -88,6 +92,135 @@ public:
      */
     virtual int SuppressCoderNotFoundWarning();
 
+    /**
+     * Set the Compress-Layer compress policy, only available in Non-Raw type service,
+     * and must be called before service start.
+     * @param[in] policy    - the compress policy, see LLBC_CompressPolicy.
+     * @param[in] threshold - the compress threshold(payload length), use in LLBC_CompressPolicy::Threshold policy.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    virtual int SetCompressPolicy(int policy, size_t threshold = LLBC_CFG_COMM_DFT_COMPRESS_THRESHOLD);
+
+    /**
+     * Set the opcode specific compress policy, it will override service compress policy,
+     * must be called before service start.
+     * @param[in] opcode - the opcode.
+     * @param[in] policy - the compress policy, see LLBC_CompressPolicy.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    virtual int SetOpcodeCompressPolicy(int opcode, int policy);
+
+    /**
+     * Set the max packet length(header + payload), only available in Non-Raw type service,
+     * and must be called before service start.
+     * @param[in] maxPacketLen - the max packet length, 0 means no limit.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    virtual int SetMaxPacketLength(size_t maxPacketLen);
+
+    /**
+     * Enable/Disable chunked receive mode, only available in Non-Raw type service,
+     * and must be called before service start.
+     * @param[in] enabled   - enable chunked receive mode or not.
+     * @param[in] chunkSize - the chunk size, must be greater than 0.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    virtual int SetChunkedRecv(bool enabled, size_t chunkSize = LLBC_CFG_COMM_DFT_RECV_CHUNK_SIZE);
+
+    /**
+     * Enable/Disable coalesced send mode, must be called before service start.
+     * @param[in] enabled    - enable coalesced send mode or not.
+     * @param[in] maxBytes   - the session max pending bytes(payload length), must be greater than 0.
+     * @param[in] maxLatency - the max pending latency, in milli-seconds, 0 means no latency limit.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    virtual int SetCoalescedSend(bool enabled,
+                                 size_t maxBytes = LLBC_CFG_COMM_DFT_COALESCED_SEND_MAX_BYTES,
+                                 int maxLatency = LLBC_CFG_COMM_DFT_COALESCED_SEND_MAX_LATENCY);
+
+    /**
+     * Set the recv budget of one session readable event, must be called before service start.
+     * @param[in] budget - the recv budget(in bytes), 0 means unlimited(receive until would-block).
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    virtual int SetRecvBudget(size_t budget = LLBC_CFG_COMM_DFT_RECV_BUDGET);
+
+    /**
+     * Set the session send queue water marks, must be called before service start.
+     * @param[in] lowWaterMark  - the low water mark(in bytes), must less than high water mark.
+     * @param[in] highWaterMark - the high water mark(in bytes), 0 means disable backpressure.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    virtual int SetSendWaterMarks(size_t lowWaterMark = LLBC_CFG_COMM_DFT_SEND_LOW_WATER_MARK,
+                                  size_t highWaterMark = LLBC_CFG_COMM_DFT_SEND_HIGH_WATER_MARK);
+
+    /**
+     * Set the default backpressure policy, must be called before service start.
+     * @param[in] policy - the backpressure policy.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    virtual int SetBackpressurePolicy(int policy);
+
+    /**
+     * Set the specified opcode's backpressure policy, must be called before service start.
+     * @param[in] opcode - the opcode.
+     * @param[in] policy - the backpressure policy.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    virtual int SetOpcodeBackpressurePolicy(int opcode, int policy);
+
+    /**
+     * Set the reliable udp session options, must be called before service start.
+     * @param[in] opts - the reliable udp options.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    virtual int SetReliableUdpOptions(const LLBC_ReliableUdpOptions &opts);
+
+    /**
+     * Enable/Disable traffic statistic, must be called before service start.
+     * @param[in] enabled      - enable traffic statistic or not.
+     * @param[in] dumpInterval - the dump interval, in milli-seconds, 0 means not dump.
+     * @param[in] loggerName   - the dump logger name, NULL or empty means root logger.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    virtual int SetTrafficStat(bool enabled, int dumpInterval = 0, const char *loggerName = NULL);
+
+    /**
+     * Set the session-affine dispatch workers count, must be called before service start.
+     * @param[in] workerCount - the workers count, 0 means disable.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    virtual int SetDispatchWorkers(int workerCount);
+
+    /**
+     * Declare opcode handler is session-local or not, must be called before service start.
+     * @param[in] opcode       - the opcode.
+     * @param[in] sessionLocal - the session-local flag.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    virtual int SetOpcodeSessionLocal(int opcode, bool sessionLocal = true);
+
+    /**
+     * Get the session send queue size(queued not sent bytes), thread safe.
+     * @param[in] sessionId  - the session Id.
+     * @param[out] queueSize - the send queue size.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    virtual int GetSendQueueSize(int sessionId, size_t &queueSize) const;
+
+    /**
+     * Get the service poller type.
+     * @return int - the poller type.
+     */
+    virtual int GetPollerType() const;
+
+    /**
+     * Set the service poller type, must be called before service start.
+     * @param[in] type - the poller type.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    virtual int SetPollerType(int type);
+
 public:
     /**
      * Startup service, default will startup one poller to work.
@@ -126,6 +259,42 @@ public:
      */
     virtual int GetFrameInterval() const;
 
+    /**
+     * Get service all pollers send statistic(send system calls, sent blocks and bytes).
+     * @param[out] stat - the send statistic.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    virtual int GetSendStat(LLBC_SendStat &stat) const;
+
+    /**
+     * Get service all pollers receive statistic.
+     * @param[out] stat - the receive statistic.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    virtual int GetRecvStat(LLBC_RecvStat &stat) const;
+
+    /**
+     * Get the live session receive statistic, thread safe.
+     * @param[in] sessionId - the session Id.
+     * @param[out] stat     - the session receive statistic.
+     * @return int - return 0 if success, otherwise return -1(session not found).
+     */
+    virtual int GetSessionRecvStat(int sessionId, LLBC_RecvStat &stat) const;
+
+    /**
+     * Get service coalesced send statistic.
+     * @param[out] stat - the coalesced send statistic.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    virtual int GetCoalescedSendStat(LLBC_CoalescedSendStat &stat) const;
+
+    /**
+     * Get service traffic statistic snapshot.
+     * @param[out] stat - the traffic statistic snapshot.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    virtual int GetTrafficStat(LLBC_TrafficStat &stat) const;
+
 public:
     /**
      * Create a session and listening.
@@ -138,6 +307,15 @@ public:
      */
     virtual int Listen(const char *ip, uint16 port);
 
+    /**
+     * Create multi-acceptor listen sessions, every poller create its own SO_REUSEPORT listen socket.
+     * @param[in] ip          - the ip address.
+     * @param[in] port        - the port number.
+     * @param[out] sessionIds - the listen session Ids, one session per poller.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    virtual int ListenReusePort(const char *ip, uint16 port, LLBC_SessionIdList &sessionIds);
+
     /**
      * Establishes a connection to a specified address.
      * Note:
@@ -164,6 +342,22 @@ public:
      */
     virtual int AsyncConn(const char *ip, uint16 port, double timeout = -1);
 
+    /**
+     * Create a reliable udp listen session.
+     * @param[in] ip   - the ip address.
+     * @param[in] port - the port number.
+     * @return int - the new session Id, if return 0, means failed, see LLBC_GetLastError().
+     */
+    virtual int ListenReliableUdp(const char *ip, uint16 port);
+
+    /**
+     * Create a reliable udp session to a specified address.
+     * @param[in] ip   - the ip address.
+     * @param[in] port - the port number.
+     * @return int - the new session Id, if return 0, means failed, see LLBC_GetLastError().
+     */
+    virtual int ConnectReliableUdp(const char *ip, uint16 port);
+
     /**
      * Check given sessionId is lgeal or not.
      * @param[in] sessionId - the given session Id.
@@ -285,6 +479,24 @@ public:
     virtual int Broadcast2(int opcode, const void *bytes, size_t len, int status, LLBC_PacketHeaderParts *parts);
     virtual int Broadcast2(int svcId, int opcode, const void *bytes, size_t len, int status, LLBC_PacketHeaderParts *parts);
 
+    /**
+     * Forward the received packet to the target service session without copy and re-encode,
+     * the packet header will be rewrite in place(service Id set to target service Id), and
+     * the packet data(header + payload) will be hand over to target service poller directly.
+     * Note:
+     *  1. After forward success, packet payload is taken over by target service, the packet
+     *     only keep header(payload length become 0).
+     *  2. Payload chunk packet(see SetChunkedRecv()) can't be forwarded.
+     *  3. The decoded object(if exist) will not be forwarded, target service send raw packet data.
+     * @param[in] packet          - the received packet.
+     * @param[in] targetSvcId     - the target service Id, service must registered in service manager.
+     * @param[in] targetSvc       - the target service.
+     * @param[in] targetSessionId - the target service session Id.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    virtual int Forward(LLBC_Packet &packet, int targetSvcId, int targetSessionId);
+    virtual int Forward(LLBC_Packet &packet, LLBC_IService *targetSvc, int targetSessionId);
+
     /**
      * Remove session, always success.
      * @param[in] sessionId - the will close session Id.
@@ -316,6 +528,11 @@ public:
      */
     virtual int Subscribe(int opcode, LLBC_IDelegate1<LLBC_Packet &> *deleg);
 
+    /**
+     * Subscribe message to specified delegate, the handler run in new service coroutine.
+     */
+    virtual int SubscribeCoro(int opcode, LLBC_IDelegate1<LLBC_Packet &> *deleg);
+
     /**
      * Previous subscribe message to specified delegate, if method return NULL, will stop packet process flow.
      */
@@ -383,6 +600,60 @@ public:
      */
     virtual int Post(LLBC_IDelegate1<Base *> *deleg);
 
+public:
+    /**
+     * Set the coroutine correlation header part, must be called before service start.
+     * @param[in] serialNo - the correlation header part serial No, -1 means disable.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    virtual int SetCoroCorrelationPart(int serialNo);
+
+    /**
+     * Start service coroutine to run task, must call in service thread.
+     * @param[in] task - the coroutine task, service will take over it(even if failed).
+     * @return int - return coroutine Id if success, otherwise return 0.
+     */
+    virtual int Go(LLBC_IDelegate0 *task);
+
+    /**
+     * Await the packet which received from sessionId and correlation part value equal to correlationId,
+     * must call in service coroutine.
+     * @param[in] sessionId     - the session Id.
+     * @param[in] correlationId - the correlation Id.
+     * @param[in] timeout       - the timeout, in milli-seconds, -1 means never timeout.
+     * @return LLBC_Packet * - the awaited packet, caller take over it, return NULL if failed.
+     */
+    virtual LLBC_Packet *AwaitPacket(int sessionId, sint64 correlationId, int timeout = -1);
+
+    /**
+     * Await specified milli-seconds, must call in service coroutine.
+     * @param[in] milliSeconds - the milli-seconds.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    virtual int AwaitTimer(int milliSeconds);
+
+    /**
+     * Await the result posted by PostCoroResult(), must call in service coroutine.
+     * @param[out] result  - the posted result.
+     * @param[in]  timeout - the timeout, in milli-seconds, -1 means never timeout.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    virtual int AwaitResult(void *&result, int timeout = -1);
+
+    /**
+     * Post result to service coroutine, thread safe.
+     * @param[in] coroId - the coroutine Id.
+     * @param[in] result - the result.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    virtual int PostCoroResult(int coroId, void *result);
+
+    /**
+     * Get the alive service coroutines count, must call in service thread.
+     * @return size_t - the coroutines count.
+     */
+    virtual size_t GetCoroCount() const;
+
 public:
     /**
      * One time service call routine, if service drive mode is ExternalDrive, you must manual call this method.
@@ -390,6 +661,13 @@ public:
      */
     virtual void OnSvc(bool fullFrame = true);
 
+public:
+    /**
+     * Push service event to service event queue, thread safe.
+     * @param[in] ev - the service event, will be stolen.
+     */
+    virtual void Push(LLBC_ServiceEvent *ev);
+
 protected:
     /**
      * Stack create helper method(call by service and session class).
@@ -410,6 +688,13 @@ protected:
     virtual void Cleanup();
 
 private:
+    /**
+     * Friend class: LLBC_ServiceWorker.
+     *  Access methods:
+     *      DispatchPacket()
+     */
+    friend class LLBC_ServiceWorker;
+
     /**
      * Service TLS operation methods.
      */
@@ -428,15 +713,34 @@ private:
      * Queued event operation methods.
      */
     void HandleQueuedEvents();
+    void WaitAndHandleQueuedEvents();
     void HandleEv_SessionCreate(LLBC_ServiceEvent &ev);
     void HandleEv_SessionDestroy(LLBC_ServiceEvent &ev);
     void HandleEv_AsyncConnResult(LLBC_ServiceEvent &ev);
     void HandleEv_DataArrival(LLBC_ServiceEvent &ev);
     void HandleEv_ProtoReport(LLBC_ServiceEvent &ev);
+    void HandleEv_SessionBackpressure(LLBC_ServiceEvent &ev);
     void HandleEv_SubscribeEv(LLBC_ServiceEvent &ev);
     void HandleEv_UnsubscribeEv(LLBC_ServiceEvent &ev);
     void HandleEv_FireEv(LLBC_ServiceEvent &ev);
 
+    /**
+     * Compile coders/handlers/pre-handlers/status handlers to opcode dispatch table, call when service starting.
+     */
+    void CompileDispatchTable();
+
+    /**
+     * Dispatch workers operation methods.
+     */
+    int StartDispatchWorkers();
+    void StopDispatchWorkers();
+
+    /**
+     * Decode and handle packet, call in service thread or dispatch worker thread.
+     * @param[in] packet - the packet, method will take over it.
+     */
+    void DispatchPacket(LLBC_Packet *packet);
+
     /**
      * Facade operation methods.
      */
@@ -469,6 +773,8 @@ private:
 private:
     /**
      * Internal helper methods.
+     * Note: LockableSend() not lock the service lock, if lock flag is true(caller not hold service lock),
+     *       will enter lock-free send guard, service Cleanup() will wait all guarded sending finished.
      */
     int LockableSend(LLBC_Packet *packet,
                      bool lock = true,
@@ -483,14 +789,192 @@ private:
                      bool lock = true,
                      bool validCheck = true);
 
-    template <typename SessionIds>
     int MulticastSendCoder(int svcId,
-                           const SessionIds &sessionIds,
+                           const LLBC_SessionIdList &sessionIds,
                            int opcode,
                            LLBC_ICoder *coder,
                            int status,
                            const LLBC_PacketHeaderParts *parts = NULL,
                            bool validCheck = true);
+    int MulticastSendBytes(int svcId,
+                           const LLBC_SessionIdList &sessionIds,
+                           int opcode,
+                           const void *bytes,
+                           size_t len,
+                           int status,
+                           const LLBC_PacketHeaderParts *parts = NULL,
+                           bool validCheck = true);
+
+    /**
+     * Multicast packet to sessions, packet will be encoded only once into shared buffer,
+     * all target sessions' send queues reference the shared buffer, call in service locked context.
+     * @param[in] packet     - the packet, packet will be deleted.
+     * @param[in] sessionIds - the target session Ids.
+     * @param[in] validCheck - validate session Ids or not.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    int SharedMulticast(LLBC_Packet *packet, const LLBC_SessionIdList &sessionIds, bool validCheck);
+
+private:
+    /**
+     * The coalesced send flush reason enumeration.
+     */
+    enum _CoalescedFlushReason
+    {
+        _FrameEndFlush,
+        _BytesLimitFlush,
+        _LatencyLimitFlush,
+        _ForceFlush
+    };
+
+    /**
+     * Check current thread is service thread and in service frame, only in this case packets can be coalesced.
+     * @return bool - return true if can coalesce, otherwise return false.
+     */
+    bool IsCanCoalesceSend() const;
+
+    /**
+     * The session coalesced packets batch.
+     */
+    struct _CoalescedBatch
+    {
+        std::vector<LLBC_Packet *> packets;
+        size_t bytes;
+        sint64 begTime;
+    };
+    typedef std::map<int, _CoalescedBatch> _CoalescedBatches;
+
+    /**
+     * Coalesce encoded packet into session batch, if session pending bytes exceed limit, will flush
+     * the session batch only, call in service thread.
+     * @param[in] packet - the encoded packet, will be stolen.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    int CoalesceSend(LLBC_Packet *packet);
+
+    /**
+     * Flush all sessions coalesced packets to pollers, call in service thread.
+     * @param[in] reason - the flush reason, see _CoalescedFlushReason.
+     */
+    void FlushCoalescedSend(int reason);
+
+    /**
+     * Flush specified session coalesced packets to pollers, call in service thread.
+     * @param[in] sessionId - the session Id.
+     * @param[in] reason    - the flush reason, see _CoalescedFlushReason.
+     */
+    void FlushSessionCoalescedSend(int sessionId, int reason);
+
+    /**
+     * Flush the sessions coalesced packets which pending latency exceed limit, use frame cached time,
+     * call in service thread.
+     */
+    void CheckCoalescedSendLatency();
+
+    /**
+     * Update coalesced send statistic after flushed.
+     */
+    void UpdateCoalescedSendStat(size_t flushCount, sint64 latency, int reason);
+
+    /**
+     * Dump traffic statistic snapshot to logger if dump interval reached, call in service thread.
+     */
+    void CheckTrafficStatDump();
+
+private:
+    /**
+     * The coroutine await type enumeration.
+     */
+    enum _CoroAwaitType
+    {
+        _CoroAwaitNone,
+        _CoroAwaitPacket,
+        _CoroAwaitTimer,
+        _CoroAwaitResult
+    };
+
+    /**
+     * The service coroutine context.
+     */
+    struct _Coro
+    {
+        LLBC_Service *svc;
+        LLBC_Coro *coro;
+
+        int awaitType;
+        int sessionId;
+        sint64 correlationId;
+        LLBC_Timer *timer;
+
+        LLBC_Packet *packet;
+        void *result;
+        bool posted;
+        int error;
+
+        void OnTimeout(LLBC_Timer *timer);
+    };
+
+    /**
+     * The packet awaiting coroutines, keyed by <sessionId, correlationId>.
+     */
+    typedef std::map<std::pair<int, sint64>, _Coro *> _CoroPacketAwaiters;
+
+    /**
+     * The posted coroutine result task, defined in Service.cpp.
+     */
+    class _CoroResultTask;
+    friend class _CoroResultTask;
+
+    /**
+     * Get current running service coroutine, if not in service coroutine, return NULL.
+     */
+    _Coro *GetCurrentCoro();
+
+    /**
+     * Suspend coroutine to await, call in coroutine.
+     * @param[in] coro      - the coroutine.
+     * @param[in] awaitType - the await type, see _CoroAwaitType.
+     * @param[in] timeout   - the timeout, in milli-seconds, -1 means never timeout.
+     * @return int - the resume error, 0 if success, otherwise return -1.
+     */
+    int AwaitCoro(_Coro *coro, int awaitType, int timeout);
+
+    /**
+     * Resume coroutine with error, if coroutine finished, will destroy it, call in service thread.
+     * @param[in] coro  - the coroutine.
+     * @param[in] error - the resume error, 0 means awaited success.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    int ResumeCoro(_Coro *coro, int error);
+
+    /**
+     * Try resume packet awaiting coroutine, call in service thread.
+     * If matched packet decode failed, the coroutine will be resumed with LLBC_ERROR_DECODE.
+     * @param[in] packet - the received packet, if matched, method will take over it.
+     * @return bool - return true if matched, otherwise return false.
+     */
+    bool ResumePacketAwaiter(LLBC_Packet *packet);
+
+    /**
+     * Resume all packet awaiting coroutines of the session with LLBC_ERROR_NOT_FOUND, call when session destroyed.
+     * @param[in] sessionId - the destroyed session Id.
+     */
+    void ResumeSessionPacketAwaiters(int sessionId);
+
+    /**
+     * Handle posted coroutine result, call in service thread.
+     */
+    void HandlePostedCoroResult(int coroId, void *result);
+
+    /**
+     * Destroy coroutine context.
+     */
+    void DestroyCoro(_Coro *coro);
+
+    /**
+     * Cancel all coroutines, awaiting coroutines will be resumed with LLBC_ERROR_NOT_ALLOW, call when service cleanup.
+     */
+    void CancelCoros();
 
 private:
     int _id;
@@ -501,6 +985,18 @@ private:
     DriveMode _driveMode;
     bool _suppressedCoderNotFoundWarning;
 
+    int _compressPolicy;
+    size_t _compressThreshold;
+    std::map<int, int> _opcodeCompressPolicies;
+
+    size_t _maxPacketLen;
+    bool _chunkedRecv;
+    size_t _recvChunkSize;
+
+    bool _coalescedSend;
+    size_t _coalescedSendMaxBytes;
+    int _coalescedSendMaxLatency;
+
     volatile bool _started;
     volatile bool _stopping;
 
@@ -513,15 +1009,43 @@ private:
     volatile bool _sinkIntoLoop;
     volatile bool _afterStop;
 
+private:
+    LLBC_MPSCQueue<LLBC_ServiceEvent> _evQueue;
+    LLBC_Semaphore _evSem;
+    volatile sint32 _evWaiting;
+
 private:
     LLBC_PollerMgr _pollerMgr;
     
-    LLBC_SessionIdSet _connectedSessionIds;
-    LLBC_SpinLock _connectedSessionIdsLock;
+    LLBC_SessionIdTable _connectedSessionIds;
+    volatile sint32 _sendingCount;
 
 #if !LLBC_CFG_COMM_USE_FULL_STACK
     LLBC_ProtocolStack _stack;
 #endif
+    LLBC_ProtocolStack *_multicastStack;
+
+    __LLBC_LibTls *_svcTls;
+    sint64 _coalescedBegTime;
+    _CoalescedBatches _coalescedBatches;
+    std::vector<LLBC_Packet *> _coalescedFlushPackets;
+    LLBC_CoalescedSendStat _coalescedSendStat;
+    LLBC_SpinLock _coalescedSendStatLock;
+
+    LLBC_TrafficStatCollector *_trafficStat;
+    int _trafficStatDumpInterval;
+    LLBC_String _trafficStatLoggerName;
+    sint64 _trafficStatDumpTime;
+
+    int _dispatchWorkerCount;
+    std::vector<LLBC_ServiceWorker *> _dispatchWorkers;
+    std::set<int> _sessionLocalOpcodes;
+
+    int _coroCorrelationPart;
+    bool _coroCancelling;
+    std::set<int> _coroOpcodes;
+    std::map<int, _Coro *> _coros;
+    _CoroPacketAwaiters _coroPacketAwaiters;
 
     typedef std::vector<LLBC_IFacade *> _Facades;
     _Facades _facades;
@@ -540,9 +1064,10 @@ private:
     _OpStatusHandlers _statusHandlers;
 #endif // LLBC_CFG_COMM_ENABLE_STATUS_HANDLER
 #if LLBC_CFG_COMM_ENABLE_STATUS_DESC
-    typedef std::map<int, LLBC_String> _StatusDescs;
+    typedef LLBC_OpcodeDispatchEntry::StatusDescs _StatusDescs;
     _StatusDescs _statusDescs;
 #endif // LLBC_CFG_COMM_ENABLE_STATUS_DESC
+    LLBC_OpcodeDispatchTable _dispatchTable;
 
     LLBC_IProtocolFilter *_filters[LLBC_ProtocolLayer::End];
 
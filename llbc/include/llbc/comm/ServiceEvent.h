@@ -41,6 +41,7 @@ public:
         AsyncConnResult,
         DataArrival,
         ProtoReport,
+        SessionBackpressure,
 
         SubscribeEv,
         UnsubscribeEv,
@@ -52,13 +53,22 @@ public:
 
 /**
  * \brief The service event base structure encapsulation.
+ *        Service events are intrusive queue nodes(linked by next member), and all
+ *        allocate from event pool, push to service without any extra wrapper.
  */
 struct LLBC_HIDDEN LLBC_ServiceEvent
 {
     int type;
+    LLBC_ServiceEvent *next;
 
     LLBC_ServiceEvent(int type);
     virtual ~LLBC_ServiceEvent();
+
+    /**
+     * Pooled allocation/deallocation, delete operator will receive the event dynamic type size.
+     */
+    static void *operator new(size_t size);
+    static void operator delete(void *ev, size_t size);
 };
 
 /**
@@ -88,6 +98,7 @@ struct LLBC_HIDDEN LLBC_SvcEv_SessionDestroy : public LLBC_ServiceEvent
     LLBC_SocketHandle handle;
 
     LLBC_SessionCloseInfo *closeInfo;
+    LLBC_RecvStat recvStat;
 
     LLBC_SvcEv_SessionDestroy();
     virtual ~LLBC_SvcEv_SessionDestroy();
@@ -133,6 +144,21 @@ struct LLBC_HIDDEN LLBC_SvcEv_ProtoReport : public LLBC_ServiceEvent
     virtual ~LLBC_SvcEv_ProtoReport();
 };
 
+/**
+ * \brief The session-backpressure event structure encapsulation.
+ */
+struct LLBC_HIDDEN LLBC_SvcEv_SessionBackpressure : public LLBC_ServiceEvent
+{
+    int sessionId;
+    bool backpressured;
+    size_t queueSize;
+    size_t droppedPackets;
+    size_t coalescedPackets;
+
+    LLBC_SvcEv_SessionBackpressure();
+    virtual ~LLBC_SvcEv_SessionBackpressure();
+};
+
 /**
  * \brief The subscribe-event event structure encapsulation.
  */
@@ -171,7 +197,7 @@ struct LLBC_HIDDEN LLBC_SvcEv_FireEv : public LLBC_ServiceEvent
 
 /**
  * \brief The service event util class encapsulation.
- *        Use for Build/Destroy service events.
+ *        Use for Build service events, the built events destroy by LLBC_Delete().
  */
 class LLBC_HIDDEN LLBC_SvcEvUtil
 {
@@ -179,7 +205,7 @@ public:
     /**
      * Build session create event.
      */
-    static LLBC_MessageBlock *BuildSessionCreateEv(const LLBC_SockAddr_IN &local,
+    static LLBC_ServiceEvent *BuildSessionCreateEv(const LLBC_SockAddr_IN &local,
                                                    const LLBC_SockAddr_IN &peer,
                                                    bool isListen,
                                                    int sessionId,
@@ -188,56 +214,60 @@ public:
     /**
      * Build session destroy event.
      */
-    static LLBC_MessageBlock *BuildSessionDestroyEv(const LLBC_SockAddr_IN &local,
+    static LLBC_ServiceEvent *BuildSessionDestroyEv(const LLBC_SockAddr_IN &local,
                                                     const LLBC_SockAddr_IN &peer,
                                                     bool isListen,
                                                     int sessionId,
                                                     LLBC_SocketHandle handle,
-                                                    LLBC_SessionCloseInfo *closeInfo);
+                                                    LLBC_SessionCloseInfo *closeInfo,
+                                                    const LLBC_RecvStat &recvStat);
 
     /**
      * Build async-connect result event.
      */
-    static LLBC_MessageBlock *BuildAsyncConnResultEv(bool conneted, 
+    static LLBC_ServiceEvent *BuildAsyncConnResultEv(bool conneted, 
                                                      const LLBC_String &reason, 
                                                      const LLBC_SockAddr_IN &peer);
 
     /**
      * Build Data-Arrival event.
      */
-    static LLBC_MessageBlock *BuildDataArrivalEv(LLBC_Packet *packet);
+    static LLBC_ServiceEvent *BuildDataArrivalEv(LLBC_Packet *packet);
 
     /**
      * Build subscribe-event event.
      */
-    static LLBC_MessageBlock *BuildSubscribeEvEv(int id,
+    static LLBC_ServiceEvent *BuildSubscribeEvEv(int id,
                                                  const LLBC_String &stub,
                                                  LLBC_IDelegate1<LLBC_Event *> *deleg);
 
     /**
      * Build proto-report event.
      */
-    static LLBC_MessageBlock *BuildProtoReportEv(int sessionId,
+    static LLBC_ServiceEvent *BuildProtoReportEv(int sessionId,
                                                  int opcode,
                                                  int layer,
                                                  int level,
                                                  const LLBC_String &report);
 
     /**
-     * Build unsubscribe-event event.
+     * Build session-backpressure event.
      */
-    static LLBC_MessageBlock *BuildUnsubscribeEvEv(int id, const LLBC_String &stub);
+    static LLBC_ServiceEvent *BuildSessionBackpressureEv(int sessionId,
+                                                         bool backpressured,
+                                                         size_t queueSize,
+                                                         size_t droppedPackets,
+                                                         size_t coalescedPackets);
 
     /**
-     * Build fire-event event.
+     * Build unsubscribe-event event.
      */
-    static LLBC_MessageBlock *BuildFireEvEv(LLBC_Event *ev);
+    static LLBC_ServiceEvent *BuildUnsubscribeEvEv(int id, const LLBC_String &stub);
 
-public:
     /**
-     * Destroy service event block.
+     * Build fire-event event.
      */
-    static void DestroyEvBlock(LLBC_MessageBlock *block);
+    static LLBC_ServiceEvent *BuildFireEvEv(LLBC_Event *ev);
 };
 
 __LLBC_NS_END
@@ -0,0 +1,94 @@
+/**
+ * @file    ServiceWorker.h
+ * @author  Longwei Lai<lailongwei@126.com>
+ * @date    2026/10/18
+ * @version 1.0
+ *
+ * @brief   The service session-affine packet dispatch worker.
+ */
+#ifndef __LLBC_COMM_SERVICE_WORKER_H__
+#define __LLBC_COMM_SERVICE_WORKER_H__
+
+#include "llbc/common/Common.h"
+#include "llbc/core/Core.h"
+
+#include "llbc/comm/ServiceEvent.h"
+
+__LLBC_NS_BEGIN
+
+/**
+ * Previous declare some classes.
+ */
+class LLBC_Service;
+
+__LLBC_NS_END
+
+__LLBC_NS_BEGIN
+
+/**
+ * \brief The service dispatch worker class encapsulation.
+ *
+ * Service dispatch the session-local opcode packets to workers by session Id, every worker own
+ * one thread and one event queue, so one session's packets always be handled in same worker in
+ * arrival order. Worker block wait on semaphore when queue empty, only be posted when queue
+ * become not empty.
+ */
+class LLBC_HIDDEN LLBC_ServiceWorker : public LLBC_BaseTask
+{
+public:
+    /**
+     * Constructor & Destructor.
+     * @param[in] svc - the owner service.
+     */
+    explicit LLBC_ServiceWorker(LLBC_Service *svc);
+    virtual ~LLBC_ServiceWorker();
+
+public:
+    /**
+     * Start worker thread.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    int Start();
+
+    /**
+     * Stop worker thread, wait the handling packet finished, the queued events will be discarded.
+     */
+    void Stop();
+
+    /**
+     * Push data arrival event to worker, thread safe.
+     * @param[in] ev - the data arrival event.
+     */
+    void PushEvent(LLBC_ServiceEvent *ev);
+
+public:
+    /**
+     * Worker thread routine.
+     */
+    virtual void Svc();
+
+    /**
+     * Task cleanup method.
+     */
+    virtual void Cleanup();
+
+    LLBC_DISABLE_ASSIGNMENT(LLBC_ServiceWorker);
+
+private:
+    /**
+     * Delete the queued events.
+     */
+    void DestroyQueuedEvents();
+
+private:
+    LLBC_Service *_svc;
+    volatile bool _stopping;
+
+    LLBC_MPSCQueue<LLBC_ServiceEvent> _evQueue;
+    LLBC_Semaphore _evSem;
+    volatile sint32 _evWaiting;
+};
+
+__LLBC_NS_END
+
+#endif // !__LLBC_COMM_SERVICE_WORKER_H__
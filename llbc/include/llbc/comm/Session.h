@@ -13,6 +13,9 @@
 #include "llbc/core/Core.h"
 #include "llbc/objbase/ObjBase.h"
 
+#include "llbc/comm/SendStat.h"
+#include "llbc/comm/RecvStat.h"
+
 __LLBC_NS_BEGIN
 
 /**
@@ -22,6 +25,7 @@ class LLBC_Packet;
 class LLBC_Socket;
 class LLBC_IService;
 class LLBC_BasePoller;
+class LLBC_RecvSlab;
 class LLBC_ProtocolStack;
 
 __LLBC_NS_END
@@ -171,10 +175,13 @@ public:
      * Send message block.
      * Note: 
      *       No matter method call success or not, method will steal <block> the parameter.
-     * @param[in] block - the message block.
+     *       If session in backpressure state(send queue exceed high water mark), the block will be
+     *       dropped/coalesced/disconnected according to the opcode's backpressure policy.
+     * @param[in] block  - the message block.
+     * @param[in] opcode - the block packet opcode, used to determine backpressure policy(and coalesce key).
      * @return int - return 0 if success, otherwise return -1.
      */
-    int Send(LLBC_MessageBlock *block);
+    int Send(LLBC_MessageBlock *block, int opcode);
 
 public:
     /**
@@ -197,6 +204,11 @@ public:
     void OnRecv();
 #endif // LLBC_TARGET_PLATFORM_WIN32
 
+    /**
+     * Pending receive event handler method, call by poller when re-arm the recv budget exhausted session.
+     */
+    void OnPendingRecv();
+
     /**
      * Close event handler method, call by poller or socket.
      * @param[in] ol        - overlapped structure(WIN32 specified).
@@ -211,16 +223,49 @@ public:
 public:
     /**
      * Sent event handler method, call by socket, when has data sent, will call this method.
-     * @param[in] len - data length, in bytes.
+     * @param[in] stat - this time sent statistic(send calls, sent blocks and bytes).
      */
-    void OnSent(size_t len);
+    void OnSent(const LLBC_SendStat &stat);
 
     /**
      * Received event handler method, call by socket, when data received, will call this metho.
-     * @param[in] block - the data block.
+     * @param[in] block - the data block, borrowed, session will not delete it.
+     * @param[in] slab  - the receive slab which block data lie in, can be NULL.
      * @return bool - return false if success, otherwise return false(if failed, this method will perform OnClose() op).
      */
-    bool OnRecved(LLBC_MessageBlock *block);
+    bool OnRecved(LLBC_MessageBlock *block, LLBC_RecvSlab *slab);
+
+    /**
+     * Receive finished event handler method, call by socket, when one readable event receive finished
+     * (would-block, error or recv budget exhausted), if budget exhausted, session will be re-armed.
+     * @param[in] stat - this time receive statistic.
+     */
+    void OnRecvFinished(const LLBC_RecvStat &stat);
+
+private:
+    /**
+     * Apply backpressure policy to the block which send in backpressure state.
+     * @param[in] block  - the message block.
+     * @param[in] opcode - the block packet opcode.
+     * @return bool - return true if block consumed(dropped or coalesced), otherwise return false.
+     */
+    bool ApplyBackpressurePolicy(LLBC_MessageBlock *block, int opcode);
+
+    /**
+     * Check send queue size, update queue size to poller manager, and enter/leave
+     * backpressure state if send queue size crossed the water marks.
+     */
+    void CheckSendQueue();
+
+    /**
+     * Requeue all coalesced blocks to socket, and defer OnSend() to poller flush send queue.
+     */
+    void FlushCoalescedBlocks();
+
+    /**
+     * Request poller close session in next loop(Disconnect backpressure policy).
+     */
+    void RequestDisconnect();
 
 private:
     int _id;
@@ -231,8 +276,19 @@ private:
     LLBC_BasePoller *_poller;
 
     LLBC_ProtocolStack *_protoStack;
+    std::vector<LLBC_Packet *> _recvedPackets;
 
     int _pollerType;
+
+    bool _pendingFlush;
+    bool _pendingRecv;
+
+    bool _backpressured;
+    bool _disconnecting;
+    size_t _reportedQueueSize;
+    size_t _droppedPackets;
+    size_t _coalescedPackets;
+    std::map<int, LLBC_MessageBlock *> _coalescedBlocks;
 };
 
 __LLBC_NS_END
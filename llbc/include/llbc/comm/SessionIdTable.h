@@ -0,0 +1,140 @@
+/**
+ * @file    SessionIdTable.h
+ * @author  Longwei Lai<lailongwei@126.com>
+ * @date    2026/10/18
+ * @version 1.0
+ *
+ * @brief   The lock-free session Id table.
+ */
+#ifndef __LLBC_COMM_SESSION_ID_TABLE_H__
+#define __LLBC_COMM_SESSION_ID_TABLE_H__
+
+#include "llbc/common/Common.h"
+#include "llbc/core/Core.h"
+
+__LLBC_NS_BEGIN
+
+/**
+ * \brief The session Id table class encapsulation.
+ *
+ * Session Ids allocated by poller manager are monotonic increase, so the table
+ * use sessionId & (slotsCount - 1) as slot index, every slot store the live session Id,
+ * the stored session Id itself is slot generation, old Id never match new session in same slot.
+ * Lookup is one volatile load when not collision, only collision session Ids(live sessions
+ * more than slots count) will store in overflow map.
+ * All live session Ids also stored in a dense list, use to support O(n) copy.
+ * Every session Id can associate fixed count 64 bits values(eg: session send queue size, receive
+ * statistic), values stored in parallel slot array, Set/Get value is lock-free when not collision.
+ * Insert/Remove/Copy operations are protected by spin lock, Lookup operation is lock-free.
+ */
+class LLBC_HIDDEN LLBC_SessionIdTable
+{
+public:
+    /**
+     * Constructor & Destructor.
+     * @param[in] slotsCount - the slots count, must be power of 2.
+     * @param[in] valueCount - the associated values count of every session Id.
+     */
+    explicit LLBC_SessionIdTable(int slotsCount = LLBC_CFG_COMM_SESSION_TABLE_SIZE, int valueCount = 1);
+    ~LLBC_SessionIdTable();
+
+public:
+    /**
+     * Insert session Id to table, thread safe.
+     * @param[in] sessionId - the session Id, must be positive.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    int Insert(int sessionId);
+
+    /**
+     * Remove session Id from table, thread safe.
+     * @param[in] sessionId - the session Id.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    int Remove(int sessionId);
+
+    /**
+     * Check session Id in table or not, thread safe and lock-free when not collision.
+     * @param[in] sessionId - the session Id.
+     * @return bool - return true if exist, otherwise return false.
+     */
+    bool IsExist(int sessionId) const;
+
+    /**
+     * Set session Id associated value, thread safe and lock-free when not collision.
+     * Note: Only the thread which own the session(eg: session's poller) should set value.
+     * @param[in] sessionId - the session Id.
+     * @param[in] value     - the value.
+     * @param[in] valueIdx  - the value index, must less than values count.
+     * @return int - return 0 if success, otherwise return -1(session Id not in table).
+     */
+    int SetValue(int sessionId, sint64 value, int valueIdx = 0);
+
+    /**
+     * Get session Id associated value, thread safe and lock-free when not collision.
+     * @param[in] sessionId - the session Id.
+     * @param[out] value    - the value, the session Id insert to table's initial value is 0.
+     * @param[in] valueIdx  - the value index, must less than values count.
+     * @return int - return 0 if success, otherwise return -1(session Id not in table).
+     */
+    int GetValue(int sessionId, sint64 &value, int valueIdx = 0) const;
+
+    /**
+     * Get session Id associated all values, thread safe and lock-free when not collision.
+     * @param[in] sessionId - the session Id.
+     * @param[out] values   - the values array, array size must greater than or equal to values count.
+     * @return int - return 0 if success, otherwise return -1(session Id not in table).
+     */
+    int GetValues(int sessionId, sint64 *values) const;
+
+    /**
+     * Get live session Ids count.
+     * @return size_t - the session Ids count.
+     */
+    size_t GetSize() const;
+
+    /**
+     * Copy all live session Ids, thread safe.
+     * @param[out] sessionIds - the session Ids list.
+     */
+    void GetSessionIds(LLBC_SessionIdList &sessionIds) const;
+
+    /**
+     * Cleanup table.
+     */
+    void Clear();
+
+    LLBC_DISABLE_ASSIGNMENT(LLBC_SessionIdTable);
+
+private:
+    /**
+     * Remove session Id from dense list, call in locked context.
+     * @param[in] denseIdx - the session Id dense list index.
+     */
+    void RemoveFromDense(int denseIdx);
+
+    /**
+     * Set session Id's dense index, call in locked context.
+     * @param[in] sessionId - the session Id.
+     * @param[in] denseIdx  - the dense index.
+     */
+    void SetDenseIdx(int sessionId, int denseIdx);
+
+private:
+    volatile sint32 *_slots;
+    volatile sint64 *_values;
+    int *_denseIdxs;
+    const int _mask;
+    const int _valueCount;
+
+    volatile sint32 _overflowCount;
+    std::map<int, int> _overflow;
+    std::map<int, std::vector<sint64> > _overflowValues;
+
+    LLBC_SessionIdList _dense;
+    LLBC_SpinLock _lock;
+};
+
+__LLBC_NS_END
+
+#endif // !__LLBC_COMM_SESSION_ID_TABLE_H__
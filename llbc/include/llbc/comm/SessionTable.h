@@ -0,0 +1,163 @@
+/**
+ * @file    SessionTable.h
+ * @author  Longwei Lai<lailongwei@126.com>
+ * @date    2026/10/18
+ * @version 1.0
+ *
+ * @brief   The poller session table.
+ */
+#ifndef __LLBC_COMM_SESSION_TABLE_H__
+#define __LLBC_COMM_SESSION_TABLE_H__
+
+#include "llbc/common/Common.h"
+#include "llbc/core/Core.h"
+
+__LLBC_NS_BEGIN
+
+/**
+ * Previous declare some classes.
+ */
+class LLBC_Session;
+
+__LLBC_NS_END
+
+__LLBC_NS_BEGIN
+
+/**
+ * \brief The poller session table class encapsulation.
+ *
+ * Poller owned sessions table, sessionId->session and socket->session lookups are both O(1):
+ *  - sessionId: generational slots array, slot index is (sessionId / idStride) & mask,
+ *               the slot stored session Id is the slot generation, collided sessions store in
+ *               overflow map(rare, table will grow when load factor exceed 0.5).
+ *  - socket:    in Non-WIN32 platform, socket handle is small integer, use dense fd-indexed array,
+ *               in WIN32 platform, socket handle is not dense, use map.
+ * All sessions also stored in dense list, use to support iterate.
+ * Note: This class is not thread safe, only can use in poller thread.
+ */
+class LLBC_HIDDEN LLBC_SessionTable
+{
+public:
+    LLBC_SessionTable();
+    ~LLBC_SessionTable();
+
+public:
+    /**
+     * Set session Id stride, poller only own the sessions which sessionId % brothersCount == pollerId,
+     * so set stride to brothers count can make slots dense.
+     * @param[in] stride - the session Id stride, must be called before insert any session.
+     */
+    void SetIdStride(int stride);
+
+public:
+    /**
+     * Insert session.
+     * @param[in] session - the session.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    int Insert(LLBC_Session *session);
+
+    /**
+     * Remove session.
+     * @param[in] session - the session.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    int Remove(LLBC_Session *session);
+
+    /**
+     * Find session by session Id.
+     * @param[in] sessionId - the session Id.
+     * @return LLBC_Session * - the session, if not found, return NULL.
+     */
+    LLBC_Session *Find(int sessionId) const;
+
+    /**
+     * Find session by socket handle.
+     * @param[in] handle - the socket handle.
+     * @return LLBC_Session * - the session, if not found, return NULL.
+     */
+    LLBC_Session *FindBySocket(LLBC_SocketHandle handle) const;
+
+public:
+    /**
+     * Get sessions count.
+     * @return size_t - the sessions count.
+     */
+    size_t GetSize() const;
+
+    /**
+     * Check table is empty or not.
+     * @return bool - empty flag.
+     */
+    bool IsEmpty() const;
+
+    /**
+     * Get session by dense index, use to iterate all sessions.
+     * @param[in] idx - the dense index, must less than GetSize().
+     * @return LLBC_Session * - the session.
+     */
+    LLBC_Session *GetAt(size_t idx) const;
+
+    /**
+     * Get all sessions max socket handle.
+     * @return LLBC_SocketHandle - the max socket handle, if table empty, return 0.
+     */
+    LLBC_SocketHandle GetMaxSocketHandle() const;
+
+    /**
+     * Delete all sessions and cleanup table.
+     */
+    void DeleteAll();
+
+    LLBC_DISABLE_ASSIGNMENT(LLBC_SessionTable);
+
+private:
+    /**
+     * The session Id slot structure.
+     */
+    struct _Slot
+    {
+        int sessionId;
+        int denseIdx;
+        LLBC_Session *session;
+    };
+
+    /**
+     * Get the slot of given session Id, if not found, return NULL.
+     */
+    _Slot *GetSlot(int sessionId);
+
+    /**
+     * Insert session to slots/overflow map, not update dense list.
+     */
+    void InsertToSlots(int sessionId, int denseIdx, LLBC_Session *session);
+
+    /**
+     * Grow slots array, and rehash all sessions.
+     */
+    void Grow();
+
+private:
+    int _idStride;
+
+    _Slot *_slots;
+    int _slotsMask;
+
+    typedef std::map<int, _Slot> _Overflow;
+    _Overflow _overflow;
+
+    std::vector<LLBC_Session *> _dense;
+
+#if LLBC_TARGET_PLATFORM_NON_WIN32
+    std::vector<LLBC_Session *> _fdSessions;
+#else
+    typedef std::map<LLBC_SocketHandle, LLBC_Session *> _Sockets;
+    _Sockets _sockets;
+#endif
+};
+
+__LLBC_NS_END
+
+#include "llbc/comm/SessionTableImpl.h"
+
+#endif // !__LLBC_COMM_SESSION_TABLE_H__
@@ -0,0 +1,56 @@
+/**
+ * @file    SessionTableImpl.h
+ * @author  Longwei Lai<lailongwei@126.com>
+ * @date    2026/10/18
+ * @version 1.0
+ *
+ * @brief   The poller session table inline lookup implementations.
+ */
+#ifdef __LLBC_COMM_SESSION_TABLE_H__
+
+__LLBC_NS_BEGIN
+
+inline LLBC_Session *LLBC_SessionTable::Find(int sessionId) const
+{
+    const _Slot &slot = _slots[(sessionId / _idStride) & _slotsMask];
+    if (LIKELY(slot.sessionId == sessionId))
+        return slot.session;
+    else if (LIKELY(_overflow.empty()))
+        return NULL;
+
+    _Overflow::const_iterator it = _overflow.find(sessionId);
+    return it != _overflow.end() ? it->second.session : NULL;
+}
+
+inline LLBC_Session *LLBC_SessionTable::FindBySocket(LLBC_SocketHandle handle) const
+{
+#if LLBC_TARGET_PLATFORM_NON_WIN32
+    if (UNLIKELY(handle < 0 ||
+            static_cast<size_t>(handle) >= _fdSessions.size()))
+        return NULL;
+
+    return _fdSessions[handle];
+#else
+    _Sockets::const_iterator it = _sockets.find(handle);
+    return it != _sockets.end() ? it->second : NULL;
+#endif
+}
+
+inline size_t LLBC_SessionTable::GetSize() const
+{
+    return _dense.size();
+}
+
+inline bool LLBC_SessionTable::IsEmpty() const
+{
+    return _dense.empty();
+}
+
+inline LLBC_Session *LLBC_SessionTable::GetAt(size_t idx) const
+{
+    return _dense[idx];
+}
+
+__LLBC_NS_END
+
+#endif // __LLBC_COMM_SESSION_TABLE_H__
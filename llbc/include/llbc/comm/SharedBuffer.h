@@ -0,0 +1,97 @@
+/**
+ * @file    SharedBuffer.h
+ * @author  Longwei Lai<lailongwei@126.com>
+ * @date    2026/10/18
+ * @version 1.0
+ *
+ * @brief   The multicast/broadcast shared send buffer.
+ */
+#ifndef __LLBC_COMM_SHARED_BUFFER_H__
+#define __LLBC_COMM_SHARED_BUFFER_H__
+
+#include "llbc/common/Common.h"
+#include "llbc/core/Core.h"
+
+__LLBC_NS_BEGIN
+
+/**
+ * \brief The shared send buffer class encapsulation.
+ *
+ * Multicast/Broadcast packet will be encoded only once into shared buffer, it is
+ * immutable and reference counted, every target session's send queue reference
+ * it by LLBC_SharedBlock, when the last referenced block flushed(deleted), buffer
+ * will be deleted.
+ * Retain/Release are thread safe.
+ */
+class LLBC_HIDDEN LLBC_SharedBuffer
+{
+public:
+    /**
+     * Constructor, take over the given block, the reference count is 1 after constructed.
+     * @param[in] block - the encoded data block(readable part is the send data).
+     */
+    explicit LLBC_SharedBuffer(LLBC_MessageBlock *block);
+
+public:
+    /**
+     * Retain buffer, thread safe.
+     */
+    void Retain();
+
+    /**
+     * Release buffer, thread safe, if reference count reach zero, buffer will be deleted.
+     */
+    void Release();
+
+public:
+    /**
+     * Get the buffer data.
+     * @return void * - the buffer data.
+     */
+    void *GetData() const;
+
+    /**
+     * Get the buffer data size.
+     * @return size_t - the data size.
+     */
+    size_t GetSize() const;
+
+    LLBC_DISABLE_ASSIGNMENT(LLBC_SharedBuffer);
+
+private:
+    /**
+     * Destructor, only can delete by Release().
+     */
+    ~LLBC_SharedBuffer();
+
+private:
+    volatile sint32 _refCount;
+    LLBC_MessageBlock *_block;
+};
+
+/**
+ * \brief The shared send block class encapsulation.
+ *
+ * Attached to shared buffer data, retain shared buffer until destroyed.
+ */
+class LLBC_HIDDEN LLBC_SharedBlock : public LLBC_MessageBlock
+{
+public:
+    /**
+     * Constructor & Destructor.
+     * @param[in] buffer - the shared buffer.
+     */
+    explicit LLBC_SharedBlock(LLBC_SharedBuffer *buffer);
+    virtual ~LLBC_SharedBlock();
+
+    LLBC_DISABLE_ASSIGNMENT(LLBC_SharedBlock);
+
+private:
+    LLBC_SharedBuffer *_buffer;
+};
+
+__LLBC_NS_END
+
+#include "llbc/comm/SharedBufferImpl.h"
+
+#endif // !__LLBC_COMM_SHARED_BUFFER_H__
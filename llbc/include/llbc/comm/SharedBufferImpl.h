@@ -0,0 +1,36 @@
+/**
+ * @file    SharedBufferImpl.h
+ * @author  Longwei Lai<lailongwei@126.com>
+ * @date    2026/10/18
+ * @version 1.0
+ *
+ * @brief   The shared send buffer inline implementations.
+ */
+#ifdef __LLBC_COMM_SHARED_BUFFER_H__
+
+__LLBC_NS_BEGIN
+
+inline void LLBC_SharedBuffer::Retain()
+{
+    LLBC_AtomicFetchAndAdd(&_refCount, 1);
+}
+
+inline void LLBC_SharedBuffer::Release()
+{
+    if (LLBC_AtomicFetchAndSub(&_refCount, 1) == 1)
+        delete this;
+}
+
+inline void *LLBC_SharedBuffer::GetData() const
+{
+    return _block->GetDataStartWithReadPos();
+}
+
+inline size_t LLBC_SharedBuffer::GetSize() const
+{
+    return _block->GetReadableSize();
+}
+
+__LLBC_NS_END
+
+#endif // __LLBC_COMM_SHARED_BUFFER_H__
@@ -13,12 +13,21 @@
 #include "llbc/core/Core.h"
 #include "llbc/objbase/ObjBase.h"
 
+#include "llbc/comm/SendStat.h"
+#include "llbc/comm/RecvStat.h"
+#include "llbc/comm/ReliableUdpOptions.h"
+
 __LLBC_NS_BEGIN
 
 /**
  * Previous declare some classes.
  */
 class LLBC_Session;
+class LLBC_RecvSlab;
+class LLBC_ReliableUdp;
+#if LLBC_TARGET_PLATFORM_LINUX
+struct LLBC_IoUringSendReq;
+#endif // LLBC_TARGET_PLATFORM_LINUX
 
 __LLBC_NS_END
 
@@ -118,6 +127,19 @@ public:
      */
     int DisableAddressReusable();
 
+    /**
+     * Enable port reusable option(SO_REUSEPORT), must call before bind.
+     * The sessions accepted by port reusable listen socket will stay in the accepting poller.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    int EnablePortReusable();
+
+    /**
+     * Check the socket port reusable option enabled or not.
+     * @return bool - the port reusable flag.
+     */
+    bool IsPortReusable() const;
+
     /**
      * Check the socket blocking flag.
      * @return bool - return true if is non-blocking, 
@@ -196,6 +218,27 @@ public:
      */
     LLBC_Socket *Accept();
 
+    /**
+     * Mark the bound udp socket as reliable udp listen socket, the poller will accept
+     * reliable udp peers by the open datagrams received in this socket.
+     */
+    void ReliableUdpListen();
+
+    /**
+     * Enable reliable udp on the connected udp socket, all data will be sent/received through
+     * reliable udp ARQ engine.
+     * @param[in] conv           - the conversation Id.
+     * @param[in] opts           - the reliable udp options.
+     * @param[in] sendOpenMarker - send open marker or not, the connecting side must send open marker.
+     */
+    void EnableReliableUdp(uint32 conv, const LLBC_ReliableUdpOptions &opts, bool sendOpenMarker);
+
+    /**
+     * Check the socket is reliable udp socket(include reliable udp listen socket) or not.
+     * @return bool - the reliable udp flag.
+     */
+    bool IsReliableUdp() const;
+
 #if LLBC_TARGET_PLATFORM_WIN32
     /**
      * WIN32 specific socket method, accept a new connection(asynchronous).
@@ -264,6 +307,12 @@ public:
      */
     bool IsExistNoSendData() const;
 
+    /**
+     * Get the queued not sent data size(include the in-flight send requests data).
+     * @return size_t - the not sent data size.
+     */
+    size_t GetWillSendSize() const;
+
     /**
      * Receive data from a connected socket.
      * @param[in] buf - buffer for the incoming data.
@@ -330,6 +379,18 @@ public:
      */
     int GetPendingError(int &pendingError);
 
+    /**
+     * Get socket send statistic, only available in the socket's poller thread.
+     * @return const LLBC_SendStat & - the send statistic.
+     */
+    const LLBC_SendStat &GetSendStat() const;
+
+    /**
+     * Get socket receive statistic, only available in the socket's poller thread.
+     * @return const LLBC_RecvStat & - the receive statistic.
+     */
+    const LLBC_RecvStat &GetRecvStat() const;
+
 public:
     /**
      * Event handle function, if socket in event trigger mode, must call this function to send data.
@@ -362,6 +423,20 @@ public:
     void OnClose();
 #endif // LLBC_TARGET_PLATFORM_WIN32
 
+    /**
+     * Event handle function, reliable udp socket specified, input the datagram received by
+     * listen socket(the datagram arrived before this socket connected).
+     * @param[in] data - the datagram data.
+     * @param[in] len  - the datagram length.
+     */
+    void OnReliableUdpRecved(const char *data, size_t len);
+
+    /**
+     * Event handle function, reliable udp socket specified, poller must call it in every
+     * loop to process retransmission, delayed acks and keepalive.
+     */
+    void OnReliableUdpUpdate();
+
 public:
 #if LLBC_TARGET_PLATFORM_WIN32
     /**
@@ -401,7 +476,91 @@ private:
     int PostZeroWSARecv();
 #endif // LLBC_TARGET_PLATFORM_WIN32
 
+#if LLBC_TARGET_PLATFORM_LINUX
+    /**
+     * LINUX specific friend class: IoUringPoller.
+     *  Access method list:
+     *      FillUringSendVecs().
+     *      OnUringSent().
+     *      OnUringRecved().
+     *      DetachUringSendBlocks().
+     *  Access member list:
+     *      _uringSendReq.
+     */
+    friend class LLBC_IoUringPoller;
+
+    /**
+     * LINUX platform io_uring poller specified method, gather queued send blocks to io vectors.
+     * @param[out] vecs    - the io vectors.
+     * @param[in]  maxVecs - the io vectors max count.
+     * @return int - the filled io vectors count, 0 means no data need send.
+     */
+    int FillUringSendVecs(LLBC_IoVec *vecs, int maxVecs);
+
+    /**
+     * LINUX platform io_uring poller specified method, remove sent data and update send statistic.
+     * @param[in] len      - the sent bytes.
+     * @param[in] vecs     - the submitted io vectors.
+     * @param[in] vecCount - the submitted io vectors count.
+     */
+    void OnUringSent(int len, const LLBC_IoVec *vecs, int vecCount);
+
+    /**
+     * LINUX platform io_uring poller specified method, deliver the data which kernel received
+     * into provided buffer slab to session, the packets reference slab memory without copy.
+     * @param[in] slab - the provided buffer slab, data start at slab write position.
+     * @param[in] len  - the received data length.
+     * @return bool - return true if success, otherwise return false(session closed).
+     */
+    bool OnUringRecved(LLBC_RecvSlab *slab, size_t len);
+
+    /**
+     * LINUX platform io_uring poller specified method, detach all queued send blocks, used to keep
+     * the blocks referenced by in-flight send request alive after socket deleted.
+     * @return LLBC_MessageBlock * - the first block of detached block list.
+     */
+    LLBC_MessageBlock *DetachUringSendBlocks();
+#endif // LLBC_TARGET_PLATFORM_LINUX
+
 private:
+    /**
+     * Deliver the received data in slab to session.
+     * @param[in] slab    - the receive slab.
+     * @param[in] recvBeg - the received data begin position in slab.
+     * @return bool - return true if success, otherwise return false(session closed).
+     */
+    bool DeliverRecvedData(LLBC_RecvSlab *slab, size_t recvBeg);
+
+    /**
+     * Update receive size hint by this time readable event received bytes.
+     * @param[in] recvedBytes - this time received bytes.
+     * @param[in] slabSize    - the receive slab size.
+     */
+    void UpdateRecvSizeHint(size_t recvedBytes, size_t slabSize);
+
+    /**
+     * Reliable udp socket specified method, receive datagrams and input to ARQ engine.
+     */
+    void ReliableUdpRecv();
+
+    /**
+     * Reliable udp socket specified method, deliver in-order data to session, and check peer closed.
+     * @return bool - return true if success, otherwise return false(session closed).
+     */
+    bool DeliverReliableUdpData();
+
+    /**
+     * Reliable udp socket specified method, flush or update ARQ engine, and notify session sent.
+     * @param[in] update - if true, only flush when update interval reached, otherwise flush immediately.
+     * @return bool - return true if success, otherwise return false(session closed).
+     */
+    bool FlushReliableUdp(bool update);
+
+    /**
+     * Close session with specified OS dependent's error number.
+     * @param[in] subErrNo - the OS dependent's error number.
+     */
+    void CloseSessionWithError(int subErrNo);
 
 private:
     LLBC_SocketHandle _handle;
@@ -410,16 +569,29 @@ private:
     int _pollerType;
 
     bool _listenSocket;
+    bool _portReusable;
     LLBC_SockAddr_IN _peerAddr;
     LLBC_SockAddr_IN _localAddr;
 
     LLBC_MessageBuffer _willSend;
+    size_t _willSendSize;
+    LLBC_SendStat _sendStat;
+
+    LLBC_RecvStat _recvStat;
+    size_t _recvSizeHint;
+
+    bool _reliableUdp;
+    LLBC_ReliableUdp *_rudp;
 
 #if LLBC_TARGET_PLATFORM_WIN32
     bool _nonBlocking;
     LLBC_OverlappedGroup _olGroup;
 #endif // LLBC_TARGET_PLATFORM_WIN32
 
+#if LLBC_TARGET_PLATFORM_LINUX
+    LLBC_IoUringSendReq *_uringSendReq;
+#endif // LLBC_TARGET_PLATFORM_LINUX
+
 private:
 #if LLBC_TARGET_PLATFORM_WIN32
     static char _acceptExBuf[(sizeof(LLBC_SockAddr_IN) + 16) * 2];
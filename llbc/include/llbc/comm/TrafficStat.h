@@ -0,0 +1,91 @@
+/**
+ * @file    TrafficStat.h
+ * @author  Longwei Lai<lailongwei@126.com>
+ * @date    2026/10/18
+ * @version 1.0
+ *
+ * @brief
+ */
+#ifndef __LLBC_COMM_TRAFFIC_STAT_H__
+#define __LLBC_COMM_TRAFFIC_STAT_H__
+
+#include "llbc/common/Common.h"
+#include "llbc/core/Core.h"
+
+__LLBC_NS_BEGIN
+
+/**
+ * \brief The traffic counter structure encapsulation.
+ *
+ * Bytes are packet payload bytes(encoded, not include packet header).
+ * Timing is sampled(every LLBC_CFG_COMM_TRAFFIC_STAT_TIMING_SAMPLE packets time once), the xxxSamples
+ * members are the timed packets count, xxxTime members are the sampled time sum, in micro-seconds.
+ */
+struct LLBC_EXPORT LLBC_TrafficCounter
+{
+    uint64 sentPackets;   // The sent packets count.
+    uint64 sentBytes;     // The sent payload bytes.
+    uint64 recvPackets;   // The received packets count.
+    uint64 recvBytes;     // The received payload bytes.
+
+    uint64 encodeSamples; // The encode timed packets count.
+    uint64 encodeTime;    // The encode sampled time, in micro-seconds.
+    uint64 decodeSamples; // The decode timed packets count.
+    uint64 decodeTime;    // The decode sampled time, in micro-seconds.
+    uint64 handleSamples; // The handler timed packets count.
+    uint64 handleTime;    // The handler sampled time, in micro-seconds.
+
+    LLBC_TrafficCounter();
+
+    /**
+     * Reset all counters to zero.
+     */
+    void Reset();
+
+    /**
+     * Get average encode/decode/handle time per packet, in micro-seconds.
+     * @return double - the average time, if no sample, return 0.
+     */
+    double GetAvgEncodeTime() const;
+    double GetAvgDecodeTime() const;
+    double GetAvgHandleTime() const;
+
+    /**
+     * Accumulate other counter.
+     */
+    LLBC_TrafficCounter &operator +=(const LLBC_TrafficCounter &other);
+
+    /**
+     * Get the counter string representation.
+     * @return LLBC_String - the string representation.
+     */
+    LLBC_String ToString() const;
+};
+
+/**
+ * \brief The service traffic statistic snapshot encapsulation.
+ */
+struct LLBC_EXPORT LLBC_TrafficStat
+{
+    typedef std::map<int, LLBC_TrafficCounter> Counters;
+
+    LLBC_TrafficCounter total; // The service total counter.
+    Counters opcodes;          // The per-opcode counters.
+    Counters sessions;         // The per-session counters(destroyed sessions not included).
+
+    /**
+     * Reset snapshot.
+     */
+    void Reset();
+
+    /**
+     * Get the snapshot string representation, opcodes and sessions sorted by sent + received bytes.
+     * @param[in] topN - the max opcodes/sessions count to output.
+     * @return LLBC_String - the string representation.
+     */
+    LLBC_String ToString(size_t topN = LLBC_CFG_COMM_TRAFFIC_STAT_DFT_DUMP_TOP) const;
+};
+
+__LLBC_NS_END
+
+#endif // !__LLBC_COMM_TRAFFIC_STAT_H__
@@ -0,0 +1,149 @@
+/**
+ * @file    TrafficStatCollector.h
+ * @author  Longwei Lai<lailongwei@126.com>
+ * @date    2026/10/18
+ * @version 1.0
+ *
+ * @brief   The service traffic statistic collector.
+ */
+#ifndef __LLBC_COMM_TRAFFIC_STAT_COLLECTOR_H__
+#define __LLBC_COMM_TRAFFIC_STAT_COLLECTOR_H__
+
+#include "llbc/common/Common.h"
+#include "llbc/core/Core.h"
+
+#include "llbc/comm/TrafficStat.h"
+
+__LLBC_NS_BEGIN
+
+/**
+ * \brief The service traffic statistic collector class encapsulation.
+ *
+ * Packets are encoded in sender threads and decoded/handled in service thread, to avoid cross-thread
+ * counter contention, collector keep one counters shard per thread, shard only written by its owner
+ * thread, counters update is lock free(relaxed stores), snapshot read counters with relaxed loads.
+ * The shard lock only guard shard structure changes(opcode array grow, map insert/erase), owner take
+ * it on slow path(first time see opcode/session), snapshot take it to iterate shard safely. Other
+ * threads never erase shard sessions directly, session remove only mark pending, owner apply it.
+ * The current thread shard is cached in thread local slots(keyed by collector serial number, so the
+ * deleted collector's cache never be hit), missed thread will lookup/create shard by its TLS address.
+ */
+class LLBC_EXPORT LLBC_TrafficStatCollector
+{
+public:
+    LLBC_TrafficStatCollector();
+    ~LLBC_TrafficStatCollector();
+
+public:
+    /**
+     * Check current sending/received packet need timing or not(every LLBC_CFG_COMM_TRAFFIC_STAT_TIMING_SAMPLE
+     * packets time once, send and receive counted separately per thread, handlers usually send packets,
+     * shared tick will make the sampled packets always on one side).
+     * The ticks are plain thread local counters(shared by all collectors in the thread), check not
+     * need shard lookup.
+     * @return bool - return true if need timing, otherwise return false.
+     */
+    static bool IsSendTimingSample();
+    static bool IsRecvTimingSample();
+
+    /**
+     * Record sent packet.
+     * @param[in] sessionId  - the session Id.
+     * @param[in] opcode     - the opcode.
+     * @param[in] bytes      - the payload bytes.
+     * @param[in] encodeTime - the encode time(micro-seconds), if not timed, pass -1.
+     */
+    void OnSent(int sessionId, int opcode, size_t bytes, sint64 encodeTime);
+
+    /**
+     * Record multicast sent packet, the encode time only count once on opcode, every target session
+     * count it as its packet encode time(packet encoded once, shared by all sessions).
+     * @param[in] sessionIds - the session Ids.
+     * @param[in] opcode     - the opcode.
+     * @param[in] bytes      - the payload bytes.
+     * @param[in] encodeTime - the encode time(micro-seconds), if not timed, pass -1.
+     */
+    void OnMulticastSent(const LLBC_SessionIdList &sessionIds, int opcode, size_t bytes, sint64 encodeTime);
+
+    /**
+     * Record received and handled packet.
+     * @param[in] sessionId  - the session Id.
+     * @param[in] opcode     - the opcode.
+     * @param[in] bytes      - the payload bytes.
+     * @param[in] decodeTime - the decode time(micro-seconds), if not timed, pass -1.
+     * @param[in] handleTime - the handler time(micro-seconds), if not timed, pass -1.
+     */
+    void OnRecved(int sessionId, int opcode, size_t bytes, sint64 decodeTime, sint64 handleTime);
+
+    /**
+     * Remove session counters, call when session destroyed.
+     * @param[in] sessionId - the session Id.
+     */
+    void RemoveSession(int sessionId);
+
+    /**
+     * Get all shards merged snapshot, thread safe.
+     * @param[out] stat - the traffic statistic snapshot.
+     */
+    void Snapshot(LLBC_TrafficStat &stat);
+
+private:
+    /**
+     * The per-thread counters shard.
+     * Opcode counters stored in flat array indexed by opcode like opcode dispatch table(opcodes in
+     * [0, LLBC_CFG_COMM_OPCODE_DISPATCH_DENSE_LIMIT) dense, other opcodes in sparse map), recent session
+     * counters cached in direct mapped slots(by session Id, map nodes are stable), most packets can
+     * skip map lookup.
+     */
+    struct _Shard
+    {
+        enum
+        {
+            SessionCacheSlots = 64
+        };
+
+        volatile sint32 locked;
+        volatile sint32 removePending;
+
+        LLBC_TrafficCounter *denseOpcodes;
+        int denseOpcodeSize;
+        LLBC_TrafficStat::Counters sparseOpcodes;
+        LLBC_TrafficStat::Counters sessions;
+        std::set<int> removedSessions;
+
+        int sessionCacheIds[SessionCacheSlots];
+        LLBC_TrafficCounter *sessionCacheCounters[SessionCacheSlots];
+
+        _Shard();
+        ~_Shard();
+    };
+
+    _Shard *GetShard();
+    _Shard *LookupShard();
+
+    static void LockShard(_Shard *shard);
+    static void UnlockShard(_Shard *shard);
+
+    /**
+     * Apply other threads removed sessions, call in shard owner thread.
+     */
+    static void ApplyRemovedSessions(_Shard *shard);
+
+    static LLBC_TrafficCounter &GetOpcodeCounter(_Shard *shard, int opcode);
+    static LLBC_TrafficCounter &GetOpcodeCounterSlow(_Shard *shard, int opcode);
+    static LLBC_TrafficCounter &GetSessionCounter(_Shard *shard, int sessionId);
+
+    static void AddSent(LLBC_TrafficCounter &counter, size_t packets, size_t bytes, sint64 encodeTime);
+    static void AddRecved(LLBC_TrafficCounter &counter, size_t bytes, sint64 decodeTime, sint64 handleTime);
+    static void LoadCounter(const LLBC_TrafficCounter &counter, LLBC_TrafficCounter &loaded);
+
+private:
+    sint64 _serial;
+
+    LLBC_SpinLock _shardsLock;
+    std::map<const void *, _Shard *> _shards;
+};
+
+__LLBC_NS_END
+
+#endif // !__LLBC_COMM_TRAFFIC_STAT_COLLECTOR_H__
@@ -0,0 +1,289 @@
+/**
+ * @file    PacketHeaderLayout.h
+ * @author  Longwei Lai<lailongwei@126.com>
+ * @date    2026/10/18
+ * @version 1.0
+ *
+ * @brief   The compile-time packet header layout.
+ */
+#ifndef __LLBC_COMM_PACKET_HEADER_LAYOUT_H__
+#define __LLBC_COMM_PACKET_HEADER_LAYOUT_H__
+
+#include "llbc/common/Common.h"
+#include "llbc/core/Core.h"
+#include "llbc/objbase/ObjBase.h"
+
+#include "llbc/comm/headerdesc/PacketHeaderDesc.h"
+
+__LLBC_NS_BEGIN
+
+/**
+ * \brief The packet header field codec, read/write fixed width integer field.
+ *        Field width only support 0(field not exist), 1, 2, 4, 8 bytes.
+ *        In net order, value compose by shift, compilers fold it to one load + one byte-swap,
+ *        and not depend on runtime machine endian check.
+ */
+template <size_t _Width>
+struct LLBC_PacketHeaderFieldCodec;
+
+template <>
+struct LLBC_PacketHeaderFieldCodec<0>
+{
+    static sint64 Read(const char *buf) { return 0; }
+    static void Write(char *buf, sint64 val) {  }
+};
+
+template <>
+struct LLBC_PacketHeaderFieldCodec<1>
+{
+    static sint64 Read(const char *buf)
+    {
+        return static_cast<sint8>(*buf);
+    }
+
+    static void Write(char *buf, sint64 val)
+    {
+        *buf = static_cast<char>(val);
+    }
+};
+
+template <>
+struct LLBC_PacketHeaderFieldCodec<2>
+{
+    static sint64 Read(const char *buf)
+    {
+#if LLBC_CFG_COMM_ORDER_IS_NET_ORDER
+        const uint8 *p = reinterpret_cast<const uint8 *>(buf);
+        return static_cast<sint16>((static_cast<uint16>(p[0]) << 8) | p[1]);
+#else // !LLBC_CFG_COMM_ORDER_IS_NET_ORDER
+        sint16 val;
+        ::memcpy(&val, buf, sizeof(val));
+        return val;
+#endif // LLBC_CFG_COMM_ORDER_IS_NET_ORDER
+    }
+
+    static void Write(char *buf, sint64 val)
+    {
+#if LLBC_CFG_COMM_ORDER_IS_NET_ORDER
+        const uint16 v = static_cast<uint16>(val);
+        uint8 *p = reinterpret_cast<uint8 *>(buf);
+        p[0] = static_cast<uint8>(v >> 8);
+        p[1] = static_cast<uint8>(v);
+#else // !LLBC_CFG_COMM_ORDER_IS_NET_ORDER
+        const sint16 v = static_cast<sint16>(val);
+        ::memcpy(buf, &v, sizeof(v));
+#endif // LLBC_CFG_COMM_ORDER_IS_NET_ORDER
+    }
+};
+
+template <>
+struct LLBC_PacketHeaderFieldCodec<4>
+{
+    static sint64 Read(const char *buf)
+    {
+#if LLBC_CFG_COMM_ORDER_IS_NET_ORDER
+        const uint8 *p = reinterpret_cast<const uint8 *>(buf);
+        return static_cast<sint32>((static_cast<uint32>(p[0]) << 24) |
+                                   (static_cast<uint32>(p[1]) << 16) |
+                                   (static_cast<uint32>(p[2]) << 8) |
+                                    static_cast<uint32>(p[3]));
+#else // !LLBC_CFG_COMM_ORDER_IS_NET_ORDER
+        sint32 val;
+        ::memcpy(&val, buf, sizeof(val));
+        return val;
+#endif // LLBC_CFG_COMM_ORDER_IS_NET_ORDER
+    }
+
+    static void Write(char *buf, sint64 val)
+    {
+#if LLBC_CFG_COMM_ORDER_IS_NET_ORDER
+        const uint32 v = static_cast<uint32>(val);
+        uint8 *p = reinterpret_cast<uint8 *>(buf);
+        p[0] = static_cast<uint8>(v >> 24);
+        p[1] = static_cast<uint8>(v >> 16);
+        p[2] = static_cast<uint8>(v >> 8);
+        p[3] = static_cast<uint8>(v);
+#else // !LLBC_CFG_COMM_ORDER_IS_NET_ORDER
+        const sint32 v = static_cast<sint32>(val);
+        ::memcpy(buf, &v, sizeof(v));
+#endif // LLBC_CFG_COMM_ORDER_IS_NET_ORDER
+    }
+};
+
+template <>
+struct LLBC_PacketHeaderFieldCodec<8>
+{
+    static sint64 Read(const char *buf)
+    {
+#if LLBC_CFG_COMM_ORDER_IS_NET_ORDER
+        const uint8 *p = reinterpret_cast<const uint8 *>(buf);
+        uint64 v = 0;
+        for (int i = 0; i < 8; i++)
+            v = (v << 8) | p[i];
+        return static_cast<sint64>(v);
+#else // !LLBC_CFG_COMM_ORDER_IS_NET_ORDER
+        sint64 val;
+        ::memcpy(&val, buf, sizeof(val));
+        return val;
+#endif // LLBC_CFG_COMM_ORDER_IS_NET_ORDER
+    }
+
+    static void Write(char *buf, sint64 val)
+    {
+#if LLBC_CFG_COMM_ORDER_IS_NET_ORDER
+        uint64 v = static_cast<uint64>(val);
+        uint8 *p = reinterpret_cast<uint8 *>(buf);
+        for (int i = 7; i >= 0; i--)
+        {
+            p[i] = static_cast<uint8>(v);
+            v >>= 8;
+        }
+#else // !LLBC_CFG_COMM_ORDER_IS_NET_ORDER
+        ::memcpy(buf, &val, sizeof(val));
+#endif // LLBC_CFG_COMM_ORDER_IS_NET_ORDER
+    }
+};
+
+/**
+ * \brief The packet header fixed offset, fixed width field.
+ */
+template <size_t _Offset, size_t _Width>
+struct LLBC_PacketHeaderField
+{
+    enum
+    {
+        Offset = _Offset,
+        Width = _Width,
+        IsExist = _Width != 0
+    };
+
+    /**
+     * Get field value from header buffer, if field not exist, return 0.
+     */
+    static int Get(const void *header)
+    {
+        return static_cast<int>(LLBC_PacketHeaderFieldCodec<_Width>::Read(
+            reinterpret_cast<const char *>(header) + _Offset));
+    }
+
+    /**
+     * Set field value to header buffer, if field not exist, do nothing.
+     */
+    static void Set(void *header, sint64 val)
+    {
+        LLBC_PacketHeaderFieldCodec<_Width>::Write(
+            reinterpret_cast<char *>(header) + _Offset, val);
+    }
+
+    /**
+     * Check the runtime header describe part is match this field or not.
+     */
+    static bool IsMatch(bool hasPart, size_t partOffset, size_t partLen)
+    {
+        if (!IsExist)
+            return !hasPart;
+
+        return hasPart && partOffset == _Offset && partLen == _Width;
+    }
+};
+
+/**
+ * \brief The compile-time packet header layout.
+ *
+ * Header parts are laid out in order: Length, Opcode, Status, ServiceId, Flags,
+ * every part width in bytes, 0 means the part not exist(Length part must exist),
+ * and length part value included whole header length.
+ * Use this template to declare header layout, packet will use fixed offset, fixed width
+ * access when the runtime header describe matches library compiled layout(see
+ * LLBC_FixedPacketHeaderLayout), otherwise fallback to runtime header describe.
+ */
+template <size_t _LenWidth,
+          size_t _OpcodeWidth,
+          size_t _StatusWidth,
+          size_t _ServiceIdWidth,
+          size_t _FlagsWidth>
+struct LLBC_PacketHeaderLayout
+{
+    typedef LLBC_PacketHeaderField<0, _LenWidth> Length;
+    typedef LLBC_PacketHeaderField<Length::Offset + _LenWidth, _OpcodeWidth> Opcode;
+    typedef LLBC_PacketHeaderField<Opcode::Offset + _OpcodeWidth, _StatusWidth> Status;
+    typedef LLBC_PacketHeaderField<Status::Offset + _StatusWidth, _ServiceIdWidth> ServiceId;
+    typedef LLBC_PacketHeaderField<ServiceId::Offset + _ServiceIdWidth, _FlagsWidth> Flags;
+
+    enum
+    {
+        HeaderLen = Flags::Offset + _FlagsWidth
+    };
+
+    /**
+     * Build the runtime packet header describe of this layout, parts serial No is 0~4.
+     * @return LLBC_PacketHeaderDesc * - the new packet header describe.
+     */
+    static LLBC_PacketHeaderDesc *BuildDesc()
+    {
+        LLBC_PacketHeaderDesc *desc = LLBC_New(LLBC_PacketHeaderDesc);
+        desc->AddPartDesc().SetSerialNo(0).SetPartLen(_LenWidth).SetIsLenPart(true).Done();
+        if (Opcode::IsExist)
+            desc->AddPartDesc().SetSerialNo(1).SetPartLen(_OpcodeWidth).SetIsOpcodePart(true).Done();
+        if (Status::IsExist)
+            desc->AddPartDesc().SetSerialNo(2).SetPartLen(_StatusWidth).SetIsStatusPart(true).Done();
+        if (ServiceId::IsExist)
+            desc->AddPartDesc().SetSerialNo(3).SetPartLen(_ServiceIdWidth).SetIsServiceIdPart(true).Done();
+        if (Flags::IsExist)
+            desc->AddPartDesc().SetSerialNo(4).SetPartLen(_FlagsWidth).SetIsFlagsPart(true).Done();
+
+        return desc;
+    }
+
+    /**
+     * Check the runtime packet header describe is match this layout or not.
+     * @param[in] desc - the runtime packet header describe.
+     * @return bool - return true if match, otherwise return false.
+     */
+    static bool IsMatch(const LLBC_PacketHeaderDesc &desc)
+    {
+        if (desc.GetHeaderLen() != static_cast<size_t>(HeaderLen) ||
+            desc.GetLenPartIncludedLen() != static_cast<size_t>(HeaderLen))
+            return false;
+
+        const bool hasLen = desc.GetLenPart() != NULL;
+        return Length::IsMatch(hasLen,
+                               hasLen ? desc.GetLenPartOffset() : 0,
+                               hasLen ? desc.GetLenPartLen() : 0) &&
+               Opcode::IsMatch(desc.IsHasOpcodePart(),
+                               desc.IsHasOpcodePart() ? desc.GetOpcodePartOffset() : 0,
+                               desc.IsHasOpcodePart() ? desc.GetOpcodePartLen() : 0) &&
+               Status::IsMatch(desc.IsHasStatusPart(),
+                               desc.IsHasStatusPart() ? desc.GetStatusPartOffset() : 0,
+                               desc.IsHasStatusPart() ? desc.GetStatusPartLen() : 0) &&
+               ServiceId::IsMatch(desc.IsHasServiceIdPart(),
+                                  desc.IsHasServiceIdPart() ? desc.GetServiceIdPartOffset() : 0,
+                                  desc.IsHasServiceIdPart() ? desc.GetServiceIdPartLen() : 0) &&
+               Flags::IsMatch(desc.IsHasFlagsPart(),
+                              desc.IsHasFlagsPart() ? desc.GetFlagsPartOffset() : 0,
+                              desc.IsHasFlagsPart() ? desc.GetFlagsPartLen() : 0);
+    }
+};
+
+/**
+ * The llbc library default packet header layout.
+ *   |    Type   | Offset |  Len |
+ * --|-----------|--------|------|--
+ *   |   Length  |    0   |   4  |
+ *   |   Opcode  |    4   |   4  |
+ *   |   Status  |    8   |   2  |
+ *   | ServiceId |   10   |   2  |
+ *   |   Flags   |   12   |   2  |
+ *Header total length: 14 bytes.
+ */
+typedef LLBC_PacketHeaderLayout<4, 4, 2, 2, 2> LLBC_LibPacketHeaderLayout;
+
+/**
+ * The library compiled fixed packet header layout, if your application use other fixed header,
+ * modify this typedef and rebuild library.
+ */
+typedef LLBC_LibPacketHeaderLayout LLBC_FixedPacketHeaderLayout;
+
+__LLBC_NS_END
+
+#endif // !__LLBC_COMM_PACKET_HEADER_LAYOUT_H__
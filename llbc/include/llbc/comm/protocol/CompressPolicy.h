@@ -0,0 +1,55 @@
+/**
+ * @file    CompressPolicy.h
+ * @author  Longwei Lai<lailongwei@126.com>
+ * @date    2026/10/18
+ * @version 1.0
+ *
+ * @brief
+ */
+#ifndef __LLBC_COMM_COMPRESS_POLICY_H__
+#define __LLBC_COMM_COMPRESS_POLICY_H__
+
+#include "llbc/common/Common.h"
+#include "llbc/core/Core.h"
+
+__LLBC_NS_BEGIN
+
+/**
+ * \brief The Compress-Layer compress policy enumerations.
+ */
+class LLBC_EXPORT LLBC_CompressPolicy
+{
+public:
+    enum
+    {
+        Begin,
+
+        // Don't compress packet.
+        None = Begin,
+        // Compress packet when packet payload length >= threshold.
+        Threshold,
+        // Always compress packet.
+        Always,
+
+        End
+    };
+
+public:
+    /**
+     * Check given compress policy legal or not.
+     * @param[in] policy - the compress policy.
+     * @return bool - return true if validate, otherwise return false.
+     */
+    static bool IsValid(int policy);
+
+    /**
+     * Get the compress policy string representation.
+     * @param[in] policy - the compress policy.
+     * @return const LLBC_String & - the compress policy string representation.
+     */
+    static const LLBC_String &Policy2Str(int policy);
+};
+
+__LLBC_NS_END
+
+#endif // !__LLBC_COMM_COMPRESS_POLICY_H__
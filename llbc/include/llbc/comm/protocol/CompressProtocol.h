@@ -17,8 +17,23 @@
 
 __LLBC_NS_BEGIN
 
+/**
+ * Previous declare some classes.
+ */
+class LLBC_Packet;
+
+__LLBC_NS_END
+
+__LLBC_NS_BEGIN
+
 /**
  * \brief The Compress-Layer protocol implement.
+ *
+ * Compress packet payload use LZ4 block format, compressed packet payload layout:
+ *      | original payload length(4 bytes) | compressed payload |
+ * And packet will be marked LLBC_CFG_COMM_COMPRESSED_FLAG flag, receiver side
+ * will decompress all marked packets, not care self compress policy.
+ * Only the packet header has flags part(length >= 2 bytes), compress layer can work.
  */
 class LLBC_EXPORT LLBC_CompressProtocol : public LLBC_IProtocol
 {
@@ -69,6 +84,41 @@ public:
      * @return int - return 0 if success, otherwise return -1.
      */
     virtual int AddCoder(int opcode, LLBC_ICoderFactory *coder);
+
+public:
+    /**
+     * Set the compress policy, must be called before protocol used(before service start).
+     * @param[in] policy           - the service compress policy, see LLBC_CompressPolicy.
+     * @param[in] threshold        - the compress threshold, use in LLBC_CompressPolicy::Threshold policy.
+     * @param[in] opcodePolicies   - the opcode specific compress policies(opcode->policy), can be NULL,
+     *                               protocol will not copy it, caller must keep it alive and immutable.
+     */
+    void SetCompressPolicy(int policy, size_t threshold, const std::map<int, int> *opcodePolicies);
+
+private:
+    /**
+     * Check given packet need compress or not.
+     * @param[in] packet - the packet.
+     * @return bool - need compress return true, otherwise return false.
+     */
+    bool IsNeedCompress(const LLBC_Packet *packet) const;
+
+    /**
+     * Report decompress error, and delete packet.
+     * @param[in] packet         - the packet.
+     * @param[in] reason         - the error reason.
+     * @param[out] removeSession - the remove session flag, always set to true.
+     * @return int - always return -1.
+     */
+    int OnDecompressFailed(LLBC_Packet *packet, const char *reason, bool &removeSession);
+
+private:
+    const bool _flagsSupported;
+    const size_t _headerLen;
+
+    int _policy;
+    size_t _threshold;
+    const std::map<int, int> *_opcodePolicies;
 };
 
 __LLBC_NS_END
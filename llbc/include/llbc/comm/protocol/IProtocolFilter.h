@@ -17,6 +17,9 @@ __LLBC_NS_BEGIN
 
 /**
  * \brief The protocol filter class encapsulation.
+ *
+ * Filter methods maybe called in multi threads concurrently(sending threads, poller threads), must be
+ * thread safe, see LLBC_IService::SetProtocolFilter().
  */
 class LLBC_EXPORT LLBC_IProtocolFilter
 {
@@ -81,6 +81,36 @@ public:
      */
     virtual int AddCoder(int opcode, LLBC_ICoderFactory *coder);
 
+public:
+    /**
+     * Set the max packet length(header + payload), the packet which length exceed it will be
+     * rejected when packet header received, and session will be removed.
+     * @param[in] maxPacketLen - the max packet length, 0 means no limit.
+     */
+    void SetMaxPacketLen(size_t maxPacketLen);
+
+    /**
+     * Set the chunked receive chunk size, the packet which payload length exceed chunk size will be
+     * delivered as payload chunks, not buffer whole packet(compressed packet always receive whole).
+     * @param[in] chunkSize - the chunk size, 0 means disable chunked receive.
+     */
+    void SetRecvChunkSize(size_t chunkSize);
+
+private:
+    /**
+     * Output current chunk packet, and create next chunk packet if whole payload not received.
+     */
+    void OutputChunk();
+
+    /**
+     * Report invalid packet length error, and cleanup receive status.
+     * @param[in] len            - the invalid packet length.
+     * @param[out] out           - the output packets, the packets framed before invalid packet will keep.
+     * @param[out] removeSession - the remove session flag, always set to true.
+     * @return int - always return -1.
+     */
+    int OnInvalidPacketLen(int len, void *&out, bool &removeSession);
+
 private:
     LLBC_PacketHeaderAssembler _headerAssembler;
 
@@ -88,7 +118,14 @@ private:
     int _payloadNeedRecv;
     int _payloadRecved;
 
+    size_t _maxPacketLen;
+    size_t _chunkSize;
+    bool _chunking;
+
+    const size_t _headerLen;
     const int _headerIncludedLen;
+
+    LLBC_MessageBlock _outPackets;
 };
 
 __LLBC_NS_END
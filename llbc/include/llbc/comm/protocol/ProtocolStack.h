@@ -26,6 +26,8 @@ class LLBC_IProtocolFilter;
 class LLBC_ICoderFactory;
 class LLBC_Session;
 class LLBC_IService;
+class LLBC_RecvSlab;
+class LLBC_OpcodeDispatchTable;
 
 __LLBC_NS_END
 
@@ -78,6 +80,13 @@ public:
      */
     void SetIsSuppressedCoderNotFoundWarning(bool suppressed);
 
+    /**
+     * Set service compiled opcode dispatch table to protocol-stack, if set,
+     * Codec-Layer protocol will find coder in the table, otherwise find in protocol added coders.
+     * @param[in] dispatchTable - the opcode dispatch table.
+     */
+    void SetDispatchTable(const LLBC_OpcodeDispatchTable *dispatchTable);
+
 public:
     /**
      * Set protocol to protocol stack.
@@ -136,12 +145,15 @@ public:
 
     /**
      * When message receive, will use this protocol stack method to convert message-block to undecoded.
+     * Note: The message block is borrowed, protocol stack will not delete it.
      * @param[in] block          - the message block.
-     * @param[in] packets        - the packets.
+     * @param[in] slab           - the receive slab which block data lie in, if not NULL,
+     *                             the packets which entirely lie in block will reference slab without copy.
+     * @param[in] packets        - the packets, when error occurred, hold the packets converted before the error.
      * @param[out] removeSession - when error occurred, this out param determine remove session or not.
      * @return int - return 0 if success, otherwise return -1.
      */
-    int RecvRaw(LLBC_MessageBlock *block, std::vector<LLBC_Packet *> &packets, bool &removeSession);
+    int RecvRaw(LLBC_MessageBlock *block, LLBC_RecvSlab *slab, std::vector<LLBC_Packet *> &packets, bool &removeSession);
 
     /**
      * When packet receive, will use this protocol stack method to decode and filter.
@@ -154,12 +166,14 @@ public:
 
     /**
      * When packet recv, will use this protocol stack method to convert message-block type to packets.
+     * Note: The message block is borrowed, protocol stack will not delete it.
      * @param[in] block          - the message block.
-     * @param[in] packets        - the converted packet list.
+     * @param[in] slab           - the receive slab which block data lie in, can be NULL.
+     * @param[in] packets        - the converted packet list, when error occurred, hold the packets converted before the error.
      * @param[out] removeSession - when error occurred, this out param determine remove session or not.
      * @return int - return 0 if success, otherwise return -1.
      */
-    int Recv(LLBC_MessageBlock *block, std::vector<LLBC_Packet *> &packets, bool &removeSession);
+    int Recv(LLBC_MessageBlock *block, LLBC_RecvSlab *slab, std::vector<LLBC_Packet *> &packets, bool &removeSession);
 
 private:
     /**
@@ -192,8 +206,12 @@ private:
     LLBC_IService *_svc;
     LLBC_Session *_session;
     bool _suppressCoderNotFoundError;
+    const LLBC_OpcodeDispatchTable *_dispatchTable;
 
     LLBC_IProtocol *_protos[LLBC_ProtocolLayer::End];
+
+    LLBC_RecvSlab *_recvSlab;
+    std::vector<LLBC_Packet *> _rawPackets;
 };
 
 __LLBC_NS_END
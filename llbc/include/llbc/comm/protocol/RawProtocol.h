@@ -78,6 +78,8 @@ private:
 
     size_t _lenOffset;
     size_t _lenSize;
+
+    LLBC_MessageBlock _outPackets;
 };
 
 __LLBC_NS_END
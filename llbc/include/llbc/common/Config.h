@@ -60,6 +60,10 @@
 #define LLBC_CFG_THREAD_MINIMUM_STACK_SIZE                  (1 * 1024 * 1024)
 // Message block default size.
 #define LLBC_CFG_THREAD_MSG_BLOCK_DFT_SIZE                  (1024)
+// The cache line size, use to separate the members which frequently written by different threads.
+#define LLBC_CFG_THREAD_CACHE_LINE_SIZE                     (64)
+// The lock-free SPSC mode message queue chunk size(message block pointers count per chunk).
+#define LLBC_CFG_THREAD_SPSC_MSG_QUEUE_CHUNK_SIZE           (256)
 
 /**
  * \brief Core/Log about config options define.
@@ -113,6 +117,18 @@
 #define LLBC_CFG_CORE_TIMER_STRICT_SCHEDULE                 0
 // Long timeout time, when a timer timeout time >= <this value>, when call Cancel(), will force remove from binary heap.
 #define LLBC_CFG_CORE_TIMER_LONG_TIMEOUT_TIME               864000000 // 10 days
+// Default timer scheduler type, 0: binary heap, 1: timing wheel(see LLBC_TimerScheduler::Type).
+#define LLBC_CFG_CORE_TIMER_DFT_SCHEDULER_TYPE              0
+// Max cached timer data count per timer scheduler.
+#define LLBC_CFG_CORE_TIMER_MAX_POOLED_TIMER_DATA           65536
+
+/**
+ * \brief core/coro about configs.
+ */
+// Default coroutine stack size, in bytes(not include guard page).
+#define LLBC_CFG_CORE_CORO_DFT_STACK_SIZE                   65536
+// Max pooled coroutine stacks count(only default size stacks will be pooled).
+#define LLBC_CFG_CORE_CORO_MAX_POOLED_STACKS                1024
 
 /**
  * \brief ObjBase about configs.
@@ -131,12 +147,24 @@
  */
 // The network data order define, default is non-net order.
 #define LLBC_CFG_COMM_ORDER_IS_NET_ORDER                    1
+// Enable fixed packet header layout access(see LLBC_FixedPacketHeaderLayout), when the runtime
+// packet header describe match the layout, packet header parts will access by fixed offset and width.
+#define LLBC_CFG_COMM_USE_FIXED_PACKET_HEADER_LAYOUT        1
 // Default connect timeout time.
 #define LLBC_CFG_COMM_DFT_CONN_TIMEOUT                      10
 // The network concurrent listen sockets count.
 #define LLBC_CFG_COMM_MAX_EVENT_COUNT                       100
 // The epool max listen socket fd size(LINUX platform specific, only available before 2.6.8 version kernel before).
 #define LLBC_CFG_EPOLL_MAX_LISTEN_FD_SIZE                   10000
+// The epoll poller max wait time(in milli-seconds), poller will be waked up by eventfd when has queued events.
+#define LLBC_CFG_EPOLL_MAX_WAIT_TIME                        1000
+// The io_uring poller submission queue entries count(LINUX platform specific), completion queue size is 4 times of it.
+#define LLBC_CFG_IOURING_SQ_ENTRIES                         256
+// The io_uring poller provided recv buffers count(must be power of 2) and per buffer size.
+#define LLBC_CFG_IOURING_RECV_BUF_COUNT                     256
+#define LLBC_CFG_IOURING_RECV_BUF_SIZE                      16384
+// The io_uring poller max wait time(in milli-seconds), poller will be waked up by eventfd when has queued events.
+#define LLBC_CFG_IOURING_MAX_WAIT_TIME                      1000
 // Default socket send buffer size.
 #define LLBC_CFG_COMM_DFT_SEND_BUF_SIZE                     65536
 // Default socket recv buffer size.
@@ -147,6 +175,8 @@
 #define LLBC_CFG_COMM_MIN_SERVICE_FPS                       1
 // Max service FPS value.
 #define LLBC_CFG_COMM_MAX_SERVICE_FPS                       200
+// Max service dispatch workers count.
+#define LLBC_CFG_COMM_MAX_SERVICE_DISPATCH_WORKERS          64
 // Sampler support option, default is true.
 #define LLBC_CFG_COMM_ENABLE_SAMPLER_SUPPORT                1
 // Per thread drive max services count.
@@ -159,22 +189,94 @@
 #define LLBC_CFG_COMM_ENABLE_STATUS_DESC                    1
 // Determine enable the unify pre-subscribe handler support or not.
 #define LLBC_CFG_COMM_ENABLE_UNIFY_PRESUBSCRIBE             1
+// The service lock-free session table slots count(must be power of 2),
+// session lookup is O(1) and lock-free when live sessions count not exceed this value.
+#define LLBC_CFG_COMM_SESSION_TABLE_SIZE                    65536
+// The service opcode dispatch table dense limit, opcodes in [0, limit) dispatch by directly indexed array,
+// other opcodes dispatch by hash table.
+#define LLBC_CFG_COMM_OPCODE_DISPATCH_DENSE_LIMIT           65536
+// The poller receive slab size, the packets which entirely lie in one slab will not copy.
+#define LLBC_CFG_COMM_RECV_SLAB_SIZE                        65536
+// The poller receive slab min receive size, when slab writable size less than it, switch to next slab.
+#define LLBC_CFG_COMM_RECV_SLAB_MIN_RECV_SIZE               4096
+// The poller receive slab pool max recycled slabs count.
+#define LLBC_CFG_COMM_RECV_SLAB_POOL_SIZE                   64
+// The service/poller event pool max pooled node size(in bytes), the events larger than it will not be pooled.
+#define LLBC_CFG_COMM_EVENT_POOL_MAX_NODE_SIZE              256
+// The service/poller event pool per size class max cached nodes count.
+#define LLBC_CFG_COMM_EVENT_POOL_MAX_CACHED_NODES           8192
+// The poller default recv budget(in bytes) of one session readable event, when exhausted, session will be re-armed
+// and continue receive in next poller loop, let other sessions in same poller can be serviced.
+// if set to 0, session will receive until would-block.
+#define LLBC_CFG_COMM_DFT_RECV_BUDGET                       (256 * 1024)
+// The session send queue default high/low water marks(in bytes), when session queued not sent bytes reach
+// high water mark, session enter backpressure state, when drain to low water mark, leave backpressure state.
+// if high water mark set to 0, backpressure disabled.
+#define LLBC_CFG_COMM_DFT_SEND_HIGH_WATER_MARK              0
+#define LLBC_CFG_COMM_DFT_SEND_LOW_WATER_MARK               0
+// The Compress-Layer compressed flag, when packet compressed, this flag will add to packet flags part,
+// this flag reserved by library, user should not use it(need packet header has flags part, and length >= 2 bytes).
+#define LLBC_CFG_COMM_COMPRESSED_FLAG                       0x4000
+// The Compress-Layer default compress threshold(payload length), use in LLBC_CompressPolicy::Threshold policy.
+#define LLBC_CFG_COMM_DFT_COMPRESS_THRESHOLD                1024
+// The Compress-Layer max decompressed length, if compressed packet original length exceed it, session will be removed.
+#define LLBC_CFG_COMM_MAX_DECOMPRESS_LEN                    (16 * 1024 * 1024)
+// The Pack-Layer default max packet length(header + payload), the packet which length exceed it will be rejected
+// when packet header received, and session will be removed, if set to 0, no limit.
+#define LLBC_CFG_COMM_DFT_MAX_PACKET_LEN                    0
+// The Pack-Layer default chunked receive chunk size, in chunked receive mode, the packet which payload length
+// exceed it will be delivered as payload chunks.
+#define LLBC_CFG_COMM_DFT_RECV_CHUNK_SIZE                   (64 * 1024)
+// The service coalesced send default session max pending bytes(payload length), when exceed, flush immediately.
+#define LLBC_CFG_COMM_DFT_COALESCED_SEND_MAX_BYTES          (64 * 1024)
+// The service coalesced send default max pending latency(in milli-seconds), when exceed, flush immediately,
+// if set to 0, coalesced packets only flush at service frame end or bytes limit exceeded.
+#define LLBC_CFG_COMM_DFT_COALESCED_SEND_MAX_LATENCY        5
+// The reliable udp session default MTU(datagram max size, include 24 bytes segment header).
+#define LLBC_CFG_COMM_RUDP_DFT_MTU                          1400
+// The reliable udp session default send/receive window size(in segments).
+#define LLBC_CFG_COMM_RUDP_DFT_SEND_WND                     128
+#define LLBC_CFG_COMM_RUDP_DFT_RECV_WND                     128
+// The reliable udp session default update interval(in milli-seconds), retransmission and ack check in this interval.
+#define LLBC_CFG_COMM_RUDP_DFT_INTERVAL                     10
+// The reliable udp session default fast retransmit threshold(skipped by later acks count), 0 means disable fast retransmit.
+#define LLBC_CFG_COMM_RUDP_DFT_FAST_RESEND                  2
+// The reliable udp session default min retransmission timeout(in milli-seconds).
+#define LLBC_CFG_COMM_RUDP_DFT_MIN_RTO                      30
+// The reliable udp session default dead link threshold, if any segment retransmitted times reach it, session will be removed.
+#define LLBC_CFG_COMM_RUDP_DFT_DEAD_LINK                    20
+// The reliable udp session default idle timeout(in milli-seconds), if not receive any datagram in this time,
+// session will be removed, the peer keepalive probe will be sent at 1/3 idle timeout, if set to 0, no idle check.
+#define LLBC_CFG_COMM_RUDP_DFT_IDLE_TIMEOUT                 30000
+// The traffic statistic timing sample rate(must be power of 2), every N packets measure encode/decode/handle time once.
+#define LLBC_CFG_COMM_TRAFFIC_STAT_TIMING_SAMPLE            16
+// The traffic statistic default top opcodes/sessions count when dump to string.
+#define LLBC_CFG_COMM_TRAFFIC_STAT_DFT_DUMP_TOP             10
 
 // The poller model config(Platform specific).
 //  Alloc set one of the follow configs(string format, case insensitive).
 //   "SelectPoller" : Use select poller(All platform available).
 //   "EpollPoller"  : Epoll poller(Avaliable in LINUX/Android platform).
+//   "IoUringPoller": io_uring poller(Available in LINUX platform, if kernel not support, fallback to epoll poller).
 //   "IocpPoller"   : Iocp poller(Available in WIN32 platform).
-#if LLBC_TARGET_PLATFORM_LINUX
- #define LLBC_CFG_COMM_POLLER_MODEL                 "EpollPoller"
-#elif LLBC_TARGET_PLATFORM_WIN32
- #define LLBC_CFG_COMM_POLLER_MODEL                 "IocpPoller"
-#elif LLBC_TARGET_PLATFORM_IPHONE
- #define LLBC_CFG_COMM_POLLER_MODEL                 "SelectPoller"
-#elif LLBC_TARGET_PLATFORM_MAC
- #define LLBC_CFG_COMM_POLLER_MODEL                 "SelectPoller"
-#else
- #define LLBC_CFG_COMM_POLLER_MODEL                 "SelectPoller"
-#endif
+//  Build option: define LLBC_CFG_COMM_POLLER_MODEL in compiler flags to override the platform default,
+//   eg: -DLLBC_CFG_COMM_POLLER_MODEL='"IoUringPoller"'.
+#ifndef LLBC_CFG_COMM_POLLER_MODEL
+ #if LLBC_TARGET_PLATFORM_LINUX
+  #define LLBC_CFG_COMM_POLLER_MODEL                "EpollPoller"
+ #elif LLBC_TARGET_PLATFORM_WIN32
+  #define LLBC_CFG_COMM_POLLER_MODEL                "IocpPoller"
+ #elif LLBC_TARGET_PLATFORM_IPHONE
+  #define LLBC_CFG_COMM_POLLER_MODEL                "SelectPoller"
+ #elif LLBC_TARGET_PLATFORM_MAC
+  #define LLBC_CFG_COMM_POLLER_MODEL                "SelectPoller"
+ #else
+  #define LLBC_CFG_COMM_POLLER_MODEL                "SelectPoller"
+ #endif
+#endif // !LLBC_CFG_COMM_POLLER_MODEL
+
+// The poller model runtime option environment variable name, if set to valid poller model(same format
+// as LLBC_CFG_COMM_POLLER_MODEL), all services default use it, eg: LLBC_POLLER_MODEL=IoUringPoller ./testsuite.
+#define LLBC_CFG_COMM_POLLER_MODEL_ENV_NAME         "LLBC_POLLER_MODEL"
 
 #endif // !__LLBC_COM_CONFIG_H__
@@ -52,6 +52,12 @@ struct __LLBC_LibTls
 
         /* Timer scheduler. */
         void *timerScheduler;
+
+        /* Cached monotonic time(in milli-seconds), -1 means not cached. */
+        sint64 cachedMonoTime;
+
+        /* Running coroutine. */
+        void *coro;
     } coreTls;
 
     /* ObjBase-Module TLS valus. */
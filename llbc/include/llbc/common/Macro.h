@@ -210,6 +210,14 @@ private:                                            \
 #define LLBC_THREAD_LOCAL __thread
 #endif
 
+// Initial-exec thread local macro define, ELF platforms access it without __tls_get_addr() call even
+// if in shared library, but it occupy static TLS space, only use for small and hot variables.
+#if LLBC_TARGET_PLATFORM_LINUX || LLBC_TARGET_PLATFORM_ANDROID
+#define LLBC_THREAD_LOCAL_INITIAL_EXEC __thread __attribute__((tls_model("initial-exec")))
+#else
+#define LLBC_THREAD_LOCAL_INITIAL_EXEC LLBC_THREAD_LOCAL
+#endif
+
 // Deprecated attribute macro define.
 #if defined(__GNUC__) && ((__GNUC__ >= 4) || ((__GNUC__ == 3) && (__GNUC_MINOR__ >= 1)))
 #define LLBC_DEPRECATED __attribute__((deprecated))
@@ -41,6 +41,7 @@
  #include <libgen.h>
  #include <sys/time.h>
  #include <sys/socket.h>
+ #include <sys/uio.h>
  #include <netdb.h>
  #include <dirent.h>
  #include <semaphore.h>
@@ -49,6 +50,13 @@
 
  #if LLBC_TARGET_PLATFORM_LINUX
   #include <sys/epoll.h>
+  #include <sys/eventfd.h>
+  #include <sys/syscall.h>
+  #include <linux/futex.h>
+  #include <linux/io_uring.h>
+  #include <poll.h>
+  #include <sys/mman.h>
+  #include <ucontext.h>
  #endif
 
  #if LLBC_TARGET_PLATFORM_MAC || LLBC_TARGET_PLATFORM_IPHONE
@@ -73,6 +73,34 @@ __LLBC_NS_BEGIN
  typedef WSABUF LLBC_SockBuf;
 #endif
 
+/**
+ * The gather-send io vector, use in LLBC_SendV() API.
+ * Use LLBC_IOVEC_SET() macro to fill it, LLBC_IOV_MAX is the max vectors count of one call.
+ */
+#if LLBC_TARGET_PLATFORM_NON_WIN32
+ typedef struct iovec LLBC_IoVec;
+ #define LLBC_IOVEC_SET(vec, data, size)                   \
+    do {                                                  \
+        (vec).iov_base = (data);                          \
+        (vec).iov_len = (size);                           \
+    } while (0)                                           \
+
+ #ifdef IOV_MAX
+  #define LLBC_IOV_MAX IOV_MAX
+ #else
+  #define LLBC_IOV_MAX 1024
+ #endif
+#else
+ typedef WSABUF LLBC_IoVec;
+ #define LLBC_IOVEC_SET(vec, data, size)                   \
+    do {                                                  \
+        (vec).buf = (data);                               \
+        (vec).len = static_cast<ULONG>(size);             \
+    } while (0)                                           \
+
+ #define LLBC_IOV_MAX 1024
+#endif
+
 /**
  * \brief The internal socket address structure encapsulation.
  */
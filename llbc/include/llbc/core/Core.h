@@ -24,6 +24,7 @@
 #include "llbc/core/time/Common.h"
 #include "llbc/core/event/Common.h"
 #include "llbc/core/timer/Common.h"
+#include "llbc/core/coro/Common.h"
 #include "llbc/core/thread/Common.h"
 #include "llbc/core/singleton/Singleton.h"
 #include "llbc/core/log/Common.h"
@@ -0,0 +1,14 @@
+/**
+ * @file    Common.h
+ * @author  Longwei Lai<lailongwei@126.com>
+ * @date    2026/10/18
+ * @version 1.0
+ *
+ * @brief
+ */
+#ifndef __LLBC_CORE_CORO_COMMON_H__
+#define __LLBC_CORE_CORO_COMMON_H__
+
+#include "llbc/core/coro/Coro.h"
+
+#endif // !__LLBC_CORE_CORO_COMMON_H__
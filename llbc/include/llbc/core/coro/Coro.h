@@ -0,0 +1,139 @@
+/**
+ * @file    Coro.h
+ * @author  Longwei Lai<lailongwei@126.com>
+ * @date    2026/10/18
+ * @version 1.0
+ *
+ * @brief   The stackful coroutine.
+ */
+#ifndef __LLBC_CORE_CORO_CORO_H__
+#define __LLBC_CORE_CORO_CORO_H__
+
+#include "llbc/common/Common.h"
+
+#include "llbc/core/utils/Util_DelegateImpl.h"
+
+__LLBC_NS_BEGIN
+
+/**
+ * \brief The stackful coroutine class encapsulation.
+ *
+ * Coroutine run task on its own stack, task can call Suspend() to suspend coroutine and switch back
+ * to the resumer, the resumer call Resume() to continue it later.
+ * Context switch implementation:
+ *  - LINUX x86-64: hand-written switch, only save callee-saved registers and fp control words.
+ *  - LINUX other:  ucontext.
+ *  - WIN32:        fiber.
+ *  - other:        not supported, Resume() will fail with LLBC_ERROR_NOT_IMPL.
+ * Stacks are mmap allocated with a low guard page(stack overflow will crash instead of silent memory
+ * corruption), the default size stacks are pooled(see LLBC_CFG_CORE_CORO_MAX_POOLED_STACKS).
+ * Coroutine is not thread safe, but can resume in any thread, only one thread resume it at a time.
+ */
+class LLBC_EXPORT LLBC_Coro
+{
+public:
+    /**
+     * The coroutine state enumeration.
+     */
+    enum State
+    {
+        Ready,
+        Running,
+        Suspended,
+        Dead
+    };
+
+public:
+    /**
+     * Create coroutine, the stack will be allocated when first resume.
+     * @param[in] task      - the coroutine task, coroutine will take over it, task must not throw exception.
+     * @param[in] stackSize - the stack size, in bytes, will round up to page size.
+     */
+    explicit LLBC_Coro(LLBC_IDelegate0 *task, size_t stackSize = LLBC_CFG_CORE_CORO_DFT_STACK_SIZE);
+
+    /**
+     * Destroy coroutine, if coroutine suspended, the objects on coroutine stack will not be destructed.
+     */
+    ~LLBC_Coro();
+
+public:
+    /**
+     * Get coroutine Id, coroutine Id is unique in process.
+     * @return int - the coroutine Id.
+     */
+    int GetId() const;
+
+    /**
+     * Get coroutine state.
+     * @return State - the coroutine state.
+     */
+    State GetState() const;
+
+    /**
+     * Get coroutine stack size(not include guard page).
+     * @return size_t - the stack size.
+     */
+    size_t GetStackSize() const;
+
+public:
+    /**
+     * Resume coroutine, return when coroutine suspended or finished.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    int Resume();
+
+    /**
+     * Suspend current coroutine, switch back to the resumer.
+     * @return int - return 0 if success, otherwise return -1(not in coroutine).
+     */
+    static int Suspend();
+
+    /**
+     * Get current thread running coroutine.
+     * @return LLBC_Coro * - the running coroutine, if not in coroutine, return NULL.
+     */
+    static LLBC_Coro *GetCurrent();
+
+    /**
+     * Get the pooled stacks count.
+     * @return size_t - the pooled stacks count.
+     */
+    static size_t GetPooledStackCount();
+
+    /**
+     * Purge all pooled stacks, call when library cleanup.
+     */
+    static void PurgeStackPool();
+
+private:
+    /**
+     * Context switch helper methods(implemented by platform specific).
+     */
+    int MakeContext();
+    void DestroyContext();
+    void SwitchIn();
+    void SwitchOut();
+
+    /**
+     * Coroutine entry.
+     */
+    static void Entry(LLBC_Coro *coro);
+
+    LLBC_DISABLE_ASSIGNMENT(LLBC_Coro);
+
+private:
+    int _id;
+    State _state;
+    LLBC_IDelegate0 *_task;
+
+    void *_stack;
+    size_t _stackSize;
+
+    void *_ctx;
+    void *_callerCtx;
+    LLBC_Coro *_caller;
+};
+
+__LLBC_NS_END
+
+#endif // !__LLBC_CORE_CORO_CORO_H__
@@ -313,6 +313,144 @@ inline sint64 LLBC_AtomicCompareAndExchange(volatile sint64 *ptr, sint64 exchang
 #endif
 }
 
+/**
+ * Atomic set pointer value operation.
+ * @param[in/out] ptr - will set's pointer variable address.
+ * @param[in] value   - the new pointer value.
+ * @return void * - the ptr pointer to's old value.
+ */
+inline void *LLBC_AtomicSetPtr(void * volatile *ptr, void *value)
+{
+#if LLBC_TARGET_PLATFORM_LINUX
+    return __sync_lock_test_and_set(ptr, value);
+#elif LLBC_TARGET_PLATFORM_WIN32
+    return ::InterlockedExchangePointer((PVOID volatile *)ptr, value);
+#elif LLBC_TARGET_PLATFORM_IPHONE
+    return __sync_lock_test_and_set(ptr, value);
+#elif LLBC_TARGET_PLATFORM_MAC
+    return __sync_lock_test_and_set(ptr, value);
+#elif LLBC_TARGET_PLATFORM_ANDROID
+    return __sync_lock_test_and_set(ptr, value);
+#endif
+}
+
+/**
+ * Perform an atomic compare-and-exchange operation on the specified pointer values.
+ * @param[in/out] ptr - specifies the address of the destination pointer.
+ * @param[in] exchange  - specifies the exchange pointer.
+ * @param[in] comparand - specifies the pointer compare to destination.
+ * @return void * - returns the initial value of the ptr.
+ */
+inline void *LLBC_AtomicCompareAndExchangePtr(void * volatile *ptr, void *exchange, void *comparand)
+{
+#if LLBC_TARGET_PLATFORM_LINUX
+    return __sync_val_compare_and_swap(ptr, comparand, exchange);
+#elif LLBC_TARGET_PLATFORM_WIN32
+    return ::InterlockedCompareExchangePointer((PVOID volatile *)ptr, exchange, comparand);
+#elif LLBC_TARGET_PLATFORM_IPHONE
+    return __sync_val_compare_and_swap(ptr, comparand, exchange);
+#elif LLBC_TARGET_PLATFORM_MAC
+    return __sync_val_compare_and_swap(ptr, comparand, exchange);
+#elif LLBC_TARGET_PLATFORM_ANDROID
+    return __sync_val_compare_and_swap(ptr, comparand, exchange);
+#endif
+}
+
+/**
+ * Acquire load operation(32 bit/pointer version), the memory operations after this load
+ * can not be reordered before it.
+ * @param[in] ptr - value/pointer variable address.
+ * @return sint32/void * - the loaded value.
+ */
+inline sint32 LLBC_AtomicLoadAcquire(volatile sint32 *ptr)
+{
+#if LLBC_TARGET_PLATFORM_WIN32
+    const sint32 value = *ptr;
+    _ReadWriteBarrier();
+
+    return value;
+#else // Non-Win32
+    return __atomic_load_n(ptr, __ATOMIC_ACQUIRE);
+#endif // LLBC_TARGET_PLATFORM_WIN32
+}
+
+inline void *LLBC_AtomicLoadAcquirePtr(void * volatile *ptr)
+{
+#if LLBC_TARGET_PLATFORM_WIN32
+    void *value = *ptr;
+    _ReadWriteBarrier();
+
+    return value;
+#else // Non-Win32
+    return __atomic_load_n(ptr, __ATOMIC_ACQUIRE);
+#endif // LLBC_TARGET_PLATFORM_WIN32
+}
+
+/**
+ * Release store operation(32 bit/pointer version), the memory operations before this store
+ * can not be reordered after it.
+ * @param[in/out] ptr - value/pointer variable address.
+ * @param[in] value   - the new value.
+ */
+inline void LLBC_AtomicStoreRelease(volatile sint32 *ptr, sint32 value)
+{
+#if LLBC_TARGET_PLATFORM_WIN32
+    _ReadWriteBarrier();
+    *ptr = value;
+#else // Non-Win32
+    __atomic_store_n(ptr, value, __ATOMIC_RELEASE);
+#endif // LLBC_TARGET_PLATFORM_WIN32
+}
+
+inline void LLBC_AtomicStoreReleasePtr(void * volatile *ptr, void *value)
+{
+#if LLBC_TARGET_PLATFORM_WIN32
+    _ReadWriteBarrier();
+    *ptr = value;
+#else // Non-Win32
+    __atomic_store_n(ptr, value, __ATOMIC_RELEASE);
+#endif // LLBC_TARGET_PLATFORM_WIN32
+}
+
+/**
+ * Relaxed load/store operation(64 bit version), only guarantee the value not be torn, no ordering
+ * guarantee, use to read/write the single writer statistic counters.
+ * @param[in/out] ptr - value variable address.
+ * @param[in] value   - the new value.
+ * @return uint64 - the loaded value.
+ */
+inline uint64 LLBC_AtomicLoadRelaxed(volatile uint64 *ptr)
+{
+#if LLBC_TARGET_PLATFORM_WIN32
+    // Aligned 64 bit volatile access is atomic on x64.
+    return *ptr;
+#else // Non-Win32
+    return __atomic_load_n(ptr, __ATOMIC_RELAXED);
+#endif // LLBC_TARGET_PLATFORM_WIN32
+}
+
+inline void LLBC_AtomicStoreRelaxed(volatile uint64 *ptr, uint64 value)
+{
+#if LLBC_TARGET_PLATFORM_WIN32
+    *ptr = value;
+#else // Non-Win32
+    __atomic_store_n(ptr, value, __ATOMIC_RELAXED);
+#endif // LLBC_TARGET_PLATFORM_WIN32
+}
+
+/**
+ * Full memory barrier, all memory operations before barrier can not be reordered after it,
+ * and vice versa.
+ */
+inline void LLBC_AtomicMemoryBarrier()
+{
+#if LLBC_TARGET_PLATFORM_WIN32
+    ::MemoryBarrier();
+#else // Non-Win32
+    __sync_synchronize();
+#endif // LLBC_TARGET_PLATFORM_WIN32
+}
+
 __LLBC_NS_END
 
 #endif // !__LLBC_CORE_OS_OS_ATOMIC_H__
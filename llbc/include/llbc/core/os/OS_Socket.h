@@ -30,6 +30,12 @@ LLBC_EXTERN LLBC_EXPORT int LLBC_CleanupNetLibrary();
  */
 LLBC_EXTERN LLBC_EXPORT LLBC_SocketHandle LLBC_CreateTcpSocket();
 
+/**
+ * Create UDP socket.
+ * @return LLBC_SocketHandle - socket handle, if failed, return LLBC_INVALID_SOCKET_HANDLE.
+ */
+LLBC_EXTERN LLBC_EXPORT LLBC_SocketHandle LLBC_CreateUdpSocket();
+
 /**
  * Create overlapped TCP socket. WIN32 specific, If in any non-win32 platform 
  * call this API, will like LLBC_CreateTcpSocket().
@@ -68,6 +74,16 @@ LLBC_EXTERN LLBC_EXPORT int LLBC_ShutdownSocketInputOutput(LLBC_SocketHandle han
  */
 LLBC_EXTERN LLBC_EXPORT int LLBC_Send(LLBC_SocketHandle handle, const void *buf, int len, int flags);
 
+/**
+ * Gather sends data on a connected socket, send all io vectors data in one system call(writev/WSASend).
+ * @param[in] handle - socket handle.
+ * @param[in] vecs   - the io vectors array, vectors data will send in order.
+ * @param[in] count  - io vectors count, must in range [1, LLBC_IOV_MAX].
+ * @return int       - if no error occurs, return the total number bytes sent(maybe less than all vectors
+ *                     total length, the remaining data need to send again), otherwise return -1.
+ */
+LLBC_EXTERN LLBC_EXPORT int LLBC_SendV(LLBC_SocketHandle handle, LLBC_IoVec *vecs, int count);
+
 /**
  * Send data on a connected socket(WIN32 specific).
  * @param[in]  handle         - socket handle.
@@ -98,6 +114,17 @@ LLBC_EXTERN LLBC_EXPORT int LLBC_SendEx(LLBC_SocketHandle handle,
  */
 LLBC_EXTERN LLBC_EXPORT int LLBC_Recv(LLBC_SocketHandle handle, void *buf, int len, int flags);
 
+/**
+ * Receive a datagram and store the source address.
+ * @param[in]  handle - socket handle.
+ * @param[in]  buf    - buffer for incoming data.
+ * @param[in]  len    - length of buf.
+ * @param[in]  flags  - flags.
+ * @param[out] from   - the datagram source address, optional.
+ * @return int - if no error occurs, returns the number of bytes received, otherwise return -1.
+ */
+LLBC_EXTERN LLBC_EXPORT int LLBC_RecvFrom(LLBC_SocketHandle handle, void *buf, int len, int flags, LLBC_SockAddr_IN *from);
+
 /**
  * Receives data from a connected socket.
  * @param[in]     handle          - socket handle.
@@ -154,6 +181,15 @@ LLBC_EXTERN LLBC_EXPORT int LLBC_EnableAddressReusable(LLBC_SocketHandle handle)
  */
 LLBC_EXTERN LLBC_EXPORT int LLBC_DisableAddressReusable(LLBC_SocketHandle handle);
 
+/**
+ * Enable socket port reusable(SO_REUSEPORT), multiple sockets can bind to same address,
+ * in LINUX platform(3.9+ kernel), kernel will load-balance incoming connections to all listen sockets.
+ * Note: WIN32 platform not support, will return -1 and set last error to LLBC_ERROR_NOT_IMPL.
+ * @param[in] handle - socket handle.
+ * @return int - return 0 if success, otherwise return -1.
+ */
+LLBC_EXTERN LLBC_EXPORT int LLBC_EnablePortReusable(LLBC_SocketHandle handle);
+
 /**
  * Set socket send buffer size, in bytes.
  * @param[in] handle - socket.
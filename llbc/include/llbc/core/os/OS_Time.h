@@ -60,6 +60,32 @@ LLBC_EXTERN sint64 LLBC_GetMicroSeconds();
  */
 LLBC_EXTERN LLBC_EXPORT uint64 LLBC_GetTickCount();
 
+/**
+ * Get the monotonic time, not affected by system time change(NTP adjust, manually set), only use to
+ * calculate time interval.
+ * @return sint64 - the monotonic time, in milli-seconds/micro-seconds since unspecified start point.
+ */
+LLBC_EXTERN LLBC_EXPORT sint64 LLBC_GetMonoMilliSeconds();
+LLBC_EXTERN LLBC_EXPORT sint64 LLBC_GetMonoMicroSeconds();
+
+/**
+ * Get current thread cached monotonic time(coarse), service cache it at frame begin, timers and
+ * service loop use it to avoid reading clock repeatedly in one frame.
+ * @return sint64 - the cached monotonic time, in milli-seconds, if not cached, return real monotonic time.
+ */
+LLBC_EXTERN LLBC_EXPORT sint64 LLBC_GetCachedMonoMilliSeconds();
+
+/**
+ * Read monotonic time and cache it in current thread.
+ * @return sint64 - the cached monotonic time, in milli-seconds.
+ */
+LLBC_EXTERN LLBC_EXPORT sint64 LLBC_CacheMonoMilliSeconds();
+
+/**
+ * Clear current thread cached monotonic time, after that, LLBC_GetCachedMonoMilliSeconds() read real time.
+ */
+LLBC_EXTERN LLBC_EXPORT void LLBC_UncacheMonoMilliSeconds();
+
 /**
  * Get struct timeval format time.
  * @param[in] tv - time value.
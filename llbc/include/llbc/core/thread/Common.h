@@ -23,6 +23,9 @@
 #include "llbc/core/thread/MessageBlock.h"
 #include "llbc/core/thread/MessageBuffer.h"
 #include "llbc/core/thread/MessageQueue.h"
+#include "llbc/core/thread/MPSCMessageQueue.h"
+#include "llbc/core/thread/MPSCQueue.h"
+#include "llbc/core/thread/LockFreeMessageQueue.h"
 #include "llbc/core/thread/ThreadManager.h"
 #include "llbc/core/thread/Task.h"
 
@@ -0,0 +1,163 @@
+/**
+ * @file    LockFreeMessageQueue.h
+ * @author  Longwei Lai<lailongwei@126.com>
+ * @date    2026/10/18
+ * @version 1.0
+ *
+ * @brief   The lock-free MPSC/SPSC mode message queue.
+ */
+#ifndef __LLBC_CORE_THREAD_LOCK_FREE_MESSAGE_QUEUE_H__
+#define __LLBC_CORE_THREAD_LOCK_FREE_MESSAGE_QUEUE_H__
+
+#include "llbc/common/Common.h"
+
+#include "llbc/core/thread/Semaphore.h"
+#include "llbc/core/thread/MessageQueue.h"
+#include "llbc/core/thread/MPSCMessageQueue.h"
+
+__LLBC_NS_BEGIN
+class LLBC_MessageBlock;
+__LLBC_NS_END
+
+__LLBC_NS_BEGIN
+
+/**
+ * \brief The lock-free message queue class encapsulation.
+ *
+ * Support two modes(see LLBC_MessageQueueMode):
+ *  - MPSC: producers push message blocks to LLBC_MPSCMessageQueue(one CAS), the consumer
+ *          detach all pushed blocks once and pop them from consumer local list.
+ *  - SPSC: the producer append message block pointers to chunked ring, only use release store
+ *          to publish, no any atomic read-modify-write operation on the fast path.
+ * Producers never block, the consumer only block when queue empty: consumer register itself
+ * as waiter and sleep on futex(linux) or semaphore(other platforms), producers only signal
+ * when waiter registered.
+ *
+ * Only one consumer thread can call pop methods at any time.
+ */
+class LLBC_EXPORT LLBC_LockFreeMessageQueue
+{
+public:
+    /**
+     * Construct lock-free message queue.
+     * @param[in] mode - the queue mode, must be LLBC_MessageQueueMode::MPSC or LLBC_MessageQueueMode::SPSC.
+     */
+    explicit LLBC_LockFreeMessageQueue(int mode = LLBC_MessageQueueMode::MPSC);
+    ~LLBC_LockFreeMessageQueue();
+
+public:
+    /**
+     * Get the queue mode.
+     * @return int - the queue mode.
+     */
+    int GetMode() const;
+
+public:
+    /**
+     * Insert new message block at the end of the controlled sequence.
+     * In SPSC mode, only one producer thread can call this method at any time.
+     * @param[in] block - message block.
+     */
+    void PushBack(LLBC_MessageBlock *block);
+
+    /**
+     * Fetch and remove the first message block of the controlled sequence,
+     * if queue empty, block until message block pushed.
+     * @param[out] block - message block.
+     */
+    void PopFront(LLBC_MessageBlock *&block);
+
+    /**
+     * Try fetch and remove the first message block.
+     * @param[out] block - message block.
+     * @return bool - return true if success, otherwise return false.
+     */
+    bool TryPopFront(LLBC_MessageBlock *&block);
+
+    /**
+     * Timed fetch and remove the first message block.
+     * @param[out] block   - message block.
+     * @param[in] interval - interval, in milliseconds.
+     * @return bool - return true if success, otherwise return false.
+     */
+    bool TimedPopFront(LLBC_MessageBlock *&block, int interval);
+
+public:
+    /**
+     * Check queue is empty or not, only consumer thread can call this method.
+     * @return bool - empty flag.
+     */
+    bool IsEmpty() const;
+
+    /**
+     * Cleanup the message queue, delete all message blocks, only consumer thread can call this method.
+     */
+    void Cleanup();
+
+    LLBC_DISABLE_ASSIGNMENT(LLBC_LockFreeMessageQueue);
+
+private:
+    /**
+     * Wait message block push, return when waked up, timeout or queue not empty.
+     * @param[in] interval - interval, in milliseconds.
+     */
+    void Wait(int interval);
+
+    /**
+     * Notify consumer, if consumer waiting.
+     */
+    void Notify();
+
+private:
+    /**
+     * \brief The SPSC mode chunk structure encapsulation.
+     */
+    struct _Chunk
+    {
+        LLBC_MessageBlock *blocks[LLBC_CFG_THREAD_SPSC_MSG_QUEUE_CHUNK_SIZE];
+        volatile sint32 writePos;
+        _Chunk * volatile next;
+    };
+
+    /**
+     * SPSC mode queue operation methods.
+     */
+    void SPSCPush(LLBC_MessageBlock *block);
+    bool SPSCTryPop(LLBC_MessageBlock *&block);
+    bool SPSCIsEmpty() const;
+
+    /**
+     * SPSC mode chunk allocate/recycle methods.
+     */
+    _Chunk *AllocChunk();
+    void RecycleChunk(_Chunk *chunk);
+
+private:
+    int _mode;
+
+    // Producer side members, separated from consumer side members by cache line padding.
+    char _pad0[LLBC_CFG_THREAD_CACHE_LINE_SIZE];
+    LLBC_MPSCMessageQueue _mpscQueue;
+    _Chunk *_prodChunk;
+
+    // Consumer side members.
+    char _pad1[LLBC_CFG_THREAD_CACHE_LINE_SIZE];
+    LLBC_MessageBlock *_mpscPopHead;
+    _Chunk *_consChunk;
+    sint32 _consPos;
+
+    // Shared members: SPSC mode recycled chunk, consumer wait/notify members.
+    char _pad2[LLBC_CFG_THREAD_CACHE_LINE_SIZE];
+    _Chunk * volatile _spareChunk;
+    volatile sint32 _waiters;
+    volatile sint32 _signal;
+#if !LLBC_TARGET_PLATFORM_LINUX
+    LLBC_Semaphore _sem;
+#endif // !LLBC_TARGET_PLATFORM_LINUX
+};
+
+__LLBC_NS_END
+
+#include "llbc/core/thread/LockFreeMessageQueueImpl.h"
+
+#endif // !__LLBC_CORE_THREAD_LOCK_FREE_MESSAGE_QUEUE_H__
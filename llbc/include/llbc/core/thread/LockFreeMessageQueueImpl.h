@@ -0,0 +1,33 @@
+/**
+ * @file    LockFreeMessageQueueImpl.h
+ * @author  Longwei Lai<lailongwei@126.com>
+ * @date    2026/10/18
+ * @version 1.0
+ *
+ * @brief
+ */
+#ifdef __LLBC_CORE_THREAD_LOCK_FREE_MESSAGE_QUEUE_H__
+
+__LLBC_NS_BEGIN
+
+inline int LLBC_LockFreeMessageQueue::GetMode() const
+{
+    return _mode;
+}
+
+inline void LLBC_LockFreeMessageQueue::PopFront(LLBC_MessageBlock *&block)
+{
+    TimedPopFront(block, LLBC_INFINITE);
+}
+
+inline bool LLBC_LockFreeMessageQueue::IsEmpty() const
+{
+    if (_mode == LLBC_MessageQueueMode::MPSC)
+        return !_mpscPopHead && _mpscQueue.IsEmpty();
+    else
+        return SPSCIsEmpty();
+}
+
+__LLBC_NS_END
+
+#endif // __LLBC_CORE_THREAD_LOCK_FREE_MESSAGE_QUEUE_H__
@@ -0,0 +1,71 @@
+/**
+ * @file    MPSCMessageQueue.h
+ * @author  Longwei Lai<lailongwei@126.com>
+ * @date    2026/10/18
+ * @version 1.0
+ *
+ * @brief   The lock-free multi-producer/single-consumer message queue.
+ */
+#ifndef __LLBC_CORE_THREAD_MPSC_MESSAGE_QUEUE_H__
+#define __LLBC_CORE_THREAD_MPSC_MESSAGE_QUEUE_H__
+
+#include "llbc/common/Common.h"
+
+__LLBC_NS_BEGIN
+class LLBC_MessageBlock;
+__LLBC_NS_END
+
+__LLBC_NS_BEGIN
+
+/**
+ * \brief The lock-free multi-producer/single-consumer message queue class encapsulation.
+ *
+ * Producers link message blocks(use block next pointer) to an atomic list head,
+ * the consumer detach whole list once and restore push order, so:
+ *  - Push() never blocked, only one CAS operation on the fast path.
+ *  - PopAll() only one atomic exchange operation, no ABA problem.
+ *  - The messages pushed by same producer thread always keep FIFO order.
+ * This queue not support wait operation, if consumer want to be waked up,
+ * please use Push() method returned value to post a notify to consumer.
+ */
+class LLBC_EXPORT LLBC_MPSCMessageQueue
+{
+public:
+    LLBC_MPSCMessageQueue();
+    ~LLBC_MPSCMessageQueue();
+
+public:
+    /**
+     * Push message block to queue, thread safe.
+     * @param[in] block - message block.
+     * @return bool - return true if queue is empty before push, otherwise return false.
+     */
+    bool Push(LLBC_MessageBlock *block);
+
+    /**
+     * Pop all message blocks, only consumer thread can call this method.
+     * @return LLBC_MessageBlock * - the first message block(use GetNext() to iterate),
+     *                               if queue empty, return NULL.
+     */
+    LLBC_MessageBlock *PopAll();
+
+    /**
+     * Check queue is empty or not.
+     * @return bool - empty flag.
+     */
+    bool IsEmpty() const;
+
+    /**
+     * Cleanup the queue, delete all message blocks.
+     */
+    void Cleanup();
+
+    LLBC_DISABLE_ASSIGNMENT(LLBC_MPSCMessageQueue);
+
+private:
+    void * volatile _head;
+};
+
+__LLBC_NS_END
+
+#endif // !__LLBC_CORE_THREAD_MPSC_MESSAGE_QUEUE_H__
@@ -0,0 +1,62 @@
+/**
+ * @file    MPSCQueue.h
+ * @author  Longwei Lai<lailongwei@126.com>
+ * @date    2026/10/18
+ * @version 1.0
+ *
+ * @brief   The lock-free multi-producer/single-consumer intrusive queue.
+ */
+#ifndef __LLBC_CORE_THREAD_MPSC_QUEUE_H__
+#define __LLBC_CORE_THREAD_MPSC_QUEUE_H__
+
+#include "llbc/common/Common.h"
+
+#include "llbc/core/os/OS_Atomic.h"
+
+__LLBC_NS_BEGIN
+
+/**
+ * \brief The lock-free multi-producer/single-consumer intrusive queue template class encapsulation.
+ *
+ * Same as LLBC_MPSCMessageQueue, but link nodes directly, node type must has a public member:
+ *      Node *next;
+ * Queue never allocate memory and never own nodes, consumer must destroy popped nodes.
+ */
+template <typename Node>
+class LLBC_MPSCQueue
+{
+public:
+    LLBC_MPSCQueue();
+
+public:
+    /**
+     * Push node to queue, thread safe.
+     * @param[in] node - the node.
+     * @return bool - return true if queue is empty before push, otherwise return false.
+     */
+    bool Push(Node *node);
+
+    /**
+     * Pop all nodes, only consumer thread can call this method.
+     * @return Node * - the first node(use next member to iterate, keep push order),
+     *                  if queue empty, return NULL.
+     */
+    Node *PopAll();
+
+    /**
+     * Check queue is empty or not.
+     * @return bool - empty flag.
+     */
+    bool IsEmpty() const;
+
+    LLBC_DISABLE_ASSIGNMENT(LLBC_MPSCQueue);
+
+private:
+    void * volatile _head;
+};
+
+__LLBC_NS_END
+
+#include "llbc/core/thread/MPSCQueueImpl.h"
+
+#endif // !__LLBC_CORE_THREAD_MPSC_QUEUE_H__
@@ -0,0 +1,67 @@
+/**
+ * @file    MPSCQueueImpl.h
+ * @author  Longwei Lai<lailongwei@126.com>
+ * @date    2026/10/18
+ * @version 1.0
+ *
+ * @brief
+ */
+#ifdef __LLBC_CORE_THREAD_MPSC_QUEUE_H__
+
+__LLBC_NS_BEGIN
+
+template <typename Node>
+inline LLBC_MPSCQueue<Node>::LLBC_MPSCQueue()
+: _head(NULL)
+{
+}
+
+template <typename Node>
+inline bool LLBC_MPSCQueue<Node>::Push(Node *node)
+{
+    void *oldHead = _head;
+    while (true)
+    {
+        node->next = reinterpret_cast<Node *>(oldHead);
+
+        void *curHead = LLBC_AtomicCompareAndExchangePtr(&_head, node, oldHead);
+        if (curHead == oldHead)
+            break;
+
+        oldHead = curHead;
+    }
+
+    return oldHead == NULL;
+}
+
+template <typename Node>
+inline Node *LLBC_MPSCQueue<Node>::PopAll()
+{
+    if (!_head)
+        return NULL;
+
+    // Detach the list, the list is LIFO ordered, reverse it.
+    Node *node = reinterpret_cast<Node *>(LLBC_AtomicSetPtr(&_head, NULL));
+
+    Node *first = NULL;
+    while (node)
+    {
+        Node *next = node->next;
+        node->next = first;
+
+        first = node;
+        node = next;
+    }
+
+    return first;
+}
+
+template <typename Node>
+inline bool LLBC_MPSCQueue<Node>::IsEmpty() const
+{
+    return _head == NULL;
+}
+
+__LLBC_NS_END
+
+#endif // __LLBC_CORE_THREAD_MPSC_QUEUE_H__
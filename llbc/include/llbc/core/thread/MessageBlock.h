@@ -36,9 +36,9 @@ public:
     LLBC_MessageBlock(void *buf, size_t size);
 
     /**
-     * Destructor.
+     * Destructor, derived block can release its external buffer owner in destructor.
      */
-    ~LLBC_MessageBlock();
+    virtual ~LLBC_MessageBlock();
 
 public:
     /**
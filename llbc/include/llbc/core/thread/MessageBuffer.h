@@ -61,6 +61,12 @@ public:
      */
     LLBC_MessageBlock *MergeBuffersAndDetach();
 
+    /**
+     * Detach all buffers, not merge, caller take over the returned block list(linked by GetNext()).
+     * @return LLBC_MessageBlock * - the first block of detached block list.
+     */
+    LLBC_MessageBlock *DetachBuffers();
+
     /**
      * Append new block to buffer.
      * @param[in] block - message block.
@@ -82,6 +88,7 @@ public:
 
 private:
     LLBC_MessageBlock *_head;
+    LLBC_MessageBlock *_tail;
 };
 
 __LLBC_NS_END
@@ -25,6 +25,34 @@ __LLBC_NS_END
 
 __LLBC_NS_BEGIN
 
+/**
+ * \brief The message queue mode enumeration.
+ */
+class LLBC_EXPORT LLBC_MessageQueueMode
+{
+public:
+    enum
+    {
+        Begin,
+
+        // Mutex/condition variable protected queue, any producers and any consumers.
+        Locked = Begin,
+        // Lock-free queue, multi producers and single consumer.
+        MPSC,
+        // Lock-free queue, single producer and single consumer.
+        SPSC,
+
+        End
+    };
+
+    /**
+     * Check given message queue mode is validate or not.
+     * @param[in] mode - the message queue mode.
+     * @return bool - return true if validate, otherwise return false.
+     */
+    static bool IsValid(int mode);
+};
+
 /**
  * \brief The thread message queue class encapsulation.
  */
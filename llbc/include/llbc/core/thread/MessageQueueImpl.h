@@ -11,6 +11,11 @@
 
 __LLBC_NS_BEGIN
 
+inline bool LLBC_MessageQueueMode::IsValid(int mode)
+{
+    return mode >= Begin && mode < End;
+}
+
 inline void LLBC_MessageQueue::PushFront(LLBC_MessageBlock *block)
 {
     Push(block, true);
@@ -13,6 +13,7 @@
 
 #include "llbc/core/os/OS_Thread.h"
 #include "llbc/core/thread/MessageQueue.h"
+#include "llbc/core/thread/LockFreeMessageQueue.h"
 
 __LLBC_NS_BEGIN
 
@@ -100,6 +101,23 @@ public:
      */
     virtual void Cleanup() = 0; 
 
+public:
+    /**
+     * Get the task message queue mode.
+     * @return int - the message queue mode, see LLBC_MessageQueueMode.
+     */
+    int GetMsgQueueMode() const;
+
+    /**
+     * Set the task message queue mode, only can set before task activated.
+     * Default mode is LLBC_MessageQueueMode::Locked, lock-free modes only support single task thread:
+     *  - LLBC_MessageQueueMode::MPSC: any threads can push message blocks to task.
+     *  - LLBC_MessageQueueMode::SPSC: only one producer thread can push message blocks to task.
+     * @param[in] mode - the message queue mode.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    int SetMsgQueueMode(int mode);
+
 public:
     /**
      * Push message block to task.
@@ -154,7 +172,9 @@ private:
 
     LLBC_SpinLock _lock;
 
+    int _msgQueueMode;
     LLBC_MessageQueue _msgQueue;
+    LLBC_LockFreeMessageQueue *_lfMsgQueue;
 };
 
 __LLBC_NS_END
@@ -14,16 +14,29 @@
 __LLBC_NS_BEGIN
 
 class LLBC_Timer;
+class LLBC_TimerDataPool;
 
 __LLBC_NS_END
 
 __LLBC_NS_BEGIN
 
+/**
+ * \brief The timer intrusive list link, use to link timer data into timing wheel bucket.
+ */
+struct LLBC_HIDDEN LLBC_TimerLink
+{
+    LLBC_TimerLink *prev;
+    LLBC_TimerLink *next;
+};
+
 /**
  * \brief The timer data structure encapsulation.
  */
 struct LLBC_HIDDEN LLBC_TimerData
 {
+    // Timing wheel bucket link, must be the first member(timing wheel cast link to timer data).
+    LLBC_TimerLink link;
+
     // Timer handle, use to build timer heap.
     uint64 handle;
 
@@ -50,6 +63,9 @@ struct LLBC_HIDDEN LLBC_TimerData
 
     // ref count.
     uint8 refCount;
+
+    // The pool which timer data allocated from.
+    LLBC_TimerDataPool *pool;
 };
 
 __LLBC_NS_END
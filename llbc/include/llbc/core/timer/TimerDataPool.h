@@ -0,0 +1,83 @@
+/**
+ * @file    TimerDataPool.h
+ * @author  Longwei Lai<lailongwei@126.com>
+ * @date    2026/10/18
+ * @version 1.0
+ *
+ * @brief   The timer data pool.
+ */
+#ifndef __LLBC_CORE_TIMER_TIMER_DATA_POOL_H__
+#define __LLBC_CORE_TIMER_TIMER_DATA_POOL_H__
+
+#include "llbc/common/Common.h"
+
+__LLBC_NS_BEGIN
+
+struct LLBC_TimerData;
+
+__LLBC_NS_END
+
+__LLBC_NS_BEGIN
+
+/**
+ * \brief The timer data pool class encapsulation.
+ *
+ * Every timer scheduler own one pool, the released timer data will be cached in pool(not exceed
+ * LLBC_CFG_CORE_TIMER_MAX_POOLED_TIMER_DATA), avoid heap allocation on timer churn.
+ * Timer data maybe released by timer after scheduler destroyed, so pool is reference counted:
+ * the owner scheduler and every acquired timer data hold one reference, after owner destroyed,
+ * the released timer data will be deleted directly.
+ */
+class LLBC_HIDDEN LLBC_TimerDataPool
+{
+public:
+    /**
+     * Create timer data pool, the owner hold the reference.
+     * @return LLBC_TimerDataPool * - the new pool.
+     */
+    static LLBC_TimerDataPool *Create();
+
+    /**
+     * Destroy pool by owner, delete all cached timer data and release owner reference.
+     */
+    void Destroy();
+
+public:
+    /**
+     * Acquire a zero filled timer data.
+     * @return LLBC_TimerData * - the timer data.
+     */
+    LLBC_TimerData *Acquire();
+
+    /**
+     * Release one timer data reference, if reference count reach zero, recycle timer data.
+     * @param[in] data - the timer data.
+     */
+    static void Release(LLBC_TimerData *data);
+
+    /**
+     * Get the cached timer data count.
+     * @return size_t - the cached count.
+     */
+    size_t GetCachedCount() const;
+
+private:
+    LLBC_TimerDataPool();
+    ~LLBC_TimerDataPool();
+
+    void Recycle(LLBC_TimerData *data);
+    void ReleaseRef();
+
+    LLBC_DISABLE_ASSIGNMENT(LLBC_TimerDataPool);
+
+private:
+    bool _destroyed;
+    size_t _refCount;
+
+    LLBC_TimerData *_cached;
+    size_t _cachedCount;
+};
+
+__LLBC_NS_END
+
+#endif // !__LLBC_CORE_TIMER_TIMER_DATA_POOL_H__
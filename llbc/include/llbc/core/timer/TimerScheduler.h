@@ -17,6 +17,8 @@ __LLBC_NS_BEGIN
 
 class LLBC_Timer;
 struct LLBC_TimerData;
+class LLBC_TimerDataPool;
+class LLBC_TimingWheel;
 
 __LLBC_NS_END
 
@@ -24,6 +26,16 @@ __LLBC_NS_BEGIN
 
 /**
  * \brief The timer scheduler class encapsulation.
+ *
+ * Scheduler support two timer storage types:
+ *  - BinaryHeap:  Schedule is O(log n), cancelled timers are lazily removed when reach heap top
+ *                 (except long timeout timers).
+ *  - TimingWheel: Hierarchical timing wheel, Schedule/Cancel are O(1), cancelled timers removed
+ *                 immediately, suitable for massive timers.
+ * Both types keep same LLBC_Timer semantics(include LLBC_CFG_CORE_TIMER_STRICT_SCHEDULE), and the
+ * timer data allocated from scheduler's timer data pool.
+ * Timers use thread cached monotonic time(see LLBC_GetCachedMonoMilliSeconds()), system time change
+ * not affect timers.
  */
 class LLBC_EXPORT LLBC_TimerScheduler
 {
@@ -32,7 +44,21 @@ class LLBC_EXPORT LLBC_TimerScheduler
     typedef LLBC_BinaryHeap<LLBC_TimerData *> _Heap;
 
 public:
-    LLBC_TimerScheduler();
+    /**
+     * The timer scheduler type enumeration.
+     */
+    enum Type
+    {
+        BinaryHeap = 0,
+        TimingWheel = 1
+    };
+
+public:
+    /**
+     * Constructor.
+     * @param[in] type - the scheduler type, default is LLBC_CFG_CORE_TIMER_DFT_SCHEDULER_TYPE.
+     */
+    explicit LLBC_TimerScheduler(Type type = static_cast<Type>(LLBC_CFG_CORE_TIMER_DFT_SCHEDULER_TYPE));
     virtual ~LLBC_TimerScheduler();
 
 public:
@@ -65,6 +91,12 @@ public:
     static _This *GetCurrentThreadScheduler();
 
 public:
+    /**
+     * Get timer scheduler type.
+     * @return Type - the scheduler type.
+     */
+    Type GetType() const;
+
     /**
      * Timer manager update drive function.
      */
@@ -88,6 +120,13 @@ public:
      */
     size_t GetTimerCount() const;
 
+    /**
+     * Get the nearest timer timeout time, use to determine wait time.
+     * @return sint64 - the nearest timeout time(monotonic time, in milli-seconds, see LLBC_GetMonoMilliSeconds()),
+     *                  if no timer or scheduler disabled, return -1.
+     */
+    sint64 GetNextTimeoutTime() const;
+
 public:
     /**
      * Cancel all timers.
@@ -122,15 +161,34 @@ private:
      */
     virtual int Cancel(LLBC_Timer *timer);
 
+private:
+    /**
+     * Timer storage operation methods, dispatch to binary heap or timing wheel.
+     */
+    void Insert(LLBC_TimerData *data);
+    bool PopExpired(uint64 now, LLBC_TimerData *&data);
+    void GetAll(std::vector<LLBC_TimerData *> &datas) const;
+
+    /**
+     * Trigger expired timer.
+     * @param[in] data - the timer data.
+     * @param[in] now  - the now time, in milli-seconds.
+     * @return bool - return true if timer need reschedule, otherwise return false.
+     */
+    bool Timeout(LLBC_TimerData *data, uint64 now);
+
 private:
     LLBC_DISABLE_ASSIGNMENT(LLBC_TimerScheduler);
 
 private:
+    const Type _type;
     LLBC_TimerId _maxTimerId;
     bool _enabled;
     bool _destroyed;
 
     _Heap _heap;
+    LLBC_TimingWheel *_wheel;
+    LLBC_TimerDataPool *_pool;
 };
 
 __LLBC_NS_END
@@ -0,0 +1,117 @@
+/**
+ * @file    TimingWheel.h
+ * @author  Longwei Lai<lailongwei@126.com>
+ * @date    2026/10/18
+ * @version 1.0
+ *
+ * @brief   The hierarchical timing wheel.
+ */
+#ifndef __LLBC_CORE_TIMER_TIMING_WHEEL_H__
+#define __LLBC_CORE_TIMER_TIMING_WHEEL_H__
+
+#include "llbc/common/Common.h"
+
+#include "llbc/core/timer/TimerData.h"
+
+__LLBC_NS_BEGIN
+
+/**
+ * \brief The hierarchical timing wheel class encapsulation.
+ *
+ * Wheel tick is 1 milli-second, level 0 has 256 buckets(one tick per bucket), level 1 ~ 4 has 64
+ * buckets per level, every level bucket covers the whole lower level, so the near timers(< 256ms)
+ * keep milli-second resolution, and the long timers store in coarse buckets, cascade to lower
+ * level when wheel time reach, the timers exceed 2^32 ms store in the farthest bucket and re-insert
+ * when reached.
+ * Every bucket is circular intrusive list, insert and remove timer data are O(1).
+ */
+class LLBC_HIDDEN LLBC_TimingWheel
+{
+public:
+    LLBC_TimingWheel();
+    ~LLBC_TimingWheel();
+
+public:
+    /**
+     * Insert timer data, expire time is timer data handle.
+     * @param[in] data - the timer data.
+     */
+    void Insert(LLBC_TimerData *data);
+
+    /**
+     * Remove timer data from wheel.
+     * @param[in] data - the timer data.
+     */
+    void Remove(LLBC_TimerData *data);
+
+    /**
+     * Advance wheel time to now, pop one expired timer data.
+     * @param[in] now - the now time, in milli-seconds.
+     * @return LLBC_TimerData * - the expired timer data, if no more expired timer, return NULL.
+     */
+    LLBC_TimerData *PopExpired(uint64 now);
+
+public:
+    /**
+     * Get timer data count in wheel.
+     * @return size_t - the timer data count.
+     */
+    size_t GetSize() const;
+
+    /**
+     * Get the nearest expire time, the level 0 timers return exact time, the higher level timers
+     * return the next cascade time(not later than actually expire time).
+     * @return sint64 - the nearest expire time(in milli-seconds), if wheel empty, return -1.
+     */
+    sint64 GetNextExpireTime() const;
+
+    /**
+     * Get all timer data in wheel.
+     * @param[out] datas - the timer data.
+     */
+    void GetAll(std::vector<LLBC_TimerData *> &datas) const;
+
+    LLBC_DISABLE_ASSIGNMENT(LLBC_TimingWheel);
+
+private:
+    /**
+     * Add timer data to bucket according to expire time.
+     */
+    void AddToBucket(LLBC_TimerData *data);
+
+    /**
+     * Cascade the higher level bucket timers to lower levels.
+     * @return uint32 - the cascaded bucket index.
+     */
+    uint32 Cascade(int level);
+
+    static void InitList(LLBC_TimerLink &head);
+    static bool IsListEmpty(const LLBC_TimerLink &head);
+    static void LinkTail(LLBC_TimerLink &head, LLBC_TimerLink *link);
+    static void Unlink(LLBC_TimerLink *link);
+    static void SpliceList(LLBC_TimerLink &from, LLBC_TimerLink &to);
+
+private:
+    enum
+    {
+        Level0Bits = 8,
+        LevelNBits = 6,
+        Level0Size = 1 << Level0Bits,
+        LevelNSize = 1 << LevelNBits,
+        Level0Mask = Level0Size - 1,
+        LevelNMask = LevelNSize - 1,
+        LevelsCount = 5
+    };
+
+    uint64 _time;
+    size_t _size;
+
+    LLBC_TimerLink _level0[Level0Size];
+    LLBC_TimerLink _levelN[LevelsCount - 1][LevelNSize];
+
+    LLBC_TimerLink _expiring;
+};
+
+__LLBC_NS_END
+
+#endif // !__LLBC_CORE_TIMER_TIMING_WHEEL_H__
@@ -16,6 +16,7 @@
 #include "llbc/core/utils/Util_DelegateImpl.h"
 #include "llbc/core/utils/Util_DelegateEx.h"
 #include "llbc/core/utils/Util_MD5.h"
+#include "llbc/core/utils/Util_LZ4.h"
 #include "llbc/core/utils/Util_Misc.h"
 #include "llbc/core/utils/Util_Network.h"
 
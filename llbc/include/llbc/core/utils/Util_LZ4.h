@@ -0,0 +1,57 @@
+/**
+ * @file    Util_LZ4.h
+ * @author  Longwei Lai<lailongwei@126.com>
+ * @date    2026/10/18
+ * @version 1.0
+ *
+ * @brief   The LZ4 block format fast compress algorithm.
+ */
+#ifndef __LLBC_CORE_UTILS_UTIL_LZ4_H__
+#define __LLBC_CORE_UTILS_UTIL_LZ4_H__
+
+#include "llbc/common/Common.h"
+
+__LLBC_NS_BEGIN
+
+/**
+ * \brief The LZ4 block format compress algorithm class encapsulation.
+ *
+ * Self-contained implementation, output is compatible with standard LZ4 block format,
+ * compressed data not contain original length, caller must save it by self.
+ */
+class LLBC_EXPORT LLBC_LZ4
+{
+public:
+    /**
+     * Get the max compressed length of given source length(worst case, data incompressible).
+     * @param[in] srcLen - the source data length.
+     * @return size_t - the max compressed length.
+     */
+    static size_t GetCompressBound(size_t srcLen);
+
+    /**
+     * Compress data.
+     * @param[in] src            - the source data.
+     * @param[in] srcLen         - the source data length.
+     * @param[out] dst           - the compressed data buffer.
+     * @param[in] dstCap         - the compressed data buffer capacity, if compressed data can't fit in it,
+     *                             compress will failed, use GetCompressBound() to get safe capacity.
+     * @param[out] compressedLen - the compressed data length.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    static int Compress(const void *src, size_t srcLen, void *dst, size_t dstCap, size_t &compressedLen);
+
+    /**
+     * Decompress data.
+     * @param[in] src    - the compressed data.
+     * @param[in] srcLen - the compressed data length.
+     * @param[out] dst   - the decompressed data buffer.
+     * @param[in] dstLen - the original data length, decompressed length must equal to it.
+     * @return int - return 0 if success, otherwise return -1(data corrupted).
+     */
+    static int Decompress(const void *src, size_t srcLen, void *dst, size_t dstLen);
+};
+
+__LLBC_NS_END
+
+#endif // !__LLBC_CORE_UTILS_UTIL_LZ4_H__
@@ -13,12 +13,16 @@
 #include "llbc/comm/Packet.h"
 #include "llbc/comm/Socket.h"
 #include "llbc/comm/Session.h"
+#include "llbc/comm/SharedBuffer.h"
 #include "llbc/comm/ServiceEvent.h"
 #include "llbc/comm/PollerType.h"
+#include "llbc/comm/BackpressurePolicy.h"
+#include "llbc/comm/ReliableUdp.h"
 #include "llbc/comm/BasePoller.h"
 #include "llbc/comm/SelectPoller.h"
 #include "llbc/comm/IocpPoller.h"
 #include "llbc/comm/EpollPoller.h"
+#include "llbc/comm/IoUringPoller.h"
 #include "llbc/comm/PollerMgr.h"
 #include "llbc/comm/IService.h"
 
@@ -27,6 +31,19 @@ namespace
     typedef LLBC_NS LLBC_BasePoller This;
 }
 
+__LLBC_INTERNAL_NS_BEGIN
+
+// The reliable udp peer key: local port(16) | peer ip(32) | peer port(16).
+inline LLBC_NS uint64 __GetRudpPeerKey(LLBC_NS uint16 localPort, const LLBC_NS LLBC_SockAddr_IN &peer)
+{
+    const struct sockaddr_in peerAddr = peer.ToOSDataType();
+    return (static_cast<LLBC_NS uint64>(localPort) << 48) |
+           (static_cast<LLBC_NS uint64>(ntohl(peerAddr.sin_addr.s_addr)) << 16) |
+           peer.GetPort();
+}
+
+__LLBC_INTERNAL_NS_END
+
 __LLBC_NS_BEGIN
 
 This::_Handler This::_handlers[LLBC_PollerEvent::End] =
@@ -36,7 +53,10 @@ This::_Handler This::_handlers[LLBC_PollerEvent::End] =
     &This::HandleEv_Send,
     &This::HandleEv_Close,
     &This::HandleEv_Monitor,
-    &This::HandleEv_TakeOverSession
+    &This::HandleEv_TakeOverSession,
+    &This::HandleEv_FlushSend,
+    &This::HandleEv_Multicast,
+    &This::HandleEv_SendBatch
 };
 
 LLBC_BasePoller::LLBC_BasePoller()
@@ -48,15 +68,45 @@ LLBC_BasePoller::LLBC_BasePoller()
 , _svc(NULL)
 , _pollerMgr(NULL)
 
-, _sockets()
 , _sessions()
 
 , _connecting()
+
+, _evQueue()
+, _sendQueue()
+, _recvSlabPool(LLBC_New(LLBC_RecvSlabPool))
+
+, _flushingSendQueue(false)
+, _pendingFlushSessionIds()
+
+, _recvBudget(LLBC_CFG_COMM_DFT_RECV_BUDGET)
+, _pendingRecvSessionIds()
+, _handlingRecvSessionIds()
+
+, _sendLowWaterMark(LLBC_CFG_COMM_DFT_SEND_LOW_WATER_MARK)
+, _sendHighWaterMark(LLBC_CFG_COMM_DFT_SEND_HIGH_WATER_MARK)
+, _backpressurePolicy(LLBC_BackpressurePolicy::None)
+, _opcodeBackpressurePolicies()
+
+, _rudpOpts()
+, _rudpSessionIds()
+, _updatingRudpSessionIds()
+, _rudpPeers()
+
+, _sendCalls(0)
+, _sentBlocks(0)
+, _sentBytes(0)
+
+, _recvEvents(0)
+, _recvCalls(0)
+, _recvBytes(0)
+, _recvBudgetExhausts(0)
 {
 }
 
 LLBC_BasePoller::~LLBC_BasePoller()
 {
+    _recvSlabPool->Destroy();
 }
 
 This *LLBC_BasePoller::Create(int type)
@@ -80,6 +130,12 @@ This *LLBC_BasePoller::Create(int type)
         break;
 #endif
 
+#if LLBC_TARGET_PLATFORM_LINUX
+    case LLBC_PollerType::IoUringPoller:
+        poller = LLBC_New(LLBC_IoUringPoller);
+        break;
+#endif
+
     default:
         break;
     }
@@ -98,6 +154,7 @@ void LLBC_BasePoller::SetPollerId(int id)
 void LLBC_BasePoller::SetBrothersCount(int count)
 {
     _brotherCount = count;
+    _sessions.SetIdStride(count);
 }
 
 void LLBC_BasePoller::SetService(LLBC_IService *svc)
@@ -110,6 +167,33 @@ void LLBC_BasePoller::SetPollerMgr(LLBC_PollerMgr *mgr)
     _pollerMgr = mgr;
 }
 
+void LLBC_BasePoller::SetRecvBudget(size_t budget)
+{
+    _recvBudget = budget;
+}
+
+size_t LLBC_BasePoller::GetRecvBudget() const
+{
+    return _recvBudget;
+}
+
+void LLBC_BasePoller::SetSendWaterMarks(size_t lowWaterMark, size_t highWaterMark)
+{
+    _sendLowWaterMark = lowWaterMark;
+    _sendHighWaterMark = highWaterMark;
+}
+
+void LLBC_BasePoller::SetBackpressurePolicies(int policy, const std::map<int, int> &opcodePolicies)
+{
+    _backpressurePolicy = policy;
+    _opcodeBackpressurePolicies = opcodePolicies;
+}
+
+void LLBC_BasePoller::SetReliableUdpOptions(const LLBC_ReliableUdpOptions &opts)
+{
+    _rudpOpts = opts;
+}
+
 int LLBC_BasePoller::Start()
 {
     ASSERT(false && "Please implement LLBC_BasePoller::Start() method!");
@@ -123,6 +207,8 @@ void LLBC_BasePoller::Stop()
         return;
 
     _stopping = true;
+    Wakeup();
+
     while (_started)
         LLBC_ThreadManager::Sleep(20);
 
@@ -135,25 +221,31 @@ void LLBC_BasePoller::Cleanup()
     _pollerMgr->OnPollerStop(_id);
 
     // Cleanup all queued events.
-    LLBC_PollerEvent ev;
-    LLBC_MessageBlock *block;
-    while (TryPop(block) == LLBC_OK)
+    LLBC_PollerEvent *ev = _evQueue.PopAll();
+    while (ev)
     {
-        block->Read(&ev, sizeof(LLBC_PollerEvent));
+        LLBC_PollerEvent *next = ev->next;
         LLBC_PollerEvUtil::DestroyEv(ev);
 
-        delete block;
+        ev = next;
+    }
+
+    // Cleanup all queued send events.
+    ev = _sendQueue.PopAll();
+    while (ev)
+    {
+        LLBC_PollerEvent *next = ev->next;
+        LLBC_PollerEvUtil::DestroyEv(ev);
+
+        ev = next;
     }
 
     // Delete all sessions.
 #if LLBC_TARGET_PLATFORM_WIN32
-    for (_Sessions::iterator it = _sessions.begin();
-         it != _sessions.end();
-         it++)
-        it->second->GetSocket()->DeleteAllOverlappeds();
+    for (size_t i = 0; i < _sessions.GetSize(); i++)
+        _sessions.GetAt(i)->GetSocket()->DeleteAllOverlappeds();
 #endif // LLBC_TARGET_PLATFORM_WIN32
-    LLBC_STLHelper::DeleteContainer(_sessions);
-    _sockets.clear();
+    _sessions.DeleteAll();
 
     // Delete all connecting sockets.
     for (_Connecting::iterator it = _connecting.begin();
@@ -165,17 +257,72 @@ void LLBC_BasePoller::Cleanup()
     _started = false;
 }
 
-void LLBC_BasePoller::HandleQueuedEvents(int waitTime)
+void LLBC_BasePoller::Push(LLBC_PollerEvent *ev)
 {
-    LLBC_MessageBlock *block;
-    while (TimedPop(block, waitTime) == LLBC_OK)
-    {
-        LLBC_PollerEvent &ev = 
-            *reinterpret_cast< LLBC_PollerEvent *>(block->GetData());
+    if (_evQueue.Push(ev))
+        Wakeup();
+}
+
+void LLBC_BasePoller::PushSend(LLBC_PollerEvent *ev)
+{
+    if (_sendQueue.Push(ev))
+        Push(LLBC_PollerEvUtil::BuildFlushSendEv());
+}
+
+LLBC_RecvSlabPool *LLBC_BasePoller::GetRecvSlabPool()
+{
+    return _recvSlabPool;
+}
+
+void LLBC_BasePoller::GetSendStat(LLBC_SendStat &stat) const
+{
+    This *ncThis = const_cast<This *>(this);
+    stat.sendCalls += static_cast<uint64>(LLBC_AtomicGet(&ncThis->_sendCalls));
+    stat.sentBlocks += static_cast<uint64>(LLBC_AtomicGet(&ncThis->_sentBlocks));
+    stat.sentBytes += static_cast<uint64>(LLBC_AtomicGet(&ncThis->_sentBytes));
+}
+
+void LLBC_BasePoller::AddSendStat(const LLBC_SendStat &stat)
+{
+    // Single writer(poller thread), use atomic set to publish new values, avoid locked add.
+    LLBC_AtomicSet(&_sendCalls, _sendCalls + static_cast<sint64>(stat.sendCalls));
+    LLBC_AtomicSet(&_sentBlocks, _sentBlocks + static_cast<sint64>(stat.sentBlocks));
+    LLBC_AtomicSet(&_sentBytes, _sentBytes + static_cast<sint64>(stat.sentBytes));
+}
+
+void LLBC_BasePoller::GetRecvStat(LLBC_RecvStat &stat) const
+{
+    This *ncThis = const_cast<This *>(this);
+    stat.recvEvents += static_cast<uint64>(LLBC_AtomicGet(&ncThis->_recvEvents));
+    stat.recvCalls += static_cast<uint64>(LLBC_AtomicGet(&ncThis->_recvCalls));
+    stat.recvBytes += static_cast<uint64>(LLBC_AtomicGet(&ncThis->_recvBytes));
+    stat.budgetExhausts += static_cast<uint64>(LLBC_AtomicGet(&ncThis->_recvBudgetExhausts));
+}
 
-        (this->*_handlers[ev.type])(ev);
+void LLBC_BasePoller::AddRecvStat(const LLBC_RecvStat &stat)
+{
+    // Same as send statistic, single writer.
+    LLBC_AtomicSet(&_recvEvents, _recvEvents + static_cast<sint64>(stat.recvEvents));
+    LLBC_AtomicSet(&_recvCalls, _recvCalls + static_cast<sint64>(stat.recvCalls));
+    LLBC_AtomicSet(&_recvBytes, _recvBytes + static_cast<sint64>(stat.recvBytes));
+    if (stat.budgetExhausts != 0)
+        LLBC_AtomicSet(&_recvBudgetExhausts, _recvBudgetExhausts + static_cast<sint64>(stat.budgetExhausts));
+}
 
-        LLBC_Delete(block);
+void LLBC_BasePoller::HandleQueuedEvents()
+{
+    // The events pushed in event handlers will be handled in next PopAll() call.
+    LLBC_PollerEvent *ev;
+    while ((ev = _evQueue.PopAll()))
+    {
+        while (ev)
+        {
+            LLBC_PollerEvent *next = ev->next;
+            (this->*_handlers[ev->type])(*ev);
+
+            LLBC_Delete(ev);
+            ev = next;
+        }
     }
 }
 
@@ -191,32 +338,22 @@ void LLBC_BasePoller::HandleEv_AsyncConn(LLBC_PollerEvent &ev)
 
 void LLBC_BasePoller::HandleEv_Send(LLBC_PollerEvent &ev)
 {
-    _Sessions::iterator it = 
-        _sessions.find(ev.un.packet->GetSessionId());
-    if (it == _sessions.end())
-    {
-        LLBC_Delete(ev.un.packet);
-        return;
-    }
-
-    LLBC_Session *session = it->second;
-    if (UNLIKELY(session->IsListen()))
-        LLBC_Delete(ev.un.packet);
-    else if (UNLIKELY(session->Send(ev.un.packet) != LLBC_OK))
-        session->OnClose();
+    SendPacket(ev.un.packet);
 }
 
 void LLBC_BasePoller::HandleEv_Close(LLBC_PollerEvent &ev)
 {
-    _Sessions::iterator it = _sessions.find(ev.sessionId);
-    if (it == _sessions.end())
+    // Flush queued send events first, to makesure the packets sent before close request can be sent.
+    FlushSendQueue();
+
+    LLBC_Session *session = _sessions.Find(ev.sessionId);
+    if (!session)
         return;
 
     LLBC_SessionCloseInfo *closeInfo = 
         new LLBC_SessionCloseInfo(ev.un.closeReason);
     LLBC_XFree(ev.un.closeReason);
 
-    LLBC_Session *session = it->second;
 #if LLBC_TARGET_PLATFORM_NON_WIN32
     session->OnClose(closeInfo);
 #else
@@ -234,6 +371,263 @@ void LLBC_BasePoller::HandleEv_TakeOverSession(LLBC_PollerEvent &ev)
     AddSession(ev.un.session);
 }
 
+void LLBC_BasePoller::HandleEv_FlushSend(LLBC_PollerEvent &ev)
+{
+    FlushSendQueue();
+}
+
+void LLBC_BasePoller::HandleEv_Multicast(LLBC_PollerEvent &ev)
+{
+    size_t off = 0;
+    LLBC_SharedBuffer *buffer;
+    ::memcpy(&buffer, ev.un.multicastEv, sizeof(LLBC_SharedBuffer *)), off += sizeof(LLBC_SharedBuffer *);
+    int opcode;
+    ::memcpy(&opcode, ev.un.multicastEv + off, sizeof(int)), off += sizeof(int);
+    int count;
+    ::memcpy(&count, ev.un.multicastEv + off, sizeof(int)), off += sizeof(int);
+    const int *sessionIds = reinterpret_cast<const int *>(ev.un.multicastEv + off);
+
+    // All target sessions reference the shared buffer, don't copy data.
+    for (int i = 0; i < count; i++)
+    {
+        LLBC_Session *session = _sessions.Find(sessionIds[i]);
+        if (UNLIKELY(!session || session->IsListen()))
+            continue;
+
+        if (UNLIKELY(session->Send(LLBC_New1(LLBC_SharedBlock, buffer), opcode) != LLBC_OK))
+            session->OnClose();
+    }
+
+    buffer->Release();
+    LLBC_Free(ev.un.multicastEv);
+}
+
+void LLBC_BasePoller::HandleEv_SendBatch(LLBC_PollerEvent &ev)
+{
+    int count;
+    ::memcpy(&count, ev.un.sendBatchEv, sizeof(int));
+    LLBC_Packet **packets = reinterpret_cast<LLBC_Packet **>(ev.un.sendBatchEv + sizeof(int));
+
+    for (int i = 0; i < count; i++)
+        SendPacket(packets[i]);
+
+    LLBC_Free(ev.un.sendBatchEv);
+}
+
+void LLBC_BasePoller::SendPacket(LLBC_Packet *packet)
+{
+    LLBC_Session *session = 
+        _sessions.Find(packet->GetSessionId());
+    if (UNLIKELY(!session))
+    {
+        LLBC_Delete(packet);
+        return;
+    }
+
+    if (UNLIKELY(session->IsListen()))
+        LLBC_Delete(packet);
+    else if (UNLIKELY(session->Send(packet) != LLBC_OK))
+        session->OnClose();
+}
+
+void LLBC_BasePoller::FlushSendQueue()
+{
+    LLBC_PollerEvent *ev = _sendQueue.PopAll();
+    if (ev)
+    {
+        _flushingSendQueue = true;
+        while (ev)
+        {
+            LLBC_PollerEvent *next = ev->next;
+
+            // Send queue only contain Send/Multicast/SendBatch events.
+            (this->*_handlers[ev->type])(*ev);
+
+            LLBC_Delete(ev);
+            ev = next;
+        }
+        _flushingSendQueue = false;
+    }
+
+    // Flush the sessions which deferred OnSend() in this flush(or deferred by session itself, eg: coalesced
+    // blocks requeued when leave backpressure state), session maybe closed, so find it again.
+    for (size_t i = 0; i < _pendingFlushSessionIds.size(); i++)
+    {
+        LLBC_Session *session = _sessions.Find(_pendingFlushSessionIds[i]);
+        if (session)
+            session->OnSend();
+    }
+    _pendingFlushSessionIds.clear();
+}
+
+bool LLBC_BasePoller::HasPendingRecvs() const
+{
+    return !_pendingRecvSessionIds.empty();
+}
+
+void LLBC_BasePoller::HandlePendingRecvs()
+{
+    if (_pendingRecvSessionIds.empty())
+        return;
+
+    // Swap to handling list, the sessions re-armed in this call will be handled in next call.
+    _handlingRecvSessionIds.swap(_pendingRecvSessionIds);
+    for (size_t i = 0; i < _handlingRecvSessionIds.size(); i++)
+    {
+        // Session maybe closed, so find it again.
+        LLBC_Session *session = _sessions.Find(_handlingRecvSessionIds[i]);
+        if (session)
+            session->OnPendingRecv();
+    }
+    _handlingRecvSessionIds.clear();
+}
+
+int LLBC_BasePoller::GetWaitTime(int maxWaitTime) const
+{
+    if (HasPendingRecvs())
+        return 0;
+    else if (!_rudpSessionIds.empty())
+        return MIN(maxWaitTime, static_cast<int>(_rudpOpts.interval));
+
+    return maxWaitTime;
+}
+
+void LLBC_BasePoller::AcceptReliableUdp(LLBC_Session *listenSession)
+{
+    LLBC_Socket *listenSock = listenSession->GetSocket();
+    const LLBC_SockAddr_IN &local = listenSock->GetLocalAddress();
+
+    int len;
+    LLBC_SockAddr_IN peer;
+    char buf[65536];
+    while ((len = LLBC_RecvFrom(listenSock->Handle(), buf, static_cast<int>(sizeof(buf)), 0, &peer)) >= 0)
+    {
+        // The datagram arrived before peer session socket connected, forward to peer session.
+        const uint64 peerKey = LLBC_INL_NS __GetRudpPeerKey(local.GetPort(), peer);
+        std::map<uint64, int>::iterator peerIt = _rudpPeers.find(peerKey);
+        if (peerIt != _rudpPeers.end())
+        {
+            LLBC_Session *session = _sessions.Find(peerIt->second);
+            if (session)
+            {
+                session->GetSocket()->OnReliableUdpRecved(buf, len);
+                continue;
+            }
+
+            _rudpPeers.erase(peerIt);
+        }
+
+        // Only open datagram can create session, ignore the datagrams of removed sessions.
+        uint32 conv;
+        if (!LLBC_ReliableUdp::IsOpenDatagram(buf, len, conv))
+            continue;
+
+        const LLBC_SocketHandle handle = LLBC_CreateUdpSocket();
+        if (UNLIKELY(handle == LLBC_INVALID_SOCKET_HANDLE))
+            continue;
+
+        LLBC_Socket *newSock = LLBC_New1(LLBC_Socket, handle);
+        newSock->SetPollerType(listenSock->GetPollerType());
+        if (newSock->SetNonBlocking() != LLBC_OK ||
+            newSock->EnableAddressReusable() != LLBC_OK ||
+            newSock->EnablePortReusable() != LLBC_OK ||
+            newSock->BindTo(local) != LLBC_OK ||
+            newSock->Connect(peer) != LLBC_OK)
+        {
+            trace("LLBC_BasePoller::AcceptReliableUdp() create peer socket failed, reason: %s\n", LLBC_FormatLastError());
+            LLBC_Delete(newSock);
+            continue;
+        }
+
+        newSock->EnableReliableUdp(conv, _rudpOpts, false);
+        SetConnectedSocketDftOpts(newSock);
+
+        // The peer session must stay in this poller, the datagrams received by listen socket forward to it directly.
+        LLBC_Session *session = CreateSession(newSock, _pollerMgr->AllocSessionId(_id));
+        AddSession(session);
+
+        _rudpPeers.insert(std::make_pair(peerKey, session->GetId()));
+        newSock->OnReliableUdpRecved(buf, len);
+    }
+}
+
+void LLBC_BasePoller::UpdateReliableUdpSessions()
+{
+    if (_rudpSessionIds.empty())
+        return;
+
+    // Session maybe closed in updating, so iterate the copy, and find session again.
+    _updatingRudpSessionIds = _rudpSessionIds;
+    for (size_t i = 0; i < _updatingRudpSessionIds.size(); i++)
+    {
+        LLBC_Session *session = _sessions.Find(_updatingRudpSessionIds[i]);
+        if (session)
+            session->GetSocket()->OnReliableUdpUpdate();
+    }
+    _updatingRudpSessionIds.clear();
+}
+
+bool LLBC_BasePoller::IsFlushingSendQueue() const
+{
+    return _flushingSendQueue;
+}
+
+void LLBC_BasePoller::AddPendingFlushSession(int sessionId)
+{
+    _pendingFlushSessionIds.push_back(sessionId);
+}
+
+void LLBC_BasePoller::AddPendingRecvSession(int sessionId)
+{
+    _pendingRecvSessionIds.push_back(sessionId);
+}
+
+size_t LLBC_BasePoller::GetSendLowWaterMark() const
+{
+    return _sendLowWaterMark;
+}
+
+size_t LLBC_BasePoller::GetSendHighWaterMark() const
+{
+    return _sendHighWaterMark;
+}
+
+int LLBC_BasePoller::GetBackpressurePolicy() const
+{
+    return _backpressurePolicy;
+}
+
+int LLBC_BasePoller::GetBackpressurePolicy(int opcode) const
+{
+    if (_opcodeBackpressurePolicies.empty())
+        return _backpressurePolicy;
+
+    std::map<int, int>::const_iterator it = _opcodeBackpressurePolicies.find(opcode);
+    return it != _opcodeBackpressurePolicies.end() ? it->second : _backpressurePolicy;
+}
+
+void LLBC_BasePoller::UpdateSendQueueSize(int sessionId, size_t queueSize)
+{
+    _pollerMgr->_sessionStats.SetValue(sessionId,
+                                       static_cast<sint64>(queueSize),
+                                       LLBC_PollerMgr::_SessionStatIdx::SendQueueSize);
+}
+
+void LLBC_BasePoller::UpdateSessionRecvStat(int sessionId, const LLBC_RecvStat &stat)
+{
+    typedef LLBC_PollerMgr::_SessionStatIdx _StatIdx;
+
+    LLBC_SessionIdTable &sessionStats = _pollerMgr->_sessionStats;
+    sessionStats.SetValue(sessionId, static_cast<sint64>(stat.recvEvents), _StatIdx::RecvEvents);
+    sessionStats.SetValue(sessionId, static_cast<sint64>(stat.recvCalls), _StatIdx::RecvCalls);
+    sessionStats.SetValue(sessionId, static_cast<sint64>(stat.recvBytes), _StatIdx::RecvBytes);
+    sessionStats.SetValue(sessionId, static_cast<sint64>(stat.budgetExhausts), _StatIdx::RecvBudgetExhausts);
+}
+
+void LLBC_BasePoller::Wakeup()
+{
+}
+
 LLBC_Session *LLBC_BasePoller::CreateSession(LLBC_Socket *socket, int sessionId)
 {
     if (sessionId == 0)
@@ -251,6 +645,14 @@ LLBC_Session *LLBC_BasePoller::CreateSession(LLBC_Socket *socket, int sessionId)
     return session;
 }
 
+LLBC_Session *LLBC_BasePoller::CreateAcceptedSession(LLBC_Socket *listenSock, LLBC_Socket *newSock)
+{
+    if (listenSock->IsPortReusable())
+        return CreateSession(newSock, _pollerMgr->AllocSessionId(_id));
+
+    return CreateSession(newSock);
+}
+
 void LLBC_BasePoller::AddToPoller(LLBC_Session *session)
 {
     const int hash = session->GetId() % _brotherCount;
@@ -261,7 +663,7 @@ void LLBC_BasePoller::AddToPoller(LLBC_Session *session)
     }
     else
     {
-        LLBC_MessageBlock *ev = 
+        LLBC_PollerEvent *ev = 
             LLBC_PollerEvUtil::BuildTakeOverSessionEv(session);
         if (_pollerMgr->PushMsgToPoller(hash, ev) != LLBC_OK)
         {
@@ -278,27 +680,44 @@ void LLBC_BasePoller::AddSession(LLBC_Session *session)
 void LLBC_BasePoller::AddSession(LLBC_Session *session, bool needAddToIocp)
 #endif // LLBC_TARGET_PLATFORM_NON_WIN32
 {
-    // Insert to socket & session map.
+    // Insert to session table.
     session->SetPoller(this);
-    _sessions.insert(std::make_pair(session->GetId(), session));
-    _sockets.insert(std::make_pair(session->GetSocketHandle(), session));
+    _sessions.Insert(session);
+    _pollerMgr->_sessionStats.Insert(session->GetId());
 
-    // Build event and push to service.
     LLBC_Socket *sock = session->GetSocket();
-    LLBC_MessageBlock *block = 
+    if (sock->IsReliableUdp() && !sock->IsListen())
+        _rudpSessionIds.push_back(session->GetId());
+
+    // Build event and push to service.
+    LLBC_ServiceEvent *ev = 
         LLBC_SvcEvUtil::BuildSessionCreateEv(sock->GetLocalAddress(),
                                              sock->GetPeerAddress(),
                                              sock->IsListen(),
                                              session->GetId(),
                                              sock->Handle());
 
-    _svc->Push(block);
+    _svc->Push(ev);
 }
 
 void LLBC_BasePoller::RemoveSession(LLBC_Session *session)
 {
-    _sessions.erase(session->GetId());
-    _sockets.erase(session->GetSocketHandle());
+    LLBC_Socket *sock = session->GetSocket();
+    if (sock->IsReliableUdp() && !sock->IsListen())
+    {
+        std::vector<int>::iterator it =
+            std::find(_rudpSessionIds.begin(), _rudpSessionIds.end(), session->GetId());
+        if (it != _rudpSessionIds.end())
+            _rudpSessionIds.erase(it);
+
+        std::map<uint64, int>::iterator peerIt = _rudpPeers.find(
+            LLBC_INL_NS __GetRudpPeerKey(sock->GetLocalPort(), sock->GetPeerAddress()));
+        if (peerIt != _rudpPeers.end() && peerIt->second == session->GetId())
+            _rudpPeers.erase(peerIt);
+    }
+
+    _sessions.Remove(session);
+    _pollerMgr->_sessionStats.Remove(session->GetId());
 
     LLBC_Delete(session);
 }
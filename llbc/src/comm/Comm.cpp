@@ -12,6 +12,7 @@
 
 #include "llbc/comm/Comm.h"
 
+#include "llbc/comm/EventPool.h"
 #include "llbc/comm/PacketHeaderDescAccessor.h"
 
 __LLBC_NS_BEGIN
@@ -24,6 +25,7 @@ int __LLBC_CommStartup()
 void __LLBC_CommCleanup()
 {
     LLBC_PacketHeaderDescAccessor::CleanupHeaderDesc();
+    LLBC_EventPool::Purge();
 }
 
 __LLBC_NS_END
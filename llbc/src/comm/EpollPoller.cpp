@@ -15,7 +15,6 @@
 #include "llbc/comm/ServiceEvent.h"
 #include "llbc/comm/PollerType.h"
 #include "llbc/comm/EpollPoller.h"
-#include "llbc/comm/PollerMonitor.h"
 #include "llbc/comm/IService.h"
 
 #if LLBC_TARGET_PLATFORM_LINUX || LLBC_TARGET_PLATFORM_ANDROID
@@ -29,13 +28,19 @@ __LLBC_NS_BEGIN
 
 LLBC_EpollPoller::LLBC_EpollPoller()
 : _epoll(LLBC_INVALID_HANDLE)
-, _monitor(NULL)
+
+, _wakeupFd(-1)
+, _wakeupPending(0)
+, _wakeupWriters(0)
 {
 }
 
 LLBC_EpollPoller::~LLBC_EpollPoller()
 {
     Stop();
+
+    // Close wakeup eventfd after poller thread stopped, the pushers maybe still wake up poller.
+    CloseWakeupFd();
 }
 
 int LLBC_EpollPoller::Start()
@@ -46,11 +51,14 @@ int LLBC_EpollPoller::Start()
         return LLBC_FAILED;
     }
 
+    // Close the eventfd of previous run.
+    CloseWakeupFd();
+
     if ((_epoll = LLBC_EpollCreate(
             LLBC_CFG_EPOLL_MAX_LISTEN_FD_SIZE)) == LLBC_INVALID_HANDLE)
         return LLBC_FAILED;
 
-    if (StartupMonitor() != LLBC_OK)
+    if (CreateWakeupFd() != LLBC_OK)
     {
         LLBC_EpollClose(_epoll);
         _epoll = LLBC_INVALID_HANDLE;
@@ -60,7 +68,9 @@ int LLBC_EpollPoller::Start()
 
     if (Activate(1) != LLBC_OK)
     {
-        StopMonitor();
+        ::close(_wakeupFd);
+        _wakeupFd = -1;
+
         LLBC_EpollClose(_epoll);
         _epoll = LLBC_INVALID_HANDLE;
 
@@ -78,13 +88,27 @@ void LLBC_EpollPoller::Svc()
 
     while (!_stopping)
     {
-        HandleQueuedEvents(20);
+        // If has recv budget exhausted sessions, not wait, the re-armed sessions are serviced
+        // after other sessions which readable in previous loop.
+        // If has reliable udp sessions, wait at most reliable udp update interval.
+        const int ret = LLBC_EpollWait(_epoll,
+                                       _events,
+                                       LLBC_CFG_COMM_MAX_EVENT_COUNT,
+                                       GetWaitTime(LLBC_CFG_EPOLL_MAX_WAIT_TIME));
+        HandlePendingRecvs();
+        if (ret > 0)
+            HandleEpollEvents(ret);
+
+        HandleQueuedEvents();
+        UpdateReliableUdpSessions();
     }
 }
 
 void LLBC_EpollPoller::Cleanup()
 {
-    StopMonitor();
+    // Keep wakeup pending flag set, the pushers will not write eventfd any more, eventfd will be
+    // closed in destructor(the pusher which already passed pending check maybe still writing).
+    LLBC_AtomicSet(&_wakeupPending, 1);
 
     LLBC_EpollClose(_epoll);
     _epoll = LLBC_INVALID_HANDLE;
@@ -144,23 +168,111 @@ void LLBC_EpollPoller::HandleEv_Close(LLBC_PollerEvent &ev)
     Base::HandleEv_Close(ev);
 }
 
-void LLBC_EpollPoller::HandleEv_Monitor(LLBC_PollerEvent &ev)
+void LLBC_EpollPoller::HandleEv_TakeOverSession(LLBC_PollerEvent &ev)
+{
+    Base::HandleEv_TakeOverSession(ev);
+}
+
+void LLBC_EpollPoller::AddSession(LLBC_Session *session)
 {
-    const int count = *reinterpret_cast<int *>(ev.un.monitorEv);
-    LLBC_EpollEvent *evs = 
-        reinterpret_cast<LLBC_EpollEvent *>(ev.un.monitorEv + sizeof(int));
+    Base::AddSession(session);
+
+    LLBC_Socket *sock = session->GetSocket();
+    const LLBC_SocketHandle handle = sock->Handle();
+
+    LLBC_EpollEvent epev;
+    epev.data.fd = handle;
+    epev.events = EPOLLIN | EPOLLET | EPOLLHUP | EPOLLERR;
+    if (!sock->IsListen())
+        epev.events |= EPOLLOUT;
+
+    LLBC_EpollCtl(_epoll, EPOLL_CTL_ADD, handle, &epev);
+}
+
+void LLBC_EpollPoller::RemoveSession(LLBC_Session *session)
+{
+    // For compatible before 2.6.9 version kernel, we pass event point to LLBC_EpollCtl() API,
+    // even through this argument is ignored.
+    LLBC_EpollEvent epev;
+    epev.events = EPOLLIN | EPOLLOUT | EPOLLET | EPOLLHUP | EPOLLERR;
+    LLBC_EpollCtl(_epoll, EPOLL_CTL_DEL, session->GetSocketHandle(), &epev);
+
+    Base::RemoveSession(session);
+}
+
+void LLBC_EpollPoller::Wakeup()
+{
+    // Only the first pusher after poller waked up need write eventfd, the writers count make sure
+    // eventfd not closed while writing.
+    LLBC_AtomicFetchAndAdd(&_wakeupWriters, 1);
+    if (LLBC_AtomicCompareAndExchange(&_wakeupPending, 1, 0) == 0)
+    {
+        const uint64 val = 1;
+        while (::write(_wakeupFd, &val, sizeof(val)) < 0 && errno == EINTR);
+    }
+
+    LLBC_AtomicFetchAndSub(&_wakeupWriters, 1);
+}
+
+void LLBC_EpollPoller::CloseWakeupFd()
+{
+    if (_wakeupFd == -1)
+        return;
+
+    LLBC_AtomicSet(&_wakeupPending, 1);
+    while (LLBC_AtomicGet(&_wakeupWriters) > 0)
+        LLBC_ThreadManager::Sleep(0);
+
+    ::close(_wakeupFd);
+    _wakeupFd = -1;
+}
+
+int LLBC_EpollPoller::CreateWakeupFd()
+{
+    if ((_wakeupFd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC)) == -1)
+    {
+        LLBC_SetLastError(LLBC_ERROR_CLIB);
+        return LLBC_FAILED;
+    }
+
+    LLBC_EpollEvent epev;
+    epev.data.fd = _wakeupFd;
+    epev.events = EPOLLIN | EPOLLET;
+    if (LLBC_EpollCtl(_epoll, EPOLL_CTL_ADD, _wakeupFd, &epev) != LLBC_OK)
+    {
+        ::close(_wakeupFd);
+        _wakeupFd = -1;
+
+        return LLBC_FAILED;
+    }
+
+    LLBC_AtomicSet(&_wakeupPending, 0);
+
+    return LLBC_OK;
+}
 
+void LLBC_EpollPoller::HandleEpollEvents(int count)
+{
     for (int i = 0; i < count; i++)
     {
-        const LLBC_EpollEvent &ev = evs[i];
+        const LLBC_EpollEvent &ev = _events[i];
+        if (ev.data.fd == _wakeupFd)
+        {
+            // Reset pending flag before drain queued events, the events pushed after reset will wake up poller again.
+            uint64 val;
+            while (::read(_wakeupFd, &val, sizeof(val)) < 0 && errno == EINTR);
+            LLBC_AtomicSet(&_wakeupPending, 0);
+
+            continue;
+        }
+
         if (HandleConnecting(ev.data.fd, ev.events))
             continue;
 
-        _Sockets::iterator it = _sockets.find(ev.data.fd);
-        if (UNLIKELY(it == _sockets.end()))
+        LLBC_Session *session = _sessions.FindBySocket(ev.data.fd);
+        if (UNLIKELY(!session))
             continue;
 
-        LLBC_Session *session = it->second;
         if (ev.events & (EPOLLHUP|EPOLLERR))
         {
             LLBC_Socket *sock = session->GetSocket();
@@ -192,80 +304,13 @@ void LLBC_EpollPoller::HandleEv_Monitor(LLBC_PollerEvent &ev)
             {
                 // Maybe in session removed while calling OnRecv() method.
                 if ((ev.events & EPOLLIN) && 
-                        UNLIKELY(_sockets.find(
-                            ev.data.fd) == _sockets.end()))
+                        UNLIKELY(_sessions.FindBySocket(ev.data.fd) != session))
                     continue;
 
                 session->OnSend();
             }
-       }
-    }
-
-    LLBC_Free(ev.un.monitorEv);
-}
-
-void LLBC_EpollPoller::HandleEv_TakeOverSession(LLBC_PollerEvent &ev)
-{
-    Base::HandleEv_TakeOverSession(ev);
-}
-
-void LLBC_EpollPoller::AddSession(LLBC_Session *session)
-{
-    Base::AddSession(session);
-
-    LLBC_Socket *sock = session->GetSocket();
-    const LLBC_SocketHandle handle = sock->Handle();
-
-    LLBC_EpollEvent epev;
-    epev.data.fd = handle;
-    epev.events = EPOLLIN | EPOLLET | EPOLLHUP | EPOLLERR;
-    if (!sock->IsListen())
-        epev.events |= EPOLLOUT;
-
-    LLBC_EpollCtl(_epoll, EPOLL_CTL_ADD, handle, &epev);
-}
-
-void LLBC_EpollPoller::RemoveSession(LLBC_Session *session)
-{
-    // For compatible before 2.6.9 version kernel, we pass event point to LLBC_EpollCtl() API,
-    // even through this argument is ignored.
-    LLBC_EpollEvent epev;
-    epev.events = EPOLLIN | EPOLLOUT | EPOLLET | EPOLLHUP | EPOLLERR;
-    LLBC_EpollCtl(_epoll, EPOLL_CTL_DEL, session->GetSocketHandle(), &epev);
-
-    Base::RemoveSession(session);
-}
-
-int LLBC_EpollPoller::StartupMonitor()
-{
-    LLBC_IDelegate0 *deleg = new LLBC_Delegate0<
-        LLBC_EpollPoller>(this, &LLBC_EpollPoller::MonitorSvc);
-
-    _monitor = new LLBC_PollerMonitor(deleg);
-    if (_monitor->Start() != LLBC_OK)
-    {
-        LLBC_XDelete(_monitor);
-        return LLBC_FAILED;
+        }
     }
-
-    return LLBC_OK;
-}
-
-void LLBC_EpollPoller::StopMonitor()
-{
-    LLBC_XDelete(_monitor);
-}
-
-void LLBC_EpollPoller::MonitorSvc()
-{
-    int ret = LLBC_EpollWait(_epoll,
-                             _events,
-                             LLBC_CFG_COMM_MAX_EVENT_COUNT,
-                             50);
-    if (ret <= 0)
-        return;
-
-    Push(LLBC_PollerEvUtil::BuildEpollMonitorEv(_events, ret));
 }
 
 bool LLBC_EpollPoller::HandleConnecting(LLBC_SocketHandle handle, int events)
@@ -313,6 +358,12 @@ void LLBC_EpollPoller::Accept(LLBC_Session *session)
 {
     LLBC_Socket *newSock;
     LLBC_Socket *sock = session->GetSocket();
+    if (sock->IsReliableUdp())
+    {
+        AcceptReliableUdp(session);
+        return;
+    }
+
     for (; ;)
     {
         if (!(newSock = sock->Accept()))
@@ -321,7 +372,7 @@ void LLBC_EpollPoller::Accept(LLBC_Session *session)
         newSock->SetNonBlocking();
 
         SetConnectedSocketDftOpts(newSock);
-        AddToPoller(CreateSession(newSock));
+        AddToPoller(CreateAcceptedSession(sock, newSock));
     }
 }
 
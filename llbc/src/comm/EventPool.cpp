@@ -0,0 +1,131 @@
+/**
+ * @file    EventPool.cpp
+ * @author  Longwei Lai<lailongwei@126.com>
+ * @date    2026/10/18
+ * @version 1.0
+ *
+ * @brief
+ */
+
+#include "llbc/common/Export.h"
+#include "llbc/common/BeforeIncl.h"
+
+#include "llbc/comm/EventPool.h"
+
+namespace
+{
+    // The size class granularity.
+    const size_t __granularity = 16;
+    // The size classes count.
+    const size_t __sizeClassCount =
+        (LLBC_CFG_COMM_EVENT_POOL_MAX_NODE_SIZE + __granularity - 1) / __granularity;
+
+    // The free node, link to next free node by node self memory.
+    struct _FreeNode
+    {
+        _FreeNode *next;
+    };
+
+    // The size class, hold all free nodes of same size class.
+    struct _SizeClass
+    {
+        LLBC_NS LLBC_SpinLock lock;
+        _FreeNode *head;
+        size_t count;
+
+        _SizeClass()
+        : head(NULL)
+        , count(0)
+        {
+        }
+    };
+
+    _SizeClass __sizeClasses[__sizeClassCount];
+
+    inline size_t __GetSizeClassIdx(size_t size)
+    {
+        return (size - 1) / __granularity;
+    }
+}
+
+__LLBC_NS_BEGIN
+
+void *LLBC_EventPool::Alloc(size_t size)
+{
+    if (UNLIKELY(size == 0 || size > LLBC_CFG_COMM_EVENT_POOL_MAX_NODE_SIZE))
+        return LLBC_Malloc(void, size);
+
+    const size_t idx = __GetSizeClassIdx(size);
+    _SizeClass &sizeClass = __sizeClasses[idx];
+
+    sizeClass.lock.Lock();
+    _FreeNode *node = sizeClass.head;
+    if (LIKELY(node))
+    {
+        sizeClass.head = node->next;
+        sizeClass.count -= 1;
+    }
+    sizeClass.lock.Unlock();
+
+    // Pool empty, allocate size class size node, node will recycle to same size class.
+    if (UNLIKELY(!node))
+        return LLBC_Malloc(void, (idx + 1) * __granularity);
+
+    return node;
+}
+
+void LLBC_EventPool::Free(void *node, size_t size)
+{
+    if (UNLIKELY(!node))
+        return;
+    else if (UNLIKELY(size == 0 || size > LLBC_CFG_COMM_EVENT_POOL_MAX_NODE_SIZE))
+    {
+        LLBC_Free(node);
+        return;
+    }
+
+    _SizeClass &sizeClass = __sizeClasses[__GetSizeClassIdx(size)];
+
+    sizeClass.lock.Lock();
+    if (LIKELY(sizeClass.count < LLBC_CFG_COMM_EVENT_POOL_MAX_CACHED_NODES))
+    {
+        _FreeNode *freeNode = reinterpret_cast<_FreeNode *>(node);
+        freeNode->next = sizeClass.head;
+
+        sizeClass.head = freeNode;
+        sizeClass.count += 1;
+
+        node = NULL;
+    }
+    sizeClass.lock.Unlock();
+
+    // Exceed max cached nodes count, free it.
+    if (node)
+        LLBC_Free(node);
+}
+
+void LLBC_EventPool::Purge()
+{
+    for (size_t i = 0; i < __sizeClassCount; i++)
+    {
+        _SizeClass &sizeClass = __sizeClasses[i];
+
+        sizeClass.lock.Lock();
+        _FreeNode *node = sizeClass.head;
+        sizeClass.head = NULL;
+        sizeClass.count = 0;
+        sizeClass.lock.Unlock();
+
+        while (node)
+        {
+            _FreeNode *next = node->next;
+            LLBC_Free(node);
+
+            node = next;
+        }
+    }
+}
+
+__LLBC_NS_END
+
+#include "llbc/common/AfterIncl.h"
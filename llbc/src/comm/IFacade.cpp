@@ -93,9 +93,11 @@ LLBC_String LLBC_SessionInfo::ToString() const
 }
 
 LLBC_SessionDestroyInfo::LLBC_SessionDestroyInfo(LLBC_SessionInfo *sessionInfo,
-                                                 LLBC_SessionCloseInfo *closeInfo)
+                                                 LLBC_SessionCloseInfo *closeInfo,
+                                                 const LLBC_RecvStat &recvStat)
 : _sessionInfo(sessionInfo)
 , _closeInfo(closeInfo)
+, _recvStat(recvStat)
 {
 }
 
@@ -155,6 +157,11 @@ const LLBC_String &LLBC_SessionDestroyInfo::GetReason() const
     return _closeInfo->GetReason();
 }
 
+const LLBC_RecvStat &LLBC_SessionDestroyInfo::GetRecvStat() const
+{
+    return _recvStat;
+}
+
 LLBC_String LLBC_SessionDestroyInfo::ToString() const
 {
     LLBC_String repr;
@@ -217,6 +224,81 @@ LLBC_String LLBC_AsyncConnResult::ToString() const
     return repr;
 }
 
+LLBC_SessionBackpressureInfo::LLBC_SessionBackpressureInfo()
+: _sessionId(0)
+, _backpressured(false)
+, _queueSize(0)
+, _droppedPackets(0)
+, _coalescedPackets(0)
+{
+}
+
+LLBC_SessionBackpressureInfo::~LLBC_SessionBackpressureInfo()
+{
+}
+
+int LLBC_SessionBackpressureInfo::GetSessionId() const
+{
+    return _sessionId;
+}
+
+void LLBC_SessionBackpressureInfo::SetSessionId(int sessionId)
+{
+    _sessionId = sessionId;
+}
+
+bool LLBC_SessionBackpressureInfo::IsBackpressured() const
+{
+    return _backpressured;
+}
+
+void LLBC_SessionBackpressureInfo::SetIsBackpressured(bool backpressured)
+{
+    _backpressured = backpressured;
+}
+
+size_t LLBC_SessionBackpressureInfo::GetQueueSize() const
+{
+    return _queueSize;
+}
+
+void LLBC_SessionBackpressureInfo::SetQueueSize(size_t queueSize)
+{
+    _queueSize = queueSize;
+}
+
+size_t LLBC_SessionBackpressureInfo::GetDroppedPackets() const
+{
+    return _droppedPackets;
+}
+
+void LLBC_SessionBackpressureInfo::SetDroppedPackets(size_t droppedPackets)
+{
+    _droppedPackets = droppedPackets;
+}
+
+size_t LLBC_SessionBackpressureInfo::GetCoalescedPackets() const
+{
+    return _coalescedPackets;
+}
+
+void LLBC_SessionBackpressureInfo::SetCoalescedPackets(size_t coalescedPackets)
+{
+    _coalescedPackets = coalescedPackets;
+}
+
+LLBC_String LLBC_SessionBackpressureInfo::ToString() const
+{
+    LLBC_String repr;
+    repr.append_format("sessionId:%d, ", _sessionId)
+        .append_format("backpressured:%s, ", _backpressured?"true":"false")
+        .append_format("queueSize:%lu, ", static_cast<unsigned long>(_queueSize))
+        .append_format("droppedPackets:%lu, ", static_cast<unsigned long>(_droppedPackets))
+        .append_format("coalescedPackets:%lu", static_cast<unsigned long>(_coalescedPackets));
+
+    return repr;
+}
+
 LLBC_ProtoReport::LLBC_ProtoReport()
 : _sessionId(0)
 , _opcode(0)
@@ -345,6 +427,10 @@ void LLBC_IFacade::OnAsyncConnResult(const LLBC_AsyncConnResult &result)
 {
 }
 
+void LLBC_IFacade::OnSessionBackpressure(const LLBC_SessionBackpressureInfo &info)
+{
+}
+
 void LLBC_IFacade::OnProtoReport(const LLBC_ProtoReport &report)
 {
 }
@@ -375,6 +461,11 @@ std::ostream &operator <<(std::ostream &o, const LLBC_NS LLBC_AsyncConnResult &r
     return o <<result.ToString();
 }
 
+std::ostream &operator <<(std::ostream &o, const LLBC_NS LLBC_SessionBackpressureInfo &info)
+{
+    return o <<info.ToString();
+}
+
 std::ostream &operator <<(std::ostream &o, const LLBC_NS LLBC_ProtoReport &report)
 {
     return o <<report.ToString();
@@ -0,0 +1,841 @@
+/**
+ * @file    IoUringPoller.cpp
+ * @author  Longwei Lai<lailongwei@126.com>
+ * @date    2026/10/18
+ * @version 1.0
+ *
+ * @brief
+ */
+
+#include "llbc/common/Export.h"
+#include "llbc/common/BeforeIncl.h"
+
+#include "llbc/comm/Socket.h"
+#include "llbc/comm/Session.h"
+#include "llbc/comm/ServiceEvent.h"
+#include "llbc/comm/PollerType.h"
+#include "llbc/comm/IoUringPoller.h"
+#include "llbc/comm/IService.h"
+
+#if LLBC_TARGET_PLATFORM_LINUX
+
+namespace
+{
+    typedef LLBC_NS LLBC_BasePoller Base;
+}
+
+__LLBC_INTERNAL_NS_BEGIN
+
+// The provided buffer ring group id.
+const LLBC_NS uint16 __bufGroupId = 0;
+
+static int __IoUringSetup(LLBC_NS uint32 entries, struct io_uring_params *params)
+{
+    return static_cast<int>(::syscall(__NR_io_uring_setup, entries, params));
+}
+
+static int __IoUringEnter(int fd, LLBC_NS uint32 toSubmit, LLBC_NS uint32 minComplete, LLBC_NS uint32 flags, const void *arg, size_t argSize)
+{
+    return static_cast<int>(::syscall(__NR_io_uring_enter, fd, toSubmit, minComplete, flags, arg, argSize));
+}
+
+static int __IoUringRegister(int fd, LLBC_NS uint32 opcode, const void *arg, LLBC_NS uint32 argCount)
+{
+    return static_cast<int>(::syscall(__NR_io_uring_register, fd, opcode, arg, argCount));
+}
+
+static int __RegisterBufRing(int fd, void *ring, LLBC_NS uint32 entries)
+{
+    struct io_uring_buf_reg reg;
+    ::memset(&reg, 0, sizeof(reg));
+    reg.ring_addr = reinterpret_cast<LLBC_NS uint64>(ring);
+    reg.ring_entries = entries;
+    reg.bgid = __bufGroupId;
+
+    return __IoUringRegister(fd, IORING_REGISTER_PBUF_RING, &reg, 1);
+}
+
+static void __DeleteBlocks(LLBC_NS LLBC_MessageBlock *block)
+{
+    while (block)
+    {
+        LLBC_NS LLBC_MessageBlock *next = block->GetNext();
+        LLBC_Delete(block);
+
+        block = next;
+    }
+}
+
+__LLBC_INTERNAL_NS_END
+
+__LLBC_NS_BEGIN
+
+LLBC_IoUringPoller::LLBC_IoUringPoller()
+: _ringFd(-1)
+
+, _sqRing(NULL)
+, _sqRingSize(0)
+, _sqHead(NULL)
+, _sqTail(NULL)
+, _sqMask(0)
+, _sqEntries(0)
+, _sqPrepared(0)
+, _sqes(NULL)
+, _sqesSize(0)
+
+, _cqRing(NULL)
+, _cqRingSize(0)
+, _cqHead(NULL)
+, _cqTail(NULL)
+, _cqMask(0)
+, _cqes(NULL)
+
+, _bufRing(NULL)
+, _bufRingSize(0)
+, _bufSlabPool(NULL)
+, _bufSlabs()
+, _bufRingTail(0)
+, _bufRingPublished(0)
+, _noBufSessionIds()
+
+, _wakeupFd(-1)
+, _wakeupPending(0)
+, _wakeupWriters(0)
+
+, _inflightSendReqs(0)
+, _freeSendReqs()
+{
+}
+
+LLBC_IoUringPoller::~LLBC_IoUringPoller()
+{
+    Stop();
+
+    // Close wakeup eventfd after poller thread stopped, the pushers maybe still wake up poller.
+    CloseWakeupFd();
+}
+
+bool LLBC_IoUringPoller::IsSupported()
+{
+    // Probe once, the kernel features not change in process lifetime.
+    static volatile sint32 supported = -1;
+    if (supported != -1)
+        return supported == 1;
+
+    // IORING_SETUP_SINGLE_ISSUER added in 6.0 kernel, same as multishot recv and cancel by fd,
+    // use it to probe kernel version, io_uring maybe disabled by sysctl/seccomp too.
+    struct io_uring_params params;
+    ::memset(&params, 0, sizeof(params));
+    params.flags = IORING_SETUP_SINGLE_ISSUER;
+
+    bool ok = false;
+    const int fd = LLBC_INL_NS __IoUringSetup(2, &params);
+    if (fd >= 0)
+    {
+        const uint32 requiredFeatures =
+            IORING_FEAT_SINGLE_MMAP | IORING_FEAT_FAST_POLL | IORING_FEAT_EXT_ARG;
+        if ((params.features & requiredFeatures) == requiredFeatures)
+        {
+            const size_t ringSize = sizeof(struct io_uring_buf);
+            void *ring = ::mmap(NULL, ringSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (ring != MAP_FAILED)
+            {
+                ok = LLBC_INL_NS __RegisterBufRing(fd, ring, 1) == 0;
+                ::munmap(ring, ringSize);
+            }
+        }
+
+        ::close(fd);
+    }
+
+    supported = ok ? 1 : 0;
+
+    return ok;
+}
+
+int LLBC_IoUringPoller::Start()
+{
+    if (_started)
+    {
+        LLBC_SetLastError(LLBC_ERROR_REENTRY);
+        return LLBC_FAILED;
+    }
+
+    // Close the eventfd of previous run.
+    CloseWakeupFd();
+
+    if (SetupRing() != LLBC_OK)
+        return LLBC_FAILED;
+
+    if ((_wakeupFd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC)) == -1)
+    {
+        LLBC_SetLastError(LLBC_ERROR_CLIB);
+        DestroyRing();
+
+        return LLBC_FAILED;
+    }
+
+    LLBC_AtomicSet(&_wakeupPending, 0);
+    PrepareWakeup();
+
+    if (Activate(1) != LLBC_OK)
+    {
+        ::close(_wakeupFd);
+        _wakeupFd = -1;
+
+        DestroyRing();
+
+        return LLBC_FAILED;
+    }
+
+    _started = true;
+    return LLBC_OK;
+}
+
+void LLBC_IoUringPoller::Svc()
+{
+    while (!_started)
+        LLBC_Sleep(20);
+
+    while (!_stopping)
+    {
+        // Submit all requests prepared in previous loop and wait completions by one system call.
+        Submit(LLBC_CFG_IOURING_MAX_WAIT_TIME);
+
+        HandleCompletions();
+        HandleQueuedEvents();
+    }
+}
+
+void LLBC_IoUringPoller::Cleanup()
+{
+    // Keep wakeup pending flag set, the pushers will not write eventfd any more, eventfd will be
+    // closed in destructor(the pusher which already passed pending check maybe still writing).
+    LLBC_AtomicSet(&_wakeupPending, 1);
+
+    // The in-flight send requests take over sessions send blocks, then cancel all requests and
+    // wait send requests completed, kernel maybe still access the send blocks before completion.
+    for (size_t i = 0; i < _sessions.GetSize(); i++)
+    {
+        LLBC_Socket *sock = _sessions.GetAt(i)->GetSocket();
+        if (sock->_uringSendReq)
+        {
+            sock->_uringSendReq->sessionId = 0;
+            sock->_uringSendReq->orphanBlocks = sock->DetachUringSendBlocks();
+            sock->_uringSendReq = NULL;
+        }
+    }
+
+    if (_inflightSendReqs > 0)
+    {
+        struct io_uring_sqe *sqe = GetSqe(_Op_Cancel, 0);
+        sqe->opcode = IORING_OP_ASYNC_CANCEL;
+        sqe->fd = -1;
+        sqe->cancel_flags = IORING_ASYNC_CANCEL_ANY;
+
+        const sint64 begTime = LLBC_GetMilliSeconds();
+        while (_inflightSendReqs > 0 && LLBC_GetMilliSeconds() - begTime < 1000)
+        {
+            Submit(100);
+
+            uint32 head = *_cqHead;
+            const uint32 tail = LLBC_AtomicLoadAcquire(reinterpret_cast<volatile sint32 *>(_cqTail));
+            for (; head != tail; head++)
+            {
+                const struct io_uring_cqe &cqe = _cqes[head & _cqMask];
+                if ((cqe.user_data & _Op_Mask) == _Op_Send)
+                    HandleSend(reinterpret_cast<LLBC_IoUringSendReq *>(cqe.user_data >> _Op_Bits), cqe.res);
+            }
+
+            LLBC_AtomicStoreRelease(reinterpret_cast<volatile sint32 *>(_cqHead), static_cast<sint32>(head));
+        }
+    }
+
+    DestroyRing();
+
+    for (size_t i = 0; i < _freeSendReqs.size(); i++)
+        LLBC_Free(_freeSendReqs[i]);
+    _freeSendReqs.clear();
+
+    Base::Cleanup();
+}
+
+void LLBC_IoUringPoller::PostSend(LLBC_Session *session)
+{
+    LLBC_Socket *sock = session->GetSocket();
+    if (sock->_uringSendReq)
+        return;
+
+    LLBC_IoUringSendReq *req = AllocSendReq();
+    if ((req->vecCount = sock->FillUringSendVecs(req->vecs, LLBC_IOV_MAX)) == 0)
+    {
+        ReleaseSendReq(req);
+        return;
+    }
+
+    req->sessionId = session->GetId();
+    req->orphanBlocks = NULL;
+
+    ::memset(&req->msg, 0, sizeof(req->msg));
+    req->msg.msg_iov = req->vecs;
+    req->msg.msg_iovlen = req->vecCount;
+
+    struct io_uring_sqe *sqe = GetSqe(_Op_Send, reinterpret_cast<uint64>(req));
+    sqe->opcode = IORING_OP_SENDMSG;
+    sqe->fd = sock->Handle();
+    sqe->addr = reinterpret_cast<uint64>(&req->msg);
+    sqe->len = 1;
+    sqe->msg_flags = MSG_NOSIGNAL;
+
+    sock->_uringSendReq = req;
+    ++_inflightSendReqs;
+}
+
+void LLBC_IoUringPoller::CancelRequests(LLBC_Session *session)
+{
+    // Cancel all requests on the socket(multishot accept/recv, in-flight send).
+    LLBC_Socket *sock = session->GetSocket();
+    struct io_uring_sqe *sqe = GetSqe(_Op_Cancel, 0);
+    sqe->opcode = IORING_OP_ASYNC_CANCEL;
+    sqe->fd = sock->Handle();
+    sqe->cancel_flags = IORING_ASYNC_CANCEL_FD | IORING_ASYNC_CANCEL_ALL;
+
+    // The in-flight send request take over the send blocks, will be deleted when request completed.
+    if (sock->_uringSendReq)
+    {
+        sock->_uringSendReq->sessionId = 0;
+        sock->_uringSendReq->orphanBlocks = sock->DetachUringSendBlocks();
+        sock->_uringSendReq = NULL;
+    }
+
+    // Submit now, the socket will be closed after return, the requests prepared before(include
+    // cancel request) must be issued before socket handle reused.
+    Submit(0);
+}
+
+void LLBC_IoUringPoller::HandleEv_AsyncConn(LLBC_PollerEvent &ev)
+{
+    LLBC_Socket *sock = LLBC_New(LLBC_Socket);
+    const LLBC_SocketHandle handle = sock->Handle();
+
+    sock->SetNonBlocking();
+    sock->SetPollerType(LLBC_PollerType::IoUringPoller);
+    if (sock->Connect(ev.peerAddr) == LLBC_OK)
+    {
+        _svc->Push(LLBC_SvcEvUtil::
+                BuildAsyncConnResultEv(true, "Success", ev.peerAddr));
+
+        SetConnectedSocketDftOpts(sock);
+        AddSession(CreateSession(sock, ev.sessionId));
+    }
+    else if (LLBC_GetLastError() == LLBC_ERROR_WBLOCK)
+    {
+        LLBC_AsyncConnInfo asyncInfo;
+        asyncInfo.socket = sock;
+        asyncInfo.peerAddr = ev.peerAddr;
+        asyncInfo.sessionId = ev.sessionId;
+        _connecting.insert(std::make_pair(handle, asyncInfo));
+
+        struct io_uring_sqe *sqe = GetSqe(_Op_Connect, static_cast<uint64>(handle));
+        sqe->opcode = IORING_OP_POLL_ADD;
+        sqe->fd = handle;
+        sqe->poll32_events = POLLOUT;
+    }
+    else
+    {
+        const LLBC_String &reason = LLBC_FormatLastError();
+        _svc->Push(LLBC_SvcEvUtil::BuildAsyncConnResultEv(false, reason, ev.peerAddr));
+
+        LLBC_Delete(sock);
+    }
+}
+
+void LLBC_IoUringPoller::AddSession(LLBC_Session *session)
+{
+    Base::AddSession(session);
+
+    if (session->IsListen())
+        PrepareAccept(session);
+    else
+        PrepareRecv(session);
+}
+
+void LLBC_IoUringPoller::Wakeup()
+{
+    // Only the first pusher after poller waked up need write eventfd, the writers count make sure
+    // eventfd not closed while writing.
+    LLBC_AtomicFetchAndAdd(&_wakeupWriters, 1);
+    if (LLBC_AtomicCompareAndExchange(&_wakeupPending, 1, 0) == 0)
+    {
+        const uint64 val = 1;
+        while (::write(_wakeupFd, &val, sizeof(val)) < 0 && errno == EINTR);
+    }
+
+    LLBC_AtomicFetchAndSub(&_wakeupWriters, 1);
+}
+
+void LLBC_IoUringPoller::CloseWakeupFd()
+{
+    if (_wakeupFd == -1)
+        return;
+
+    LLBC_AtomicSet(&_wakeupPending, 1);
+    while (LLBC_AtomicGet(&_wakeupWriters) > 0)
+        LLBC_ThreadManager::Sleep(0);
+
+    ::close(_wakeupFd);
+    _wakeupFd = -1;
+}
+
+int LLBC_IoUringPoller::SetupRing()
+{
+    struct io_uring_params params;
+    ::memset(&params, 0, sizeof(params));
+    params.flags = IORING_SETUP_CQSIZE | IORING_SETUP_SUBMIT_ALL | IORING_SETUP_COOP_TASKRUN;
+    params.cq_entries = LLBC_CFG_IOURING_SQ_ENTRIES * 4;
+    if ((_ringFd = LLBC_INL_NS __IoUringSetup(LLBC_CFG_IOURING_SQ_ENTRIES, &params)) < 0)
+    {
+        LLBC_SetLastError(LLBC_ERROR_CLIB);
+        return LLBC_FAILED;
+    }
+
+    // Map submission/completion queue ring(single mmap) and submission queue entries.
+    _sqRingSize = params.sq_off.array + params.sq_entries * sizeof(uint32);
+    _cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+    _sqRingSize = _cqRingSize = MAX(_sqRingSize, _cqRingSize);
+    _sqesSize = params.sq_entries * sizeof(struct io_uring_sqe);
+
+    _sqRing = ::mmap(NULL, _sqRingSize, PROT_READ | PROT_WRITE,
+                     MAP_SHARED | MAP_POPULATE, _ringFd, IORING_OFF_SQ_RING);
+    _sqes = reinterpret_cast<struct io_uring_sqe *>(
+        ::mmap(NULL, _sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, _ringFd, IORING_OFF_SQES));
+    if (_sqRing == MAP_FAILED || _sqes == MAP_FAILED)
+    {
+        LLBC_SetLastError(LLBC_ERROR_CLIB);
+        DestroyRing();
+
+        return LLBC_FAILED;
+    }
+
+    char *sqRing = reinterpret_cast<char *>(_sqRing);
+    _sqHead = reinterpret_cast<volatile uint32 *>(sqRing + params.sq_off.head);
+    _sqTail = reinterpret_cast<volatile uint32 *>(sqRing + params.sq_off.tail);
+    _sqMask = *reinterpret_cast<uint32 *>(sqRing + params.sq_off.ring_mask);
+    _sqEntries = *reinterpret_cast<uint32 *>(sqRing + params.sq_off.ring_entries);
+    _sqPrepared = *_sqTail;
+
+    // Use identity submission queue index array, entries always submitted in order.
+    uint32 *sqArray = reinterpret_cast<uint32 *>(sqRing + params.sq_off.array);
+    for (uint32 i = 0; i < _sqEntries; i++)
+        sqArray[i] = i;
+
+    _cqRing = _sqRing;
+    char *cqRing = reinterpret_cast<char *>(_cqRing);
+    _cqHead = reinterpret_cast<volatile uint32 *>(cqRing + params.cq_off.head);
+    _cqTail = reinterpret_cast<volatile uint32 *>(cqRing + params.cq_off.tail);
+    _cqMask = *reinterpret_cast<uint32 *>(cqRing + params.cq_off.ring_mask);
+    _cqes = reinterpret_cast<struct io_uring_cqe *>(cqRing + params.cq_off.cqes);
+
+    // Create provided buffer ring, and provide all buffers to kernel.
+    _bufRingSize = LLBC_CFG_IOURING_RECV_BUF_COUNT * sizeof(struct io_uring_buf);
+    _bufRing = reinterpret_cast<struct io_uring_buf *>(
+        ::mmap(NULL, _bufRingSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0));
+    if (_bufRing == MAP_FAILED)
+    {
+        _bufRing = NULL;
+        LLBC_SetLastError(LLBC_ERROR_CLIB);
+        DestroyRing();
+
+        return LLBC_FAILED;
+    }
+
+    // Every provided buffer is a receive slab, kernel receive data into slab directly.
+    _bufSlabPool = LLBC_New3(LLBC_RecvSlabPool,
+                             LLBC_CFG_IOURING_RECV_BUF_SIZE,
+                             LLBC_CFG_IOURING_RECV_BUF_SIZE,
+                             LLBC_CFG_IOURING_RECV_BUF_COUNT);
+    _bufSlabs.resize(LLBC_CFG_IOURING_RECV_BUF_COUNT);
+    for (int i = 0; i < LLBC_CFG_IOURING_RECV_BUF_COUNT; i++)
+        _bufSlabs[i] = _bufSlabPool->Acquire();
+
+    if (LLBC_INL_NS __RegisterBufRing(_ringFd, _bufRing, LLBC_CFG_IOURING_RECV_BUF_COUNT) != 0)
+    {
+        LLBC_SetLastError(LLBC_ERROR_CLIB);
+        DestroyRing();
+
+        return LLBC_FAILED;
+    }
+
+    _bufRingTail = _bufRingPublished = 0;
+    for (int i = 0; i < LLBC_CFG_IOURING_RECV_BUF_COUNT; i++)
+        RecycleBuffer(static_cast<uint16>(i));
+    PublishBuffers();
+
+    return LLBC_OK;
+}
+
+void LLBC_IoUringPoller::DestroyRing()
+{
+    if (_ringFd >= 0)
+    {
+        ::close(_ringFd);
+        _ringFd = -1;
+    }
+
+    if (_sqRing && _sqRing != MAP_FAILED)
+        ::munmap(_sqRing, _sqRingSize);
+    if (_sqes && _sqes != MAP_FAILED)
+        ::munmap(_sqes, _sqesSize);
+    _sqRing = _cqRing = NULL;
+    _sqes = NULL;
+    _cqes = NULL;
+    _sqHead = _sqTail = _cqHead = _cqTail = NULL;
+
+    if (_bufRing)
+    {
+        ::munmap(_bufRing, _bufRingSize);
+        _bufRing = NULL;
+    }
+
+    for (size_t i = 0; i < _bufSlabs.size(); i++)
+        _bufSlabs[i]->Release();
+    _bufSlabs.clear();
+
+    if (_bufSlabPool)
+    {
+        _bufSlabPool->Destroy();
+        _bufSlabPool = NULL;
+    }
+}
+
+struct io_uring_sqe *LLBC_IoUringPoller::GetSqe(int op, uint64 data)
+{
+    // Submission queue full, submit prepared entries first(until kernel consumed).
+    while (_sqPrepared - static_cast<uint32>(
+            LLBC_AtomicLoadAcquire(reinterpret_cast<volatile sint32 *>(_sqHead))) >= _sqEntries)
+        Submit(0);
+
+    struct io_uring_sqe *sqe = &_sqes[_sqPrepared & _sqMask];
+    ++_sqPrepared;
+
+    ::memset(sqe, 0, sizeof(struct io_uring_sqe));
+    sqe->user_data = (data << _Op_Bits) | static_cast<uint64>(op);
+
+    return sqe;
+}
+
+void LLBC_IoUringPoller::Submit(int waitTime)
+{
+    const uint32 toSubmit = _sqPrepared - static_cast<uint32>(
+        LLBC_AtomicLoadAcquire(reinterpret_cast<volatile sint32 *>(_sqHead)));
+    if (toSubmit == 0 && waitTime == 0)
+        return;
+
+    LLBC_AtomicStoreRelease(reinterpret_cast<volatile sint32 *>(_sqTail), static_cast<sint32>(_sqPrepared));
+
+    // The submitted recv requests maybe issued immediately, publish recycled buffers first.
+    PublishBuffers();
+
+    uint32 flags = 0;
+    uint32 minComplete = 0;
+    struct __kernel_timespec ts;
+    struct io_uring_getevents_arg arg;
+    ::memset(&arg, 0, sizeof(arg));
+    if (waitTime > 0)
+    {
+        ts.tv_sec = waitTime / 1000;
+        ts.tv_nsec = (waitTime % 1000) * 1000000LL;
+        arg.ts = reinterpret_cast<uint64>(&ts);
+
+        flags = IORING_ENTER_GETEVENTS | IORING_ENTER_EXT_ARG;
+        minComplete = 1;
+    }
+
+    // The errors(EINTR, ETIME, EBUSY, ...) are ignored, the submitted entries will be submitted again in next call.
+    LLBC_INL_NS __IoUringEnter(_ringFd, toSubmit, minComplete, flags, &arg, sizeof(arg));
+}
+
+void LLBC_IoUringPoller::HandleCompletions()
+{
+    uint32 head = *_cqHead;
+    for (; ;)
+    {
+        const uint32 tail = LLBC_AtomicLoadAcquire(reinterpret_cast<volatile sint32 *>(_cqTail));
+        if (head == tail)
+            break;
+
+        for (; head != tail; )
+        {
+            // Copy completion and advance head, completion handlers maybe submit requests.
+            const struct io_uring_cqe &cqe = _cqes[head & _cqMask];
+            const uint64 data = cqe.user_data >> _Op_Bits;
+            const int op = static_cast<int>(cqe.user_data & _Op_Mask);
+            const sint32 res = cqe.res;
+            const uint32 flags = cqe.flags;
+
+            ++head;
+            LLBC_AtomicStoreRelease(reinterpret_cast<volatile sint32 *>(_cqHead), static_cast<sint32>(head));
+
+            switch (op)
+            {
+            case _Op_Wakeup:
+                HandleWakeup(res, flags);
+                break;
+
+            case _Op_Accept:
+                HandleAccept(static_cast<int>(data), res, flags);
+                break;
+
+            case _Op_Recv:
+                HandleRecv(static_cast<int>(data), res, flags);
+                break;
+
+            case _Op_Send:
+                HandleSend(reinterpret_cast<LLBC_IoUringSendReq *>(data), res);
+                break;
+
+            case _Op_Connect:
+                HandleConnect(static_cast<LLBC_SocketHandle>(data), res);
+                break;
+
+            default:
+                break;
+            }
+        }
+    }
+
+    // Publish recycled buffers to kernel, and re-arm the buffers exhausted sessions.
+    PublishBuffers();
+    if (!_noBufSessionIds.empty())
+    {
+        for (size_t i = 0; i < _noBufSessionIds.size(); i++)
+        {
+            LLBC_Session *session = _sessions.Find(_noBufSessionIds[i]);
+            if (session)
+                PrepareRecv(session);
+        }
+
+        _noBufSessionIds.clear();
+    }
+}
+
+void LLBC_IoUringPoller::HandleWakeup(sint32 res, uint32 flags)
+{
+    // Reset pending flag before drain queued events, the events pushed after reset will wake up poller again.
+    uint64 val;
+    while (::read(_wakeupFd, &val, sizeof(val)) < 0 && errno == EINTR);
+    LLBC_AtomicSet(&_wakeupPending, 0);
+
+    if (!(flags & IORING_CQE_F_MORE))
+        PrepareWakeup();
+}
+
+void LLBC_IoUringPoller::HandleAccept(int sessionId, sint32 res, uint32 flags)
+{
+    LLBC_Session *session = _sessions.Find(sessionId);
+    if (res >= 0)
+    {
+        if (UNLIKELY(!session))
+        {
+            ::close(res);
+            return;
+        }
+
+        LLBC_Socket *newSock = LLBC_New1(LLBC_Socket, res);
+        newSock->SetPollerType(LLBC_PollerType::IoUringPoller);
+
+        SetConnectedSocketDftOpts(newSock);
+        AddToPoller(CreateAcceptedSession(session->GetSocket(), newSock));
+    }
+
+    // Multishot accept terminated(error occurred, eg: EMFILE), re-arm it.
+    if (session && !(flags & IORING_CQE_F_MORE))
+        PrepareAccept(session);
+}
+
+void LLBC_IoUringPoller::HandleRecv(int sessionId, sint32 res, uint32 flags)
+{
+    LLBC_Session *session = _sessions.Find(sessionId);
+    if (res > 0)
+    {
+        const uint16 bufId = static_cast<uint16>(flags >> IORING_CQE_BUFFER_SHIFT);
+        LLBC_RecvSlab *slab = _bufSlabs[bufId];
+        const bool alive = session != NULL &&
+            session->GetSocket()->OnUringRecved(slab, static_cast<size_t>(res));
+
+        // The packets which reference slab will hold it, provide an empty slab to kernel(if no packet
+        // reference the slab, it recycled to pool and reused immediately).
+        slab->Release();
+        _bufSlabs[bufId] = _bufSlabPool->Acquire();
+        RecycleBuffer(bufId);
+
+        // Multishot recv terminated(eg: recv buffer larger than provided buffer), re-arm it.
+        if (alive && !(flags & IORING_CQE_F_MORE))
+            PrepareRecv(session);
+
+        return;
+    }
+
+    if (!session)
+        return;
+
+    if (res == 0) // Connection gracefully close by peer, same as LLBC_Socket::OnRecv(), set errno to ECONNRESET.
+    {
+        session->OnClose(new LLBC_SessionCloseInfo(LLBC_ERROR_CLIB, ECONNRESET));
+    }
+    else if (res == -ENOBUFS)
+    {
+        // Provided buffers exhausted, re-arm it after all completions handled(buffers recycled),
+        // if re-arm immediately, the request maybe submitted and failed again before buffers published.
+        _noBufSessionIds.push_back(sessionId);
+    }
+    else if (res != -ECANCELED)
+    {
+        session->OnClose(new LLBC_SessionCloseInfo(LLBC_ERROR_CLIB, -res));
+    }
+}
+
+void LLBC_IoUringPoller::HandleSend(LLBC_IoUringSendReq *req, sint32 res)
+{
+    --_inflightSendReqs;
+
+    // Session closed while request in-flight, delete the blocks taken over.
+    if (req->sessionId == 0)
+    {
+        LLBC_INL_NS __DeleteBlocks(req->orphanBlocks);
+        ReleaseSendReq(req);
+
+        return;
+    }
+
+    LLBC_Session *session = _sessions.Find(req->sessionId);
+    if (UNLIKELY(!session))
+    {
+        ReleaseSendReq(req);
+        return;
+    }
+
+    LLBC_Socket *sock = session->GetSocket();
+    sock->_uringSendReq = NULL;
+    if (res >= 0)
+        sock->OnUringSent(res, req->vecs, req->vecCount);
+
+    ReleaseSendReq(req);
+
+    if (res < 0 && res != -EINTR && res != -EAGAIN)
+    {
+        session->OnClose(new LLBC_SessionCloseInfo(LLBC_ERROR_CLIB, -res));
+        return;
+    }
+
+    // Send the remaining data(partial sent, or queued while request in-flight).
+    PostSend(session);
+}
+
+void LLBC_IoUringPoller::HandleConnect(LLBC_SocketHandle handle, sint32 res)
+{
+    _Connecting::iterator it = _connecting.find(handle);
+    if (it == _connecting.end())
+        return;
+
+    LLBC_AsyncConnInfo &asyncInfo = it->second;
+    LLBC_Socket *sock = asyncInfo.socket;
+
+    bool connected = false;
+    if (res >= 0 && (res & POLLOUT))
+    {
+        int optval;
+        LLBC_SocketLen optlen = sizeof(int);
+        if (sock->GetOption(SOL_SOCKET,
+                            SO_ERROR,
+                            &optval,
+                            &optlen) == LLBC_OK && optval == 0)
+            connected = true;
+    }
+
+    _svc->Push(LLBC_SvcEvUtil::BuildAsyncConnResultEv(connected,
+                connected ? "Success" : LLBC_FormatLastError(), asyncInfo.peerAddr));
+    if (connected)
+    {
+        SetConnectedSocketDftOpts(sock);
+        AddSession(CreateSession(sock, asyncInfo.sessionId));
+    }
+    else
+    {
+        LLBC_XDelete(sock);
+    }
+
+    _connecting.erase(it);
+}
+
+void LLBC_IoUringPoller::PrepareWakeup()
+{
+    struct io_uring_sqe *sqe = GetSqe(_Op_Wakeup, 0);
+    sqe->opcode = IORING_OP_POLL_ADD;
+    sqe->fd = _wakeupFd;
+    sqe->len = IORING_POLL_ADD_MULTI;
+    sqe->poll32_events = POLLIN;
+}
+
+void LLBC_IoUringPoller::PrepareAccept(LLBC_Session *session)
+{
+    struct io_uring_sqe *sqe = GetSqe(_Op_Accept, static_cast<uint64>(session->GetId()));
+    sqe->opcode = IORING_OP_ACCEPT;
+    sqe->fd = session->GetSocketHandle();
+    sqe->ioprio = IORING_ACCEPT_MULTISHOT;
+    sqe->accept_flags = SOCK_NONBLOCK | SOCK_CLOEXEC;
+}
+
+void LLBC_IoUringPoller::PrepareRecv(LLBC_Session *session)
+{
+    struct io_uring_sqe *sqe = GetSqe(_Op_Recv, static_cast<uint64>(session->GetId()));
+    sqe->opcode = IORING_OP_RECV;
+    sqe->fd = session->GetSocketHandle();
+    sqe->ioprio = IORING_RECV_MULTISHOT;
+    sqe->flags = IOSQE_BUFFER_SELECT;
+    sqe->buf_group = LLBC_INL_NS __bufGroupId;
+}
+
+void LLBC_IoUringPoller::RecycleBuffer(uint16 bufId)
+{
+    struct io_uring_buf &buf = _bufRing[_bufRingTail & (LLBC_CFG_IOURING_RECV_BUF_COUNT - 1)];
+    buf.addr = reinterpret_cast<uint64>(_bufSlabs[bufId]->GetBuf());
+    buf.len = LLBC_CFG_IOURING_RECV_BUF_SIZE;
+    buf.bid = bufId;
+
+    ++_bufRingTail;
+}
+
+void LLBC_IoUringPoller::PublishBuffers()
+{
+    // The ring tail is overlaid with the first buffer resv field(see struct io_uring_buf_ring),
+    // not use io_uring_buf_ring::bufs, the flex array offset is different in C++.
+    if (_bufRingPublished == _bufRingTail)
+        return;
+
+    LLBC_AtomicMemoryBarrier();
+    *reinterpret_cast<volatile uint16 *>(&_bufRing[0].resv) = _bufRingTail;
+    _bufRingPublished = _bufRingTail;
+}
+
+LLBC_IoUringSendReq *LLBC_IoUringPoller::AllocSendReq()
+{
+    if (_freeSendReqs.empty())
+        return LLBC_Malloc(LLBC_IoUringSendReq, sizeof(LLBC_IoUringSendReq));
+
+    LLBC_IoUringSendReq *req = _freeSendReqs.back();
+    _freeSendReqs.pop_back();
+
+    return req;
+}
+
+void LLBC_IoUringPoller::ReleaseSendReq(LLBC_IoUringSendReq *req)
+{
+    _freeSendReqs.push_back(req);
+}
+
+__LLBC_NS_END
+
+#endif // LLBC_TARGET_PLATFORM_LINUX
+
+#include "llbc/common/AfterIncl.h"
@@ -37,6 +37,8 @@ __LLBC_NS_BEGIN
 LLBC_IocpPoller::LLBC_IocpPoller()
 : _iocp(LLBC_INVALID_IOCP_HANDLE)
 , _monitor(NULL)
+
+, _wakeupSem()
 {
 }
 
@@ -83,8 +85,12 @@ void LLBC_IocpPoller::Svc()
     while (!_started)
         LLBC_Sleep(20);
 
+    // Event queue is lock-free, pushers post wakeup semaphore when queue changed from empty to non-empty.
     while (!_stopping)
-        HandleQueuedEvents(20);
+    {
+        _wakeupSem.TimedWait(20);
+        HandleQueuedEvents();
+    }
 }
 
 void LLBC_IocpPoller::Cleanup()
@@ -187,8 +193,8 @@ void LLBC_IocpPoller::HandleEv_Monitor(LLBC_PollerEvent &ev)
     if (HandleConnecting(waitRet, ol, errNo, subErrNo))
         return;
 
-    _Sockets::iterator it  = _sockets.find(ol->sock);
-    if (UNLIKELY(it == _sockets.end()))
+    LLBC_Session *session = _sessions.FindBySocket(ol->sock);
+    if (UNLIKELY(!session))
     {
         if (ol->acceptSock != LLBC_INVALID_SOCKET_HANDLE)
             LLBC_CloseSocket(ol->acceptSock);
@@ -199,7 +205,6 @@ void LLBC_IocpPoller::HandleEv_Monitor(LLBC_PollerEvent &ev)
         return;
     }
 
-    LLBC_Session *session = it->second;
     if (waitRet == LLBC_FAILED)
     {
         session->OnClose(ol, LLBC_New2(LLBC_SessionCloseInfo, errNo, subErrNo));
@@ -239,6 +244,11 @@ void LLBC_IocpPoller::RemoveSession(LLBC_Session *session)
     Base::RemoveSession(session);
 }
 
+void LLBC_IocpPoller::Wakeup()
+{
+    _wakeupSem.Post();
+}
+
 int LLBC_IocpPoller::StartupMonitor()
 {
     LLBC_IDelegate0 *deleg = new LLBC_Delegate0<
@@ -337,7 +347,7 @@ void LLBC_IocpPoller::Accept(LLBC_Session *session, LLBC_POverlapped ol)
     sock->PostAsyncAccept();
 
     // Create session and add to poller.
-    AddToPoller(CreateSession(newSock));
+    AddToPoller(CreateAcceptedSession(sock, newSock));
 }
 
 __LLBC_NS_END
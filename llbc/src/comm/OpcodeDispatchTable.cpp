@@ -0,0 +1,128 @@
+/**
+ * @file    OpcodeDispatchTable.cpp
+ * @author  Longwei Lai<lailongwei@126.com>
+ * @date    2026/10/18
+ * @version 1.0
+ *
+ * @brief
+ */
+
+#include "llbc/common/Export.h"
+#include "llbc/common/BeforeIncl.h"
+
+#include "llbc/comm/OpcodeDispatchTable.h"
+
+namespace
+{
+    // The entries array alignment, use cache line size.
+    const size_t __entriesAlign = 64;
+}
+
+__LLBC_NS_BEGIN
+
+LLBC_OpcodeDispatchTable::LLBC_OpcodeDispatchTable()
+: _denseMem(NULL)
+, _dense(NULL)
+, _denseSize(0)
+
+, _sparseKeys(NULL)
+, _sparseMem(NULL)
+, _sparse(NULL)
+, _sparseMask(0)
+, _sparseCount(0)
+{
+    LLBC_MemSet(&_dftEntry, 0, sizeof(_dftEntry));
+}
+
+LLBC_OpcodeDispatchTable::~LLBC_OpcodeDispatchTable()
+{
+    Clear();
+}
+
+void LLBC_OpcodeDispatchTable::Compile(const Entries &entries,
+                                       const LLBC_OpcodeDispatchEntry *dftEntry,
+                                       int denseLimit)
+{
+    Clear();
+    if (dftEntry)
+        _dftEntry = *dftEntry;
+
+    // Calculate dense array size and sparse entries count.
+    int maxDenseOpcode = -1;
+    for (Entries::const_iterator it = entries.begin();
+         it != entries.end();
+         it++)
+    {
+        if (it->first >= 0 && it->first < denseLimit)
+            maxDenseOpcode = MAX(maxDenseOpcode, it->first);
+        else
+            _sparseCount += 1;
+    }
+
+    // Build dense entries array, the not subscribed opcodes use default entry.
+    if (maxDenseOpcode >= 0)
+    {
+        _denseSize = static_cast<uint32>(maxDenseOpcode + 1);
+        _dense = AllocEntries(_denseSize, _denseMem);
+        for (uint32 i = 0; i < _denseSize; i++)
+            _dense[i] = _dftEntry;
+    }
+
+    // Build sparse hash table, keep load factor not exceed 0.5.
+    if (_sparseCount > 0)
+    {
+        uint32 slotsCount = 4;
+        while (slotsCount < _sparseCount * 2)
+            slotsCount <<= 1;
+
+        _sparseKeys = LLBC_Calloc(_SparseKey, sizeof(_SparseKey) * slotsCount);
+        _sparse = AllocEntries(slotsCount, _sparseMem);
+        _sparseMask = slotsCount - 1;
+    }
+
+    for (Entries::const_iterator it = entries.begin();
+         it != entries.end();
+         it++)
+    {
+        const int opcode = it->first;
+        if (opcode >= 0 && opcode < denseLimit)
+        {
+            _dense[opcode] = it->second;
+            continue;
+        }
+
+        uint32 idx = HashSparse(opcode) & _sparseMask;
+        while (_sparseKeys[idx].used)
+            idx = (idx + 1) & _sparseMask;
+
+        _sparseKeys[idx].opcode = opcode;
+        _sparseKeys[idx].used = true;
+        _sparse[idx] = it->second;
+    }
+}
+
+void LLBC_OpcodeDispatchTable::Clear()
+{
+    LLBC_XFree(_denseMem);
+    _dense = NULL;
+    _denseSize = 0;
+
+    LLBC_XFree(_sparseKeys);
+    LLBC_XFree(_sparseMem);
+    _sparse = NULL;
+    _sparseMask = 0;
+    _sparseCount = 0;
+
+    LLBC_MemSet(&_dftEntry, 0, sizeof(_dftEntry));
+}
+
+LLBC_OpcodeDispatchEntry *LLBC_OpcodeDispatchTable::AllocEntries(size_t count, void *&mem)
+{
+    mem = LLBC_Calloc(char, sizeof(LLBC_OpcodeDispatchEntry) * count + __entriesAlign);
+    return reinterpret_cast<LLBC_OpcodeDispatchEntry *>(
+        (reinterpret_cast<size_t>(mem) + __entriesAlign - 1) & ~(__entriesAlign - 1));
+}
+
+__LLBC_NS_END
+
+#include "llbc/common/AfterIncl.h"
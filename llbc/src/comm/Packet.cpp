@@ -10,14 +10,17 @@
 #include "llbc/common/Export.h"
 #include "llbc/common/BeforeIncl.h"
 
+#include "llbc/comm/headerdesc/PacketHeaderLayout.h"
 #include "llbc/comm/PacketHeaderDescAccessor.h"
 
 #include "llbc/comm/ICoder.h"
 #include "llbc/comm/Packet.h"
+#include "llbc/comm/RecvSlab.h"
 
 namespace
 {
     typedef LLBC_NS LLBC_PacketHeaderDescAccessor _HDAccessor;
+    typedef LLBC_NS LLBC_FixedPacketHeaderLayout _FixedLayout;
 }
 
 __LLBC_INTERNAL_NS_BEGIN
@@ -32,6 +35,7 @@ LLBC_Packet::LLBC_Packet()
 : _headerDesc(_HDAccessor::GetHeaderDesc())
 , _lenSize(_HDAccessor::GetHeaderDesc()->GetLenPartLen())
 , _lenOffset(_HDAccessor::GetHeaderDesc()->GetLenPartOffset())
+, _fixedLayout(_HDAccessor::IsFixedLayout())
 
 , _sessionId(0)
 
@@ -51,7 +55,42 @@ LLBC_Packet::LLBC_Packet()
     _block->SetReadPos(headerLen);
     _block->SetWritePos(headerLen);
 
+    _slab = NULL;
     _codecError = NULL;
+
+    _chunkOffset = 0;
+    _chunkTotalLen = 0;
+}
+
+LLBC_Packet::LLBC_Packet(LLBC_RecvSlab *slab, const void *data, size_t len)
+: _headerDesc(_HDAccessor::GetHeaderDesc())
+, _lenSize(_HDAccessor::GetHeaderDesc()->GetLenPartLen())
+, _lenOffset(_HDAccessor::GetHeaderDesc()->GetLenPartOffset())
+, _fixedLayout(_HDAccessor::IsFixedLayout())
+
+, _sessionId(0)
+
+, _encoder(NULL)
+, _decoder(NULL)
+#if LLBC_CFG_COMM_ENABLE_STATUS_DESC
+, _statusDesc(NULL)
+#endif // LLBC_CFG_COMM_ENABLE_STATUS_DESC
+
+, _preHandleResult(NULL)
+, _resultClearDeleg(NULL)
+{
+    // Attach to slab data, if packet write data later, message block will copy data to self own buffer.
+    _block = new LLBC_MessageBlock(const_cast<void *>(data), len);
+    _block->SetReadPos(_headerDesc->GetHeaderLen());
+    _block->SetWritePos(len);
+
+    _slab = slab;
+    _slab->Retain();
+
+    _codecError = NULL;
+
+    _chunkOffset = 0;
+    _chunkTotalLen = 0;
 }
 
 LLBC_Packet::~LLBC_Packet()
@@ -65,11 +104,19 @@ LLBC_Packet::~LLBC_Packet()
 #endif // LLBC_CFG_COMM_ENABLE_STATUS_DESC
 
     LLBC_XDelete(_block);
+    if (_slab)
+        _slab->Release();
+
     LLBC_XDelete(_codecError);
 }
 
 int LLBC_Packet::GetLength() const
 {
+#if LLBC_CFG_COMM_USE_FIXED_PACKET_HEADER_LAYOUT
+    if (LIKELY(_fixedLayout))
+        return _FixedLayout::Length::Get(_block->GetData());
+#endif // LLBC_CFG_COMM_USE_FIXED_PACKET_HEADER_LAYOUT
+
     const char *lenBeg =
         reinterpret_cast<const char *>(_block->GetData()) + _lenOffset;
 
@@ -81,6 +128,11 @@ int LLBC_Packet::GetLength() const
 
 int LLBC_Packet::GetOpcode() const
 {
+#if LLBC_CFG_COMM_USE_FIXED_PACKET_HEADER_LAYOUT
+    if (LIKELY(_fixedLayout))
+        return _FixedLayout::Opcode::Get(_block->GetData());
+#endif // LLBC_CFG_COMM_USE_FIXED_PACKET_HEADER_LAYOUT
+
     if (!_headerDesc->IsHasOpcodePart())
         return 0;
 
@@ -98,6 +150,14 @@ int LLBC_Packet::GetOpcode() const
 
 void LLBC_Packet::SetOpcode(int opcode)
 {
+#if LLBC_CFG_COMM_USE_FIXED_PACKET_HEADER_LAYOUT
+    if (LIKELY(_fixedLayout))
+    {
+        _FixedLayout::Opcode::Set(_block->GetData(), opcode);
+        return;
+    }
+#endif // LLBC_CFG_COMM_USE_FIXED_PACKET_HEADER_LAYOUT
+
     if (!_headerDesc->IsHasOpcodePart())
         return;
 
@@ -112,6 +172,11 @@ void LLBC_Packet::SetOpcode(int opcode)
 
 int LLBC_Packet::GetStatus() const
 {
+#if LLBC_CFG_COMM_USE_FIXED_PACKET_HEADER_LAYOUT
+    if (LIKELY(_fixedLayout))
+        return _FixedLayout::Status::Get(_block->GetData());
+#endif // LLBC_CFG_COMM_USE_FIXED_PACKET_HEADER_LAYOUT
+
     if (!_headerDesc->IsHasStatusPart())
         return 0;
 
@@ -129,6 +194,14 @@ int LLBC_Packet::GetStatus() const
 
 void LLBC_Packet::SetStatus(int status)
 {
+#if LLBC_CFG_COMM_USE_FIXED_PACKET_HEADER_LAYOUT
+    if (LIKELY(_fixedLayout))
+    {
+        _FixedLayout::Status::Set(_block->GetData(), status);
+        return;
+    }
+#endif // LLBC_CFG_COMM_USE_FIXED_PACKET_HEADER_LAYOUT
+
     if (!_headerDesc->IsHasStatusPart())
         return;
 
@@ -158,6 +231,11 @@ void LLBC_Packet::SetStatusDesc(const LLBC_String &desc)
 
 int LLBC_Packet::GetServiceId() const
 {
+#if LLBC_CFG_COMM_USE_FIXED_PACKET_HEADER_LAYOUT
+    if (LIKELY(_fixedLayout))
+        return _FixedLayout::ServiceId::Get(_block->GetData());
+#endif // LLBC_CFG_COMM_USE_FIXED_PACKET_HEADER_LAYOUT
+
     if (!_headerDesc->IsHasServiceIdPart())
         return 0;
 
@@ -175,6 +253,14 @@ int LLBC_Packet::GetServiceId() const
 
 void LLBC_Packet::SetServiceId(int serviceId)
 {
+#if LLBC_CFG_COMM_USE_FIXED_PACKET_HEADER_LAYOUT
+    if (LIKELY(_fixedLayout))
+    {
+        _FixedLayout::ServiceId::Set(_block->GetData(), serviceId);
+        return;
+    }
+#endif // LLBC_CFG_COMM_USE_FIXED_PACKET_HEADER_LAYOUT
+
     if (!_headerDesc->IsHasServiceIdPart())
         return;
 
@@ -189,6 +275,11 @@ void LLBC_Packet::SetServiceId(int serviceId)
 
 int LLBC_Packet::GetFlags() const
 {
+#if LLBC_CFG_COMM_USE_FIXED_PACKET_HEADER_LAYOUT
+    if (LIKELY(_fixedLayout))
+        return _FixedLayout::Flags::Get(_block->GetData());
+#endif // LLBC_CFG_COMM_USE_FIXED_PACKET_HEADER_LAYOUT
+
     if (!_headerDesc->IsHasFlagsPart())
         return 0;
 
@@ -206,6 +297,14 @@ int LLBC_Packet::GetFlags() const
 
 void LLBC_Packet::SetFlags(int flags)
 {
+#if LLBC_CFG_COMM_USE_FIXED_PACKET_HEADER_LAYOUT
+    if (LIKELY(_fixedLayout))
+    {
+        _FixedLayout::Flags::Set(_block->GetData(), flags);
+        return;
+    }
+#endif // LLBC_CFG_COMM_USE_FIXED_PACKET_HEADER_LAYOUT
+
     if (!_headerDesc->IsHasFlagsPart())
         return;
 
@@ -594,6 +693,21 @@ void LLBC_Packet::SetDecoder(LLBC_ICoder *decoder)
 
 LLBC_MessageBlock *LLBC_Packet::GiveUp()
 {
+    // The given up block will outlive packet, if block still reference slab data,
+    // hand over the slab referenced data with slab block(retain slab), don't need copy.
+    if (_slab)
+    {
+        if (_block->IsAttach())
+        {
+            LLBC_MessageBlock *block = LLBC_New3(LLBC_RecvSlabBlock, _slab, _block->GetData(), _block->GetWritePos());
+            LLBC_Delete(_block);
+            _block = block;
+        }
+
+        _slab->Release();
+        _slab = NULL;
+    }
+
     Encode();
 
     LLBC_MessageBlock *block = _block;
@@ -604,6 +718,14 @@ LLBC_MessageBlock *LLBC_Packet::GiveUp()
     size_t length = block->GetWritePos();
     length -= _headerDesc->GetLenPartNotIncludedLen();
 
+#if LLBC_CFG_COMM_USE_FIXED_PACKET_HEADER_LAYOUT
+    if (LIKELY(_fixedLayout))
+    {
+        _FixedLayout::Length::Set(block->GetData(), length);
+        return block;
+    }
+#endif // LLBC_CFG_COMM_USE_FIXED_PACKET_HEADER_LAYOUT
+
     char *lenBeg = reinterpret_cast<
         char *>(block->GetData()) + _lenOffset;
 
@@ -665,6 +787,42 @@ void LLBC_Packet::CleanupPreHandleResult()
     }
 }
 
+void LLBC_Packet::MoveDataTo(LLBC_Packet &packet)
+{
+    // Copy header to another packet header block, then swap blocks.
+    const size_t headerLen = _headerDesc->GetHeaderLen();
+    memcpy(packet._block->GetData(), _block->GetData(), headerLen);
+
+    LLBC_Swap(_block, packet._block);
+    LLBC_Swap(_slab, packet._slab);
+
+    packet._block->SetReadPos(headerLen);
+}
+
+void LLBC_Packet::ReplaceBlock(LLBC_MessageBlock *block)
+{
+    LLBC_Delete(_block);
+    if (_slab)
+    {
+        _slab->Release();
+        _slab = NULL;
+    }
+
+    _block = block;
+    _block->SetReadPos(_headerDesc->GetHeaderLen());
+
+    const size_t length = _block->GetWritePos() - _headerDesc->GetLenPartNotIncludedLen();
+#if LLBC_CFG_COMM_USE_FIXED_PACKET_HEADER_LAYOUT
+    if (LIKELY(_fixedLayout))
+    {
+        _FixedLayout::Length::Set(_block->GetData(), length);
+        return;
+    }
+#endif // LLBC_CFG_COMM_USE_FIXED_PACKET_HEADER_LAYOUT
+
+    RawSetNonFloatTypeHeaderPartVal(reinterpret_cast<char *>(_block->GetData()) + _lenOffset, _lenSize, length);
+}
+
 __LLBC_NS_END
 
 #include "llbc/common/AfterIncl.h"
@@ -10,8 +10,17 @@
 #include "llbc/common/Export.h"
 #include "llbc/common/BeforeIncl.h"
 
+#include "llbc/comm/Packet.h"
 #include "llbc/comm/PacketHeaderAssembler.h"
+#include "llbc/comm/PacketHeaderDescAccessor.h"
 #include "llbc/comm/headerdesc/PacketHeaderDesc.h"
+#include "llbc/comm/headerdesc/PacketHeaderLayout.h"
+
+namespace
+{
+    typedef LLBC_NS LLBC_PacketHeaderDescAccessor _HDAccessor;
+    typedef LLBC_NS LLBC_FixedPacketHeaderLayout _FixedLayout;
+}
 
 __LLBC_NS_BEGIN
 
@@ -20,6 +29,10 @@ LLBC_PacketHeaderAssembler::LLBC_PacketHeaderAssembler(size_t headerLen)
 , _headerLen(headerLen)
 
 , _curRecved(0)
+
+, _lenOffset(_HDAccessor::GetHeaderDesc()->GetLenPartOffset())
+, _lenSize(_HDAccessor::GetHeaderDesc()->GetLenPartLen())
+, _fixedLayout(_HDAccessor::IsFixedLayout())
 {
 }
 
@@ -70,6 +83,30 @@ size_t LLBC_PacketHeaderAssembler::GetHeaderLen() const
     return _headerLen;
 }
 
+size_t LLBC_PacketHeaderAssembler::GetAssembledLen() const
+{
+    return _curRecved;
+}
+
+int LLBC_PacketHeaderAssembler::GetLength() const
+{
+    return ReadLength(_header);
+}
+
+int LLBC_PacketHeaderAssembler::ReadLength(const void *header) const
+{
+#if LLBC_CFG_COMM_USE_FIXED_PACKET_HEADER_LAYOUT
+    if (LIKELY(_fixedLayout))
+        return _FixedLayout::Length::Get(header);
+#endif // LLBC_CFG_COMM_USE_FIXED_PACKET_HEADER_LAYOUT
+
+    int len;
+    LLBC_Packet::RawGetNonFloatTypeHeaderPartVal(
+        reinterpret_cast<const char *>(header) + _lenOffset, _lenSize, len);
+
+    return len;
+}
+
 __LLBC_NS_END
 
 #include "llbc/common/AfterIncl.h"
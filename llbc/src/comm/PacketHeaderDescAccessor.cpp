@@ -13,6 +13,7 @@
 #include "llbc/comm/IService.h"
 
 #include "llbc/comm/headerdesc/PacketHeaderDesc.h"
+#include "llbc/comm/headerdesc/PacketHeaderLayout.h"
 
 #include "llbc/comm/LibPacketHeaderDescFactory.h"
 #include "llbc/comm/PacketHeaderDescAccessor.h"
@@ -20,12 +21,18 @@
 __LLBC_NS_BEGIN
 
 LLBC_PacketHeaderDesc *LLBC_PacketHeaderDescAccessor::_headerDesc = NULL;
+bool LLBC_PacketHeaderDescAccessor::_fixedLayout = false;
 
 const LLBC_PacketHeaderDesc *LLBC_PacketHeaderDescAccessor::GetHeaderDesc(bool tryCreate)
 {
     if (UNLIKELY(!_headerDesc))
+    {
         if (tryCreate)
+        {
             _headerDesc = LLBC_LibPacketHeaderDescFactory().Create();
+            UpdateFixedLayout();
+        }
+    }
 
     return _headerDesc;
 }
@@ -39,13 +46,29 @@ int LLBC_PacketHeaderDescAccessor::SetPacketDesc(LLBC_PacketHeaderDesc *headerDe
     }
 
     _headerDesc = headerDesc;
+    UpdateFixedLayout();
 
     return LLBC_OK;
 }
 
+bool LLBC_PacketHeaderDescAccessor::IsFixedLayout()
+{
+    return _fixedLayout;
+}
+
 void LLBC_PacketHeaderDescAccessor::CleanupHeaderDesc()
 {
     LLBC_XDelete(_headerDesc);
+    _fixedLayout = false;
+}
+
+void LLBC_PacketHeaderDescAccessor::UpdateFixedLayout()
+{
+#if LLBC_CFG_COMM_USE_FIXED_PACKET_HEADER_LAYOUT
+    _fixedLayout = _headerDesc && LLBC_FixedPacketHeaderLayout::IsMatch(*_headerDesc);
+#else // !LLBC_CFG_COMM_USE_FIXED_PACKET_HEADER_LAYOUT
+    _fixedLayout = false;
+#endif // LLBC_CFG_COMM_USE_FIXED_PACKET_HEADER_LAYOUT
 }
 
 __LLBC_NS_END
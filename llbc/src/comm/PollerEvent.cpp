@@ -13,127 +13,150 @@
 #include "llbc/comm/Packet.h"
 #include "llbc/comm/Socket.h"
 #include "llbc/comm/Session.h"
+#include "llbc/comm/SharedBuffer.h"
+#include "llbc/comm/EventPool.h"
 #include "llbc/comm/PollerEvent.h"
 
 namespace
 {
     typedef LLBC_NS LLBC_PollerEvent _Ev;
-    typedef LLBC_NS LLBC_MessageBlock _Block;
 
     typedef LLBC_NS LLBC_PollerEvUtil This;
 }
 
 __LLBC_NS_BEGIN
 
-LLBC_MessageBlock *LLBC_PollerEvUtil::BuildAddSockEv(int sessionId, LLBC_Socket *sock)
+void *LLBC_PollerEvent::operator new(size_t size)
 {
-    _Block *block = LLBC_New1(_Block, sizeof(_Ev));
-    _Ev &ev = *reinterpret_cast<_Ev *>(block->GetData());
-    ev.type = _Ev::AddSock;
-    ev.un.socket = sock;
-    ev.sessionId = sessionId;
-
-    block->SetWritePos(sizeof(_Ev));
-    return block;
+    return LLBC_EventPool::Alloc(size);
 }
 
-LLBC_MessageBlock *LLBC_PollerEvUtil::BuildAsyncConnEv(int sessionId, const LLBC_SockAddr_IN &peerAddr)
+void LLBC_PollerEvent::operator delete(void *ev, size_t size)
 {
-    _Block *block = LLBC_New1(_Block, sizeof(_Ev));
-    _Ev &ev = *reinterpret_cast<_Ev *>(block->GetData());
-    ev.type = _Ev::AsyncConn;
-    ev.sessionId = sessionId;
-    ev.peerAddr = peerAddr;
-
-    block->SetWritePos(sizeof(_Ev));
-    return block;
+    LLBC_EventPool::Free(ev, size);
 }
 
-LLBC_MessageBlock *LLBC_PollerEvUtil::BuildSendEv(LLBC_Packet *packet)
+LLBC_PollerEvent *LLBC_PollerEvUtil::BuildAddSockEv(int sessionId, LLBC_Socket *sock)
 {
-    _Block *block = LLBC_New1(_Block, sizeof(_Ev));
-    _Ev &ev = *reinterpret_cast<_Ev *>(block->GetData());
-    ev.type = _Ev::Send;
-    ev.un.packet = packet;
+    _Ev *ev = LLBC_New(_Ev);
+    ev->type = _Ev::AddSock;
+    ev->un.socket = sock;
+    ev->sessionId = sessionId;
 
-    block->SetWritePos(sizeof(_Ev));
-    return block;
+    return ev;
 }
 
-LLBC_MessageBlock *LLBC_PollerEvUtil::BuildCloseEv(int sessionId, const char *reason)
+LLBC_PollerEvent *LLBC_PollerEvUtil::BuildAsyncConnEv(int sessionId, const LLBC_SockAddr_IN &peerAddr)
 {
-    _Block *block = LLBC_New1(_Block, sizeof(_Ev));
-    _Ev &ev = *reinterpret_cast<_Ev *>(block->GetData());
-    ev.type = _Ev::Close;
-    ev.sessionId = sessionId;
+    _Ev *ev = LLBC_New(_Ev);
+    ev->type = _Ev::AsyncConn;
+    ev->sessionId = sessionId;
+    ev->peerAddr = peerAddr;
+
+    return ev;
+}
+
+LLBC_PollerEvent *LLBC_PollerEvUtil::BuildSendEv(LLBC_Packet *packet)
+{
+    _Ev *ev = LLBC_New(_Ev);
+    ev->type = _Ev::Send;
+    ev->un.packet = packet;
+
+    return ev;
+}
+
+LLBC_PollerEvent *LLBC_PollerEvUtil::BuildCloseEv(int sessionId, const char *reason)
+{
+    _Ev *ev = LLBC_New(_Ev);
+    ev->type = _Ev::Close;
+    ev->sessionId = sessionId;
 
     if (reason != NULL)
     {
-        ev.un.closeReason = LLBC_Malloc(char, LLBC_StrLenA(reason) + 1);
-        LLBC_StrCpyA(ev.un.closeReason, reason);
+        ev->un.closeReason = LLBC_Malloc(char, LLBC_StrLenA(reason) + 1);
+        LLBC_StrCpyA(ev->un.closeReason, reason);
     }
     else
     {
-        ev.un.closeReason = NULL;
+        ev->un.closeReason = NULL;
     }
 
-    block->SetWritePos(sizeof(_Ev));
-    return block;
+    return ev;
 }
 
 #if LLBC_TARGET_PLATFORM_WIN32
-LLBC_MessageBlock *LLBC_PollerEvUtil::BuildIocpMonitorEv(int ret, 
-                                                         LLBC_POverlapped ol, 
-                                                         int errNo, 
-                                                         int subErrNo)
+LLBC_PollerEvent *LLBC_PollerEvUtil::BuildIocpMonitorEv(int ret, 
+                                                        LLBC_POverlapped ol, 
+                                                        int errNo, 
+                                                        int subErrNo)
 {
-    _Block *block = LLBC_New1(_Block, sizeof(_Ev));
-    _Ev &ev = *reinterpret_cast<_Ev *>(block->GetData());
-    ev.type = _Ev::Monitor;
-    ev.un.monitorEv = LLBC_Malloc(char, sizeof(int) + sizeof(LLBC_POverlapped) + sizeof(int) * 2);
+    _Ev *ev = LLBC_New(_Ev);
+    ev->type = _Ev::Monitor;
+    ev->un.monitorEv = LLBC_Malloc(char, sizeof(int) + sizeof(LLBC_POverlapped) + sizeof(int) * 2);
 
     size_t off = 0;
     // Wait return value.
-    ::memcpy(ev.un.monitorEv, &ret, sizeof(int)), off += sizeof(int);
+    ::memcpy(ev->un.monitorEv, &ret, sizeof(int)), off += sizeof(int);
     // Overlapped data.
-    ::memcpy(ev.un.monitorEv + off, &ol, sizeof(LLBC_POverlapped)), off += sizeof(LLBC_POverlapped);
+    ::memcpy(ev->un.monitorEv + off, &ol, sizeof(LLBC_POverlapped)), off += sizeof(LLBC_POverlapped);
     // Error no.
-    ::memcpy(ev.un.monitorEv + off, &errNo, sizeof(int)), off += sizeof(int);
+    ::memcpy(ev->un.monitorEv + off, &errNo, sizeof(int)), off += sizeof(int);
     // Sub error no.
-    ::memcpy(ev.un.monitorEv + off, &subErrNo, sizeof(int));
+    ::memcpy(ev->un.monitorEv + off, &subErrNo, sizeof(int));
 
-    block->SetWritePos(sizeof(_Ev));
-    return block;
+    return ev;
 }
 #endif // LLBC_TARGET_PLATFORM_WIN32
 
-#if LLBC_TARGET_PLATFORM_LINUX || LLBC_TARGET_PLATFORM_ANDROID
-LLBC_MessageBlock *LLBC_PollerEvUtil::BuildEpollMonitorEv(const LLBC_EpollEvent *evs, int count)
+LLBC_PollerEvent *LLBC_PollerEvUtil::BuildTakeOverSessionEv(LLBC_Session *session)
+{
+    _Ev *ev = LLBC_New(_Ev);
+    ev->type = _Ev::TakeOverSession;
+    ev->un.session = session;
+
+    return ev;
+}
+
+LLBC_PollerEvent *LLBC_PollerEvUtil::BuildFlushSendEv()
 {
-    _Block *block = LLBC_New1(_Block, sizeof(_Ev));
-    _Ev &ev = *reinterpret_cast<_Ev *>(block->GetData());
-    ev.type = _Ev::Monitor;
-    ev.un.monitorEv = LLBC_Malloc(char, sizeof(int) + sizeof(LLBC_EpollEvent) * count);
+    _Ev *ev = LLBC_New(_Ev);
+    ev->type = _Ev::FlushSend;
 
+    return ev;
+}
+
+LLBC_PollerEvent *LLBC_PollerEvUtil::BuildMulticastEv(LLBC_SharedBuffer *buffer, int opcode, const int *sessionIds, int count)
+{
+    _Ev *ev = LLBC_New(_Ev);
+    ev->type = _Ev::Multicast;
+    ev->un.multicastEv = LLBC_Malloc(char, sizeof(LLBC_SharedBuffer *) + sizeof(int) * 2 + sizeof(int) * count);
+
+    // Write shared buffer.
+    buffer->Retain();
+    size_t off = 0;
+    ::memcpy(ev->un.multicastEv, &buffer, sizeof(LLBC_SharedBuffer *)), off += sizeof(LLBC_SharedBuffer *);
+    // Write opcode.
+    ::memcpy(ev->un.multicastEv + off, &opcode, sizeof(int)), off += sizeof(int);
     // Write count.
-    ::memcpy(ev.un.monitorEv, &count, sizeof(int));
-    // Write events.
-    ::memcpy(ev.un.monitorEv + sizeof(int), evs, sizeof(LLBC_EpollEvent) * count);
+    ::memcpy(ev->un.multicastEv + off, &count, sizeof(int)), off += sizeof(int);
+    // Write session Ids.
+    ::memcpy(ev->un.multicastEv + off, sessionIds, sizeof(int) * count);
 
-    block->SetWritePos(sizeof(_Ev));
-    return block;
+    return ev;
 }
-#endif // LLBC_TARGET_PLATFORM_LINUX || LLBC_TARGET_PLATFORM_ANDROID
 
-LLBC_MessageBlock *LLBC_PollerEvUtil::BuildTakeOverSessionEv(LLBC_Session *session)
+LLBC_PollerEvent *LLBC_PollerEvUtil::BuildSendBatchEv(LLBC_Packet * const *packets, int count)
 {
-    _Block *block = LLBC_New1(_Block, sizeof(_Ev));
-    _Ev &ev = *reinterpret_cast<_Ev *>(block->GetData());
-    ev.type = _Ev::TakeOverSession;
-    ev.un.session = session;
+    _Ev *ev = LLBC_New(_Ev);
+    ev->type = _Ev::SendBatch;
+    ev->un.sendBatchEv = LLBC_Malloc(char, sizeof(int) + sizeof(LLBC_Packet *) * count);
+
+    // Write count.
+    ::memcpy(ev->un.sendBatchEv, &count, sizeof(int));
+    // Write packets.
+    ::memcpy(ev->un.sendBatchEv + sizeof(int), packets, sizeof(LLBC_Packet *) * count);
 
-    block->SetWritePos(sizeof(_Ev));
-    return block;
+    return ev;
 }
 
 void LLBC_PollerEvUtil::DestroyEv(LLBC_PollerEvent &ev)
@@ -160,17 +183,35 @@ void LLBC_PollerEvUtil::DestroyEv(LLBC_PollerEvent &ev)
         LLBC_Delete(ev.un.session);
         break;
 
+    case _Ev::Multicast:
+        (*reinterpret_cast<LLBC_SharedBuffer **>(ev.un.multicastEv))->Release();
+        LLBC_XFree(ev.un.multicastEv);
+        break;
+
+    case _Ev::SendBatch:
+        {
+            int count;
+            ::memcpy(&count, ev.un.sendBatchEv, sizeof(int));
+            for (int i = 0; i < count; i++)
+            {
+                LLBC_Packet *packet;
+                ::memcpy(&packet, ev.un.sendBatchEv + sizeof(int) + sizeof(LLBC_Packet *) * i, sizeof(LLBC_Packet *));
+                LLBC_Delete(packet);
+            }
+
+            LLBC_XFree(ev.un.sendBatchEv);
+        }
+        break;
+
     default:
         break;
     }
 }
 
-void LLBC_PollerEvUtil::DestroyEv(LLBC_MessageBlock *block)
+void LLBC_PollerEvUtil::DestroyEv(LLBC_PollerEvent *ev)
 {
-    _Ev &ev = *reinterpret_cast<_Ev *>(block->GetData());
-    This::DestroyEv(ev);
-
-    LLBC_Delete(block);
+    This::DestroyEv(*ev);
+    LLBC_Delete(ev);
 }
 
 __LLBC_NS_END
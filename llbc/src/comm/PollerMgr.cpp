@@ -13,8 +13,10 @@
 #include "llbc/comm/Packet.h"
 #include "llbc/comm/Socket.h"
 #include "llbc/comm/PollerType.h"
+#include "llbc/comm/BackpressurePolicy.h"
 #include "llbc/comm/PollerEvent.h"
 #include "llbc/comm/BasePoller.h"
+#include "llbc/comm/IoUringPoller.h"
 #include "llbc/comm/PollerMgr.h"
 
 namespace
@@ -40,6 +42,30 @@ static LLBC_NS LLBC_Socket *__CreateSocket(int type)
     return sock;
 }
 
+static LLBC_NS LLBC_Socket *__CreateUdpSocket(int type)
+{
+    LLBC_NS LLBC_SocketHandle handle = LLBC_NS LLBC_CreateUdpSocket();
+    if (UNLIKELY(handle == LLBC_INVALID_SOCKET_HANDLE))
+        return NULL;
+
+    LLBC_NS LLBC_Socket *sock =
+        LLBC_New1(LLBC_NS LLBC_Socket, handle);
+    sock->SetPollerType(type);
+
+    return sock;
+}
+
+// Reliable udp session only support readiness based pollers.
+static bool __IsReliableUdpSupported(int type)
+{
+    if (type == LLBC_NS LLBC_PollerType::SelectPoller ||
+        type == LLBC_NS LLBC_PollerType::EpollPoller)
+        return true;
+
+    LLBC_NS LLBC_SetLastError(LLBC_ERROR_NOT_IMPL);
+    return false;
+}
+
 __LLBC_INTERNAL_NS_END
 
 __LLBC_NS_BEGIN
@@ -49,10 +75,17 @@ LLBC_PollerMgr::LLBC_PollerMgr()
 , _svc(NULL)
 
 , _pollerCount(0)
+, _recvBudget(LLBC_CFG_COMM_DFT_RECV_BUDGET)
+, _sendLowWaterMark(LLBC_CFG_COMM_DFT_SEND_LOW_WATER_MARK)
+, _sendHighWaterMark(LLBC_CFG_COMM_DFT_SEND_HIGH_WATER_MARK)
+, _backpressurePolicy(LLBC_BackpressurePolicy::None)
+, _opcodeBackpressurePolicies()
+, _rudpOpts()
 , _pollers(NULL)
 , _pollerLock()
 
 , _maxSessionId(1)
+, _sessionStats(LLBC_CFG_COMM_SESSION_TABLE_SIZE, _SessionStatIdx::End)
 
 , _pendingAddSocks()
 , _pendingAsyncConns()
@@ -66,14 +99,54 @@ LLBC_PollerMgr::~LLBC_PollerMgr()
 
 void LLBC_PollerMgr::SetPollerType(int type)
 {
+    // If kernel not support io_uring poller, fallback to epoll poller.
+#if LLBC_TARGET_PLATFORM_LINUX
+    if (type == LLBC_PollerType::IoUringPoller && !LLBC_IoUringPoller::IsSupported())
+    {
+        trace("LLBC_PollerMgr::SetPollerType() kernel not support io_uring poller, fallback to epoll poller\n");
+        type = LLBC_PollerType::EpollPoller;
+    }
+#endif // LLBC_TARGET_PLATFORM_LINUX
+
     _type = type;
 }
 
+int LLBC_PollerMgr::GetPollerType() const
+{
+    return _type;
+}
+
 void LLBC_PollerMgr::SetService(LLBC_IService *svc)
 {
     _svc = svc;
 }
 
+void LLBC_PollerMgr::SetRecvBudget(size_t budget)
+{
+    _recvBudget = budget;
+}
+
+void LLBC_PollerMgr::SetSendWaterMarks(size_t lowWaterMark, size_t highWaterMark)
+{
+    _sendLowWaterMark = lowWaterMark;
+    _sendHighWaterMark = highWaterMark;
+}
+
+void LLBC_PollerMgr::SetBackpressurePolicy(int policy)
+{
+    _backpressurePolicy = policy;
+}
+
+void LLBC_PollerMgr::SetOpcodeBackpressurePolicy(int opcode, int policy)
+{
+    _opcodeBackpressurePolicies[opcode] = policy;
+}
+
+void LLBC_PollerMgr::SetReliableUdpOptions(const LLBC_ReliableUdpOptions &opts)
+{
+    _rudpOpts = opts;
+}
+
 int LLBC_PollerMgr::Start(int count)
 {
     if (count <= 0)
@@ -99,6 +172,10 @@ int LLBC_PollerMgr::Start(int count)
         _pollers[i]->SetService(_svc);
         _pollers[i]->SetPollerMgr(this);
         _pollers[i]->SetBrothersCount(count);
+        _pollers[i]->SetRecvBudget(_recvBudget);
+        _pollers[i]->SetSendWaterMarks(_sendLowWaterMark, _sendHighWaterMark);
+        _pollers[i]->SetBackpressurePolicies(_backpressurePolicy, _opcodeBackpressurePolicies);
+        _pollers[i]->SetReliableUdpOptions(_rudpOpts);
     }
 
     // Startup all pollers.
@@ -140,6 +217,7 @@ void LLBC_PollerMgr::Stop()
     }
 
     _maxSessionId = 1;
+    _sessionStats.Clear();
 }
 
 int LLBC_PollerMgr::Listen(const char *ip, uint16 port)
@@ -172,6 +250,52 @@ int LLBC_PollerMgr::Listen(const char *ip, uint16 port)
     return sessionId;
 }
 
+int LLBC_PollerMgr::ListenReusePort(const char *ip, uint16 port, LLBC_SessionIdList &sessionIds)
+{
+    if (UNLIKELY(!_pollers))
+    {
+        LLBC_SetLastError(LLBC_ERROR_NOT_INIT);
+        return LLBC_FAILED;
+    }
+
+    LLBC_SockAddr_IN local;
+    if (This::GetAddr(ip, port, local) != LLBC_OK)
+        return LLBC_FAILED;
+
+    // Create all pollers listen sockets first, if any one failed, delete all.
+    std::vector<LLBC_Socket *> socks;
+    for (int i = 0; i < _pollerCount; i++)
+    {
+        LLBC_Socket *sock;
+        if (!(sock = LLBC_INL_NS __CreateSocket(_type)))
+        {
+            LLBC_STLHelper::DeleteContainer(socks);
+            return LLBC_FAILED;
+        }
+
+        socks.push_back(sock);
+        if (sock->SetNonBlocking() != LLBC_OK ||
+                sock->EnableAddressReusable() != LLBC_OK ||
+                sock->EnablePortReusable() != LLBC_OK ||
+                sock->BindTo(local) != LLBC_OK ||
+                sock->Listen() != LLBC_OK)
+        {
+            LLBC_STLHelper::DeleteContainer(socks);
+            return LLBC_FAILED;
+        }
+    }
+
+    for (int i = 0; i < _pollerCount; i++)
+    {
+        const int sessionId = AllocSessionId(i);
+        _pollers[i]->Push(LLBC_PollerEvUtil::BuildAddSockEv(sessionId, socks[i]));
+
+        sessionIds.push_back(sessionId);
+    }
+
+    return LLBC_OK;
+}
+
 int LLBC_PollerMgr::Connect(const char *ip, uint16 port)
 {
     LLBC_SockAddr_IN peer;
@@ -202,6 +326,79 @@ int LLBC_PollerMgr::Connect(const char *ip, uint16 port)
     return sessionId;
 }
 
+int LLBC_PollerMgr::ListenReliableUdp(const char *ip, uint16 port)
+{
+    if (!LLBC_INL_NS __IsReliableUdpSupported(_type))
+        return 0;
+
+    LLBC_SockAddr_IN local;
+    if (This::GetAddr(ip, port, local) != LLBC_OK)
+        return 0;
+
+    // The peer sessions sockets will bind to same local address and connect to peer,
+    // so listen socket must enable address & port reusable.
+    LLBC_Socket *sock;
+    if (!(sock = LLBC_INL_NS __CreateUdpSocket(_type)))
+    {
+        return 0;
+    }
+    else if (sock->SetNonBlocking() != LLBC_OK ||
+            sock->EnableAddressReusable() != LLBC_OK ||
+            sock->EnablePortReusable() != LLBC_OK ||
+            sock->BindTo(local) != LLBC_OK)
+    {
+        LLBC_Delete(sock);
+        return 0;
+    }
+
+    sock->ReliableUdpListen();
+
+    const int sessionId = AllocSessionId();
+    if (LIKELY(_pollers))
+        _pollers[sessionId % _pollerCount]->Push(
+                LLBC_PollerEvUtil::BuildAddSockEv(sessionId, sock));
+    else
+        _pendingAddSocks.insert(std::make_pair(sessionId, sock));
+
+    return sessionId;
+}
+
+int LLBC_PollerMgr::ConnectReliableUdp(const char *ip, uint16 port)
+{
+    if (!LLBC_INL_NS __IsReliableUdpSupported(_type))
+        return 0;
+
+    LLBC_SockAddr_IN peer;
+    if (This::GetAddr(ip, port, peer) != LLBC_OK)
+        return 0;
+
+    LLBC_Socket *sock;
+    if (!(sock = LLBC_INL_NS __CreateUdpSocket(_type)))
+    {
+        return 0;
+    }
+    else if (sock->Connect(peer) != LLBC_OK ||
+            sock->SetNonBlocking() != LLBC_OK)
+    {
+        LLBC_Delete(sock);
+        return 0;
+    }
+
+    // Udp connect not handshake, the open marker will be sent when session added to poller.
+    uint32 conv;
+    while ((conv = LLBC_Random::RandInt32()) == 0);
+    sock->EnableReliableUdp(conv, _rudpOpts, true);
+
+    const int sessionId = AllocSessionId();
+    if (LIKELY(_pollers))
+        _pollers[sessionId % _pollerCount]->Push(
+                LLBC_PollerEvUtil::BuildAddSockEv(sessionId, sock));
+    else
+        _pendingAddSocks.insert(std::make_pair(sessionId, sock));
+
+    return sessionId;
+}
+
 int LLBC_PollerMgr::AsyncConn(const char *ip, uint16 port)
 {
     LLBC_SockAddr_IN peer;
@@ -221,7 +418,61 @@ int LLBC_PollerMgr::AsyncConn(const char *ip, uint16 port)
 int LLBC_PollerMgr::Send(LLBC_Packet *packet)
 {
     _pollers[packet->GetSessionId() % 
-        _pollerCount]->Push(LLBC_PollerEvUtil::BuildSendEv(packet));
+        _pollerCount]->PushSend(LLBC_PollerEvUtil::BuildSendEv(packet));
+    return LLBC_OK;
+}
+
+int LLBC_PollerMgr::Multicast(LLBC_SharedBuffer *buffer, int opcode, const LLBC_SessionIdList &sessionIds)
+{
+    if (sessionIds.empty())
+        return LLBC_OK;
+
+    if (_pollerCount == 1)
+    {
+        _pollers[0]->PushSend(LLBC_PollerEvUtil::BuildMulticastEv(
+            buffer, opcode, &sessionIds[0], static_cast<int>(sessionIds.size())));
+        return LLBC_OK;
+    }
+
+    std::vector<LLBC_SessionIdList> pollerSessionIds(_pollerCount);
+    for (size_t i = 0; i < sessionIds.size(); i++)
+        pollerSessionIds[sessionIds[i] % _pollerCount].push_back(sessionIds[i]);
+
+    for (int i = 0; i < _pollerCount; i++)
+    {
+        const LLBC_SessionIdList &ids = pollerSessionIds[i];
+        if (!ids.empty())
+            _pollers[i]->PushSend(LLBC_PollerEvUtil::BuildMulticastEv(
+                buffer, opcode, &ids[0], static_cast<int>(ids.size())));
+    }
+
+    return LLBC_OK;
+}
+
+int LLBC_PollerMgr::SendBatch(const std::vector<LLBC_Packet *> &packets)
+{
+    if (packets.empty())
+        return LLBC_OK;
+
+    if (_pollerCount == 1)
+    {
+        _pollers[0]->PushSend(LLBC_PollerEvUtil::BuildSendBatchEv(
+            &packets[0], static_cast<int>(packets.size())));
+        return LLBC_OK;
+    }
+
+    std::vector<std::vector<LLBC_Packet *> > pollerPackets(_pollerCount);
+    for (size_t i = 0; i < packets.size(); i++)
+        pollerPackets[packets[i]->GetSessionId() % _pollerCount].push_back(packets[i]);
+
+    for (int i = 0; i < _pollerCount; i++)
+    {
+        const std::vector<LLBC_Packet *> &batch = pollerPackets[i];
+        if (!batch.empty())
+            _pollers[i]->PushSend(LLBC_PollerEvUtil::BuildSendBatchEv(
+                &batch[0], static_cast<int>(batch.size())));
+    }
+
     return LLBC_OK;
 }
 
@@ -230,18 +481,75 @@ void LLBC_PollerMgr::Close(int sessionId, const char *reason)
     _pollers[sessionId % _pollerCount]->Push(LLBC_PollerEvUtil::BuildCloseEv(sessionId, reason));
 }
 
+void LLBC_PollerMgr::GetSendStat(LLBC_SendStat &stat)
+{
+    LLBC_Guard guard(_pollerLock);
+    for (int i = 0; i < _pollerCount; i++)
+    {
+        if (_pollers[i])
+            _pollers[i]->GetSendStat(stat);
+    }
+}
+
+void LLBC_PollerMgr::GetRecvStat(LLBC_RecvStat &stat)
+{
+    LLBC_Guard guard(_pollerLock);
+    for (int i = 0; i < _pollerCount; i++)
+    {
+        if (_pollers[i])
+            _pollers[i]->GetRecvStat(stat);
+    }
+}
+
+int LLBC_PollerMgr::GetSendQueueSize(int sessionId, size_t &queueSize) const
+{
+    sint64 value;
+    if (_sessionStats.GetValue(sessionId, value, _SessionStatIdx::SendQueueSize) != LLBC_OK)
+        return LLBC_FAILED;
+
+    queueSize = static_cast<size_t>(value);
+
+    return LLBC_OK;
+}
+
+int LLBC_PollerMgr::GetSessionRecvStat(int sessionId, LLBC_RecvStat &stat) const
+{
+    sint64 values[_SessionStatIdx::End];
+    if (_sessionStats.GetValues(sessionId, values) != LLBC_OK)
+        return LLBC_FAILED;
+
+    stat.recvEvents = static_cast<uint64>(values[_SessionStatIdx::RecvEvents]);
+    stat.recvCalls = static_cast<uint64>(values[_SessionStatIdx::RecvCalls]);
+    stat.recvBytes = static_cast<uint64>(values[_SessionStatIdx::RecvBytes]);
+    stat.budgetExhausts = static_cast<uint64>(values[_SessionStatIdx::RecvBudgetExhausts]);
+
+    return LLBC_OK;
+}
+
 int LLBC_PollerMgr::AllocSessionId()
 {
     return LLBC_AtomicFetchAndAdd(&_maxSessionId, 1);
 }
 
-int LLBC_PollerMgr::PushMsgToPoller(int id, LLBC_MessageBlock *block)
+int LLBC_PollerMgr::AllocSessionId(int pollerId)
+{
+    // Skip to the first session Id which belong to given poller, the skipped Ids never be used.
+    for (; ;)
+    {
+        const int curId = LLBC_AtomicGet(&_maxSessionId);
+        const int sessionId = curId + (pollerId - curId % _pollerCount + _pollerCount) % _pollerCount;
+        if (LLBC_AtomicCompareAndExchange(&_maxSessionId, sessionId + 1, curId) == curId)
+            return sessionId;
+    }
+}
+
+int LLBC_PollerMgr::PushMsgToPoller(int id, LLBC_PollerEvent *ev)
 {
     LLBC_Guard guard(_pollerLock);
     LLBC_BasePoller *poller = _pollers[id];
     if (LIKELY(poller))
     {
-        poller->Push(block);
+        poller->Push(ev);
         return LLBC_OK;
     }
     
@@ -26,6 +26,9 @@ static const LLBC_NS LLBC_String __g_descs[] =
     "IocpPoller",
 #elif LLBC_TARGET_PLATFORM_LINUX || LLBC_TARGET_PLATFORM_ANDROID
     "EpollPoller",
+ #if LLBC_TARGET_PLATFORM_LINUX
+    "IoUringPoller",
+ #endif // LLBC_TARGET_PLATFORM_LINUX
 #endif // LLBC_TARGET_PLATFORM_WIN32
 
     "Invalid"
@@ -0,0 +1,142 @@
+/**
+ * @file    RecvSlab.cpp
+ * @author  Longwei Lai<lailongwei@126.com>
+ * @date    2026/10/18
+ * @version 1.0
+ *
+ * @brief
+ */
+
+#include "llbc/common/Export.h"
+#include "llbc/common/BeforeIncl.h"
+
+#include "llbc/comm/RecvSlab.h"
+
+__LLBC_NS_BEGIN
+
+LLBC_RecvSlab::LLBC_RecvSlab(LLBC_RecvSlabPool *pool, size_t size)
+: _pool(pool)
+, _refCount(0)
+
+, _buf(LLBC_Malloc(char, size))
+, _size(size)
+, _writePos(0)
+{
+}
+
+LLBC_RecvSlab::~LLBC_RecvSlab()
+{
+    LLBC_Free(_buf);
+}
+
+LLBC_RecvSlabPool::LLBC_RecvSlabPool(size_t slabSize, size_t minRecvSize, size_t maxRecycledNum)
+: _slabSize(slabSize)
+, _minRecvSize(MIN(minRecvSize, slabSize))
+, _maxRecycledNum(maxRecycledNum)
+
+, _refCount(1)
+, _current(NULL)
+
+, _lock()
+, _recycled()
+{
+}
+
+LLBC_RecvSlabPool::~LLBC_RecvSlabPool()
+{
+    for (size_t i = 0; i < _recycled.size(); i++)
+        LLBC_Delete(_recycled[i]);
+}
+
+LLBC_RecvSlab *LLBC_RecvSlabPool::GetCurrent()
+{
+    return GetCurrent(_minRecvSize);
+}
+
+LLBC_RecvSlab *LLBC_RecvSlabPool::GetCurrent(size_t minWritable)
+{
+    minWritable = MIN(MAX(minWritable, static_cast<size_t>(1)), _slabSize);
+    if (LIKELY(_current && _current->GetWritableSize() >= minWritable))
+        return _current;
+
+    // Release the exhausted slab, the packets which reference it will hold it until destroyed.
+    if (_current)
+        _current->Release();
+
+    // Pool hold current slab reference.
+    _current = Acquire();
+
+    return _current;
+}
+
+LLBC_RecvSlab *LLBC_RecvSlabPool::Acquire()
+{
+    LLBC_RecvSlab *slab = NULL;
+    _lock.Lock();
+    if (!_recycled.empty())
+    {
+        slab = _recycled.back();
+        _recycled.pop_back();
+    }
+    _lock.Unlock();
+
+    if (!slab)
+        slab = LLBC_New2(LLBC_RecvSlab, this, _slabSize);
+
+    // Every in-use slab hold one pool reference.
+    LLBC_AtomicFetchAndAdd(&_refCount, 1);
+    slab->_writePos = 0;
+    slab->Retain();
+
+    return slab;
+}
+
+void LLBC_RecvSlabPool::Destroy()
+{
+    if (_current)
+    {
+        _current->Release();
+        _current = NULL;
+    }
+
+    ReleaseRef();
+}
+
+void LLBC_RecvSlabPool::Recycle(LLBC_RecvSlab *slab)
+{
+    _lock.Lock();
+    if (_recycled.size() < _maxRecycledNum)
+    {
+        _recycled.push_back(slab);
+        slab = NULL;
+    }
+    _lock.Unlock();
+
+    if (slab)
+        LLBC_Delete(slab);
+
+    ReleaseRef();
+}
+
+void LLBC_RecvSlabPool::ReleaseRef()
+{
+    if (LLBC_AtomicFetchAndSub(&_refCount, 1) == 1)
+        delete this;
+}
+
+LLBC_RecvSlabBlock::LLBC_RecvSlabBlock(LLBC_RecvSlab *slab, void *data, size_t len)
+: LLBC_MessageBlock(data, len)
+, _slab(slab)
+{
+    SetWritePos(len);
+    _slab->Retain();
+}
+
+LLBC_RecvSlabBlock::~LLBC_RecvSlabBlock()
+{
+    _slab->Release();
+}
+
+__LLBC_NS_END
+
+#include "llbc/common/AfterIncl.h"
@@ -0,0 +1,63 @@
+/**
+ * @file    RecvStat.cpp
+ * @author  Longwei Lai<lailongwei@126.com>
+ * @date    2026/10/18
+ * @version 1.0
+ *
+ * @brief
+ */
+
+#include "llbc/common/Export.h"
+#include "llbc/common/BeforeIncl.h"
+
+#include "llbc/comm/RecvStat.h"
+
+__LLBC_NS_BEGIN
+
+LLBC_RecvStat::LLBC_RecvStat()
+: recvEvents(0)
+, recvCalls(0)
+, recvBytes(0)
+, budgetExhausts(0)
+{
+}
+
+void LLBC_RecvStat::Reset()
+{
+    recvEvents = 0;
+    recvCalls = 0;
+    recvBytes = 0;
+    budgetExhausts = 0;
+}
+
+double LLBC_RecvStat::GetBytesPerEvent() const
+{
+    return recvEvents != 0 ? static_cast<double>(recvBytes) / recvEvents : 0.0;
+}
+
+double LLBC_RecvStat::GetBytesPerCall() const
+{
+    return recvCalls != 0 ? static_cast<double>(recvBytes) / recvCalls : 0.0;
+}
+
+LLBC_RecvStat &LLBC_RecvStat::operator +=(const LLBC_RecvStat &other)
+{
+    recvEvents += other.recvEvents;
+    recvCalls += other.recvCalls;
+    recvBytes += other.recvBytes;
+    budgetExhausts += other.budgetExhausts;
+
+    return *this;
+}
+
+LLBC_String LLBC_RecvStat::ToString() const
+{
+    return LLBC_String().format("recvEvents: %llu, recvCalls: %llu, recvBytes: %llu, budgetExhausts: %llu, "
+                                "bytes/event: %.2f, bytes/call: %.2f",
+                                recvEvents, recvCalls, recvBytes, budgetExhausts,
+                                GetBytesPerEvent(), GetBytesPerCall());
+}
+
+__LLBC_NS_END
+
+#include "llbc/common/AfterIncl.h"
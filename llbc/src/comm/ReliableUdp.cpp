@@ -0,0 +1,812 @@
+/**
+ * @file    ReliableUdp.cpp
+ * @author  Longwei Lai<lailongwei@126.com>
+ * @date    2026/10/18
+ * @version 1.0
+ *
+ * @brief
+ */
+
+#include "llbc/common/Export.h"
+#include "llbc/common/BeforeIncl.h"
+
+#include "llbc/comm/ReliableUdp.h"
+
+__LLBC_INTERNAL_NS_BEGIN
+
+// The max retransmission timeout(in milli-seconds).
+const LLBC_NS sint32 __maxRto = 60000;
+// The window probe init/max wait time(in milli-seconds).
+const LLBC_NS uint32 __probeInitWait = 7000;
+const LLBC_NS uint32 __probeMaxWait = 120000;
+
+// The probe flags.
+const int __probeAskSend = 0x01;
+const int __probeAskTell = 0x02;
+
+inline LLBC_NS sint32 __TimeDiff(LLBC_NS uint32 later, LLBC_NS uint32 earlier)
+{
+    return static_cast<LLBC_NS sint32>(later - earlier);
+}
+
+inline char *__Encode8(char *ptr, LLBC_NS uint32 val)
+{
+    *ptr++ = static_cast<char>(val & 0xff);
+    return ptr;
+}
+
+inline char *__Encode16(char *ptr, LLBC_NS uint32 val)
+{
+    ptr = __Encode8(ptr, val);
+    return __Encode8(ptr, val >> 8);
+}
+
+inline char *__Encode32(char *ptr, LLBC_NS uint32 val)
+{
+    ptr = __Encode16(ptr, val);
+    return __Encode16(ptr, val >> 16);
+}
+
+inline const char *__Decode8(const char *ptr, LLBC_NS uint32 &val)
+{
+    val = static_cast<LLBC_NS uint8>(*ptr++);
+    return ptr;
+}
+
+inline const char *__Decode16(const char *ptr, LLBC_NS uint32 &val)
+{
+    LLBC_NS uint32 high;
+    ptr = __Decode8(ptr, val);
+    ptr = __Decode8(ptr, high);
+    val |= high << 8;
+
+    return ptr;
+}
+
+inline const char *__Decode32(const char *ptr, LLBC_NS uint32 &val)
+{
+    LLBC_NS uint32 high;
+    ptr = __Decode16(ptr, val);
+    ptr = __Decode16(ptr, high);
+    val |= high << 16;
+
+    return ptr;
+}
+
+__LLBC_INTERNAL_NS_END
+
+__LLBC_NS_BEGIN
+
+const size_t LLBC_ReliableUdp::HeaderSize;
+
+char *LLBC_ReliableUdp::_Segment::Data()
+{
+    return reinterpret_cast<char *>(this + 1);
+}
+
+LLBC_ReliableUdp::LLBC_ReliableUdp(uint32 conv, LLBC_SocketHandle handle, const LLBC_ReliableUdpOptions &opts)
+: _conv(conv)
+, _handle(handle)
+, _opts(opts)
+, _mss(opts.mtu - static_cast<uint32>(HeaderSize))
+
+, _sndUna(0)
+, _sndNxt(0)
+, _rcvNxt(0)
+, _rmtWnd(opts.recvWnd)
+
+, _rxRttVal(0)
+, _rxSrtt(0)
+, _rxRto(MAX(static_cast<sint32>(opts.minRto), 1))
+
+, _current(Now())
+, _tsFlush(_current)
+, _tsLastRecv(_current)
+, _tsLastOutput(_current)
+
+, _probe(0)
+, _tsProbe(0)
+, _probeWait(0)
+
+, _peerClosed(false)
+, _dead(false)
+
+, _sndQueue()
+, _sndBuf()
+, _rcvQueue()
+, _rcvBuf()
+, _rcvQueueOffset(0)
+, _rcvQueueSize(0)
+, _waitSendSize(0)
+
+, _ackList()
+, _buf(LLBC_Malloc(char, opts.mtu))
+
+, _delayedDatagrams()
+
+, _sentDatagrams(0)
+, _sentBytes(0)
+, _retransmits(0)
+, _fastRetransmits(0)
+, _simulatedLosses(0)
+{
+}
+
+LLBC_ReliableUdp::~LLBC_ReliableUdp()
+{
+    DeleteSegments(_sndQueue);
+    DeleteSegments(_sndBuf);
+    DeleteSegments(_rcvQueue);
+    DeleteSegments(_rcvBuf);
+
+    LLBC_Free(_buf);
+}
+
+uint32 LLBC_ReliableUdp::GetConv() const
+{
+    return _conv;
+}
+
+bool LLBC_ReliableUdp::IsOpenDatagram(const char *data, size_t len, uint32 &conv)
+{
+    _Segment seg;
+    while (len >= HeaderSize)
+    {
+        data = DecodeSegment(data, seg);
+        len -= HeaderSize;
+        if (seg.conv == 0 || seg.len > len)
+            return false;
+
+        if (seg.cmd == CmdPush && seg.sn == 0)
+        {
+            conv = seg.conv;
+            return true;
+        }
+
+        data += seg.len;
+        len -= seg.len;
+    }
+
+    return false;
+}
+
+void LLBC_ReliableUdp::Send(const char *data, size_t len)
+{
+    // Open marker, an empty push segment.
+    if (len == 0)
+    {
+        _sndQueue.push_back(NewSegment(0));
+        return;
+    }
+
+    _waitSendSize += len;
+
+    // Stream mode, fill the last queued segment first.
+    if (!_sndQueue.empty())
+    {
+        _Segment *last = _sndQueue.back();
+        if (last->len < _mss)
+        {
+            const size_t fillLen = MIN(len, static_cast<size_t>(_mss - last->len));
+            ::memcpy(last->Data() + last->len, data, fillLen);
+            last->len += static_cast<uint32>(fillLen);
+
+            data += fillLen;
+            len -= fillLen;
+        }
+    }
+
+    while (len > 0)
+    {
+        const size_t segLen = MIN(len, static_cast<size_t>(_mss));
+        _Segment *seg = NewSegment(segLen);
+        ::memcpy(seg->Data(), data, segLen);
+
+        _sndQueue.push_back(seg);
+
+        data += segLen;
+        len -= segLen;
+    }
+}
+
+int LLBC_ReliableUdp::Input(const char *data, size_t len)
+{
+    if (len < HeaderSize)
+    {
+        LLBC_SetLastError(LLBC_ERROR_FORMAT);
+        return LLBC_FAILED;
+    }
+
+    _current = Now();
+    _tsLastRecv = _current;
+
+    bool hasAck = false;
+    uint32 maxAck = 0;
+    while (len >= HeaderSize)
+    {
+        _Segment seg;
+        data = DecodeSegment(data, seg);
+        len -= HeaderSize;
+        if (seg.conv != _conv || seg.len > len)
+        {
+            LLBC_SetLastError(LLBC_ERROR_FORMAT);
+            return LLBC_FAILED;
+        }
+
+        if (seg.cmd == CmdFin)
+        {
+            _peerClosed = true;
+            return LLBC_OK;
+        }
+        else if (seg.cmd < CmdPush || seg.cmd > CmdWndTell)
+        {
+            LLBC_SetLastError(LLBC_ERROR_FORMAT);
+            return LLBC_FAILED;
+        }
+
+        _rmtWnd = seg.wnd;
+        ParseUna(seg.una);
+        ShrinkBuf();
+
+        if (seg.cmd == CmdAck)
+        {
+            if (LLBC_INL_NS __TimeDiff(_current, seg.ts) >= 0)
+                UpdateAck(LLBC_INL_NS __TimeDiff(_current, seg.ts));
+
+            ParseAck(seg.sn);
+            ShrinkBuf();
+
+            if (!hasAck || LLBC_INL_NS __TimeDiff(seg.sn, maxAck) > 0)
+            {
+                hasAck = true;
+                maxAck = seg.sn;
+            }
+        }
+        else if (seg.cmd == CmdPush)
+        {
+            if (LLBC_INL_NS __TimeDiff(seg.sn, _rcvNxt + _opts.recvWnd) < 0)
+            {
+                // Selective ack, every push segment in window will be acked.
+                _ackList.push_back(std::make_pair(seg.sn, seg.ts));
+                if (LLBC_INL_NS __TimeDiff(seg.sn, _rcvNxt) >= 0)
+                {
+                    _Segment *newSeg = NewSegment(seg.len);
+                    *newSeg = seg;
+                    ::memcpy(newSeg->Data(), data, seg.len);
+
+                    ParseData(newSeg);
+                }
+            }
+        }
+        else if (seg.cmd == CmdWndAsk)
+        {
+            _probe |= LLBC_INL_NS __probeAskTell;
+        }
+
+        data += seg.len;
+        len -= seg.len;
+    }
+
+    if (hasAck)
+        ParseFastAck(maxAck);
+
+    return LLBC_OK;
+}
+
+size_t LLBC_ReliableUdp::GetRecvableSize() const
+{
+    return _rcvQueueSize - _rcvQueueOffset;
+}
+
+size_t LLBC_ReliableUdp::Recv(char *buf, size_t len)
+{
+    const bool recover = _rcvQueue.size() >= _opts.recvWnd;
+
+    size_t recved = 0;
+    while (recved < len && !_rcvQueue.empty())
+    {
+        _Segment *seg = _rcvQueue.front();
+        const size_t copyLen = MIN(len - recved, seg->len - _rcvQueueOffset);
+        ::memcpy(buf + recved, seg->Data() + _rcvQueueOffset, copyLen);
+
+        recved += copyLen;
+        _rcvQueueOffset += copyLen;
+        if (_rcvQueueOffset == seg->len)
+        {
+            _rcvQueue.pop_front();
+            _rcvQueueSize -= seg->len;
+            _rcvQueueOffset = 0;
+
+            DeleteSegment(seg);
+        }
+    }
+
+    // Move the segments blocked by full receive queue.
+    MoveRecvedSegments();
+
+    // If receive window was full, tell peer window size immediately.
+    if (recover && _rcvQueue.size() < _opts.recvWnd)
+        _probe |= LLBC_INL_NS __probeAskTell;
+
+    return recved;
+}
+
+void LLBC_ReliableUdp::Flush()
+{
+    _current = Now();
+
+    _Segment seg;
+    seg.conv = _conv;
+    seg.cmd = CmdAck;
+    seg.frg = 0;
+    seg.wnd = GetUnusedWnd();
+    seg.una = _rcvNxt;
+    seg.len = 0;
+    seg.sn = 0;
+    seg.ts = 0;
+
+    // Flush acks.
+    char *ptr = _buf;
+    for (size_t i = 0; i < _ackList.size(); i++)
+    {
+        if (static_cast<size_t>(ptr - _buf) + HeaderSize > _opts.mtu)
+        {
+            Output(_buf, ptr - _buf);
+            ptr = _buf;
+        }
+
+        seg.sn = _ackList[i].first;
+        seg.ts = _ackList[i].second;
+        ptr = EncodeSegment(ptr, seg);
+    }
+    _ackList.clear();
+
+    // Peer window is zero, probe peer window size.
+    if (_rmtWnd == 0)
+    {
+        if (_probeWait == 0)
+        {
+            _probeWait = LLBC_INL_NS __probeInitWait;
+            _tsProbe = _current + _probeWait;
+        }
+        else if (LLBC_INL_NS __TimeDiff(_current, _tsProbe) >= 0)
+        {
+            _probeWait = MIN(_probeWait + _probeWait / 2, LLBC_INL_NS __probeMaxWait);
+            _tsProbe = _current + _probeWait;
+            _probe |= LLBC_INL_NS __probeAskSend;
+        }
+    }
+    else
+    {
+        _tsProbe = 0;
+        _probeWait = 0;
+    }
+
+    // Keepalive, tell window size to peer if no datagram sent in 1/3 idle timeout.
+    if (_opts.idleTimeout > 0 &&
+        LLBC_INL_NS __TimeDiff(_current, _tsLastOutput) >= static_cast<sint32>(_opts.idleTimeout / 3))
+        _probe |= LLBC_INL_NS __probeAskTell;
+
+    if (_probe & LLBC_INL_NS __probeAskSend)
+    {
+        seg.cmd = CmdWndAsk;
+        if (static_cast<size_t>(ptr - _buf) + HeaderSize > _opts.mtu)
+        {
+            Output(_buf, ptr - _buf);
+            ptr = _buf;
+        }
+
+        ptr = EncodeSegment(ptr, seg);
+    }
+
+    if (_probe & LLBC_INL_NS __probeAskTell)
+    {
+        seg.cmd = CmdWndTell;
+        if (static_cast<size_t>(ptr - _buf) + HeaderSize > _opts.mtu)
+        {
+            Output(_buf, ptr - _buf);
+            ptr = _buf;
+        }
+
+        ptr = EncodeSegment(ptr, seg);
+    }
+    _probe = 0;
+
+    // Move queued segments to send buffer, limited by send window and peer receive window.
+    const uint32 cwnd = MIN(_opts.sendWnd, _rmtWnd);
+    while (LLBC_INL_NS __TimeDiff(_sndNxt, _sndUna + cwnd) < 0 && !_sndQueue.empty())
+    {
+        _Segment *newSeg = _sndQueue.front();
+        _sndQueue.pop_front();
+
+        newSeg->conv = _conv;
+        newSeg->cmd = CmdPush;
+        newSeg->sn = _sndNxt++;
+        newSeg->resendTs = _current;
+        newSeg->rto = _rxRto;
+        newSeg->fastAck = 0;
+        newSeg->xmit = 0;
+
+        _sndBuf.push_back(newSeg);
+    }
+
+    // Send new segments, and retransmit timeout or fast retransmit segments.
+    const uint32 fastResend = _opts.fastResend > 0 ? _opts.fastResend : 0xffffffff;
+    for (_Segments::iterator it = _sndBuf.begin(); it != _sndBuf.end(); ++it)
+    {
+        _Segment *sndSeg = *it;
+
+        bool needSend = false;
+        if (sndSeg->xmit == 0)
+        {
+            needSend = true;
+            sndSeg->rto = _rxRto;
+            sndSeg->resendTs = _current + sndSeg->rto;
+        }
+        else if (LLBC_INL_NS __TimeDiff(_current, sndSeg->resendTs) >= 0)
+        {
+            needSend = true;
+            sndSeg->rto = MIN(sndSeg->rto + sndSeg->rto / 2, static_cast<uint32>(LLBC_INL_NS __maxRto));
+            sndSeg->resendTs = _current + sndSeg->rto;
+            ++_retransmits;
+        }
+        else if (sndSeg->fastAck >= fastResend)
+        {
+            needSend = true;
+            sndSeg->fastAck = 0;
+            sndSeg->resendTs = _current + sndSeg->rto;
+            ++_fastRetransmits;
+        }
+
+        if (!needSend)
+            continue;
+
+        sndSeg->xmit += 1;
+        sndSeg->ts = _current;
+        sndSeg->wnd = seg.wnd;
+        sndSeg->una = _rcvNxt;
+
+        if (static_cast<size_t>(ptr - _buf) + HeaderSize + sndSeg->len > _opts.mtu)
+        {
+            Output(_buf, ptr - _buf);
+            ptr = _buf;
+        }
+
+        ptr = EncodeSegment(ptr, *sndSeg);
+        if (sndSeg->len > 0)
+        {
+            ::memcpy(ptr, sndSeg->Data(), sndSeg->len);
+            ptr += sndSeg->len;
+        }
+
+        if (sndSeg->xmit >= _opts.deadLink)
+            _dead = true;
+    }
+
+    if (ptr > _buf)
+        Output(_buf, ptr - _buf);
+
+    _tsFlush = _current + _opts.interval;
+}
+
+void LLBC_ReliableUdp::Update()
+{
+    _current = Now();
+
+    // Idle timeout check.
+    if (_opts.idleTimeout > 0 &&
+        LLBC_INL_NS __TimeDiff(_current, _tsLastRecv) >= static_cast<sint32>(_opts.idleTimeout))
+        _dead = true;
+
+    if (LLBC_INL_NS __TimeDiff(_current, _tsFlush) >= 0)
+        Flush();
+
+    if (!_delayedDatagrams.empty())
+        FlushDelayedDatagrams();
+}
+
+void LLBC_ReliableUdp::SendFin()
+{
+    _Segment seg;
+    ::memset(&seg, 0, sizeof(_Segment));
+    seg.conv = _conv;
+    seg.cmd = CmdFin;
+    seg.una = _rcvNxt;
+
+    char buf[HeaderSize];
+    EncodeSegment(buf, seg);
+    RawOutput(buf, sizeof(buf));
+}
+
+size_t LLBC_ReliableUdp::GetWaitSendSize() const
+{
+    return _waitSendSize;
+}
+
+bool LLBC_ReliableUdp::IsPeerClosed() const
+{
+    return _peerClosed;
+}
+
+bool LLBC_ReliableUdp::IsDead() const
+{
+    return _dead;
+}
+
+uint64 LLBC_ReliableUdp::GetSentDatagrams() const
+{
+    return _sentDatagrams;
+}
+
+uint64 LLBC_ReliableUdp::GetSentBytes() const
+{
+    return _sentBytes;
+}
+
+uint64 LLBC_ReliableUdp::GetRetransmits() const
+{
+    return _retransmits;
+}
+
+uint64 LLBC_ReliableUdp::GetFastRetransmits() const
+{
+    return _fastRetransmits;
+}
+
+uint64 LLBC_ReliableUdp::GetSimulatedLosses() const
+{
+    return _simulatedLosses;
+}
+
+LLBC_ReliableUdp::_Segment *LLBC_ReliableUdp::NewSegment(size_t dataLen)
+{
+    // Queued send segment capacity always is mss, stream data can append to it.
+    _Segment *seg = reinterpret_cast<_Segment *>(
+        LLBC_Malloc(char, sizeof(_Segment) + MAX(dataLen, static_cast<size_t>(_mss))));
+    ::memset(seg, 0, sizeof(_Segment));
+    seg->len = static_cast<uint32>(dataLen);
+
+    return seg;
+}
+
+void LLBC_ReliableUdp::DeleteSegment(_Segment *seg)
+{
+    LLBC_Free(seg);
+}
+
+void LLBC_ReliableUdp::DeleteSegments(_Segments &segs)
+{
+    for (_Segments::iterator it = segs.begin(); it != segs.end(); ++it)
+        DeleteSegment(*it);
+    segs.clear();
+}
+
+char *LLBC_ReliableUdp::EncodeSegment(char *ptr, const _Segment &seg)
+{
+    ptr = LLBC_INL_NS __Encode32(ptr, seg.conv);
+    ptr = LLBC_INL_NS __Encode8(ptr, seg.cmd);
+    ptr = LLBC_INL_NS __Encode8(ptr, seg.frg);
+    ptr = LLBC_INL_NS __Encode16(ptr, seg.wnd);
+    ptr = LLBC_INL_NS __Encode32(ptr, seg.ts);
+    ptr = LLBC_INL_NS __Encode32(ptr, seg.sn);
+    ptr = LLBC_INL_NS __Encode32(ptr, seg.una);
+    ptr = LLBC_INL_NS __Encode32(ptr, seg.len);
+
+    return ptr;
+}
+
+const char *LLBC_ReliableUdp::DecodeSegment(const char *ptr, _Segment &seg)
+{
+    ptr = LLBC_INL_NS __Decode32(ptr, seg.conv);
+    ptr = LLBC_INL_NS __Decode8(ptr, seg.cmd);
+    ptr = LLBC_INL_NS __Decode8(ptr, seg.frg);
+    ptr = LLBC_INL_NS __Decode16(ptr, seg.wnd);
+    ptr = LLBC_INL_NS __Decode32(ptr, seg.ts);
+    ptr = LLBC_INL_NS __Decode32(ptr, seg.sn);
+    ptr = LLBC_INL_NS __Decode32(ptr, seg.una);
+    ptr = LLBC_INL_NS __Decode32(ptr, seg.len);
+
+    seg.resendTs = 0;
+    seg.rto = 0;
+    seg.fastAck = 0;
+    seg.xmit = 0;
+
+    return ptr;
+}
+
+void LLBC_ReliableUdp::UpdateAck(sint32 rtt)
+{
+    if (_rxSrtt == 0)
+    {
+        _rxSrtt = rtt;
+        _rxRttVal = rtt / 2;
+    }
+    else
+    {
+        const sint32 delta = rtt > _rxSrtt ? rtt - _rxSrtt : _rxSrtt - rtt;
+        _rxRttVal = (3 * _rxRttVal + delta) / 4;
+        _rxSrtt = MAX((7 * _rxSrtt + rtt) / 8, 1);
+    }
+
+    const sint32 rto = _rxSrtt + MAX(static_cast<sint32>(_opts.interval), 4 * _rxRttVal);
+    _rxRto = MIN(MAX(rto, static_cast<sint32>(_opts.minRto)), LLBC_INL_NS __maxRto);
+}
+
+void LLBC_ReliableUdp::ShrinkBuf()
+{
+    _sndUna = _sndBuf.empty() ? _sndNxt : _sndBuf.front()->sn;
+}
+
+void LLBC_ReliableUdp::ParseAck(uint32 sn)
+{
+    if (LLBC_INL_NS __TimeDiff(sn, _sndUna) < 0 ||
+        LLBC_INL_NS __TimeDiff(sn, _sndNxt) >= 0)
+        return;
+
+    for (_Segments::iterator it = _sndBuf.begin(); it != _sndBuf.end(); ++it)
+    {
+        _Segment *seg = *it;
+        if (seg->sn == sn)
+        {
+            _waitSendSize -= seg->len;
+            _sndBuf.erase(it);
+            DeleteSegment(seg);
+
+            break;
+        }
+        else if (LLBC_INL_NS __TimeDiff(sn, seg->sn) < 0)
+        {
+            break;
+        }
+    }
+}
+
+void LLBC_ReliableUdp::ParseUna(uint32 una)
+{
+    while (!_sndBuf.empty())
+    {
+        _Segment *seg = _sndBuf.front();
+        if (LLBC_INL_NS __TimeDiff(una, seg->sn) <= 0)
+            break;
+
+        _waitSendSize -= seg->len;
+        _sndBuf.pop_front();
+        DeleteSegment(seg);
+    }
+}
+
+void LLBC_ReliableUdp::ParseFastAck(uint32 sn)
+{
+    if (LLBC_INL_NS __TimeDiff(sn, _sndUna) < 0 ||
+        LLBC_INL_NS __TimeDiff(sn, _sndNxt) >= 0)
+        return;
+
+    // The segments before max acked segment are skipped by this ack.
+    for (_Segments::iterator it = _sndBuf.begin(); it != _sndBuf.end(); ++it)
+    {
+        _Segment *seg = *it;
+        if (LLBC_INL_NS __TimeDiff(sn, seg->sn) < 0)
+            break;
+        else if (seg->sn != sn)
+            seg->fastAck += 1;
+    }
+}
+
+void LLBC_ReliableUdp::ParseData(_Segment *newSeg)
+{
+    const uint32 sn = newSeg->sn;
+    if (LLBC_INL_NS __TimeDiff(sn, _rcvNxt + _opts.recvWnd) >= 0 ||
+        LLBC_INL_NS __TimeDiff(sn, _rcvNxt) < 0)
+    {
+        DeleteSegment(newSeg);
+        return;
+    }
+
+    // Insert to receive buffer(ordered by sn), drop repeated segment.
+    _Segments::iterator it = _rcvBuf.end();
+    while (it != _rcvBuf.begin())
+    {
+        _Segments::iterator prev = it - 1;
+        if ((*prev)->sn == sn)
+        {
+            DeleteSegment(newSeg);
+            return;
+        }
+        else if (LLBC_INL_NS __TimeDiff(sn, (*prev)->sn) > 0)
+        {
+            break;
+        }
+
+        it = prev;
+    }
+
+    _rcvBuf.insert(it, newSeg);
+
+    MoveRecvedSegments();
+}
+
+void LLBC_ReliableUdp::MoveRecvedSegments()
+{
+    while (!_rcvBuf.empty())
+    {
+        _Segment *seg = _rcvBuf.front();
+        if (seg->sn != _rcvNxt || _rcvQueue.size() >= _opts.recvWnd)
+            break;
+
+        _rcvBuf.pop_front();
+        _rcvNxt += 1;
+
+        // Empty segment(open marker) has no stream data.
+        if (seg->len == 0)
+        {
+            DeleteSegment(seg);
+            continue;
+        }
+
+        _rcvQueue.push_back(seg);
+        _rcvQueueSize += seg->len;
+    }
+}
+
+uint32 LLBC_ReliableUdp::GetUnusedWnd() const
+{
+    return _rcvQueue.size() < _opts.recvWnd ?
+        _opts.recvWnd - static_cast<uint32>(_rcvQueue.size()) : 0;
+}
+
+void LLBC_ReliableUdp::Output(const char *data, size_t len)
+{
+    _tsLastOutput = _current;
+
+    // Loss/latency simulator.
+    if (_opts.lossRate > 0.0 && LLBC_Random::RandRealc0o1() < _opts.lossRate)
+    {
+        ++_simulatedLosses;
+        return;
+    }
+
+    if (_opts.latency > 0 || _opts.jitter > 0)
+    {
+        sint64 dueTime = LLBC_GetMilliSeconds() + _opts.latency;
+        if (_opts.jitter > 0)
+            dueTime += LLBC_Random::RandInt32cmcn(0, _opts.jitter);
+
+        _delayedDatagrams.insert(std::make_pair(dueTime, LLBC_String(data, len)));
+        return;
+    }
+
+    RawOutput(data, len);
+}
+
+void LLBC_ReliableUdp::RawOutput(const char *data, size_t len)
+{
+    // Datagram send failed(eg: socket send buffer full) is same as datagram lost, ARQ will retransmit it.
+    if (LLBC_Send(_handle, data, static_cast<int>(len), 0) < 0)
+        return;
+
+    ++_sentDatagrams;
+    _sentBytes += len;
+}
+
+void LLBC_ReliableUdp::FlushDelayedDatagrams()
+{
+    const sint64 now = LLBC_GetMilliSeconds();
+    while (!_delayedDatagrams.empty())
+    {
+        std::multimap<sint64, LLBC_String>::iterator it = _delayedDatagrams.begin();
+        if (it->first > now)
+            break;
+
+        RawOutput(it->second.data(), it->second.size());
+        _delayedDatagrams.erase(it);
+    }
+}
+
+uint32 LLBC_ReliableUdp::Now()
+{
+    return static_cast<uint32>(LLBC_GetMilliSeconds());
+}
+
+__LLBC_NS_END
+
+#include "llbc/common/AfterIncl.h"
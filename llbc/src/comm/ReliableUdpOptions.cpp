@@ -0,0 +1,58 @@
+/**
+ * @file    ReliableUdpOptions.cpp
+ * @author  Longwei Lai<lailongwei@126.com>
+ * @date    2026/10/18
+ * @version 1.0
+ *
+ * @brief
+ */
+
+#include "llbc/common/Export.h"
+#include "llbc/common/BeforeIncl.h"
+
+#include "llbc/comm/ReliableUdpOptions.h"
+
+__LLBC_NS_BEGIN
+
+LLBC_ReliableUdpOptions::LLBC_ReliableUdpOptions()
+: mtu(LLBC_CFG_COMM_RUDP_DFT_MTU)
+, sendWnd(LLBC_CFG_COMM_RUDP_DFT_SEND_WND)
+, recvWnd(LLBC_CFG_COMM_RUDP_DFT_RECV_WND)
+, interval(LLBC_CFG_COMM_RUDP_DFT_INTERVAL)
+, fastResend(LLBC_CFG_COMM_RUDP_DFT_FAST_RESEND)
+, minRto(LLBC_CFG_COMM_RUDP_DFT_MIN_RTO)
+, deadLink(LLBC_CFG_COMM_RUDP_DFT_DEAD_LINK)
+, idleTimeout(LLBC_CFG_COMM_RUDP_DFT_IDLE_TIMEOUT)
+
+, lossRate(0.0)
+, latency(0)
+, jitter(0)
+{
+}
+
+bool LLBC_ReliableUdpOptions::IsValid() const
+{
+    // The segment header is 24 bytes, at least can hold one byte payload.
+    return mtu > 24 && mtu <= 65507 &&
+           sendWnd > 0 && recvWnd > 0 &&
+           interval > 0 &&
+           deadLink > 0 &&
+           lossRate >= 0.0 && lossRate < 1.0;
+}
+
+bool LLBC_ReliableUdpOptions::IsSimulatorEnabled() const
+{
+    return lossRate > 0.0 || latency > 0 || jitter > 0;
+}
+
+LLBC_String LLBC_ReliableUdpOptions::ToString() const
+{
+    return LLBC_String().format("mtu: %u, sendWnd: %u, recvWnd: %u, interval: %u, fastResend: %u, "
+                                "minRto: %u, deadLink: %u, idleTimeout: %u, lossRate: %.2f, latency: %u, jitter: %u",
+                                mtu, sendWnd, recvWnd, interval, fastResend,
+                                minRto, deadLink, idleTimeout, lossRate, latency, jitter);
+}
+
+__LLBC_NS_END
+
+#include "llbc/common/AfterIncl.h"
@@ -63,7 +63,7 @@ void LLBC_SelectPoller::Svc()
 
     while (!_stopping)
     {
-        HandleQueuedEvents(0);
+        HandleQueuedEvents();
         if (_maxFd == 0)
         {
             LLBC_ThreadManager::Sleep(interval);
@@ -86,7 +86,7 @@ void LLBC_SelectPoller::Svc()
             for (uint32 i = 0; i < excepts.fd_count; i++)
             {
                 LLBC_Session *session = 
-                    _sockets.find(excepts.fd_array[i])->second;
+                    _sessions.FindBySocket(excepts.fd_array[i]);
                 LLBC_Socket *sock = session->GetSocket();
 
                 int sockErr;
@@ -102,7 +102,7 @@ void LLBC_SelectPoller::Svc()
             for (uint32 i = 0; i < reads.fd_count; i++)
             {
                 LLBC_Session *session = 
-                    _sockets.find(reads.fd_array[i])->second;
+                    _sessions.FindBySocket(reads.fd_array[i]);
                 if (session->GetSocket()->IsListen())
                     Accept(session);
                 else
@@ -111,20 +111,22 @@ void LLBC_SelectPoller::Svc()
 
             for (uint32 i = 0; i < writes.fd_count; i++)
             {
-                _Sockets::iterator it = _sockets.find(writes.fd_array[i]);
-                if (it != _sockets.end())
-                    it->second->OnSend();
+                LLBC_Session *session = 
+                    _sessions.FindBySocket(writes.fd_array[i]);
+                if (session)
+                    session->OnSend();
             }
 #else // Non-WIN32
             // In Non-WIN32 platform, the fd_set use bit-set way to implement.
-            // So, we must use the looks like stupid method to lookup.
-            _Sockets sockets = _sockets;
-            for (_Sockets::iterator it = sockets.begin();
-                    it != sockets.end();
-                    it++)
+            // So, we scan fds and lookup session from fd-indexed session table,
+            // the session maybe removed in callbacks, so lookup every fd again.
+            const LLBC_SocketHandle maxFd = _maxFd;
+            for (LLBC_SocketHandle handle = 0; handle <= maxFd; handle++)
             {
-                LLBC_Session *session = it->second;
-                const LLBC_SocketHandle handle = it->first;
+                LLBC_Session *session = _sessions.FindBySocket(handle);
+                if (!session)
+                    continue;
+
                 if (LLBC_FdIsSet(handle, &excepts))
                 {
                     LLBC_Socket *sock = session->GetSocket();
@@ -153,6 +155,8 @@ void LLBC_SelectPoller::Svc()
 #endif // LLBC_TARGET_PLATFORM_WIN32
         }
 
+        UpdateReliableUdpSessions();
+
         const sint64 elapsed = LLBC_GetMilliSeconds() - begin;
         if (UNLIKELY(elapsed < 0))
             continue;
@@ -267,21 +271,28 @@ void LLBC_SelectPoller::RemoveSession(LLBC_Session *session)
 void LLBC_SelectPoller::UpdateMaxFd()
 {
     _maxFd = 0;
-    if (!_sockets.empty())
-        _maxFd = _sockets.rbegin()->first;
+    if (!_sessions.IsEmpty())
+        _maxFd = _sessions.GetMaxSocketHandle();
     if (!_connecting.empty())
         _maxFd = MAX(_maxFd, _connecting.rbegin()->first);
 }
 
 void LLBC_SelectPoller::Accept(LLBC_Session *session)
 {
-    LLBC_Socket *newSocket = session->GetSocket()->Accept();
+    LLBC_Socket *sock = session->GetSocket();
+    if (sock->IsReliableUdp())
+    {
+        AcceptReliableUdp(session);
+        return;
+    }
+
+    LLBC_Socket *newSocket = sock->Accept();
     if (LIKELY(newSocket))
     {
         newSocket->SetNonBlocking();
 
         SetConnectedSocketDftOpts(newSocket);
-        AddToPoller(CreateSession(newSocket));
+        AddToPoller(CreateAcceptedSession(sock, newSocket));
     }
 }
 
@@ -0,0 +1,96 @@
+/**
+ * @file    SendStat.cpp
+ * @author  Longwei Lai<lailongwei@126.com>
+ * @date    2026/10/18
+ * @version 1.0
+ *
+ * @brief
+ */
+
+#include "llbc/common/Export.h"
+#include "llbc/common/BeforeIncl.h"
+
+#include "llbc/comm/SendStat.h"
+
+__LLBC_NS_BEGIN
+
+LLBC_SendStat::LLBC_SendStat()
+: sendCalls(0)
+, sentBlocks(0)
+, sentBytes(0)
+{
+}
+
+void LLBC_SendStat::Reset()
+{
+    sendCalls = 0;
+    sentBlocks = 0;
+    sentBytes = 0;
+}
+
+double LLBC_SendStat::GetBlocksPerCall() const
+{
+    return sendCalls != 0 ? static_cast<double>(sentBlocks) / sendCalls : 0.0;
+}
+
+double LLBC_SendStat::GetBytesPerCall() const
+{
+    return sendCalls != 0 ? static_cast<double>(sentBytes) / sendCalls : 0.0;
+}
+
+LLBC_SendStat &LLBC_SendStat::operator +=(const LLBC_SendStat &other)
+{
+    sendCalls += other.sendCalls;
+    sentBlocks += other.sentBlocks;
+    sentBytes += other.sentBytes;
+
+    return *this;
+}
+
+LLBC_String LLBC_SendStat::ToString() const
+{
+    return LLBC_String().format("sendCalls: %llu, sentBlocks: %llu, sentBytes: %llu, blocks/call: %.2f, bytes/call: %.2f",
+                                sendCalls, sentBlocks, sentBytes, GetBlocksPerCall(), GetBytesPerCall());
+}
+
+LLBC_CoalescedSendStat::LLBC_CoalescedSendStat()
+: coalescedPackets(0)
+, flushes(0)
+, frameEndFlushes(0)
+, bytesLimitFlushes(0)
+, bytesLimitPackets(0)
+, latencyLimitFlushes(0)
+, forceFlushes(0)
+, maxLatency(0)
+{
+}
+
+void LLBC_CoalescedSendStat::Reset()
+{
+    coalescedPackets = 0;
+    flushes = 0;
+    frameEndFlushes = 0;
+    bytesLimitFlushes = 0;
+    bytesLimitPackets = 0;
+    latencyLimitFlushes = 0;
+    forceFlushes = 0;
+    maxLatency = 0;
+}
+
+double LLBC_CoalescedSendStat::GetPacketsPerFlush() const
+{
+    return flushes != 0 ? static_cast<double>(coalescedPackets) / flushes : 0.0;
+}
+
+LLBC_String LLBC_CoalescedSendStat::ToString() const
+{
+    return LLBC_String().format("coalescedPackets: %llu, flushes: %llu(frameEnd: %llu, bytesLimit: %llu, "
+                                "latencyLimit: %llu, force: %llu), bytesLimitPackets: %llu, packets/flush: %.2f, "
+                                "maxLatency: %lld ms",
+                                coalescedPackets, flushes, frameEndFlushes, bytesLimitFlushes,
+                                latencyLimitFlushes, forceFlushes, bytesLimitPackets, GetPacketsPerFlush(), maxLatency);
+}
+
+__LLBC_NS_END
+
+#include "llbc/common/AfterIncl.h"
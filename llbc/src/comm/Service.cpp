@@ -13,9 +13,14 @@
 #include "llbc/comm/ICoder.h"
 #include "llbc/comm/Packet.h"
 #include "llbc/comm/PollerType.h"
+#include "llbc/comm/BackpressurePolicy.h"
+#include "llbc/comm/protocol/CompressPolicy.h"
 #include "llbc/comm/protocol/IProtocol.h"
 #include "llbc/comm/protocol/IProtocolFilter.h"
 #include "llbc/comm/protocol/ProtocolStack.h"
+#include "llbc/comm/SharedBuffer.h"
+#include "llbc/comm/PacketHeaderDescAccessor.h"
+#include "llbc/comm/headerdesc/PacketHeaderDesc.h"
 #include "llbc/comm/Service.h"
 #include "llbc/comm/ServiceMgr.h"
 
@@ -27,15 +32,133 @@ namespace
 
 __LLBC_INTERNAL_NS_BEGIN
 
-static void __DeletePacket(void *data)
+/**
+ * \brief The packet delete guard, delete packet when guard destructed, unless released.
+ */
+class __PacketDeleteGuard
 {
-    LLBC_Delete(reinterpret_cast<LLBC_NS LLBC_Packet *>(data));
-}
+public:
+    explicit __PacketDeleteGuard(LLBC_NS LLBC_Packet *packet)
+    : _packet(packet)
+    {
+    }
+
+    ~__PacketDeleteGuard()
+    {
+        LLBC_XDelete(_packet);
+    }
+
+public:
+    void Release()
+    {
+        _packet = NULL;
+    }
+
+private:
+    LLBC_NS LLBC_Packet *_packet;
+};
+
+/**
+ * \brief The coroutine packet handler task, invoke handler in coroutine, and delete packet when task destroyed.
+ */
+class __CoroHandlerTask : public LLBC_NS LLBC_IDelegate0
+{
+public:
+    __CoroHandlerTask(LLBC_NS LLBC_IDelegate1<LLBC_NS LLBC_Packet &> *handler, LLBC_NS LLBC_Packet *packet)
+    : _handler(handler)
+    , _packet(packet)
+    {
+    }
+
+    virtual ~__CoroHandlerTask()
+    {
+        LLBC_Delete(_packet);
+    }
+
+public:
+    virtual void Invoke()
+    {
+        _handler->Invoke(*_packet);
+    }
+
+private:
+    LLBC_NS LLBC_IDelegate1<LLBC_NS LLBC_Packet &> *_handler;
+    LLBC_NS LLBC_Packet *_packet;
+};
+
+/**
+ * \brief The received packet traffic recorder, record packet when packet handled(recorder destructed).
+ */
+class __RecvTrafficRecorder
+{
+public:
+    __RecvTrafficRecorder(LLBC_NS LLBC_TrafficStatCollector *collector,
+                          const LLBC_NS LLBC_Packet &packet,
+                          LLBC_NS sint64 handleBegTime,
+                          LLBC_NS sint64 decodeTime)
+    : _collector(collector)
+    , _sessionId(packet.GetSessionId())
+    , _opcode(packet.GetOpcode())
+    , _bytes(packet.GetPayloadLength())
+    , _handleBegTime(handleBegTime)
+    , _decodeTime(decodeTime)
+    {
+    }
+
+    ~__RecvTrafficRecorder()
+    {
+        if (!_collector)
+            return;
+
+        LLBC_NS sint64 handleTime = -1;
+        if (_handleBegTime != 0)
+            handleTime = MAX(LLBC_NS LLBC_GetMicroSeconds() - _handleBegTime, 0);
+
+        _collector->OnRecved(_sessionId, _opcode, _bytes, _decodeTime, handleTime);
+    }
+
+private:
+    LLBC_NS LLBC_TrafficStatCollector *_collector;
+    int _sessionId;
+    int _opcode;
+    size_t _bytes;
+    LLBC_NS sint64 _handleBegTime;
+    LLBC_NS sint64 _decodeTime;
+};
 
 __LLBC_INTERNAL_NS_END
 
 __LLBC_NS_BEGIN
 
+/**
+ * \brief The posted coroutine result task, pass result to coroutine in service thread.
+ */
+class LLBC_Service::_CoroResultTask : public LLBC_IDelegate1<LLBC_IService *>
+{
+public:
+    _CoroResultTask(int coroId, void *result)
+    : _coroId(coroId)
+    , _result(result)
+    {
+    }
+
+public:
+    virtual void Invoke(LLBC_IService *svc)
+    {
+        static_cast<LLBC_Service *>(svc)->HandlePostedCoroResult(_coroId, _result);
+    }
+
+private:
+    int _coroId;
+    void *_result;
+};
+
+void LLBC_Service::_Coro::OnTimeout(LLBC_Timer *timer)
+{
+    timer->Cancel();
+    svc->ResumeCoro(this, LLBC_ERROR_TIMEOUT);
+}
+
 int LLBC_Service::_maxId = 1;
 
 LLBC_Service::_EvHandler LLBC_Service::_evHandlers[LLBC_SvcEvType::End] = 
@@ -45,6 +168,7 @@ LLBC_Service::_EvHandler LLBC_Service::_evHandlers[LLBC_SvcEvType::End] =
     &LLBC_Service::HandleEv_AsyncConnResult,
     &LLBC_Service::HandleEv_DataArrival,
     &LLBC_Service::HandleEv_ProtoReport,
+    &LLBC_Service::HandleEv_SessionBackpressure,
 
     &LLBC_Service::HandleEv_SubscribeEv,
     &LLBC_Service::HandleEv_UnsubscribeEv,
@@ -64,6 +188,18 @@ LLBC_Service::LLBC_Service(This::Type type, const LLBC_String &name)
 , _driveMode(This::SelfDrive)
 , _suppressedCoderNotFoundWarning(false)
 
+, _compressPolicy(LLBC_CompressPolicy::None)
+, _compressThreshold(LLBC_CFG_COMM_DFT_COMPRESS_THRESHOLD)
+, _opcodeCompressPolicies()
+
+, _maxPacketLen(LLBC_CFG_COMM_DFT_MAX_PACKET_LEN)
+, _chunkedRecv(false)
+, _recvChunkSize(LLBC_CFG_COMM_DFT_RECV_CHUNK_SIZE)
+
+, _coalescedSend(false)
+, _coalescedSendMaxBytes(LLBC_CFG_COMM_DFT_COALESCED_SEND_MAX_BYTES)
+, _coalescedSendMaxLatency(LLBC_CFG_COMM_DFT_COALESCED_SEND_MAX_LATENCY)
+
 , _started(false)
 , _stopping(false)
 
@@ -75,12 +211,39 @@ LLBC_Service::LLBC_Service(This::Type type, const LLBC_String &name)
 , _sinkIntoLoop(false)
 , _afterStop(false)
 
+, _evQueue()
+, _evSem()
+, _evWaiting(0)
+
 , _pollerMgr()
 , _connectedSessionIds()
-, _connectedSessionIdsLock()
+, _sendingCount(0)
 #if !LLBC_CFG_COMM_USE_FULL_STACK
 , _stack(LLBC_ProtocolStack::CodecStack)
 #endif
+, _multicastStack(NULL)
+
+, _svcTls(NULL)
+, _coalescedBegTime(0)
+, _coalescedBatches()
+, _coalescedFlushPackets()
+, _coalescedSendStat()
+, _coalescedSendStatLock()
+
+, _trafficStat(NULL)
+, _trafficStatDumpInterval(0)
+, _trafficStatLoggerName()
+, _trafficStatDumpTime(0)
+
+, _dispatchWorkerCount(0)
+, _dispatchWorkers()
+, _sessionLocalOpcodes()
+
+, _coroCorrelationPart(-1)
+, _coroCancelling(false)
+, _coroOpcodes()
+, _coros()
+, _coroPacketAwaiters()
 
 , _facades()
 , _coders()
@@ -120,10 +283,17 @@ LLBC_Service::LLBC_Service(This::Type type, const LLBC_String &name)
     if (_name.empty())
         _name.format("S%d-%s", _id, LLBC_GUIDHelper::GenStr().c_str());
 
-    // Get the poller type from Config.h.
-    const char *pollerModel = LLBC_CFG_COMM_POLLER_MODEL;
-    const int pollerType = LLBC_PollerType::Str2Type(pollerModel);
-    ASSERT (LLBC_PollerType::IsValid(pollerType) && "Invalid LLBC_CFG_COMM_POLLER_MODEL config!");
+    // Get the poller type from runtime option environment variable(if set), otherwise from Config.h.
+    int pollerType = LLBC_PollerType::End;
+    const char *envPollerModel = getenv(LLBC_CFG_COMM_POLLER_MODEL_ENV_NAME);
+    if (envPollerModel && envPollerModel[0] != '\0')
+        pollerType = LLBC_PollerType::Str2Type(envPollerModel);
+    if (!LLBC_PollerType::IsValid(pollerType))
+    {
+        const char *pollerModel = LLBC_CFG_COMM_POLLER_MODEL;
+        pollerType = LLBC_PollerType::Str2Type(pollerModel);
+        ASSERT (LLBC_PollerType::IsValid(pollerType) && "Invalid LLBC_CFG_COMM_POLLER_MODEL config!");
+    }
 
     _pollerMgr.SetService(this);
     _pollerMgr.SetPollerType(pollerType);
@@ -170,6 +340,9 @@ LLBC_Service::~LLBC_Service()
          layer++)
         LLBC_XDelete(_filters[layer]);
 
+    LLBC_XDelete(_multicastStack);
+    LLBC_XDelete(_trafficStat);
+
     _handledBeforeFrameTasks = false;
     DestroyFrameTasks(_beforeFrameTasks, _handlingBeforeFrameTasks);
     DestroyFrameTasks(_afterFrameTasks, _handlingAfterFrameTasks);
@@ -197,7 +370,9 @@ This::DriveMode LLBC_Service::GetDriveMode() const
 
 int LLBC_Service::SetDriveMode(This::DriveMode mode)
 {
-    if (mode != This::SelfDrive && mode != This::ExternalDrive)
+    if (mode != This::SelfDrive &&
+        mode != This::ExternalDrive &&
+        mode != This::EventDrive)
     {
         LLBC_SetLastError(LLBC_ERROR_INVALID);
         return LLBC_FAILED;
@@ -237,211 +412,629 @@ int LLBC_Service::SuppressCoderNotFoundWarning()
     return LLBC_OK;
 }
 
-int LLBC_Service::Start(int pollerCount)
+int LLBC_Service::SetCompressPolicy(int policy, size_t threshold)
 {
-    if (pollerCount <= 0)
+    if (_type == This::Raw || !LLBC_CompressPolicy::IsValid(policy))
     {
         LLBC_SetLastError(LLBC_ERROR_INVALID);
         return LLBC_FAILED;
     }
-    else if (_svcMgr.GetService(_id) ||
-        _svcMgr.GetService(_name))
+
+    LLBC_Guard guard(_lock);
+    if (_started)
     {
-        LLBC_SetLastError(LLBC_ERROR_REPEAT);
+        LLBC_SetLastError(LLBC_ERROR_INITED);
         return LLBC_FAILED;
     }
-    else if (_started)
+
+    _compressPolicy = policy;
+    _compressThreshold = threshold;
+
+    return LLBC_OK;
+}
+
+int LLBC_Service::SetOpcodeCompressPolicy(int opcode, int policy)
+{
+    if (_type == This::Raw || !LLBC_CompressPolicy::IsValid(policy))
     {
-        LLBC_SetLastError(LLBC_ERROR_REENTRY);
+        LLBC_SetLastError(LLBC_ERROR_INVALID);
         return LLBC_FAILED;
     }
 
     LLBC_Guard guard(_lock);
     if (_started)
     {
-        LLBC_SetLastError(LLBC_ERROR_REENTRY);
+        LLBC_SetLastError(LLBC_ERROR_INITED);
         return LLBC_FAILED;
     }
 
-    if (_pollerMgr.Start(pollerCount) != LLBC_OK)
-        return LLBC_FAILED;
-
-    if (_driveMode == This::ExternalDrive)
-    {
-        if (!IsCanContinueDriveService())
-        {
-            LLBC_SetLastError(LLBC_ERROR_LIMIT);
-            _pollerMgr.Stop();
+    _opcodeCompressPolicies[opcode] = policy;
 
-            return LLBC_FAILED;
-        }
+    return LLBC_OK;
+}
 
-        AddServiceToTls();
-    }
-    else
+int LLBC_Service::SetMaxPacketLength(size_t maxPacketLen)
+{
+    if (_type == This::Raw)
     {
-        if (Activate(1) != LLBC_OK)
-        {
-            _pollerMgr.Stop();
-            return LLBC_FAILED;
-        }
+        LLBC_SetLastError(LLBC_ERROR_INVALID);
+        return LLBC_FAILED;
     }
 
-    _started = true;
-
-    if (_driveMode == This::ExternalDrive)
+    LLBC_Guard guard(_lock);
+    if (_started)
     {
-        InitFacades();
-        StartFacades();
+        LLBC_SetLastError(LLBC_ERROR_INITED);
+        return LLBC_FAILED;
     }
 
-    return LLBC_OK;
-}
+    _maxPacketLen = maxPacketLen;
 
-bool LLBC_Service::IsStarted() const
-{
-    return _started;
+    return LLBC_OK;
 }
 
-void LLBC_Service::Stop()
+int LLBC_Service::SetChunkedRecv(bool enabled, size_t chunkSize)
 {
-    LLBC_Guard guard(_lock);
-
-    if (!_started || _stopping)
-        return;
-
-    _stopping = true;
-    if (_driveMode == This::SelfDrive) // Stop self-drive service.
+    if (_type == This::Raw)
     {
-        // TODO: How to stop sink into loop service???
-        // if (_sinkIntoLoop) // Service sink into loop, direct return.
-        //     return;
-
-        while (_started) // Service not sink into loop, wait service stop(LLBC_Task mechanism will ensure Cleanup method called).
-            LLBC_ThreadManager::Sleep(20);
+        LLBC_SetLastError(LLBC_ERROR_INVALID);
+        return LLBC_FAILED;
     }
-    else // Stop external-drive service.
+    else if (chunkSize == 0)
     {
-        if (_sinkIntoLoop) // Service sink into loop, set afterStop flag to true, and return.
-        {
-            _afterStop = true; //! After stop data member only use external-drive service.
-            return;
-        }
+        LLBC_SetLastError(LLBC_ERROR_ARG);
+        return LLBC_FAILED;
+    }
 
-        // Service not sink into loop, direct cleanup.
-        Cleanup();
+    LLBC_Guard guard(_lock);
+    if (_started)
+    {
+        LLBC_SetLastError(LLBC_ERROR_INITED);
+        return LLBC_FAILED;
     }
-}
 
-int LLBC_Service::GetFPS() const
-{
-    This *ncThis = const_cast<This *>(this);
-    LLBC_Guard guard(ncThis->_lock);
-    return _fps;
+    _chunkedRecv = enabled;
+    _recvChunkSize = chunkSize;
+
+    return LLBC_OK;
 }
 
-int LLBC_Service::SetFPS(int fps)
+int LLBC_Service::SetCoalescedSend(bool enabled, size_t maxBytes, int maxLatency)
 {
-    if (LLBC_CFG_COMM_MIN_SERVICE_FPS <= fps &&
-            fps <= LLBC_CFG_COMM_MAX_SERVICE_FPS)
+    if (maxBytes == 0 || maxLatency < 0)
     {
-        LLBC_Guard guard(_lock);
-
-        _fps = fps;
-        _frameInterval = 1000 / _fps;
-        return LLBC_OK;
+        LLBC_SetLastError(LLBC_ERROR_ARG);
+        return LLBC_FAILED;
     }
 
-    LLBC_SetLastError(LLBC_ERROR_LIMIT);
-    return LLBC_FAILED;
-}
+    LLBC_Guard guard(_lock);
+    if (_started)
+    {
+        LLBC_SetLastError(LLBC_ERROR_INITED);
+        return LLBC_FAILED;
+    }
 
-int LLBC_Service::GetFrameInterval() const
-{
-    This *ncThis = const_cast<This *>(this);
+    _coalescedSend = enabled;
+    _coalescedSendMaxBytes = maxBytes;
+    _coalescedSendMaxLatency = maxLatency;
 
-    LLBC_Guard guard(ncThis->_lock);
-    return _frameInterval;
+    return LLBC_OK;
 }
 
-int LLBC_Service::Listen(const char *ip, uint16 port)
+int LLBC_Service::SetRecvBudget(size_t budget)
 {
     LLBC_Guard guard(_lock);
-    const int sessionId = _pollerMgr.Listen(ip, port);
-    if (sessionId != 0)
+    if (_started)
     {
-        _connectedSessionIdsLock.Lock();
-        _connectedSessionIds.insert(sessionId);
-        _connectedSessionIdsLock.Unlock();
+        LLBC_SetLastError(LLBC_ERROR_INITED);
+        return LLBC_FAILED;
     }
 
-    return sessionId;
+    _pollerMgr.SetRecvBudget(budget);
+
+    return LLBC_OK;
 }
 
-int LLBC_Service::Connect(const char *ip, uint16 port, double timeout)
+int LLBC_Service::SetSendWaterMarks(size_t lowWaterMark, size_t highWaterMark)
 {
+    if (highWaterMark != 0 && lowWaterMark >= highWaterMark)
+    {
+        LLBC_SetLastError(LLBC_ERROR_ARG);
+        return LLBC_FAILED;
+    }
+
     LLBC_Guard guard(_lock);
-    const int sessionId = _pollerMgr.Connect(ip, port);
-    if (sessionId != 0)
+    if (_started)
     {
-        _connectedSessionIdsLock.Lock();
-        _connectedSessionIds.insert(sessionId);
-        _connectedSessionIdsLock.Unlock();
+        LLBC_SetLastError(LLBC_ERROR_INITED);
+        return LLBC_FAILED;
     }
 
-    return sessionId;
-}
+    _pollerMgr.SetSendWaterMarks(lowWaterMark, highWaterMark);
 
-int LLBC_Service::AsyncConn(const char *ip, uint16 port, double timeout)
-{
-    LLBC_Guard guard(_lock);
-    return _pollerMgr.AsyncConn(ip, port);
+    return LLBC_OK;
 }
 
-bool LLBC_Service::IsSessionValidate(int sessionId)
+int LLBC_Service::SetBackpressurePolicy(int policy)
 {
-    if (UNLIKELY(sessionId == 0))
-        return false;
-
-    _connectedSessionIdsLock.Lock();
-    const bool valid = 
-        _connectedSessionIds.find(sessionId) != _connectedSessionIds.end();
-    _connectedSessionIdsLock.Unlock();
+    if (!LLBC_BackpressurePolicy::IsValid(policy))
+    {
+        LLBC_SetLastError(LLBC_ERROR_ARG);
+        return LLBC_FAILED;
+    }
 
-    return valid;
-}
+    LLBC_Guard guard(_lock);
+    if (_started)
+    {
+        LLBC_SetLastError(LLBC_ERROR_INITED);
+        return LLBC_FAILED;
+    }
 
-int LLBC_Service::Send(LLBC_Packet *packet)
-{
-    // Call internal Lockable() to complete.
-    // lock = true
-    // validCheck = true
-    return LockableSend(packet);
-}
+    _pollerMgr.SetBackpressurePolicy(policy);
 
-int LLBC_Service::Send2(int sessionId, int opcode, LLBC_ICoder *coder, int status, LLBC_PacketHeaderParts *parts)
-{
-    return Send2(0, sessionId, opcode, coder, status, parts);
+    return LLBC_OK;
 }
 
-int LLBC_Service::Send2(int svcId, int sessionId, int opcode, LLBC_ICoder *coder, int status, LLBC_PacketHeaderParts *parts)
+int LLBC_Service::SetOpcodeBackpressurePolicy(int opcode, int policy)
 {
-    LLBC_Packet *packet = LLBC_New(LLBC_Packet);
-    packet->SetHeader(svcId, sessionId, opcode, status);
-    if (parts)
+    if (!LLBC_BackpressurePolicy::IsValid(policy))
     {
-        if (_type != This::Raw)
-            parts->SetToPacket(*packet);
+        LLBC_SetLastError(LLBC_ERROR_ARG);
+        return LLBC_FAILED;
+    }
 
-        LLBC_Delete(parts);
+    LLBC_Guard guard(_lock);
+    if (_started)
+    {
+        LLBC_SetLastError(LLBC_ERROR_INITED);
+        return LLBC_FAILED;
     }
 
-    packet->SetEncoder(coder);
+    _pollerMgr.SetOpcodeBackpressurePolicy(opcode, policy);
 
-    // Call internal LockableSend() to complete.
-    // lock = true
-    // validCheck = true
-    return LockableSend(packet);
+    return LLBC_OK;
+}
+
+int LLBC_Service::SetReliableUdpOptions(const LLBC_ReliableUdpOptions &opts)
+{
+    if (!opts.IsValid())
+    {
+        LLBC_SetLastError(LLBC_ERROR_ARG);
+        return LLBC_FAILED;
+    }
+
+    LLBC_Guard guard(_lock);
+    if (_started)
+    {
+        LLBC_SetLastError(LLBC_ERROR_INITED);
+        return LLBC_FAILED;
+    }
+
+    _pollerMgr.SetReliableUdpOptions(opts);
+
+    return LLBC_OK;
+}
+
+int LLBC_Service::SetTrafficStat(bool enabled, int dumpInterval, const char *loggerName)
+{
+    if (dumpInterval < 0)
+    {
+        LLBC_SetLastError(LLBC_ERROR_ARG);
+        return LLBC_FAILED;
+    }
+
+#if LLBC_CFG_COMM_USE_FULL_STACK
+    // Full stack encode/decode packets in poller threads, statistic hooks not available.
+    LLBC_SetLastError(LLBC_ERROR_NOT_IMPL);
+    return LLBC_FAILED;
+#else
+    LLBC_Guard guard(_lock);
+    if (_started)
+    {
+        LLBC_SetLastError(LLBC_ERROR_INITED);
+        return LLBC_FAILED;
+    }
+
+    if (enabled)
+    {
+        if (!_trafficStat)
+            _trafficStat = LLBC_New(LLBC_TrafficStatCollector);
+
+        _trafficStatDumpInterval = dumpInterval;
+        _trafficStatLoggerName = loggerName ? loggerName : "";
+    }
+    else
+    {
+        LLBC_XDelete(_trafficStat);
+        _trafficStatDumpInterval = 0;
+        _trafficStatLoggerName.clear();
+    }
+
+    return LLBC_OK;
+#endif // LLBC_CFG_COMM_USE_FULL_STACK
+}
+
+int LLBC_Service::SetDispatchWorkers(int workerCount)
+{
+    if (workerCount < 0 ||
+        workerCount > LLBC_CFG_COMM_MAX_SERVICE_DISPATCH_WORKERS)
+    {
+        LLBC_SetLastError(LLBC_ERROR_ARG);
+        return LLBC_FAILED;
+    }
+
+    LLBC_Guard guard(_lock);
+    if (_started)
+    {
+        LLBC_SetLastError(LLBC_ERROR_INITED);
+        return LLBC_FAILED;
+    }
+
+    _dispatchWorkerCount = workerCount;
+
+    return LLBC_OK;
+}
+
+int LLBC_Service::SetOpcodeSessionLocal(int opcode, bool sessionLocal)
+{
+    LLBC_Guard guard(_lock);
+    if (_started)
+    {
+        LLBC_SetLastError(LLBC_ERROR_INITED);
+        return LLBC_FAILED;
+    }
+
+    if (sessionLocal)
+        _sessionLocalOpcodes.insert(opcode);
+    else
+        _sessionLocalOpcodes.erase(opcode);
+
+    return LLBC_OK;
+}
+
+int LLBC_Service::GetSendQueueSize(int sessionId, size_t &queueSize) const
+{
+    return _pollerMgr.GetSendQueueSize(sessionId, queueSize);
+}
+
+int LLBC_Service::GetPollerType() const
+{
+    return _pollerMgr.GetPollerType();
+}
+
+int LLBC_Service::SetPollerType(int type)
+{
+    if (!LLBC_PollerType::IsValid(type))
+    {
+        LLBC_SetLastError(LLBC_ERROR_ARG);
+        return LLBC_FAILED;
+    }
+
+    LLBC_Guard guard(_lock);
+    if (_started)
+    {
+        LLBC_SetLastError(LLBC_ERROR_INITED);
+        return LLBC_FAILED;
+    }
+
+    _pollerMgr.SetPollerType(type);
+
+    return LLBC_OK;
+}
+
+int LLBC_Service::Start(int pollerCount)
+{
+    if (pollerCount <= 0)
+    {
+        LLBC_SetLastError(LLBC_ERROR_INVALID);
+        return LLBC_FAILED;
+    }
+    else if (_svcMgr.GetService(_id) ||
+        _svcMgr.GetService(_name))
+    {
+        LLBC_SetLastError(LLBC_ERROR_REPEAT);
+        return LLBC_FAILED;
+    }
+    else if (_started)
+    {
+        LLBC_SetLastError(LLBC_ERROR_REENTRY);
+        return LLBC_FAILED;
+    }
+
+    LLBC_Guard guard(_lock);
+    if (_started)
+    {
+        LLBC_SetLastError(LLBC_ERROR_REENTRY);
+        return LLBC_FAILED;
+    }
+
+    CompileDispatchTable();
+    if (StartDispatchWorkers() != LLBC_OK)
+        return LLBC_FAILED;
+
+    if (_pollerMgr.Start(pollerCount) != LLBC_OK)
+    {
+        StopDispatchWorkers();
+        return LLBC_FAILED;
+    }
+
+    if (_driveMode == This::ExternalDrive)
+    {
+        if (!IsCanContinueDriveService())
+        {
+            LLBC_SetLastError(LLBC_ERROR_LIMIT);
+            _pollerMgr.Stop();
+            StopDispatchWorkers();
+
+            return LLBC_FAILED;
+        }
+
+        AddServiceToTls();
+    }
+    else
+    {
+        if (Activate(1) != LLBC_OK)
+        {
+            _pollerMgr.Stop();
+            StopDispatchWorkers();
+
+            return LLBC_FAILED;
+        }
+    }
+
+    _started = true;
+
+    if (_driveMode == This::ExternalDrive)
+    {
+        InitFacades();
+        StartFacades();
+    }
+
+    return LLBC_OK;
+}
+
+bool LLBC_Service::IsStarted() const
+{
+    return _started;
+}
+
+void LLBC_Service::Stop()
+{
+    LLBC_Guard guard(_lock);
+
+    if (!_started || _stopping)
+        return;
+
+    _stopping = true;
+    if (_driveMode != This::ExternalDrive) // Stop self-drive service.
+    {
+        // Wakeup event-drive service, if service waiting events.
+        if (_driveMode == This::EventDrive)
+            _evSem.Post();
+
+        // TODO: How to stop sink into loop service???
+        // if (_sinkIntoLoop) // Service sink into loop, direct return.
+        //     return;
+
+        while (_started) // Service not sink into loop, wait service stop(LLBC_Task mechanism will ensure Cleanup method called).
+            LLBC_ThreadManager::Sleep(20);
+    }
+    else // Stop external-drive service.
+    {
+        if (_sinkIntoLoop) // Service sink into loop, set afterStop flag to true, and return.
+        {
+            _afterStop = true; //! After stop data member only use external-drive service.
+            return;
+        }
+
+        // Service not sink into loop, direct cleanup.
+        Cleanup();
+    }
+}
+
+int LLBC_Service::GetFPS() const
+{
+    This *ncThis = const_cast<This *>(this);
+    LLBC_Guard guard(ncThis->_lock);
+    return _fps;
+}
+
+int LLBC_Service::SetFPS(int fps)
+{
+    if (LLBC_CFG_COMM_MIN_SERVICE_FPS <= fps &&
+            fps <= LLBC_CFG_COMM_MAX_SERVICE_FPS)
+    {
+        LLBC_Guard guard(_lock);
+
+        _fps = fps;
+        _frameInterval = 1000 / _fps;
+        return LLBC_OK;
+    }
+
+    LLBC_SetLastError(LLBC_ERROR_LIMIT);
+    return LLBC_FAILED;
+}
+
+int LLBC_Service::GetFrameInterval() const
+{
+    This *ncThis = const_cast<This *>(this);
+
+    LLBC_Guard guard(ncThis->_lock);
+    return _frameInterval;
+}
+
+int LLBC_Service::GetSendStat(LLBC_SendStat &stat) const
+{
+    This *ncThis = const_cast<This *>(this);
+
+    stat.Reset();
+
+    LLBC_Guard guard(ncThis->_lock);
+    if (!_started)
+    {
+        LLBC_SetLastError(LLBC_ERROR_NOT_INIT);
+        return LLBC_FAILED;
+    }
+
+    ncThis->_pollerMgr.GetSendStat(stat);
+
+    return LLBC_OK;
+}
+
+int LLBC_Service::GetRecvStat(LLBC_RecvStat &stat) const
+{
+    This *ncThis = const_cast<This *>(this);
+
+    stat.Reset();
+
+    LLBC_Guard guard(ncThis->_lock);
+    if (!_started)
+    {
+        LLBC_SetLastError(LLBC_ERROR_NOT_INIT);
+        return LLBC_FAILED;
+    }
+
+    ncThis->_pollerMgr.GetRecvStat(stat);
+
+    return LLBC_OK;
+}
+
+int LLBC_Service::GetSessionRecvStat(int sessionId, LLBC_RecvStat &stat) const
+{
+    return _pollerMgr.GetSessionRecvStat(sessionId, stat);
+}
+
+int LLBC_Service::GetCoalescedSendStat(LLBC_CoalescedSendStat &stat) const
+{
+    This *ncThis = const_cast<This *>(this);
+
+    LLBC_Guard guard(ncThis->_coalescedSendStatLock);
+    stat = _coalescedSendStat;
+
+    return LLBC_OK;
+}
+
+int LLBC_Service::GetTrafficStat(LLBC_TrafficStat &stat) const
+{
+    // Collector only created/deleted before service start, not need to lock service.
+    if (!_trafficStat)
+    {
+        stat.Reset();
+
+        LLBC_SetLastError(LLBC_ERROR_NOT_INIT);
+        return LLBC_FAILED;
+    }
+
+    _trafficStat->Snapshot(stat);
+
+    return LLBC_OK;
+}
+
+int LLBC_Service::Listen(const char *ip, uint16 port)
+{
+    LLBC_Guard guard(_lock);
+    const int sessionId = _pollerMgr.Listen(ip, port);
+    if (sessionId != 0)
+        _connectedSessionIds.Insert(sessionId);
+
+    return sessionId;
+}
+
+int LLBC_Service::ListenReusePort(const char *ip, uint16 port, LLBC_SessionIdList &sessionIds)
+{
+    LLBC_Guard guard(_lock);
+    if (!_started)
+    {
+        LLBC_SetLastError(LLBC_ERROR_NOT_INIT);
+        return LLBC_FAILED;
+    }
+
+    LLBC_SessionIdList listenSessionIds;
+    if (_pollerMgr.ListenReusePort(ip, port, listenSessionIds) != LLBC_OK)
+        return LLBC_FAILED;
+
+    for (size_t i = 0; i < listenSessionIds.size(); i++)
+        _connectedSessionIds.Insert(listenSessionIds[i]);
+    sessionIds.insert(sessionIds.end(), listenSessionIds.begin(), listenSessionIds.end());
+
+    return LLBC_OK;
+}
+
+int LLBC_Service::Connect(const char *ip, uint16 port, double timeout)
+{
+    LLBC_Guard guard(_lock);
+    const int sessionId = _pollerMgr.Connect(ip, port);
+    if (sessionId != 0)
+        _connectedSessionIds.Insert(sessionId);
+
+    return sessionId;
+}
+
+int LLBC_Service::AsyncConn(const char *ip, uint16 port, double timeout)
+{
+    LLBC_Guard guard(_lock);
+    return _pollerMgr.AsyncConn(ip, port);
+}
+
+int LLBC_Service::ListenReliableUdp(const char *ip, uint16 port)
+{
+    LLBC_Guard guard(_lock);
+    const int sessionId = _pollerMgr.ListenReliableUdp(ip, port);
+    if (sessionId != 0)
+        _connectedSessionIds.Insert(sessionId);
+
+    return sessionId;
+}
+
+int LLBC_Service::ConnectReliableUdp(const char *ip, uint16 port)
+{
+    LLBC_Guard guard(_lock);
+    const int sessionId = _pollerMgr.ConnectReliableUdp(ip, port);
+    if (sessionId != 0)
+        _connectedSessionIds.Insert(sessionId);
+
+    return sessionId;
+}
+
+bool LLBC_Service::IsSessionValidate(int sessionId)
+{
+    if (UNLIKELY(sessionId == 0))
+        return false;
+
+    return _connectedSessionIds.IsExist(sessionId);
+}
+
+int LLBC_Service::Send(LLBC_Packet *packet)
+{
+    // Call internal Lockable() to complete.
+    // lock = true
+    // validCheck = true
+    return LockableSend(packet);
+}
+
+int LLBC_Service::Send2(int sessionId, int opcode, LLBC_ICoder *coder, int status, LLBC_PacketHeaderParts *parts)
+{
+    return Send2(0, sessionId, opcode, coder, status, parts);
+}
+
+int LLBC_Service::Send2(int svcId, int sessionId, int opcode, LLBC_ICoder *coder, int status, LLBC_PacketHeaderParts *parts)
+{
+    LLBC_Packet *packet = LLBC_New(LLBC_Packet);
+    packet->SetHeader(svcId, sessionId, opcode, status);
+    if (parts)
+    {
+        if (_type != This::Raw)
+            parts->SetToPacket(*packet);
+
+        LLBC_Delete(parts);
+    }
+
+    packet->SetEncoder(coder);
+
+    // Call internal LockableSend() to complete.
+    // lock = true
+    // validCheck = true
+    return LockableSend(packet);
 }
 
 int LLBC_Service::Send2(int sessionId, int opcode, const void *bytes, size_t len, int status, LLBC_PacketHeaderParts *parts)
@@ -475,9 +1068,9 @@ int LLBC_Service::Multicast2(const LLBC_SessionIdList &sessionIds, int opcode, L
 
 int LLBC_Service::Multicast2(int svcId, const LLBC_SessionIdList &sessionIds, int opcode, LLBC_ICoder *coder, int status, LLBC_PacketHeaderParts *parts)
 {
-    // Call internal MulticastSendCoder<> template method to complete.
+    // Call internal MulticastSendCoder() method to complete.
     // validCheck = true
-    const int ret = MulticastSendCoder<LLBC_SessionIdList>(svcId, sessionIds, opcode, coder, status, parts);
+    const int ret = MulticastSendCoder(svcId, sessionIds, opcode, coder, status, parts);
     if (parts)
         LLBC_Delete(parts);
 
@@ -491,20 +1084,13 @@ int LLBC_Service::Multicast2(const LLBC_SessionIdList &sessionIds, int opcode, c
 
 int LLBC_Service::Multicast2(int svcId, const LLBC_SessionIdList &sessionIds, int opcode, const void *bytes, size_t len, int status, LLBC_PacketHeaderParts *parts)
 {
-    LLBC_Guard guard(_lock);
-
-    // Foreach to call internal method LockableSend() method to complete.
-    // lock = false
+    // Call internal MulticastSendBytes() method to complete.
     // validCheck = true
-    for (LLBC_SessionIdListCIter sessionIt = sessionIds.begin();
-         sessionIt != sessionIds.end();
-         sessionIt++)
-        LockableSend(svcId, *sessionIt, opcode, bytes, len, status, parts, false);
-
+    const int ret = MulticastSendBytes(svcId, sessionIds, opcode, bytes, len, status, parts);
     if (parts)
         LLBC_Delete(parts);
 
-    return LLBC_OK;
+    return ret;
 }
 
 int LLBC_Service::Broadcast2(int opcode, LLBC_ICoder *coder, int status, LLBC_PacketHeaderParts *parts)
@@ -515,20 +1101,12 @@ int LLBC_Service::Broadcast2(int opcode, LLBC_ICoder *coder, int status, LLBC_Pa
 int LLBC_Service::Broadcast2(int svcId, int opcode, LLBC_ICoder *coder, int status, LLBC_PacketHeaderParts *parts)
 {
     // Copy all connected session Ids.
-    int idx = 0;
-
-    _connectedSessionIdsLock.Lock();
-    LLBC_SessionIdList connectedSessionIds(_connectedSessionIds.size());
-    for (LLBC_SessionIdSetCIter sessionIdIt = _connectedSessionIds.begin();
-         sessionIdIt != _connectedSessionIds.end();
-         idx++, sessionIdIt++)
-         connectedSessionIds[idx] = *sessionIdIt;
+    LLBC_SessionIdList connectedSessionIds;
+    _connectedSessionIds.GetSessionIds(connectedSessionIds);
 
-    _connectedSessionIdsLock.Unlock();
-
-    // Call internal template method MulticastSendCoder<>() to complete.
+    // Call internal MulticastSendCoder() method to complete.
     // validCheck = false
-    const int ret = MulticastSendCoder<LLBC_SessionIdList>(svcId, connectedSessionIds, opcode, coder, status, parts, false);
+    const int ret = MulticastSendCoder(svcId, connectedSessionIds, opcode, coder, status, parts, false);
     if (parts)
         LLBC_Delete(parts);
 
@@ -542,43 +1120,83 @@ int LLBC_Service::Broadcast2(int opcode, const void *bytes, size_t len, int stat
 
 int LLBC_Service::Broadcast2(int svcId, int opcode, const void *bytes, size_t len , int status, LLBC_PacketHeaderParts *parts)
 {
-    LLBC_Guard guard(_lock);
+    // Copy all connected session Ids.
+    LLBC_SessionIdList connectedSessionIds;
+    _connectedSessionIds.GetSessionIds(connectedSessionIds);
 
-    // Foreach to call internal method LockableSend() method to complete.
-    // lock = false
+    // Call internal MulticastSendBytes() method to complete.
     // validCheck = false
-    LLBC_Guard connSIdsGuard(_connectedSessionIdsLock);
-    for (LLBC_SessionIdSetCIter sessionIt = _connectedSessionIds.begin();
-         sessionIt != _connectedSessionIds.end();
-         sessionIt++)
-        LockableSend(svcId, *sessionIt, opcode, bytes, len, status, parts, false, false);
-
+    const int ret = MulticastSendBytes(svcId, connectedSessionIds, opcode, bytes, len, status, parts, false);
     if (parts)
         LLBC_Delete(parts);
 
-    return LLBC_OK;
+    return ret;
 }
 
-int LLBC_Service::RemoveSession(int sessionId, const char *reason)
+int LLBC_Service::Forward(LLBC_Packet &packet, int targetSvcId, int targetSessionId)
 {
-    LLBC_Guard guard(_lock);
-    if (!_started)
+    LLBC_IService *targetSvc = targetSvcId == _id ?
+        this : LLBC_ServiceMgrSingleton->GetService(targetSvcId);
+    if (UNLIKELY(!targetSvc))
+        return LLBC_FAILED;
+
+    return Forward(packet, targetSvc, targetSessionId);
+}
+
+int LLBC_Service::Forward(LLBC_Packet &packet, LLBC_IService *targetSvc, int targetSessionId)
+{
+    if (UNLIKELY(!targetSvc))
     {
-        LLBC_SetLastError(LLBC_ERROR_NOT_INIT);
+        LLBC_SetLastError(LLBC_ERROR_ARG);
         return LLBC_FAILED;
     }
 
-    LLBC_Guard connSIdsGuard(_connectedSessionIdsLock);
+    // Payload chunk only hold part of payload, header length part not match chunk data.
+    if (UNLIKELY(packet.IsChunk()))
+    {
+        LLBC_SetLastError(LLBC_ERROR_NOT_ALLOW);
+        return LLBC_FAILED;
+    }
 
-    LLBC_SessionIdSetIter sessionIdIt = _connectedSessionIds.find(sessionId);
-    if (sessionIdIt == _connectedSessionIds.end())
+    // Check target before take over packet data, keep packet untouched when target unavailable.
+    LLBC_Service *target = static_cast<LLBC_Service *>(targetSvc);
+    if (UNLIKELY(!target->_started || target->_stopping))
+    {
+        LLBC_SetLastError(LLBC_ERROR_NOT_INIT);
+        return LLBC_FAILED;
+    }
+    else if (!target->_connectedSessionIds.IsExist(targetSessionId))
     {
         LLBC_SetLastError(LLBC_ERROR_NOT_FOUND);
         return LLBC_FAILED;
     }
 
+    // Take over packet data(still reference receive slab if possible), rewrite header in place.
+    LLBC_Packet *forwarding = LLBC_New(LLBC_Packet);
+    packet.MoveDataTo(*forwarding);
+    forwarding->SetServiceId(target->_id);
+    forwarding->SetSessionId(targetSessionId);
+
+    return target->LockableSend(forwarding);
+}
+
+int LLBC_Service::RemoveSession(int sessionId, const char *reason)
+{
+    LLBC_Guard guard(_lock);
+    if (!_started)
+    {
+        LLBC_SetLastError(LLBC_ERROR_NOT_INIT);
+        return LLBC_FAILED;
+    }
+
+    if (_connectedSessionIds.Remove(sessionId) != LLBC_OK)
+        return LLBC_FAILED;
+
+    // Flush session coalesced packets first, to makesure the packets sent before remove session can be sent.
+    if (IsCanCoalesceSend())
+        FlushSessionCoalescedSend(sessionId, _ForceFlush);
+
     _pollerMgr.Close(sessionId, reason);
-    _connectedSessionIds.erase(sessionIdIt);
 
     return LLBC_OK;
 }
@@ -630,10 +1248,6 @@ int LLBC_Service::RegisterCoder(int opcode, LLBC_ICoderFactory *coder)
         return LLBC_FAILED;
     }
 
-#if !LLBC_CFG_COMM_USE_FULL_STACK
-    _stack.AddCoder(opcode, coder);
-#endif // !LLBC_CFG_COMM_USE_FULL_STACK
-
     return LLBC_OK;
 }
 
@@ -692,6 +1306,17 @@ int LLBC_Service::Subscribe(int opcode, LLBC_IDelegate1<LLBC_Packet &> *deleg)
     return LLBC_OK;
 }
 
+int LLBC_Service::SubscribeCoro(int opcode, LLBC_IDelegate1<LLBC_Packet &> *deleg)
+{
+    LLBC_Guard guard(_lock);
+    if (Subscribe(opcode, deleg) != LLBC_OK)
+        return LLBC_FAILED;
+
+    _coroOpcodes.insert(opcode);
+
+    return LLBC_OK;
+}
+
 int LLBC_Service::PreSubscribe(int opcode, LLBC_IDelegateEx<LLBC_Packet &> *deleg)
 {
     if (UNLIKELY(!deleg))
@@ -927,6 +1552,148 @@ int LLBC_Service::Post(LLBC_IDelegate1<LLBC_Service::Base *> *deleg)
     return LLBC_OK;
 }
 
+int LLBC_Service::SetCoroCorrelationPart(int serialNo)
+{
+    LLBC_Guard guard(_lock);
+    if (_started)
+    {
+        LLBC_SetLastError(LLBC_ERROR_INITED);
+        return LLBC_FAILED;
+    }
+
+    if (serialNo >= 0 &&
+        !LLBC_PacketHeaderDescAccessor::GetHeaderDesc()->GetPart(serialNo))
+    {
+        LLBC_SetLastError(LLBC_ERROR_INVALID);
+        return LLBC_FAILED;
+    }
+
+    _coroCorrelationPart = serialNo >= 0 ? serialNo : -1;
+
+    return LLBC_OK;
+}
+
+int LLBC_Service::Go(LLBC_IDelegate0 *task)
+{
+    if (UNLIKELY(!task))
+    {
+        LLBC_SetLastError(LLBC_ERROR_INVALID);
+        return 0;
+    }
+
+    if (UNLIKELY(_coroCancelling ||
+        !_sinkIntoLoop || _svcTls != __LLBC_GetLibTls()))
+    {
+        LLBC_Delete(task);
+        LLBC_SetLastError(_coroCancelling ? LLBC_ERROR_NOT_ALLOW : LLBC_ERROR_ILLEGAL);
+
+        return 0;
+    }
+
+    _Coro *coro = LLBC_New(_Coro);
+    coro->svc = this;
+    coro->coro = LLBC_New1(LLBC_Coro, task);
+    coro->awaitType = _CoroAwaitNone;
+    coro->sessionId = 0;
+    coro->correlationId = 0;
+    coro->timer = NULL;
+    coro->packet = NULL;
+    coro->result = NULL;
+    coro->posted = false;
+    coro->error = LLBC_OK;
+
+    const int coroId = coro->coro->GetId();
+    _coros.insert(std::make_pair(coroId, coro));
+
+    // Run coroutine until first await or finished.
+    if (ResumeCoro(coro, LLBC_OK) != LLBC_OK)
+        return 0;
+
+    return coroId;
+}
+
+LLBC_Packet *LLBC_Service::AwaitPacket(int sessionId, sint64 correlationId, int timeout)
+{
+    _Coro *coro = GetCurrentCoro();
+    if (UNLIKELY(!coro))
+        return NULL;
+
+    if (UNLIKELY(_coroCorrelationPart < 0))
+    {
+        LLBC_SetLastError(LLBC_ERROR_NOT_INIT);
+        return NULL;
+    }
+
+    if (UNLIKELY(!_connectedSessionIds.IsExist(sessionId)))
+    {
+        LLBC_SetLastError(LLBC_ERROR_NOT_FOUND);
+        return NULL;
+    }
+
+    if (!_coroPacketAwaiters.insert(std::make_pair(std::make_pair(sessionId, correlationId), coro)).second)
+    {
+        LLBC_SetLastError(LLBC_ERROR_REPEAT);
+        return NULL;
+    }
+
+    coro->sessionId = sessionId;
+    coro->correlationId = correlationId;
+    if (AwaitCoro(coro, _CoroAwaitPacket, timeout) != LLBC_OK)
+        return NULL;
+
+    LLBC_Packet *packet = coro->packet;
+    coro->packet = NULL;
+
+    return packet;
+}
+
+int LLBC_Service::AwaitTimer(int milliSeconds)
+{
+    _Coro *coro = GetCurrentCoro();
+    if (UNLIKELY(!coro))
+        return LLBC_FAILED;
+
+    if (AwaitCoro(coro, _CoroAwaitTimer, MAX(milliSeconds, 0)) != LLBC_OK &&
+        LLBC_GetLastError() != LLBC_ERROR_TIMEOUT)
+        return LLBC_FAILED;
+
+    return LLBC_OK;
+}
+
+int LLBC_Service::AwaitResult(void *&result, int timeout)
+{
+    _Coro *coro = GetCurrentCoro();
+    if (UNLIKELY(!coro))
+        return LLBC_FAILED;
+
+    if (!coro->posted &&
+        AwaitCoro(coro, _CoroAwaitResult, timeout) != LLBC_OK)
+        return LLBC_FAILED;
+
+    result = coro->result;
+    coro->result = NULL;
+    coro->posted = false;
+
+    return LLBC_OK;
+}
+
+int LLBC_Service::PostCoroResult(int coroId, void *result)
+{
+    LLBC_IDelegate1<Base *> *task = LLBC_New2(_CoroResultTask, coroId, result);
+    if (Post(task) != LLBC_OK)
+    {
+        LLBC_Delete(task);
+        return LLBC_FAILED;
+    }
+
+    return LLBC_OK;
+}
+
+size_t LLBC_Service::GetCoroCount() const
+{
+    return _coros.size();
+}
+
 void LLBC_Service::OnSvc(bool fullFrame)
 {
     if (UNLIKELY(!_started))
@@ -938,9 +1705,10 @@ void LLBC_Service::OnSvc(bool fullFrame)
     }
 
     _sinkIntoLoop = true;
+    _svcTls = __LLBC_GetLibTls();
 
-    // Record begin heartbeat time.
-    _begHeartbeatTime = LLBC_GetMilliSeconds();
+    // Record begin heartbeat time, and cache it as frame time(timers read it from TLS).
+    _begHeartbeatTime = LLBC_CacheMonoMilliSeconds();
 
     // Handle before frame-tasks.
     HandleFrameTasks(_beforeFrameTasks, _handlingBeforeFrameTasks);
@@ -960,22 +1728,48 @@ void LLBC_Service::OnSvc(bool fullFrame)
     HandleFrameTasks(_afterFrameTasks, _handlingAfterFrameTasks);
     _handledBeforeFrameTasks = false;
 
-    // Process Idle.
+    // Flush coalesced packets at frame end.
+    if (!_coalescedBatches.empty())
+        FlushCoalescedSend(_FrameEndFlush);
+
+    // Process Idle, the packets sent in idle also need to flush.
     ProcessIdle();
+    if (!_coalescedBatches.empty())
+        FlushCoalescedSend(_FrameEndFlush);
 
-    // Sleep FrameInterval - ElapsedTime milli-seconds, if need.
-    if (fullFrame)
+    // Dump traffic statistic, if need.
+    if (_trafficStatDumpInterval > 0)
+        CheckTrafficStatDump();
+
+    // Sleep FrameInterval - ElapsedTime milli-seconds(event-drive service wait events), if need.
+    if (fullFrame && _driveMode == This::EventDrive)
+    {
+        WaitAndHandleQueuedEvents();
+    }
+    else if (fullFrame)
     {
-        const sint64 elapsed = LLBC_GetMilliSeconds() - _begHeartbeatTime;
+        const sint64 elapsed = LLBC_GetMonoMilliSeconds() - _begHeartbeatTime;
         if (elapsed >= 0 && elapsed < _frameInterval)
             LLBC_Sleep(static_cast<int>(_frameInterval - elapsed));
     }
 
+    // Frame finished, the timers scheduled out of frame read real time.
+    LLBC_UncacheMonoMilliSeconds();
+
     _sinkIntoLoop = false;
     if (UNLIKELY(_afterStop))
         Cleanup();
 }
 
+void LLBC_Service::Push(LLBC_ServiceEvent *ev)
+{
+    // Service poll event queue every frame, only need to notify waiting event-drive service
+    // when queue become not empty.
+    if (_evQueue.Push(ev) &&
+        LLBC_AtomicGet(&_evWaiting) != 0)
+        _evSem.Post();
+}
+
 LLBC_ProtocolStack *LLBC_Service::CreateRawStack(LLBC_ProtocolStack *stack)
 {
     if (!stack)
@@ -990,8 +1784,18 @@ LLBC_ProtocolStack *LLBC_Service::CreateRawStack(LLBC_ProtocolStack *stack)
     }
     else
     {
-        stack->AddProtocol(LLBC_IProtocol::Create<LLBC_PacketProtocol>(_filters[LLBC_ProtocolLayer::PackLayer]));
-        stack->AddProtocol(LLBC_IProtocol::Create<LLBC_CompressProtocol>(_filters[LLBC_ProtocolLayer::CompressLayer]));
+        LLBC_IProtocol *packetProto =
+            LLBC_IProtocol::Create<LLBC_PacketProtocol>(_filters[LLBC_ProtocolLayer::PackLayer]);
+        static_cast<LLBC_PacketProtocol *>(packetProto)->SetMaxPacketLen(_maxPacketLen);
+        static_cast<LLBC_PacketProtocol *>(packetProto)->SetRecvChunkSize(_chunkedRecv ? _recvChunkSize : 0);
+
+        stack->AddProtocol(packetProto);
+        LLBC_IProtocol *compressProto =
+            LLBC_IProtocol::Create<LLBC_CompressProtocol>(_filters[LLBC_ProtocolLayer::CompressLayer]);
+        static_cast<LLBC_CompressProtocol *>(compressProto)->SetCompressPolicy(
+            _compressPolicy, _compressThreshold, &_opcodeCompressPolicies);
+
+        stack->AddProtocol(compressProto);
     }
 
     return stack;
@@ -1008,11 +1812,9 @@ LLBC_ProtocolStack *LLBC_Service::CreateCodecStack(LLBC_ProtocolStack *stack)
 
     if (_type != This::Raw)
     {
+        // Coders compiled to dispatch table when service starting, codec protocol find coder in it.
         stack->AddProtocol(LLBC_IProtocol::Create<LLBC_CodecProtocol>(_filters[LLBC_ProtocolLayer::CodecLayer]));
-        for (_Coders::iterator it = _coders.begin();
-             it != _coders.end();
-             it++)
-            stack->AddCoder(it->first, it->second);
+        stack->SetDispatchTable(&_dispatchTable);
     }
 
     return stack;
@@ -1051,6 +1853,23 @@ void LLBC_Service::Svc()
 
 void LLBC_Service::Cleanup()
 {
+    // Stop dispatch workers firstly, the not handled session-local packets will be discarded.
+    StopDispatchWorkers();
+
+    // Cancel all coroutines, awaiting coroutines will be resumed and awaits fail.
+    CancelCoros();
+
+    // Wait all lock-free sending operations finished(_stopping flag already set, no new sending can enter).
+    while (LLBC_AtomicGet(&_sendingCount) > 0)
+        LLBC_ThreadManager::Sleep(0);
+
+    // Delete all not flushed coalesced packets.
+    for (_CoalescedBatches::iterator it = _coalescedBatches.begin();
+         it != _coalescedBatches.end();
+         it++)
+        LLBC_STLHelper::DeleteContainer(it->second.packets);
+    _coalescedBatches.clear();
+
     // Stop poller manager.
     _pollerMgr.Stop();
 
@@ -1058,10 +1877,8 @@ void LLBC_Service::Cleanup()
     if (_driveMode == This::ExternalDrive)
         _timerScheduler->CancelAll();
 
-    // Cleanup connected-sessionIds set.
-    _connectedSessionIdsLock.Lock();
-    _connectedSessionIds.clear();
-    _connectedSessionIdsLock.Unlock();
+    // Cleanup connected-sessionIds table.
+    _connectedSessionIds.Clear();
 
     // Stop facades, destroy release-pool, and remove service from TLS.
     StopFacades();
@@ -1071,12 +1888,17 @@ void LLBC_Service::Cleanup()
     RemoveServiceFromTls();
 
     // Popup & Destroy all not-process events.
-    LLBC_MessageBlock *block;
-    while (TryPop(block) == LLBC_OK)
-        LLBC_SvcEvUtil::DestroyEvBlock(block);
+    LLBC_ServiceEvent *ev = _evQueue.PopAll();
+    while (ev)
+    {
+        LLBC_ServiceEvent *next = ev->next;
+        LLBC_Delete(ev);
+
+        ev = next;
+    }
 
     // If is self-drive servie, notify service manager self stopped.
-    if (_driveMode == This::SelfDrive)
+    if (_driveMode != This::ExternalDrive)
     {
         _timerScheduler = NULL;
         _svcMgr.OnServiceStop(this);
@@ -1147,18 +1969,60 @@ void LLBC_Service::DestroyFrameTasks(_FrameTasks &tasks, bool &usingFlag)
 
 void LLBC_Service::HandleQueuedEvents()
 {
-    int type;
+    // The events pushed in event handlers will be handled in next PopAll() call.
     LLBC_ServiceEvent *ev;
-    LLBC_MessageBlock *block;
-    while (TryPop(block) == LLBC_OK)
+    while ((ev = _evQueue.PopAll()))
     {
-        block->Read(&type, sizeof(int));
-        block->Read(&ev, sizeof(LLBC_ServiceEvent *));
+        while (ev)
+        {
+            LLBC_ServiceEvent *next = ev->next;
+            (this->*_evHandlers[ev->type])(*ev);
 
-        (this->*_evHandlers[type])(*ev);
+            LLBC_Delete(ev);
+            ev = next;
+        }
 
-        LLBC_Delete(ev);
-        LLBC_Delete(block);
+        // Check coalesced packets latency once per events batch.
+        if (!_coalescedBatches.empty())
+            CheckCoalescedSendLatency();
+    }
+}
+
+void LLBC_Service::WaitAndHandleQueuedEvents()
+{
+    const sint64 frameEndTime = _begHeartbeatTime + _frameInterval;
+    while (!_stopping)
+    {
+        // Wait until frame end or the nearest timer timeout, refresh frame time after every wakeup.
+        const sint64 now = LLBC_CacheMonoMilliSeconds();
+        if (now >= frameEndTime)
+            break;
+
+        sint64 deadline = frameEndTime;
+        const sint64 timeoutTime = _timerScheduler->GetNextTimeoutTime();
+        if (timeoutTime >= 0 && timeoutTime < deadline)
+            deadline = timeoutTime;
+
+        if (deadline > now)
+        {
+            // Set waiting flag before check queue, Push() check the flag after pushed(both full barrier),
+            // so the event pushed after checked will always post semaphore.
+            LLBC_AtomicFetchAndAdd(&_evWaiting, 1);
+            if (_evQueue.IsEmpty())
+                _evSem.TimedWait(static_cast<int>(deadline - now));
+
+            LLBC_AtomicFetchAndSub(&_evWaiting, 1);
+
+            // Drain the redundant posts, the events already pushed will be handled below.
+            while (_evSem.TryWait())
+                ;
+        }
+
+        // Handle arrived events, timeout timers, and flush the packets sent in handlers.
+        HandleQueuedEvents();
+        UpdateTimers();
+        if (!_coalescedBatches.empty())
+            FlushCoalescedSend(_FrameEndFlush);
     }
 }
 
@@ -1167,11 +2031,7 @@ void LLBC_Service::HandleEv_SessionCreate(LLBC_ServiceEvent &_)
     typedef LLBC_SvcEv_SessionCreate _Ev;
     _Ev &ev = static_cast<_Ev &>(_);
 
-    {
-        _connectedSessionIdsLock.Lock();
-        _connectedSessionIds.insert(ev.sessionId);
-        _connectedSessionIdsLock.Unlock();
-    }
+    _connectedSessionIds.Insert(ev.sessionId);
 
     LLBC_SessionInfo info;
     info.SetSessionId(ev.sessionId);
@@ -1191,10 +2051,8 @@ void LLBC_Service::HandleEv_SessionDestroy(LLBC_ServiceEvent &_)
     typedef LLBC_SvcEv_SessionDestroy _Ev;
     _Ev &ev = static_cast<_Ev &>(_);
 
-    // Erase session from connected sessionIds set.
-    _connectedSessionIdsLock.Lock();
-    _connectedSessionIds.erase(ev.sessionId);
-    _connectedSessionIdsLock.Unlock();
+    // Erase session from connected sessionIds table.
+    _connectedSessionIds.Remove(ev.sessionId);
 
     // Build session info.
     LLBC_SessionInfo *sessionInfo = LLBC_New(LLBC_SessionInfo);
@@ -1205,7 +2063,7 @@ void LLBC_Service::HandleEv_SessionDestroy(LLBC_ServiceEvent &_)
     sessionInfo->SetSocket(ev.handle);
 
     // Build session destroy info.
-    LLBC_SessionDestroyInfo destroyInfo(sessionInfo, ev.closeInfo);
+    LLBC_SessionDestroyInfo destroyInfo(sessionInfo, ev.closeInfo, ev.recvStat);
     ev.closeInfo = NULL;
 
     // Dispatch destroy event to all facades.
@@ -1213,6 +2071,14 @@ void LLBC_Service::HandleEv_SessionDestroy(LLBC_ServiceEvent &_)
          it != _facades.end();
          it++)
         (*it)->OnSessionDestroy(destroyInfo);
+
+    // The session packets never arrive, resume the session packet awaiting coroutines.
+    if (!_coroPacketAwaiters.empty())
+        ResumeSessionPacketAwaiters(ev.sessionId);
+
+    // Facades already seen the session final traffic, remove session counters.
+    if (_trafficStat)
+        _trafficStat->RemoveSession(ev.sessionId);
 }
 
 void LLBC_Service::HandleEv_AsyncConnResult(LLBC_ServiceEvent &_)
@@ -1240,16 +2106,36 @@ void LLBC_Service::HandleEv_DataArrival(LLBC_ServiceEvent &_)
     // Makesure session in connected sessionId set.
     const int sessionId = packet->GetSessionId();
 
-    _connectedSessionIdsLock.Lock();
-    if (_connectedSessionIds.find(sessionId) == 
-        _connectedSessionIds.end())
+    if (!_connectedSessionIds.IsExist(sessionId))
+        return;
+
+    ev.packet = NULL;
+
+    // Correlation matched packet resume awaiting coroutine, not dispatch to handlers.
+    if (!_coroPacketAwaiters.empty() &&
+        ResumePacketAwaiter(packet))
+        return;
+
+    // Session-local packet dispatch to session-affine worker, keep per-session order.
+    if (!_dispatchWorkers.empty() &&
+        _dispatchTable.Find(packet->GetOpcode()).sessionLocal)
     {
-        _connectedSessionIdsLock.Unlock();
+        _dispatchWorkers[sessionId % _dispatchWorkers.size()]->PushEvent(
+            LLBC_SvcEvUtil::BuildDataArrivalEv(packet));
         return;
     }
-    _connectedSessionIdsLock.Unlock();
 
-    ev.packet = NULL;
+    DispatchPacket(packet);
+}
+
+void LLBC_Service::DispatchPacket(LLBC_Packet *packet)
+{
+    const int sessionId = packet->GetSessionId();
+
+    // Traffic statistic only time sampled packets.
+    const bool timing = _trafficStat && _trafficStat->IsRecvTimingSample();
+    sint64 timingBegTime = timing ? LLBC_GetMicroSeconds() : 0;
+    sint64 decodeTime = -1;
 
 #if !LLBC_CFG_COMM_USE_FULL_STACK
     bool removeSession;
@@ -1260,27 +2146,39 @@ void LLBC_Service::HandleEv_DataArrival(LLBC_ServiceEvent &_)
 
         return;
     }
+
+    if (timing)
+    {
+        const sint64 now = LLBC_GetMicroSeconds();
+        decodeTime = MAX(now - timingBegTime, 0);
+        timingBegTime = now;
+    }
 #endif
 
-    // Create invoke-guard to delete packet.
-    LLBC_InvokeGuard delPacketGuard(&LLBC_INL_NS __DeletePacket, packet);
+    // Create guard to delete packet, and traffic recorder(destruct before packet deleted).
+    LLBC_INL_NS __PacketDeleteGuard delPacketGuard(packet);
+    LLBC_INL_NS __RecvTrafficRecorder trafficRecorder(_trafficStat, *packet, timingBegTime, decodeTime);
 
     const int opcode = packet->GetOpcode();
+    const LLBC_OpcodeDispatchEntry &dispatchEntry = _dispatchTable.Find(opcode);
 
 #if LLBC_CFG_COMM_ENABLE_STATUS_HANDLER || LLBC_CFG_COMM_ENABLE_STATUS_DESC
     const int status = packet->GetStatus();
     if (status != 0)
     {
 # if LLBC_CFG_COMM_ENABLE_STATUS_DESC
-        _StatusDescs::const_iterator statusDescIt = _statusDescs.find(status);
-        if (statusDescIt != _statusDescs.end())
-            packet->SetStatusDesc(statusDescIt->second);
+        if (dispatchEntry.statusDescs)
+        {
+            const _StatusDescs &statusDescs = *dispatchEntry.statusDescs;
+            _StatusDescs::const_iterator statusDescIt = statusDescs.find(status);
+            if (statusDescIt != statusDescs.end())
+                packet->SetStatusDesc(statusDescIt->second);
+        }
 # endif // LLBC_CFG_COMM_ENABLE_STATUS_DESC
 # if LLBC_CFG_COMM_ENABLE_STATUS_HANDLER
-        _OpStatusHandlers::iterator stHandlersIt = _statusHandlers.find(opcode);
-        if (stHandlersIt != _statusHandlers.end())
+        if (dispatchEntry.statusHandlers)
         {
-            _StatusHandlers &stHandlers = *stHandlersIt->second;
+            _StatusHandlers &stHandlers = *dispatchEntry.statusHandlers;
             _StatusHandlers::iterator stHandlerIt = stHandlers.find(status);
             if (stHandlerIt != stHandlers.end())
             {
@@ -1296,10 +2194,9 @@ void LLBC_Service::HandleEv_DataArrival(LLBC_ServiceEvent &_)
     bool preHandled = false;
     if (_type != This::Raw)
     {
-        _PreHandlers::iterator preIt = _preHandlers.find(opcode);
-        if (preIt != _preHandlers.end())
+        if (dispatchEntry.preHandler)
         {
-            if (!preIt->second->Invoke(*packet))
+            if (!dispatchEntry.preHandler->Invoke(*packet))
                 return;
 
             preHandled = true;
@@ -1314,10 +2211,15 @@ void LLBC_Service::HandleEv_DataArrival(LLBC_ServiceEvent &_)
     }
 #endif // LLBC_CFG_COMM_ENABLE_UNIFY_PRESUBSCRIBE
 
-    _Handlers::iterator it = _handlers.find(opcode);
-    if (it != _handlers.end())
+    if (dispatchEntry.coro)
+    {
+        // Coroutine handler task take over packet.
+        delPacketGuard.Release();
+        Go(LLBC_New2(LLBC_INL_NS __CoroHandlerTask, dispatchEntry.handler, packet));
+    }
+    else if (dispatchEntry.handler)
     {
-        it->second->Invoke(*packet);
+        dispatchEntry.handler->Invoke(*packet);
     }
     else
     {
@@ -1346,6 +2248,28 @@ void LLBC_Service::HandleEv_ProtoReport(LLBC_ServiceEvent &_)
         (*it)->OnProtoReport(report);
 }
 
+void LLBC_Service::HandleEv_SessionBackpressure(LLBC_ServiceEvent &_)
+{
+    typedef LLBC_SvcEv_SessionBackpressure _Ev;
+    _Ev &ev = static_cast<_Ev &>(_);
+
+    // Session maybe removed by service, ignore it.
+    if (!_connectedSessionIds.IsExist(ev.sessionId))
+        return;
+
+    LLBC_SessionBackpressureInfo info;
+    info.SetSessionId(ev.sessionId);
+    info.SetIsBackpressured(ev.backpressured);
+    info.SetQueueSize(ev.queueSize);
+    info.SetDroppedPackets(ev.droppedPackets);
+    info.SetCoalescedPackets(ev.coalescedPackets);
+
+    for (_Facades::iterator it = _facades.begin();
+         it != _facades.end();
+         it++)
+        (*it)->OnSessionBackpressure(info);
+}
+
 void LLBC_Service::HandleEv_SubscribeEv(LLBC_ServiceEvent &_)
 {
     typedef LLBC_SvcEv_SubscribeEv _Ev;
@@ -1360,19 +2284,105 @@ void LLBC_Service::HandleEv_UnsubscribeEv(LLBC_ServiceEvent &_)
     typedef LLBC_SvcEv_UnsubscribeEv _Ev;
     _Ev &ev = static_cast<_Ev &>(_);
 
-    if (ev.stub.empty())
-        _evManager.RemoveListener(ev.id);
-    else
-        _evManager.RemoveListener(ev.stub);
+    if (ev.stub.empty())
+        _evManager.RemoveListener(ev.id);
+    else
+        _evManager.RemoveListener(ev.stub);
+}
+
+void LLBC_Service::HandleEv_FireEv(LLBC_ServiceEvent &_)
+{
+    typedef LLBC_SvcEv_FireEv _Ev;
+    _Ev &ev = static_cast<_Ev &>(_);
+
+    _evManager.FireEvent(ev.ev);
+    ev.ev = NULL;
+}
+
+void LLBC_Service::CompileDispatchTable()
+{
+    typedef LLBC_OpcodeDispatchTable::Entries _Entries;
+
+    _Entries entries;
+    for (_Coders::iterator it = _coders.begin();
+         it != _coders.end();
+         it++)
+        entries[it->first].coder = it->second;
+    for (_Handlers::iterator it = _handlers.begin();
+         it != _handlers.end();
+         it++)
+        entries[it->first].handler = it->second;
+    for (_PreHandlers::iterator it = _preHandlers.begin();
+         it != _preHandlers.end();
+         it++)
+        entries[it->first].preHandler = it->second;
+#if LLBC_CFG_COMM_ENABLE_STATUS_HANDLER
+    for (_OpStatusHandlers::iterator it = _statusHandlers.begin();
+         it != _statusHandlers.end();
+         it++)
+        entries[it->first].statusHandlers = it->second;
+#endif // LLBC_CFG_COMM_ENABLE_STATUS_HANDLER
+
+    for (std::set<int>::iterator it = _sessionLocalOpcodes.begin();
+         it != _sessionLocalOpcodes.end();
+         it++)
+        entries[*it].sessionLocal = true;
+
+    // Coroutine handlers always run in service thread.
+    for (std::set<int>::iterator it = _coroOpcodes.begin();
+         it != _coroOpcodes.end();
+         it++)
+    {
+        LLBC_OpcodeDispatchEntry &entry = entries[*it];
+        entry.coro = true;
+        entry.sessionLocal = false;
+    }
+
+    // All entries(include default entry of not subscribed opcodes) hold status descs.
+    LLBC_OpcodeDispatchEntry dftEntry;
+    LLBC_MemSet(&dftEntry, 0, sizeof(dftEntry));
+#if LLBC_CFG_COMM_ENABLE_STATUS_DESC
+    if (!_statusDescs.empty())
+    {
+        dftEntry.statusDescs = &_statusDescs;
+        for (_Entries::iterator it = entries.begin();
+             it != entries.end();
+             it++)
+            it->second.statusDescs = &_statusDescs;
+    }
+#endif // LLBC_CFG_COMM_ENABLE_STATUS_DESC
+
+    _dispatchTable.Compile(entries, &dftEntry);
+}
+
+int LLBC_Service::StartDispatchWorkers()
+{
+    for (int i = 0; i < _dispatchWorkerCount; i++)
+    {
+        LLBC_ServiceWorker *worker = LLBC_New1(LLBC_ServiceWorker, this);
+        if (worker->Start() != LLBC_OK)
+        {
+            LLBC_Delete(worker);
+            StopDispatchWorkers();
+
+            return LLBC_FAILED;
+        }
+
+        _dispatchWorkers.push_back(worker);
+    }
+
+    return LLBC_OK;
 }
 
-void LLBC_Service::HandleEv_FireEv(LLBC_ServiceEvent &_)
+void LLBC_Service::StopDispatchWorkers()
 {
-    typedef LLBC_SvcEv_FireEv _Ev;
-    _Ev &ev = static_cast<_Ev &>(_);
+    for (size_t i = 0; i < _dispatchWorkers.size(); i++)
+    {
+        _dispatchWorkers[i]->Stop();
+        LLBC_Delete(_dispatchWorkers[i]);
+    }
 
-    _evManager.FireEvent(ev.ev);
-    ev.ev = NULL;
+    _dispatchWorkers.clear();
 }
 
 void LLBC_Service::InitFacades()
@@ -1441,7 +2451,7 @@ void LLBC_Service::CreateAutoReleasePool()
 
 void LLBC_Service::UpdateAutoReleasePool()
 {
-    if (_driveMode == This::SelfDrive)
+    if (_driveMode != This::ExternalDrive)
         _releasePoolStack->Purge();
 }
 
@@ -1465,37 +2475,36 @@ void LLBC_Service::GetTimerScheduler()
 
 void LLBC_Service::UpdateTimers()
 {
+    // Timer scheduler read the frame cached time, not read clock again.
     _timerScheduler->Update();
 }
 
 void LLBC_Service::ProcessIdle()
 {
+    // Idle time computed once from frame cached time, all facades got same idle time.
+    const sint64 elapsed = LLBC_GetCachedMonoMilliSeconds() - _begHeartbeatTime;
+    if (UNLIKELY(elapsed < 0 || elapsed >= _frameInterval))
+        return;
+
+    const int idleTime = static_cast<int>(_frameInterval - elapsed);
     for (_Facades::iterator it = _facades.begin();
          it != _facades.end();
          it++)
-    {
-        sint64 elapsed = LLBC_GetMilliSeconds() - _begHeartbeatTime;
-        if (LIKELY(elapsed >= 0))
-        {
-            if (elapsed >= _frameInterval)
-                break;
-
-            (*it)->OnIdle(static_cast<int>(_frameInterval - elapsed));
-        }
-    }
+        (*it)->OnIdle(idleTime);
 }
 
 int LLBC_Service::LockableSend(LLBC_Packet *packet,
                                bool lock,
                                bool validCheck)
 {
+    // Enter lock-free send guard, Cleanup() will wait all guarded sending finished before stop pollers.
     if (lock)
-        _lock.Lock();
+        LLBC_AtomicFetchAndAdd(&_sendingCount, 1);
 
-    if (UNLIKELY(!_started))
+    if (UNLIKELY(!_started || _stopping))
     {
         if (lock)
-            _lock.Unlock();
+            LLBC_AtomicFetchAndSub(&_sendingCount, 1);
 
         LLBC_Delete(packet);
 
@@ -1504,47 +2513,51 @@ int LLBC_Service::LockableSend(LLBC_Packet *packet,
     }
 
     const int sessionId = packet->GetSessionId();
-    if (validCheck)
+    if (validCheck && !_connectedSessionIds.IsExist(sessionId))
     {
-        LLBC_Guard connSIdsGuard(_connectedSessionIdsLock);
-        if (_connectedSessionIds.find(sessionId) == _connectedSessionIds.end())
-        {
-            if (lock)
-                _lock.Unlock();
+        if (lock)
+            LLBC_AtomicFetchAndSub(&_sendingCount, 1);
 
-            LLBC_Delete(packet);
+        LLBC_Delete(packet);
 
-            LLBC_SetLastError(LLBC_ERROR_NOT_FOUND);
-            return LLBC_FAILED;
-        }
+        LLBC_SetLastError(LLBC_ERROR_NOT_FOUND);
+        return LLBC_FAILED;
     }
 
 #if !LLBC_CFG_COMM_USE_FULL_STACK
+    // Traffic statistic only time sampled packets.
+    const bool timing = _trafficStat && _trafficStat->IsSendTimingSample();
+    const sint64 encodeBegTime = timing ? LLBC_GetMicroSeconds() : 0;
+
     bool removeSession;
     LLBC_Packet *encoded;
     if (_stack.SendCodec(packet, encoded, removeSession) != LLBC_OK)
     {
+        if (lock)
+            LLBC_AtomicFetchAndSub(&_sendingCount, 1);
+
         if (removeSession)
             RemoveSession(sessionId, LLBC_FormatLastError());
 
-        if (lock)
-            _lock.Unlock();
-
         return LLBC_FAILED;
     }
 
-    const int ret = _pollerMgr.Send(encoded);
-    if (lock)
-        _lock.Unlock();
+    if (_trafficStat)
+        _trafficStat->OnSent(sessionId,
+                             encoded->GetOpcode(),
+                             encoded->GetPayloadLength(),
+                             timing ? MAX(LLBC_GetMicroSeconds() - encodeBegTime, 0) : -1);
 
-    return ret;
+    LLBC_Packet *sending = encoded;
 #else
-    const int ret = _pollerMgr.Send(packet);
+    LLBC_Packet *sending = packet;
+#endif
+    const int ret = _coalescedSend && IsCanCoalesceSend() ?
+        CoalesceSend(sending) : _pollerMgr.Send(sending);
     if (lock)
-        _lock.Unlock();
+        LLBC_AtomicFetchAndSub(&_sendingCount, 1);
 
     return ret;
-#endif
 }
 
 int LLBC_Service::LockableSend(int svcId,
@@ -1572,9 +2585,8 @@ int LLBC_Service::LockableSend(int svcId,
     return LockableSend(packet, lock, validCheck);
 }
 
-template <typename SessionIds>
 int LLBC_Service::MulticastSendCoder(int svcId,
-                                     const SessionIds &sessionIds,
+                                     const LLBC_SessionIdList &sessionIds,
                                      int opcode,
                                      LLBC_ICoder *coder,
                                      int status,
@@ -1599,105 +2611,488 @@ int LLBC_Service::MulticastSendCoder(int svcId,
         return LLBC_FAILED;
     }
 
-    typename SessionIds::const_iterator sessionIt = sessionIds.begin();
-
-    LLBC_Packet *firstPacket = LLBC_New(LLBC_Packet);
-    firstPacket->SetHeader(svcId, *sessionIt++, opcode, status);
+    LLBC_Packet *packet = LLBC_New(LLBC_Packet);
+    packet->SetHeader(svcId, 0, opcode, status);
     if (parts && _type != This::Raw)
-        parts->SetToPacket(*firstPacket);
+        parts->SetToPacket(*packet);
 
-    bool hasCoder = true;
+    // Encode only once, all sessions share the encoded data.
     if (LIKELY(coder))
     {
-        if (!coder->Encode(*firstPacket))
+        if (!coder->Encode(*packet))
         {
+            LLBC_Delete(coder);
+            LLBC_Delete(packet);
+
             LLBC_SetLastError(LLBC_ERROR_ENCODE);
             return LLBC_FAILED;
         }
 
         LLBC_Delete(coder);
     }
-    else
+
+    return SharedMulticast(packet, sessionIds, validCheck);
+}
+
+int LLBC_Service::MulticastSendBytes(int svcId,
+                                     const LLBC_SessionIdList &sessionIds,
+                                     int opcode,
+                                     const void *bytes,
+                                     size_t len,
+                                     int status,
+                                     const LLBC_PacketHeaderParts *parts,
+                                     bool validCheck)
+{
+    if (sessionIds.empty())
+        return LLBC_OK;
+
+    LLBC_Guard guard(_lock);
+
+    LLBC_Packet *packet = LLBC_New(LLBC_Packet);
+    packet->SetHeader(svcId, 0, opcode, status);
+    if (parts && _type != This::Raw)
+        parts->SetToPacket(*packet);
+
+    if (UNLIKELY(packet->Write(bytes, len) != LLBC_OK))
+    {
+        LLBC_Delete(packet);
+        return LLBC_FAILED;
+    }
+
+    return SharedMulticast(packet, sessionIds, validCheck);
+}
+
+LLBC_Service::_Coro *LLBC_Service::GetCurrentCoro()
+{
+    if (UNLIKELY(_coroCancelling))
     {
-        hasCoder = false;
+        LLBC_SetLastError(LLBC_ERROR_NOT_ALLOW);
+        return NULL;
     }
 
-    typename SessionIds::size_type sessionCnt = sessionIds.size();
-    if (sessionCnt == 1)
-        return LockableSend(firstPacket, false, validCheck);
+    LLBC_Coro *running = LLBC_Coro::GetCurrent();
+    if (UNLIKELY(!running ||
+        !_sinkIntoLoop || _svcTls != __LLBC_GetLibTls()))
+    {
+        LLBC_SetLastError(LLBC_ERROR_ILLEGAL);
+        return NULL;
+    }
 
-    LLBC_Packet **otherPackets =
-        LLBC_Calloc(LLBC_Packet *, (sizeof(LLBC_Packet *) * (sessionCnt - 1)));
-    if (LIKELY(hasCoder))
+    std::map<int, _Coro *>::iterator it = _coros.find(running->GetId());
+    if (UNLIKELY(it == _coros.end()))
     {
-        const void *payload = firstPacket->GetPayload();
-        const size_t payloadLen = firstPacket->GetPayloadLength();
+        LLBC_SetLastError(LLBC_ERROR_ILLEGAL);
+        return NULL;
+    }
 
-        if (validCheck)
-            _connectedSessionIdsLock.Lock();
+    return it->second;
+}
 
-        for (register typename SessionIds::size_type i = 1;
-             i < sessionCnt;
-             i++)
+int LLBC_Service::AwaitCoro(_Coro *coro, int awaitType, int timeout)
+{
+    if (timeout >= 0)
+    {
+        if (!coro->timer)
         {
-            const int sessionId = *sessionIt++;
-            if (validCheck &&
-                _connectedSessionIds.find(sessionId) == _connectedSessionIds.end())
-                    continue;
+            typedef LLBC_Delegate1<_Coro, LLBC_Timer *> _TimeoutDeleg;
+            coro->timer = LLBC_New2(LLBC_Timer, new _TimeoutDeleg(coro, &_Coro::OnTimeout), NULL);
+        }
 
-            LLBC_Packet *otherPacket = LLBC_New(LLBC_Packet);
-            otherPacket->SetHeader(svcId, sessionId, opcode, status);
-            otherPacket->Write(payload, payloadLen);
+        if (coro->timer->Schedule(timeout) != LLBC_OK)
+        {
+            if (awaitType == _CoroAwaitPacket)
+                _coroPacketAwaiters.erase(std::make_pair(coro->sessionId, coro->correlationId));
 
-            otherPackets[i - 1] = otherPacket;
+            return LLBC_FAILED;
         }
-
-        if (validCheck)
-            _connectedSessionIdsLock.Unlock();
     }
-    else
+
+    // Suspend, until service resume coroutine in later frame.
+    coro->awaitType = awaitType;
+    coro->error = LLBC_OK;
+    LLBC_Coro::Suspend();
+
+    if (coro->timer && coro->timer->IsScheduling())
+        coro->timer->Cancel();
+
+    if (coro->error != LLBC_OK)
     {
-        if (validCheck)
-            _connectedSessionIdsLock.Lock();
+        LLBC_SetLastError(coro->error);
+        return LLBC_FAILED;
+    }
 
-        for (register typename SessionIds::size_type i = 1;
-             i < sessionCnt;
-             i++)
-        {
-            const int sessionId = *sessionIt++;
-            if (validCheck &&
-                _connectedSessionIds.find(sessionId) == _connectedSessionIds.end())
-                continue;
+    return LLBC_OK;
+}
+
+int LLBC_Service::ResumeCoro(_Coro *coro, int error)
+{
+    // Await failed, the packet awaiter no longer wait packet.
+    if (coro->awaitType == _CoroAwaitPacket && error != LLBC_OK)
+        _coroPacketAwaiters.erase(std::make_pair(coro->sessionId, coro->correlationId));
 
-            LLBC_Packet *otherPacket = LLBC_New(LLBC_Packet);
-            otherPacket->SetHeader(svcId, sessionId, opcode, status);
-            if (parts && _type != This::Raw)
-                parts->SetToPacket(*otherPacket);
+    coro->awaitType = _CoroAwaitNone;
+    coro->error = error;
 
-            otherPackets[i - 1] = otherPacket;
+    LLBC_Coro *c = coro->coro;
+    if (c->Resume() != LLBC_OK)
+    {
+        // Coroutine create context failed, destroy it.
+        if (c->GetState() == LLBC_Coro::Ready)
+        {
+            const int errNo = LLBC_GetLastError();
+            DestroyCoro(coro);
+            LLBC_SetLastError(errNo);
         }
 
-        if (validCheck)
-            _connectedSessionIdsLock.Unlock();
+        return LLBC_FAILED;
+    }
+
+    if (c->GetState() == LLBC_Coro::Dead)
+        DestroyCoro(coro);
+
+    return LLBC_OK;
+}
+
+bool LLBC_Service::ResumePacketAwaiter(LLBC_Packet *packet)
+{
+    const int sessionId = packet->GetSessionId();
+    _CoroPacketAwaiters::iterator it = _coroPacketAwaiters.find(
+        std::make_pair(sessionId, packet->GetHeaderPartAsSInt64(_coroCorrelationPart)));
+    if (it == _coroPacketAwaiters.end())
+        return false;
+
+    _Coro *coro = it->second;
+    _coroPacketAwaiters.erase(it);
+
+#if !LLBC_CFG_COMM_USE_FULL_STACK
+    // Decode failed(packet deleted by codec layer), resume coroutine with decode error, not left it
+    // awaiting until timeout.
+    bool removeSession;
+    if (UNLIKELY(_stack.RecvCodec(packet, packet, removeSession) != LLBC_OK))
+    {
+        const int errNo = LLBC_GetLastError();
+        if (removeSession)
+            RemoveSession(sessionId);
+
+        ResumeCoro(coro, errNo != LLBC_OK ? errNo : LLBC_ERROR_DECODE);
+
+        return true;
+    }
+#endif
+
+    // Record traffic before coroutine take over packet.
+    {
+        LLBC_INL_NS __RecvTrafficRecorder trafficRecorder(_trafficStat, *packet, 0, -1);
     }
 
-    LockableSend(firstPacket, false, validCheck); // Use pass "validCheck" argument to call LockableSend().
+    coro->packet = packet;
+    ResumeCoro(coro, LLBC_OK);
+
+    return true;
+}
 
-    const size_t otherPacketCnt = sessionCnt - 1;
-    for (register size_t i = 0; i < otherPacketCnt; i++)
+void LLBC_Service::ResumeSessionPacketAwaiters(int sessionId)
+{
+    // Awaiters keyed by <sessionId, correlationId>, the session awaiters are contiguous.
+    while (true)
     {
-        LLBC_Packet *otherPacket = otherPackets[i];
-        if (!otherPacket)
-            continue;
+        _CoroPacketAwaiters::iterator it =
+            _coroPacketAwaiters.lower_bound(std::make_pair(sessionId, LLONG_MIN));
+        if (it == _coroPacketAwaiters.end() ||
+            it->first.first != sessionId)
+            break;
+
+        _Coro *coro = it->second;
+        _coroPacketAwaiters.erase(it);
+
+        ResumeCoro(coro, LLBC_ERROR_NOT_FOUND);
+    }
+}
+
+void LLBC_Service::HandlePostedCoroResult(int coroId, void *result)
+{
+    // Coroutine finished, discard result.
+    std::map<int, _Coro *>::iterator it = _coros.find(coroId);
+    if (it == _coros.end())
+        return;
+
+    _Coro *coro = it->second;
+    coro->result = result;
+    coro->posted = true;
+
+    if (coro->awaitType == _CoroAwaitResult)
+        ResumeCoro(coro, LLBC_OK);
+}
+
+void LLBC_Service::DestroyCoro(_Coro *coro)
+{
+    _coros.erase(coro->coro->GetId());
+    if (coro->awaitType == _CoroAwaitPacket)
+        _coroPacketAwaiters.erase(std::make_pair(coro->sessionId, coro->correlationId));
+
+    LLBC_XDelete(coro->timer);
+    LLBC_XDelete(coro->packet);
+    LLBC_Delete(coro->coro);
+    LLBC_Delete(coro);
+}
+
+void LLBC_Service::CancelCoros()
+{
+    _coroCancelling = true;
+    while (!_coros.empty())
+    {
+        _Coro *coro = _coros.begin()->second;
+        const int coroId = coro->coro->GetId();
+        if (coro->coro->GetState() == LLBC_Coro::Suspended)
+            ResumeCoro(coro, LLBC_ERROR_NOT_ALLOW);
+
+        // Coroutine still alive(suspend again without await), force destroy it.
+        std::map<int, _Coro *>::iterator it = _coros.find(coroId);
+        if (it != _coros.end())
+            DestroyCoro(it->second);
+    }
+
+    _coroCancelling = false;
+}
 
-        LockableSend(otherPacket, false, false); // Don't need vaildate check.
+bool LLBC_Service::IsCanCoalesceSend() const
+{
+    return _sinkIntoLoop && _svcTls == __LLBC_GetLibTls();
+}
+
+int LLBC_Service::CoalesceSend(LLBC_Packet *packet)
+{
+    const int sessionId = packet->GetSessionId();
+
+    _CoalescedBatch *batch;
+    _CoalescedBatches::iterator it = _coalescedBatches.find(sessionId);
+    if (it == _coalescedBatches.end())
+    {
+        // The first session batch is the oldest batch.
+        const sint64 now = LLBC_GetCachedMonoMilliSeconds();
+        if (_coalescedBatches.empty())
+            _coalescedBegTime = now;
+
+        batch = &_coalescedBatches[sessionId];
+        batch->bytes = 0;
+        batch->begTime = now;
     }
+    else
+    {
+        batch = &it->second;
+    }
+
+    batch->packets.push_back(packet);
+    batch->bytes += packet->GetPayloadLength();
 
-    LLBC_Free(otherPackets);
+    if (batch->bytes >= _coalescedSendMaxBytes)
+        FlushSessionCoalescedSend(sessionId, _BytesLimitFlush);
 
     return LLBC_OK;
 }
 
+void LLBC_Service::FlushCoalescedSend(int reason)
+{
+    if (_coalescedBatches.empty())
+        return;
+
+    for (_CoalescedBatches::iterator it = _coalescedBatches.begin();
+         it != _coalescedBatches.end();
+         it++)
+    {
+        const std::vector<LLBC_Packet *> &packets = it->second.packets;
+        _coalescedFlushPackets.insert(_coalescedFlushPackets.end(), packets.begin(), packets.end());
+    }
+
+    const size_t flushCount = _coalescedFlushPackets.size();
+    const sint64 latency = LLBC_GetCachedMonoMilliSeconds() - _coalescedBegTime;
+
+    // Packets will be grouped by poller, every poller only receive one send batch event.
+    _pollerMgr.SendBatch(_coalescedFlushPackets);
+    _coalescedFlushPackets.clear();
+    _coalescedBatches.clear();
+
+    UpdateCoalescedSendStat(flushCount, latency, reason);
+}
+
+void LLBC_Service::FlushSessionCoalescedSend(int sessionId, int reason)
+{
+    _CoalescedBatches::iterator it = _coalescedBatches.find(sessionId);
+    if (it == _coalescedBatches.end())
+        return;
+
+    const size_t flushCount = it->second.packets.size();
+    const sint64 latency = LLBC_GetCachedMonoMilliSeconds() - it->second.begTime;
+
+    _pollerMgr.SendBatch(it->second.packets);
+    _coalescedBatches.erase(it);
+
+    // Recalculate the oldest batch begin time.
+    for (it = _coalescedBatches.begin(); it != _coalescedBatches.end(); it++)
+        _coalescedBegTime = it == _coalescedBatches.begin() ?
+            it->second.begTime : MIN(_coalescedBegTime, it->second.begTime);
+
+    UpdateCoalescedSendStat(flushCount, latency, reason);
+}
+
+void LLBC_Service::UpdateCoalescedSendStat(size_t flushCount, sint64 latency, int reason)
+{
+    LLBC_Guard guard(_coalescedSendStatLock);
+    _coalescedSendStat.coalescedPackets += flushCount;
+    _coalescedSendStat.flushes += 1;
+    if (reason == _FrameEndFlush)
+    {
+        _coalescedSendStat.frameEndFlushes += 1;
+    }
+    else if (reason == _BytesLimitFlush)
+    {
+        _coalescedSendStat.bytesLimitFlushes += 1;
+        _coalescedSendStat.bytesLimitPackets += flushCount;
+    }
+    else if (reason == _LatencyLimitFlush)
+    {
+        _coalescedSendStat.latencyLimitFlushes += 1;
+    }
+    else
+    {
+        _coalescedSendStat.forceFlushes += 1;
+    }
+
+    if (latency > _coalescedSendStat.maxLatency)
+        _coalescedSendStat.maxLatency = latency;
+}
+
+void LLBC_Service::CheckTrafficStatDump()
+{
+    const sint64 now = LLBC_GetCachedMonoMilliSeconds();
+    if (_trafficStatDumpTime == 0)
+    {
+        _trafficStatDumpTime = now;
+        return;
+    }
+    else if (now - _trafficStatDumpTime < _trafficStatDumpInterval)
+    {
+        return;
+    }
+
+    _trafficStatDumpTime = now;
+
+    LLBC_LoggerManager *loggerMgr = LLBC_LoggerManagerSingleton;
+    if (!loggerMgr->IsInited())
+        return;
+
+    LLBC_Logger *logger = _trafficStatLoggerName.empty() ?
+        loggerMgr->GetRootLogger() : loggerMgr->GetLogger(_trafficStatLoggerName);
+    if (!logger)
+        return;
+
+    LLBC_TrafficStat stat;
+    _trafficStat->Snapshot(stat);
+    logger->Info(_name.c_str(), __FILE__, __LINE__, "Service traffic statistic:\n%s", stat.ToString().c_str());
+}
+
+void LLBC_Service::CheckCoalescedSendLatency()
+{
+    if (_coalescedSendMaxLatency == 0)
+        return;
+
+    // Only the sessions which oldest packet exceed latency limit will be flushed.
+    const sint64 now = LLBC_GetCachedMonoMilliSeconds();
+    if (now - _coalescedBegTime < _coalescedSendMaxLatency)
+        return;
+
+    std::vector<int> expiredSessionIds;
+    for (_CoalescedBatches::iterator it = _coalescedBatches.begin();
+         it != _coalescedBatches.end();
+         it++)
+    {
+        if (now - it->second.begTime >= _coalescedSendMaxLatency)
+            expiredSessionIds.push_back(it->first);
+    }
+
+    for (size_t i = 0; i < expiredSessionIds.size(); i++)
+        FlushSessionCoalescedSend(expiredSessionIds[i], _LatencyLimitFlush);
+}
+
+int LLBC_Service::SharedMulticast(LLBC_Packet *packet, const LLBC_SessionIdList &sessionIds, bool validCheck)
+{
+    if (UNLIKELY(!_started || _stopping))
+    {
+        LLBC_Delete(packet);
+
+        LLBC_SetLastError(LLBC_ERROR_NOT_INIT);
+        return LLBC_FAILED;
+    }
+
+    // Filter not connected sessions.
+    LLBC_SessionIdList validSessionIds;
+    const LLBC_SessionIdList *targets = &sessionIds;
+    if (validCheck)
+    {
+        validSessionIds.reserve(sessionIds.size());
+        for (LLBC_SessionIdListCIter sessionIt = sessionIds.begin();
+             sessionIt != sessionIds.end();
+             sessionIt++)
+        {
+            if (_connectedSessionIds.IsExist(*sessionIt))
+                validSessionIds.push_back(*sessionIt);
+        }
+
+        targets = &validSessionIds;
+    }
+
+    if (targets->empty())
+    {
+        LLBC_Delete(packet);
+        return LLBC_OK;
+    }
+
+    // Encoded data not contain session Id, use first session Id to report protocol error.
+    packet->SetSessionId(targets->front());
+    const int opcode = packet->GetOpcode();
+
+    // Use service owned stack to encode packet, compress policy already immutable after service started.
+    bool removeSession;
+    LLBC_MessageBlock *block;
+#if LLBC_CFG_COMM_USE_FULL_STACK
+    if (!_multicastStack)
+        _multicastStack = CreateFullStack();
+
+    if (_multicastStack->Send(packet, block, removeSession) != LLBC_OK)
+        return LLBC_FAILED;
+#else
+    if (!_multicastStack)
+        _multicastStack = CreateRawStack();
+
+    const bool timing = _trafficStat && _trafficStat->IsSendTimingSample();
+    const sint64 encodeBegTime = timing ? LLBC_GetMicroSeconds() : 0;
+
+    LLBC_Packet *encoded;
+    if (_stack.SendCodec(packet, encoded, removeSession) != LLBC_OK)
+        return LLBC_FAILED;
+
+    const size_t payloadLen = encoded->GetPayloadLength();
+    if (_multicastStack->SendRaw(encoded, block, removeSession) != LLBC_OK)
+        return LLBC_FAILED;
+
+    if (_trafficStat)
+        _trafficStat->OnMulticastSent(*targets,
+                                      opcode,
+                                      payloadLen,
+                                      timing ? MAX(LLBC_GetMicroSeconds() - encodeBegTime, 0) : -1);
+#endif
+
+    LLBC_SharedBuffer *buffer = LLBC_New1(LLBC_SharedBuffer, block);
+    // Flush coalesced packets first, to keep the packets order.
+    if (IsCanCoalesceSend())
+        FlushCoalescedSend(_ForceFlush);
+
+    const int ret = _pollerMgr.Multicast(buffer, opcode, *targets);
+    buffer->Release();
+
+    return ret;
+}
+
 __LLBC_NS_END
 
 #include "llbc/common/AfterIncl.h"
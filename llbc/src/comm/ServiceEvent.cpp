@@ -14,29 +14,20 @@
 #include "llbc/comm/Session.h"
 #include "llbc/comm/protocol/ProtocolLayer.h"
 #include "llbc/comm/protocol/ProtoReportLevel.h"
+#include "llbc/comm/EventPool.h"
 #include "llbc/comm/ServiceEvent.h"
 
 namespace
 {
     typedef LLBC_NS LLBC_ServiceEvent Base;
-    typedef LLBC_NS LLBC_MessageBlock _Block;
     typedef LLBC_NS LLBC_SvcEvType _EvType;
-
-    template <typename Ev>
-    static _Block *__CreateEvBlock(Ev *ev)
-    {
-        _Block *block = LLBC_New1(_Block, sizeof(int) + sizeof(Ev *));
-        block->Write(&ev->type, sizeof(int));
-        block->Write(&ev, sizeof(Ev *));
-
-        return block;
-    }
 }
 
 __LLBC_NS_BEGIN
 
 LLBC_ServiceEvent::LLBC_ServiceEvent(int type)
 : type(type)
+, next(NULL)
 {
 }
 
@@ -44,6 +35,16 @@ LLBC_ServiceEvent::~LLBC_ServiceEvent()
 {
 }
 
+void *LLBC_ServiceEvent::operator new(size_t size)
+{
+    return LLBC_EventPool::Alloc(size);
+}
+
+void LLBC_ServiceEvent::operator delete(void *ev, size_t size)
+{
+    LLBC_EventPool::Free(ev, size);
+}
+
 LLBC_SvcEv_SessionCreate::LLBC_SvcEv_SessionCreate()
 : Base(_EvType::SessionCreate)
 {
@@ -98,6 +99,20 @@ LLBC_SvcEv_ProtoReport::~LLBC_SvcEv_ProtoReport()
 {
 }
 
+LLBC_SvcEv_SessionBackpressure::LLBC_SvcEv_SessionBackpressure()
+: Base(_EvType::SessionBackpressure)
+, sessionId(0)
+, backpressured(false)
+, queueSize(0)
+, droppedPackets(0)
+, coalescedPackets(0)
+{
+}
+
+LLBC_SvcEv_SessionBackpressure::~LLBC_SvcEv_SessionBackpressure()
+{
+}
+
 LLBC_SvcEv_SubscribeEv::LLBC_SvcEv_SubscribeEv()
 : Base(_EvType::SubscribeEv)
 , id(0)
@@ -133,7 +148,7 @@ LLBC_SvcEv_FireEv::~LLBC_SvcEv_FireEv()
     LLBC_XDelete(ev);
 }
 
-LLBC_MessageBlock *LLBC_SvcEvUtil::BuildSessionCreateEv(const LLBC_SockAddr_IN &local,
+LLBC_ServiceEvent *LLBC_SvcEvUtil::BuildSessionCreateEv(const LLBC_SockAddr_IN &local,
                                                         const LLBC_SockAddr_IN &peer,
                                                         bool isListen,
                                                         int sessionId,
@@ -148,15 +163,16 @@ LLBC_MessageBlock *LLBC_SvcEvUtil::BuildSessionCreateEv(const LLBC_SockAddr_IN &
     ev->peer = peer;
     ev->handle = handle;
 
-    return __CreateEvBlock(ev);
+    return ev;
 }
 
-LLBC_MessageBlock *LLBC_SvcEvUtil::BuildSessionDestroyEv(const LLBC_SockAddr_IN &local,
+LLBC_ServiceEvent *LLBC_SvcEvUtil::BuildSessionDestroyEv(const LLBC_SockAddr_IN &local,
                                                          const LLBC_SockAddr_IN &peer,
                                                          bool isListen,
                                                          int sessionId,
                                                          LLBC_SocketHandle handle,
-                                                         LLBC_SessionCloseInfo *closeInfo)
+                                                         LLBC_SessionCloseInfo *closeInfo,
+                                                         const LLBC_RecvStat &recvStat)
 {
     typedef LLBC_SvcEv_SessionDestroy _Ev;
 
@@ -168,11 +184,12 @@ LLBC_MessageBlock *LLBC_SvcEvUtil::BuildSessionDestroyEv(const LLBC_SockAddr_IN
     ev->handle = handle;
 
     ev->closeInfo = closeInfo;
+    ev->recvStat = recvStat;
 
-    return __CreateEvBlock(ev);
+    return ev;
 }
 
-LLBC_MessageBlock *LLBC_SvcEvUtil::BuildAsyncConnResultEv(bool connected,
+LLBC_ServiceEvent *LLBC_SvcEvUtil::BuildAsyncConnResultEv(bool connected,
                                                           const LLBC_String &reason,
                                                           const LLBC_SockAddr_IN &peer)
 {
@@ -183,20 +200,20 @@ LLBC_MessageBlock *LLBC_SvcEvUtil::BuildAsyncConnResultEv(bool connected,
     ev->reason.append(reason);
     ev->peer = peer;
 
-    return __CreateEvBlock(ev);
+    return ev;
 }
 
-LLBC_MessageBlock *LLBC_SvcEvUtil::BuildDataArrivalEv(LLBC_Packet *packet)
+LLBC_ServiceEvent *LLBC_SvcEvUtil::BuildDataArrivalEv(LLBC_Packet *packet)
 {
     typedef LLBC_SvcEv_DataArrival _Ev;
 
     _Ev *ev = LLBC_New(_Ev);
     ev->packet = packet;
 
-    return __CreateEvBlock(ev);
+    return ev;
 }
 
-LLBC_MessageBlock *LLBC_SvcEvUtil::BuildProtoReportEv(int sessionId,
+LLBC_ServiceEvent *LLBC_SvcEvUtil::BuildProtoReportEv(int sessionId,
                                                       int opcode,
                                                       int layer,
                                                       int level,
@@ -211,10 +228,28 @@ LLBC_MessageBlock *LLBC_SvcEvUtil::BuildProtoReportEv(int sessionId,
     ev->level = level;
     ev->report.append(report);
 
-    return __CreateEvBlock(ev);
+    return ev;
 }
 
-LLBC_MessageBlock *LLBC_SvcEvUtil::BuildSubscribeEvEv(int id,
+LLBC_ServiceEvent *LLBC_SvcEvUtil::BuildSessionBackpressureEv(int sessionId,
+                                                              bool backpressured,
+                                                              size_t queueSize,
+                                                              size_t droppedPackets,
+                                                              size_t coalescedPackets)
+{
+    typedef LLBC_SvcEv_SessionBackpressure _Ev;
+
+    _Ev *ev = LLBC_New(_Ev);
+    ev->sessionId = sessionId;
+    ev->backpressured = backpressured;
+    ev->queueSize = queueSize;
+    ev->droppedPackets = droppedPackets;
+    ev->coalescedPackets = coalescedPackets;
+
+    return ev;
+}
+
+LLBC_ServiceEvent *LLBC_SvcEvUtil::BuildSubscribeEvEv(int id,
                                                       const LLBC_String &stub,
                                                       LLBC_IDelegate1<LLBC_Event *> *deleg)
 {
@@ -225,10 +260,10 @@ LLBC_MessageBlock *LLBC_SvcEvUtil::BuildSubscribeEvEv(int id,
     ev->stub.append(stub);
     ev->deleg = deleg;
 
-    return __CreateEvBlock(ev);
+    return ev;
 }
 
-LLBC_MessageBlock *LLBC_SvcEvUtil::BuildUnsubscribeEvEv(int id, const LLBC_String &stub)
+LLBC_ServiceEvent *LLBC_SvcEvUtil::BuildUnsubscribeEvEv(int id, const LLBC_String &stub)
 {
     typedef LLBC_SvcEv_UnsubscribeEv _Ev;
 
@@ -236,29 +271,17 @@ LLBC_MessageBlock *LLBC_SvcEvUtil::BuildUnsubscribeEvEv(int id, const LLBC_Strin
     ev->id = id;
     ev->stub.append(stub);
 
-    return __CreateEvBlock(ev);
+    return ev;
 }
 
-LLBC_MessageBlock *LLBC_SvcEvUtil::BuildFireEvEv(LLBC_Event *ev)
+LLBC_ServiceEvent *LLBC_SvcEvUtil::BuildFireEvEv(LLBC_Event *ev)
 {
     typedef LLBC_SvcEv_FireEv _Ev;
 
     _Ev *wrapEv = LLBC_New(_Ev);
     wrapEv->ev = ev;
 
-    return __CreateEvBlock(wrapEv);
-}
-
-void LLBC_SvcEvUtil::DestroyEvBlock(LLBC_MessageBlock *block)
-{
-    // Skip event type.
-    block->ShiftReadPos(sizeof(int));
-
-    LLBC_ServiceEvent *svcEv;
-    block->Read(&svcEv, sizeof(LLBC_ServiceEvent *));
-
-    LLBC_Delete(svcEv);
-    LLBC_Delete(block);
+    return wrapEv;
 }
 
 __LLBC_NS_END
@@ -0,0 +1,107 @@
+/**
+ * @file    ServiceWorker.cpp
+ * @author  Longwei Lai<lailongwei@126.com>
+ * @date    2026/10/18
+ * @version 1.0
+ *
+ * @brief
+ */
+
+#include "llbc/common/Export.h"
+#include "llbc/common/BeforeIncl.h"
+
+#include "llbc/comm/Packet.h"
+#include "llbc/comm/Service.h"
+#include "llbc/comm/ServiceWorker.h"
+
+__LLBC_NS_BEGIN
+
+LLBC_ServiceWorker::LLBC_ServiceWorker(LLBC_Service *svc)
+: _svc(svc)
+, _stopping(false)
+
+, _evQueue()
+, _evSem()
+, _evWaiting(0)
+{
+}
+
+LLBC_ServiceWorker::~LLBC_ServiceWorker()
+{
+    DestroyQueuedEvents();
+}
+
+int LLBC_ServiceWorker::Start()
+{
+    _stopping = false;
+    return Activate(1);
+}
+
+void LLBC_ServiceWorker::Stop()
+{
+    _stopping = true;
+    _evSem.Post();
+
+    Wait();
+    DestroyQueuedEvents();
+}
+
+void LLBC_ServiceWorker::PushEvent(LLBC_ServiceEvent *ev)
+{
+    // Only need to notify worker when queue become not empty, and worker waiting.
+    if (_evQueue.Push(ev) &&
+        LLBC_AtomicGet(&_evWaiting) != 0)
+        _evSem.Post();
+}
+
+void LLBC_ServiceWorker::Svc()
+{
+    while (!_stopping)
+    {
+        LLBC_ServiceEvent *ev = _evQueue.PopAll();
+        if (!ev)
+        {
+            // Set waiting flag before check queue, PushEvent() check the flag after pushed.
+            LLBC_AtomicFetchAndAdd(&_evWaiting, 1);
+            if (_evQueue.IsEmpty() && !_stopping)
+                _evSem.Wait();
+            LLBC_AtomicFetchAndSub(&_evWaiting, 1);
+
+            continue;
+        }
+
+        while (ev)
+        {
+            LLBC_ServiceEvent *next = ev->next;
+
+            LLBC_SvcEv_DataArrival *dataArrivalEv = static_cast<LLBC_SvcEv_DataArrival *>(ev);
+            LLBC_Packet *packet = dataArrivalEv->packet;
+            dataArrivalEv->packet = NULL;
+
+            _svc->DispatchPacket(packet);
+
+            LLBC_Delete(ev);
+            ev = next;
+        }
+    }
+}
+
+void LLBC_ServiceWorker::Cleanup()
+{
+}
+
+void LLBC_ServiceWorker::DestroyQueuedEvents()
+{
+    LLBC_ServiceEvent *ev = _evQueue.PopAll();
+    while (ev)
+    {
+        LLBC_ServiceEvent *next = ev->next;
+        LLBC_Delete(ev);
+
+        ev = next;
+    }
+}
+
+__LLBC_NS_END
+
+#include "llbc/common/AfterIncl.h"
@@ -16,7 +16,10 @@
 #include "llbc/comm/Socket.h"
 #include "llbc/comm/Session.h"
 #include "llbc/comm/BasePoller.h"
+#include "llbc/comm/IoUringPoller.h"
 #include "llbc/comm/PollerType.h"
+#include "llbc/comm/PollerEvent.h"
+#include "llbc/comm/BackpressurePolicy.h"
 #include "llbc/comm/ServiceEvent.h"
 #include "llbc/comm/IService.h"
 
@@ -96,11 +99,24 @@ LLBC_Session::LLBC_Session()
 , _poller(NULL)
 
 , _protoStack(NULL)
+, _recvedPackets()
+
+, _pendingFlush(false)
+, _pendingRecv(false)
+
+, _backpressured(false)
+, _disconnecting(false)
+, _reportedQueueSize(0)
+, _droppedPackets(0)
+, _coalescedPackets(0)
+, _coalescedBlocks()
 {
 }
 
 LLBC_Session::~LLBC_Session()
 {
+    LLBC_STLHelper::DeleteContainer(_coalescedBlocks);
+
     LLBC_XDelete(_socket);
     LLBC_XDelete(_protoStack);
 }
@@ -172,6 +188,7 @@ int LLBC_Session::Send(LLBC_Packet *packet)
 {
     bool removeSession;
     LLBC_MessageBlock *block;
+    const int opcode = packet->GetOpcode();
 #if LLBC_CFG_COMM_USE_FULL_STACK
     if (_protoStack->Send(packet, block, removeSession) != LLBC_OK)
 #else
@@ -179,20 +196,45 @@ int LLBC_Session::Send(LLBC_Packet *packet)
 #endif
         return removeSession ? LLBC_FAILED : LLBC_OK;
 
-    return Send(block);
+    return Send(block, opcode);
 }
 
-int LLBC_Session::Send(LLBC_MessageBlock *block)
+int LLBC_Session::Send(LLBC_MessageBlock *block, int opcode)
 {
+    if (UNLIKELY(_backpressured) && ApplyBackpressurePolicy(block, opcode))
+        return LLBC_OK;
+
     if (_socket->AsyncSend(block) != LLBC_OK)
         return LLBC_FAILED;
 
     // In LINUX or ANDROID platform, if use EPOLL ET mode, we must force call OnSend() one time.
+    // If poller is flushing send queue, defer OnSend() to the flush end, so all blocks queued
+    // in this flush will gather-send by one system call.
 #if LLBC_TARGET_PLATFORM_LINUX || LLBC_TARGET_PLATFORM_ANDROID
-    if (_pollerType == LLBC_PollerType::EpollPoller)
-        OnSend();
+    if (_pollerType == LLBC_PollerType::EpollPoller
+ #if LLBC_TARGET_PLATFORM_LINUX
+        || _pollerType == LLBC_PollerType::IoUringPoller
+ #endif // LLBC_TARGET_PLATFORM_LINUX
+       )
+    {
+        if (!_poller->IsFlushingSendQueue())
+        {
+            OnSend();
+        }
+        else if (!_pendingFlush)
+        {
+            _pendingFlush = true;
+            _poller->AddPendingFlushSession(_id);
+        }
+
+        // Send queue will be checked when socket sent(or io_uring send request posted).
+        return LLBC_OK;
+    }
 #endif
 
+    // The other pollers send data in poller loop, check send queue here.
+    CheckSendQueue();
+
     return LLBC_OK;
 }
 
@@ -204,6 +246,19 @@ void LLBC_Session::OnSend(LLBC_POverlapped ol)
 #else // LLBC_TARGET_PLATFORM_NON_WIN32
 void LLBC_Session::OnSend()
 {
+    _pendingFlush = false;
+
+    // In io_uring poller, the send request will be submitted by poller in batch.
+#if LLBC_TARGET_PLATFORM_LINUX
+    if (_pollerType == LLBC_PollerType::IoUringPoller)
+    {
+        static_cast<LLBC_IoUringPoller *>(_poller)->PostSend(this);
+        CheckSendQueue();
+
+        return;
+    }
+#endif // LLBC_TARGET_PLATFORM_LINUX
+
     _socket->OnSend();
 }
 #endif // LLBC_TARGET_PLATFORM_WIN32
@@ -220,6 +275,12 @@ void LLBC_Session::OnRecv()
 }
 #endif // LLBC_TARGET_PLATFORM_WIN32
 
+void LLBC_Session::OnPendingRecv()
+{
+    _pendingRecv = false;
+    OnRecv();
+}
+
 #if LLBC_TARGET_PLATFORM_WIN32
 void LLBC_Session::OnClose(LLBC_POverlapped ol, LLBC_SessionCloseInfo *closeInfo)
 #else
@@ -229,6 +290,13 @@ void LLBC_Session::OnClose(LLBC_SessionCloseInfo *closeInfo)
     if (closeInfo == NULL)
         closeInfo = new LLBC_SessionCloseInfo();
 
+    // In io_uring poller, the session's requests must be submitted and canceled before socket closed,
+    // avoid the requests issued on the reused socket handle.
+#if LLBC_TARGET_PLATFORM_LINUX
+    if (_pollerType == LLBC_PollerType::IoUringPoller)
+        static_cast<LLBC_IoUringPoller *>(_poller)->CancelRequests(this);
+#endif // LLBC_TARGET_PLATFORM_LINUX
+
     // Notify socket session closed.
     const LLBC_SocketHandle sockHandle = _socket->Handle();
 #if LLBC_TARGET_PLATFORM_WIN32
@@ -243,34 +311,52 @@ void LLBC_Session::OnClose(LLBC_SessionCloseInfo *closeInfo)
                                                      _socket->IsListen(),
                                                      _id,
                                                      sockHandle,
-                                                     closeInfo));
+                                                     closeInfo,
+                                                     _socket->GetRecvStat()));
 
     // Let poller remove self.
     _poller->RemoveSession(this);
 }
 
-void LLBC_Session::OnSent(size_t len)
+void LLBC_Session::OnSent(const LLBC_SendStat &stat)
+{
+    if (stat.sentBytes > 0)
+        _poller->AddSendStat(stat);
+
+    CheckSendQueue();
+}
+
+void LLBC_Session::OnRecvFinished(const LLBC_RecvStat &stat)
 {
-    // TODO: For support sampler, do stuff here.
-    // ... ...
+    _poller->AddRecvStat(stat);
+    _poller->UpdateSessionRecvStat(_id, _socket->GetRecvStat());
+
+    // In EPOLL ET mode, the data remain in socket will not trigger readable event again,
+    // so re-arm session, poller will continue receive in next loop.
+    // The other pollers are level-triggered(select, IOCP zero-byte recv), not need re-arm.
+#if LLBC_TARGET_PLATFORM_LINUX || LLBC_TARGET_PLATFORM_ANDROID
+    if (stat.budgetExhausts != 0 &&
+        _pollerType == LLBC_PollerType::EpollPoller &&
+        !_pendingRecv)
+    {
+        _pendingRecv = true;
+        _poller->AddPendingRecvSession(_id);
+    }
+#endif
 }
 
-bool LLBC_Session::OnRecved(LLBC_MessageBlock *block)
+bool LLBC_Session::OnRecved(LLBC_MessageBlock *block, LLBC_RecvSlab *slab)
 {
     bool removeSession;
-    std::vector<LLBC_Packet *> packets;
+    std::vector<LLBC_Packet *> &packets = _recvedPackets;
+    packets.clear();
 #if LLBC_CFG_COMM_USE_FULL_STACK
-    if (_protoStack->Recv(block, packets, removeSession) != LLBC_OK)
+    const int ret = _protoStack->Recv(block, slab, packets, removeSession);
 #else
-    if (_protoStack->RecvRaw(block, packets, removeSession) != LLBC_OK)
+    const int ret = _protoStack->RecvRaw(block, slab, packets, removeSession);
 #endif
-    {
-        if (removeSession)
-            OnClose();
-
-        return false;
-    }
 
+    // Deliver the packets received before the error(if has error) first, then close session.
     LLBC_Packet *packet;
     for (size_t i = 0; i < packets.size(); i++)
     {
@@ -282,9 +368,131 @@ bool LLBC_Session::OnRecved(LLBC_MessageBlock *block)
         _svc->Push(LLBC_SvcEvUtil::BuildDataArrivalEv(packet));
     }
 
+    if (ret != LLBC_OK)
+    {
+        if (removeSession)
+            OnClose();
+
+        return false;
+    }
+
     return true;
 }
 
+bool LLBC_Session::ApplyBackpressurePolicy(LLBC_MessageBlock *block, int opcode)
+{
+    // Session will be closed in next poller loop, discard all blocks.
+    if (_disconnecting)
+    {
+        LLBC_Delete(block);
+        return true;
+    }
+
+    switch (_poller->GetBackpressurePolicy(opcode))
+    {
+    case LLBC_BackpressurePolicy::Drop:
+        ++_droppedPackets;
+        LLBC_Delete(block);
+        return true;
+
+    case LLBC_BackpressurePolicy::Coalesce:
+        {
+            // Only keep the latest block of the opcode.
+            LLBC_MessageBlock *&coalescedBlock = _coalescedBlocks[opcode];
+            if (coalescedBlock)
+            {
+                ++_coalescedPackets;
+                LLBC_Delete(coalescedBlock);
+            }
+
+            coalescedBlock = block;
+            return true;
+        }
+
+    case LLBC_BackpressurePolicy::Disconnect:
+        LLBC_Delete(block);
+        RequestDisconnect();
+        return true;
+
+    default:
+        return false;
+    }
+}
+
+void LLBC_Session::CheckSendQueue()
+{
+    const size_t queueSize = _socket->GetWillSendSize();
+    if (queueSize != _reportedQueueSize)
+    {
+        _reportedQueueSize = queueSize;
+        _poller->UpdateSendQueueSize(_id, queueSize);
+    }
+
+    const size_t highWaterMark = _poller->GetSendHighWaterMark();
+    if (highWaterMark == 0 || _disconnecting)
+        return;
+
+    if (!_backpressured)
+    {
+        if (queueSize < highWaterMark)
+            return;
+
+        _backpressured = true;
+        _svc->Push(LLBC_SvcEvUtil::BuildSessionBackpressureEv(_id, true, queueSize, 0, 0));
+
+        if (_poller->GetBackpressurePolicy() == LLBC_BackpressurePolicy::Disconnect)
+            RequestDisconnect();
+    }
+    else if (queueSize <= _poller->GetSendLowWaterMark())
+    {
+        _backpressured = false;
+        _svc->Push(LLBC_SvcEvUtil::BuildSessionBackpressureEv(
+            _id, false, queueSize, _droppedPackets, _coalescedPackets));
+
+        _droppedPackets = 0;
+        _coalescedPackets = 0;
+
+        FlushCoalescedBlocks();
+    }
+}
+
+void LLBC_Session::FlushCoalescedBlocks()
+{
+    if (_coalescedBlocks.empty())
+        return;
+
+    // Only append blocks to socket, this method maybe called in socket sent callback.
+    for (std::map<int, LLBC_MessageBlock *>::iterator it = _coalescedBlocks.begin();
+         it != _coalescedBlocks.end();
+         ++it)
+        _socket->AsyncSend(it->second);
+    _coalescedBlocks.clear();
+
+#if LLBC_TARGET_PLATFORM_LINUX || LLBC_TARGET_PLATFORM_ANDROID
+    if ((_pollerType == LLBC_PollerType::EpollPoller
+ #if LLBC_TARGET_PLATFORM_LINUX
+         || _pollerType == LLBC_PollerType::IoUringPoller
+ #endif // LLBC_TARGET_PLATFORM_LINUX
+        ) && !_pendingFlush)
+    {
+        _pendingFlush = true;
+        _poller->AddPendingFlushSession(_id);
+        if (!_poller->IsFlushingSendQueue())
+            _poller->Push(LLBC_PollerEvUtil::BuildFlushSendEv());
+    }
+#endif
+}
+
+void LLBC_Session::RequestDisconnect()
+{
+    if (_disconnecting)
+        return;
+
+    // Close session in next poller loop, avoid close session in socket callbacks.
+    _disconnecting = true;
+    _poller->Push(LLBC_PollerEvUtil::BuildCloseEv(_id, "Session send queue exceed high water mark"));
+}
+
 __LLBC_NS_END
 
 #include "llbc/common/AfterIncl.h"
@@ -0,0 +1,294 @@
+/**
+ * @file    SessionIdTable.cpp
+ * @author  Longwei Lai<lailongwei@126.com>
+ * @date    2026/10/18
+ * @version 1.0
+ *
+ * @brief
+ */
+
+#include "llbc/common/Export.h"
+#include "llbc/common/BeforeIncl.h"
+
+#include "llbc/comm/SessionIdTable.h"
+
+__LLBC_NS_BEGIN
+
+LLBC_SessionIdTable::LLBC_SessionIdTable(int slotsCount, int valueCount)
+: _slots(NULL)
+, _values(NULL)
+, _denseIdxs(NULL)
+, _mask(slotsCount - 1)
+, _valueCount(valueCount)
+
+, _overflowCount(0)
+, _overflow()
+, _overflowValues()
+
+, _dense()
+, _lock()
+{
+    ASSERT(slotsCount > 0 && (slotsCount & (slotsCount - 1)) == 0 &&
+        "LLBC_SessionIdTable slots count must be power of 2!");
+    ASSERT(valueCount > 0 && "LLBC_SessionIdTable values count must greater than 0!");
+
+    _slots = LLBC_Calloc(sint32, sizeof(sint32) * slotsCount);
+    _values = LLBC_Calloc(sint64, sizeof(sint64) * slotsCount * valueCount);
+    _denseIdxs = LLBC_Calloc(int, sizeof(int) * slotsCount);
+}
+
+LLBC_SessionIdTable::~LLBC_SessionIdTable()
+{
+    LLBC_Free(const_cast<sint32 *>(_slots));
+    LLBC_Free(const_cast<sint64 *>(_values));
+    LLBC_Free(_denseIdxs);
+}
+
+int LLBC_SessionIdTable::Insert(int sessionId)
+{
+    if (UNLIKELY(sessionId <= 0))
+    {
+        LLBC_SetLastError(LLBC_ERROR_ARG);
+        return LLBC_FAILED;
+    }
+
+    LLBC_Guard guard(_lock);
+
+    const int slotIdx = sessionId & _mask;
+    const sint32 old = _slots[slotIdx];
+    if (old == 0)
+    {
+        _denseIdxs[slotIdx] = static_cast<int>(_dense.size());
+        for (int i = 0; i < _valueCount; i++)
+            LLBC_AtomicSet(&_values[slotIdx * _valueCount + i], 0);
+        LLBC_AtomicSet(&_slots[slotIdx], sessionId);
+    }
+    else if (old == sessionId)
+    {
+        LLBC_SetLastError(LLBC_ERROR_REPEAT);
+        return LLBC_FAILED;
+    }
+    else // Slot collision, insert to overflow map.
+    {
+        if (!_overflow.insert(std::make_pair(sessionId, static_cast<int>(_dense.size()))).second)
+        {
+            LLBC_SetLastError(LLBC_ERROR_REPEAT);
+            return LLBC_FAILED;
+        }
+
+        _overflowValues[sessionId].assign(_valueCount, 0);
+        LLBC_AtomicFetchAndAdd(&_overflowCount, 1);
+    }
+
+    _dense.push_back(sessionId);
+
+    return LLBC_OK;
+}
+
+int LLBC_SessionIdTable::Remove(int sessionId)
+{
+    if (UNLIKELY(sessionId <= 0))
+    {
+        LLBC_SetLastError(LLBC_ERROR_ARG);
+        return LLBC_FAILED;
+    }
+
+    LLBC_Guard guard(_lock);
+
+    int denseIdx;
+    const int slotIdx = sessionId & _mask;
+    if (_slots[slotIdx] == sessionId)
+    {
+        denseIdx = _denseIdxs[slotIdx];
+        LLBC_AtomicSet(&_slots[slotIdx], 0);
+    }
+    else
+    {
+        std::map<int, int>::iterator it = _overflow.find(sessionId);
+        if (it == _overflow.end())
+        {
+            LLBC_SetLastError(LLBC_ERROR_NOT_FOUND);
+            return LLBC_FAILED;
+        }
+
+        denseIdx = it->second;
+        _overflow.erase(it);
+        _overflowValues.erase(sessionId);
+
+        LLBC_AtomicFetchAndSub(&_overflowCount, 1);
+    }
+
+    RemoveFromDense(denseIdx);
+
+    return LLBC_OK;
+}
+
+bool LLBC_SessionIdTable::IsExist(int sessionId) const
+{
+    if (UNLIKELY(sessionId <= 0))
+        return false;
+
+    if (LIKELY(_slots[sessionId & _mask] == sessionId))
+        return true;
+    else if (LIKELY(_overflowCount == 0))
+        return false;
+
+    LLBC_SessionIdTable *ncThis = const_cast<LLBC_SessionIdTable *>(this);
+    LLBC_Guard guard(ncThis->_lock);
+
+    return _overflow.find(sessionId) != _overflow.end();
+}
+
+int LLBC_SessionIdTable::SetValue(int sessionId, sint64 value, int valueIdx)
+{
+    if (UNLIKELY(sessionId <= 0 || valueIdx < 0 || valueIdx >= _valueCount))
+    {
+        LLBC_SetLastError(LLBC_ERROR_ARG);
+        return LLBC_FAILED;
+    }
+
+    // The slot only can be reused after session Id removed by owner thread, so not need recheck.
+    const int slotIdx = sessionId & _mask;
+    if (LIKELY(_slots[slotIdx] == sessionId))
+    {
+        LLBC_AtomicSet(&_values[slotIdx * _valueCount + valueIdx], value);
+        return LLBC_OK;
+    }
+
+    LLBC_Guard guard(_lock);
+
+    std::map<int, std::vector<sint64> >::iterator it = _overflowValues.find(sessionId);
+    if (it == _overflowValues.end())
+    {
+        LLBC_SetLastError(LLBC_ERROR_NOT_FOUND);
+        return LLBC_FAILED;
+    }
+
+    it->second[valueIdx] = value;
+
+    return LLBC_OK;
+}
+
+int LLBC_SessionIdTable::GetValue(int sessionId, sint64 &value, int valueIdx) const
+{
+    if (UNLIKELY(sessionId <= 0 || valueIdx < 0 || valueIdx >= _valueCount))
+    {
+        LLBC_SetLastError(LLBC_ERROR_ARG);
+        return LLBC_FAILED;
+    }
+
+    // Recheck slot after value loaded, makesure the value not belong to the new session Id in same slot.
+    const int slotIdx = sessionId & _mask;
+    if (LIKELY(_slots[slotIdx] == sessionId))
+    {
+        value = LLBC_AtomicGet(&_values[slotIdx * _valueCount + valueIdx]);
+        if (LIKELY(_slots[slotIdx] == sessionId))
+            return LLBC_OK;
+    }
+
+    LLBC_SessionIdTable *ncThis = const_cast<LLBC_SessionIdTable *>(this);
+    LLBC_Guard guard(ncThis->_lock);
+
+    std::map<int, std::vector<sint64> >::const_iterator it = _overflowValues.find(sessionId);
+    if (it == _overflowValues.end())
+    {
+        LLBC_SetLastError(LLBC_ERROR_NOT_FOUND);
+        return LLBC_FAILED;
+    }
+
+    value = it->second[valueIdx];
+
+    return LLBC_OK;
+}
+
+int LLBC_SessionIdTable::GetValues(int sessionId, sint64 *values) const
+{
+    if (UNLIKELY(sessionId <= 0))
+    {
+        LLBC_SetLastError(LLBC_ERROR_ARG);
+        return LLBC_FAILED;
+    }
+
+    // Same as GetValue(), recheck slot after all values loaded.
+    const int slotIdx = sessionId & _mask;
+    if (LIKELY(_slots[slotIdx] == sessionId))
+    {
+        for (int i = 0; i < _valueCount; i++)
+            values[i] = LLBC_AtomicGet(&_values[slotIdx * _valueCount + i]);
+        if (LIKELY(_slots[slotIdx] == sessionId))
+            return LLBC_OK;
+    }
+
+    LLBC_SessionIdTable *ncThis = const_cast<LLBC_SessionIdTable *>(this);
+    LLBC_Guard guard(ncThis->_lock);
+
+    std::map<int, std::vector<sint64> >::const_iterator it = _overflowValues.find(sessionId);
+    if (it == _overflowValues.end())
+    {
+        LLBC_SetLastError(LLBC_ERROR_NOT_FOUND);
+        return LLBC_FAILED;
+    }
+
+    for (int i = 0; i < _valueCount; i++)
+        values[i] = it->second[i];
+
+    return LLBC_OK;
+}
+
+size_t LLBC_SessionIdTable::GetSize() const
+{
+    LLBC_SessionIdTable *ncThis = const_cast<LLBC_SessionIdTable *>(this);
+    LLBC_Guard guard(ncThis->_lock);
+
+    return _dense.size();
+}
+
+void LLBC_SessionIdTable::GetSessionIds(LLBC_SessionIdList &sessionIds) const
+{
+    LLBC_SessionIdTable *ncThis = const_cast<LLBC_SessionIdTable *>(this);
+    LLBC_Guard guard(ncThis->_lock);
+
+    sessionIds.assign(_dense.begin(), _dense.end());
+}
+
+void LLBC_SessionIdTable::Clear()
+{
+    LLBC_Guard guard(_lock);
+
+    LLBC_MemSet(const_cast<sint32 *>(_slots), 0, sizeof(sint32) * (_mask + 1));
+    LLBC_MemSet(const_cast<sint64 *>(_values), 0, sizeof(sint64) * (_mask + 1) * _valueCount);
+
+    _overflow.clear();
+    _overflowValues.clear();
+    LLBC_AtomicSet(&_overflowCount, 0);
+
+    _dense.clear();
+}
+
+void LLBC_SessionIdTable::RemoveFromDense(int denseIdx)
+{
+    // Move the last session Id to removed position, and update it's dense index.
+    const int lastIdx = static_cast<int>(_dense.size()) - 1;
+    if (denseIdx != lastIdx)
+    {
+        const int lastSessionId = _dense[lastIdx];
+        _dense[denseIdx] = lastSessionId;
+
+        SetDenseIdx(lastSessionId, denseIdx);
+    }
+
+    _dense.pop_back();
+}
+
+void LLBC_SessionIdTable::SetDenseIdx(int sessionId, int denseIdx)
+{
+    const int slotIdx = sessionId & _mask;
+    if (_slots[slotIdx] == sessionId)
+        _denseIdxs[slotIdx] = denseIdx;
+    else
+        _overflow[sessionId] = denseIdx;
+}
+
+__LLBC_NS_END
+
+#include "llbc/common/AfterIncl.h"
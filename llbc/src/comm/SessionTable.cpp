@@ -0,0 +1,193 @@
+/**
+ * @file    SessionTable.cpp
+ * @author  Longwei Lai<lailongwei@126.com>
+ * @date    2026/10/18
+ * @version 1.0
+ *
+ * @brief
+ */
+
+#include "llbc/common/Export.h"
+#include "llbc/common/BeforeIncl.h"
+
+#include "llbc/comm/Socket.h"
+#include "llbc/comm/Session.h"
+#include "llbc/comm/SessionTable.h"
+
+namespace
+{
+    typedef LLBC_NS LLBC_SessionTable This;
+
+    // The session table initialize slots count, must be power of 2.
+    const int __initSlotsCount = 64;
+}
+
+__LLBC_NS_BEGIN
+
+LLBC_SessionTable::LLBC_SessionTable()
+: _idStride(1)
+
+, _slots(NULL)
+, _slotsMask(__initSlotsCount - 1)
+
+, _overflow()
+, _dense()
+
+#if LLBC_TARGET_PLATFORM_NON_WIN32
+, _fdSessions()
+#else
+, _sockets()
+#endif
+{
+    _slots = LLBC_Calloc(_Slot, sizeof(_Slot) * __initSlotsCount);
+}
+
+LLBC_SessionTable::~LLBC_SessionTable()
+{
+    LLBC_Free(_slots);
+}
+
+void LLBC_SessionTable::SetIdStride(int stride)
+{
+    ASSERT(_dense.empty() && "Could not set session Id stride after session inserted!");
+    _idStride = MAX(stride, 1);
+}
+
+int LLBC_SessionTable::Insert(LLBC_Session *session)
+{
+    const int sessionId = session->GetId();
+    if (UNLIKELY(sessionId <= 0))
+    {
+        LLBC_SetLastError(LLBC_ERROR_ARG);
+        return LLBC_FAILED;
+    }
+    else if (UNLIKELY(Find(sessionId)))
+    {
+        LLBC_SetLastError(LLBC_ERROR_REPEAT);
+        return LLBC_FAILED;
+    }
+
+    // Keep load factor not exceed 0.5.
+    if ((_dense.size() + 1) * 2 > static_cast<size_t>(_slotsMask + 1))
+        Grow();
+
+    InsertToSlots(sessionId, static_cast<int>(_dense.size()), session);
+    _dense.push_back(session);
+
+    const LLBC_SocketHandle handle = session->GetSocketHandle();
+#if LLBC_TARGET_PLATFORM_NON_WIN32
+    if (static_cast<size_t>(handle) >= _fdSessions.size())
+        _fdSessions.resize(MAX(static_cast<size_t>(handle) + 1, _fdSessions.size() * 2), NULL);
+    _fdSessions[handle] = session;
+#else
+    _sockets.insert(std::make_pair(handle, session));
+#endif
+
+    return LLBC_OK;
+}
+
+int LLBC_SessionTable::Remove(LLBC_Session *session)
+{
+    const int sessionId = session->GetId();
+
+    _Slot *slot = GetSlot(sessionId);
+    if (UNLIKELY(!slot))
+    {
+        LLBC_SetLastError(LLBC_ERROR_NOT_FOUND);
+        return LLBC_FAILED;
+    }
+
+    const int denseIdx = slot->denseIdx;
+    if (slot == &_slots[(sessionId / _idStride) & _slotsMask])
+        ::memset(slot, 0, sizeof(_Slot));
+    else
+        _overflow.erase(sessionId);
+
+    // Move the last session to removed position, and update it's dense index.
+    const int lastIdx = static_cast<int>(_dense.size()) - 1;
+    if (denseIdx != lastIdx)
+    {
+        LLBC_Session *lastSession = _dense[lastIdx];
+        _dense[denseIdx] = lastSession;
+
+        GetSlot(lastSession->GetId())->denseIdx = denseIdx;
+    }
+    _dense.pop_back();
+
+    const LLBC_SocketHandle handle = session->GetSocketHandle();
+#if LLBC_TARGET_PLATFORM_NON_WIN32
+    if (static_cast<size_t>(handle) < _fdSessions.size() &&
+        _fdSessions[handle] == session)
+        _fdSessions[handle] = NULL;
+#else
+    _sockets.erase(handle);
+#endif
+
+    return LLBC_OK;
+}
+
+LLBC_SocketHandle LLBC_SessionTable::GetMaxSocketHandle() const
+{
+    LLBC_SocketHandle maxHandle = 0;
+    for (size_t i = 0; i < _dense.size(); i++)
+        maxHandle = MAX(maxHandle, _dense[i]->GetSocketHandle());
+
+    return maxHandle;
+}
+
+void LLBC_SessionTable::DeleteAll()
+{
+    for (size_t i = 0; i < _dense.size(); i++)
+        LLBC_Delete(_dense[i]);
+    _dense.clear();
+
+    ::memset(_slots, 0, sizeof(_Slot) * (_slotsMask + 1));
+    _overflow.clear();
+
+#if LLBC_TARGET_PLATFORM_NON_WIN32
+    _fdSessions.clear();
+#else
+    _sockets.clear();
+#endif
+}
+
+LLBC_SessionTable::_Slot *LLBC_SessionTable::GetSlot(int sessionId)
+{
+    _Slot &slot = _slots[(sessionId / _idStride) & _slotsMask];
+    if (slot.sessionId == sessionId)
+        return &slot;
+
+    _Overflow::iterator it = _overflow.find(sessionId);
+    return it != _overflow.end() ? &it->second : NULL;
+}
+
+void LLBC_SessionTable::InsertToSlots(int sessionId, int denseIdx, LLBC_Session *session)
+{
+    _Slot newSlot;
+    newSlot.sessionId = sessionId;
+    newSlot.denseIdx = denseIdx;
+    newSlot.session = session;
+
+    _Slot &slot = _slots[(sessionId / _idStride) & _slotsMask];
+    if (slot.sessionId == 0)
+        slot = newSlot;
+    else
+        _overflow.insert(std::make_pair(sessionId, newSlot));
+}
+
+void LLBC_SessionTable::Grow()
+{
+    const int newSlotsCount = (_slotsMask + 1) * 2;
+
+    LLBC_Free(_slots);
+    _slots = LLBC_Calloc(_Slot, sizeof(_Slot) * newSlotsCount);
+    _slotsMask = newSlotsCount - 1;
+
+    _overflow.clear();
+    for (size_t i = 0; i < _dense.size(); i++)
+        InsertToSlots(_dense[i]->GetId(), static_cast<int>(i), _dense[i]);
+}
+
+__LLBC_NS_END
+
+#include "llbc/common/AfterIncl.h"
@@ -0,0 +1,43 @@
+/**
+ * @file    SharedBuffer.cpp
+ * @author  Longwei Lai<lailongwei@126.com>
+ * @date    2026/10/18
+ * @version 1.0
+ *
+ * @brief
+ */
+
+#include "llbc/common/Export.h"
+#include "llbc/common/BeforeIncl.h"
+
+#include "llbc/comm/SharedBuffer.h"
+
+__LLBC_NS_BEGIN
+
+LLBC_SharedBuffer::LLBC_SharedBuffer(LLBC_MessageBlock *block)
+: _refCount(1)
+, _block(block)
+{
+}
+
+LLBC_SharedBuffer::~LLBC_SharedBuffer()
+{
+    LLBC_Delete(_block);
+}
+
+LLBC_SharedBlock::LLBC_SharedBlock(LLBC_SharedBuffer *buffer)
+: LLBC_MessageBlock(buffer->GetData(), buffer->GetSize())
+, _buffer(buffer)
+{
+    SetWritePos(buffer->GetSize());
+    _buffer->Retain();
+}
+
+LLBC_SharedBlock::~LLBC_SharedBlock()
+{
+    _buffer->Release();
+}
+
+__LLBC_NS_END
+
+#include "llbc/common/AfterIncl.h"
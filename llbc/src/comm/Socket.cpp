@@ -13,6 +13,9 @@
 #include "llbc/comm/PollerType.h"
 #include "llbc/comm/Socket.h"
 #include "llbc/comm/Session.h"
+#include "llbc/comm/RecvSlab.h"
+#include "llbc/comm/ReliableUdp.h"
+#include "llbc/comm/BasePoller.h"
 
 namespace
 {
@@ -30,6 +33,35 @@ void __OnOverlappedDelHook(void *data)
             LLBC_NS LLBC_MessageBlock *>(data));
 }
 
+// The max io vectors count of one gather-send call.
+const int __maxSendVecs = LLBC_IOV_MAX;
+
+// The min receive size hint, the session which receive few data per event also need this continuous writable slab space.
+const size_t __minRecvSizeHint = 512;
+
+// The reliable udp socket receive buffer size, udp datagram max size.
+const size_t __rudpRecvBufSize = 65536;
+
+// The OS dependent's socket error type and the error numbers, use to build reliable udp session close info.
+#if LLBC_TARGET_PLATFORM_NON_WIN32
+const int __sockErrType = LLBC_ERROR_CLIB;
+const int __connResetErr = ECONNRESET;
+const int __timedOutErr = ETIMEDOUT;
+#else
+const int __sockErrType = LLBC_ERROR_NETAPI;
+const int __connResetErr = WSAECONNRESET;
+const int __timedOutErr = WSAETIMEDOUT;
+#endif
+
+inline size_t __GetIoVecLen(const LLBC_NS LLBC_IoVec &vec)
+{
+#if LLBC_TARGET_PLATFORM_NON_WIN32
+    return vec.iov_len;
+#else
+    return vec.len;
+#endif
+}
+
 __LLBC_INTERNAL_NS_END
 
 __LLBC_NS_BEGIN
@@ -46,14 +78,26 @@ LLBC_Socket::LLBC_Socket(LLBC_SocketHandle handle)
 , _pollerType(_PollerType::End)
 
 , _listenSocket(false)
+, _portReusable(false)
 , _peerAddr()
 , _localAddr()
 
 , _willSend()
+, _willSendSize(0)
+, _sendStat()
+
+, _recvStat()
+, _recvSizeHint(LLBC_CFG_COMM_RECV_SLAB_MIN_RECV_SIZE)
+
+, _reliableUdp(false)
+, _rudp(NULL)
 #if LLBC_TARGET_PLATFORM_WIN32
 , _nonBlocking(false)
 , _olGroup()
 #endif // LLBC_TARGET_PLATFORM_WIN32
+#if LLBC_TARGET_PLATFORM_LINUX
+, _uringSendReq(NULL)
+#endif // LLBC_TARGET_PLATFORM_LINUX
 {
     if (_handle == LLBC_INVALID_SOCKET_HANDLE)
         _handle = LLBC_CreateTcpSocket();
@@ -66,6 +110,7 @@ LLBC_Socket::LLBC_Socket(LLBC_SocketHandle handle)
 LLBC_Socket::~LLBC_Socket()
 {
     Close();
+    LLBC_XDelete(_rudp);
 }
 
 void LLBC_Socket::SetSession(LLBC_Session *session)
@@ -110,7 +155,12 @@ int LLBC_Socket::Close()
         LLBC_SetLastError(LLBC_ERROR_NOT_OPEN);
         return LLBC_FAILED;
     }
-    else if (LLBC_CloseSocket(_handle) != LLBC_OK)
+
+    // Notify reliable udp peer, if fin lost, peer session will be removed by idle timeout.
+    if (_rudp && !_rudp->IsPeerClosed())
+        _rudp->SendFin();
+
+    if (LLBC_CloseSocket(_handle) != LLBC_OK)
         return LLBC_FAILED;
 
     _handle = LLBC_INVALID_SOCKET_HANDLE;
@@ -142,6 +192,20 @@ int LLBC_Socket::DisableAddressReusable()
     return LLBC_DisableAddressReusable(_handle);
 }
 
+int LLBC_Socket::EnablePortReusable()
+{
+    if (LLBC_EnablePortReusable(_handle) != LLBC_OK)
+        return LLBC_FAILED;
+
+    _portReusable = true;
+    return LLBC_OK;
+}
+
+bool LLBC_Socket::IsPortReusable() const
+{
+    return _portReusable;
+}
+
 bool LLBC_Socket::IsNonBlocking() const
 {
 #if LLBC_TARGET_PLATFORM_NON_WIN32
@@ -231,6 +295,25 @@ LLBC_Socket *LLBC_Socket::Accept()
     return newSocket;
 }
 
+void LLBC_Socket::ReliableUdpListen()
+{
+    _listenSocket = true;
+    _reliableUdp = true;
+}
+
+void LLBC_Socket::EnableReliableUdp(uint32 conv, const LLBC_ReliableUdpOptions &opts, bool sendOpenMarker)
+{
+    _reliableUdp = true;
+    _rudp = LLBC_New3(LLBC_ReliableUdp, conv, _handle, opts);
+    if (sendOpenMarker)
+        _rudp->Send(NULL, 0);
+}
+
+bool LLBC_Socket::IsReliableUdp() const
+{
+    return _reliableUdp;
+}
+
 #if LLBC_TARGET_PLATFORM_WIN32
 int LLBC_Socket::AcceptEx(LLBC_SocketHandle listenSock,
                           LLBC_SocketHandle acceptSock,
@@ -294,12 +377,25 @@ int LLBC_Socket::AsyncSend(const char *buf, int len)
 
 int LLBC_Socket::AsyncSend(LLBC_MessageBlock *block)
 {
+    // Reliable udp socket, queue data to ARQ engine.
+    if (_rudp)
+    {
+        _rudp->Send(reinterpret_cast<const char *>(block->GetDataStartWithReadPos()), block->GetReadableSize());
+        _willSendSize = _rudp->GetWaitSendSize();
+        LLBC_Delete(block);
+
+        return LLBC_OK;
+    }
+
+    const size_t blockLen = block->GetReadableSize();
     if (_willSend.Append(block) != LLBC_OK)
     {
         LLBC_XDelete(block);
         return LLBC_FAILED;
     }
 
+    _willSendSize += blockLen;
+
 #if LLBC_TARGET_PLATFORM_WIN32
     if (_pollerType != _PollerType::IocpPoller)
         return LLBC_OK;
@@ -348,6 +444,11 @@ bool LLBC_Socket::IsExistNoSendData() const
     return !!_willSend.FirstBlock();
 }
 
+size_t LLBC_Socket::GetWillSendSize() const
+{
+    return _willSendSize;
+}
+
 int LLBC_Socket::Recv(char *buf, int len)
 {
     return LLBC_Recv(_handle, buf, len, 0);
@@ -399,6 +500,16 @@ int LLBC_Socket::GetPendingError(int &pendingError)
     return GetOption(SOL_SOCKET, SO_ERROR, &pendingError, &soLen);
 }
 
+const LLBC_SendStat &LLBC_Socket::GetSendStat() const
+{
+    return _sendStat;
+}
+
+const LLBC_RecvStat &LLBC_Socket::GetRecvStat() const
+{
+    return _recvStat;
+}
+
 #if LLBC_TARGET_PLATFORM_WIN32
 void LLBC_Socket::OnSend(LLBC_POverlapped ol)
 #else
@@ -413,10 +524,14 @@ void LLBC_Socket::OnSend()
         LLBC_MessageBlock *block = reinterpret_cast<LLBC_MessageBlock *>(ol->data);
         if (LIKELY(block))
         {
-            size_t sent = block->GetReadableSize();
+            LLBC_SendStat sentStat;
+            sentStat.sentBlocks = 1;
+            sentStat.sentBytes = block->GetReadableSize();
             _olGroup.DeleteOverlapped(ol);
 
-            _session->OnSent(sent);
+            _willSendSize -= static_cast<size_t>(sentStat.sentBytes);
+            _sendStat += sentStat;
+            _session->OnSent(sentStat);
 
             return;
         }
@@ -425,17 +540,51 @@ void LLBC_Socket::OnSend()
     }
 #endif // LLBC_TARGET_PLATFORM_WIN32
 
-    int len = 0, totalLen = 0;
+    if (_rudp)
+    {
+        FlushReliableUdp(false);
+        return;
+    }
+
+    // Gather up to LLBC_IOV_MAX queued blocks, send them in one system call.
+    int len = 0;
+    LLBC_SendStat sentStat;
+    LLBC_IoVec vecs[LLBC_INL_NS __maxSendVecs];
     LLBC_MessageBlock *block = _willSend.FirstBlock();
     while (block)
     {
-        if ((len = LLBC_Send(_handle, 
-                             block->GetDataStartWithReadPos(), 
-                             static_cast<int>(block->GetReadableSize()), 0)) < 0)
+        int vecCount = 0;
+        size_t vecsLen = 0;
+        for (; block && vecCount < LLBC_INL_NS __maxSendVecs; block = block->GetNext())
+        {
+            const size_t blockLen = block->GetReadableSize();
+            if (vecCount > 0 && vecsLen + blockLen > static_cast<size_t>(INT_MAX))
+                break;
+
+            LLBC_IOVEC_SET(vecs[vecCount], block->GetDataStartWithReadPos(), blockLen);
+            vecsLen += blockLen;
+            ++vecCount;
+        }
+
+        ++sentStat.sendCalls;
+        if ((len = LLBC_SendV(_handle, vecs, vecCount)) < 0)
             break;
 
-        totalLen += len;
+        // Count fully sent blocks, the partial sent block will remain in the buffer head.
+        size_t remain = static_cast<size_t>(len);
+        for (int i = 0; i < vecCount && remain >= LLBC_INL_NS __GetIoVecLen(vecs[i]); ++i)
+        {
+            remain -= LLBC_INL_NS __GetIoVecLen(vecs[i]);
+            ++sentStat.sentBlocks;
+        }
+
+        sentStat.sentBytes += len;
         _willSend.Remove(len);
+
+        // Partial sent, the socket send buffer is full, wait next writable event.
+        if (static_cast<size_t>(len) < vecsLen)
+            break;
+
         block = _willSend.FirstBlock();
     }
 
@@ -450,8 +599,10 @@ void LLBC_Socket::OnSend()
          return;
     }
 
-    if (totalLen > 0)
-        _session->OnSent(totalLen);
+    // Always notify session, although no data sent, session need check send queue water marks.
+    _willSendSize -= static_cast<size_t>(sentStat.sentBytes);
+    _sendStat += sentStat;
+    _session->OnSent(sentStat);
 
 #if LLBC_TARGET_PLATFORM_WIN32
     if (_pollerType != _PollerType::IocpPoller)
@@ -517,22 +668,60 @@ void LLBC_Socket::OnRecv()
     }
 #endif // LLBC_TARGET_PLATFORM_WIN32
 
+    if (_rudp)
+    {
+        ReliableUdpRecv();
+        return;
+    }
+
     int len = 0;
-    bool recvFlag = false;
-    
-    LLBC_MessageBlock *block = LLBC_New(LLBC_MessageBlock);
-    while ((len = LLBC_Recv(_handle,
-                            block->GetDataStartWithWritePos(),
-                            static_cast<int>(block->GetWritableSize()),
-                            0)) > 0)
+    LLBC_RecvStat recvStat;
+    recvStat.recvEvents = 1;
+
+    // Receive data into poller receive slab, if slab full, process received data and switch to next slab.
+    // The slab continuous writable size at least as large as this session recent received bytes per event,
+    // and at most receive budget bytes in this event, if budget exhausted, session will be re-armed.
+    LLBC_BasePoller *poller = _session->GetPoller();
+    LLBC_RecvSlabPool *slabPool = poller->GetRecvSlabPool();
+    const size_t budget = poller->GetRecvBudget();
+
+    LLBC_RecvSlab *slab = slabPool->GetCurrent(_recvSizeHint);
+    size_t recvBeg = slab->GetWritePos();
+    for (; ;)
     {
-        block->ShiftWritePos(len);
-        if (block->GetWritableSize() == 0)
-            block->Allocate();
+        size_t recvSize = slab->GetWritableSize();
+        if (budget != 0)
+        {
+            if (recvStat.recvBytes >= budget)
+            {
+                recvStat.budgetExhausts = 1;
+                break;
+            }
+
+            recvSize = MIN(recvSize, budget - static_cast<size_t>(recvStat.recvBytes));
+        }
+
+        recvStat.recvCalls += 1;
+        if ((len = LLBC_Recv(_handle, slab->GetWritable(), static_cast<int>(recvSize), 0)) <= 0)
+            break;
 
-        recvFlag = true;
+        recvStat.recvBytes += len;
+        slab->ShiftWritePos(len);
+        if (slab->GetWritableSize() == 0)
+        {
+            if (!DeliverRecvedData(slab, recvBeg))
+                return;
+
+            slab = slabPool->GetCurrent(_recvSizeHint);
+            recvBeg = slab->GetWritePos();
+        }
     }
 
+    // Update receive statistic and size hint, if budget exhausted, session will be re-armed.
+    _recvStat += recvStat;
+    UpdateRecvSizeHint(static_cast<size_t>(recvStat.recvBytes), slab->GetSize());
+    _session->OnRecvFinished(recvStat);
+
     // If recv failed, firstly get last error.
     int errNo = LLBC_ERROR_SUCCESS;
     int subErrNo = LLBC_ERROR_SUCCESS;
@@ -546,15 +735,11 @@ void LLBC_Socket::OnRecv()
     }
 
     // Try process already received data, whether the errors occurred or not.
-    if (recvFlag)
+    if (slab->GetWritePos() > recvBeg)
     {
-        if (!_session->OnRecved(block))
+        if (!DeliverRecvedData(slab, recvBeg))
             return;
     }
-    else
-    {
-        LLBC_Delete(block);
-    }
 
     // Process errors.
     if (len < 0)
@@ -598,6 +783,24 @@ void LLBC_Socket::OnRecv()
 #endif // LLBC_TARGET_PLATFORM_WIN32
 }
 
+bool LLBC_Socket::DeliverRecvedData(LLBC_RecvSlab *slab, size_t recvBeg)
+{
+    // Attach received data to stack message block, session will not take over it.
+    const size_t recvedLen = slab->GetWritePos() - recvBeg;
+    LLBC_MessageBlock block(slab->GetBuf() + recvBeg, recvedLen);
+    block.SetWritePos(recvedLen);
+
+    return _session->OnRecved(&block, slab);
+}
+
+void LLBC_Socket::UpdateRecvSizeHint(size_t recvedBytes, size_t slabSize)
+{
+    // Exponential moving average(alpha = 1/4), the hint follow session recent traffic,
+    // and not jump by one burst.
+    _recvSizeHint = _recvSizeHint - _recvSizeHint / 4 + recvedBytes / 4;
+    _recvSizeHint = MIN(MAX(_recvSizeHint, LLBC_INL_NS __minRecvSizeHint), slabSize);
+}
+
 #if LLBC_TARGET_PLATFORM_WIN32
 void LLBC_Socket::OnClose(LLBC_POverlapped ol)
 #else
@@ -612,6 +815,152 @@ void LLBC_Socket::OnClose()
     Close();
 }
 
+void LLBC_Socket::OnReliableUdpRecved(const char *data, size_t len)
+{
+    LLBC_RecvStat recvStat;
+    recvStat.recvEvents = 1;
+    recvStat.recvBytes = len;
+
+    _recvStat += recvStat;
+    _session->OnRecvFinished(recvStat);
+
+    _rudp->Input(data, len);
+    if (DeliverReliableUdpData())
+        FlushReliableUdp(false);
+}
+
+void LLBC_Socket::OnReliableUdpUpdate()
+{
+    FlushReliableUdp(true);
+}
+
+void LLBC_Socket::ReliableUdpRecv()
+{
+    int len = 0;
+    LLBC_RecvStat recvStat;
+    recvStat.recvEvents = 1;
+
+    // Receive all datagrams(at most receive budget bytes) and input to ARQ engine, the bad datagrams are ignored.
+    char buf[LLBC_INL_NS __rudpRecvBufSize];
+    const size_t budget = _session->GetPoller()->GetRecvBudget();
+    for (; ;)
+    {
+        if (budget != 0 && recvStat.recvBytes >= budget)
+        {
+            recvStat.budgetExhausts = 1;
+            break;
+        }
+
+        recvStat.recvCalls += 1;
+        if ((len = LLBC_Recv(_handle, buf, static_cast<int>(sizeof(buf)), 0)) < 0)
+            break;
+
+        recvStat.recvBytes += len;
+        _rudp->Input(buf, len);
+        if (_rudp->IsPeerClosed())
+            break;
+    }
+
+    _recvStat += recvStat;
+    _session->OnRecvFinished(recvStat);
+
+    // If recv failed, firstly get last error.
+    int errNo = LLBC_ERROR_SUCCESS;
+    int subErrNo = LLBC_ERROR_SUCCESS;
+    if (len < 0)
+    {
+        errNo = LLBC_Errno;
+        if (!LLBC_ERROR_TYPE_IS_LIBRARY(errNo))
+            subErrNo = LLBC_SubErrno;
+    }
+
+    // Deliver already received data, whether the errors occurred or not.
+    if (!DeliverReliableUdpData())
+        return;
+
+    // Process errors(eg: peer not listen, ICMP port unreachable received).
+    if (len < 0 &&
+        errNo != LLBC_ERROR_WBLOCK
+#if LLBC_TARGET_PLATFORM_NON_WIN32
+        && errNo != LLBC_ERROR_AGAIN
+#endif
+        )
+    {
+#if LLBC_TARGET_PLATFORM_NON_WIN32
+        _session->OnClose(new LLBC_SessionCloseInfo(errNo, subErrNo));
+#else
+        _session->OnClose(NULL, new LLBC_SessionCloseInfo(errNo, subErrNo));
+#endif
+        return;
+    }
+
+    // Send acks immediately.
+    FlushReliableUdp(false);
+}
+
+bool LLBC_Socket::DeliverReliableUdpData()
+{
+    // Copy in-order data to poller receive slab, same as io_uring poller provided buffer.
+    LLBC_RecvSlabPool *slabPool = _session->GetPoller()->GetRecvSlabPool();
+    for (size_t len = _rudp->GetRecvableSize(); len > 0; len = _rudp->GetRecvableSize())
+    {
+        LLBC_RecvSlab *slab = slabPool->GetCurrent(len);
+        const size_t recvBeg = slab->GetWritePos();
+        slab->ShiftWritePos(_rudp->Recv(slab->GetWritable(), slab->GetWritableSize()));
+        if (!DeliverRecvedData(slab, recvBeg))
+            return false;
+    }
+
+    // Connection close by peer, same as tcp socket, set to connection reset error.
+    if (_rudp->IsPeerClosed())
+    {
+        CloseSessionWithError(LLBC_INL_NS __connResetErr);
+        return false;
+    }
+
+    return true;
+}
+
+bool LLBC_Socket::FlushReliableUdp(bool update)
+{
+    const uint64 sentDatagrams = _rudp->GetSentDatagrams();
+    const uint64 sentBytes = _rudp->GetSentBytes();
+    if (update)
+        _rudp->Update();
+    else
+        _rudp->Flush();
+
+    // Retransmitted too many times or idle timeout.
+    if (_rudp->IsDead())
+    {
+        CloseSessionWithError(LLBC_INL_NS __timedOutErr);
+        return false;
+    }
+
+    // Every datagram is one send call.
+    LLBC_SendStat sentStat;
+    sentStat.sendCalls = _rudp->GetSentDatagrams() - sentDatagrams;
+    sentStat.sentBlocks = sentStat.sendCalls;
+    sentStat.sentBytes = _rudp->GetSentBytes() - sentBytes;
+
+    _willSendSize = _rudp->GetWaitSendSize();
+    _sendStat += sentStat;
+    _session->OnSent(sentStat);
+
+    return true;
+}
+
+void LLBC_Socket::CloseSessionWithError(int subErrNo)
+{
+    LLBC_SessionCloseInfo *closeInfo =
+        new LLBC_SessionCloseInfo(LLBC_INL_NS __sockErrType, subErrNo);
+#if LLBC_TARGET_PLATFORM_NON_WIN32
+    _session->OnClose(closeInfo);
+#else
+    _session->OnClose(NULL, closeInfo);
+#endif
+}
+
 #if LLBC_TARGET_PLATFORM_WIN32
 LLBC_OverlappedGroup &LLBC_Socket::GetOverlappedGroup()
 {
@@ -712,6 +1061,73 @@ int LLBC_Socket::PostAsyncAccept()
 
 #endif // LLBC_TARGET_PLATFORM_WIN32
 
+#if LLBC_TARGET_PLATFORM_LINUX
+int LLBC_Socket::FillUringSendVecs(LLBC_IoVec *vecs, int maxVecs)
+{
+    int vecCount = 0;
+    size_t vecsLen = 0;
+    for (LLBC_MessageBlock *block = _willSend.FirstBlock();
+         block && vecCount < maxVecs;
+         block = block->GetNext())
+    {
+        const size_t blockLen = block->GetReadableSize();
+        if (vecCount > 0 && vecsLen + blockLen > static_cast<size_t>(INT_MAX))
+            break;
+
+        LLBC_IOVEC_SET(vecs[vecCount], block->GetDataStartWithReadPos(), blockLen);
+        vecsLen += blockLen;
+        ++vecCount;
+    }
+
+    return vecCount;
+}
+
+void LLBC_Socket::OnUringSent(int len, const LLBC_IoVec *vecs, int vecCount)
+{
+    LLBC_SendStat sentStat;
+    sentStat.sendCalls = 1;
+
+    // Same as OnSend(), count fully sent blocks.
+    size_t remain = static_cast<size_t>(len);
+    for (int i = 0; i < vecCount && remain >= LLBC_INL_NS __GetIoVecLen(vecs[i]); ++i)
+    {
+        remain -= LLBC_INL_NS __GetIoVecLen(vecs[i]);
+        ++sentStat.sentBlocks;
+    }
+
+    sentStat.sentBytes = len;
+    _willSend.Remove(len);
+    _willSendSize -= static_cast<size_t>(len);
+
+    _sendStat += sentStat;
+    _session->OnSent(sentStat);
+}
+
+bool LLBC_Socket::OnUringRecved(LLBC_RecvSlab *slab, size_t len)
+{
+    LLBC_RecvStat recvStat;
+    recvStat.recvEvents = 1;
+    recvStat.recvCalls = 1;
+    recvStat.recvBytes = len;
+
+    _recvStat += recvStat;
+    _session->OnRecvFinished(recvStat);
+
+    // Kernel already received data into slab, deliver it directly, the packets reference
+    // slab memory(see DeliverRecvedData()).
+    const size_t recvBeg = slab->GetWritePos();
+    slab->ShiftWritePos(len);
+
+    return DeliverRecvedData(slab, recvBeg);
+}
+
+LLBC_MessageBlock *LLBC_Socket::DetachUringSendBlocks()
+{
+    _willSendSize = 0;
+    return _willSend.DetachBuffers();
+}
+#endif // LLBC_TARGET_PLATFORM_LINUX
+
 __LLBC_NS_END
 
 #include "llbc/common/AfterIncl.h"
@@ -0,0 +1,145 @@
+/**
+ * @file    TrafficStat.cpp
+ * @author  Longwei Lai<lailongwei@126.com>
+ * @date    2026/10/18
+ * @version 1.0
+ *
+ * @brief
+ */
+
+#include "llbc/common/Export.h"
+#include "llbc/common/BeforeIncl.h"
+
+#include "llbc/comm/TrafficStat.h"
+
+__LLBC_INTERNAL_NS_BEGIN
+
+typedef std::pair<LLBC_NS uint64, int> __TrafficRankItem;
+
+/**
+ * Rank counters by sent + received bytes, descending.
+ */
+static void __RankCounters(const LLBC_NS LLBC_TrafficStat::Counters &counters,
+                           size_t topN,
+                           std::vector<__TrafficRankItem> &ranked)
+{
+    ranked.clear();
+    ranked.reserve(counters.size());
+    for (LLBC_NS LLBC_TrafficStat::Counters::const_iterator it = counters.begin();
+         it != counters.end();
+         it++)
+        ranked.push_back(__TrafficRankItem(it->second.sentBytes + it->second.recvBytes, it->first));
+
+    const size_t keep = MIN(topN, ranked.size());
+    std::partial_sort(ranked.begin(),
+                      ranked.begin() + keep,
+                      ranked.end(),
+                      std::greater<__TrafficRankItem>());
+    ranked.resize(keep);
+}
+
+__LLBC_INTERNAL_NS_END
+
+__LLBC_NS_BEGIN
+
+LLBC_TrafficCounter::LLBC_TrafficCounter()
+: sentPackets(0)
+, sentBytes(0)
+, recvPackets(0)
+, recvBytes(0)
+
+, encodeSamples(0)
+, encodeTime(0)
+, decodeSamples(0)
+, decodeTime(0)
+, handleSamples(0)
+, handleTime(0)
+{
+}
+
+void LLBC_TrafficCounter::Reset()
+{
+    sentPackets = 0;
+    sentBytes = 0;
+    recvPackets = 0;
+    recvBytes = 0;
+
+    encodeSamples = 0;
+    encodeTime = 0;
+    decodeSamples = 0;
+    decodeTime = 0;
+    handleSamples = 0;
+    handleTime = 0;
+}
+
+double LLBC_TrafficCounter::GetAvgEncodeTime() const
+{
+    return encodeSamples != 0 ? static_cast<double>(encodeTime) / encodeSamples : 0.0;
+}
+
+double LLBC_TrafficCounter::GetAvgDecodeTime() const
+{
+    return decodeSamples != 0 ? static_cast<double>(decodeTime) / decodeSamples : 0.0;
+}
+
+double LLBC_TrafficCounter::GetAvgHandleTime() const
+{
+    return handleSamples != 0 ? static_cast<double>(handleTime) / handleSamples : 0.0;
+}
+
+LLBC_TrafficCounter &LLBC_TrafficCounter::operator +=(const LLBC_TrafficCounter &other)
+{
+    sentPackets += other.sentPackets;
+    sentBytes += other.sentBytes;
+    recvPackets += other.recvPackets;
+    recvBytes += other.recvBytes;
+
+    encodeSamples += other.encodeSamples;
+    encodeTime += other.encodeTime;
+    decodeSamples += other.decodeSamples;
+    decodeTime += other.decodeTime;
+    handleSamples += other.handleSamples;
+    handleTime += other.handleTime;
+
+    return *this;
+}
+
+LLBC_String LLBC_TrafficCounter::ToString() const
+{
+    return LLBC_String().format("sent: %llu/%llu bytes, recv: %llu/%llu bytes, "
+                                "avg encode: %.2f us, avg decode: %.2f us, avg handle: %.2f us",
+                                sentPackets, sentBytes, recvPackets, recvBytes,
+                                GetAvgEncodeTime(), GetAvgDecodeTime(), GetAvgHandleTime());
+}
+
+void LLBC_TrafficStat::Reset()
+{
+    total.Reset();
+    opcodes.clear();
+    sessions.clear();
+}
+
+LLBC_String LLBC_TrafficStat::ToString(size_t topN) const
+{
+    LLBC_String repr;
+    repr.format("total: %s", total.ToString().c_str());
+
+    std::vector<LLBC_INL_NS __TrafficRankItem> ranked;
+    LLBC_INL_NS __RankCounters(opcodes, topN, ranked);
+    repr.append_format("\ntop opcodes(%lu/%lu):", ranked.size(), opcodes.size());
+    for (size_t i = 0; i < ranked.size(); i++)
+        repr.append_format("\n  opcode %d: %s",
+                           ranked[i].second, opcodes.find(ranked[i].second)->second.ToString().c_str());
+
+    LLBC_INL_NS __RankCounters(sessions, topN, ranked);
+    repr.append_format("\ntop sessions(%lu/%lu):", ranked.size(), sessions.size());
+    for (size_t i = 0; i < ranked.size(); i++)
+        repr.append_format("\n  session %d: %s",
+                           ranked[i].second, sessions.find(ranked[i].second)->second.ToString().c_str());
+
+    return repr;
+}
+
+__LLBC_NS_END
+
+#include "llbc/common/AfterIncl.h"
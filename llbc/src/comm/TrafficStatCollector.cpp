@@ -0,0 +1,395 @@
+/**
+ * @file    TrafficStatCollector.cpp
+ * @author  Longwei Lai<lailongwei@126.com>
+ * @date    2026/10/18
+ * @version 1.0
+ *
+ * @brief
+ */
+
+#include "llbc/common/Export.h"
+#include "llbc/common/BeforeIncl.h"
+
+#include "llbc/comm/TrafficStatCollector.h"
+
+__LLBC_INTERNAL_NS_BEGIN
+
+/**
+ * The thread local shard cache slot.
+ */
+struct __TrafficShardCacheSlot
+{
+    LLBC_NS sint64 serial;
+    void *shard;
+};
+
+static const int __trafficShardCacheSlots = 4;
+
+/**
+ * The collector thread local data, every packet access it(sample ticks, shard cache), keep it small
+ * and use initial-exec model.
+ */
+struct __TrafficTls
+{
+    __TrafficShardCacheSlot shardCache[__trafficShardCacheSlots];
+    int shardCacheNext;
+
+    LLBC_NS uint32 sendTimingTick;
+    LLBC_NS uint32 recvTimingTick;
+};
+
+static LLBC_THREAD_LOCAL_INITIAL_EXEC __TrafficTls __trafficTls;
+
+static volatile LLBC_NS sint64 __trafficCollectorSerial = 0;
+
+/**
+ * The minimum dense opcode counters array size.
+ */
+static const int __trafficMinDenseOpcodeSize = 64;
+
+/**
+ * Single writer counter add, reader load it with relaxed load.
+ */
+static inline void __TrafficCounterAdd(LLBC_NS uint64 &value, LLBC_NS uint64 delta)
+{
+    LLBC_NS LLBC_AtomicStoreRelaxed(&value, value + delta);
+}
+
+__LLBC_INTERNAL_NS_END
+
+__LLBC_NS_BEGIN
+
+LLBC_TrafficStatCollector::_Shard::_Shard()
+: locked(0)
+, removePending(0)
+
+, denseOpcodes(NULL)
+, denseOpcodeSize(0)
+{
+    memset(sessionCacheIds, 0, sizeof(sessionCacheIds));
+    memset(sessionCacheCounters, 0, sizeof(sessionCacheCounters));
+}
+
+LLBC_TrafficStatCollector::_Shard::~_Shard()
+{
+    LLBC_XFree(denseOpcodes);
+}
+
+LLBC_TrafficStatCollector::LLBC_TrafficStatCollector()
+: _serial(LLBC_AtomicFetchAndAdd(&LLBC_INL_NS __trafficCollectorSerial, 1) + 1)
+{
+}
+
+LLBC_TrafficStatCollector::~LLBC_TrafficStatCollector()
+{
+    LLBC_STLHelper::DeleteContainer(_shards);
+}
+
+bool LLBC_TrafficStatCollector::IsSendTimingSample()
+{
+    return (LLBC_INL_NS __trafficTls.sendTimingTick++ & (LLBC_CFG_COMM_TRAFFIC_STAT_TIMING_SAMPLE - 1)) == 0;
+}
+
+bool LLBC_TrafficStatCollector::IsRecvTimingSample()
+{
+    return (LLBC_INL_NS __trafficTls.recvTimingTick++ & (LLBC_CFG_COMM_TRAFFIC_STAT_TIMING_SAMPLE - 1)) == 0;
+}
+
+void LLBC_TrafficStatCollector::OnSent(int sessionId, int opcode, size_t bytes, sint64 encodeTime)
+{
+    _Shard *shard = GetShard();
+    if (UNLIKELY(shard->removePending))
+        ApplyRemovedSessions(shard);
+
+    AddSent(GetOpcodeCounter(shard, opcode), 1, bytes, encodeTime);
+    AddSent(GetSessionCounter(shard, sessionId), 1, bytes, encodeTime);
+}
+
+void LLBC_TrafficStatCollector::OnMulticastSent(const LLBC_SessionIdList &sessionIds,
+                                                int opcode,
+                                                size_t bytes,
+                                                sint64 encodeTime)
+{
+    _Shard *shard = GetShard();
+    if (UNLIKELY(shard->removePending))
+        ApplyRemovedSessions(shard);
+
+    AddSent(GetOpcodeCounter(shard, opcode), sessionIds.size(), sessionIds.size() * bytes, encodeTime);
+    for (LLBC_SessionIdListCIter it = sessionIds.begin();
+         it != sessionIds.end();
+         it++)
+        AddSent(GetSessionCounter(shard, *it), 1, bytes, encodeTime);
+}
+
+void LLBC_TrafficStatCollector::OnRecved(int sessionId,
+                                         int opcode,
+                                         size_t bytes,
+                                         sint64 decodeTime,
+                                         sint64 handleTime)
+{
+    _Shard *shard = GetShard();
+    if (UNLIKELY(shard->removePending))
+        ApplyRemovedSessions(shard);
+
+    AddRecved(GetOpcodeCounter(shard, opcode), bytes, decodeTime, handleTime);
+    AddRecved(GetSessionCounter(shard, sessionId), bytes, decodeTime, handleTime);
+}
+
+void LLBC_TrafficStatCollector::RemoveSession(int sessionId)
+{
+    // Not erase other shards sessions directly(owner update them lock free), only mark pending.
+    LLBC_Guard guard(_shardsLock);
+    for (std::map<const void *, _Shard *>::iterator it = _shards.begin();
+         it != _shards.end();
+         it++)
+    {
+        _Shard *shard = it->second;
+
+        LockShard(shard);
+        if (shard->sessions.find(sessionId) != shard->sessions.end())
+        {
+            shard->removedSessions.insert(sessionId);
+            LLBC_AtomicStoreRelease(&shard->removePending, 1);
+        }
+        UnlockShard(shard);
+    }
+}
+
+void LLBC_TrafficStatCollector::Snapshot(LLBC_TrafficStat &stat)
+{
+    stat.Reset();
+
+    LLBC_TrafficCounter counter;
+    LLBC_Guard guard(_shardsLock);
+    for (std::map<const void *, _Shard *>::iterator it = _shards.begin();
+         it != _shards.end();
+         it++)
+    {
+        _Shard *shard = it->second;
+
+        LockShard(shard);
+        for (int opcode = 0; opcode < shard->denseOpcodeSize; opcode++)
+        {
+            LoadCounter(shard->denseOpcodes[opcode], counter);
+            if (counter.sentPackets == 0 && counter.recvPackets == 0)
+                continue;
+
+            stat.opcodes[opcode] += counter;
+            stat.total += counter;
+        }
+
+        for (LLBC_TrafficStat::Counters::const_iterator opIt = shard->sparseOpcodes.begin();
+             opIt != shard->sparseOpcodes.end();
+             opIt++)
+        {
+            LoadCounter(opIt->second, counter);
+            stat.opcodes[opIt->first] += counter;
+            stat.total += counter;
+        }
+
+        for (LLBC_TrafficStat::Counters::const_iterator sessionIt = shard->sessions.begin();
+             sessionIt != shard->sessions.end();
+             sessionIt++)
+        {
+            if (!shard->removedSessions.empty() &&
+                shard->removedSessions.find(sessionIt->first) != shard->removedSessions.end())
+                continue;
+
+            LoadCounter(sessionIt->second, counter);
+            stat.sessions[sessionIt->first] += counter;
+        }
+        UnlockShard(shard);
+    }
+}
+
+LLBC_TrafficStatCollector::_Shard *LLBC_TrafficStatCollector::GetShard()
+{
+    LLBC_INL_NS __TrafficTls &tls = LLBC_INL_NS __trafficTls;
+    for (int i = 0; i < LLBC_INL_NS __trafficShardCacheSlots; i++)
+    {
+        if (tls.shardCache[i].serial == _serial)
+            return reinterpret_cast<_Shard *>(tls.shardCache[i].shard);
+    }
+
+    _Shard *shard = LookupShard();
+
+    LLBC_INL_NS __TrafficShardCacheSlot &slot = tls.shardCache[tls.shardCacheNext];
+    slot.serial = _serial;
+    slot.shard = shard;
+    tls.shardCacheNext = (tls.shardCacheNext + 1) % LLBC_INL_NS __trafficShardCacheSlots;
+
+    return shard;
+}
+
+LLBC_TrafficStatCollector::_Shard *LLBC_TrafficStatCollector::LookupShard()
+{
+    // Thread local variable address is unique in all alive threads, use it as thread key, if thread
+    // exited, the new thread may reuse the exited thread's shard, it is safe because shard only has
+    // one writer at any time.
+    const void *threadKey = &LLBC_INL_NS __trafficTls;
+
+    LLBC_Guard guard(_shardsLock);
+    _Shard *&shard = _shards[threadKey];
+    if (!shard)
+        shard = LLBC_New(_Shard);
+
+    return shard;
+}
+
+void LLBC_TrafficStatCollector::LockShard(_Shard *shard)
+{
+    while (LLBC_AtomicCompareAndExchange(&shard->locked, 1, 0) != 0)
+        ;
+}
+
+void LLBC_TrafficStatCollector::UnlockShard(_Shard *shard)
+{
+    LLBC_AtomicStoreRelease(&shard->locked, 0);
+}
+
+void LLBC_TrafficStatCollector::ApplyRemovedSessions(_Shard *shard)
+{
+    LockShard(shard);
+    for (std::set<int>::const_iterator it = shard->removedSessions.begin();
+         it != shard->removedSessions.end();
+         it++)
+    {
+        const int sessionId = *it;
+        const int slot = sessionId & (_Shard::SessionCacheSlots - 1);
+        if (shard->sessionCacheIds[slot] == sessionId)
+        {
+            shard->sessionCacheIds[slot] = 0;
+            shard->sessionCacheCounters[slot] = NULL;
+        }
+
+        shard->sessions.erase(sessionId);
+    }
+
+    shard->removedSessions.clear();
+    LLBC_AtomicStoreRelease(&shard->removePending, 0);
+    UnlockShard(shard);
+}
+
+LLBC_TrafficCounter &LLBC_TrafficStatCollector::GetOpcodeCounter(_Shard *shard, int opcode)
+{
+    if (LIKELY(static_cast<uint32>(opcode) < static_cast<uint32>(shard->denseOpcodeSize)))
+        return shard->denseOpcodes[opcode];
+
+    return GetOpcodeCounterSlow(shard, opcode);
+}
+
+LLBC_TrafficCounter &LLBC_TrafficStatCollector::GetOpcodeCounterSlow(_Shard *shard, int opcode)
+{
+    // Sparse opcode, only owner insert, so find without lock.
+    if (opcode < 0 || opcode >= LLBC_CFG_COMM_OPCODE_DISPATCH_DENSE_LIMIT)
+    {
+        LLBC_TrafficStat::Counters::iterator it = shard->sparseOpcodes.find(opcode);
+        if (it != shard->sparseOpcodes.end())
+            return it->second;
+
+        LockShard(shard);
+        LLBC_TrafficCounter &counter = shard->sparseOpcodes[opcode];
+        UnlockShard(shard);
+
+        return counter;
+    }
+
+    // Dense opcode, grow array to power of 2 size, copy counters outside lock(owner is the only writer).
+    int newSize = MAX(shard->denseOpcodeSize, LLBC_INL_NS __trafficMinDenseOpcodeSize);
+    while (newSize <= opcode)
+        newSize <<= 1;
+    newSize = MIN(newSize, LLBC_CFG_COMM_OPCODE_DISPATCH_DENSE_LIMIT);
+
+    LLBC_TrafficCounter *newOpcodes = LLBC_Calloc(LLBC_TrafficCounter, sizeof(LLBC_TrafficCounter) * newSize);
+    if (shard->denseOpcodeSize > 0)
+        memcpy(newOpcodes, shard->denseOpcodes, sizeof(LLBC_TrafficCounter) * shard->denseOpcodeSize);
+
+    LockShard(shard);
+    LLBC_TrafficCounter *oldOpcodes = shard->denseOpcodes;
+    shard->denseOpcodes = newOpcodes;
+    shard->denseOpcodeSize = newSize;
+    UnlockShard(shard);
+
+    LLBC_XFree(oldOpcodes);
+
+    return shard->denseOpcodes[opcode];
+}
+
+LLBC_TrafficCounter &LLBC_TrafficStatCollector::GetSessionCounter(_Shard *shard, int sessionId)
+{
+    const int slot = sessionId & (_Shard::SessionCacheSlots - 1);
+    if (LIKELY(shard->sessionCacheCounters[slot] && shard->sessionCacheIds[slot] == sessionId))
+        return *shard->sessionCacheCounters[slot];
+
+    // Only owner insert, so find without lock.
+    LLBC_TrafficCounter *counter;
+    LLBC_TrafficStat::Counters::iterator it = shard->sessions.find(sessionId);
+    if (it != shard->sessions.end())
+    {
+        counter = &it->second;
+    }
+    else
+    {
+        LockShard(shard);
+        counter = &shard->sessions[sessionId];
+        UnlockShard(shard);
+    }
+
+    shard->sessionCacheIds[slot] = sessionId;
+    shard->sessionCacheCounters[slot] = counter;
+
+    return *counter;
+}
+
+void LLBC_TrafficStatCollector::AddSent(LLBC_TrafficCounter &counter,
+                                        size_t packets,
+                                        size_t bytes,
+                                        sint64 encodeTime)
+{
+    LLBC_INL_NS __TrafficCounterAdd(counter.sentPackets, packets);
+    LLBC_INL_NS __TrafficCounterAdd(counter.sentBytes, bytes);
+    if (encodeTime >= 0)
+    {
+        LLBC_INL_NS __TrafficCounterAdd(counter.encodeSamples, 1);
+        LLBC_INL_NS __TrafficCounterAdd(counter.encodeTime, static_cast<uint64>(encodeTime));
+    }
+}
+
+void LLBC_TrafficStatCollector::AddRecved(LLBC_TrafficCounter &counter,
+                                          size_t bytes,
+                                          sint64 decodeTime,
+                                          sint64 handleTime)
+{
+    LLBC_INL_NS __TrafficCounterAdd(counter.recvPackets, 1);
+    LLBC_INL_NS __TrafficCounterAdd(counter.recvBytes, bytes);
+    if (decodeTime >= 0)
+    {
+        LLBC_INL_NS __TrafficCounterAdd(counter.decodeSamples, 1);
+        LLBC_INL_NS __TrafficCounterAdd(counter.decodeTime, static_cast<uint64>(decodeTime));
+    }
+
+    if (handleTime >= 0)
+    {
+        LLBC_INL_NS __TrafficCounterAdd(counter.handleSamples, 1);
+        LLBC_INL_NS __TrafficCounterAdd(counter.handleTime, static_cast<uint64>(handleTime));
+    }
+}
+
+void LLBC_TrafficStatCollector::LoadCounter(const LLBC_TrafficCounter &counter, LLBC_TrafficCounter &loaded)
+{
+    LLBC_TrafficCounter &src = const_cast<LLBC_TrafficCounter &>(counter);
+    loaded.sentPackets = LLBC_AtomicLoadRelaxed(&src.sentPackets);
+    loaded.sentBytes = LLBC_AtomicLoadRelaxed(&src.sentBytes);
+    loaded.recvPackets = LLBC_AtomicLoadRelaxed(&src.recvPackets);
+    loaded.recvBytes = LLBC_AtomicLoadRelaxed(&src.recvBytes);
+    loaded.encodeSamples = LLBC_AtomicLoadRelaxed(&src.encodeSamples);
+    loaded.encodeTime = LLBC_AtomicLoadRelaxed(&src.encodeTime);
+    loaded.decodeSamples = LLBC_AtomicLoadRelaxed(&src.decodeSamples);
+    loaded.decodeTime = LLBC_AtomicLoadRelaxed(&src.decodeTime);
+    loaded.handleSamples = LLBC_AtomicLoadRelaxed(&src.handleSamples);
+    loaded.handleTime = LLBC_AtomicLoadRelaxed(&src.handleTime);
+}
+
+__LLBC_NS_END
+
+#include "llbc/common/AfterIncl.h"
@@ -11,6 +11,7 @@
 #include "llbc/common/BeforeIncl.h"
 
 #include "llbc/comm/ICoder.h"
+#include "llbc/comm/OpcodeDispatchTable.h"
 #include "llbc/comm/protocol/ProtocolLayer.h"
 #include "llbc/comm/protocol/ProtoReportLevel.h"
 #include "llbc/comm/protocol/IProtocol.h"
@@ -69,10 +70,29 @@ int LLBC_CodecProtocol::Send(void *in, void *&out, bool &removeSession)
 int LLBC_CodecProtocol::Recv(void *in, void *&out, bool &removeSession)
 {
     LLBC_Packet *packet = reinterpret_cast<LLBC_Packet *>(in);
-    _Coders::iterator it = _coders.find(packet->GetOpcode());
-    if (it != _coders.end())
+
+    // Payload chunk only hold part of payload, can't decode, deliver raw chunk to handler.
+    if (UNLIKELY(packet->IsChunk()))
+    {
+        out = in;
+        return LLBC_OK;
+    }
+
+    // Find coder factory, prefer service compiled dispatch table.
+    LLBC_ICoderFactory *coderFactory;
+    if (LIKELY(_stack->_dispatchTable))
+    {
+        coderFactory = _stack->_dispatchTable->Find(packet->GetOpcode()).coder;
+    }
+    else
+    {
+        _Coders::iterator it = _coders.find(packet->GetOpcode());
+        coderFactory = it != _coders.end() ? it->second : NULL;
+    }
+
+    if (coderFactory)
     {
-        LLBC_ICoder *coder = it->second->Create();
+        LLBC_ICoder *coder = coderFactory->Create();
         if (UNLIKELY(!coder->Decode(*packet)))
         {
             LLBC_String reportMsg = LLBC_String().format(
@@ -0,0 +1,47 @@
+/**
+ * @file    CompressPolicy.cpp
+ * @author  Longwei Lai<lailongwei@126.com>
+ * @date    2026/10/18
+ * @version 1.0
+ *
+ * @brief
+ */
+
+#include "llbc/common/Export.h"
+#include "llbc/common/BeforeIncl.h"
+
+#include "llbc/comm/protocol/CompressPolicy.h"
+
+namespace
+{
+    typedef LLBC_NS LLBC_CompressPolicy This;
+}
+
+__LLBC_INTERNAL_NS_BEGIN
+
+static const LLBC_NS LLBC_String __g_descs[] =
+{
+    "None",
+    "Threshold",
+    "Always",
+
+    "Invalid"
+};
+
+__LLBC_INTERNAL_NS_END
+
+__LLBC_NS_BEGIN
+
+bool LLBC_CompressPolicy::IsValid(int policy)
+{
+    return (This::Begin <= policy && policy < This::End);
+}
+
+const LLBC_String &LLBC_CompressPolicy::Policy2Str(int policy)
+{
+    return LLBC_INL_NS __g_descs[This::IsValid(policy) ? policy : This::End];
+}
+
+__LLBC_NS_END
+
+#include "llbc/common/AfterIncl.h"
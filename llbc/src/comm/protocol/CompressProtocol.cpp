@@ -10,12 +10,42 @@
 #include "llbc/common/Export.h"
 #include "llbc/common/BeforeIncl.h"
 
+#include "llbc/comm/Packet.h"
+#include "llbc/comm/PacketHeaderDescAccessor.h"
 #include "llbc/comm/protocol/ProtocolLayer.h"
+#include "llbc/comm/protocol/ProtoReportLevel.h"
+#include "llbc/comm/protocol/CompressPolicy.h"
 #include "llbc/comm/protocol/IProtocol.h"
+#include "llbc/comm/protocol/ProtocolStack.h"
+
+namespace
+{
+    typedef LLBC_NS LLBC_PacketHeaderDescAccessor _HDAccessor;
+}
+
+__LLBC_INTERNAL_NS_BEGIN
+
+// The compressed payload original length part length.
+static const size_t __origLenPartLen = sizeof(LLBC_NS uint32);
+
+static bool __IsFlagsSupported()
+{
+    const LLBC_NS LLBC_PacketHeaderDesc *headerDesc = _HDAccessor::GetHeaderDesc();
+    return headerDesc->IsHasFlagsPart() &&
+        headerDesc->GetFlagsPartLen() >= sizeof(LLBC_NS uint16);
+}
+
+__LLBC_INTERNAL_NS_END
 
 __LLBC_NS_BEGIN
 
 LLBC_CompressProtocol::LLBC_CompressProtocol()
+: _flagsSupported(LLBC_INL_NS __IsFlagsSupported())
+, _headerLen(_HDAccessor::GetHeaderDesc()->GetHeaderLen())
+
+, _policy(LLBC_CompressPolicy::None)
+, _threshold(LLBC_CFG_COMM_DFT_COMPRESS_THRESHOLD)
+, _opcodePolicies(NULL)
 {
 }
 
@@ -36,12 +66,91 @@ int LLBC_CompressProtocol::Connect(LLBC_SockAddr_IN &local, LLBC_SockAddr_IN &pe
 int LLBC_CompressProtocol::Send(void *in, void *&out, bool &removeSession)
 {
     out = in;
+
+    LLBC_Packet *packet = reinterpret_cast<LLBC_Packet *>(in);
+    if (!IsNeedCompress(packet))
+        return LLBC_OK;
+
+    // Compress payload to new block, if compressed data not smaller than original payload, give up it
+    // (the compress buffer capacity limit make LZ4 compress failed early, don't need compare again).
+    const size_t payloadLen = packet->GetPayloadLength();
+    if (payloadLen <= LLBC_INL_NS __origLenPartLen)
+        return LLBC_OK;
+
+    const size_t dstCap = payloadLen - LLBC_INL_NS __origLenPartLen - 1;
+    LLBC_MessageBlock *block = LLBC_New1(LLBC_MessageBlock, _headerLen + payloadLen);
+    char *buf = reinterpret_cast<char *>(block->GetData());
+
+    size_t compressedLen;
+    if (LLBC_LZ4::Compress(packet->GetPayload(),
+                           payloadLen,
+                           buf + _headerLen + LLBC_INL_NS __origLenPartLen,
+                           dstCap,
+                           compressedLen) != LLBC_OK)
+    {
+        LLBC_Delete(block);
+        return LLBC_OK;
+    }
+
+    uint32 origLen = static_cast<uint32>(payloadLen);
+#if LLBC_CFG_COMM_ORDER_IS_NET_ORDER
+    LLBC_Host2Net(origLen);
+#endif
+    memcpy(buf, packet->_block->GetData(), _headerLen);
+    memcpy(buf + _headerLen, &origLen, sizeof(origLen));
+    block->SetWritePos(_headerLen + LLBC_INL_NS __origLenPartLen + compressedLen);
+
+    packet->ReplaceBlock(block);
+    packet->AddFlags(LLBC_CFG_COMM_COMPRESSED_FLAG);
+
     return LLBC_OK;
 }
 
 int LLBC_CompressProtocol::Recv(void *in, void *&out, bool &removeSession)
 {
     out = in;
+    if (!_flagsSupported)
+        return LLBC_OK;
+
+    LLBC_Packet *packet = reinterpret_cast<LLBC_Packet *>(in);
+    if (!packet->HasFlags(LLBC_CFG_COMM_COMPRESSED_FLAG))
+        return LLBC_OK;
+
+    out = NULL;
+
+    const size_t payloadLen = packet->GetPayloadLength();
+    if (UNLIKELY(payloadLen < LLBC_INL_NS __origLenPartLen))
+        return OnDecompressFailed(packet, "compressed payload too short", removeSession);
+
+    const char *payload = reinterpret_cast<const char *>(packet->GetPayload());
+
+    uint32 origLen;
+    memcpy(&origLen, payload, sizeof(origLen));
+#if LLBC_CFG_COMM_ORDER_IS_NET_ORDER
+    LLBC_Net2Host(origLen);
+#endif
+    if (UNLIKELY(origLen == 0 || origLen > LLBC_CFG_COMM_MAX_DECOMPRESS_LEN))
+        return OnDecompressFailed(packet, "invalid original payload length", removeSession);
+
+    LLBC_MessageBlock *block = LLBC_New1(LLBC_MessageBlock, _headerLen + origLen);
+    char *buf = reinterpret_cast<char *>(block->GetData());
+    if (LLBC_LZ4::Decompress(payload + LLBC_INL_NS __origLenPartLen,
+                             payloadLen - LLBC_INL_NS __origLenPartLen,
+                             buf + _headerLen,
+                             origLen) != LLBC_OK)
+    {
+        LLBC_Delete(block);
+        return OnDecompressFailed(packet, "corrupted compressed payload", removeSession);
+    }
+
+    memcpy(buf, packet->_block->GetData(), _headerLen);
+    block->SetWritePos(_headerLen + origLen);
+
+    packet->ReplaceBlock(block);
+    packet->RemoveFlags(LLBC_CFG_COMM_COMPRESSED_FLAG);
+
+    out = packet;
+
     return LLBC_OK;
 }
 
@@ -51,6 +160,52 @@ int LLBC_CompressProtocol::AddCoder(int opcode, LLBC_ICoderFactory *coder)
     return LLBC_FAILED;
 }
 
+void LLBC_CompressProtocol::SetCompressPolicy(int policy, size_t threshold, const std::map<int, int> *opcodePolicies)
+{
+    _policy = policy;
+    _threshold = threshold;
+    _opcodePolicies = opcodePolicies && !opcodePolicies->empty() ? opcodePolicies : NULL;
+}
+
+bool LLBC_CompressProtocol::IsNeedCompress(const LLBC_Packet *packet) const
+{
+    if (!_flagsSupported || packet->GetEncoder())
+        return false;
+
+    // Opcode specific policy first.
+    int policy = _policy;
+    if (_opcodePolicies)
+    {
+        std::map<int, int>::const_iterator it = _opcodePolicies->find(packet->GetOpcode());
+        if (it != _opcodePolicies->end())
+            policy = it->second;
+    }
+
+    if (policy == LLBC_CompressPolicy::Always)
+        return true;
+    else if (policy == LLBC_CompressPolicy::Threshold)
+        return packet->GetPayloadLength() >= _threshold;
+
+    return false;
+}
+
+int LLBC_CompressProtocol::OnDecompressFailed(LLBC_Packet *packet, const char *reason, bool &removeSession)
+{
+    _stack->Report(packet->GetSessionId(),
+                   packet->GetOpcode(),
+                   this,
+                   LLBC_ProtoReportLevel::Error,
+                   LLBC_String().format("decompress packet failed, reason: %s, payloadLen: %lu",
+                                        reason, packet->GetPayloadLength()));
+
+    LLBC_Delete(packet);
+
+    removeSession = true;
+    LLBC_SetLastError(LLBC_ERROR_DECOMPRESS);
+
+    return LLBC_FAILED;
+}
+
 __LLBC_NS_END
 
 #include "llbc/common/AfterIncl.h"
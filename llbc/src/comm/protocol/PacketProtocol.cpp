@@ -18,6 +18,7 @@
 #include "llbc/comm/protocol/ProtocolStack.h"
 
 #include "llbc/comm/Session.h"
+#include "llbc/comm/RecvSlab.h"
 #include "llbc/comm/IService.h"
 
 namespace
@@ -28,32 +29,6 @@ namespace
     typedef LLBC_NS LLBC_PacketHeaderDescAccessor _HDAccessor;
 }
 
-__LLBC_INTERNAL_NS_BEGIN
-
-void inline __DelBlock(void *data)
-{
-    LLBC_Delete(reinterpret_cast<LLBC_NS LLBC_MessageBlock *>(data));
-}
-
-void inline __DelPacketList(void *&data)
-{
-    if (!data)
-        return;
-
-    LLBC_NS LLBC_MessageBlock *block = 
-        reinterpret_cast<LLBC_NS LLBC_MessageBlock *>(data);
-
-    LLBC_NS LLBC_Packet *packet;
-    while (block->Read(&packet, sizeof(LLBC_NS LLBC_Packet *)) == LLBC_OK)
-        LLBC_Delete(packet);
-
-    LLBC_Delete(block);
-
-    data = NULL;
-}
-
-__LLBC_INTERNAL_NS_END
-
 __LLBC_NS_BEGIN
 
 LLBC_PacketProtocol::LLBC_PacketProtocol()
@@ -63,7 +38,14 @@ LLBC_PacketProtocol::LLBC_PacketProtocol()
 , _payloadNeedRecv(0)
 , _payloadRecved(0)
 
+, _maxPacketLen(0)
+, _chunkSize(0)
+, _chunking(false)
+
+, _headerLen(_HDAccessor::GetHeaderDesc()->GetHeaderLen())
 , _headerIncludedLen(static_cast<int>(_HDAccessor::GetHeaderDesc()->GetLenPartIncludedLen()))
+
+, _outPackets()
 {
 }
 
@@ -94,16 +76,50 @@ int LLBC_PacketProtocol::Send(void *in, void *&out, bool &removeSession)
 
 int LLBC_PacketProtocol::Recv(void *in, void *&out, bool &removeSession)
 {
-
     out = NULL;
     LLBC_MessageBlock *block = reinterpret_cast<LLBC_MessageBlock *>(in);
+    LLBC_RecvSlab *slab = _stack->_recvSlab;
+
+    // Reuse the output packets block.
+    _outPackets.SetReadPos(0);
+    _outPackets.SetWritePos(0);
 
-    LLBC_InvokeGuard guard(&LLBC_INL_NS __DelBlock, block);
-    
     size_t readableSize;
     while ((readableSize = block->GetReadableSize()) > 0)
     {
         const char *readableBuf = reinterpret_cast<const char *>(block->GetDataStartWithReadPos());
+
+        // If no pending packet, and whole packet lie in receive slab, reference slab without copy.
+        if (slab && !_packet &&
+            _headerAssembler.GetAssembledLen() == 0 && readableSize >= _headerLen)
+        {
+            const int len = _headerAssembler.ReadLength(readableBuf);
+            if (len - _headerIncludedLen < 0)
+                return OnInvalidPacketLen(len, out, removeSession);
+
+            const size_t payloadLen = static_cast<size_t>(len - _headerIncludedLen);
+            const size_t packetLen = _headerLen + payloadLen;
+            if (_maxPacketLen != 0 && packetLen > _maxPacketLen)
+                return OnInvalidPacketLen(len, out, removeSession);
+
+            if (packetLen <= readableSize && (_chunkSize == 0 || payloadLen <= _chunkSize))
+            {
+                LLBC_Packet *packet = LLBC_New3(LLBC_Packet, slab, readableBuf, packetLen);
+                packet->SetServiceId(_stack->_svc->GetId());
+                packet->SetSessionId(_stack->_session->GetId());
+
+                _outPackets.Write(&packet, sizeof(LLBC_Packet *));
+                out = &_outPackets;
+
+#if LLBC_TARGET_PLATFORM_WIN32 && defined(_WIN64)
+                block->ShiftReadPos(static_cast<long>(packetLen));
+#else
+                block->ShiftReadPos(packetLen);
+#endif // target platform is WIN32 and defined _WIN64 macro.
+
+                continue;
+            }
+        }
         
         // Construct packet header.
         if (!_packet)
@@ -118,26 +134,19 @@ int LLBC_PacketProtocol::Recv(void *in, void *&out, bool &removeSession)
             _packet->SetServiceId(_stack->_svc->GetId());
             _packet->SetSessionId(_stack->_session->GetId());
             _payloadNeedRecv = _packet->GetLength() - _headerIncludedLen;
-            if (_payloadNeedRecv < 0)
-            {
-                _stack->Report(this,
-                               LLBC_ProtoReportLevel::Error,
-                               LLBC_String().format("invalid packet len: %d", _packet->GetLength()));
-
-                _headerAssembler.Reset();
-
-                LLBC_XDelete(_packet);
-                _payloadNeedRecv = 0;
-
-                LLBC_INL_NS __DelPacketList(out);
+            if (_payloadNeedRecv < 0 ||
+                (_maxPacketLen != 0 && _headerLen + static_cast<size_t>(_payloadNeedRecv) > _maxPacketLen))
+                return OnInvalidPacketLen(_packet->GetLength(), out, removeSession);
 
-                removeSession = true;
-                LLBC_SetLastError(LLBC_ERROR_PACK);
-                return LLBC_FAILED;
-            }
-
-            // Reset the header assembler.
+            // Reset the header assembler, and preallocate payload buffer(in chunked receive mode,
+            // only preallocate one chunk, compressed packet must be received whole).
             _headerAssembler.Reset();
+            _chunking = _chunkSize != 0 &&
+                static_cast<size_t>(_payloadNeedRecv) > _chunkSize &&
+                !_packet->HasFlags(LLBC_CFG_COMM_COMPRESSED_FLAG);
+            if (_payloadNeedRecv > 0)
+                _packet->_block->Allocate(_chunking ? _chunkSize : _payloadNeedRecv);
+
             if (headerUsed == readableSize) // If readable size equal headerUsed, just return.
                 return LLBC_OK;
 
@@ -153,6 +162,29 @@ int LLBC_PacketProtocol::Recv(void *in, void *&out, bool &removeSession)
 #endif // target platform is WIN32 and in x64 module.
         }
 
+        // Chunked receive, fill current chunk, output it when chunk full or whole payload received.
+        if (_chunking)
+        {
+            const size_t chunkNeedRecv = MIN(_chunkSize - _packet->GetPayloadLength(),
+                                             static_cast<size_t>(_payloadNeedRecv - _payloadRecved));
+            const size_t copyLen = MIN(readableSize, chunkNeedRecv);
+            _packet->Write(readableBuf, copyLen);
+            _payloadRecved += static_cast<int>(copyLen);
+#if LLBC_TARGET_PLATFORM_WIN32 && defined(_WIN64)
+            block->ShiftReadPos(static_cast<long>(copyLen));
+#else
+            block->ShiftReadPos(copyLen);
+#endif // target platform is WIN32 and defined _WIN64 macro.
+
+            if (copyLen < chunkNeedRecv)
+                return LLBC_OK;
+
+            OutputChunk();
+            out = &_outPackets;
+
+            continue;
+        }
+
         // Content packet content.
         size_t contentNeedRecv = _payloadNeedRecv - _payloadRecved;
         if (readableSize < contentNeedRecv) // if the readable data size < content need receive size, copy the data and return.
@@ -169,9 +201,8 @@ int LLBC_PacketProtocol::Recv(void *in, void *&out, bool &removeSession)
 
         // Readable data size >= content need receive size.
         _packet->Write(readableBuf, contentNeedRecv);
-        if (!out)
-            out = LLBC_New1(LLBC_MessageBlock, sizeof(LLBC_Packet *));
-        (reinterpret_cast<LLBC_MessageBlock *>(out))->Write(&_packet, sizeof(LLBC_Packet *));
+        _outPackets.Write(&_packet, sizeof(LLBC_Packet *));
+        out = &_outPackets;
 
         // Reset packet about data members.
         _packet = NULL;
@@ -195,6 +226,64 @@ int LLBC_PacketProtocol::AddCoder(int opcode, LLBC_ICoderFactory *coder)
     return LLBC_FAILED;
 }
 
+void LLBC_PacketProtocol::SetMaxPacketLen(size_t maxPacketLen)
+{
+    _maxPacketLen = maxPacketLen;
+}
+
+void LLBC_PacketProtocol::SetRecvChunkSize(size_t chunkSize)
+{
+    _chunkSize = chunkSize;
+}
+
+void LLBC_PacketProtocol::OutputChunk()
+{
+    LLBC_Packet *chunk = _packet;
+    chunk->_chunkTotalLen = static_cast<size_t>(_payloadNeedRecv);
+    chunk->_chunkOffset = static_cast<size_t>(_payloadRecved) - chunk->GetPayloadLength();
+    _outPackets.Write(&chunk, sizeof(LLBC_Packet *));
+
+    // Whole payload received, reset packet about data members.
+    if (_payloadRecved == _payloadNeedRecv)
+    {
+        _packet = NULL;
+        _payloadRecved = 0;
+        _payloadNeedRecv = 0;
+        _chunking = false;
+
+        return;
+    }
+
+    // Create next chunk packet, all chunks share same header.
+    _packet = LLBC_New(LLBC_Packet);
+    _packet->WriteHeader(chunk->_block->GetData());
+    _packet->SetServiceId(_stack->_svc->GetId());
+    _packet->SetSessionId(_stack->_session->GetId());
+    _packet->_block->Allocate(MIN(_chunkSize, static_cast<size_t>(_payloadNeedRecv - _payloadRecved)));
+}
+
+int LLBC_PacketProtocol::OnInvalidPacketLen(int len, void *&out, bool &removeSession)
+{
+    _stack->Report(this,
+                   LLBC_ProtoReportLevel::Error,
+                   LLBC_String().format("invalid packet len: %d", len));
+
+    _headerAssembler.Reset();
+
+    LLBC_XDelete(_packet);
+    _payloadNeedRecv = 0;
+    _payloadRecved = 0;
+    _chunking = false;
+
+    // The packets framed before invalid header are valid, keep them in out,
+    // protocol stack will deliver them before remove session.
+
+    removeSession = true;
+    LLBC_SetLastError(LLBC_ERROR_PACK);
+
+    return LLBC_FAILED;
+}
+
 __LLBC_NS_END
 
 #include "llbc/common/AfterIncl.h"
@@ -26,18 +26,17 @@ namespace
 
 __LLBC_INTERNAL_NS_BEGIN
 
-void __DeletePacketsBlock(void *data)
+void __DeleteUnhandledPackets(void *data)
 {
     typedef LLBC_NS LLBC_Packet _Packet;
     typedef LLBC_NS LLBC_MessageBlock _Block;
 
+    // The packets block is owned by pack layer protocol, only delete unhandled packets.
     _Block *block = reinterpret_cast<_Block *>(data);
 
     _Packet *packet;
     while (block->Read(&packet, sizeof(_Packet *)) == LLBC_OK)
         LLBC_Delete(packet);
-
-    LLBC_Delete(block);
 }
 
 __LLBC_INTERNAL_NS_END
@@ -51,6 +50,10 @@ LLBC_ProtocolStack::LLBC_ProtocolStack(This::StackType type)
 , _svc(NULL)
 , _session(NULL)
 , _suppressCoderNotFoundError(false)
+, _dispatchTable(NULL)
+
+, _recvSlab(NULL)
+, _rawPackets()
 {
     ::memset(_protos, 0, sizeof(_protos));
 }
@@ -76,6 +79,11 @@ void LLBC_ProtocolStack::SetIsSuppressedCoderNotFoundWarning(bool suppressed)
     _suppressCoderNotFoundError = suppressed;
 }
 
+void LLBC_ProtocolStack::SetDispatchTable(const LLBC_OpcodeDispatchTable *dispatchTable)
+{
+    _dispatchTable = dispatchTable;
+}
+
 int LLBC_ProtocolStack::AddProtocol(LLBC_IProtocol *proto)
 {
     const int layer = proto->GetLayer();
@@ -183,16 +191,21 @@ int LLBC_ProtocolStack::Send(LLBC_Packet *packet, LLBC_MessageBlock *&block, boo
     return SendRaw(packet, block, removeSession);
 }
 
-int LLBC_ProtocolStack::RecvRaw(LLBC_MessageBlock *block, std::vector<LLBC_Packet *> &packets, bool &removeSession)
+int LLBC_ProtocolStack::RecvRaw(LLBC_MessageBlock *block, LLBC_RecvSlab *slab, std::vector<LLBC_Packet *> &packets, bool &removeSession)
 {
     void *in, *out = NULL;
-    if (UNLIKELY(_protos[_Layer::PackLayer]->Recv(block, out, removeSession) != LLBC_OK))
-        return LLBC_FAILED;
-    else if (!out)
-        return LLBC_OK;
+
+    removeSession = false;
+    _recvSlab = slab;
+    const int ret = _protos[_Layer::PackLayer]->Recv(block, out, removeSession);
+    _recvSlab = NULL;
+
+    // When pack layer failed, the packets framed before the error still output, convert them first.
+    if (!out)
+        return ret;
 
     LLBC_MessageBlock *packetsBlock = reinterpret_cast<LLBC_MessageBlock *>(out);
-    LLBC_InvokeGuard guard(&LLBC_INL_NS __DeletePacketsBlock, packetsBlock);
+    LLBC_InvokeGuard guard(&LLBC_INL_NS __DeleteUnhandledPackets, packetsBlock);
 
     LLBC_Packet *packet;
     while (packetsBlock->Read(&packet, sizeof(LLBC_Packet *)) == LLBC_OK)
@@ -204,15 +217,13 @@ int LLBC_ProtocolStack::RecvRaw(LLBC_MessageBlock *block, std::vector<LLBC_Packe
                 continue;
 
             in = out, out = NULL;
-            if (_protos[layer]->Recv(in, out, removeSession) != LLBC_OK)
+            bool layerRemoveSession = false;
+            if (_protos[layer]->Recv(in, out, layerRemoveSession) != LLBC_OK)
             {
                 //! Current in-data already deleted in specific protocol, we don't need care it.
-                //  Just need delete decoded packets, and non-decode packets.
-             
-                // Delete all decoded packets.
-                LLBC_STLHelper::DeleteContainer(packets);
-                // Delete non-decode packets and the message-block.
-                // Yeah, this operation will done by LLBC_InvokeGuard, we don't need care it too.
+                //  The decoded packets keep in packets list, caller will deliver them.
+                //  Delete non-decode packets, this operation will done by LLBC_InvokeGuard.
+                removeSession = removeSession || layerRemoveSession;
                 return LLBC_FAILED;
             }
         }
@@ -221,7 +232,7 @@ int LLBC_ProtocolStack::RecvRaw(LLBC_MessageBlock *block, std::vector<LLBC_Packe
         packets.push_back(reinterpret_cast<LLBC_Packet *>(out));
     }
 
-    return LLBC_OK;
+    return ret;
 }
 
 int LLBC_ProtocolStack::RecvCodec(LLBC_Packet *willDecode, LLBC_Packet *&decoded, bool &removeSession)
@@ -241,28 +252,30 @@ int LLBC_ProtocolStack::RecvCodec(LLBC_Packet *willDecode, LLBC_Packet *&decoded
     return LLBC_OK;
 }
 
-int LLBC_ProtocolStack::Recv(LLBC_MessageBlock *block, std::vector<LLBC_Packet *> &packets, bool &removeSession)
+int LLBC_ProtocolStack::Recv(LLBC_MessageBlock *block, LLBC_RecvSlab *slab, std::vector<LLBC_Packet *> &packets, bool &removeSession)
 {
-    std::vector<LLBC_Packet *> rawPackets;
-    if (RecvRaw(block, rawPackets, removeSession) != LLBC_OK)
-        return LLBC_FAILED;
+    std::vector<LLBC_Packet *> &rawPackets = _rawPackets;
+    rawPackets.clear();
+    const int ret = RecvRaw(block, slab, rawPackets, removeSession);
 
+    // Even raw layers failed, the packets converted before the error still need decode.
     for (size_t i = 0;  i < rawPackets.size(); i++)
     {
         LLBC_Packet *packet;
-        if (RecvCodec(rawPackets[i], packet, removeSession) != LLBC_OK)
+        bool codecRemoveSession = false;
+        if (RecvCodec(rawPackets[i], packet, codecRemoveSession) != LLBC_OK)
         {
-            LLBC_STLHelper::DeleteContainer(packets);
             for (++i; i < rawPackets.size(); i++)
                 LLBC_Delete(rawPackets[i]);
 
+            removeSession = removeSession || codecRemoveSession;
             return LLBC_FAILED;
         }
 
         packets.push_back(packet);
     }
 
-    return LLBC_OK;
+    return ret;
 }
 
 void LLBC_ProtocolStack::Report(LLBC_IProtocol *proto, int level, const LLBC_String &msg)
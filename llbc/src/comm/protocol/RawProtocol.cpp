@@ -24,6 +24,8 @@ LLBC_RawProtocol::LLBC_RawProtocol()
 
 , _lenOffset(0)
 , _lenSize(0)
+
+, _outPackets(sizeof(LLBC_Packet *))
 {
     typedef LLBC_PacketHeaderDescAccessor _HDAccessor;
 
@@ -75,12 +77,19 @@ int LLBC_RawProtocol::Recv(void *in, void *&out, bool &removeSession)
     // Write length part.
     packet->SetHeaderPartVal(_lenPartId, static_cast<sint32>(readableSize));
 
-    // Delete this block.
-    LLBC_Delete(block);
+    // Consume this block, block is borrowed, don't delete it.
+#if LLBC_TARGET_PLATFORM_WIN32 && defined(_WIN64)
+    block->ShiftReadPos(static_cast<long>(readableSize));
+#else
+    block->ShiftReadPos(readableSize);
+#endif // target platform is WIN32 and defined _WIN64 macro.
+
+    // Reuse the output packets block.
+    _outPackets.SetReadPos(0);
+    _outPackets.SetWritePos(0);
+    _outPackets.Write(&packet, sizeof(LLBC_Packet *));
 
-    // Create output.
-    out = LLBC_New1(LLBC_MessageBlock, sizeof(LLBC_Packet *));
-    (reinterpret_cast<LLBC_MessageBlock *>(out))->Write(&packet, sizeof(LLBC_Packet *));
+    out = &_outPackets;
 
     return LLBC_OK;
 }
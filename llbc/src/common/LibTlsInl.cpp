@@ -35,6 +35,8 @@ __LLBC_LibTls::__LLBC_LibTls()
     coreTls.nativeThreadHandle = LLBC_INVALID_NATIVE_THREAD_HANDLE;
     coreTls.task = NULL;
     coreTls.timerScheduler = NULL;
+    coreTls.cachedMonoTime = -1;
+    coreTls.coro = NULL;
 
     objbaseTls.poolStack = NULL;
 
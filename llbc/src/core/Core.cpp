@@ -53,6 +53,9 @@ void __LLBC_CoreCleanup()
     tls->coreTls.timerScheduler = NULL;
     LLBC_TimerScheduler::DestroyEntryThreadScheduler();
 
+    // Purge pooled coroutine stacks.
+    LLBC_Coro::PurgeStackPool();
+
     // Destroy main bundle.
     LLBC_Bundle::DestroyMainBundle();
 
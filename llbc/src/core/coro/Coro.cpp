@@ -0,0 +1,485 @@
+/**
+ * @file    Coro.cpp
+ * @author  Longwei Lai<lailongwei@126.com>
+ * @date    2026/10/18
+ * @version 1.0
+ *
+ * @brief
+ */
+
+#include "llbc/common/Export.h"
+#include "llbc/common/BeforeIncl.h"
+
+#include "llbc/core/os/OS_Atomic.h"
+#include "llbc/core/thread/Guard.h"
+#include "llbc/core/thread/SpinLock.h"
+#include "llbc/core/coro/Coro.h"
+
+#if LLBC_TARGET_PLATFORM_LINUX && defined(__x86_64__)
+ #define __LLBC_CORO_IMPL_ASM       1
+#elif LLBC_TARGET_PLATFORM_LINUX
+ #define __LLBC_CORO_IMPL_UCONTEXT  1
+#elif LLBC_TARGET_PLATFORM_WIN32
+ #define __LLBC_CORO_IMPL_FIBER     1
+#endif
+
+#if __LLBC_CORO_IMPL_ASM
+extern "C"
+{
+
+/**
+ * Switch context, save callee-saved registers and fp control words to current stack, store
+ * current stack pointer to *fromSp, then switch to toSp and restore.
+ */
+void __llbc_coro_switch(void **fromSp, void *toSp);
+
+/**
+ * The new coroutine first switched in entry, call r13(entry function) with r12(coroutine).
+ */
+void __llbc_coro_start();
+
+}
+
+__asm__(
+    ".text\n"
+    ".globl __llbc_coro_switch\n"
+    ".hidden __llbc_coro_switch\n"
+    ".type __llbc_coro_switch, @function\n"
+    "__llbc_coro_switch:\n"
+    "    pushq %rbp\n"
+    "    pushq %rbx\n"
+    "    pushq %r12\n"
+    "    pushq %r13\n"
+    "    pushq %r14\n"
+    "    pushq %r15\n"
+    "    subq $8, %rsp\n"
+    "    stmxcsr (%rsp)\n"
+    "    fnstcw 4(%rsp)\n"
+    "    movq %rsp, (%rdi)\n"
+    "    movq %rsi, %rsp\n"
+    "    ldmxcsr (%rsp)\n"
+    "    fldcw 4(%rsp)\n"
+    "    addq $8, %rsp\n"
+    "    popq %r15\n"
+    "    popq %r14\n"
+    "    popq %r13\n"
+    "    popq %r12\n"
+    "    popq %rbx\n"
+    "    popq %rbp\n"
+    "    ret\n"
+    ".size __llbc_coro_switch, .-__llbc_coro_switch\n"
+    "\n"
+    ".globl __llbc_coro_start\n"
+    ".hidden __llbc_coro_start\n"
+    ".type __llbc_coro_start, @function\n"
+    "__llbc_coro_start:\n"
+    "    movq %r12, %rdi\n"
+    "    callq *%r13\n"
+    "    ud2\n"
+    ".size __llbc_coro_start, .-__llbc_coro_start\n"
+);
+#endif // __LLBC_CORO_IMPL_ASM
+
+__LLBC_INTERNAL_NS_BEGIN
+
+static volatile LLBC_NS sint32 __coroMaxId = 0;
+
+#if __LLBC_CORO_IMPL_UCONTEXT || __LLBC_CORO_IMPL_FIBER
+static void (*__coroEntry)(LLBC_NS LLBC_Coro *) = NULL;
+#endif // __LLBC_CORO_IMPL_UCONTEXT || __LLBC_CORO_IMPL_FIBER
+
+#if __LLBC_CORO_IMPL_UCONTEXT
+static void __CoroUContextEntry(unsigned int lo, unsigned int hi)
+{
+    const LLBC_NS uint64 ptr = (static_cast<LLBC_NS uint64>(hi) << 32) | lo;
+    (*__coroEntry)(reinterpret_cast<LLBC_NS LLBC_Coro *>(static_cast<uintptr_t>(ptr)));
+}
+#endif // __LLBC_CORO_IMPL_UCONTEXT
+
+#if __LLBC_CORO_IMPL_FIBER
+static VOID WINAPI __CoroFiberEntry(LPVOID param)
+{
+    (*__coroEntry)(reinterpret_cast<LLBC_NS LLBC_Coro *>(param));
+}
+#endif // __LLBC_CORO_IMPL_FIBER
+
+#if __LLBC_CORO_IMPL_ASM || __LLBC_CORO_IMPL_UCONTEXT
+static LLBC_NS LLBC_SpinLock __stackPoolLock;
+static std::vector<void *> __pooledStacks;
+
+static size_t __GetPageSize()
+{
+    static size_t pageSize = 0;
+    if (UNLIKELY(pageSize == 0))
+        pageSize = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+
+    return pageSize;
+}
+
+static size_t __GetDftStackSize()
+{
+    const size_t pageSize = __GetPageSize();
+    return (LLBC_CFG_CORE_CORO_DFT_STACK_SIZE + pageSize - 1) / pageSize * pageSize;
+}
+
+/**
+ * Allocate stack, stack lowest page is guard page, return the usable stack lowest address.
+ */
+static void *__AllocStack(size_t stackSize)
+{
+    if (stackSize == __GetDftStackSize())
+    {
+        LLBC_NS LLBC_Guard guard(__stackPoolLock);
+        if (!__pooledStacks.empty())
+        {
+            void *stack = __pooledStacks.back();
+            __pooledStacks.pop_back();
+
+            return stack;
+        }
+    }
+
+    const size_t pageSize = __GetPageSize();
+    void *base = ::mmap(NULL, stackSize + pageSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (base == MAP_FAILED)
+    {
+        LLBC_NS LLBC_SetLastError(LLBC_ERROR_CLIB);
+        return NULL;
+    }
+
+    if (::mprotect(base, pageSize, PROT_NONE) != 0)
+    {
+        LLBC_NS LLBC_SetLastError(LLBC_ERROR_CLIB);
+        ::munmap(base, stackSize + pageSize);
+
+        return NULL;
+    }
+
+    return reinterpret_cast<char *>(base) + pageSize;
+}
+
+static void __FreeStack(void *stack, size_t stackSize)
+{
+    if (stackSize == __GetDftStackSize())
+    {
+        LLBC_NS LLBC_Guard guard(__stackPoolLock);
+        if (__pooledStacks.size() < LLBC_CFG_CORE_CORO_MAX_POOLED_STACKS)
+        {
+            __pooledStacks.push_back(stack);
+            return;
+        }
+    }
+
+    const size_t pageSize = __GetPageSize();
+    ::munmap(reinterpret_cast<char *>(stack) - pageSize, stackSize + pageSize);
+}
+#endif // __LLBC_CORO_IMPL_ASM || __LLBC_CORO_IMPL_UCONTEXT
+
+__LLBC_INTERNAL_NS_END
+
+__LLBC_NS_BEGIN
+
+LLBC_Coro::LLBC_Coro(LLBC_IDelegate0 *task, size_t stackSize)
+: _id(LLBC_AtomicFetchAndAdd(&LLBC_INL_NS __coroMaxId, 1) + 1)
+, _state(Ready)
+, _task(task)
+
+, _stack(NULL)
+, _stackSize(stackSize)
+
+, _ctx(NULL)
+, _callerCtx(NULL)
+, _caller(NULL)
+{
+#if __LLBC_CORO_IMPL_ASM || __LLBC_CORO_IMPL_UCONTEXT
+    const size_t pageSize = LLBC_INL_NS __GetPageSize();
+    _stackSize = (MAX(_stackSize, pageSize) + pageSize - 1) / pageSize * pageSize;
+#endif // __LLBC_CORO_IMPL_ASM || __LLBC_CORO_IMPL_UCONTEXT
+}
+
+LLBC_Coro::~LLBC_Coro()
+{
+    DestroyContext();
+    LLBC_XDelete(_task);
+}
+
+int LLBC_Coro::GetId() const
+{
+    return _id;
+}
+
+LLBC_Coro::State LLBC_Coro::GetState() const
+{
+    return _state;
+}
+
+size_t LLBC_Coro::GetStackSize() const
+{
+    return _stackSize;
+}
+
+int LLBC_Coro::Resume()
+{
+    if (UNLIKELY(_state == Running))
+    {
+        LLBC_SetLastError(LLBC_ERROR_REENTRY);
+        return LLBC_FAILED;
+    }
+    else if (UNLIKELY(_state == Dead))
+    {
+        LLBC_SetLastError(LLBC_ERROR_END);
+        return LLBC_FAILED;
+    }
+
+    __LLBC_LibTls *tls = __LLBC_GetLibTls();
+    if (UNLIKELY(!tls))
+    {
+        LLBC_SetLastError(LLBC_ERROR_NOT_INIT);
+        return LLBC_FAILED;
+    }
+
+    if (_state == Ready && MakeContext() != LLBC_OK)
+        return LLBC_FAILED;
+
+    // Switch in, until coroutine suspended or finished.
+    _caller = reinterpret_cast<LLBC_Coro *>(tls->coreTls.coro);
+    tls->coreTls.coro = this;
+
+    _state = Running;
+    SwitchIn();
+
+    tls->coreTls.coro = _caller;
+    _caller = NULL;
+
+    // Coroutine finished, release stack as soon as possible.
+    if (_state == Dead)
+        DestroyContext();
+
+    return LLBC_OK;
+}
+
+int LLBC_Coro::Suspend()
+{
+    LLBC_Coro *coro = GetCurrent();
+    if (UNLIKELY(!coro))
+    {
+        LLBC_SetLastError(LLBC_ERROR_ILLEGAL);
+        return LLBC_FAILED;
+    }
+
+    coro->_state = Suspended;
+    coro->SwitchOut();
+
+    return LLBC_OK;
+}
+
+LLBC_Coro *LLBC_Coro::GetCurrent()
+{
+    __LLBC_LibTls *tls = __LLBC_GetLibTls();
+    return LIKELY(tls) ? reinterpret_cast<LLBC_Coro *>(tls->coreTls.coro) : NULL;
+}
+
+size_t LLBC_Coro::GetPooledStackCount()
+{
+#if __LLBC_CORO_IMPL_ASM || __LLBC_CORO_IMPL_UCONTEXT
+    LLBC_Guard guard(LLBC_INL_NS __stackPoolLock);
+    return LLBC_INL_NS __pooledStacks.size();
+#else // Fiber allocate stack itself, not support stack pool.
+    return 0;
+#endif // __LLBC_CORO_IMPL_ASM || __LLBC_CORO_IMPL_UCONTEXT
+}
+
+void LLBC_Coro::PurgeStackPool()
+{
+#if __LLBC_CORO_IMPL_ASM || __LLBC_CORO_IMPL_UCONTEXT
+    LLBC_Guard guard(LLBC_INL_NS __stackPoolLock);
+
+    const size_t pageSize = LLBC_INL_NS __GetPageSize();
+    const size_t stackSize = LLBC_INL_NS __GetDftStackSize();
+    std::vector<void *> &stacks = LLBC_INL_NS __pooledStacks;
+    for (size_t i = 0; i < stacks.size(); i++)
+        ::munmap(reinterpret_cast<char *>(stacks[i]) - pageSize, stackSize + pageSize);
+
+    stacks.clear();
+#endif // __LLBC_CORO_IMPL_ASM || __LLBC_CORO_IMPL_UCONTEXT
+}
+
+void LLBC_Coro::Entry(LLBC_Coro *coro)
+{
+    coro->_task->Invoke();
+
+    // Finished, switch out and never come back.
+    coro->_state = Dead;
+    coro->SwitchOut();
+}
+
+#if __LLBC_CORO_IMPL_ASM
+int LLBC_Coro::MakeContext()
+{
+    if (!(_stack = LLBC_INL_NS __AllocStack(_stackSize)))
+        return LLBC_FAILED;
+
+    // Build initial frame, __llbc_coro_switch() will pop it and return to __llbc_coro_start(),
+    // the return address slot + 8 must be 16 bytes aligned(ABI requirement before call).
+    void **sp = reinterpret_cast<void **>(reinterpret_cast<char *>(_stack) + _stackSize - 24);
+    sp[0] = reinterpret_cast<void *>(&__llbc_coro_start);
+    sp[-1] = NULL; // rbp
+    sp[-2] = NULL; // rbx
+    sp[-3] = this; // r12
+    sp[-4] = reinterpret_cast<void *>(&LLBC_Coro::Entry); // r13
+    sp[-5] = NULL; // r14
+    sp[-6] = NULL; // r15
+
+    // Inherit current thread fp control words.
+    uint32 mxcsr;
+    uint16 fpucw;
+    __asm__ __volatile__("stmxcsr %0" : "=m"(mxcsr));
+    __asm__ __volatile__("fnstcw %0" : "=m"(fpucw));
+    ::memcpy(&sp[-7], &mxcsr, sizeof(mxcsr));
+    ::memcpy(reinterpret_cast<char *>(&sp[-7]) + 4, &fpucw, sizeof(fpucw));
+
+    _ctx = &sp[-7];
+
+    return LLBC_OK;
+}
+
+void LLBC_Coro::DestroyContext()
+{
+    if (_stack)
+    {
+        LLBC_INL_NS __FreeStack(_stack, _stackSize);
+        _stack = NULL;
+    }
+
+    _ctx = NULL;
+    _callerCtx = NULL;
+}
+
+void LLBC_Coro::SwitchIn()
+{
+    __llbc_coro_switch(&_callerCtx, _ctx);
+}
+
+void LLBC_Coro::SwitchOut()
+{
+    __llbc_coro_switch(&_ctx, _callerCtx);
+}
+#elif __LLBC_CORO_IMPL_UCONTEXT
+int LLBC_Coro::MakeContext()
+{
+    if (!(_stack = LLBC_INL_NS __AllocStack(_stackSize)))
+        return LLBC_FAILED;
+
+    ucontext_t *ctx = LLBC_Malloc(ucontext_t, sizeof(ucontext_t));
+    if (::getcontext(ctx) != 0)
+    {
+        LLBC_SetLastError(LLBC_ERROR_CLIB);
+        LLBC_Free(ctx);
+
+        LLBC_INL_NS __FreeStack(_stack, _stackSize);
+        _stack = NULL;
+
+        return LLBC_FAILED;
+    }
+
+    ctx->uc_stack.ss_sp = _stack;
+    ctx->uc_stack.ss_size = _stackSize;
+    ctx->uc_link = NULL;
+
+    // makecontext() only can pass int arguments, split coroutine pointer.
+    LLBC_INL_NS __coroEntry = &LLBC_Coro::Entry;
+    const uint64 ptr = static_cast<uint64>(reinterpret_cast<uintptr_t>(this));
+    ::makecontext(ctx,
+                  reinterpret_cast<void (*)()>(&LLBC_INL_NS __CoroUContextEntry),
+                  2,
+                  static_cast<unsigned int>(ptr & 0xffffffff),
+                  static_cast<unsigned int>(ptr >> 32));
+
+    _ctx = ctx;
+    _callerCtx = LLBC_Malloc(ucontext_t, sizeof(ucontext_t));
+
+    return LLBC_OK;
+}
+
+void LLBC_Coro::DestroyContext()
+{
+    if (_stack)
+    {
+        LLBC_INL_NS __FreeStack(_stack, _stackSize);
+        _stack = NULL;
+    }
+
+    LLBC_XFree(_ctx);
+    LLBC_XFree(_callerCtx);
+}
+
+void LLBC_Coro::SwitchIn()
+{
+    ::swapcontext(reinterpret_cast<ucontext_t *>(_callerCtx), reinterpret_cast<ucontext_t *>(_ctx));
+}
+
+void LLBC_Coro::SwitchOut()
+{
+    ::swapcontext(reinterpret_cast<ucontext_t *>(_ctx), reinterpret_cast<ucontext_t *>(_callerCtx));
+}
+#elif __LLBC_CORO_IMPL_FIBER
+int LLBC_Coro::MakeContext()
+{
+    LLBC_INL_NS __coroEntry = &LLBC_Coro::Entry;
+    if (!(_ctx = ::CreateFiberEx(0, _stackSize, 0, &LLBC_INL_NS __CoroFiberEntry, this)))
+    {
+        LLBC_SetLastError(LLBC_ERROR_OSAPI);
+        return LLBC_FAILED;
+    }
+
+    return LLBC_OK;
+}
+
+void LLBC_Coro::DestroyContext()
+{
+    if (_ctx)
+    {
+        ::DeleteFiber(_ctx);
+        _ctx = NULL;
+    }
+
+    _callerCtx = NULL;
+}
+
+void LLBC_Coro::SwitchIn()
+{
+    // Resumer must be a fiber, convert thread to fiber when first resume in this thread.
+    if (!::IsThreadAFiber())
+        ::ConvertThreadToFiber(NULL);
+
+    _callerCtx = ::GetCurrentFiber();
+    ::SwitchToFiber(_ctx);
+}
+
+void LLBC_Coro::SwitchOut()
+{
+    ::SwitchToFiber(_callerCtx);
+}
+#else // Not supported platform.
+int LLBC_Coro::MakeContext()
+{
+    LLBC_SetLastError(LLBC_ERROR_NOT_IMPL);
+    return LLBC_FAILED;
+}
+
+void LLBC_Coro::DestroyContext()
+{
+}
+
+void LLBC_Coro::SwitchIn()
+{
+}
+
+void LLBC_Coro::SwitchOut()
+{
+}
+#endif
+
+__LLBC_NS_END
+
+#include "llbc/common/AfterIncl.h"
@@ -27,6 +27,8 @@ LLBC_LogRunnable::LLBC_LogRunnable()
 , _lastFlushTime(0)
 , _flushInterval(LLBC_CFG_LOG_DEFAULT_LOG_FLUSH_INTERVAL)
 {
+    // All logging threads push log data to single log thread.
+    SetMsgQueueMode(LLBC_MessageQueueMode::MPSC);
 }
 
 LLBC_LogRunnable::~LLBC_LogRunnable()
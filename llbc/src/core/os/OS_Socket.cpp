@@ -167,6 +167,27 @@ LLBC_SocketHandle LLBC_CreateTcpSocket()
 #endif // LLBC_TARGET_PLATFORM_NON_WIN32
 }
 
+LLBC_SocketHandle LLBC_CreateUdpSocket()
+{
+    LLBC_SocketHandle handle = ::socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+
+#if LLBC_TARGET_PLATFORM_NON_WIN32
+    if (handle == -1)
+    {
+        LLBC_SetLastError(LLBC_ERROR_CLIB);
+    }
+
+    return handle;
+#else // LLBC_TARGET_PLATFORM_WIN32
+    if (handle == INVALID_SOCKET)
+    {
+        LLBC_SetLastError(LLBC_ERROR_NETAPI);
+    }
+
+    return handle;
+#endif // LLBC_TARGET_PLATFORM_NON_WIN32
+}
+
 LLBC_SocketHandle LLBC_CreateTcpSocketEx()
 {
 #if LLBC_TARGET_PLATFORM_NON_WIN32
@@ -314,6 +335,53 @@ int LLBC_Send(LLBC_SocketHandle handle, const void *buf, int len, int flags)
 #endif // LLBC_TARGET_PLATFORM_NON_WIN32
 }
 
+int LLBC_SendV(LLBC_SocketHandle handle, LLBC_IoVec *vecs, int count)
+{
+    if (UNLIKELY(!vecs || count <= 0 || count > LLBC_IOV_MAX))
+    {
+        LLBC_SetLastError(LLBC_ERROR_ARG);
+        return LLBC_FAILED;
+    }
+
+#if LLBC_TARGET_PLATFORM_NON_WIN32
+    ssize_t ret = 0;
+    while ((ret = ::writev(handle, vecs, count)) < 0 && errno == EINTR);
+    if (ret == -1)
+    {
+        if (errno == EWOULDBLOCK)
+        {
+            LLBC_SetLastError(LLBC_ERROR_WBLOCK);
+            return LLBC_FAILED;
+        }
+        else if (errno == EAGAIN)
+        {
+            LLBC_SetLastError(LLBC_ERROR_AGAIN);
+            return LLBC_FAILED;
+        }
+
+        LLBC_SetLastError(LLBC_ERROR_CLIB);
+        return LLBC_FAILED;
+    }
+
+    return static_cast<int>(ret);
+#else // LLBC_TARGET_PLATFORM_WIN32
+    DWORD bytesSent = 0;
+    if (::WSASend(handle, vecs, count, &bytesSent, 0, NULL, NULL) == SOCKET_ERROR)
+    {
+        if (::WSAGetLastError() == WSAEWOULDBLOCK)
+        {
+            LLBC_SetLastError(LLBC_ERROR_WBLOCK);
+            return LLBC_FAILED;
+        }
+
+        LLBC_SetLastError(LLBC_ERROR_NETAPI);
+        return LLBC_FAILED;
+    }
+
+    return static_cast<int>(bytesSent);
+#endif // LLBC_TARGET_PLATFORM_NON_WIN32
+}
+
 int LLBC_SendEx(LLBC_SocketHandle handle,
                 LLBC_SockBuf *buffers,
                 ulong bufferCount,
@@ -400,6 +468,59 @@ int LLBC_Recv(LLBC_SocketHandle handle, void *buf, int len, int flags)
 #endif // LLBC_TARGET_PLATFORM_NON_WIN32
 }
 
+int LLBC_RecvFrom(LLBC_SocketHandle handle, void *buf, int len, int flags, LLBC_SockAddr_IN *from)
+{
+    struct sockaddr_in inAddr;
+    LLBC_SocketLen addrLen = sizeof(struct sockaddr_in);
+
+#if LLBC_TARGET_PLATFORM_NON_IPHONE
+    int ret = 0;
+#else // iPHone
+    ssize_t ret = 0;
+#endif // LLBC_TARGET_PLATFORM_NON_IPHONE
+    while ((ret = ::recvfrom(handle,
+                             reinterpret_cast<char *>(buf),
+                             len,
+                             flags,
+                             reinterpret_cast<struct sockaddr *>(&inAddr),
+                             &addrLen)) < 0 && errno == EINTR);
+#if LLBC_TARGET_PLATFORM_NON_WIN32
+    if (ret == -1)
+    {
+        if (errno == EWOULDBLOCK)
+        {
+            LLBC_SetLastError(LLBC_ERROR_WBLOCK);
+            return LLBC_FAILED;
+        }
+        else if (errno == EAGAIN)
+        {
+            LLBC_SetLastError(LLBC_ERROR_AGAIN);
+            return LLBC_FAILED;
+        }
+
+        LLBC_SetLastError(LLBC_ERROR_CLIB);
+        return LLBC_FAILED;
+    }
+#else // LLBC_TARGET_PLATFORM_WIN32
+    if (ret == SOCKET_ERROR)
+    {
+        if (::WSAGetLastError() == WSAEWOULDBLOCK)
+        {
+            LLBC_SetLastError(LLBC_ERROR_WBLOCK);
+            return LLBC_FAILED;
+        }
+
+        LLBC_SetLastError(LLBC_ERROR_NETAPI);
+        return LLBC_FAILED;
+    }
+#endif // LLBC_TARGET_PLATFORM_NON_WIN32
+
+    if (from)
+        from->FromOSDataType(&inAddr);
+
+    return static_cast<int>(ret);
+}
+
 int LLBC_RecvEx(LLBC_SocketHandle handle,
                 LLBC_SockBuf *buffers,
                 ulong bufferCount,
@@ -552,6 +673,24 @@ int LLBC_DisableAddressReusable(LLBC_SocketHandle handle)
 #endif // LLBC_TARGET_PLATFORM_NON_WIN32
 }
 
+int LLBC_EnablePortReusable(LLBC_SocketHandle handle)
+{
+#if LLBC_TARGET_PLATFORM_NON_WIN32 && defined(SO_REUSEPORT)
+    int reuse = 1;
+    if (::setsockopt(handle, SOL_SOCKET, 
+        SO_REUSEPORT, reinterpret_cast<const char *>(&reuse), sizeof(int))!= 0)
+    {
+        LLBC_SetLastError(LLBC_ERROR_CLIB);
+        return LLBC_FAILED;
+    }
+
+    return LLBC_OK;
+#else // WIN32 or SO_REUSEPORT not defined
+    LLBC_SetLastError(LLBC_ERROR_NOT_IMPL);
+    return LLBC_FAILED;
+#endif // LLBC_TARGET_PLATFORM_NON_WIN32 && defined(SO_REUSEPORT)
+}
+
 int LLBC_SetSendBufSize(LLBC_SocketHandle handle, size_t size)
 {
     if (size <= 0)
@@ -78,6 +78,76 @@ uint64 LLBC_GetTickCount()
 #endif
 }
 
+sint64 LLBC_GetMonoMilliSeconds()
+{
+#if LLBC_TARGET_PLATFORM_LINUX || LLBC_TARGET_PLATFORM_ANDROID
+    // LINUX & ANDROID Impl.
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<sint64>(ts.tv_sec) * 1000 + ts.tv_nsec / (1000 * 1000);
+#else
+    return LLBC_GetMonoMicroSeconds() / 1000;
+#endif
+}
+
+sint64 LLBC_GetMonoMicroSeconds()
+{
+#if LLBC_TARGET_PLATFORM_LINUX || LLBC_TARGET_PLATFORM_ANDROID
+    // LINUX & ANDROID Impl.
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<sint64>(ts.tv_sec) * 1000000 + ts.tv_nsec / 1000;
+#elif LLBC_TARGET_PLATFORM_MAC
+    // Mac Impl.
+    static mach_timebase_info_data_t timeBaseInfo;
+    if (timeBaseInfo.denom == 0)
+        (void)mach_timebase_info(&timeBaseInfo);
+
+    const uint64_t nanoSec = ::mach_absolute_time() * timeBaseInfo.numer / timeBaseInfo.denom;
+    return static_cast<sint64>(nanoSec / 1000);
+#elif LLBC_TARGET_PLATFORM_IPHONE
+    // Iphone Impl(not monotonic).
+    return LLBC_GetMicroSeconds();
+#elif LLBC_TARGET_PLATFORM_WIN32
+    // WIN32 Impl.
+    static LARGE_INTEGER freq;
+    if (freq.QuadPart == 0)
+        ::QueryPerformanceFrequency(&freq);
+
+    LARGE_INTEGER counter;
+    ::QueryPerformanceCounter(&counter);
+    return static_cast<sint64>(counter.QuadPart / freq.QuadPart * 1000000 +
+                               counter.QuadPart % freq.QuadPart * 1000000 / freq.QuadPart);
+#endif
+}
+
+sint64 LLBC_GetCachedMonoMilliSeconds()
+{
+    const __LLBC_LibTls *tls = __LLBC_GetLibTls();
+    if (LIKELY(tls) && tls->coreTls.cachedMonoTime >= 0)
+        return tls->coreTls.cachedMonoTime;
+
+    return LLBC_GetMonoMilliSeconds();
+}
+
+sint64 LLBC_CacheMonoMilliSeconds()
+{
+    const sint64 now = LLBC_GetMonoMilliSeconds();
+
+    __LLBC_LibTls *tls = __LLBC_GetLibTls();
+    if (LIKELY(tls))
+        tls->coreTls.cachedMonoTime = now;
+
+    return now;
+}
+
+void LLBC_UncacheMonoMilliSeconds()
+{
+    __LLBC_LibTls *tls = __LLBC_GetLibTls();
+    if (LIKELY(tls))
+        tls->coreTls.cachedMonoTime = -1;
+}
+
 #if LLBC_TARGET_PLATFORM_NON_WIN32
 int LLBC_GetTimeOfDay(struct timeval *tv, struct timezone *tz)
 #else
@@ -0,0 +1,254 @@
+/**
+ * @file    LockFreeMessageQueue.cpp
+ * @author  Longwei Lai<lailongwei@126.com>
+ * @date    2026/10/18
+ * @version 1.0
+ *
+ * @brief
+ */
+
+#include "llbc/common/Export.h"
+#include "llbc/common/BeforeIncl.h"
+
+#include "llbc/core/os/OS_Time.h"
+#include "llbc/core/os/OS_Atomic.h"
+#include "llbc/core/thread/MessageBlock.h"
+#include "llbc/core/thread/LockFreeMessageQueue.h"
+
+__LLBC_NS_BEGIN
+
+LLBC_LockFreeMessageQueue::LLBC_LockFreeMessageQueue(int mode)
+: _mode(mode == LLBC_MessageQueueMode::SPSC ? 
+        LLBC_MessageQueueMode::SPSC : LLBC_MessageQueueMode::MPSC)
+
+, _mpscQueue()
+, _prodChunk(NULL)
+
+, _mpscPopHead(NULL)
+, _consChunk(NULL)
+, _consPos(0)
+
+, _spareChunk(NULL)
+, _waiters(0)
+, _signal(0)
+{
+    if (_mode == LLBC_MessageQueueMode::SPSC)
+        _prodChunk = _consChunk = AllocChunk();
+}
+
+LLBC_LockFreeMessageQueue::~LLBC_LockFreeMessageQueue()
+{
+    Cleanup();
+
+    if (_mode == LLBC_MessageQueueMode::SPSC)
+    {
+        LLBC_Free(_consChunk);
+        LLBC_Free(_spareChunk);
+    }
+}
+
+void LLBC_LockFreeMessageQueue::PushBack(LLBC_MessageBlock *block)
+{
+    if (_mode == LLBC_MessageQueueMode::MPSC)
+    {
+        // The CAS operation already is a full memory barrier.
+        _mpscQueue.Push(block);
+    }
+    else
+    {
+        SPSCPush(block);
+        // Make sure block published before check consumer waiting or not.
+        LLBC_AtomicMemoryBarrier();
+    }
+
+    Notify();
+}
+
+bool LLBC_LockFreeMessageQueue::TryPopFront(LLBC_MessageBlock *&block)
+{
+    if (_mode == LLBC_MessageQueueMode::SPSC)
+        return SPSCTryPop(block);
+
+    if (!_mpscPopHead &&
+        !(_mpscPopHead = _mpscQueue.PopAll()))
+        return false;
+
+    block = _mpscPopHead;
+    _mpscPopHead = block->GetNext();
+    block->SetNext(NULL);
+
+    return true;
+}
+
+bool LLBC_LockFreeMessageQueue::TimedPopFront(LLBC_MessageBlock *&block, int interval)
+{
+    if (TryPopFront(block))
+        return true;
+    else if (interval == 0)
+        return false;
+
+    const sint64 begTime = interval != LLBC_INFINITE ? LLBC_GetMilliSeconds() : 0;
+    while (true)
+    {
+        int waitTime = interval;
+        if (interval != LLBC_INFINITE)
+        {
+            const sint64 elapsed = LLBC_GetMilliSeconds() - begTime;
+            if (elapsed < 0 || elapsed >= interval)
+                return TryPopFront(block);
+
+            waitTime = static_cast<int>(interval - elapsed);
+        }
+
+        Wait(waitTime);
+        if (TryPopFront(block))
+            return true;
+    }
+}
+
+void LLBC_LockFreeMessageQueue::Cleanup()
+{
+    LLBC_MessageBlock *block;
+    while (TryPopFront(block))
+        LLBC_Delete(block);
+}
+
+void LLBC_LockFreeMessageQueue::Wait(int interval)
+{
+#if LLBC_TARGET_PLATFORM_LINUX
+    const sint32 signal = LLBC_AtomicLoadAcquire(&_signal);
+#endif // LLBC_TARGET_PLATFORM_LINUX
+
+    // Register as waiter, and then recheck queue, the producers publish block before check
+    // waiter, so either consumer see the block, or producer see the waiter.
+    LLBC_AtomicSet(&_waiters, 1);
+    LLBC_AtomicMemoryBarrier();
+    if (IsEmpty())
+    {
+#if LLBC_TARGET_PLATFORM_LINUX
+        struct timespec ts;
+        struct timespec *tsPtr = NULL;
+        if (interval != LLBC_INFINITE)
+        {
+            ts.tv_sec = interval / 1000;
+            ts.tv_nsec = (interval % 1000) * 1000000;
+            tsPtr = &ts;
+        }
+
+        // If any producer signaled after signal value fetched, futex wait return immediately.
+        ::syscall(SYS_futex, &_signal, FUTEX_WAIT_PRIVATE, signal, tsPtr, NULL, 0);
+#else // Non-Linux
+        if (interval == LLBC_INFINITE)
+            _sem.Wait();
+        else
+            _sem.TimedWait(interval);
+#endif // LLBC_TARGET_PLATFORM_LINUX
+    }
+
+    // Unregister waiter, if waiter already claimed by producer, do nothing.
+    LLBC_AtomicCompareAndExchange(&_waiters, 0, 1);
+}
+
+void LLBC_LockFreeMessageQueue::Notify()
+{
+    // Only the producer which claimed waiter signal consumer, so one wait at most one wakeup.
+    if (LIKELY(_waiters == 0) ||
+        LLBC_AtomicCompareAndExchange(&_waiters, 0, 1) != 1)
+        return;
+
+#if LLBC_TARGET_PLATFORM_LINUX
+    LLBC_AtomicFetchAndAdd(&_signal, 1);
+    ::syscall(SYS_futex, &_signal, FUTEX_WAKE_PRIVATE, 1, NULL, NULL, 0);
+#else // Non-Linux
+    _sem.Post();
+#endif // LLBC_TARGET_PLATFORM_LINUX
+}
+
+void LLBC_LockFreeMessageQueue::SPSCPush(LLBC_MessageBlock *block)
+{
+    _Chunk *chunk = _prodChunk;
+
+    // Chunk full, link new chunk, consumer will switch to it after consumed all blocks.
+    sint32 writePos = chunk->writePos;
+    if (UNLIKELY(writePos == LLBC_CFG_THREAD_SPSC_MSG_QUEUE_CHUNK_SIZE))
+    {
+        _Chunk *newChunk = AllocChunk();
+        LLBC_AtomicStoreReleasePtr(reinterpret_cast<void * volatile *>(&chunk->next), newChunk);
+
+        _prodChunk = chunk = newChunk;
+        writePos = 0;
+    }
+
+    chunk->blocks[writePos] = block;
+    LLBC_AtomicStoreRelease(&chunk->writePos, writePos + 1);
+}
+
+bool LLBC_LockFreeMessageQueue::SPSCTryPop(LLBC_MessageBlock *&block)
+{
+    _Chunk *chunk = _consChunk;
+    while (true)
+    {
+        if (_consPos < LLBC_AtomicLoadAcquire(&chunk->writePos))
+        {
+            block = chunk->blocks[_consPos++];
+            return true;
+        }
+        else if (_consPos < LLBC_CFG_THREAD_SPSC_MSG_QUEUE_CHUNK_SIZE)
+        {
+            return false;
+        }
+
+        // Chunk consumed, switch to next chunk(if exist).
+        _Chunk *next = reinterpret_cast<_Chunk *>(
+            LLBC_AtomicLoadAcquirePtr(reinterpret_cast<void * volatile *>(&chunk->next)));
+        if (!next)
+            return false;
+
+        _consChunk = next;
+        _consPos = 0;
+
+        RecycleChunk(chunk);
+        chunk = next;
+    }
+}
+
+bool LLBC_LockFreeMessageQueue::SPSCIsEmpty() const
+{
+    _Chunk *chunk = _consChunk;
+    if (_consPos < LLBC_AtomicLoadAcquire(&chunk->writePos))
+        return false;
+    else if (_consPos < LLBC_CFG_THREAD_SPSC_MSG_QUEUE_CHUNK_SIZE)
+        return true;
+
+    // Next chunk always non-empty when it linked.
+    return LLBC_AtomicLoadAcquirePtr(reinterpret_cast<void * volatile *>(&chunk->next)) == NULL;
+}
+
+LLBC_LockFreeMessageQueue::_Chunk *LLBC_LockFreeMessageQueue::AllocChunk()
+{
+    // Reuse the chunk which recycled by consumer first.
+    _Chunk *chunk = NULL;
+    if (_spareChunk)
+        chunk = reinterpret_cast<_Chunk *>(
+            LLBC_AtomicSetPtr(reinterpret_cast<void * volatile *>(&_spareChunk), NULL));
+    if (!chunk)
+        chunk = LLBC_Malloc(_Chunk, sizeof(_Chunk));
+
+    chunk->writePos = 0;
+    chunk->next = NULL;
+
+    return chunk;
+}
+
+void LLBC_LockFreeMessageQueue::RecycleChunk(_Chunk *chunk)
+{
+    // Keep one spare chunk for producer, free the replaced one.
+    _Chunk *oldChunk = reinterpret_cast<_Chunk *>(
+        LLBC_AtomicSetPtr(reinterpret_cast<void * volatile *>(&_spareChunk), chunk));
+    if (oldChunk)
+        LLBC_Free(oldChunk);
+}
+
+__LLBC_NS_END
+
+#include "llbc/common/AfterIncl.h"
@@ -0,0 +1,87 @@
+/**
+ * @file    MPSCMessageQueue.cpp
+ * @author  Longwei Lai<lailongwei@126.com>
+ * @date    2026/10/18
+ * @version 1.0
+ *
+ * @brief
+ */
+
+#include "llbc/common/Export.h"
+#include "llbc/common/BeforeIncl.h"
+
+#include "llbc/core/os/OS_Atomic.h"
+#include "llbc/core/thread/MessageBlock.h"
+#include "llbc/core/thread/MPSCMessageQueue.h"
+
+__LLBC_NS_BEGIN
+
+LLBC_MPSCMessageQueue::LLBC_MPSCMessageQueue()
+: _head(NULL)
+{
+}
+
+LLBC_MPSCMessageQueue::~LLBC_MPSCMessageQueue()
+{
+    Cleanup();
+}
+
+bool LLBC_MPSCMessageQueue::Push(LLBC_MessageBlock *block)
+{
+    void *oldHead = _head;
+    while (true)
+    {
+        block->SetNext(reinterpret_cast<LLBC_MessageBlock *>(oldHead));
+
+        void *curHead = LLBC_AtomicCompareAndExchangePtr(&_head, block, oldHead);
+        if (curHead == oldHead)
+            break;
+
+        oldHead = curHead;
+    }
+
+    return oldHead == NULL;
+}
+
+LLBC_MessageBlock *LLBC_MPSCMessageQueue::PopAll()
+{
+    if (!_head)
+        return NULL;
+
+    // Detach the list, the list is LIFO ordered, reverse it.
+    LLBC_MessageBlock *block =
+        reinterpret_cast<LLBC_MessageBlock *>(LLBC_AtomicSetPtr(&_head, NULL));
+
+    LLBC_MessageBlock *first = NULL;
+    while (block)
+    {
+        LLBC_MessageBlock *next = block->GetNext();
+        block->SetNext(first);
+
+        first = block;
+        block = next;
+    }
+
+    return first;
+}
+
+bool LLBC_MPSCMessageQueue::IsEmpty() const
+{
+    return _head == NULL;
+}
+
+void LLBC_MPSCMessageQueue::Cleanup()
+{
+    LLBC_MessageBlock *block = PopAll();
+    while (block)
+    {
+        LLBC_MessageBlock *next = block->GetNext();
+        LLBC_Delete(block);
+
+        block = next;
+    }
+}
+
+__LLBC_NS_END
+
+#include "llbc/common/AfterIncl.h"
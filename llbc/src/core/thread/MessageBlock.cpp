@@ -273,9 +273,23 @@ void LLBC_MessageBlock::SetNext(LLBC_MessageBlock *next)
 
 void LLBC_MessageBlock::Resize(size_t newSize)
 {
-    ASSERT(!_attach && newSize > _size);
+    ASSERT(newSize > _size);
+
+    // If attached to external buffer, copy data to self own buffer.
+    if (_attach)
+    {
+        char *buf = LLBC_Malloc(char, newSize);
+        if (_buf)
+            memcpy(buf, _buf, _writePos);
+
+        _buf = buf;
+        _attach = false;
+    }
+    else
+    {
+        _buf = LLBC_Realloc(char, _buf, newSize);
+    }
 
-    _buf = LLBC_Realloc(char, _buf, newSize);
     _size = newSize;
 }
 
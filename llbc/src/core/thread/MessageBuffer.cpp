@@ -17,6 +17,7 @@ __LLBC_NS_BEGIN
 
 LLBC_MessageBuffer::LLBC_MessageBuffer()
 : _head(NULL)
+, _tail(NULL)
 {
 }
 
@@ -40,7 +41,7 @@ size_t LLBC_MessageBuffer::Read(void *buf, size_t len)
     }
 
     size_t needReadLen = len;
-    while (needReadLen > 0)
+    while (needReadLen > 0 && _head)
     {
         size_t availableSize = _head->GetWritePos() - _head->GetReadPos();
         if (availableSize >= needReadLen)
@@ -67,6 +68,9 @@ size_t LLBC_MessageBuffer::Read(void *buf, size_t len)
         delete block;
     }
 
+    if (!_head)
+        _tail = NULL;
+
     if (needReadLen > 0)
         LLBC_SetLastError(LLBC_ERROR_NO_SUCH);
     else
@@ -120,12 +124,20 @@ LLBC_MessageBlock *LLBC_MessageBuffer::MergeBuffersAndDetach()
         curBlock = next;
     }
 
-    _head = NULL;
+    _head = _tail = NULL;
     mergedBlock->SetNext(NULL);
 
     return mergedBlock;
 }
 
+LLBC_MessageBlock *LLBC_MessageBuffer::DetachBuffers()
+{
+    LLBC_MessageBlock *head = _head;
+    _head = _tail = NULL;
+
+    return head;
+}
+
 int LLBC_MessageBuffer::Append(LLBC_MessageBlock *block)
 {
     if (UNLIKELY(!block))
@@ -143,16 +155,11 @@ int LLBC_MessageBuffer::Append(LLBC_MessageBlock *block)
     block->SetNext(NULL);
 
     if (!_head)
-    {
         _head = block;
-        return LLBC_OK;
-    }
-
-    LLBC_MessageBlock *curBlock = _head;
-    while (curBlock->GetNext())
-        curBlock = curBlock->GetNext();
+    else
+        _tail->SetNext(block);
 
-    curBlock->SetNext(block);
+    _tail = block;
 
     return LLBC_OK;
 }
@@ -166,7 +173,7 @@ size_t LLBC_MessageBuffer::Remove(size_t length)
     }
 
     size_t needRemoveLength = length;
-    while (needRemoveLength > 0)
+    while (needRemoveLength > 0 && _head)
     {
         size_t availableSize = _head->GetWritePos() - _head->GetReadPos();
         if (availableSize >= needRemoveLength)
@@ -191,6 +198,9 @@ size_t LLBC_MessageBuffer::Remove(size_t length)
         delete block;
     }
 
+    if (!_head)
+        _tail = NULL;
+
     if (needRemoveLength > 0)
         LLBC_SetLastError(LLBC_ERROR_NO_SUCH);
     else
@@ -208,6 +218,8 @@ void LLBC_MessageBuffer::Cleanup()
         _head = _head->GetNext();
         delete block;
     }
+
+    _tail = NULL;
 }
 
 __LLBC_NS_END
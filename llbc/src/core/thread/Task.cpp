@@ -52,12 +52,17 @@ LLBC_BaseTask::LLBC_BaseTask(LLBC_ThreadManager *threadMgr)
     , _curThreadNum(0)
     , _startCompleted(false)
     , _threadManager(threadMgr ? threadMgr : LLBC_ThreadManagerSingleton)
+
+    , _msgQueueMode(LLBC_MessageQueueMode::Locked)
+    , _lfMsgQueue(NULL)
 {
 }
 
 LLBC_BaseTask::~LLBC_BaseTask()
 {
     Wait();
+
+    LLBC_XDelete(_lfMsgQueue);
 }
 
 int LLBC_BaseTask::Activate(int threadNum,
@@ -71,6 +76,14 @@ int LLBC_BaseTask::Activate(int threadNum,
 
     _lock.Lock();
 
+    if (_msgQueueMode != LLBC_MessageQueueMode::Locked && threadNum != 1)
+    {
+        _lock.Unlock();
+        LLBC_SetLastError(LLBC_ERROR_NOT_ALLOW);
+
+        return LLBC_FAILED;
+    }
+
     if (_threadManager->CreateThreads(threadNum,
                                       &LLBC_INTERNAL_NS __LLBC_BaseTaskEntry,
                                       task,
@@ -128,32 +141,73 @@ int LLBC_BaseTask::Kill(int signo)
     return _threadManager->KillTask(this, signo);
 }
 
+int LLBC_BaseTask::GetMsgQueueMode() const
+{
+    return _msgQueueMode;
+}
+
+int LLBC_BaseTask::SetMsgQueueMode(int mode)
+{
+    if (!LLBC_MessageQueueMode::IsValid(mode))
+    {
+        LLBC_SetLastError(LLBC_ERROR_ARG);
+        return LLBC_FAILED;
+    }
+
+    LLBC_Guard guard(_lock);
+    if (_threadNum != 0)
+    {
+        LLBC_SetLastError(LLBC_ERROR_NOT_ALLOW);
+        return LLBC_FAILED;
+    }
+    else if (mode == _msgQueueMode)
+    {
+        return LLBC_OK;
+    }
+
+    LLBC_XDelete(_lfMsgQueue);
+    if (mode != LLBC_MessageQueueMode::Locked)
+        _lfMsgQueue = LLBC_New1(LLBC_LockFreeMessageQueue, mode);
+
+    _msgQueueMode = mode;
+
+    return LLBC_OK;
+}
+
 int LLBC_BaseTask::Push(LLBC_MessageBlock *block)
 {
-    _msgQueue.PushBack(block);
+    if (_lfMsgQueue)
+        _lfMsgQueue->PushBack(block);
+    else
+        _msgQueue.PushBack(block);
+
     return LLBC_OK;
 }
 
 int LLBC_BaseTask::Pop(LLBC_MessageBlock *&block)
 {
-    _msgQueue.PopFront(block);
+    if (_lfMsgQueue)
+        _lfMsgQueue->PopFront(block);
+    else
+        _msgQueue.PopFront(block);
+
     return LLBC_OK;
 }
 
 int LLBC_BaseTask::TryPop(LLBC_MessageBlock *&block)
 {
-    if (_msgQueue.TryPopFront(block))
-        return LLBC_OK;
+    const bool popped = _lfMsgQueue ?
+        _lfMsgQueue->TryPopFront(block) : _msgQueue.TryPopFront(block);
 
-    return LLBC_FAILED;
+    return popped ? LLBC_OK : LLBC_FAILED;
 }
 
 int LLBC_BaseTask::TimedPop(LLBC_MessageBlock *&block, int interval)
 {
-    if (_msgQueue.TimedPopFront(block, interval))
-        return LLBC_OK;
+    const bool popped = _lfMsgQueue ?
+        _lfMsgQueue->TimedPopFront(block, interval) : _msgQueue.TimedPopFront(block, interval);
 
-    return LLBC_FAILED;
+    return popped ? LLBC_OK : LLBC_FAILED;
 }
 
 void LLBC_BaseTask::OnTaskThreadStart()
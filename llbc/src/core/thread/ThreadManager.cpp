@@ -404,7 +404,9 @@ int LLBC_ThreadManager::WaitTask(LLBC_BaseTask *task)
 
     for (size_t i = 0; i < willWaitThreads.size(); i++)
     {
-        if (Wait(willWaitThreads[i]) != LLBC_OK)
+        // The thread maybe terminated after collected, continue to wait other threads.
+        if (Wait(willWaitThreads[i]) != LLBC_OK &&
+            LLBC_GetLastError() != LLBC_ERROR_NOT_FOUND)
             return LLBC_FAILED;
     }
 
@@ -11,6 +11,7 @@
 #include "llbc/common/BeforeIncl.h"
 
 #include "llbc/core/timer/TimerData.h"
+#include "llbc/core/timer/TimerDataPool.h"
 #include "llbc/core/timer/Timer.h"
 #include "llbc/core/timer/TimerScheduler.h"
 
@@ -34,8 +35,7 @@ LLBC_Timer::~LLBC_Timer()
     if (_timerData)
     {
         Cancel();
-        if (--_timerData->refCount == 0)
-            LLBC_Delete(_timerData);
+        LLBC_TimerDataPool::Release(_timerData);
 
         _timerData = NULL;
     }
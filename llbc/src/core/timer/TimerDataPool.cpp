@@ -0,0 +1,109 @@
+/**
+ * @file    TimerDataPool.cpp
+ * @author  Longwei Lai<lailongwei@126.com>
+ * @date    2026/10/18
+ * @version 1.0
+ *
+ * @brief
+ */
+
+#include "llbc/common/Export.h"
+#include "llbc/common/BeforeIncl.h"
+
+#include "llbc/core/timer/TimerData.h"
+#include "llbc/core/timer/TimerDataPool.h"
+
+__LLBC_NS_BEGIN
+
+LLBC_TimerDataPool::LLBC_TimerDataPool()
+: _destroyed(false)
+, _refCount(1)
+
+, _cached(NULL)
+, _cachedCount(0)
+{
+}
+
+LLBC_TimerDataPool::~LLBC_TimerDataPool()
+{
+}
+
+LLBC_TimerDataPool *LLBC_TimerDataPool::Create()
+{
+    return LLBC_New(LLBC_TimerDataPool);
+}
+
+void LLBC_TimerDataPool::Destroy()
+{
+    _destroyed = true;
+    while (_cached)
+    {
+        LLBC_TimerData *next = reinterpret_cast<LLBC_TimerData *>(_cached->link.next);
+        LLBC_Delete(_cached);
+
+        _cached = next;
+    }
+
+    _cachedCount = 0;
+
+    ReleaseRef();
+}
+
+LLBC_TimerData *LLBC_TimerDataPool::Acquire()
+{
+    LLBC_TimerData *data = _cached;
+    if (data)
+    {
+        _cached = reinterpret_cast<LLBC_TimerData *>(data->link.next);
+        --_cachedCount;
+    }
+    else
+    {
+        data = LLBC_New(LLBC_TimerData);
+    }
+
+    ::memset(data, 0, sizeof(LLBC_TimerData));
+    data->pool = this;
+
+    ++_refCount;
+
+    return data;
+}
+
+void LLBC_TimerDataPool::Release(LLBC_TimerData *data)
+{
+    if (--data->refCount == 0)
+        data->pool->Recycle(data);
+}
+
+size_t LLBC_TimerDataPool::GetCachedCount() const
+{
+    return _cachedCount;
+}
+
+void LLBC_TimerDataPool::Recycle(LLBC_TimerData *data)
+{
+    if (_destroyed ||
+        _cachedCount >= LLBC_CFG_CORE_TIMER_MAX_POOLED_TIMER_DATA)
+    {
+        LLBC_Delete(data);
+    }
+    else
+    {
+        data->link.next = reinterpret_cast<LLBC_TimerLink *>(_cached);
+        _cached = data;
+        ++_cachedCount;
+    }
+
+    ReleaseRef();
+}
+
+void LLBC_TimerDataPool::ReleaseRef()
+{
+    if (--_refCount == 0)
+        LLBC_Delete(this);
+}
+
+__LLBC_NS_END
+
+#include "llbc/common/AfterIncl.h"
@@ -14,6 +14,8 @@
 
 #include "llbc/core/timer/Timer.h"
 #include "llbc/core/timer/TimerData.h"
+#include "llbc/core/timer/TimerDataPool.h"
+#include "llbc/core/timer/TimingWheel.h"
 
 #include "llbc/core/timer/TimerScheduler.h"
 
@@ -25,10 +27,15 @@ __LLBC_INTERNAL_NS_END
 
 __LLBC_NS_BEGIN
 
-LLBC_TimerScheduler::LLBC_TimerScheduler()
-: _maxTimerId(0)
+LLBC_TimerScheduler::LLBC_TimerScheduler(Type type)
+: _type(type)
+, _maxTimerId(0)
 , _enabled(true)
 , _destroyed(false)
+
+, _heap()
+, _wheel(type == TimingWheel ? LLBC_New(LLBC_TimingWheel) : NULL)
+, _pool(LLBC_TimerDataPool::Create())
 {
 }
 
@@ -36,21 +43,23 @@ LLBC_TimerScheduler::~LLBC_TimerScheduler()
 {
     _destroyed = true;
 
-    const size_t size = _heap.GetSize();
-    const _Heap::Container &elems = _heap.GetData();
-    for (size_t i = 1; i <= size; i++)
+    std::vector<LLBC_TimerData *> datas;
+    GetAll(datas);
+    for (size_t i = 0; i < datas.size(); i++)
     {
-        LLBC_TimerData *data = const_cast<LLBC_TimerData *>(elems[i]);
+        LLBC_TimerData *data = datas[i];
         if (data->validate)
         {
             data->validate = false;
             data->cancelling = true;
             data->timer->OnCancel();
-
-            if (--data->refCount == 0)
-                LLBC_Delete(data);
         }
+
+        LLBC_TimerDataPool::Release(data);
     }
+
+    LLBC_XDelete(_wheel);
+    _pool->Destroy();
 }
 
 void LLBC_TimerScheduler::CreateEntryThreadScheduler()
@@ -79,74 +88,77 @@ LLBC_TimerScheduler::_This *LLBC_TimerScheduler::GetCurrentThreadScheduler()
     return reinterpret_cast<_This *>(tls->coreTls.timerScheduler);
 }
 
+LLBC_TimerScheduler::Type LLBC_TimerScheduler::GetType() const
+{
+    return _type;
+}
+
 void LLBC_TimerScheduler::Update()
 {
     if (UNLIKELY(!_enabled))
         return;
 
     LLBC_TimerData *data;
-    uint64 now = LLBC_GetMilliSeconds();
-    while (_heap.FindTop(data) == LLBC_OK)
+    uint64 now = LLBC_GetCachedMonoMilliSeconds();
+    while (PopExpired(now, data))
     {
-        if (now < data->handle)
-            break;
-
-        _heap.DeleteTop();
         if (!data->validate)
         {
-            if (--data->refCount == 0)
-                LLBC_Delete(data);
-
+            LLBC_TimerDataPool::Release(data);
             continue;
         }
 
-        data->timeouting = true;
+        if (Timeout(data, now))
+        {
+            data->timeouting = false;
 
-        bool reSchedule = true;
-        LLBC_Timer *timer = data->timer;
-#if LLBC_CFG_CORE_TIMER_STRICT_SCHEDULE
-        uint64 pseudoNow = now;
-        while (pseudoNow >= data->handle)
-#endif // LLBC_CFG_CORE_TIMER_STRICT_SCHEDULE
+            uint64 delay = (data->period != 0) ? (now - data->handle) % data->period : 0;
+            data->handle = now + data->period - delay;
+
+            Insert(data);
+        }
+        else
         {
-            ++data->repeatTimes;
-            timer->OnTimeout();
+            LLBC_TimerDataPool::Release(data);
+        }
+    }
+}
 
-            // Cancel() or Schedule() called.
-            if (!data->validate)
-            {
-                reSchedule = false;
+bool LLBC_TimerScheduler::Timeout(LLBC_TimerData *data, uint64 now)
+{
+    data->timeouting = true;
+
+    bool reSchedule = true;
+    LLBC_Timer *timer = data->timer;
 #if LLBC_CFG_CORE_TIMER_STRICT_SCHEDULE
-                break;
+    uint64 pseudoNow = now;
+    while (pseudoNow >= data->handle)
 #endif // LLBC_CFG_CORE_TIMER_STRICT_SCHEDULE
-            }
+    {
+        ++data->repeatTimes;
+        timer->OnTimeout();
 
+        // Cancel() or Schedule() called.
+        if (!data->validate)
+        {
+            reSchedule = false;
 #if LLBC_CFG_CORE_TIMER_STRICT_SCHEDULE
-            if (data->period == 0)
-                break;
-
-            if (UNLIKELY(pseudoNow < data->period))
-                break;
-
-            pseudoNow -= data->period;
+            break;
 #endif // LLBC_CFG_CORE_TIMER_STRICT_SCHEDULE
         }
 
-        if (reSchedule)
-        {
-            data->timeouting = false;
+#if LLBC_CFG_CORE_TIMER_STRICT_SCHEDULE
+        if (data->period == 0)
+            break;
 
-            uint64 delay = (data->period != 0) ? (now - data->handle) % data->period : 0;
-            data->handle = now + data->period - delay;
+        if (UNLIKELY(pseudoNow < data->period))
+            break;
 
-            _heap.Insert(data);
-        }
-        else
-        {
-            if (--data->refCount == 0)
-                LLBC_Delete(data);
-        }
+        pseudoNow -= data->period;
+#endif // LLBC_CFG_CORE_TIMER_STRICT_SCHEDULE
     }
+
+    return reSchedule;
 }
 
 bool LLBC_TimerScheduler::IsEnabled() const
@@ -161,7 +173,22 @@ void LLBC_TimerScheduler::SetEnabled(bool enabled)
 
 size_t LLBC_TimerScheduler::GetTimerCount() const
 {
-    return _heap.GetSize();
+    return _wheel ? _wheel->GetSize() : _heap.GetSize();
+}
+
+sint64 LLBC_TimerScheduler::GetNextTimeoutTime() const
+{
+    if (UNLIKELY(!_enabled))
+        return -1;
+
+    if (_wheel)
+        return _wheel->GetNextExpireTime();
+
+    LLBC_TimerData *data;
+    if (_heap.FindTop(data) != LLBC_OK)
+        return -1;
+
+    return static_cast<sint64>(data->handle);
 }
 
 bool LLBC_TimerScheduler::IsDstroyed() const
@@ -174,9 +201,8 @@ int LLBC_TimerScheduler::Schedule(LLBC_Timer *timer, uint64 dueTime, uint64 peri
     if (UNLIKELY(_destroyed))
         return LLBC_ERROR_INVALID;
 
-    LLBC_TimerData *data = new LLBC_TimerData;
-    ::memset(data, 0, sizeof(LLBC_TimerData));
-    data->handle = LLBC_GetMilliSeconds() + dueTime;
+    LLBC_TimerData *data = _pool->Acquire();
+    data->handle = LLBC_GetCachedMonoMilliSeconds() + dueTime;
     data->timerId = ++ _maxTimerId;
     data->dueTime = dueTime;
     data->period = period;
@@ -188,13 +214,10 @@ int LLBC_TimerScheduler::Schedule(LLBC_Timer *timer, uint64 dueTime, uint64 peri
     data->refCount = 2;
 
     if (timer->_timerData)
-    {
-        if (--timer->_timerData->refCount == 0)
-            LLBC_Delete(timer->_timerData);
-    }
+        LLBC_TimerDataPool::Release(timer->_timerData);
 
     timer->_timerData = data;
-    _heap.Insert(data);
+    Insert(data);
 
     return LLBC_OK;
 }
@@ -216,14 +239,19 @@ int LLBC_TimerScheduler::Cancel(LLBC_Timer *timer)
     if (data->timeouting)
         return LLBC_OK;
 
-    if (static_cast<sint64>(data->handle) - 
-            LLBC_GetMilliSeconds() >= LLBC_CFG_CORE_TIMER_LONG_TIMEOUT_TIME)
+    // Timing wheel remove timer immediately, binary heap only remove long timeout timer.
+    if (_wheel)
+    {
+        _wheel->Remove(data);
+        LLBC_TimerDataPool::Release(data);
+    }
+    else if (static_cast<sint64>(data->handle) - 
+            LLBC_GetCachedMonoMilliSeconds() >= LLBC_CFG_CORE_TIMER_LONG_TIMEOUT_TIME)
     {
         int delElemRet = _heap.DeleteElem(data);
         ASSERT(delElemRet == LLBC_OK &&
             "Timer manager internal error, Could not found timer data when Cancel long timeout timer!");
-        if (--data->refCount == 0)
-            LLBC_Delete(data);
+        LLBC_TimerDataPool::Release(data);
     }
 
     return LLBC_OK;
@@ -234,11 +262,11 @@ void LLBC_TimerScheduler::CancelAll()
     if (UNLIKELY(_destroyed))
         return;
 
-    const size_t size = _heap.GetSize();
-    _Heap::Container copyElems(_heap.GetData());
-    for (size_t i = 1; i <= size; i++)
+    std::vector<LLBC_TimerData *> datas;
+    GetAll(datas);
+    for (size_t i = 0; i < datas.size(); i++)
     {
-        LLBC_TimerData *data = copyElems[i];
+        LLBC_TimerData *data = datas[i];
         if (UNLIKELY(!data->validate))
             return;
 
@@ -246,6 +274,41 @@ void LLBC_TimerScheduler::CancelAll()
     }
 }
 
+void LLBC_TimerScheduler::Insert(LLBC_TimerData *data)
+{
+    if (_wheel)
+        _wheel->Insert(data);
+    else
+        _heap.Insert(data);
+}
+
+bool LLBC_TimerScheduler::PopExpired(uint64 now, LLBC_TimerData *&data)
+{
+    if (_wheel)
+        return (data = _wheel->PopExpired(now)) != NULL;
+
+    if (_heap.FindTop(data) != LLBC_OK ||
+        now < data->handle)
+        return false;
+
+    _heap.DeleteTop();
+
+    return true;
+}
+
+void LLBC_TimerScheduler::GetAll(std::vector<LLBC_TimerData *> &datas) const
+{
+    if (_wheel)
+    {
+        _wheel->GetAll(datas);
+        return;
+    }
+
+    const size_t size = _heap.GetSize();
+    const _Heap::Container &elems = _heap.GetData();
+    datas.insert(datas.end(), elems.begin() + 1, elems.begin() + 1 + size);
+}
+
 __LLBC_NS_END
 
 #include "llbc/common/AfterIncl.h"
@@ -0,0 +1,229 @@
+/**
+ * @file    TimingWheel.cpp
+ * @author  Longwei Lai<lailongwei@126.com>
+ * @date    2026/10/18
+ * @version 1.0
+ *
+ * @brief
+ */
+
+#include "llbc/common/Export.h"
+#include "llbc/common/BeforeIncl.h"
+
+#include "llbc/core/os/OS_Time.h"
+
+#include "llbc/core/timer/TimingWheel.h"
+
+__LLBC_NS_BEGIN
+
+LLBC_TimingWheel::LLBC_TimingWheel()
+: _time(LLBC_GetMonoMilliSeconds())
+, _size(0)
+{
+    for (int i = 0; i < Level0Size; i++)
+        InitList(_level0[i]);
+    for (int level = 0; level < LevelsCount - 1; level++)
+    {
+        for (int i = 0; i < LevelNSize; i++)
+            InitList(_levelN[level][i]);
+    }
+
+    InitList(_expiring);
+}
+
+LLBC_TimingWheel::~LLBC_TimingWheel()
+{
+}
+
+void LLBC_TimingWheel::Insert(LLBC_TimerData *data)
+{
+    AddToBucket(data);
+    ++_size;
+}
+
+void LLBC_TimingWheel::Remove(LLBC_TimerData *data)
+{
+    Unlink(&data->link);
+    --_size;
+}
+
+LLBC_TimerData *LLBC_TimingWheel::PopExpired(uint64 now)
+{
+    while (true)
+    {
+        if (!IsListEmpty(_expiring))
+        {
+            LLBC_TimerLink *link = _expiring.next;
+            Unlink(link);
+
+            // The clamped long timer not reach, re-insert it.
+            LLBC_TimerData *data = reinterpret_cast<LLBC_TimerData *>(link);
+            if (data->handle >= _time)
+            {
+                AddToBucket(data);
+                continue;
+            }
+
+            --_size;
+            return data;
+        }
+
+        // Empty wheel, fast forward wheel time.
+        if (_size == 0)
+        {
+            if (_time <= now)
+                _time = now + 1;
+
+            return NULL;
+        }
+
+        if (_time > now)
+            return NULL;
+
+        const uint32 idx = static_cast<uint32>(_time & Level0Mask);
+        if (idx == 0 &&
+            Cascade(1) == 0 &&
+            Cascade(2) == 0 &&
+            Cascade(3) == 0)
+            Cascade(4);
+
+        // Detach expired bucket before handle, the new timers maybe insert to same bucket.
+        SpliceList(_level0[idx], _expiring);
+        ++_time;
+    }
+}
+
+size_t LLBC_TimingWheel::GetSize() const
+{
+    return _size;
+}
+
+sint64 LLBC_TimingWheel::GetNextExpireTime() const
+{
+    if (_size == 0)
+        return -1;
+
+    if (!IsListEmpty(_expiring))
+        return static_cast<sint64>(_time - 1);
+
+    // Cascade pending, the higher level timers maybe expire in this round.
+    if ((_time & Level0Mask) == 0)
+        return static_cast<sint64>(_time);
+
+    const uint64 nextCascadeTime = (_time | Level0Mask) + 1;
+    for (uint64 time = _time; time < nextCascadeTime; time++)
+    {
+        if (!IsListEmpty(_level0[time & Level0Mask]))
+            return static_cast<sint64>(time);
+    }
+
+    return static_cast<sint64>(nextCascadeTime);
+}
+
+void LLBC_TimingWheel::GetAll(std::vector<LLBC_TimerData *> &datas) const
+{
+    datas.reserve(datas.size() + _size);
+
+    const LLBC_TimerLink *lists[] = {_level0, _levelN[0], _levelN[1], _levelN[2], _levelN[3], &_expiring};
+    const int listsCount[] = {Level0Size, LevelNSize, LevelNSize, LevelNSize, LevelNSize, 1};
+    for (size_t i = 0; i < sizeof(lists) / sizeof(lists[0]); i++)
+    {
+        for (int j = 0; j < listsCount[i]; j++)
+        {
+            const LLBC_TimerLink &head = lists[i][j];
+            for (LLBC_TimerLink *link = head.next; link != &head; link = link->next)
+                datas.push_back(reinterpret_cast<LLBC_TimerData *>(link));
+        }
+    }
+}
+
+void LLBC_TimingWheel::AddToBucket(LLBC_TimerData *data)
+{
+    uint64 expires = MAX(data->handle, _time);
+    uint64 idx = expires - _time;
+    if (idx < static_cast<uint64>(Level0Size))
+    {
+        LinkTail(_level0[expires & Level0Mask], &data->link);
+        return;
+    }
+
+    int level = 1;
+    while (level < LevelsCount - 1 &&
+           idx >= (static_cast<uint64>(1) << (Level0Bits + level * LevelNBits)))
+        level += 1;
+
+    // Exceed the max wheel time, store in the farthest bucket, re-insert when reached.
+    const uint64 maxIdx = (static_cast<uint64>(1) << (Level0Bits + (LevelsCount - 1) * LevelNBits)) - 1;
+    if (idx > maxIdx)
+        expires = _time + maxIdx;
+
+    const int shift = Level0Bits + (level - 1) * LevelNBits;
+    LinkTail(_levelN[level - 1][(expires >> shift) & LevelNMask], &data->link);
+}
+
+uint32 LLBC_TimingWheel::Cascade(int level)
+{
+    const int shift = Level0Bits + (level - 1) * LevelNBits;
+    const uint32 idx = static_cast<uint32>((_time >> shift) & LevelNMask);
+
+    LLBC_TimerLink cascading;
+    InitList(cascading);
+    SpliceList(_levelN[level - 1][idx], cascading);
+
+    while (!IsListEmpty(cascading))
+    {
+        LLBC_TimerLink *link = cascading.next;
+        Unlink(link);
+
+        AddToBucket(reinterpret_cast<LLBC_TimerData *>(link));
+    }
+
+    return idx;
+}
+
+void LLBC_TimingWheel::InitList(LLBC_TimerLink &head)
+{
+    head.prev = &head;
+    head.next = &head;
+}
+
+bool LLBC_TimingWheel::IsListEmpty(const LLBC_TimerLink &head)
+{
+    return head.next == &head;
+}
+
+void LLBC_TimingWheel::LinkTail(LLBC_TimerLink &head, LLBC_TimerLink *link)
+{
+    link->prev = head.prev;
+    link->next = &head;
+    head.prev->next = link;
+    head.prev = link;
+}
+
+void LLBC_TimingWheel::Unlink(LLBC_TimerLink *link)
+{
+    link->prev->next = link->next;
+    link->next->prev = link->prev;
+    link->prev = NULL;
+    link->next = NULL;
+}
+
+void LLBC_TimingWheel::SpliceList(LLBC_TimerLink &from, LLBC_TimerLink &to)
+{
+    if (IsListEmpty(from))
+        return;
+
+    LLBC_TimerLink *first = from.next;
+    LLBC_TimerLink *last = from.prev;
+
+    first->prev = to.prev;
+    to.prev->next = first;
+    last->next = &to;
+    to.prev = last;
+
+    InitList(from);
+}
+
+__LLBC_NS_END
+
+#include "llbc/common/AfterIncl.h"
@@ -0,0 +1,279 @@
+/**
+ * @file    Util_LZ4.cpp
+ * @author  Longwei Lai<lailongwei@126.com>
+ * @date    2026/10/18
+ * @version 1.0
+ *
+ * @brief
+ */
+
+#include "llbc/common/Export.h"
+#include "llbc/common/BeforeIncl.h"
+
+#include "llbc/core/utils/Util_LZ4.h"
+
+__LLBC_INTERNAL_NS_BEGIN
+
+// Min match length.
+static const size_t __minMatch = 4;
+// The last literals length, last 5 bytes always literals.
+static const size_t __lastLiterals = 5;
+// The last match must start at least 12 bytes before block end.
+static const size_t __mfLimit = 12;
+// Max match offset.
+static const size_t __maxOffset = 65535;
+
+// Hash table about configs.
+static const int __hashLog = 12;
+static const size_t __hashSize = 1 << __hashLog;
+
+// Token about configs.
+static const size_t __runMask = 15;
+static const size_t __mlMask = 15;
+
+inline LLBC_NS uint32 __Read32(const LLBC_NS uint8 *p)
+{
+    LLBC_NS uint32 val;
+    ::memcpy(&val, p, sizeof(val));
+
+    return val;
+}
+
+inline LLBC_NS uint32 __Hash(LLBC_NS uint32 seq)
+{
+    return (seq * 2654435761U) >> (32 - __hashLog);
+}
+
+inline size_t __LenExtBytes(size_t len)
+{
+    return len >= 15 ? (len - 15) / 255 + 1 : 0;
+}
+
+inline LLBC_NS uint8 *__WriteLenExt(LLBC_NS uint8 *op, size_t len)
+{
+    for (len -= 15; len >= 255; len -= 255)
+        *op++ = 255;
+    *op++ = static_cast<LLBC_NS uint8>(len);
+
+    return op;
+}
+
+inline bool __ReadLenExt(const LLBC_NS uint8 *&ip, const LLBC_NS uint8 *iend, size_t &len)
+{
+    LLBC_NS uint8 b;
+    do
+    {
+        if (UNLIKELY(ip >= iend))
+            return false;
+
+        b = *ip++;
+        len += b;
+    } while (b == 255);
+
+    return true;
+}
+
+__LLBC_INTERNAL_NS_END
+
+__LLBC_NS_BEGIN
+
+size_t LLBC_LZ4::GetCompressBound(size_t srcLen)
+{
+    return srcLen + srcLen / 255 + 16;
+}
+
+int LLBC_LZ4::Compress(const void *src, size_t srcLen, void *dst, size_t dstCap, size_t &compressedLen)
+{
+    compressedLen = 0;
+    if (UNLIKELY(!src || !dst))
+    {
+        LLBC_SetLastError(LLBC_ERROR_ARG);
+        return LLBC_FAILED;
+    }
+
+    const uint8 *base = reinterpret_cast<const uint8 *>(src);
+    const uint8 *ip = base;
+    const uint8 *anchor = base;
+    const uint8 *iend = base + srcLen;
+
+    uint8 *op = reinterpret_cast<uint8 *>(dst);
+    uint8 *oend = op + dstCap;
+
+    if (srcLen >= LLBC_INL_NS __mfLimit + 1)
+    {
+        const uint8 *mfLimit = iend - LLBC_INL_NS __mfLimit;
+        const uint8 *matchLimit = iend - LLBC_INL_NS __lastLiterals;
+
+        uint32 hashTable[LLBC_INL_NS __hashSize];
+        ::memset(hashTable, 0, sizeof(hashTable));
+
+        ip++;
+        while (ip < mfLimit)
+        {
+            // Find match, if not found in long time, accelerate search step.
+            const uint8 *ref;
+            size_t searchTimes = 1 << 6;
+            for (; ; )
+            {
+                const uint32 h = LLBC_INL_NS __Hash(LLBC_INL_NS __Read32(ip));
+                ref = base + hashTable[h];
+                hashTable[h] = static_cast<uint32>(ip - base);
+
+                if (static_cast<size_t>(ip - ref) <= LLBC_INL_NS __maxOffset &&
+                    LLBC_INL_NS __Read32(ref) == LLBC_INL_NS __Read32(ip))
+                    break;
+
+                ip += searchTimes++ >> 6;
+                if (ip >= mfLimit)
+                    break;
+            }
+
+            if (ip >= mfLimit)
+                break;
+
+            // Extend match backward.
+            while (ip > anchor && ref > base && ip[-1] == ref[-1])
+                ip--, ref--;
+
+            // Extend match forward.
+            const uint8 *matchBeg = ip;
+            ip += LLBC_INL_NS __minMatch;
+            ref += LLBC_INL_NS __minMatch;
+            while (ip < matchLimit && *ip == *ref)
+                ip++, ref++;
+
+            // Encode sequence: token + literals length ext + literals + offset + match length ext.
+            const size_t litLen = static_cast<size_t>(matchBeg - anchor);
+            const size_t matchLen = static_cast<size_t>(ip - matchBeg) - LLBC_INL_NS __minMatch;
+            const size_t seqLen = 1 + LLBC_INL_NS __LenExtBytes(litLen) + litLen + 2 + LLBC_INL_NS __LenExtBytes(matchLen);
+            if (UNLIKELY(static_cast<size_t>(oend - op) < seqLen))
+            {
+                LLBC_SetLastError(LLBC_ERROR_COMPRESS);
+                return LLBC_FAILED;
+            }
+
+            uint8 *token = op++;
+            *token = static_cast<uint8>((MIN(litLen, LLBC_INL_NS __runMask) << 4) |
+                                        MIN(matchLen, LLBC_INL_NS __mlMask));
+            if (litLen >= LLBC_INL_NS __runMask)
+                op = LLBC_INL_NS __WriteLenExt(op, litLen);
+
+            ::memcpy(op, anchor, litLen);
+            op += litLen;
+
+            const size_t offset = static_cast<size_t>(matchBeg - (ref - (ip - matchBeg)));
+            *op++ = static_cast<uint8>(offset & 0xff);
+            *op++ = static_cast<uint8>(offset >> 8);
+
+            if (matchLen >= LLBC_INL_NS __mlMask)
+                op = LLBC_INL_NS __WriteLenExt(op, matchLen);
+
+            anchor = ip;
+
+            // Fill hash table at match end, improve the compress ratio.
+            if (ip < mfLimit)
+                hashTable[LLBC_INL_NS __Hash(LLBC_INL_NS __Read32(ip - 2))] = static_cast<uint32>(ip - 2 - base);
+        }
+    }
+
+    // Encode last literals.
+    const size_t lastLitLen = static_cast<size_t>(iend - anchor);
+    if (UNLIKELY(static_cast<size_t>(oend - op) < 1 + LLBC_INL_NS __LenExtBytes(lastLitLen) + lastLitLen))
+    {
+        LLBC_SetLastError(LLBC_ERROR_COMPRESS);
+        return LLBC_FAILED;
+    }
+
+    *op++ = static_cast<uint8>(MIN(lastLitLen, LLBC_INL_NS __runMask) << 4);
+    if (lastLitLen >= LLBC_INL_NS __runMask)
+        op = LLBC_INL_NS __WriteLenExt(op, lastLitLen);
+
+    ::memcpy(op, anchor, lastLitLen);
+    op += lastLitLen;
+
+    compressedLen = static_cast<size_t>(op - reinterpret_cast<uint8 *>(dst));
+
+    return LLBC_OK;
+}
+
+int LLBC_LZ4::Decompress(const void *src, size_t srcLen, void *dst, size_t dstLen)
+{
+    if (UNLIKELY(!src || !dst))
+    {
+        LLBC_SetLastError(LLBC_ERROR_ARG);
+        return LLBC_FAILED;
+    }
+
+    const uint8 *ip = reinterpret_cast<const uint8 *>(src);
+    const uint8 *iend = ip + srcLen;
+
+    uint8 *const obeg = reinterpret_cast<uint8 *>(dst);
+    uint8 *op = obeg;
+    uint8 *const oend = obeg + dstLen;
+
+    while (ip < iend)
+    {
+        const uint8 token = *ip++;
+
+        // Copy literals.
+        size_t litLen = token >> 4;
+        if (litLen == LLBC_INL_NS __runMask &&
+            !LLBC_INL_NS __ReadLenExt(ip, iend, litLen))
+            break;
+
+        if (UNLIKELY(litLen > static_cast<size_t>(iend - ip) ||
+                     litLen > static_cast<size_t>(oend - op)))
+            break;
+
+        ::memcpy(op, ip, litLen);
+        ip += litLen;
+        op += litLen;
+
+        // The last sequence only contain literals.
+        if (ip == iend)
+        {
+            if (op == oend)
+                return LLBC_OK;
+
+            break;
+        }
+
+        // Copy match.
+        if (UNLIKELY(iend - ip < 2))
+            break;
+
+        const size_t offset = ip[0] | (ip[1] << 8);
+        ip += 2;
+        if (UNLIKELY(offset == 0 || offset > static_cast<size_t>(op - obeg)))
+            break;
+
+        size_t matchLen = token & LLBC_INL_NS __mlMask;
+        if (matchLen == LLBC_INL_NS __mlMask &&
+            !LLBC_INL_NS __ReadLenExt(ip, iend, matchLen))
+            break;
+
+        matchLen += LLBC_INL_NS __minMatch;
+        if (UNLIKELY(matchLen > static_cast<size_t>(oend - op)))
+            break;
+
+        const uint8 *ref = op - offset;
+        if (offset >= matchLen)
+        {
+            ::memcpy(op, ref, matchLen);
+            op += matchLen;
+        }
+        else
+        {
+            // Overlapped copy, must copy byte by byte.
+            for (size_t i = 0; i < matchLen; i++)
+                *op++ = *ref++;
+        }
+    }
+
+    LLBC_SetLastError(LLBC_ERROR_DECOMPRESS);
+    return LLBC_FAILED;
+}
+
+__LLBC_NS_END
+
+#include "llbc/common/AfterIncl.h"
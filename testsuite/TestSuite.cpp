@@ -50,11 +50,14 @@ int TestSuite_Main(int argc, char *argv[])
     // test = new TestCase_Core_Thread_Tls;
     // test = new TestCase_Core_Thread_ThreadMgr;
     // test = new TestCase_Core_Thread_Task;
+    // test = new TestCase_Core_Thread_MsgQueue;
     // test = new TestCase_Core_Random;
     // test = new TestCase_Core_Log;
     // test = new TestCase_Core_Entity;
     // test = new TestCase_Core_Transcoder;
     // test = new TestCase_Core_Library;
+    // test = new TestCase_Core_Timer_Scheduler;
+    // test = new TestCase_Core_Coro_Coro;
 
     /* ObjBase module testcases. */
 #if LLBC_CFG_OBJBASE_ENABLED
@@ -81,6 +84,27 @@ int TestSuite_Main(int argc, char *argv[])
     // test = new TestCase_Comm_ExternalDriveSvc;
     // test = new TestCase_Comm_LazyTask;
     // test = new TestCase_Comm_CustomHeaderSvc;
+    // test = new TestCase_Comm_SendContention;
+    // test = new TestCase_Comm_SessionTable;
+    // test = new TestCase_Comm_Compress;
+    // test = new TestCase_Comm_MulticastBench;
+    // test = new TestCase_Comm_SendV;
+    // test = new TestCase_Comm_CoalescedSend;
+    // test = new TestCase_Comm_PingPong;
+    // test = new TestCase_Comm_ReusePortListen;
+    // test = new TestCase_Comm_RecvBudget;
+    // test = new TestCase_Comm_PacketHeaderLayout;
+    // test = new TestCase_Comm_OpcodeDispatch;
+    // test = new TestCase_Comm_EventAlloc;
+    // test = new TestCase_Comm_PollerBench;
+    // test = new TestCase_Comm_Backpressure;
+    // test = new TestCase_Comm_ChunkedRecv;
+    // test = new TestCase_Comm_ReliableUdp;
+    // test = new TestCase_Comm_TrafficStat;
+    // test = new TestCase_Comm_Forward;
+    // test = new TestCase_Comm_EventDrive;
+    // test = new TestCase_Comm_DispatchWorkers;
+    // test = new TestCase_Comm_Coro;
 
     int ret = LLBC_FAILED;
     if (test)
@@ -42,11 +42,14 @@
 #include "core/thread/TestCase_Core_Thread_Tls.h"
 #include "core/thread/TestCase_Core_Thread_ThreadMgr.h"
 #include "core/thread/TestCase_Core_Thread_Task.h"
+#include "core/thread/TestCase_Core_Thread_MsgQueue.h"
 #include "core/random/TestCase_Core_Random.h"
 #include "core/log/TestCase_Core_Log.h"
 #include "core/entity/TestCase_Core_Entity.h"
 #include "core/transcoder/TestCase_Core_Transcoder.h"
 #include "core/library/TestCase_Core_Library.h"
+#include "core/timer/TestCase_Core_Timer_Scheduler.h"
+#include "core/coro/TestCase_Core_Coro_Coro.h"
 
 #include "objbase/TestCase_ObjBase_Object.h"
 #include "objbase/TestCase_ObjBase_Array.h"
@@ -67,6 +70,27 @@
 #include "comm/TestCase_Comm_ExternalDriveSvc.h"
 #include "comm/TestCase_Comm_LazyTask.h"
 #include "comm/TestCase_Comm_CustomHeaderSvc.h"
+#include "comm/TestCase_Comm_SendContention.h"
+#include "comm/TestCase_Comm_SessionTable.h"
+#include "comm/TestCase_Comm_Compress.h"
+#include "comm/TestCase_Comm_MulticastBench.h"
+#include "comm/TestCase_Comm_SendV.h"
+#include "comm/TestCase_Comm_CoalescedSend.h"
+#include "comm/TestCase_Comm_PingPong.h"
+#include "comm/TestCase_Comm_ReusePortListen.h"
+#include "comm/TestCase_Comm_RecvBudget.h"
+#include "comm/TestCase_Comm_PacketHeaderLayout.h"
+#include "comm/TestCase_Comm_OpcodeDispatch.h"
+#include "comm/TestCase_Comm_EventAlloc.h"
+#include "comm/TestCase_Comm_PollerBench.h"
+#include "comm/TestCase_Comm_Backpressure.h"
+#include "comm/TestCase_Comm_ChunkedRecv.h"
+#include "comm/TestCase_Comm_ReliableUdp.h"
+#include "comm/TestCase_Comm_TrafficStat.h"
+#include "comm/TestCase_Comm_Forward.h"
+#include "comm/TestCase_Comm_EventDrive.h"
+#include "comm/TestCase_Comm_DispatchWorkers.h"
+#include "comm/TestCase_Comm_Coro.h"
 
 extern int TestSuite_Main(int argc, char *argv[]);
 
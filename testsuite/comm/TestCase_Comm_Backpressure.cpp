@@ -0,0 +1,356 @@
+/**
+ * @file    TestCase_Comm_Backpressure.cpp
+ * @author  Longwei Lai<lailongwei@126.com>
+ * @date    2026/10/18
+ * @version 1.0
+ *
+ * @brief
+ */
+
+#include "comm/TestCase_Comm_Backpressure.h"
+
+namespace
+{
+
+const int FLOOD_OPCODE = 1;
+const int DROP_OPCODE = 2;
+const int COALESCE_OPCODE = 3;
+
+const int PAYLOAD_SIZE = 1024;
+const int FLOOD_PACKETS_PER_FRAME = 64;
+const int BACKPRESSURE_PACKETS_PER_FRAME = 100;
+const int BACKPRESSURE_FRAMES = 10;
+
+class SvrFacade : public LLBC_IFacade
+{
+public:
+    enum Phase
+    {
+        Wait,
+        Flood,
+        Backpressured,
+        Done
+    };
+
+public:
+    SvrFacade()
+    : _phase(Wait)
+    , _sessionId(0)
+    , _destroyed(false)
+
+    , _backpressuredFrames(0)
+    , _enterTimes(0)
+    , _leaveTimes(0)
+    , _droppedPackets(0)
+    , _coalescedPackets(0)
+    {
+        ::memset(_payload, 'b', sizeof(_payload));
+    }
+
+public:
+    virtual void OnSessionCreate(const LLBC_SessionInfo &sessionInfo)
+    {
+        if (sessionInfo.IsListenSession())
+            return;
+
+        _sessionId = sessionInfo.GetSessionId();
+        _phase = Flood;
+    }
+
+    virtual void OnSessionDestroy(const LLBC_SessionDestroyInfo &destroyInfo)
+    {
+        if (destroyInfo.GetSessionId() != _sessionId)
+            return;
+
+        _destroyed = true;
+        _phase = Done;
+    }
+
+    virtual void OnSessionBackpressure(const LLBC_SessionBackpressureInfo &info)
+    {
+        LLBC_PrintLine("    session backpressure: %s", info.ToString().c_str());
+        if (info.IsBackpressured())
+        {
+            _enterTimes += 1;
+            if (_phase == Flood)
+                _phase = Backpressured;
+        }
+        else
+        {
+            _leaveTimes += 1;
+            _droppedPackets += info.GetDroppedPackets();
+            _coalescedPackets += info.GetCoalescedPackets();
+        }
+    }
+
+    virtual void OnUpdate()
+    {
+        if (_phase == Flood)
+        {
+            // Flood session until session enter backpressure state.
+            for (int i = 0; i < FLOOD_PACKETS_PER_FRAME; i++)
+                GetService()->Send(_sessionId, FLOOD_OPCODE, _payload, sizeof(_payload), 0);
+        }
+        else if (_phase == Backpressured)
+        {
+            // Send droppable/coalescable packets in backpressure state.
+            for (int i = 0; i < BACKPRESSURE_PACKETS_PER_FRAME; i++)
+            {
+                GetService()->Send(_sessionId, DROP_OPCODE, _payload, sizeof(_payload), 0);
+                GetService()->Send(_sessionId, COALESCE_OPCODE, _payload, sizeof(_payload), 0);
+            }
+
+            if (++_backpressuredFrames == BACKPRESSURE_FRAMES)
+                _phase = Done;
+        }
+    }
+
+public:
+    int GetPhase() const
+    {
+        return _phase;
+    }
+
+    int GetSessionId() const
+    {
+        return _sessionId;
+    }
+
+    bool IsDestroyed() const
+    {
+        return _destroyed;
+    }
+
+    int GetEnterTimes() const
+    {
+        return _enterTimes;
+    }
+
+    int GetLeaveTimes() const
+    {
+        return _leaveTimes;
+    }
+
+    size_t GetDroppedPackets() const
+    {
+        return _droppedPackets;
+    }
+
+    size_t GetCoalescedPackets() const
+    {
+        return _coalescedPackets;
+    }
+
+private:
+    volatile int _phase;
+    volatile int _sessionId;
+    volatile bool _destroyed;
+
+    int _backpressuredFrames;
+    volatile int _enterTimes;
+    volatile int _leaveTimes;
+    volatile size_t _droppedPackets;
+    volatile size_t _coalescedPackets;
+
+    char _payload[PAYLOAD_SIZE];
+};
+
+/**
+ * Create server service and connect a raw socket client(not receive data until test want).
+ */
+LLBC_IService *StartServer(const LLBC_String &ip,
+                           int port,
+                           size_t lowWaterMark,
+                           size_t highWaterMark,
+                           int policy,
+                           SvrFacade *&facade,
+                           LLBC_Socket *&client)
+{
+    LLBC_IService *svr = LLBC_IService::Create(LLBC_IService::Normal, "BackpressureSvr");
+    facade = LLBC_New(SvrFacade);
+    svr->RegisterFacade(facade);
+    svr->SuppressCoderNotFoundWarning();
+    svr->SetFPS(LLBC_CFG_COMM_MAX_SERVICE_FPS);
+    svr->SetSendWaterMarks(lowWaterMark, highWaterMark);
+    svr->SetBackpressurePolicy(policy);
+    svr->SetOpcodeBackpressurePolicy(DROP_OPCODE, LLBC_BackpressurePolicy::Drop);
+    svr->SetOpcodeBackpressurePolicy(COALESCE_OPCODE, LLBC_BackpressurePolicy::Coalesce);
+    if (svr->Start(1) != LLBC_OK ||
+        svr->Listen(ip.c_str(), port) == 0)
+    {
+        LLBC_FilePrintLine(stderr, "Start server service failed, err: %s", LLBC_FormatLastError());
+        LLBC_Delete(svr);
+
+        return NULL;
+    }
+
+    client = LLBC_New(LLBC_Socket);
+    client->SetRecvBufSize(4096);
+    if (client->Connect(LLBC_SockAddr_IN(ip.c_str(), port)) != LLBC_OK ||
+        client->SetNonBlocking() != LLBC_OK)
+    {
+        LLBC_FilePrintLine(stderr, "Connect to server failed, err: %s", LLBC_FormatLastError());
+        LLBC_Delete(client);
+        LLBC_Delete(svr);
+
+        return NULL;
+    }
+
+    return svr;
+}
+
+}
+
+TestCase_Comm_Backpressure::TestCase_Comm_Backpressure()
+: _runIp("127.0.0.1")
+, _runPort(7788)
+
+, _lowWaterMark(64 * 1024)
+, _highWaterMark(256 * 1024)
+{
+}
+
+TestCase_Comm_Backpressure::~TestCase_Comm_Backpressure()
+{
+}
+
+int TestCase_Comm_Backpressure::Run(int argc, char *argv[])
+{
+    LLBC_PrintLine("Service session send queue backpressure test:");
+    LLBC_PrintLine("  usage: ./a [ip] [port] [lowWaterMark] [highWaterMark]");
+
+    FetchArgs(argc, argv);
+
+    LLBC_PrintLine("low water mark: %lu, high water mark: %lu", _lowWaterMark, _highWaterMark);
+
+    const int policiesRet = TestOpcodePolicies(_runPort);
+    const int disconnectRet = TestDisconnectPolicy(_runPort + 1);
+
+    return policiesRet == LLBC_OK && disconnectRet == LLBC_OK ? LLBC_OK : LLBC_FAILED;
+}
+
+int TestCase_Comm_Backpressure::TestOpcodePolicies(int port)
+{
+    LLBC_PrintLine("[opcode policies] Flood:None, Drop:Drop, Coalesce:Coalesce");
+
+    SvrFacade *facade;
+    LLBC_Socket *client;
+    LLBC_IService *svr = StartServer(_runIp,
+                                     port,
+                                     _lowWaterMark,
+                                     _highWaterMark,
+                                     LLBC_BackpressurePolicy::None,
+                                     facade,
+                                     client);
+    if (!svr)
+        return LLBC_FAILED;
+
+    // Wait server flood and send droppable/coalescable packets in backpressure state.
+    sint64 begTime = LLBC_GetMilliSeconds();
+    while (facade->GetPhase() != SvrFacade::Done &&
+        LLBC_GetMilliSeconds() - begTime < 10000)
+        LLBC_Sleep(10);
+
+    size_t queueSize = 0;
+    svr->GetSendQueueSize(facade->GetSessionId(), queueSize);
+    LLBC_PrintLine("    backpressured queue size: %lu", queueSize);
+
+    // Client start receive, drain session send queue.
+    char buf[16384];
+    size_t recvedBytes = 0;
+    begTime = LLBC_GetMilliSeconds();
+    while (facade->GetLeaveTimes() == 0 &&
+        LLBC_GetMilliSeconds() - begTime < 10000)
+    {
+        const int len = client->Recv(buf, sizeof(buf));
+        if (len > 0)
+            recvedBytes += len;
+        else
+            LLBC_Sleep(1);
+    }
+
+    // Receive the requeued coalesced packet.
+    begTime = LLBC_GetMilliSeconds();
+    while (LLBC_GetMilliSeconds() - begTime < 200)
+    {
+        const int len = client->Recv(buf, sizeof(buf));
+        if (len > 0)
+            recvedBytes += len;
+        else
+            LLBC_Sleep(1);
+    }
+
+    size_t drainedQueueSize = 0;
+    svr->GetSendQueueSize(facade->GetSessionId(), drainedQueueSize);
+
+    const size_t expectedCoalesced = BACKPRESSURE_PACKETS_PER_FRAME * BACKPRESSURE_FRAMES - 1;
+    const size_t expectedDropped = BACKPRESSURE_PACKETS_PER_FRAME * BACKPRESSURE_FRAMES;
+    LLBC_PrintLine("    enter times: %d, leave times: %d, dropped: %lu/%lu, coalesced: %lu/%lu, "
+                   "client received: %lu bytes, drained queue size: %lu",
+                   facade->GetEnterTimes(),
+                   facade->GetLeaveTimes(),
+                   facade->GetDroppedPackets(),
+                   expectedDropped,
+                   facade->GetCoalescedPackets(),
+                   expectedCoalesced,
+                   recvedBytes,
+                   drainedQueueSize);
+
+    const bool succeed = facade->GetEnterTimes() == 1 &&
+                         facade->GetLeaveTimes() == 1 &&
+                         facade->GetDroppedPackets() == expectedDropped &&
+                         facade->GetCoalescedPackets() == expectedCoalesced &&
+                         queueSize >= _highWaterMark &&
+                         drainedQueueSize == 0 &&
+                         !facade->IsDestroyed();
+
+    LLBC_Delete(client);
+    LLBC_Delete(svr);
+
+    return succeed ? LLBC_OK : LLBC_FAILED;
+}
+
+int TestCase_Comm_Backpressure::TestDisconnectPolicy(int port)
+{
+    LLBC_PrintLine("[disconnect policy] default:Disconnect");
+
+    SvrFacade *facade;
+    LLBC_Socket *client;
+    LLBC_IService *svr = StartServer(_runIp,
+                                     port,
+                                     _lowWaterMark,
+                                     _highWaterMark,
+                                     LLBC_BackpressurePolicy::Disconnect,
+                                     facade,
+                                     client);
+    if (!svr)
+        return LLBC_FAILED;
+
+    // Client never receive, wait server disconnect session.
+    const sint64 begTime = LLBC_GetMilliSeconds();
+    while (!facade->IsDestroyed() &&
+        LLBC_GetMilliSeconds() - begTime < 10000)
+        LLBC_Sleep(10);
+
+    LLBC_PrintLine("    enter times: %d, session destroyed: %s",
+                   facade->GetEnterTimes(), facade->IsDestroyed() ? "true" : "false");
+
+    const bool succeed = facade->GetEnterTimes() == 1 && facade->IsDestroyed();
+
+    LLBC_Delete(client);
+    LLBC_Delete(svr);
+
+    return succeed ? LLBC_OK : LLBC_FAILED;
+}
+
+void TestCase_Comm_Backpressure::FetchArgs(int argc, char *argv[])
+{
+    if (argc > 1)
+        _runIp = argv[1];
+    if (argc > 2)
+        _runPort = LLBC_Str2Int32(argv[2]);
+    if (argc > 3)
+        _lowWaterMark = MAX(LLBC_Str2Int32(argv[3]), 1);
+    if (argc > 4)
+        _highWaterMark = MAX(LLBC_Str2Int32(argv[4]), 2);
+}
@@ -0,0 +1,49 @@
+/**
+ * @file    TestCase_Comm_Backpressure.h
+ * @author  Longwei Lai<lailongwei@126.com>
+ * @date    2026/10/18
+ * @version 1.0
+ *
+ * @brief   The llbc library service session send queue backpressure test case.
+ */
+#ifndef __LLBC_TEST_CASE_COMM_BACKPRESSURE_H__
+#define __LLBC_TEST_CASE_COMM_BACKPRESSURE_H__
+
+#include "llbc.h"
+using namespace llbc;
+
+class TestCase_Comm_Backpressure : public LLBC_BaseTestCase
+{
+public:
+    TestCase_Comm_Backpressure();
+    virtual ~TestCase_Comm_Backpressure();
+
+public:
+    virtual int Run(int argc, char *argv[]);
+
+private:
+    void FetchArgs(int argc, char *argv[]);
+
+    /**
+     * Test Drop/Coalesce opcode policies, client not receive until server session enter backpressure state.
+     * @param[in] port - the listen port.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    int TestOpcodePolicies(int port);
+
+    /**
+     * Test Disconnect default policy, server session will be disconnected when enter backpressure state.
+     * @param[in] port - the listen port.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    int TestDisconnectPolicy(int port);
+
+private:
+    LLBC_String _runIp;
+    int _runPort;
+
+    size_t _lowWaterMark;
+    size_t _highWaterMark;
+};
+
+#endif // !__LLBC_TEST_CASE_COMM_BACKPRESSURE_H__
@@ -0,0 +1,318 @@
+/**
+ * @file    TestCase_Comm_ChunkedRecv.cpp
+ * @author  Longwei Lai<lailongwei@126.com>
+ * @date    2026/10/18
+ * @version 1.0
+ *
+ * @brief
+ */
+
+#include "comm/TestCase_Comm_ChunkedRecv.h"
+
+namespace
+{
+
+const int SMALL_OPCODE = 1;
+const int LARGE_OPCODE = 2;
+
+const int SMALL_PAYLOAD_SIZE = 128;
+const int MAX_PACKET_LEN = 4096;
+
+class SvrFacade : public LLBC_IFacade
+{
+public:
+    SvrFacade()
+    : _sessionId(0)
+    , _destroyed(false)
+
+    , _smallPackets(0)
+    , _largePackets(0)
+    , _chunks(0)
+    , _maxChunkSize(0)
+    , _badChunks(0)
+    {
+    }
+
+public:
+    virtual void OnSessionCreate(const LLBC_SessionInfo &sessionInfo)
+    {
+        if (!sessionInfo.IsListenSession())
+            _sessionId = sessionInfo.GetSessionId();
+    }
+
+    virtual void OnSessionDestroy(const LLBC_SessionDestroyInfo &destroyInfo)
+    {
+        if (destroyInfo.GetSessionId() == _sessionId)
+            _destroyed = true;
+    }
+
+public:
+    void OnSmall(LLBC_Packet &packet)
+    {
+        if (packet.IsChunk() || packet.GetPayloadLength() != SMALL_PAYLOAD_SIZE)
+            _badChunks += 1;
+
+        _smallPackets += 1;
+    }
+
+    void OnLarge(LLBC_Packet &packet)
+    {
+        if (!packet.IsChunk())
+        {
+            _largePackets += 1;
+            return;
+        }
+
+        // Chunks must be delivered in order, and chunk payload is offset pattern.
+        const size_t chunkSize = packet.GetPayloadLength();
+        if (packet.GetChunkOffset() != _payload.size())
+            _badChunks += 1;
+
+        const char *chunk = reinterpret_cast<const char *>(packet.GetPayload());
+        for (size_t i = 0; i < chunkSize; i++)
+        {
+            if (chunk[i] != static_cast<char>((packet.GetChunkOffset() + i) % 251))
+            {
+                _badChunks += 1;
+                break;
+            }
+        }
+
+        _payload.append(chunk, chunkSize);
+        _chunks += 1;
+        _maxChunkSize = MAX(_maxChunkSize, chunkSize);
+
+        if (packet.IsLastChunk())
+        {
+            if (_payload.size() != packet.GetChunkTotalLength())
+                _badChunks += 1;
+
+            _largePackets += 1;
+        }
+    }
+
+public:
+    bool IsDestroyed() const
+    {
+        return _destroyed;
+    }
+
+    int GetSmallPackets() const
+    {
+        return _smallPackets;
+    }
+
+    int GetLargePackets() const
+    {
+        return _largePackets;
+    }
+
+    int GetChunks() const
+    {
+        return _chunks;
+    }
+
+    size_t GetMaxChunkSize() const
+    {
+        return _maxChunkSize;
+    }
+
+    int GetBadChunks() const
+    {
+        return _badChunks;
+    }
+
+private:
+    volatile int _sessionId;
+    volatile bool _destroyed;
+
+    volatile int _smallPackets;
+    volatile int _largePackets;
+    volatile int _chunks;
+    size_t _maxChunkSize;
+    volatile int _badChunks;
+
+    LLBC_String _payload;
+};
+
+/**
+ * Create client service and connect to server.
+ */
+LLBC_IService *ConnectServer(const LLBC_String &ip, int port, int &sessionId)
+{
+    LLBC_IService *cli = LLBC_IService::Create(LLBC_IService::Normal, "ChunkedRecvCli");
+    cli->SuppressCoderNotFoundWarning();
+    cli->Start(1);
+
+    sessionId = cli->Connect(ip.c_str(), port);
+    if (sessionId == 0)
+    {
+        LLBC_FilePrintLine(stderr, "Connect to server failed, err: %s", LLBC_FormatLastError());
+        LLBC_Delete(cli);
+
+        return NULL;
+    }
+
+    return cli;
+}
+
+}
+
+TestCase_Comm_ChunkedRecv::TestCase_Comm_ChunkedRecv()
+: _runIp("127.0.0.1")
+, _runPort(7788)
+
+, _payloadSize(4 * 1024 * 1024 + 123)
+, _chunkSize(64 * 1024)
+{
+}
+
+TestCase_Comm_ChunkedRecv::~TestCase_Comm_ChunkedRecv()
+{
+}
+
+int TestCase_Comm_ChunkedRecv::Run(int argc, char *argv[])
+{
+    LLBC_PrintLine("Service max packet length and chunked receive test:");
+    LLBC_PrintLine("  usage: ./a [ip] [port] [payloadSize] [chunkSize]");
+
+    FetchArgs(argc, argv);
+
+    const int maxLenRet = TestMaxPacketLength(_runPort);
+    const int chunkedRet = TestChunkedRecv(_runPort + 1);
+
+    return maxLenRet == LLBC_OK && chunkedRet == LLBC_OK ? LLBC_OK : LLBC_FAILED;
+}
+
+int TestCase_Comm_ChunkedRecv::TestMaxPacketLength(int port)
+{
+    LLBC_PrintLine("[max packet length] max packet length: %d", MAX_PACKET_LEN);
+
+    LLBC_IService *svr = LLBC_IService::Create(LLBC_IService::Normal, "MaxPacketLenSvr");
+    SvrFacade *facade = LLBC_New(SvrFacade);
+    svr->RegisterFacade(facade);
+    svr->Subscribe(SMALL_OPCODE, facade, &SvrFacade::OnSmall);
+    svr->Subscribe(LARGE_OPCODE, facade, &SvrFacade::OnLarge);
+    svr->SuppressCoderNotFoundWarning();
+    svr->SetMaxPacketLength(MAX_PACKET_LEN);
+    if (svr->Start(1) != LLBC_OK ||
+        svr->Listen(_runIp.c_str(), port) == 0)
+    {
+        LLBC_FilePrintLine(stderr, "Start server service failed, err: %s", LLBC_FormatLastError());
+        LLBC_Delete(svr);
+
+        return LLBC_FAILED;
+    }
+
+    int sessionId;
+    LLBC_IService *cli = ConnectServer(_runIp, port, sessionId);
+    if (!cli)
+    {
+        LLBC_Delete(svr);
+        return LLBC_FAILED;
+    }
+
+    // Small packet will be received, the large packet will be rejected when header received.
+    // Send them back to back, the small packet must be delivered even if both lie in one receive buffer.
+    char *payload = LLBC_Malloc(char, MAX_PACKET_LEN * 2);
+    ::memset(payload, 'm', MAX_PACKET_LEN * 2);
+    cli->Send(sessionId, SMALL_OPCODE, payload, SMALL_PAYLOAD_SIZE, 0);
+    cli->Send(sessionId, LARGE_OPCODE, payload, MAX_PACKET_LEN * 2, 0);
+
+    const sint64 begTime = LLBC_GetMilliSeconds();
+    while (!facade->IsDestroyed() &&
+        LLBC_GetMilliSeconds() - begTime < 5000)
+        LLBC_Sleep(10);
+
+    LLBC_PrintLine("    small packets: %d, large packets: %d, session destroyed: %s",
+                   facade->GetSmallPackets(),
+                   facade->GetLargePackets(),
+                   facade->IsDestroyed() ? "true" : "false");
+
+    const bool succeed = facade->GetSmallPackets() == 1 &&
+                         facade->GetLargePackets() == 0 &&
+                         facade->IsDestroyed();
+
+    LLBC_Free(payload);
+    LLBC_Delete(cli);
+    LLBC_Delete(svr);
+
+    return succeed ? LLBC_OK : LLBC_FAILED;
+}
+
+int TestCase_Comm_ChunkedRecv::TestChunkedRecv(int port)
+{
+    LLBC_PrintLine("[chunked receive] payload size: %d, chunk size: %d", _payloadSize, _chunkSize);
+
+    LLBC_IService *svr = LLBC_IService::Create(LLBC_IService::Normal, "ChunkedRecvSvr");
+    SvrFacade *facade = LLBC_New(SvrFacade);
+    svr->RegisterFacade(facade);
+    svr->Subscribe(SMALL_OPCODE, facade, &SvrFacade::OnSmall);
+    svr->Subscribe(LARGE_OPCODE, facade, &SvrFacade::OnLarge);
+    svr->SuppressCoderNotFoundWarning();
+    svr->SetChunkedRecv(true, _chunkSize);
+    if (svr->Start(1) != LLBC_OK ||
+        svr->Listen(_runIp.c_str(), port) == 0)
+    {
+        LLBC_FilePrintLine(stderr, "Start server service failed, err: %s", LLBC_FormatLastError());
+        LLBC_Delete(svr);
+
+        return LLBC_FAILED;
+    }
+
+    int sessionId;
+    LLBC_IService *cli = ConnectServer(_runIp, port, sessionId);
+    if (!cli)
+    {
+        LLBC_Delete(svr);
+        return LLBC_FAILED;
+    }
+
+    // Small packets(not exceed chunk size) still be delivered whole.
+    char *payload = LLBC_Malloc(char, _payloadSize);
+    for (int i = 0; i < _payloadSize; i++)
+        payload[i] = static_cast<char>(i % 251);
+
+    cli->Send(sessionId, SMALL_OPCODE, payload, SMALL_PAYLOAD_SIZE, 0);
+    cli->Send(sessionId, LARGE_OPCODE, payload, _payloadSize, 0);
+    cli->Send(sessionId, SMALL_OPCODE, payload, SMALL_PAYLOAD_SIZE, 0);
+
+    const sint64 begTime = LLBC_GetMilliSeconds();
+    while ((facade->GetLargePackets() < 1 || facade->GetSmallPackets() < 2) &&
+        LLBC_GetMilliSeconds() - begTime < 10000)
+        LLBC_Sleep(10);
+
+    const int expectedChunks = (_payloadSize + _chunkSize - 1) / _chunkSize;
+    LLBC_PrintLine("    small packets: %d, large packets: %d, chunks: %d/%d, max chunk size: %lu, bad chunks: %d",
+                   facade->GetSmallPackets(),
+                   facade->GetLargePackets(),
+                   facade->GetChunks(),
+                   expectedChunks,
+                   facade->GetMaxChunkSize(),
+                   facade->GetBadChunks());
+
+    const bool succeed = facade->GetSmallPackets() == 2 &&
+                         facade->GetLargePackets() == 1 &&
+                         facade->GetChunks() == expectedChunks &&
+                         facade->GetMaxChunkSize() == static_cast<size_t>(_chunkSize) &&
+                         facade->GetBadChunks() == 0 &&
+                         !facade->IsDestroyed();
+
+    LLBC_Free(payload);
+    LLBC_Delete(cli);
+    LLBC_Delete(svr);
+
+    return succeed ? LLBC_OK : LLBC_FAILED;
+}
+
+void TestCase_Comm_ChunkedRecv::FetchArgs(int argc, char *argv[])
+{
+    if (argc > 1)
+        _runIp = argv[1];
+    if (argc > 2)
+        _runPort = LLBC_Str2Int32(argv[2]);
+    if (argc > 3)
+        _payloadSize = MAX(LLBC_Str2Int32(argv[3]), 1);
+    if (argc > 4)
+        _chunkSize = MAX(LLBC_Str2Int32(argv[4]), 1);
+}
@@ -0,0 +1,49 @@
+/**
+ * @file    TestCase_Comm_ChunkedRecv.h
+ * @author  Longwei Lai<lailongwei@126.com>
+ * @date    2026/10/18
+ * @version 1.0
+ *
+ * @brief   The llbc library service max packet length and chunked receive test case.
+ */
+#ifndef __LLBC_TEST_CASE_COMM_CHUNKED_RECV_H__
+#define __LLBC_TEST_CASE_COMM_CHUNKED_RECV_H__
+
+#include "llbc.h"
+using namespace llbc;
+
+class TestCase_Comm_ChunkedRecv : public LLBC_BaseTestCase
+{
+public:
+    TestCase_Comm_ChunkedRecv();
+    virtual ~TestCase_Comm_ChunkedRecv();
+
+public:
+    virtual int Run(int argc, char *argv[]);
+
+private:
+    void FetchArgs(int argc, char *argv[]);
+
+    /**
+     * Test max packet length, the packet exceed max packet length will cause session removed.
+     * @param[in] port - the listen port.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    int TestMaxPacketLength(int port);
+
+    /**
+     * Test chunked receive, the large payload will be delivered as chunks.
+     * @param[in] port - the listen port.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    int TestChunkedRecv(int port);
+
+private:
+    LLBC_String _runIp;
+    int _runPort;
+
+    int _payloadSize;
+    int _chunkSize;
+};
+
+#endif // !__LLBC_TEST_CASE_COMM_CHUNKED_RECV_H__
@@ -0,0 +1,273 @@
+/**
+ * @file    TestCase_Comm_CoalescedSend.cpp
+ * @author  Longwei Lai<lailongwei@126.com>
+ * @date    2026/10/18
+ * @version 1.0
+ *
+ * @brief
+ */
+
+#include "comm/TestCase_Comm_CoalescedSend.h"
+
+namespace
+{
+
+const int OPCODE = 1;
+const int PAYLOAD_SIZE = 32;
+
+// The hot session send packets times of other sessions.
+const int HOT_FACTOR = 8;
+
+class SvrFacade : public LLBC_IFacade
+{
+public:
+    SvrFacade(int perFramePackets, int frames, bool hotSession)
+    : _perFramePackets(perFramePackets)
+    , _frames(frames)
+    , _hotSession(hotSession)
+
+    , _sending(false)
+    , _sentFrames(0)
+    {
+        ::memset(_payload, 'c', sizeof(_payload));
+    }
+
+public:
+    virtual void OnSessionCreate(const LLBC_SessionInfo &sessionInfo)
+    {
+        if (sessionInfo.IsListenSession())
+            return;
+
+        _sessionIds.push_back(sessionInfo.GetSessionId());
+        _seqs.push_back(0);
+    }
+
+    virtual void OnUpdate()
+    {
+        if (!_sending || _sentFrames >= _frames)
+            return;
+
+        // Chatty protocol, send many small packets to every session in one frame, the hot session(first session)
+        // send HOT_FACTOR times packets.
+        for (int i = 0; i < _perFramePackets * (_hotSession ? HOT_FACTOR : 1); i++)
+        {
+            for (size_t j = 0; j < _sessionIds.size(); j++)
+            {
+                if (i >= _perFramePackets && j != 0)
+                    break;
+
+                ::memcpy(_payload, &_seqs[j], sizeof(sint32));
+                _seqs[j] += 1;
+
+                GetService()->Send(_sessionIds[j], OPCODE, _payload, sizeof(_payload), 0);
+            }
+        }
+
+        _sentFrames += 1;
+    }
+
+public:
+    int GetSessionCount() const
+    {
+        return static_cast<int>(_sessionIds.size());
+    }
+
+    void StartSend()
+    {
+        _sending = true;
+    }
+
+private:
+    const int _perFramePackets;
+    const int _frames;
+    const bool _hotSession;
+
+    volatile bool _sending;
+    int _sentFrames;
+
+    char _payload[PAYLOAD_SIZE];
+    std::vector<int> _sessionIds;
+    std::vector<sint32> _seqs;
+};
+
+class CliFacade : public LLBC_IFacade
+{
+public:
+    CliFacade()
+    : _recvCount(0)
+    , _badCount(0)
+    {
+    }
+
+public:
+    void OnRecv(LLBC_Packet &packet)
+    {
+        _recvCount += 1;
+
+        sint32 seq;
+        ::memcpy(&seq, packet.GetPayload(), sizeof(sint32));
+
+        sint32 &expectSeq = _expectSeqs[packet.GetSessionId()];
+        if (packet.GetPayloadLength() != PAYLOAD_SIZE || seq != expectSeq)
+            _badCount += 1;
+
+        expectSeq = seq + 1;
+    }
+
+    sint32 GetRecvCount() const
+    {
+        return _recvCount;
+    }
+
+    sint32 GetBadCount() const
+    {
+        return _badCount;
+    }
+
+private:
+    volatile sint32 _recvCount;
+    volatile sint32 _badCount;
+
+    std::map<int, sint32> _expectSeqs;
+};
+
+}
+
+TestCase_Comm_CoalescedSend::TestCase_Comm_CoalescedSend()
+: _runIp("127.0.0.1")
+, _runPort(7788)
+
+, _sessionCount(100)
+, _perFramePackets(50)
+, _frames(100)
+{
+}
+
+TestCase_Comm_CoalescedSend::~TestCase_Comm_CoalescedSend()
+{
+}
+
+int TestCase_Comm_CoalescedSend::Run(int argc, char *argv[])
+{
+    LLBC_PrintLine("Service coalesced send test:");
+    LLBC_PrintLine("  usage: ./a [ip] [port] [sessionCount] [perFramePackets] [frames]");
+
+    FetchArgs(argc, argv);
+
+    LLBC_PrintLine("sessions: %d, packets per frame per session: %d, frames: %d, payload: %d bytes",
+                   _sessionCount, _perFramePackets, _frames, PAYLOAD_SIZE);
+
+    const int immediateRet = RunOnce(false, false, _runPort);
+    const int coalescedRet = RunOnce(true, false, _runPort + 1);
+    const int hotSessionRet = RunOnce(true, true, _runPort + 2);
+
+    return immediateRet == LLBC_OK &&
+           coalescedRet == LLBC_OK &&
+           hotSessionRet == LLBC_OK ? LLBC_OK : LLBC_FAILED;
+}
+
+int TestCase_Comm_CoalescedSend::RunOnce(bool coalesced, bool hotSession, int port)
+{
+    const char *modeName = hotSession ? "hot-session" : (coalesced ? "coalesced" : "immediate");
+
+    // Create server service.
+    LLBC_IService *svr = LLBC_IService::Create(LLBC_IService::Normal, coalesced ? "CoalescedSvr" : "ImmediateSvr");
+    SvrFacade *svrFacade = LLBC_New3(SvrFacade, _perFramePackets, _frames, hotSession);
+    svr->RegisterFacade(svrFacade);
+    svr->SuppressCoderNotFoundWarning();
+    svr->SetFPS(LLBC_CFG_COMM_MAX_SERVICE_FPS);
+
+    // Hot session mode, session bytes limit is two frames packets of normal session, only hot session
+    // reach limit, and only hot session batch flushed.
+    const size_t hotLimitPackets = _perFramePackets * 2;
+    if (hotSession)
+        svr->SetCoalescedSend(true, PAYLOAD_SIZE * hotLimitPackets, 0);
+    else if (coalesced)
+        svr->SetCoalescedSend(true);
+
+    if (svr->Start(1) != LLBC_OK ||
+        svr->Listen(_runIp.c_str(), port) == 0)
+    {
+        LLBC_FilePrintLine(stderr, "Start server service failed, err: %s", LLBC_FormatLastError());
+        LLBC_Delete(svr);
+
+        return LLBC_FAILED;
+    }
+
+    // Create client service and connect to server.
+    LLBC_IService *cli = LLBC_IService::Create(LLBC_IService::Normal, coalesced ? "CoalescedCli" : "ImmediateCli");
+    CliFacade *cliFacade = LLBC_New(CliFacade);
+    cli->RegisterFacade(cliFacade);
+    cli->Subscribe(OPCODE, cliFacade, &CliFacade::OnRecv);
+    cli->SuppressCoderNotFoundWarning();
+    cli->Start(1);
+
+    int connected = 0;
+    for (int i = 0; i < _sessionCount; i++)
+    {
+        if (cli->Connect(_runIp.c_str(), port) == 0)
+            break;
+
+        connected += 1;
+    }
+
+    // Wait server accept all sessions.
+    const sint64 connectedTime = LLBC_GetMilliSeconds();
+    while (svrFacade->GetSessionCount() < connected &&
+        LLBC_GetMilliSeconds() - connectedTime < 5000)
+        LLBC_Sleep(10);
+
+    // Start send and wait all packets received.
+    sint32 expectedCount = svrFacade->GetSessionCount() * _perFramePackets * _frames;
+    if (hotSession && svrFacade->GetSessionCount() > 0)
+        expectedCount += (HOT_FACTOR - 1) * _perFramePackets * _frames;
+
+    const sint64 begTime = LLBC_GetMicroSeconds();
+    svrFacade->StartSend();
+    while (cliFacade->GetRecvCount() < expectedCount &&
+        LLBC_GetMicroSeconds() - begTime < 60 * 1000000LL)
+        LLBC_Sleep(1);
+    const sint64 elapsed = MAX(LLBC_GetMicroSeconds() - begTime, 1);
+
+    LLBC_SendStat sendStat;
+    svr->GetSendStat(sendStat);
+    LLBC_CoalescedSendStat coalescedStat;
+    svr->GetCoalescedSendStat(coalescedStat);
+
+    LLBC_PrintLine("[%s] received: %d/%d, bad: %d, elapsed: %.3f ms, delivered: %.0f packets/s",
+                   modeName,
+                   cliFacade->GetRecvCount(),
+                   expectedCount,
+                   cliFacade->GetBadCount(),
+                   elapsed / 1000.0,
+                   cliFacade->GetRecvCount() * 1000000.0 / elapsed);
+    LLBC_PrintLine("    server send stat: %s", sendStat.ToString().c_str());
+    LLBC_PrintLine("    server coalesced stat: %s", coalescedStat.ToString().c_str());
+
+    bool succeed = cliFacade->GetRecvCount() == expectedCount && cliFacade->GetBadCount() == 0;
+
+    // The bytes limit flushes only flush hot session packets, every flush exactly flush limit packets.
+    if (hotSession)
+        succeed = succeed &&
+                  coalescedStat.bytesLimitFlushes == static_cast<uint64>(HOT_FACTOR / 2 * _frames) &&
+                  coalescedStat.bytesLimitPackets == coalescedStat.bytesLimitFlushes * hotLimitPackets;
+
+    LLBC_Delete(cli);
+    LLBC_Delete(svr);
+
+    return succeed ? LLBC_OK : LLBC_FAILED;
+}
+
+void TestCase_Comm_CoalescedSend::FetchArgs(int argc, char *argv[])
+{
+    if (argc > 1)
+        _runIp = argv[1];
+    if (argc > 2)
+        _runPort = LLBC_Str2Int32(argv[2]);
+    if (argc > 3)
+        _sessionCount = MAX(LLBC_Str2Int32(argv[3]), 1);
+    if (argc > 4)
+        _perFramePackets = MAX(LLBC_Str2Int32(argv[4]), 1);
+    if (argc > 5)
+        _frames = MAX(LLBC_Str2Int32(argv[5]), 1);
+}
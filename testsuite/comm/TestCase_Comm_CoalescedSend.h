@@ -0,0 +1,45 @@
+/**
+ * @file    TestCase_Comm_CoalescedSend.h
+ * @author  Longwei Lai<lailongwei@126.com>
+ * @date    2026/10/18
+ * @version 1.0
+ *
+ * @brief   The llbc library service coalesced send test case.
+ */
+#ifndef __LLBC_TEST_CASE_COMM_COALESCED_SEND_H__
+#define __LLBC_TEST_CASE_COMM_COALESCED_SEND_H__
+
+#include "llbc.h"
+using namespace llbc;
+
+class TestCase_Comm_CoalescedSend : public LLBC_BaseTestCase
+{
+public:
+    TestCase_Comm_CoalescedSend();
+    virtual ~TestCase_Comm_CoalescedSend();
+
+public:
+    virtual int Run(int argc, char *argv[]);
+
+private:
+    void FetchArgs(int argc, char *argv[]);
+
+    /**
+     * Run once, server send packets in every frame update.
+     * @param[in] coalesced  - enable server coalesced send or not.
+     * @param[in] hotSession - the first session send more packets than other sessions and reach bytes limit.
+     * @param[in] port       - the listen port.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    int RunOnce(bool coalesced, bool hotSession, int port);
+
+private:
+    LLBC_String _runIp;
+    int _runPort;
+
+    int _sessionCount;
+    int _perFramePackets;
+    int _frames;
+};
+
+#endif // !__LLBC_TEST_CASE_COMM_COALESCED_SEND_H__
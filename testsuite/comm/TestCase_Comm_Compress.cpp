@@ -0,0 +1,309 @@
+/**
+ * @file    TestCase_Comm_Compress.cpp
+ * @author  Longwei Lai<lailongwei@126.com>
+ * @date    2026/10/18
+ * @version 1.0
+ *
+ * @brief
+ */
+
+#include "comm/TestCase_Comm_Compress.h"
+
+namespace
+{
+
+const int OPCODE_COMPRESS = 1;
+const int OPCODE_NOT_COMPRESS = 2;
+
+const size_t PAYLOAD_SIZES[] = {5 * 1024, 20 * 1024, 60 * 1024};
+const sint64 BENCH_TIME = 300; // Per case bench time, in milli-seconds.
+
+enum PayloadKind
+{
+    StateSync,
+    JsonText,
+    RandomBytes,
+
+    PayloadKindEnd
+};
+
+const char *PAYLOAD_KIND_NAMES[] = {"state-sync", "json-text", "random"};
+
+#pragma pack(push, 1)
+struct EntityState
+{
+    uint32 entityId;
+    float x;
+    float y;
+    float z;
+    uint16 hp;
+    uint8 state;
+};
+#pragma pack(pop)
+
+void GenPayload(int kind, size_t size, std::vector<char> &payload)
+{
+    payload.resize(size);
+    if (kind == StateSync) // Entities state, neighbor entities similar.
+    {
+        EntityState entity;
+        for (size_t off = 0, i = 0; off < size; off += sizeof(entity), i++)
+        {
+            entity.entityId = static_cast<uint32>(100000 + i);
+            entity.x = 100.0f + (i % 16) * 0.5f;
+            entity.y = 0.0f;
+            entity.z = 200.0f + (i % 8) * 0.25f;
+            entity.hp = static_cast<uint16>(1000 - (i % 4) * 10);
+            entity.state = static_cast<uint8>(i % 3);
+
+            ::memcpy(&payload[off], &entity, MIN(sizeof(entity), size - off));
+        }
+    }
+    else if (kind == JsonText) // Player info json array.
+    {
+        LLBC_String text;
+        for (int i = 0; text.size() < size; i++)
+            text.append_format("{\"id\":%d,\"name\":\"player_%d\",\"level\":%d,\"pos\":[%.1f,%.1f,%.1f]},",
+                               10000 + i, 10000 + i, i % 100, i * 1.5, i * 2.5, i * 0.5);
+
+        ::memcpy(&payload[0], text.data(), size);
+    }
+    else // Xorshift random bytes, incompressible.
+    {
+        uint32 seed = 2463534242U;
+        for (size_t i = 0; i < size; i++)
+        {
+            seed ^= seed << 13;
+            seed ^= seed >> 17;
+            seed ^= seed << 5;
+            payload[i] = static_cast<char>(seed);
+        }
+    }
+}
+
+class RecvFacade : public LLBC_IFacade
+{
+public:
+    RecvFacade(const std::vector<char> &expected)
+    : _expected(expected)
+    , _recvCount(0)
+    , _badCount(0)
+    , _compressedCount(0)
+    {
+    }
+
+public:
+    void OnRecv(LLBC_Packet &packet)
+    {
+        _recvCount += 1;
+        if (packet.GetPayloadLength() != _expected.size() ||
+            ::memcmp(packet.GetPayload(), &_expected[0], _expected.size()) != 0)
+            _badCount += 1;
+
+        // Decompressed packet must remove the compressed flag.
+        if (packet.HasFlags(LLBC_CFG_COMM_COMPRESSED_FLAG))
+            _compressedCount += 1;
+    }
+
+    sint32 GetRecvCount() const
+    {
+        return _recvCount;
+    }
+
+    sint32 GetBadCount() const
+    {
+        return _badCount;
+    }
+
+    sint32 GetCompressedCount() const
+    {
+        return _compressedCount;
+    }
+
+private:
+    const std::vector<char> &_expected;
+
+    volatile sint32 _recvCount;
+    volatile sint32 _badCount;
+    volatile sint32 _compressedCount;
+};
+
+}
+
+TestCase_Comm_Compress::TestCase_Comm_Compress()
+: _runIp("127.0.0.1")
+, _runPort(7788)
+
+, _packetCount(10000)
+{
+}
+
+TestCase_Comm_Compress::~TestCase_Comm_Compress()
+{
+}
+
+int TestCase_Comm_Compress::Run(int argc, char *argv[])
+{
+    LLBC_PrintLine("Compress-Layer(LZ4) benchmark:");
+    LLBC_PrintLine("  usage: ./a [ip] [port] [packetCount]");
+
+    FetchArgs(argc, argv);
+
+    if (BenchLZ4() != LLBC_OK)
+        return LLBC_FAILED;
+
+    LLBC_PrintLine("");
+    return BenchService();
+}
+
+void TestCase_Comm_Compress::FetchArgs(int argc, char *argv[])
+{
+    if (argc > 1)
+        _runIp = argv[1];
+    if (argc > 2)
+        _runPort = LLBC_Str2Int32(argv[2]);
+    if (argc > 3)
+        _packetCount = MAX(LLBC_Str2Int32(argv[3]), 1);
+}
+
+int TestCase_Comm_Compress::BenchLZ4()
+{
+    LLBC_PrintLine("%12s %8s %12s %8s %14s %14s",
+                   "payload", "size", "compressed", "ratio", "compress MB/s", "decompress MB/s");
+
+    std::vector<char> payload;
+    std::vector<char> compressed;
+    std::vector<char> decompressed;
+    for (int kind = StateSync; kind != PayloadKindEnd; kind++)
+    {
+        for (size_t i = 0; i < sizeof(PAYLOAD_SIZES) / sizeof(PAYLOAD_SIZES[0]); i++)
+        {
+            const size_t size = PAYLOAD_SIZES[i];
+            GenPayload(kind, size, payload);
+            compressed.resize(LLBC_LZ4::GetCompressBound(size));
+            decompressed.resize(size);
+
+            // Compress bench.
+            int times = 0;
+            size_t compressedLen = 0;
+            sint64 begTime = LLBC_GetMicroSeconds();
+            do
+            {
+                if (LLBC_LZ4::Compress(&payload[0], size, &compressed[0], compressed.size(), compressedLen) != LLBC_OK)
+                {
+                    LLBC_FilePrintLine(stderr, "Compress failed, err: %s", LLBC_FormatLastError());
+                    return LLBC_FAILED;
+                }
+
+                times += 1;
+            } while (LLBC_GetMicroSeconds() - begTime < BENCH_TIME * 1000);
+            const double compMBps = size * static_cast<double>(times) /
+                (LLBC_GetMicroSeconds() - begTime) * 1000000.0 / (1024 * 1024);
+
+            // Decompress bench.
+            times = 0;
+            begTime = LLBC_GetMicroSeconds();
+            do
+            {
+                if (LLBC_LZ4::Decompress(&compressed[0], compressedLen, &decompressed[0], size) != LLBC_OK)
+                {
+                    LLBC_FilePrintLine(stderr, "Decompress failed, err: %s", LLBC_FormatLastError());
+                    return LLBC_FAILED;
+                }
+
+                times += 1;
+            } while (LLBC_GetMicroSeconds() - begTime < BENCH_TIME * 1000);
+            const double decompMBps = size * static_cast<double>(times) /
+                (LLBC_GetMicroSeconds() - begTime) * 1000000.0 / (1024 * 1024);
+
+            if (decompressed != payload)
+            {
+                LLBC_FilePrintLine(stderr, "Verify decompressed data failed, payload: %s, size: %lu",
+                                   PAYLOAD_KIND_NAMES[kind], size);
+                return LLBC_FAILED;
+            }
+
+            LLBC_PrintLine("%12s %8lu %12lu %8.3f %14.1f %14.1f",
+                           PAYLOAD_KIND_NAMES[kind],
+                           size,
+                           compressedLen,
+                           static_cast<double>(size) / compressedLen,
+                           compMBps,
+                           decompMBps);
+        }
+    }
+
+    return LLBC_OK;
+}
+
+int TestCase_Comm_Compress::BenchService()
+{
+    LLBC_PrintLine("Service end-to-end(threshold policy, opcode %d override to None):", OPCODE_NOT_COMPRESS);
+
+    std::vector<char> payload;
+    GenPayload(StateSync, PAYLOAD_SIZES[1], payload);
+
+    // Create server service, server not set compress policy, but it can decompress all compressed packets.
+    LLBC_IService *svr = LLBC_IService::Create(LLBC_IService::Normal, "CompressSvr");
+    RecvFacade *facade = LLBC_New1(RecvFacade, payload);
+    svr->RegisterFacade(facade);
+    svr->Subscribe(OPCODE_COMPRESS, facade, &RecvFacade::OnRecv);
+    svr->Subscribe(OPCODE_NOT_COMPRESS, facade, &RecvFacade::OnRecv);
+    svr->SuppressCoderNotFoundWarning();
+    if (svr->Start() != LLBC_OK ||
+        svr->Listen(_runIp.c_str(), _runPort) == 0)
+    {
+        LLBC_FilePrintLine(stderr, "Start server service failed, err: %s", LLBC_FormatLastError());
+        LLBC_Delete(svr);
+
+        return LLBC_FAILED;
+    }
+
+    // Create client service, enable compress.
+    LLBC_IService *cli = LLBC_IService::Create(LLBC_IService::Normal, "CompressCli");
+    cli->SuppressCoderNotFoundWarning();
+    cli->SetCompressPolicy(LLBC_CompressPolicy::Threshold, 1024);
+    cli->SetOpcodeCompressPolicy(OPCODE_NOT_COMPRESS, LLBC_CompressPolicy::None);
+    cli->Start();
+
+    const int sessionId = cli->Connect(_runIp.c_str(), _runPort);
+    if (sessionId == 0)
+    {
+        LLBC_FilePrintLine(stderr, "Connect to %s:%d failed, err: %s",
+            _runIp.c_str(), _runPort, LLBC_FormatLastError());
+        LLBC_Delete(cli);
+        LLBC_Delete(svr);
+
+        return LLBC_FAILED;
+    }
+
+    int sent = 0;
+    const sint64 begTime = LLBC_GetMilliSeconds();
+    for (int i = 0; i < _packetCount; i++)
+    {
+        const int opcode = i % 2 == 0 ? OPCODE_COMPRESS : OPCODE_NOT_COMPRESS;
+        if (cli->Send(sessionId, opcode, &payload[0], payload.size(), 0) == LLBC_OK)
+            sent += 1;
+    }
+
+    // Wait server received all packets(at most 30 seconds).
+    while (facade->GetRecvCount() < sent &&
+        LLBC_GetMilliSeconds() - begTime < 30000)
+        LLBC_Sleep(1);
+    const sint64 elapsed = MAX(LLBC_GetMilliSeconds() - begTime, 1);
+
+    LLBC_PrintLine("  sent: %d, received: %d, bad: %d, flag not removed: %d, packets/s: %.0f",
+                   sent,
+                   facade->GetRecvCount(),
+                   facade->GetBadCount(),
+                   facade->GetCompressedCount(),
+                   facade->GetRecvCount() * 1000.0 / elapsed);
+
+    const bool succeed = facade->GetRecvCount() == sent &&
+        facade->GetBadCount() == 0 && facade->GetCompressedCount() == 0;
+
+    LLBC_Delete(cli);
+    LLBC_Delete(svr);
+
+    return succeed ? LLBC_OK : LLBC_FAILED;
+}
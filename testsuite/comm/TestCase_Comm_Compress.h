@@ -0,0 +1,37 @@
+/**
+ * @file    TestCase_Comm_Compress.h
+ * @author  Longwei Lai<lailongwei@126.com>
+ * @date    2026/10/18
+ * @version 1.0
+ *
+ * @brief   The llbc library Compress-Layer(LZ4) benchmark test case.
+ */
+#ifndef __LLBC_TEST_CASE_COMM_COMPRESS_H__
+#define __LLBC_TEST_CASE_COMM_COMPRESS_H__
+
+#include "llbc.h"
+using namespace llbc;
+
+class TestCase_Comm_Compress : public LLBC_BaseTestCase
+{
+public:
+    TestCase_Comm_Compress();
+    virtual ~TestCase_Comm_Compress();
+
+public:
+    virtual int Run(int argc, char *argv[]);
+
+private:
+    void FetchArgs(int argc, char *argv[]);
+
+    int BenchLZ4();
+    int BenchService();
+
+private:
+    LLBC_String _runIp;
+    int _runPort;
+
+    int _packetCount;
+};
+
+#endif // !__LLBC_TEST_CASE_COMM_COMPRESS_H__
@@ -0,0 +1,528 @@
+/**
+ * @file    TestCase_Comm_Coro.cpp
+ * @author  Longwei Lai<lailongwei@126.com>
+ * @date    2026/10/18
+ * @version 1.0
+ *
+ * @brief
+ */
+
+#include "comm/TestCase_Comm_Coro.h"
+
+namespace
+{
+
+const int QUERY_OPCODE = 1;
+const int DROP_OPCODE = 2;
+const int BAD_DECODE_OPCODE = 3;
+
+// The correlation header part serial No, append to library header layout(part 0~4).
+const int CORRELATION_PART = 5;
+
+// The posted result.
+int PostedResult = 0x1234;
+
+// The pending coroutine cancelled flag.
+volatile int PendingCancelled = 0;
+
+// The always decode failed coder, client use it to decode BAD_DECODE_OPCODE response.
+class BadDecodeCoder : public LLBC_ICoder
+{
+public:
+    virtual bool Encode(LLBC_Packet &packet)
+    {
+        return true;
+    }
+
+    virtual bool Decode(LLBC_Packet &packet)
+    {
+        return false;
+    }
+};
+
+class BadDecodeCoderFactory : public LLBC_ICoderFactory
+{
+public:
+    virtual LLBC_ICoder *Create() const
+    {
+        return LLBC_New(BadDecodeCoder);
+    }
+};
+
+class SvrFacade : public LLBC_IFacade
+{
+public:
+    SvrFacade()
+    : _queries(0)
+    , _errors(0)
+    {
+    }
+
+public:
+    void OnQuery(LLBC_Packet &packet)
+    {
+        // Simulate async db query, packet keep valid in coroutine handler.
+        const sint64 correlationId = packet.GetHeaderPartAsSInt64(CORRELATION_PART);
+        if (GetService()->AwaitTimer(1) != LLBC_OK)
+            _errors += 1;
+
+        sint64 payload;
+        ::memcpy(&payload, packet.GetPayload(), sizeof(payload));
+        if (payload != correlationId ||
+            packet.GetHeaderPartAsSInt64(CORRELATION_PART) != correlationId)
+            _errors += 1;
+
+        LLBC_PacketHeaderParts *parts = LLBC_New(LLBC_PacketHeaderParts);
+        parts->SetPart(CORRELATION_PART, correlationId);
+        GetService()->Send2(packet.GetSessionId(), QUERY_OPCODE, &payload, sizeof(payload), 0, parts);
+
+        _queries += 1;
+    }
+
+    void OnDrop(LLBC_Packet &packet)
+    {
+    }
+
+    void OnBadDecode(LLBC_Packet &packet)
+    {
+        // Echo back, the client will decode response failed.
+        LLBC_PacketHeaderParts *parts = LLBC_New(LLBC_PacketHeaderParts);
+        parts->SetPart(CORRELATION_PART, packet.GetHeaderPartAsSInt64(CORRELATION_PART));
+        GetService()->Send2(packet.GetSessionId(),
+                            BAD_DECODE_OPCODE,
+                            packet.GetPayload(),
+                            packet.GetPayloadLength(),
+                            0,
+                            parts);
+    }
+
+public:
+    int GetQueries() const
+    {
+        return _queries;
+    }
+
+    int GetErrors() const
+    {
+        return _errors;
+    }
+
+private:
+    volatile int _queries;
+    volatile int _errors;
+};
+
+class CliFacade : public LLBC_IFacade
+{
+public:
+    CliFacade(int coroCount, int requestCount)
+    : _coroCount(coroCount)
+    , _requestCount(requestCount)
+    , _sessionId(0)
+    , _badDecodeSessionId(0)
+    , _nextCorrelationId(0)
+    , _launched(false)
+
+    , _finished(0)
+    , _errors(0)
+    , _timeoutOk(false)
+    , _decodeFailOk(false)
+    , _resultOk(false)
+    , _resultCoroId(0)
+    , _coroCountAfterFinished(-1)
+    , _done(0)
+    {
+        _latencies.reserve(coroCount * requestCount);
+    }
+
+public:
+    void SetSessionIds(int sessionId, int badDecodeSessionId)
+    {
+        _badDecodeSessionId = badDecodeSessionId;
+        _sessionId = sessionId;
+    }
+
+    virtual void OnUpdate()
+    {
+        if (_sessionId == 0 || _done)
+            return;
+
+        if (!_launched)
+        {
+            _launched = true;
+            for (int i = 0; i < _coroCount; i++)
+            {
+                if (GetService()->Go(this, &CliFacade::RunRequests) == 0)
+                    _errors += 1;
+            }
+
+            GetService()->Go(this, &CliFacade::RunTimeout);
+            GetService()->Go(this, &CliFacade::RunDecodeFail);
+            GetService()->Go(this, &CliFacade::RunResult);
+            GetService()->Go(this, &CliFacade::RunPending);
+        }
+
+        // All coroutines finished, except the pending one.
+        if (_finished == _coroCount + 3)
+        {
+            _coroCountAfterFinished = static_cast<int>(GetService()->GetCoroCount());
+            _done = 1;
+        }
+    }
+
+public:
+    void RunRequests()
+    {
+        for (int i = 0; i < _requestCount; i++)
+        {
+            const sint64 correlationId = ++_nextCorrelationId;
+            const sint64 begTime = LLBC_GetMicroSeconds();
+
+            LLBC_PacketHeaderParts *parts = LLBC_New(LLBC_PacketHeaderParts);
+            parts->SetPart(CORRELATION_PART, correlationId);
+            GetService()->Send2(_sessionId, QUERY_OPCODE, &correlationId, sizeof(correlationId), 0, parts);
+
+            // Coroutine suspended here, service resume it when correlation matched response arrived.
+            LLBC_Packet *packet = GetService()->AwaitPacket(_sessionId, correlationId, 5000);
+            if (!packet)
+            {
+                _errors += 1;
+                continue;
+            }
+
+            sint64 payload;
+            ::memcpy(&payload, packet->GetPayload(), sizeof(payload));
+            if (payload != correlationId)
+                _errors += 1;
+
+            _latencies.push_back(LLBC_GetMicroSeconds() - begTime);
+            LLBC_Delete(packet);
+        }
+
+        _finished += 1;
+    }
+
+    void RunTimeout()
+    {
+        // Server not response drop request, await will timeout.
+        const sint64 correlationId = -1;
+        LLBC_PacketHeaderParts *parts = LLBC_New(LLBC_PacketHeaderParts);
+        parts->SetPart(CORRELATION_PART, correlationId);
+        GetService()->Send2(_sessionId, DROP_OPCODE, &correlationId, sizeof(correlationId), 0, parts);
+
+        sint64 begTime = LLBC_GetMonoMilliSeconds();
+        LLBC_Packet *packet = GetService()->AwaitPacket(_sessionId, correlationId, 100);
+        const bool packetTimeoutOk = packet == NULL &&
+                                     LLBC_GetLastError() == LLBC_ERROR_TIMEOUT &&
+                                     LLBC_GetMonoMilliSeconds() - begTime >= 90;
+        LLBC_XDelete(packet);
+
+        begTime = LLBC_GetMonoMilliSeconds();
+        const bool timerOk = GetService()->AwaitTimer(50) == LLBC_OK &&
+                             LLBC_GetMonoMilliSeconds() - begTime >= 40;
+
+        _timeoutOk = packetTimeoutOk && timerOk;
+        _finished += 1;
+    }
+
+    void RunDecodeFail()
+    {
+        // Same correlation Id as the first request, awaiters keyed by session, not conflict.
+        const sint64 correlationId = 1;
+        LLBC_PacketHeaderParts *parts = LLBC_New(LLBC_PacketHeaderParts);
+        parts->SetPart(CORRELATION_PART, correlationId);
+        GetService()->Send2(_badDecodeSessionId, BAD_DECODE_OPCODE, &correlationId, sizeof(correlationId), 0, parts);
+
+        // Response decode failed, await fail with decode error immediately(not timeout).
+        sint64 begTime = LLBC_GetMonoMilliSeconds();
+        LLBC_Packet *packet = GetService()->AwaitPacket(_badDecodeSessionId, correlationId, 5000);
+        const bool decodeFailOk = packet == NULL &&
+                                  LLBC_GetLastError() == LLBC_ERROR_DECODE &&
+                                  LLBC_GetMonoMilliSeconds() - begTime < 4000;
+        LLBC_XDelete(packet);
+
+        // Decode failed session removed, await on it fail with not found.
+        packet = GetService()->AwaitPacket(_badDecodeSessionId, correlationId + 1, 5000);
+        const bool sessionRemovedOk = packet == NULL &&
+                                      LLBC_GetLastError() == LLBC_ERROR_NOT_FOUND &&
+                                      LLBC_GetMonoMilliSeconds() - begTime < 4000;
+        LLBC_XDelete(packet);
+
+        _decodeFailOk = decodeFailOk && sessionRemovedOk;
+        _finished += 1;
+    }
+
+    void RunResult()
+    {
+        _resultCoroId = LLBC_Coro::GetCurrent()->GetId();
+
+        void *result = NULL;
+        _resultOk = GetService()->AwaitResult(result, 5000) == LLBC_OK &&
+                    result == &PostedResult;
+
+        _finished += 1;
+    }
+
+    void RunPending()
+    {
+        // Never posted, service stop will cancel it.
+        void *result = NULL;
+        if (GetService()->AwaitResult(result) != LLBC_OK &&
+            LLBC_GetLastError() == LLBC_ERROR_NOT_ALLOW)
+            PendingCancelled = 1;
+    }
+
+public:
+    bool IsDone() const
+    {
+        return _done != 0;
+    }
+
+    int GetFinished() const
+    {
+        return _finished;
+    }
+
+    int GetErrors() const
+    {
+        return _errors;
+    }
+
+    bool IsTimeoutOk() const
+    {
+        return _timeoutOk;
+    }
+
+    bool IsDecodeFailOk() const
+    {
+        return _decodeFailOk;
+    }
+
+    bool IsResultOk() const
+    {
+        return _resultOk;
+    }
+
+    int GetResultCoroId() const
+    {
+        return _resultCoroId;
+    }
+
+    int GetCoroCountAfterFinished() const
+    {
+        return _coroCountAfterFinished;
+    }
+
+    std::vector<sint64> &GetLatencies()
+    {
+        return _latencies;
+    }
+
+private:
+    const int _coroCount;
+    const int _requestCount;
+    volatile int _sessionId;
+    int _badDecodeSessionId;
+    sint64 _nextCorrelationId;
+    bool _launched;
+
+    volatile int _finished;
+    volatile int _errors;
+    volatile bool _timeoutOk;
+    volatile bool _decodeFailOk;
+    volatile bool _resultOk;
+    volatile int _resultCoroId;
+    volatile int _coroCountAfterFinished;
+    volatile int _done;
+    std::vector<sint64> _latencies;
+};
+
+/**
+ * Post result to client coroutine in other thread.
+ */
+int PostResultProc(void *arg)
+{
+    CliFacade *facade = reinterpret_cast<CliFacade *>(arg);
+
+    const sint64 begTime = LLBC_GetMilliSeconds();
+    while (facade->GetResultCoroId() == 0 &&
+        LLBC_GetMilliSeconds() - begTime < 5000)
+        LLBC_Sleep(1);
+
+    LLBC_Sleep(20);
+    facade->GetService()->PostCoroResult(facade->GetResultCoroId(), &PostedResult);
+
+    return 0;
+}
+
+}
+
+TestCase_Comm_Coro::TestCase_Comm_Coro()
+: _runIp("127.0.0.1")
+, _runPort(7788)
+
+, _coroCount(100)
+, _requestCount(20)
+{
+}
+
+TestCase_Comm_Coro::~TestCase_Comm_Coro()
+{
+}
+
+int TestCase_Comm_Coro::Run(int argc, char *argv[])
+{
+    LLBC_PrintLine("Service coroutine test:");
+    LLBC_PrintLine("  usage: ./a [ip] [port] [coroCount] [requestCount]");
+
+    FetchArgs(argc, argv);
+
+    if (DesignHeader() != LLBC_OK)
+        return LLBC_FAILED;
+
+    return RunRpcs();
+}
+
+void TestCase_Comm_Coro::FetchArgs(int argc, char *argv[])
+{
+    if (argc > 1)
+        _runIp = argv[1];
+    if (argc > 2)
+        _runPort = LLBC_Str2Int32(argv[2]);
+    if (argc > 3)
+        _coroCount = MAX(LLBC_Str2Int32(argv[3]), 1);
+    if (argc > 4)
+        _requestCount = MAX(LLBC_Str2Int32(argv[4]), 1);
+}
+
+int TestCase_Comm_Coro::DesignHeader()
+{
+    LLBC_PacketHeaderDesc *headerDesc = LLBC_LibPacketHeaderLayout::BuildDesc();
+    headerDesc->AddPartDesc()
+        .SetSerialNo(CORRELATION_PART)
+        .SetPartLen(sizeof(sint64))
+        .Done();
+
+    if (LLBC_IService::SetPacketHeaderDesc(headerDesc) != LLBC_OK)
+    {
+        LLBC_FilePrintLine(stderr, "Set packet header describe failed, err: %s", LLBC_FormatLastError());
+        LLBC_Delete(headerDesc);
+
+        return LLBC_FAILED;
+    }
+
+    return LLBC_OK;
+}
+
+int TestCase_Comm_Coro::RunRpcs()
+{
+    // Server, the handlers run in coroutine.
+    LLBC_IService *svr = LLBC_IService::Create(LLBC_IService::Normal, "CoroSvr");
+    SvrFacade *svrFacade = LLBC_New(SvrFacade);
+    svr->RegisterFacade(svrFacade);
+    svr->SubscribeCoro(QUERY_OPCODE, svrFacade, &SvrFacade::OnQuery);
+    svr->SubscribeCoro(DROP_OPCODE, svrFacade, &SvrFacade::OnDrop);
+    svr->SubscribeCoro(BAD_DECODE_OPCODE, svrFacade, &SvrFacade::OnBadDecode);
+    svr->SuppressCoderNotFoundWarning();
+    svr->SetDriveMode(LLBC_IService::EventDrive);
+    if (svr->Start(1) != LLBC_OK ||
+        svr->Listen(_runIp.c_str(), _runPort) == 0)
+    {
+        LLBC_FilePrintLine(stderr, "Start server service failed, err: %s", LLBC_FormatLastError());
+        LLBC_Delete(svr);
+
+        return LLBC_FAILED;
+    }
+
+    // Client, the response packets resume awaiting coroutines.
+    LLBC_IService *cli = LLBC_IService::Create(LLBC_IService::Normal, "CoroCli");
+    CliFacade *cliFacade = LLBC_New2(CliFacade, _coroCount, _requestCount);
+    cli->RegisterFacade(cliFacade);
+    cli->RegisterCoder(BAD_DECODE_OPCODE, LLBC_New(BadDecodeCoderFactory));
+    cli->SuppressCoderNotFoundWarning();
+    cli->SetDriveMode(LLBC_IService::EventDrive);
+    cli->SetCoroCorrelationPart(CORRELATION_PART);
+    cli->Start(1);
+
+    const int sessionId = cli->Connect(_runIp.c_str(), _runPort);
+    const int badDecodeSessionId = cli->Connect(_runIp.c_str(), _runPort);
+    if (sessionId == 0 || badDecodeSessionId == 0)
+    {
+        LLBC_FilePrintLine(stderr, "Connect to server failed, err: %s", LLBC_FormatLastError());
+        LLBC_Delete(cli);
+        LLBC_Delete(svr);
+
+        return LLBC_FAILED;
+    }
+
+    // Go() not in service thread will fail.
+    const bool goOutOk = cli->Go(cliFacade, &CliFacade::RunPending) == 0;
+
+    LLBC_Handle postThreadGroup = LLBC_ThreadManagerSingleton->CreateThreads(1, &PostResultProc, cliFacade);
+
+    const sint64 begTime = LLBC_GetMicroSeconds();
+    cliFacade->SetSessionIds(sessionId, badDecodeSessionId);
+    while (!cliFacade->IsDone() &&
+        LLBC_GetMicroSeconds() - begTime < 60000000)
+        LLBC_Sleep(1);
+    const sint64 elapsed = MAX(LLBC_GetMicroSeconds() - begTime, 1);
+
+    LLBC_ThreadManagerSingleton->WaitGroup(postThreadGroup);
+
+    sint64 p50 = 0, p99 = 0;
+    std::vector<sint64> &latencies = cliFacade->GetLatencies();
+    if (!latencies.empty())
+    {
+        std::sort(latencies.begin(), latencies.end());
+        p50 = latencies[latencies.size() / 2];
+        p99 = latencies[MIN(latencies.size() * 99 / 100, latencies.size() - 1)];
+    }
+
+    const int rpcCount = static_cast<int>(latencies.size());
+    const bool done = cliFacade->IsDone();
+    const int finished = cliFacade->GetFinished();
+    const int cliErrors = cliFacade->GetErrors();
+    const bool timeoutOk = cliFacade->IsTimeoutOk();
+    const bool decodeFailOk = cliFacade->IsDecodeFailOk();
+    const bool resultOk = cliFacade->IsResultOk();
+    const int coroCountAfterFinished = cliFacade->GetCoroCountAfterFinished();
+    const int queries = svrFacade->GetQueries();
+    const int svrErrors = svrFacade->GetErrors();
+
+    // Stop client, the pending coroutine will be cancelled.
+    LLBC_Delete(cli);
+    LLBC_Delete(svr);
+
+    LLBC_PrintLine("[rpc] coroutines: %d, requests per coroutine: %d, rpcs: %d, server queries: %d, "
+                   "elapsed: %.3f ms, rpc latency p50: %lld us, p99: %lld us",
+                   _coroCount,
+                   _requestCount,
+                   rpcCount,
+                   queries,
+                   elapsed / 1000.0,
+                   p50,
+                   p99);
+    LLBC_PrintLine("[rpc] finished coroutines: %d, errors(client/server): %d/%d, await timeout: %s, "
+                   "await decode failed: %s, posted result: %s, alive coroutines after finished: %d, pending coroutine cancelled: %s, "
+                   "go out of service thread: %s",
+                   finished,
+                   cliErrors,
+                   svrErrors,
+                   timeoutOk ? "ok" : "bad",
+                   decodeFailOk ? "ok" : "bad",
+                   resultOk ? "ok" : "bad",
+                   coroCountAfterFinished,
+                   PendingCancelled ? "yes" : "no",
+                   goOutOk ? "failed(ok)" : "succeed(bad)");
+
+    return done &&
+           rpcCount == _coroCount * _requestCount &&
+           cliErrors == 0 &&
+           svrErrors == 0 &&
+           timeoutOk &&
+           decodeFailOk &&
+           resultOk &&
+           coroCountAfterFinished == 1 &&
+           PendingCancelled &&
+           goOutOk ? LLBC_OK : LLBC_FAILED;
+}
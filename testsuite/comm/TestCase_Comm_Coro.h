@@ -0,0 +1,48 @@
+/**
+ * @file    TestCase_Comm_Coro.h
+ * @author  Longwei Lai<lailongwei@126.com>
+ * @date    2026/10/18
+ * @version 1.0
+ *
+ * @brief   The llbc library service coroutine(RPC-style request/response) test case.
+ */
+#ifndef __LLBC_TEST_CASE_COMM_CORO_H__
+#define __LLBC_TEST_CASE_COMM_CORO_H__
+
+#include "llbc.h"
+using namespace llbc;
+
+class TestCase_Comm_Coro : public LLBC_BaseTestCase
+{
+public:
+    TestCase_Comm_Coro();
+    virtual ~TestCase_Comm_Coro();
+
+public:
+    virtual int Run(int argc, char *argv[]);
+
+private:
+    void FetchArgs(int argc, char *argv[]);
+
+    /**
+     * Design packet header, append the correlation part to library header layout.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    int DesignHeader();
+
+    /**
+     * Run coroutine RPCs, client coroutines send requests and await responses, server coroutine
+     * handlers await timer(simulate async db query) before response.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    int RunRpcs();
+
+private:
+    LLBC_String _runIp;
+    int _runPort;
+
+    int _coroCount;
+    int _requestCount;
+};
+
+#endif // !__LLBC_TEST_CASE_COMM_CORO_H__
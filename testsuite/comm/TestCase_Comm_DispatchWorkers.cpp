@@ -0,0 +1,348 @@
+/**
+ * @file    TestCase_Comm_DispatchWorkers.cpp
+ * @author  Longwei Lai<lailongwei@126.com>
+ * @date    2026/10/18
+ * @version 1.0
+ *
+ * @brief
+ */
+
+#include "comm/TestCase_Comm_DispatchWorkers.h"
+
+namespace
+{
+
+const int ECHO_OPCODE = 1;
+const int MAIN_OPCODE = 2;
+
+/**
+ * The packet payload, client index used to check per-session order.
+ */
+struct Payload
+{
+    int clientIdx;
+    int seq;
+};
+
+class SvrFacade : public LLBC_IFacade
+{
+public:
+    SvrFacade(int sessionCount, int handleCost)
+    : _handleCost(handleCost)
+    , _nextSeqs(sessionCount, 0)
+    , _disorders(0)
+    , _mainErrors(0)
+
+    , _threadTagsCount(0)
+    , _svcThreadTag(0)
+    {
+    }
+
+public:
+    virtual void OnUpdate()
+    {
+        _svcThreadTag = GetThreadTag();
+    }
+
+public:
+    void OnEcho(LLBC_Packet &packet)
+    {
+        // Session-local handler only access the session's states, no lock required.
+        Payload payload;
+        ::memcpy(&payload, packet.GetPayload(), sizeof(payload));
+        if (payload.seq != _nextSeqs[payload.clientIdx])
+            _disorders += 1;
+        _nextSeqs[payload.clientIdx] = payload.seq + 1;
+
+        // Simulate cpu-heavy handler.
+        volatile uint32 hash = payload.seq;
+        for (int i = 0; i < _handleCost; i++)
+            hash = hash * 31 + i;
+
+        const int threadTag = GetThreadTag();
+        _lock.Lock();
+        _echoThreadTags.insert(threadTag);
+        _lock.Unlock();
+
+        GetService()->Send(packet.GetSessionId(), ECHO_OPCODE, &payload, sizeof(payload), 0);
+    }
+
+    void OnMain(LLBC_Packet &packet)
+    {
+        // Not session-local opcode packet always handled in service thread.
+        if (_svcThreadTag != 0 && GetThreadTag() != _svcThreadTag)
+            _mainErrors += 1;
+
+        GetService()->Send(packet.GetSessionId(), MAIN_OPCODE, packet.GetPayload(), packet.GetPayloadLength(), 0);
+    }
+
+public:
+    int GetDisorders() const
+    {
+        return _disorders;
+    }
+
+    int GetMainErrors() const
+    {
+        return _mainErrors;
+    }
+
+    int GetSvcThreadTag() const
+    {
+        return _svcThreadTag;
+    }
+
+    std::set<int> GetEchoThreadTags()
+    {
+        LLBC_Guard guard(_lock);
+        return _echoThreadTags;
+    }
+
+private:
+    /**
+     * Get current thread tag, every thread allocate unique tag when first call.
+     */
+    int GetThreadTag()
+    {
+        char *tag = _threadTags.GetValue();
+        if (tag)
+            return static_cast<int>(reinterpret_cast<size_t>(tag));
+
+        _lock.Lock();
+        const int newTag = ++_threadTagsCount;
+        _lock.Unlock();
+
+        _threadTags.SetValue(reinterpret_cast<char *>(static_cast<size_t>(newTag)));
+
+        return newTag;
+    }
+
+private:
+    const int _handleCost;
+    std::vector<int> _nextSeqs;
+    volatile int _disorders;
+    volatile int _mainErrors;
+
+    LLBC_SpinLock _lock;
+    LLBC_Tls<char> _threadTags;
+    int _threadTagsCount;
+    volatile int _svcThreadTag;
+    std::set<int> _echoThreadTags;
+};
+
+class CliFacade : public LLBC_IFacade
+{
+public:
+    CliFacade(int sessionCount)
+    : _nextSeqs(sessionCount, 0)
+    , _echoed(0)
+    , _mainEchoed(0)
+    , _disorders(0)
+    {
+    }
+
+public:
+    void OnEcho(LLBC_Packet &packet)
+    {
+        Payload payload;
+        ::memcpy(&payload, packet.GetPayload(), sizeof(payload));
+        if (payload.seq != _nextSeqs[payload.clientIdx])
+            _disorders += 1;
+        _nextSeqs[payload.clientIdx] = payload.seq + 1;
+
+        _echoed += 1;
+    }
+
+    void OnMain(LLBC_Packet &packet)
+    {
+        _mainEchoed += 1;
+    }
+
+public:
+    int GetEchoed() const
+    {
+        return _echoed;
+    }
+
+    int GetMainEchoed() const
+    {
+        return _mainEchoed;
+    }
+
+    int GetDisorders() const
+    {
+        return _disorders;
+    }
+
+private:
+    std::vector<int> _nextSeqs;
+    volatile int _echoed;
+    volatile int _mainEchoed;
+    volatile int _disorders;
+};
+
+}
+
+TestCase_Comm_DispatchWorkers::TestCase_Comm_DispatchWorkers()
+: _runIp("127.0.0.1")
+, _runPort(7788)
+
+, _workerCount(4)
+, _sessionCount(8)
+, _packetCount(2000)
+, _handleCost(20000)
+{
+}
+
+TestCase_Comm_DispatchWorkers::~TestCase_Comm_DispatchWorkers()
+{
+}
+
+int TestCase_Comm_DispatchWorkers::Run(int argc, char *argv[])
+{
+    LLBC_PrintLine("Service session-affine dispatch workers test:");
+    LLBC_PrintLine("  usage: ./a [ip] [port] [workerCount] [sessionCount] [packetCount] [handleCost]");
+
+    FetchArgs(argc, argv);
+
+    sint64 svcThreadElapsed, workersElapsed;
+    if (RunEcho(_runPort, 0, svcThreadElapsed) != LLBC_OK ||
+        RunEcho(_runPort + 1, _workerCount, workersElapsed) != LLBC_OK)
+        return LLBC_FAILED;
+
+    LLBC_PrintLine("[compare] service thread elapsed: %.3f ms, %d workers elapsed: %.3f ms, speedup: %.2fx",
+                   svcThreadElapsed / 1000.0,
+                   _workerCount,
+                   workersElapsed / 1000.0,
+                   svcThreadElapsed / static_cast<double>(workersElapsed));
+
+    return LLBC_OK;
+}
+
+void TestCase_Comm_DispatchWorkers::FetchArgs(int argc, char *argv[])
+{
+    if (argc > 1)
+        _runIp = argv[1];
+    if (argc > 2)
+        _runPort = LLBC_Str2Int32(argv[2]);
+    if (argc > 3)
+        _workerCount = MAX(LLBC_Str2Int32(argv[3]), 1);
+    if (argc > 4)
+        _sessionCount = MAX(LLBC_Str2Int32(argv[4]), 1);
+    if (argc > 5)
+        _packetCount = MAX(LLBC_Str2Int32(argv[5]), 1);
+    if (argc > 6)
+        _handleCost = MAX(LLBC_Str2Int32(argv[6]), 0);
+}
+
+int TestCase_Comm_DispatchWorkers::RunEcho(int port, int workerCount, sint64 &elapsed)
+{
+    elapsed = 0;
+
+    LLBC_IService *svr = LLBC_IService::Create(LLBC_IService::Normal, "DispatchWorkersSvr");
+    SvrFacade *svrFacade = LLBC_New2(SvrFacade, _sessionCount, _handleCost);
+    svr->RegisterFacade(svrFacade);
+    svr->Subscribe(ECHO_OPCODE, svrFacade, &SvrFacade::OnEcho);
+    svr->Subscribe(MAIN_OPCODE, svrFacade, &SvrFacade::OnMain);
+    svr->SuppressCoderNotFoundWarning();
+    svr->SetOpcodeSessionLocal(ECHO_OPCODE);
+    svr->SetDispatchWorkers(workerCount);
+    if (svr->Start(1) != LLBC_OK ||
+        svr->Listen(_runIp.c_str(), port) == 0)
+    {
+        LLBC_FilePrintLine(stderr, "Start server service failed, err: %s", LLBC_FormatLastError());
+        LLBC_Delete(svr);
+
+        return LLBC_FAILED;
+    }
+
+    // After started, dispatch workers can't be changed.
+    if (svr->SetDispatchWorkers(workerCount + 1) == LLBC_OK ||
+        svr->SetOpcodeSessionLocal(MAIN_OPCODE) == LLBC_OK)
+    {
+        LLBC_FilePrintLine(stderr, "Set dispatch workers after service started not failed");
+        LLBC_Delete(svr);
+
+        return LLBC_FAILED;
+    }
+
+    LLBC_IService *cli = LLBC_IService::Create(LLBC_IService::Normal, "DispatchWorkersCli");
+    CliFacade *cliFacade = LLBC_New1(CliFacade, _sessionCount);
+    cli->RegisterFacade(cliFacade);
+    cli->Subscribe(ECHO_OPCODE, cliFacade, &CliFacade::OnEcho);
+    cli->Subscribe(MAIN_OPCODE, cliFacade, &CliFacade::OnMain);
+    cli->SuppressCoderNotFoundWarning();
+    cli->Start(1);
+
+    std::vector<int> sessionIds;
+    for (int i = 0; i < _sessionCount; i++)
+    {
+        const int sessionId = cli->Connect(_runIp.c_str(), port);
+        if (sessionId == 0)
+        {
+            LLBC_FilePrintLine(stderr, "Connect to server failed, err: %s", LLBC_FormatLastError());
+            LLBC_Delete(cli);
+            LLBC_Delete(svr);
+
+            return LLBC_FAILED;
+        }
+
+        sessionIds.push_back(sessionId);
+    }
+
+    // All sessions send sequenced packets interleaved, and mix main thread opcode packets.
+    const sint64 begTime = LLBC_GetMicroSeconds();
+    for (int seq = 0; seq < _packetCount; seq++)
+    {
+        for (int i = 0; i < _sessionCount; i++)
+        {
+            Payload payload = {i, seq};
+            cli->Send(sessionIds[i], ECHO_OPCODE, &payload, sizeof(payload), 0);
+            if (seq % 100 == 0)
+                cli->Send(sessionIds[i], MAIN_OPCODE, &payload, sizeof(payload), 0);
+        }
+    }
+
+    const int totalPackets = _sessionCount * _packetCount;
+    const int totalMainPackets = _sessionCount * ((_packetCount + 99) / 100);
+    const sint64 waitBegTime = LLBC_GetMilliSeconds();
+    while ((cliFacade->GetEchoed() < totalPackets || cliFacade->GetMainEchoed() < totalMainPackets) &&
+        LLBC_GetMilliSeconds() - waitBegTime < 60000)
+        LLBC_Sleep(1);
+
+    elapsed = MAX(LLBC_GetMicroSeconds() - begTime, 1);
+
+    // Session-local packets must be handled in workers when workers enabled(sessions spread over
+    // multi workers), otherwise in service thread.
+    const std::set<int> echoThreadTags = svrFacade->GetEchoThreadTags();
+    const bool inSvcThread = echoThreadTags.find(svrFacade->GetSvcThreadTag()) != echoThreadTags.end();
+    const bool threadsOk = workerCount == 0 ?
+        (echoThreadTags.size() == 1 && inSvcThread) :
+        (!inSvcThread && (MIN(workerCount, _sessionCount) == 1 || echoThreadTags.size() > 1));
+
+    LLBC_PrintLine("[echo] workers: %d, sessions: %d, packets: %d/%d, main packets: %d/%d, elapsed: %.3f ms, "
+                   "handle threads: %lu, disorders(server/client): %d/%d, main thread errors: %d",
+                   workerCount,
+                   _sessionCount,
+                   cliFacade->GetEchoed(),
+                   totalPackets,
+                   cliFacade->GetMainEchoed(),
+                   totalMainPackets,
+                   elapsed / 1000.0,
+                   echoThreadTags.size(),
+                   svrFacade->GetDisorders(),
+                   cliFacade->GetDisorders(),
+                   svrFacade->GetMainErrors());
+
+    const bool succeed = cliFacade->GetEchoed() == totalPackets &&
+                         cliFacade->GetMainEchoed() == totalMainPackets &&
+                         svrFacade->GetDisorders() == 0 &&
+                         cliFacade->GetDisorders() == 0 &&
+                         svrFacade->GetMainErrors() == 0 &&
+                         threadsOk;
+
+    LLBC_Delete(cli);
+    LLBC_Delete(svr);
+
+    return succeed ? LLBC_OK : LLBC_FAILED;
+}
@@ -0,0 +1,46 @@
+/**
+ * @file    TestCase_Comm_DispatchWorkers.h
+ * @author  Longwei Lai<lailongwei@126.com>
+ * @date    2026/10/18
+ * @version 1.0
+ *
+ * @brief   The llbc library service session-affine dispatch workers test case.
+ */
+#ifndef __LLBC_TEST_CASE_COMM_DISPATCH_WORKERS_H__
+#define __LLBC_TEST_CASE_COMM_DISPATCH_WORKERS_H__
+
+#include "llbc.h"
+using namespace llbc;
+
+class TestCase_Comm_DispatchWorkers : public LLBC_BaseTestCase
+{
+public:
+    TestCase_Comm_DispatchWorkers();
+    virtual ~TestCase_Comm_DispatchWorkers();
+
+public:
+    virtual int Run(int argc, char *argv[]);
+
+private:
+    void FetchArgs(int argc, char *argv[]);
+
+    /**
+     * Run echo with given dispatch workers count, all sessions send sequenced packets concurrently.
+     * @param[in]  port        - the listen port.
+     * @param[in]  workerCount - the server service dispatch workers count.
+     * @param[out] elapsed     - the elapsed time, in micro-seconds.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    int RunEcho(int port, int workerCount, sint64 &elapsed);
+
+private:
+    LLBC_String _runIp;
+    int _runPort;
+
+    int _workerCount;
+    int _sessionCount;
+    int _packetCount;
+    int _handleCost;
+};
+
+#endif // !__LLBC_TEST_CASE_COMM_DISPATCH_WORKERS_H__
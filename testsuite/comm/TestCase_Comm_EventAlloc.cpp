@@ -0,0 +1,192 @@
+/**
+ * @file    TestCase_Comm_EventAlloc.cpp
+ * @author  Longwei Lai<lailongwei@126.com>
+ * @date    2026/10/18
+ * @version 1.0
+ *
+ * @brief
+ */
+
+#include "comm/TestCase_Comm_EventAlloc.h"
+
+#if __cplusplus >= 201103L
+ #define __EVALLOC_THROW_BAD_ALLOC
+ #define __EVALLOC_NO_THROW noexcept
+#else
+ #define __EVALLOC_THROW_BAD_ALLOC throw(std::bad_alloc)
+ #define __EVALLOC_NO_THROW throw()
+#endif
+
+namespace
+{
+
+// The heap allocation counter, only count when counting flag set.
+volatile bool __counting = false;
+volatile sint64 __allocCount = 0;
+
+const int OPCODE = 1;
+
+class SvrFacade : public LLBC_IFacade
+{
+public:
+    SvrFacade()
+    : _recved(0)
+    {
+    }
+
+public:
+    void OnRecv(LLBC_Packet &packet)
+    {
+        ++_recved;
+    }
+
+    int GetRecved() const
+    {
+        return _recved;
+    }
+
+private:
+    int _recved;
+};
+
+class CliFacade : public LLBC_IFacade
+{
+};
+
+}
+
+// Replace global allocation functions, count all heap allocations which through operator new
+// (service/poller events, message blocks, packets, ...) in whole process.
+void *operator new(size_t size) __EVALLOC_THROW_BAD_ALLOC
+{
+    if (__counting)
+        LLBC_AtomicFetchAndAdd(&__allocCount, 1);
+
+    void *p = malloc(size != 0 ? size : 1);
+    if (UNLIKELY(!p))
+        throw std::bad_alloc();
+
+    return p;
+}
+
+void operator delete(void *p) __EVALLOC_NO_THROW
+{
+    free(p);
+}
+
+TestCase_Comm_EventAlloc::TestCase_Comm_EventAlloc()
+: _runIp("127.0.0.1")
+, _runPort(7788)
+
+, _packetCount(300000)
+, _windowSize(256)
+{
+}
+
+TestCase_Comm_EventAlloc::~TestCase_Comm_EventAlloc()
+{
+}
+
+int TestCase_Comm_EventAlloc::Run(int argc, char *argv[])
+{
+    LLBC_PrintLine("Service/Poller event allocation count benchmark:");
+    LLBC_PrintLine("  usage: ./a [ip] [port] [packetCount] [windowSize]");
+
+    FetchArgs(argc, argv);
+
+    // Create server service.
+    LLBC_IService *svr = LLBC_IService::Create(LLBC_IService::Normal, "EventAllocSvr");
+    SvrFacade *svrFacade = LLBC_New(SvrFacade);
+    svr->RegisterFacade(svrFacade);
+    svr->Subscribe(OPCODE, svrFacade, &SvrFacade::OnRecv);
+    svr->SuppressCoderNotFoundWarning();
+    svr->SetDriveMode(LLBC_IService::ExternalDrive);
+    if (svr->Start(1) != LLBC_OK ||
+        svr->Listen(_runIp.c_str(), static_cast<uint16>(_runPort)) == 0)
+    {
+        LLBC_FilePrintLine(stderr, "Start server service failed, err: %s", LLBC_FormatLastError());
+        LLBC_Delete(svr);
+
+        return LLBC_FAILED;
+    }
+
+    // Create client service and connect to server.
+    LLBC_IService *cli = LLBC_IService::Create(LLBC_IService::Normal, "EventAllocCli");
+    cli->RegisterFacade(LLBC_New(CliFacade));
+    cli->SuppressCoderNotFoundWarning();
+    cli->SetDriveMode(LLBC_IService::ExternalDrive);
+    cli->Start(1);
+
+    const int sessionId = cli->Connect(_runIp.c_str(), static_cast<uint16>(_runPort));
+    if (sessionId == 0)
+    {
+        LLBC_FilePrintLine(stderr, "Connect to server failed, err: %s", LLBC_FormatLastError());
+        LLBC_Delete(cli);
+        LLBC_Delete(svr);
+
+        return LLBC_FAILED;
+    }
+
+    // Send packets window by window, every window drive both services until all packets handled
+    // by server, the first window use to warm up(not count).
+    int sent = 0;
+    sint64 begTime = 0;
+    const int totalCount = _packetCount + _windowSize;
+    while (sent < totalCount)
+    {
+        if (sent == _windowSize)
+        {
+            LLBC_AtomicSet(&__allocCount, 0);
+            __counting = true;
+            begTime = LLBC_GetMicroSeconds();
+        }
+
+        const int windowEnd = MIN(sent + _windowSize, totalCount);
+        for (; sent < windowEnd; sent++)
+            cli->Send(sessionId, OPCODE, &sent, sizeof(sent), 0);
+
+        const sint64 waitBegTime = LLBC_GetMilliSeconds();
+        while (svrFacade->GetRecved() < windowEnd &&
+               LLBC_GetMilliSeconds() - waitBegTime < 5000)
+        {
+            cli->OnSvc(false);
+            svr->OnSvc(false);
+        }
+
+        if (svrFacade->GetRecved() < windowEnd)
+            break;
+    }
+
+    __counting = false;
+    const sint64 elapsed = MAX(LLBC_GetMicroSeconds() - begTime, 1);
+    const sint64 allocCount = LLBC_AtomicGet(&__allocCount);
+
+    const int handled = svrFacade->GetRecved() - _windowSize;
+    LLBC_PrintLine("packets: %d/%d, window: %d, elapsed: %.3f ms, throughput: %.0f packets/s",
+                   handled,
+                   _packetCount,
+                   _windowSize,
+                   elapsed / 1000.0,
+                   handled * 1000000.0 / elapsed);
+    LLBC_PrintLine("heap allocations(operator new): %lld, per packet(send + recv): %.2f, per second: %.0f",
+                   allocCount,
+                   static_cast<double>(allocCount) / MAX(handled, 1),
+                   allocCount * 1000000.0 / elapsed);
+
+    LLBC_Delete(cli);
+    LLBC_Delete(svr);
+
+    return handled == _packetCount ? LLBC_OK : LLBC_FAILED;
+}
+
+void TestCase_Comm_EventAlloc::FetchArgs(int argc, char *argv[])
+{
+    if (argc > 1)
+        _runIp = argv[1];
+    if (argc > 2)
+        _runPort = LLBC_Str2Int32(argv[2]);
+    if (argc > 3)
+        _packetCount = MAX(LLBC_Str2Int32(argv[3]), 1);
+    if (argc > 4)
+        _windowSize = MAX(LLBC_Str2Int32(argv[4]), 1);
+}
@@ -0,0 +1,35 @@
+/**
+ * @file    TestCase_Comm_EventAlloc.h
+ * @author  Longwei Lai<lailongwei@126.com>
+ * @date    2026/10/18
+ * @version 1.0
+ *
+ * @brief   The llbc library service/poller event allocation count benchmark test case.
+ */
+#ifndef __LLBC_TEST_CASE_COMM_EVENT_ALLOC_H__
+#define __LLBC_TEST_CASE_COMM_EVENT_ALLOC_H__
+
+#include "llbc.h"
+using namespace llbc;
+
+class TestCase_Comm_EventAlloc : public LLBC_BaseTestCase
+{
+public:
+    TestCase_Comm_EventAlloc();
+    virtual ~TestCase_Comm_EventAlloc();
+
+public:
+    virtual int Run(int argc, char *argv[]);
+
+private:
+    void FetchArgs(int argc, char *argv[]);
+
+private:
+    LLBC_String _runIp;
+    int _runPort;
+
+    int _packetCount;
+    int _windowSize;
+};
+
+#endif // !__LLBC_TEST_CASE_COMM_EVENT_ALLOC_H__
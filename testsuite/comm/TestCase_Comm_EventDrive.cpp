@@ -0,0 +1,232 @@
+/**
+ * @file    TestCase_Comm_EventDrive.cpp
+ * @author  Longwei Lai<lailongwei@126.com>
+ * @date    2026/10/18
+ * @version 1.0
+ *
+ * @brief
+ */
+
+#include "comm/TestCase_Comm_EventDrive.h"
+
+namespace
+{
+
+const int PING_OPCODE = 1;
+
+const char *GetDriveModeName(LLBC_IService::DriveMode driveMode)
+{
+    if (driveMode == LLBC_IService::SelfDrive)
+        return "SelfDrive";
+    else if (driveMode == LLBC_IService::EventDrive)
+        return "EventDrive";
+    else
+        return "ExternalDrive";
+}
+
+class SvrFacade : public LLBC_IFacade
+{
+public:
+    SvrFacade()
+    : _updates(0)
+    {
+    }
+
+public:
+    virtual void OnUpdate()
+    {
+        _updates += 1;
+    }
+
+public:
+    void OnPing(LLBC_Packet &packet)
+    {
+        GetService()->Send(packet.GetSessionId(),
+                           packet.GetOpcode(),
+                           packet.GetPayload(),
+                           packet.GetPayloadLength(),
+                           0);
+    }
+
+    int GetUpdates() const
+    {
+        return _updates;
+    }
+
+private:
+    volatile int _updates;
+};
+
+class CliFacade : public LLBC_IFacade
+{
+public:
+    CliFacade(int pingCount)
+    : _pingCount(pingCount)
+    , _ponged(0)
+    {
+        _latencies.reserve(pingCount);
+    }
+
+public:
+    void Ping(int sessionId)
+    {
+        const sint64 now = LLBC_GetMicroSeconds();
+        GetService()->Send(sessionId, PING_OPCODE, &now, sizeof(now), 0);
+    }
+
+    void OnPong(LLBC_Packet &packet)
+    {
+        sint64 pingTime;
+        ::memcpy(&pingTime, packet.GetPayload(), sizeof(pingTime));
+        _latencies.push_back(LLBC_GetMicroSeconds() - pingTime);
+
+        // Ping next, until reach ping count.
+        if (static_cast<int>(_latencies.size()) < _pingCount)
+            Ping(packet.GetSessionId());
+        else
+            _ponged = 1;
+    }
+
+public:
+    bool IsPonged() const
+    {
+        return _ponged != 0;
+    }
+
+    std::vector<sint64> &GetLatencies()
+    {
+        return _latencies;
+    }
+
+private:
+    const int _pingCount;
+    volatile int _ponged;
+    std::vector<sint64> _latencies;
+};
+
+}
+
+TestCase_Comm_EventDrive::TestCase_Comm_EventDrive()
+: _runIp("127.0.0.1")
+, _runPort(7788)
+
+, _pingCount(200)
+, _fps(LLBC_CFG_COMM_DFT_SERVICE_FPS)
+{
+}
+
+TestCase_Comm_EventDrive::~TestCase_Comm_EventDrive()
+{
+}
+
+int TestCase_Comm_EventDrive::Run(int argc, char *argv[])
+{
+    LLBC_PrintLine("Event-drive service test:");
+    LLBC_PrintLine("  usage: ./a [ip] [port] [pingCount] [fps]");
+
+    FetchArgs(argc, argv);
+
+    sint64 selfP50, selfP99, eventP50, eventP99;
+    if (RunPingPong(_runPort, LLBC_IService::SelfDrive, selfP50, selfP99) != LLBC_OK ||
+        RunPingPong(_runPort + 1, LLBC_IService::EventDrive, eventP50, eventP99) != LLBC_OK)
+        return LLBC_FAILED;
+
+    LLBC_PrintLine("[compare] p50 speedup: %.1fx, p99 speedup: %.1fx(target >= 10x)",
+                   selfP50 / static_cast<double>(MAX(eventP50, 1)),
+                   selfP99 / static_cast<double>(MAX(eventP99, 1)));
+
+    return eventP50 < selfP50 && eventP99 < selfP99 ? LLBC_OK : LLBC_FAILED;
+}
+
+void TestCase_Comm_EventDrive::FetchArgs(int argc, char *argv[])
+{
+    if (argc > 1)
+        _runIp = argv[1];
+    if (argc > 2)
+        _runPort = LLBC_Str2Int32(argv[2]);
+    if (argc > 3)
+        _pingCount = MAX(LLBC_Str2Int32(argv[3]), 1);
+    if (argc > 4)
+        _fps = MAX(LLBC_Str2Int32(argv[4]), 1);
+}
+
+int TestCase_Comm_EventDrive::RunPingPong(int port, LLBC_IService::DriveMode driveMode, sint64 &p50, sint64 &p99)
+{
+    p50 = p99 = 0;
+
+    LLBC_IService *svr = LLBC_IService::Create(LLBC_IService::Normal, "EventDriveSvr");
+    SvrFacade *svrFacade = LLBC_New(SvrFacade);
+    svr->RegisterFacade(svrFacade);
+    svr->Subscribe(PING_OPCODE, svrFacade, &SvrFacade::OnPing);
+    svr->SuppressCoderNotFoundWarning();
+    svr->SetDriveMode(driveMode);
+    svr->SetFPS(_fps);
+    if (svr->Start(1) != LLBC_OK ||
+        svr->Listen(_runIp.c_str(), port) == 0)
+    {
+        LLBC_FilePrintLine(stderr, "Start server service failed, err: %s", LLBC_FormatLastError());
+        LLBC_Delete(svr);
+
+        return LLBC_FAILED;
+    }
+
+    LLBC_IService *cli = LLBC_IService::Create(LLBC_IService::Normal, "EventDriveCli");
+    CliFacade *cliFacade = LLBC_New1(CliFacade, _pingCount);
+    cli->RegisterFacade(cliFacade);
+    cli->Subscribe(PING_OPCODE, cliFacade, &CliFacade::OnPong);
+    cli->SuppressCoderNotFoundWarning();
+    cli->SetDriveMode(driveMode);
+    cli->SetFPS(_fps);
+    cli->Start(1);
+
+    const int sessionId = cli->Connect(_runIp.c_str(), port);
+    if (sessionId == 0)
+    {
+        LLBC_FilePrintLine(stderr, "Connect to server failed, err: %s", LLBC_FormatLastError());
+        LLBC_Delete(cli);
+        LLBC_Delete(svr);
+
+        return LLBC_FAILED;
+    }
+
+    cliFacade->Ping(sessionId);
+
+    const sint64 begTime = LLBC_GetMilliSeconds();
+    while (!cliFacade->IsPonged() &&
+        LLBC_GetMilliSeconds() - begTime < 60000)
+        LLBC_Sleep(10);
+
+    // Idle one second, facades still update on frame cadence, and service not busy-spin.
+    const int begUpdates = svrFacade->GetUpdates();
+    const clock_t begClock = ::clock();
+    LLBC_Sleep(1000);
+    const int idleUpdates = svrFacade->GetUpdates() - begUpdates;
+    const double idleCpu = (::clock() - begClock) * 1000.0 / CLOCKS_PER_SEC;
+
+    const bool ponged = cliFacade->IsPonged();
+    if (ponged)
+    {
+        std::vector<sint64> &latencies = cliFacade->GetLatencies();
+        std::sort(latencies.begin(), latencies.end());
+        p50 = latencies[latencies.size() / 2];
+        p99 = latencies[MIN(latencies.size() * 99 / 100, latencies.size() - 1)];
+    }
+
+    LLBC_PrintLine("[ping-pong] drive mode: %-10s, fps: %d, pings: %d, latency p50: %lld us, p99: %lld us, "
+                   "idle 1s updates: %d, idle cpu: %.1f ms",
+                   GetDriveModeName(driveMode),
+                   _fps,
+                   _pingCount,
+                   p50,
+                   p99,
+                   idleUpdates,
+                   idleCpu);
+
+    LLBC_Delete(cli);
+    LLBC_Delete(svr);
+
+    // Update frequency deviation tolerance is 50%, idle cpu must less than 20% of one core.
+    return ponged &&
+           idleUpdates >= _fps / 2 && idleUpdates <= _fps * 3 / 2 + 1 &&
+           idleCpu < 200.0 ? LLBC_OK : LLBC_FAILED;
+}
@@ -0,0 +1,45 @@
+/**
+ * @file    TestCase_Comm_EventDrive.h
+ * @author  Longwei Lai<lailongwei@126.com>
+ * @date    2026/10/18
+ * @version 1.0
+ *
+ * @brief   The llbc library event-drive service test case.
+ */
+#ifndef __LLBC_TEST_CASE_COMM_EVENT_DRIVE_H__
+#define __LLBC_TEST_CASE_COMM_EVENT_DRIVE_H__
+
+#include "llbc.h"
+using namespace llbc;
+
+class TestCase_Comm_EventDrive : public LLBC_BaseTestCase
+{
+public:
+    TestCase_Comm_EventDrive();
+    virtual ~TestCase_Comm_EventDrive();
+
+public:
+    virtual int Run(int argc, char *argv[]);
+
+private:
+    void FetchArgs(int argc, char *argv[]);
+
+    /**
+     * Run ping-pong with given drive mode services, collect request round-trip latencies.
+     * @param[in]  port      - the listen port.
+     * @param[in]  driveMode - the server & client services drive mode.
+     * @param[out] p50       - the p50 latency, in micro-seconds.
+     * @param[out] p99       - the p99 latency, in micro-seconds.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    int RunPingPong(int port, LLBC_IService::DriveMode driveMode, sint64 &p50, sint64 &p99);
+
+private:
+    LLBC_String _runIp;
+    int _runPort;
+
+    int _pingCount;
+    int _fps;
+};
+
+#endif // !__LLBC_TEST_CASE_COMM_EVENT_DRIVE_H__
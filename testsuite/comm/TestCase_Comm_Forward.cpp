@@ -0,0 +1,330 @@
+/**
+ * @file    TestCase_Comm_Forward.cpp
+ * @author  Longwei Lai<lailongwei@126.com>
+ * @date    2026/10/18
+ * @version 1.0
+ *
+ * @brief
+ */
+
+#include "comm/TestCase_Comm_Forward.h"
+
+namespace
+{
+
+const int RELAY_OPCODE = 1;
+
+/**
+ * Build packet payload, payload begin with sequence, follow the sequence pattern.
+ */
+void BuildPayload(int seq, size_t size, std::vector<char> &payload)
+{
+    payload.resize(size);
+    ::memcpy(&payload[0], &seq, sizeof(seq));
+    for (size_t i = sizeof(seq); i < size; i++)
+        payload[i] = static_cast<char>((seq + i) % 251);
+}
+
+/**
+ * Check packet payload, return the sequence, if payload broken, return -1.
+ */
+int CheckPayload(const LLBC_Packet &packet)
+{
+    const size_t size = packet.GetPayloadLength();
+    if (size < sizeof(int))
+        return -1;
+
+    int seq;
+    const char *payload = reinterpret_cast<const char *>(packet.GetPayload());
+    ::memcpy(&seq, payload, sizeof(seq));
+    for (size_t i = sizeof(seq); i < size; i++)
+    {
+        if (payload[i] != static_cast<char>((seq + i) % 251))
+            return -1;
+    }
+
+    return seq;
+}
+
+class RelayFacade : public LLBC_IFacade
+{
+public:
+    RelayFacade(bool useForward)
+    : _useForward(useForward)
+    , _targetSvc(NULL)
+    , _targetSessionId(0)
+    , _peer(NULL)
+
+    , _relayed(0)
+    , _errors(0)
+    {
+    }
+
+public:
+    void SetTarget(LLBC_IService *targetSvc, int targetSessionId)
+    {
+        _targetSvc = targetSvc;
+        _targetSessionId = targetSessionId;
+    }
+
+    void SetPeer(RelayFacade *peer)
+    {
+        _peer = peer;
+    }
+
+public:
+    void OnRecv(LLBC_Packet &packet)
+    {
+        // The front facade relay packet to back service, and tell back facade the reply target.
+        if (_peer)
+            _peer->SetTarget(GetService(), packet.GetSessionId());
+
+        if (!_useForward)
+        {
+            if (_targetSvc->Send(_targetSessionId,
+                                 packet.GetOpcode(),
+                                 packet.GetPayload(),
+                                 packet.GetPayloadLength(),
+                                 0) != LLBC_OK)
+                _errors += 1;
+
+            _relayed += 1;
+            return;
+        }
+
+        // Forward to not exist session will fail, and packet keep untouched.
+        const size_t payloadLen = packet.GetPayloadLength();
+        if (GetService()->Forward(packet, _targetSvc, 0x7fffffff) == LLBC_OK ||
+            packet.GetPayloadLength() != payloadLen)
+            _errors += 1;
+
+        // After forwarded, packet payload taken over by target service(lookup in service manager).
+        if (GetService()->Forward(packet, _targetSvc->GetId(), _targetSessionId) != LLBC_OK ||
+            packet.GetPayloadLength() != 0)
+            _errors += 1;
+
+        _relayed += 1;
+    }
+
+public:
+    int GetRelayed() const
+    {
+        return _relayed;
+    }
+
+    int GetErrors() const
+    {
+        return _errors;
+    }
+
+private:
+    const bool _useForward;
+    LLBC_IService * volatile _targetSvc;
+    volatile int _targetSessionId;
+    RelayFacade *_peer;
+
+    volatile int _relayed;
+    volatile int _errors;
+};
+
+class EchoFacade : public LLBC_IFacade
+{
+public:
+    void OnRecv(LLBC_Packet &packet)
+    {
+        // Forward to self service session.
+        GetService()->Forward(packet, GetService()->GetId(), packet.GetSessionId());
+    }
+};
+
+class CliFacade : public LLBC_IFacade
+{
+public:
+    CliFacade()
+    : _recved(0)
+    , _errors(0)
+    {
+    }
+
+public:
+    void OnRecv(LLBC_Packet &packet)
+    {
+        // Relay keep packet order, so the sequence must equal to received count.
+        if (CheckPayload(packet) != _recved)
+            _errors += 1;
+
+        _recved += 1;
+    }
+
+    int GetRecved() const
+    {
+        return _recved;
+    }
+
+    int GetErrors() const
+    {
+        return _errors;
+    }
+
+private:
+    volatile int _recved;
+    volatile int _errors;
+};
+
+}
+
+TestCase_Comm_Forward::TestCase_Comm_Forward()
+: _runIp("127.0.0.1")
+, _runPort(7788)
+
+, _packetCount(20000)
+, _maxPacketSize(4096)
+{
+}
+
+TestCase_Comm_Forward::~TestCase_Comm_Forward()
+{
+}
+
+int TestCase_Comm_Forward::Run(int argc, char *argv[])
+{
+    LLBC_PrintLine("Cross-service packet forward test:");
+    LLBC_PrintLine("  usage: ./a [ip] [port] [packetCount] [maxPacketSize]");
+
+    FetchArgs(argc, argv);
+
+    sint64 forwardElapsed, sendElapsed;
+    if (RunRelay(_runPort, true, forwardElapsed) != LLBC_OK ||
+        RunRelay(_runPort + 2, false, sendElapsed) != LLBC_OK)
+        return LLBC_FAILED;
+
+    LLBC_PrintLine("[compare] forward elapsed: %.3f ms, re-send elapsed: %.3f ms",
+                   forwardElapsed / 1000.0, sendElapsed / 1000.0);
+
+    return LLBC_OK;
+}
+
+void TestCase_Comm_Forward::FetchArgs(int argc, char *argv[])
+{
+    if (argc > 1)
+        _runIp = argv[1];
+    if (argc > 2)
+        _runPort = LLBC_Str2Int32(argv[2]);
+    if (argc > 3)
+        _packetCount = MAX(LLBC_Str2Int32(argv[3]), 1);
+    if (argc > 4)
+        _maxPacketSize = MAX(LLBC_Str2Int32(argv[4]), static_cast<int>(sizeof(int)));
+}
+
+int TestCase_Comm_Forward::RunRelay(int port, bool useForward, sint64 &elapsed)
+{
+    elapsed = 0;
+
+    // Echo server.
+    LLBC_IService *echoSvr = LLBC_IService::Create(LLBC_IService::Normal, "ForwardEchoSvr");
+    EchoFacade *echoFacade = LLBC_New(EchoFacade);
+    echoSvr->RegisterFacade(echoFacade);
+    echoSvr->Subscribe(RELAY_OPCODE, echoFacade, &EchoFacade::OnRecv);
+    echoSvr->SuppressCoderNotFoundWarning();
+    if (echoSvr->Start(1) != LLBC_OK ||
+        echoSvr->Listen(_runIp.c_str(), port + 1) == 0)
+    {
+        LLBC_FilePrintLine(stderr, "Start echo server service failed, err: %s", LLBC_FormatLastError());
+        LLBC_Delete(echoSvr);
+
+        return LLBC_FAILED;
+    }
+
+    // Front service accept client, back service connect to echo server.
+    LLBC_IService *front = LLBC_IService::Create(LLBC_IService::Normal, "ForwardFront");
+    RelayFacade *frontFacade = LLBC_New1(RelayFacade, useForward);
+    front->RegisterFacade(frontFacade);
+    front->Subscribe(RELAY_OPCODE, frontFacade, &RelayFacade::OnRecv);
+    front->SuppressCoderNotFoundWarning();
+
+    LLBC_IService *back = LLBC_IService::Create(LLBC_IService::Normal, "ForwardBack");
+    RelayFacade *backFacade = LLBC_New1(RelayFacade, useForward);
+    back->RegisterFacade(backFacade);
+    back->Subscribe(RELAY_OPCODE, backFacade, &RelayFacade::OnRecv);
+    back->SuppressCoderNotFoundWarning();
+
+    int backSessionId = 0;
+    if (front->Start(1) != LLBC_OK ||
+        front->Listen(_runIp.c_str(), port) == 0 ||
+        back->Start(1) != LLBC_OK ||
+        (backSessionId = back->Connect(_runIp.c_str(), port + 1)) == 0)
+    {
+        LLBC_FilePrintLine(stderr, "Start relay services failed, err: %s", LLBC_FormatLastError());
+        LLBC_Delete(back);
+        LLBC_Delete(front);
+        LLBC_Delete(echoSvr);
+
+        return LLBC_FAILED;
+    }
+
+    frontFacade->SetTarget(back, backSessionId);
+    frontFacade->SetPeer(backFacade);
+
+    // Client.
+    LLBC_IService *cli = LLBC_IService::Create(LLBC_IService::Normal, "ForwardCli");
+    CliFacade *cliFacade = LLBC_New(CliFacade);
+    cli->RegisterFacade(cliFacade);
+    cli->Subscribe(RELAY_OPCODE, cliFacade, &CliFacade::OnRecv);
+    cli->SuppressCoderNotFoundWarning();
+    cli->Start(1);
+
+    const int sessionId = cli->Connect(_runIp.c_str(), port);
+    if (sessionId == 0)
+    {
+        LLBC_FilePrintLine(stderr, "Connect to front service failed, err: %s", LLBC_FormatLastError());
+        LLBC_Delete(cli);
+        LLBC_Delete(back);
+        LLBC_Delete(front);
+        LLBC_Delete(echoSvr);
+
+        return LLBC_FAILED;
+    }
+
+    const sint64 begTime = LLBC_GetMicroSeconds();
+
+    size_t totalBytes = 0;
+    std::vector<char> payload;
+    for (int i = 0; i < _packetCount; i++)
+    {
+        BuildPayload(i, sizeof(int) + (i * 7919) % (_maxPacketSize - sizeof(int) + 1), payload);
+        cli->Send(sessionId, RELAY_OPCODE, &payload[0], payload.size(), 0);
+
+        totalBytes += payload.size();
+    }
+
+    const sint64 waitBegTime = LLBC_GetMilliSeconds();
+    while (cliFacade->GetRecved() < _packetCount &&
+        LLBC_GetMilliSeconds() - waitBegTime < 30000)
+        LLBC_Sleep(1);
+
+    elapsed = MAX(LLBC_GetMicroSeconds() - begTime, 1);
+    LLBC_PrintLine("[relay] mode: %-7s, packets: %d/%d, bytes: %lu, elapsed: %.3f ms, "
+                   "relayed(front/back): %d/%d, errors(front/back/client): %d/%d/%d",
+                   useForward ? "forward" : "re-send",
+                   cliFacade->GetRecved(),
+                   _packetCount,
+                   totalBytes,
+                   elapsed / 1000.0,
+                   frontFacade->GetRelayed(),
+                   backFacade->GetRelayed(),
+                   frontFacade->GetErrors(),
+                   backFacade->GetErrors(),
+                   cliFacade->GetErrors());
+
+    const bool succeed = cliFacade->GetRecved() == _packetCount &&
+                         cliFacade->GetErrors() == 0 &&
+                         frontFacade->GetErrors() == 0 &&
+                         backFacade->GetErrors() == 0;
+
+    LLBC_Delete(cli);
+    LLBC_Delete(back);
+    LLBC_Delete(front);
+    LLBC_Delete(echoSvr);
+
+    return succeed ? LLBC_OK : LLBC_FAILED;
+}
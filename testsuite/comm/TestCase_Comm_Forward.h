@@ -0,0 +1,44 @@
+/**
+ * @file    TestCase_Comm_Forward.h
+ * @author  Longwei Lai<lailongwei@126.com>
+ * @date    2026/10/18
+ * @version 1.0
+ *
+ * @brief   The llbc library cross-service packet forward test case.
+ */
+#ifndef __LLBC_TEST_CASE_COMM_FORWARD_H__
+#define __LLBC_TEST_CASE_COMM_FORWARD_H__
+
+#include "llbc.h"
+using namespace llbc;
+
+class TestCase_Comm_Forward : public LLBC_BaseTestCase
+{
+public:
+    TestCase_Comm_Forward();
+    virtual ~TestCase_Comm_Forward();
+
+public:
+    virtual int Run(int argc, char *argv[]);
+
+private:
+    void FetchArgs(int argc, char *argv[]);
+
+    /**
+     * Run client->front service->back service->echo server relay, and echo back.
+     * @param[in]  port       - the front service listen port, echo server listen on port + 1.
+     * @param[in]  useForward - use Forward() to relay packet or not(re-send bytes).
+     * @param[out] elapsed    - the elapsed time, in micro-seconds.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    int RunRelay(int port, bool useForward, sint64 &elapsed);
+
+private:
+    LLBC_String _runIp;
+    int _runPort;
+
+    int _packetCount;
+    int _maxPacketSize;
+};
+
+#endif // !__LLBC_TEST_CASE_COMM_FORWARD_H__
@@ -0,0 +1,219 @@
+/**
+ * @file    TestCase_Comm_MulticastBench.cpp
+ * @author  Longwei Lai<lailongwei@126.com>
+ * @date    2026/10/18
+ * @version 1.0
+ *
+ * @brief
+ */
+
+#include "comm/TestCase_Comm_MulticastBench.h"
+
+namespace
+{
+
+const int OPCODE = 1;
+
+class SvrFacade : public LLBC_IFacade
+{
+public:
+    virtual void OnSessionCreate(const LLBC_SessionInfo &sessionInfo)
+    {
+        if (sessionInfo.IsListenSession())
+            return;
+
+        LLBC_Guard guard(_lock);
+        _sessionIds.push_back(sessionInfo.GetSessionId());
+    }
+
+    virtual void OnSessionDestroy(const LLBC_SessionDestroyInfo &destroyInfo)
+    {
+        LLBC_Guard guard(_lock);
+        LLBC_SessionIdList::iterator it =
+            std::find(_sessionIds.begin(), _sessionIds.end(), destroyInfo.GetSessionId());
+        if (it != _sessionIds.end())
+            _sessionIds.erase(it);
+    }
+
+    void GetSessionIds(LLBC_SessionIdList &sessionIds)
+    {
+        LLBC_Guard guard(_lock);
+        sessionIds = _sessionIds;
+    }
+
+private:
+    LLBC_SpinLock _lock;
+    LLBC_SessionIdList _sessionIds;
+};
+
+class CliFacade : public LLBC_IFacade
+{
+public:
+    CliFacade(const std::vector<char> &expected)
+    : _expected(expected)
+    , _recvCount(0)
+    , _badCount(0)
+    {
+    }
+
+public:
+    void OnRecv(LLBC_Packet &packet)
+    {
+        _recvCount += 1;
+        if (packet.GetPayloadLength() != _expected.size() ||
+            ::memcmp(packet.GetPayload(), &_expected[0], _expected.size()) != 0)
+            _badCount += 1;
+    }
+
+    sint32 GetRecvCount() const
+    {
+        return _recvCount;
+    }
+
+    sint32 GetBadCount() const
+    {
+        return _badCount;
+    }
+
+private:
+    const std::vector<char> &_expected;
+
+    volatile sint32 _recvCount;
+    volatile sint32 _badCount;
+};
+
+}
+
+TestCase_Comm_MulticastBench::TestCase_Comm_MulticastBench()
+: _runIp("127.0.0.1")
+, _runPort(7788)
+
+, _sessionCount(2000)
+, _broadcastTimes(200)
+, _payloadSize(1024)
+{
+}
+
+TestCase_Comm_MulticastBench::~TestCase_Comm_MulticastBench()
+{
+}
+
+int TestCase_Comm_MulticastBench::Run(int argc, char *argv[])
+{
+    LLBC_PrintLine("Encode-once multicast/broadcast benchmark:");
+    LLBC_PrintLine("  usage: ./a [ip] [port] [sessionCount] [broadcastTimes] [payloadSize]");
+
+    FetchArgs(argc, argv);
+
+    std::vector<char> payload(_payloadSize);
+    for (int i = 0; i < _payloadSize; i++)
+        payload[i] = static_cast<char>(i % 251);
+
+    // Create server service.
+    LLBC_IService *svr = LLBC_IService::Create(LLBC_IService::Normal, "MulticastSvr");
+    SvrFacade *svrFacade = LLBC_New(SvrFacade);
+    svr->RegisterFacade(svrFacade);
+    svr->SuppressCoderNotFoundWarning();
+    if (svr->Start(2) != LLBC_OK ||
+        svr->Listen(_runIp.c_str(), _runPort) == 0)
+    {
+        LLBC_FilePrintLine(stderr, "Start server service failed, err: %s", LLBC_FormatLastError());
+        LLBC_Delete(svr);
+
+        return LLBC_FAILED;
+    }
+
+    // Create client service and connect to server.
+    LLBC_IService *cli = LLBC_IService::Create(LLBC_IService::Normal, "MulticastCli");
+    CliFacade *cliFacade = LLBC_New1(CliFacade, payload);
+    cli->RegisterFacade(cliFacade);
+    cli->Subscribe(OPCODE, cliFacade, &CliFacade::OnRecv);
+    cli->SuppressCoderNotFoundWarning();
+    cli->Start(2);
+
+    int connected = 0;
+    for (int i = 0; i < _sessionCount; i++)
+    {
+        if (cli->Connect(_runIp.c_str(), _runPort) == 0)
+            break;
+
+        connected += 1;
+    }
+
+    // Wait server accept all sessions.
+    LLBC_SessionIdList sessionIds;
+    const sint64 connectedTime = LLBC_GetMilliSeconds();
+    do
+    {
+        LLBC_Sleep(10);
+        svrFacade->GetSessionIds(sessionIds);
+    } while (static_cast<int>(sessionIds.size()) < connected &&
+        LLBC_GetMilliSeconds() - connectedTime < 5000);
+
+    const int accepted = static_cast<int>(sessionIds.size());
+    LLBC_PrintLine("sessions: %d, connected: %d, accepted: %d, payload: %d bytes",
+                   _sessionCount, connected, accepted, _payloadSize);
+
+    // Broadcast.
+    sint64 begTime = LLBC_GetMicroSeconds();
+    for (int i = 0; i < _broadcastTimes; i++)
+        svr->Broadcast(OPCODE, &payload[0], payload.size(), 0);
+    const sint64 broadcastCost = MAX(LLBC_GetMicroSeconds() - begTime, 1);
+
+    sint32 expectedCount = accepted * _broadcastTimes;
+    while (cliFacade->GetRecvCount() < expectedCount &&
+        LLBC_GetMicroSeconds() - begTime < 60 * 1000000LL)
+        LLBC_Sleep(1);
+    sint64 elapsed = MAX(LLBC_GetMicroSeconds() - begTime, 1);
+
+    LLBC_PrintLine("broadcast: %d times, call cost: %.2f us/broadcast, received: %d/%d, delivered: %.0f packets/s",
+                   _broadcastTimes,
+                   broadcastCost / static_cast<double>(_broadcastTimes),
+                   cliFacade->GetRecvCount(),
+                   expectedCount,
+                   cliFacade->GetRecvCount() * 1000000.0 / elapsed);
+
+    // Multicast to half sessions.
+    LLBC_SessionIdList halfSessionIds(sessionIds.begin(), sessionIds.begin() + sessionIds.size() / 2);
+    const sint32 recvedCount = cliFacade->GetRecvCount();
+    begTime = LLBC_GetMicroSeconds();
+    for (int i = 0; i < _broadcastTimes; i++)
+        svr->Multicast(halfSessionIds, OPCODE, &payload[0], payload.size(), 0);
+    const sint64 multicastCost = MAX(LLBC_GetMicroSeconds() - begTime, 1);
+
+    expectedCount = recvedCount + static_cast<sint32>(halfSessionIds.size()) * _broadcastTimes;
+    while (cliFacade->GetRecvCount() < expectedCount &&
+        LLBC_GetMicroSeconds() - begTime < 60 * 1000000LL)
+        LLBC_Sleep(1);
+    elapsed = MAX(LLBC_GetMicroSeconds() - begTime, 1);
+
+    LLBC_PrintLine("multicast: %d times, call cost: %.2f us/multicast, received: %d/%d, delivered: %.0f packets/s",
+                   _broadcastTimes,
+                   multicastCost / static_cast<double>(_broadcastTimes),
+                   cliFacade->GetRecvCount() - recvedCount,
+                   expectedCount - recvedCount,
+                   (cliFacade->GetRecvCount() - recvedCount) * 1000000.0 / elapsed);
+
+    LLBC_PrintLine("bad packets: %d", cliFacade->GetBadCount());
+
+    const bool succeed = cliFacade->GetRecvCount() == expectedCount && cliFacade->GetBadCount() == 0;
+
+    LLBC_Delete(cli);
+    LLBC_Delete(svr);
+
+    return succeed ? LLBC_OK : LLBC_FAILED;
+}
+
+void TestCase_Comm_MulticastBench::FetchArgs(int argc, char *argv[])
+{
+    if (argc > 1)
+        _runIp = argv[1];
+    if (argc > 2)
+        _runPort = LLBC_Str2Int32(argv[2]);
+    if (argc > 3)
+        _sessionCount = MAX(LLBC_Str2Int32(argv[3]), 1);
+    if (argc > 4)
+        _broadcastTimes = MAX(LLBC_Str2Int32(argv[4]), 1);
+    if (argc > 5)
+        _payloadSize = MAX(LLBC_Str2Int32(argv[5]), 1);
+}
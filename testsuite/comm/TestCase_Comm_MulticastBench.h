@@ -0,0 +1,36 @@
+/**
+ * @file    TestCase_Comm_MulticastBench.h
+ * @author  Longwei Lai<lailongwei@126.com>
+ * @date    2026/10/18
+ * @version 1.0
+ *
+ * @brief   The llbc library encode-once multicast/broadcast benchmark test case.
+ */
+#ifndef __LLBC_TEST_CASE_COMM_MULTICAST_BENCH_H__
+#define __LLBC_TEST_CASE_COMM_MULTICAST_BENCH_H__
+
+#include "llbc.h"
+using namespace llbc;
+
+class TestCase_Comm_MulticastBench : public LLBC_BaseTestCase
+{
+public:
+    TestCase_Comm_MulticastBench();
+    virtual ~TestCase_Comm_MulticastBench();
+
+public:
+    virtual int Run(int argc, char *argv[]);
+
+private:
+    void FetchArgs(int argc, char *argv[]);
+
+private:
+    LLBC_String _runIp;
+    int _runPort;
+
+    int _sessionCount;
+    int _broadcastTimes;
+    int _payloadSize;
+};
+
+#endif // !__LLBC_TEST_CASE_COMM_MULTICAST_BENCH_H__
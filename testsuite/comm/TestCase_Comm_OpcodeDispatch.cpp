@@ -0,0 +1,327 @@
+/**
+ * @file    TestCase_Comm_OpcodeDispatch.cpp
+ * @author  Longwei Lai<lailongwei@126.com>
+ * @date    2026/10/18
+ * @version 1.0
+ *
+ * @brief
+ */
+
+#include "comm/TestCase_Comm_OpcodeDispatch.h"
+
+namespace
+{
+
+// Sparse opcodes begin, greater than dense limit, use to test hashed dispatch.
+const int SPARSE_OPCODE_BEG = 1 << 20;
+const int SPARSE_OPCODE_STEP = 7919;
+
+// Status handler registered status and status desc.
+const int HANDLED_STATUS = 1;
+const char * const HANDLED_STATUS_DESC = "handled status";
+
+int GetOpcode(bool sparse, int idx)
+{
+    return sparse ? SPARSE_OPCODE_BEG + idx * SPARSE_OPCODE_STEP : idx;
+}
+
+class EmptyCoder : public LLBC_ICoder
+{
+public:
+    virtual bool Encode(LLBC_Packet &packet)
+    {
+        return true;
+    }
+
+    virtual bool Decode(LLBC_Packet &packet)
+    {
+        return true;
+    }
+};
+
+class EmptyCoderFactory : public LLBC_ICoderFactory
+{
+public:
+    virtual LLBC_ICoder *Create() const
+    {
+        return LLBC_New(EmptyCoder);
+    }
+};
+
+class SvrFacade : public LLBC_IFacade
+{
+public:
+    SvrFacade()
+    : _handled(0)
+    , _preHandled(0)
+    , _statusHandled(0)
+    , _badStatusDescs(0)
+    {
+    }
+
+public:
+    void *OnPreHandle(LLBC_Packet &packet)
+    {
+        ++_preHandled;
+        return reinterpret_cast<void *>(0x01);
+    }
+
+    void OnHandle(LLBC_Packet &packet)
+    {
+        ++_handled;
+    }
+
+    void OnStatus(LLBC_Packet &packet)
+    {
+        ++_statusHandled;
+#if LLBC_CFG_COMM_ENABLE_STATUS_DESC
+        if (packet.GetStatusDesc() != HANDLED_STATUS_DESC)
+            ++_badStatusDescs;
+#endif // LLBC_CFG_COMM_ENABLE_STATUS_DESC
+    }
+
+    int GetHandled() const
+    {
+        return _handled + _statusHandled;
+    }
+
+    int GetPreHandled() const
+    {
+        return _preHandled;
+    }
+
+    int GetBadStatusDescs() const
+    {
+        return _badStatusDescs;
+    }
+
+private:
+    int _handled;
+    int _preHandled;
+    int _statusHandled;
+    int _badStatusDescs;
+};
+
+class CliFacade : public LLBC_IFacade
+{
+public:
+    CliFacade(bool sparse, int opcodeCount, int packetCount)
+    : _sparse(sparse)
+    , _opcodeCount(opcodeCount)
+    , _packetCount(packetCount)
+    {
+    }
+
+public:
+    virtual void OnSessionCreate(const LLBC_SessionInfo &sessionInfo)
+    {
+        // Scatter opcodes, every 16th packet carry handled status.
+        uint32 seed = 1;
+        for (int i = 0; i < _packetCount; i++)
+        {
+            seed = seed * 1103515245 + 12345;
+            const int opcode = GetOpcode(_sparse, (seed >> 8) % _opcodeCount);
+            GetService()->Send(sessionInfo.GetSessionId(), opcode, &i, sizeof(i), (i & 0xf) == 0 ? HANDLED_STATUS : 0);
+        }
+    }
+
+private:
+    bool _sparse;
+    int _opcodeCount;
+    int _packetCount;
+};
+
+}
+
+TestCase_Comm_OpcodeDispatch::TestCase_Comm_OpcodeDispatch()
+: _runIp("127.0.0.1")
+, _runPort(7788)
+
+, _opcodeCount(4096)
+, _packetCount(500000)
+{
+}
+
+TestCase_Comm_OpcodeDispatch::~TestCase_Comm_OpcodeDispatch()
+{
+}
+
+int TestCase_Comm_OpcodeDispatch::Run(int argc, char *argv[])
+{
+    LLBC_PrintLine("Service opcode dispatch overhead benchmark:");
+    LLBC_PrintLine("  usage: ./a [ip] [port] [opcodeCount] [packetCount]");
+
+    FetchArgs(argc, argv);
+
+    RunLookupCompare(false);
+    RunLookupCompare(true);
+    if (RunOnce(false, static_cast<uint16>(_runPort)) != LLBC_OK ||
+        RunOnce(true, static_cast<uint16>(_runPort + 1)) != LLBC_OK)
+        return LLBC_FAILED;
+
+    return LLBC_OK;
+}
+
+int TestCase_Comm_OpcodeDispatch::RunOnce(bool sparse, uint16 port)
+{
+    // Create server service, subscribe coder/pre-handler/handler/status handler for all opcodes.
+    LLBC_IService *svr = LLBC_IService::Create(LLBC_IService::Normal, "OpcodeDispatchSvr");
+    SvrFacade *svrFacade = LLBC_New(SvrFacade);
+    svr->RegisterFacade(svrFacade);
+    for (int i = 0; i < _opcodeCount; i++)
+    {
+        const int opcode = GetOpcode(sparse, i);
+        svr->RegisterCoder(opcode, LLBC_New(EmptyCoderFactory));
+        svr->PreSubscribe(opcode, svrFacade, &SvrFacade::OnPreHandle);
+        svr->Subscribe(opcode, svrFacade, &SvrFacade::OnHandle);
+        svr->SubscribeStatus(opcode, HANDLED_STATUS, svrFacade, &SvrFacade::OnStatus);
+    }
+#if LLBC_CFG_COMM_ENABLE_STATUS_DESC
+    svr->RegisterStatusDesc(HANDLED_STATUS, HANDLED_STATUS_DESC);
+#endif // LLBC_CFG_COMM_ENABLE_STATUS_DESC
+
+    svr->SetDriveMode(LLBC_IService::ExternalDrive);
+    if (svr->Start(1) != LLBC_OK ||
+        svr->Listen(_runIp.c_str(), port) == 0)
+    {
+        LLBC_FilePrintLine(stderr, "Start server service failed, err: %s", LLBC_FormatLastError());
+        LLBC_Delete(svr);
+
+        return LLBC_FAILED;
+    }
+
+    // Accept session.
+    svr->OnSvc(false);
+
+    // Create client, send all packets when session created.
+    LLBC_IService *cli = LLBC_IService::Create(LLBC_IService::Normal, "OpcodeDispatchCli");
+    cli->RegisterFacade(LLBC_New3(CliFacade, sparse, _opcodeCount, _packetCount));
+    cli->SuppressCoderNotFoundWarning();
+    cli->Start(1);
+    cli->Connect(_runIp.c_str(), port);
+
+    // Wait all packets arrived server service queue(not drive server service), then drain queue and measure.
+    const size_t expectBytes = static_cast<size_t>(_packetCount) * (LLBC_LibPacketHeaderLayout::HeaderLen + sizeof(int));
+    const sint64 waitBegTime = LLBC_GetMilliSeconds();
+    LLBC_RecvStat recvStat;
+    while (svr->GetRecvStat(recvStat) == LLBC_OK &&
+           recvStat.recvBytes < expectBytes &&
+           LLBC_GetMilliSeconds() - waitBegTime < 30000)
+        LLBC_Sleep(10);
+
+    const sint64 begTime = LLBC_GetMicroSeconds();
+    while (svrFacade->GetHandled() < _packetCount &&
+           LLBC_GetMicroSeconds() - begTime < 30000000)
+        svr->OnSvc(false);
+    const sint64 elapsed = MAX(LLBC_GetMicroSeconds() - begTime, 1);
+
+    const int handled = svrFacade->GetHandled();
+    const int badStatusDescs = svrFacade->GetBadStatusDescs();
+    LLBC_PrintLine("[%s] opcodes: %d, handled: %d/%d, preHandled: %d, bad status descs: %d, "
+                   "elapsed: %.3f ms, dispatch: %.1f ns/packet",
+                   sparse ? "sparse(hashed)" : "dense(indexed)",
+                   _opcodeCount,
+                   handled,
+                   _packetCount,
+                   svrFacade->GetPreHandled(),
+                   badStatusDescs,
+                   elapsed / 1000.0,
+                   elapsed * 1000.0 / MAX(handled, 1));
+
+    LLBC_Delete(cli);
+    LLBC_Delete(svr);
+
+    return handled == _packetCount && badStatusDescs == 0 ? LLBC_OK : LLBC_FAILED;
+}
+
+void TestCase_Comm_OpcodeDispatch::RunLookupCompare(bool sparse)
+{
+    // Old: five std::map lookups per packet(status descs, status handlers, pre-handlers, handlers, coders).
+    // New: one dispatch table lookup, read same five members from entry.
+    // Both use same opcodes, same pre-generated opcode sequence, same loop and same result accumulation.
+    const int mapCount = 5;
+    std::map<int, void *> maps[mapCount];
+    LLBC_OpcodeDispatchTable::Entries entries;
+    for (int i = 0; i < _opcodeCount; i++)
+    {
+        const int opcode = GetOpcode(sparse, i);
+        for (int j = 0; j < mapCount; j++)
+            maps[j].insert(std::make_pair(opcode, reinterpret_cast<void *>(i + 1)));
+
+        LLBC_OpcodeDispatchEntry &entry = entries[opcode];
+        entry.handler = reinterpret_cast<LLBC_IDelegate1<LLBC_Packet &> *>(i + 1);
+        entry.preHandler = reinterpret_cast<LLBC_IDelegateEx<LLBC_Packet &> *>(i + 1);
+        entry.coder = reinterpret_cast<LLBC_ICoderFactory *>(i + 1);
+        entry.statusHandlers = reinterpret_cast<LLBC_OpcodeDispatchEntry::StatusHandlers *>(i + 1);
+        entry.statusDescs = reinterpret_cast<const LLBC_OpcodeDispatchEntry::StatusDescs *>(i + 1);
+    }
+
+    LLBC_OpcodeDispatchTable table;
+    table.Compile(entries);
+
+    std::vector<int> opcodes(_packetCount);
+    uint32 seed = 1;
+    for (int i = 0; i < _packetCount; i++)
+    {
+        seed = seed * 1103515245 + 12345;
+        opcodes[i] = GetOpcode(sparse, (seed >> 8) % _opcodeCount);
+    }
+
+    // Interleave rounds, use the best round of every lookup.
+    const int rounds = 5;
+    sint64 mapElapsed = LLONG_MAX, tableElapsed = LLONG_MAX;
+    size_t mapSum = 0, tableSum = 0;
+    for (int round = 0; round < rounds; round++)
+    {
+        mapSum = 0;
+        sint64 begTime = LLBC_GetMicroSeconds();
+        for (int i = 0; i < _packetCount; i++)
+        {
+            for (int j = 0; j < mapCount; j++)
+            {
+                std::map<int, void *>::const_iterator it = maps[j].find(opcodes[i]);
+                if (it != maps[j].end())
+                    mapSum += reinterpret_cast<size_t>(it->second);
+            }
+        }
+        mapElapsed = MIN(mapElapsed, LLBC_GetMicroSeconds() - begTime);
+
+        tableSum = 0;
+        begTime = LLBC_GetMicroSeconds();
+        for (int i = 0; i < _packetCount; i++)
+        {
+            const LLBC_OpcodeDispatchEntry &entry = table.Find(opcodes[i]);
+            tableSum += reinterpret_cast<size_t>(entry.handler) +
+                        reinterpret_cast<size_t>(entry.preHandler) +
+                        reinterpret_cast<size_t>(entry.coder) +
+                        reinterpret_cast<size_t>(entry.statusHandlers) +
+                        reinterpret_cast<size_t>(entry.statusDescs);
+        }
+        tableElapsed = MIN(tableElapsed, LLBC_GetMicroSeconds() - begTime);
+    }
+
+    mapElapsed = MAX(mapElapsed, 1);
+    tableElapsed = MAX(tableElapsed, 1);
+    LLBC_PrintLine("[lookup %s] opcodes: %d, entry size: %lu, %d std::map lookups: %.1f ns/packet, "
+                   "dispatch table lookup: %.1f ns/packet, speedup: %.1fx, checksum %s",
+                   sparse ? "sparse" : "dense",
+                   _opcodeCount,
+                   static_cast<unsigned long>(sizeof(LLBC_OpcodeDispatchEntry)),
+                   mapCount,
+                   mapElapsed * 1000.0 / _packetCount,
+                   tableElapsed * 1000.0 / _packetCount,
+                   static_cast<double>(mapElapsed) / tableElapsed,
+                   mapSum == tableSum ? "matched" : "mismatched");
+}
+
+void TestCase_Comm_OpcodeDispatch::FetchArgs(int argc, char *argv[])
+{
+    if (argc > 1)
+        _runIp = argv[1];
+    if (argc > 2)
+        _runPort = LLBC_Str2Int32(argv[2]);
+    if (argc > 3)
+        _opcodeCount = MAX(LLBC_Str2Int32(argv[3]), 1);
+    if (argc > 4)
+        _packetCount = MAX(LLBC_Str2Int32(argv[4]), 1);
+}
@@ -0,0 +1,38 @@
+/**
+ * @file    TestCase_Comm_OpcodeDispatch.h
+ * @author  Longwei Lai<lailongwei@126.com>
+ * @date    2026/10/18
+ * @version 1.0
+ *
+ * @brief   The llbc library service opcode dispatch overhead benchmark test case.
+ */
+#ifndef __LLBC_TEST_CASE_COMM_OPCODE_DISPATCH_H__
+#define __LLBC_TEST_CASE_COMM_OPCODE_DISPATCH_H__
+
+#include "llbc.h"
+using namespace llbc;
+
+class TestCase_Comm_OpcodeDispatch : public LLBC_BaseTestCase
+{
+public:
+    TestCase_Comm_OpcodeDispatch();
+    virtual ~TestCase_Comm_OpcodeDispatch();
+
+public:
+    virtual int Run(int argc, char *argv[]);
+
+private:
+    void FetchArgs(int argc, char *argv[]);
+
+    int RunOnce(bool sparse, uint16 port);
+    void RunLookupCompare(bool sparse);
+
+private:
+    LLBC_String _runIp;
+    int _runPort;
+
+    int _opcodeCount;
+    int _packetCount;
+};
+
+#endif // !__LLBC_TEST_CASE_COMM_OPCODE_DISPATCH_H__
@@ -0,0 +1,133 @@
+/**
+ * @file    TestCase_Comm_PacketHeaderLayout.cpp
+ * @author  Longwei Lai<lailongwei@126.com>
+ * @date    2026/10/18
+ * @version 1.0
+ *
+ * @brief
+ */
+
+#include "comm/TestCase_Comm_PacketHeaderLayout.h"
+
+namespace
+{
+
+const int SERVICE_ID = 300;
+const int SESSION_ID = 1;
+const int OPCODE = 0x12345678;
+const int STATUS = -2;
+const int FLAGS = 0x5;
+
+const int PAYLOAD_SIZE = 32;
+
+}
+
+TestCase_Comm_PacketHeaderLayout::TestCase_Comm_PacketHeaderLayout()
+: _runtimeMode(false)
+, _loopCount(10000000)
+{
+}
+
+TestCase_Comm_PacketHeaderLayout::~TestCase_Comm_PacketHeaderLayout()
+{
+}
+
+int TestCase_Comm_PacketHeaderLayout::Run(int argc, char *argv[])
+{
+    LLBC_PrintLine("Packet header layout dispatch cost benchmark:");
+    LLBC_PrintLine("  usage: ./a [fixed|runtime] [loopCount]");
+    LLBC_PrintLine("  runtime mode use library layout + one extra reserved part, force use runtime header describe");
+
+    FetchArgs(argc, argv);
+
+    // In runtime mode, append a reserved part to library layout, header describe will not match fixed layout.
+    if (_runtimeMode)
+    {
+        LLBC_PacketHeaderDesc *desc = LLBC_LibPacketHeaderLayout::BuildDesc();
+        desc->AddPartDesc().SetSerialNo(5).SetPartLen(2).Done();
+        if (LLBC_IService::SetPacketHeaderDesc(desc) != LLBC_OK)
+        {
+            LLBC_FilePrintLine(stderr, "Set packet header describe failed, err: %s", LLBC_FormatLastError());
+            LLBC_Delete(desc);
+
+            return LLBC_FAILED;
+        }
+    }
+
+    // Build a wire packet, use to simulate dispatch path(read length, opcode, status, serviceId, flags).
+    char payload[PAYLOAD_SIZE];
+    ::memset(payload, 'p', sizeof(payload));
+
+    LLBC_Packet *sendPacket = LLBC_New(LLBC_Packet);
+    sendPacket->SetHeader(SERVICE_ID, SESSION_ID, OPCODE, STATUS);
+    sendPacket->SetFlags(FLAGS);
+    sendPacket->Write(payload, sizeof(payload));
+
+    const bool fixedLayout = sendPacket->IsFixedHeaderLayout();
+    LLBC_MessageBlock *wire = sendPacket->GiveUp();
+    LLBC_Delete(sendPacket);
+
+    LLBC_Packet packet;
+    packet.WriteHeader(wire->GetData());
+
+    LLBC_PacketHeaderAssembler assembler(wire->GetWritePos() - PAYLOAD_SIZE);
+
+    // Verify values.
+    const int expectLen = static_cast<int>(wire->GetWritePos());
+    if (packet.GetLength() != expectLen ||
+        assembler.ReadLength(wire->GetData()) != expectLen ||
+        packet.GetOpcode() != OPCODE ||
+        packet.GetStatus() != STATUS ||
+        packet.GetServiceId() != SERVICE_ID ||
+        packet.GetFlags() != FLAGS)
+    {
+        LLBC_FilePrintLine(stderr, "Header values mismatch, len: %d(expect: %d), opcode: %d, status: %d, svcId: %d, flags: %d",
+                           packet.GetLength(), expectLen, packet.GetOpcode(),
+                           packet.GetStatus(), packet.GetServiceId(), packet.GetFlags());
+        LLBC_Delete(wire);
+
+        return LLBC_FAILED;
+    }
+
+    // Read path: length(assembler) + opcode + status + serviceId + flags, as dispatch does.
+    volatile sint64 sum = 0;
+    sint64 begTime = LLBC_GetMicroSeconds();
+    for (int i = 0; i < _loopCount; i++)
+    {
+        sum += assembler.ReadLength(wire->GetData());
+        sum += packet.GetOpcode();
+        sum += packet.GetStatus();
+        sum += packet.GetServiceId();
+        sum += packet.GetFlags();
+    }
+    const sint64 readElapsed = MAX(LLBC_GetMicroSeconds() - begTime, 1);
+
+    // Write path: set header + flags.
+    begTime = LLBC_GetMicroSeconds();
+    for (int i = 0; i < _loopCount; i++)
+    {
+        packet.SetHeader(SERVICE_ID, SESSION_ID, OPCODE + (i & 0xff), STATUS);
+        packet.SetFlags(FLAGS);
+    }
+    const sint64 writeElapsed = MAX(LLBC_GetMicroSeconds() - begTime, 1);
+
+    LLBC_PrintLine("[%s] fixedLayout: %s, loops: %d, read: %.2f ns/packet, write: %.2f ns/packet(sum: %lld)",
+                   _runtimeMode ? "runtime" : "fixed",
+                   fixedLayout ? "true" : "false",
+                   _loopCount,
+                   readElapsed * 1000.0 / _loopCount,
+                   writeElapsed * 1000.0 / _loopCount,
+                   static_cast<sint64>(sum));
+
+    LLBC_Delete(wire);
+
+    return LLBC_OK;
+}
+
+void TestCase_Comm_PacketHeaderLayout::FetchArgs(int argc, char *argv[])
+{
+    if (argc > 1)
+        _runtimeMode = LLBC_String(argv[1]) == "runtime";
+    if (argc > 2)
+        _loopCount = MAX(LLBC_Str2Int32(argv[2]), 1);
+}
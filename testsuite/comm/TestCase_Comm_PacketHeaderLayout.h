@@ -0,0 +1,32 @@
+/**
+ * @file    TestCase_Comm_PacketHeaderLayout.h
+ * @author  Longwei Lai<lailongwei@126.com>
+ * @date    2026/10/18
+ * @version 1.0
+ *
+ * @brief   The llbc library fixed packet header layout benchmark test case.
+ */
+#ifndef __LLBC_TEST_CASE_COMM_PACKET_HEADER_LAYOUT_H__
+#define __LLBC_TEST_CASE_COMM_PACKET_HEADER_LAYOUT_H__
+
+#include "llbc.h"
+using namespace llbc;
+
+class TestCase_Comm_PacketHeaderLayout : public LLBC_BaseTestCase
+{
+public:
+    TestCase_Comm_PacketHeaderLayout();
+    virtual ~TestCase_Comm_PacketHeaderLayout();
+
+public:
+    virtual int Run(int argc, char *argv[]);
+
+private:
+    void FetchArgs(int argc, char *argv[]);
+
+private:
+    bool _runtimeMode;
+    int _loopCount;
+};
+
+#endif // !__LLBC_TEST_CASE_COMM_PACKET_HEADER_LAYOUT_H__
@@ -0,0 +1,183 @@
+/**
+ * @file    TestCase_Comm_PingPong.cpp
+ * @author  Longwei Lai<lailongwei@126.com>
+ * @date    2026/10/18
+ * @version 1.0
+ *
+ * @brief
+ */
+
+#include "comm/TestCase_Comm_PingPong.h"
+
+namespace
+{
+
+const int OPCODE = 1;
+
+class SvrFacade : public LLBC_IFacade
+{
+public:
+    void OnPing(LLBC_Packet &packet)
+    {
+        // Echo back.
+        GetService()->Send(packet.GetSessionId(),
+                           OPCODE,
+                           packet.GetPayload(),
+                           packet.GetPayloadLength(),
+                           0);
+    }
+};
+
+class CliFacade : public LLBC_IFacade
+{
+public:
+    CliFacade(int roundTrips)
+    : _roundTrips(roundTrips)
+    , _finished(false)
+    {
+        _rtts.reserve(roundTrips);
+    }
+
+public:
+    void Ping(int sessionId)
+    {
+        const sint64 now = LLBC_GetMicroSeconds();
+        GetService()->Send(sessionId, OPCODE, &now, sizeof(now), 0);
+    }
+
+    void OnPong(LLBC_Packet &packet)
+    {
+        sint64 sendTime;
+        ::memcpy(&sendTime, packet.GetPayload(), sizeof(sendTime));
+        _rtts.push_back(LLBC_GetMicroSeconds() - sendTime);
+
+        if (static_cast<int>(_rtts.size()) < _roundTrips)
+            Ping(packet.GetSessionId());
+        else
+            _finished = true;
+    }
+
+    bool IsFinished() const
+    {
+        return _finished;
+    }
+
+    std::vector<sint64> &GetRtts()
+    {
+        return _rtts;
+    }
+
+private:
+    const int _roundTrips;
+    volatile bool _finished;
+
+    std::vector<sint64> _rtts;
+};
+
+}
+
+TestCase_Comm_PingPong::TestCase_Comm_PingPong()
+: _runIp("127.0.0.1")
+, _runPort(7788)
+
+, _roundTrips(20000)
+{
+}
+
+TestCase_Comm_PingPong::~TestCase_Comm_PingPong()
+{
+}
+
+int TestCase_Comm_PingPong::Run(int argc, char *argv[])
+{
+    LLBC_PrintLine("Ping-pong round trip latency test:");
+    LLBC_PrintLine("  usage: ./a [ip] [port] [roundTrips]");
+
+    FetchArgs(argc, argv);
+
+    // Create server service.
+    LLBC_IService *svr = LLBC_IService::Create(LLBC_IService::Normal, "PingPongSvr");
+    SvrFacade *svrFacade = LLBC_New(SvrFacade);
+    svr->RegisterFacade(svrFacade);
+    svr->Subscribe(OPCODE, svrFacade, &SvrFacade::OnPing);
+    svr->SuppressCoderNotFoundWarning();
+    svr->SetDriveMode(LLBC_IService::ExternalDrive);
+    if (svr->Start(1) != LLBC_OK ||
+        svr->Listen(_runIp.c_str(), _runPort) == 0)
+    {
+        LLBC_FilePrintLine(stderr, "Start server service failed, err: %s", LLBC_FormatLastError());
+        LLBC_Delete(svr);
+
+        return LLBC_FAILED;
+    }
+
+    // Create client service and connect to server.
+    LLBC_IService *cli = LLBC_IService::Create(LLBC_IService::Normal, "PingPongCli");
+    CliFacade *cliFacade = LLBC_New1(CliFacade, _roundTrips);
+    cli->RegisterFacade(cliFacade);
+    cli->Subscribe(OPCODE, cliFacade, &CliFacade::OnPong);
+    cli->SuppressCoderNotFoundWarning();
+    cli->SetDriveMode(LLBC_IService::ExternalDrive);
+    cli->Start(1);
+
+    const int sessionId = cli->Connect(_runIp.c_str(), _runPort);
+    if (sessionId == 0)
+    {
+        LLBC_FilePrintLine(stderr, "Connect to server failed, err: %s", LLBC_FormatLastError());
+        LLBC_Delete(cli);
+        LLBC_Delete(svr);
+
+        return LLBC_FAILED;
+    }
+
+    // Only one packet in flight, every round trip across client poller, server poller and both services,
+    // services are busy driven by this thread(not sleep in frame), so round trip time mainly is pollers latency.
+    const sint64 begTime = LLBC_GetMicroSeconds();
+    cliFacade->Ping(sessionId);
+    while (!cliFacade->IsFinished() &&
+        LLBC_GetMicroSeconds() - begTime < 60 * 1000000LL)
+    {
+        svr->OnSvc(false);
+        cli->OnSvc(false);
+    }
+    const sint64 elapsed = MAX(LLBC_GetMicroSeconds() - begTime, 1);
+
+    const bool succeed = cliFacade->IsFinished();
+    if (succeed)
+    {
+        std::vector<sint64> &rtts = cliFacade->GetRtts();
+        std::sort(rtts.begin(), rtts.end());
+
+        sint64 totalRtt = 0;
+        for (size_t i = 0; i < rtts.size(); i++)
+            totalRtt += rtts[i];
+
+        LLBC_PrintLine("round trips: %d, elapsed: %.3f ms, avg rtt: %.2f us, p50: %lld us, p99: %lld us, max: %lld us",
+                       _roundTrips,
+                       elapsed / 1000.0,
+                       static_cast<double>(totalRtt) / rtts.size(),
+                       rtts[rtts.size() / 2],
+                       rtts[rtts.size() * 99 / 100],
+                       rtts.back());
+    }
+    else
+    {
+        LLBC_FilePrintLine(stderr, "Ping-pong not finished in 60 seconds, finished round trips: %d",
+                           static_cast<int>(cliFacade->GetRtts().size()));
+    }
+
+    LLBC_Delete(cli);
+    LLBC_Delete(svr);
+
+    return succeed ? LLBC_OK : LLBC_FAILED;
+}
+
+void TestCase_Comm_PingPong::FetchArgs(int argc, char *argv[])
+{
+    if (argc > 1)
+        _runIp = argv[1];
+    if (argc > 2)
+        _runPort = LLBC_Str2Int32(argv[2]);
+    if (argc > 3)
+        _roundTrips = MAX(LLBC_Str2Int32(argv[3]), 1);
+}
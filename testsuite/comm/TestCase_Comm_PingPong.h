@@ -0,0 +1,34 @@
+/**
+ * @file    TestCase_Comm_PingPong.h
+ * @author  Longwei Lai<lailongwei@126.com>
+ * @date    2026/10/18
+ * @version 1.0
+ *
+ * @brief   The llbc library ping-pong round trip latency test case.
+ */
+#ifndef __LLBC_TEST_CASE_COMM_PING_PONG_H__
+#define __LLBC_TEST_CASE_COMM_PING_PONG_H__
+
+#include "llbc.h"
+using namespace llbc;
+
+class TestCase_Comm_PingPong : public LLBC_BaseTestCase
+{
+public:
+    TestCase_Comm_PingPong();
+    virtual ~TestCase_Comm_PingPong();
+
+public:
+    virtual int Run(int argc, char *argv[]);
+
+private:
+    void FetchArgs(int argc, char *argv[]);
+
+private:
+    LLBC_String _runIp;
+    int _runPort;
+
+    int _roundTrips;
+};
+
+#endif // !__LLBC_TEST_CASE_COMM_PING_PONG_H__
@@ -0,0 +1,212 @@
+/**
+ * @file    TestCase_Comm_PollerBench.cpp
+ * @author  Longwei Lai<lailongwei@126.com>
+ * @date    2026/10/18
+ * @version 1.0
+ *
+ * @brief
+ */
+
+#include "comm/TestCase_Comm_PollerBench.h"
+
+namespace
+{
+
+const int OPCODE = 1;
+
+class EchoFacade : public LLBC_IFacade
+{
+public:
+    void OnRecv(LLBC_Packet &packet)
+    {
+        GetService()->Send(packet.GetSessionId(),
+                           OPCODE,
+                           packet.GetPayload(),
+                           packet.GetPayloadLength(),
+                           0);
+    }
+};
+
+class CliFacade : public LLBC_IFacade
+{
+public:
+    CliFacade()
+    : _recved(0)
+    , _recvedBytes(0)
+    {
+    }
+
+public:
+    void OnRecv(LLBC_Packet &packet)
+    {
+        ++_recved;
+        _recvedBytes += packet.GetPayloadLength();
+    }
+
+    int GetRecved() const
+    {
+        return _recved;
+    }
+
+    sint64 GetRecvedBytes() const
+    {
+        return _recvedBytes;
+    }
+
+private:
+    int _recved;
+    sint64 _recvedBytes;
+};
+
+}
+
+TestCase_Comm_PollerBench::TestCase_Comm_PollerBench()
+: _runIp("127.0.0.1")
+, _runPort(7788)
+
+, _sessionCount(64)
+, _packetCount(200000)
+, _packetSize(256)
+, _windowSize(4096)
+{
+}
+
+TestCase_Comm_PollerBench::~TestCase_Comm_PollerBench()
+{
+}
+
+int TestCase_Comm_PollerBench::Run(int argc, char *argv[])
+{
+    LLBC_PrintLine("Pollers echo throughput comparison benchmark:");
+    LLBC_PrintLine("  usage: ./a [ip] [port] [sessionCount] [packetCount] [packetSize] [windowSize]");
+
+    FetchArgs(argc, argv);
+
+#if LLBC_TARGET_PLATFORM_LINUX
+    const int pollerTypes[] = {LLBC_PollerType::EpollPoller, LLBC_PollerType::IoUringPoller};
+#elif LLBC_TARGET_PLATFORM_WIN32
+    const int pollerTypes[] = {LLBC_PollerType::SelectPoller, LLBC_PollerType::IocpPoller};
+#else
+    const int pollerTypes[] = {LLBC_PollerType::SelectPoller};
+#endif
+    for (size_t i = 0; i < sizeof(pollerTypes) / sizeof(pollerTypes[0]); i++)
+    {
+        if (RunBench(pollerTypes[i]) != LLBC_OK)
+            return LLBC_FAILED;
+    }
+
+    return LLBC_OK;
+}
+
+void TestCase_Comm_PollerBench::FetchArgs(int argc, char *argv[])
+{
+    if (argc > 1)
+        _runIp = argv[1];
+    if (argc > 2)
+        _runPort = LLBC_Str2Int32(argv[2]);
+    if (argc > 3)
+        _sessionCount = MAX(LLBC_Str2Int32(argv[3]), 1);
+    if (argc > 4)
+        _packetCount = MAX(LLBC_Str2Int32(argv[4]), 1);
+    if (argc > 5)
+        _packetSize = MAX(LLBC_Str2Int32(argv[5]), 1);
+    if (argc > 6)
+        _windowSize = MAX(LLBC_Str2Int32(argv[6]), 1);
+}
+
+int TestCase_Comm_PollerBench::RunBench(int pollerType)
+{
+    // Create echo server service, every poller type use different port, avoid TIME_WAIT sockets affect.
+    const uint16 port = static_cast<uint16>(_runPort + pollerType);
+    LLBC_IService *svr = LLBC_IService::Create(LLBC_IService::Normal, "PollerBenchSvr");
+    EchoFacade *svrFacade = LLBC_New(EchoFacade);
+    svr->RegisterFacade(svrFacade);
+    svr->Subscribe(OPCODE, svrFacade, &EchoFacade::OnRecv);
+    svr->SuppressCoderNotFoundWarning();
+    svr->SetDriveMode(LLBC_IService::ExternalDrive);
+    if (svr->SetPollerType(pollerType) != LLBC_OK ||
+        svr->Start(1) != LLBC_OK ||
+        svr->Listen(_runIp.c_str(), port) == 0)
+    {
+        LLBC_FilePrintLine(stderr, "Start server service failed, err: %s", LLBC_FormatLastError());
+        LLBC_Delete(svr);
+
+        return LLBC_FAILED;
+    }
+
+    // Create client service and connect to server.
+    LLBC_IService *cli = LLBC_IService::Create(LLBC_IService::Normal, "PollerBenchCli");
+    CliFacade *cliFacade = LLBC_New(CliFacade);
+    cli->RegisterFacade(cliFacade);
+    cli->Subscribe(OPCODE, cliFacade, &CliFacade::OnRecv);
+    cli->SuppressCoderNotFoundWarning();
+    cli->SetDriveMode(LLBC_IService::ExternalDrive);
+    cli->SetPollerType(pollerType);
+    cli->Start(1);
+
+    std::vector<int> sessionIds;
+    for (int i = 0; i < _sessionCount; i++)
+    {
+        const int sessionId = cli->Connect(_runIp.c_str(), port);
+        if (sessionId == 0)
+        {
+            LLBC_FilePrintLine(stderr, "Connect to server failed, err: %s", LLBC_FormatLastError());
+            LLBC_Delete(cli);
+            LLBC_Delete(svr);
+
+            return LLBC_FAILED;
+        }
+
+        sessionIds.push_back(sessionId);
+    }
+
+    // Send packets window by window(round-robin sessions), every window drive both services until
+    // all packets echoed back, the first window use to warm up(not count).
+    int sent = 0;
+    sint64 begTime = 0;
+    sint64 begBytes = 0;
+    std::vector<char> payload(_packetSize, 'x');
+    const int totalCount = _packetCount + _windowSize;
+    while (sent < totalCount)
+    {
+        if (sent == _windowSize)
+        {
+            begTime = LLBC_GetMicroSeconds();
+            begBytes = cliFacade->GetRecvedBytes();
+        }
+
+        const int windowEnd = MIN(sent + _windowSize, totalCount);
+        for (; sent < windowEnd; sent++)
+            cli->Send(sessionIds[sent % _sessionCount], OPCODE, &payload[0], payload.size(), 0);
+
+        const sint64 waitBegTime = LLBC_GetMilliSeconds();
+        while (cliFacade->GetRecved() < windowEnd &&
+               LLBC_GetMilliSeconds() - waitBegTime < 5000)
+        {
+            cli->OnSvc(false);
+            svr->OnSvc(false);
+        }
+
+        if (cliFacade->GetRecved() < windowEnd)
+            break;
+    }
+
+    const sint64 elapsed = MAX(LLBC_GetMicroSeconds() - begTime, 1);
+    const int echoed = cliFacade->GetRecved() - _windowSize;
+    const sint64 echoedBytes = cliFacade->GetRecvedBytes() - begBytes;
+    LLBC_PrintLine("poller: %-13s, sessions: %d, packets: %d/%d, size: %d, elapsed: %.3f ms, "
+                   "throughput: %.0f packets/s, %.2f MB/s",
+                   LLBC_PollerType::Type2Str(svr->GetPollerType()).c_str(),
+                   _sessionCount,
+                   echoed,
+                   _packetCount,
+                   _packetSize,
+                   elapsed / 1000.0,
+                   echoed * 1000000.0 / elapsed,
+                   echoedBytes / static_cast<double>(elapsed));
+
+    LLBC_Delete(cli);
+    LLBC_Delete(svr);
+
+    return echoed == _packetCount ? LLBC_OK : LLBC_FAILED;
+}
@@ -0,0 +1,39 @@
+/**
+ * @file    TestCase_Comm_PollerBench.h
+ * @author  Longwei Lai<lailongwei@126.com>
+ * @date    2026/10/18
+ * @version 1.0
+ *
+ * @brief   The llbc library pollers(epoll/io_uring, ...) throughput comparison benchmark test case.
+ */
+#ifndef __LLBC_TEST_CASE_COMM_POLLER_BENCH_H__
+#define __LLBC_TEST_CASE_COMM_POLLER_BENCH_H__
+
+#include "llbc.h"
+using namespace llbc;
+
+class TestCase_Comm_PollerBench : public LLBC_BaseTestCase
+{
+public:
+    TestCase_Comm_PollerBench();
+    virtual ~TestCase_Comm_PollerBench();
+
+public:
+    virtual int Run(int argc, char *argv[]);
+
+private:
+    void FetchArgs(int argc, char *argv[]);
+
+    int RunBench(int pollerType);
+
+private:
+    LLBC_String _runIp;
+    int _runPort;
+
+    int _sessionCount;
+    int _packetCount;
+    int _packetSize;
+    int _windowSize;
+};
+
+#endif // !__LLBC_TEST_CASE_COMM_POLLER_BENCH_H__
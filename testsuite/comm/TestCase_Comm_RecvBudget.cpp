@@ -0,0 +1,308 @@
+/**
+ * @file    TestCase_Comm_RecvBudget.cpp
+ * @author  Longwei Lai<lailongwei@126.com>
+ * @date    2026/10/18
+ * @version 1.0
+ *
+ * @brief
+ */
+
+#include "comm/TestCase_Comm_RecvBudget.h"
+
+namespace
+{
+
+const int HOG_OPCODE = 1;
+const int PING_OPCODE = 2;
+
+const int HOG_PAYLOAD_SIZE = 16 * 1024;
+const int HOG_PER_FRAME_PACKETS = 64;
+
+class SvrFacade : public LLBC_IFacade
+{
+public:
+    SvrFacade()
+    : _hogRecvBytes(0)
+    {
+    }
+
+public:
+    virtual void OnSessionCreate(const LLBC_SessionInfo &sessionInfo)
+    {
+        if (!sessionInfo.IsListenSession())
+            _sessionIds.push_back(sessionInfo.GetSessionId());
+    }
+
+    void OnHog(LLBC_Packet &packet)
+    {
+        _hogRecvBytes += packet.GetPayloadLength();
+    }
+
+    void OnPing(LLBC_Packet &packet)
+    {
+        // Echo back.
+        GetService()->Send(packet.GetSessionId(),
+                           PING_OPCODE,
+                           packet.GetPayload(),
+                           packet.GetPayloadLength(),
+                           0);
+    }
+
+    sint64 GetHogRecvBytes() const
+    {
+        return _hogRecvBytes;
+    }
+
+    const std::vector<int> &GetSessionIds() const
+    {
+        return _sessionIds;
+    }
+
+private:
+    sint64 _hogRecvBytes;
+    std::vector<int> _sessionIds;
+};
+
+class HogFacade : public LLBC_IFacade
+{
+public:
+    HogFacade()
+    : _sending(false)
+    {
+        ::memset(_payload, 'h', sizeof(_payload));
+    }
+
+public:
+    virtual void OnSessionCreate(const LLBC_SessionInfo &sessionInfo)
+    {
+        _sessionIds.push_back(sessionInfo.GetSessionId());
+    }
+
+    virtual void OnUpdate()
+    {
+        if (!_sending)
+            return;
+
+        // Stream big packets as fast as possible.
+        for (size_t i = 0; i < _sessionIds.size(); i++)
+        {
+            for (int j = 0; j < HOG_PER_FRAME_PACKETS; j++)
+                GetService()->Send(_sessionIds[i], HOG_OPCODE, _payload, sizeof(_payload), 0);
+        }
+    }
+
+    void SetSending(bool sending)
+    {
+        _sending = sending;
+    }
+
+private:
+    volatile bool _sending;
+    char _payload[HOG_PAYLOAD_SIZE];
+    std::vector<int> _sessionIds;
+};
+
+class PingFacade : public LLBC_IFacade
+{
+public:
+    PingFacade()
+    : _pinging(false)
+    {
+    }
+
+public:
+    void Ping(int sessionId)
+    {
+        const sint64 now = LLBC_GetMicroSeconds();
+        GetService()->Send(sessionId, PING_OPCODE, &now, sizeof(now), 0);
+    }
+
+    void OnPong(LLBC_Packet &packet)
+    {
+        sint64 sendTime;
+        ::memcpy(&sendTime, packet.GetPayload(), sizeof(sendTime));
+        _rtts.push_back(LLBC_GetMicroSeconds() - sendTime);
+
+        if (_pinging)
+            Ping(packet.GetSessionId());
+    }
+
+    void SetPinging(bool pinging)
+    {
+        _pinging = pinging;
+    }
+
+    std::vector<sint64> &GetRtts()
+    {
+        return _rtts;
+    }
+
+private:
+    bool _pinging;
+    std::vector<sint64> _rtts;
+};
+
+}
+
+TestCase_Comm_RecvBudget::TestCase_Comm_RecvBudget()
+: _runIp("127.0.0.1")
+, _runPort(7788)
+
+, _hogSessionCount(2)
+, _pingSessionCount(4)
+, _budget(LLBC_CFG_COMM_DFT_RECV_BUDGET)
+, _duration(3000)
+{
+}
+
+TestCase_Comm_RecvBudget::~TestCase_Comm_RecvBudget()
+{
+}
+
+int TestCase_Comm_RecvBudget::Run(int argc, char *argv[])
+{
+    LLBC_PrintLine("Poller recv budget fairness test:");
+    LLBC_PrintLine("  usage: ./a [ip] [port] [hogSessionCount] [pingSessionCount] [budget] [duration(ms)]");
+
+    FetchArgs(argc, argv);
+
+    // Compare unlimited budget with given budget.
+    if (RunOnce(0, static_cast<uint16>(_runPort)) != LLBC_OK ||
+        RunOnce(static_cast<size_t>(_budget), static_cast<uint16>(_runPort + 1)) != LLBC_OK)
+        return LLBC_FAILED;
+
+    return LLBC_OK;
+}
+
+int TestCase_Comm_RecvBudget::RunOnce(size_t budget, uint16 port)
+{
+    // Create server service, all sessions in one poller, service driven by this thread.
+    LLBC_IService *svr = LLBC_IService::Create(LLBC_IService::Normal, "RecvBudgetSvr");
+    SvrFacade *svrFacade = LLBC_New(SvrFacade);
+    svr->RegisterFacade(svrFacade);
+    svr->Subscribe(HOG_OPCODE, svrFacade, &SvrFacade::OnHog);
+    svr->Subscribe(PING_OPCODE, svrFacade, &SvrFacade::OnPing);
+    svr->SuppressCoderNotFoundWarning();
+    svr->SetDriveMode(LLBC_IService::ExternalDrive);
+    svr->SetRecvBudget(budget);
+    if (svr->Start(1) != LLBC_OK ||
+        svr->Listen(_runIp.c_str(), port) == 0)
+    {
+        LLBC_FilePrintLine(stderr, "Start server service failed, err: %s", LLBC_FormatLastError());
+        LLBC_Delete(svr);
+
+        return LLBC_FAILED;
+    }
+
+    // Create hog client service, self driven, stream big packets.
+    LLBC_IService *hog = LLBC_IService::Create(LLBC_IService::Normal, "RecvBudgetHog");
+    HogFacade *hogFacade = LLBC_New(HogFacade);
+    hog->RegisterFacade(hogFacade);
+    hog->SuppressCoderNotFoundWarning();
+    hog->SetFPS(LLBC_CFG_COMM_MAX_SERVICE_FPS);
+    hog->Start(1);
+
+    // Create ping client service, driven by this thread.
+    LLBC_IService *pinger = LLBC_IService::Create(LLBC_IService::Normal, "RecvBudgetPinger");
+    PingFacade *pingFacade = LLBC_New(PingFacade);
+    pinger->RegisterFacade(pingFacade);
+    pinger->Subscribe(PING_OPCODE, pingFacade, &PingFacade::OnPong);
+    pinger->SuppressCoderNotFoundWarning();
+    pinger->SetDriveMode(LLBC_IService::ExternalDrive);
+    pinger->Start(1);
+
+    for (int i = 0; i < _hogSessionCount; i++)
+        hog->Connect(_runIp.c_str(), port);
+
+    std::vector<int> pingSessionIds;
+    for (int i = 0; i < _pingSessionCount; i++)
+        pingSessionIds.push_back(pinger->Connect(_runIp.c_str(), port));
+
+    // Start hog streaming, and ping-pong in same server poller.
+    hogFacade->SetSending(true);
+    pingFacade->SetPinging(true);
+    for (size_t i = 0; i < pingSessionIds.size(); i++)
+        pingFacade->Ping(pingSessionIds[i]);
+
+    const sint64 begTime = LLBC_GetMicroSeconds();
+    while (LLBC_GetMicroSeconds() - begTime < _duration * 1000LL)
+    {
+        svr->OnSvc(false);
+        pinger->OnSvc(false);
+    }
+    const sint64 elapsed = MAX(LLBC_GetMicroSeconds() - begTime, 1);
+
+    hogFacade->SetSending(false);
+    pingFacade->SetPinging(false);
+
+    // Query live sessions receive statistic before service receive statistic, poller update session
+    // statistic after service statistic, so sessions received bytes sum never exceed service received bytes.
+    LLBC_RecvStat sessionsRecvStat;
+    bool sessionStatOk = !svrFacade->GetSessionIds().empty();
+    for (size_t i = 0; i < svrFacade->GetSessionIds().size(); i++)
+    {
+        LLBC_RecvStat sessionRecvStat;
+        if (svr->GetSessionRecvStat(svrFacade->GetSessionIds()[i], sessionRecvStat) != LLBC_OK ||
+            sessionRecvStat.recvBytes == 0)
+            sessionStatOk = false;
+
+        sessionsRecvStat += sessionRecvStat;
+    }
+
+    LLBC_RecvStat recvStat;
+    svr->GetRecvStat(recvStat);
+    sessionStatOk = sessionStatOk && sessionsRecvStat.recvBytes <= recvStat.recvBytes;
+
+    std::vector<sint64> &rtts = pingFacade->GetRtts();
+    std::sort(rtts.begin(), rtts.end());
+
+    const bool succeed = !rtts.empty() && sessionStatOk;
+    if (succeed)
+    {
+        LLBC_PrintLine("[budget: %lu] hog: %.2f MB/s, pings: %d, ping rtt p50: %lld us, p99: %lld us, max: %lld us",
+                       static_cast<unsigned long>(budget),
+                       svrFacade->GetHogRecvBytes() / (1024.0 * 1024.0) * 1000000.0 / elapsed,
+                       static_cast<int>(rtts.size()),
+                       rtts[rtts.size() / 2],
+                       rtts[rtts.size() * 99 / 100],
+                       rtts.back());
+        LLBC_PrintLine("    server recv stat: %s", recvStat.ToString().c_str());
+        LLBC_PrintLine("    server live sessions(%d) recv stat: %s",
+                       static_cast<int>(svrFacade->GetSessionIds().size()),
+                       sessionsRecvStat.ToString().c_str());
+    }
+    else if (rtts.empty())
+    {
+        LLBC_FilePrintLine(stderr, "[budget: %lu] no ping-pong finished",
+                           static_cast<unsigned long>(budget));
+    }
+    else
+    {
+        LLBC_FilePrintLine(stderr, "[budget: %lu] live session recv stat mismatch, sessions: %s, server: %s",
+                           static_cast<unsigned long>(budget),
+                           sessionsRecvStat.ToString().c_str(),
+                           recvStat.ToString().c_str());
+    }
+
+    LLBC_Delete(pinger);
+    LLBC_Delete(hog);
+    LLBC_Delete(svr);
+
+    return succeed ? LLBC_OK : LLBC_FAILED;
+}
+
+void TestCase_Comm_RecvBudget::FetchArgs(int argc, char *argv[])
+{
+    if (argc > 1)
+        _runIp = argv[1];
+    if (argc > 2)
+        _runPort = LLBC_Str2Int32(argv[2]);
+    if (argc > 3)
+        _hogSessionCount = MAX(LLBC_Str2Int32(argv[3]), 1);
+    if (argc > 4)
+        _pingSessionCount = MAX(LLBC_Str2Int32(argv[4]), 1);
+    if (argc > 5)
+        _budget = MAX(LLBC_Str2Int32(argv[5]), 0);
+    if (argc > 6)
+        _duration = MAX(LLBC_Str2Int32(argv[6]), 100);
+}
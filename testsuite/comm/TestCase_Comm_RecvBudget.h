@@ -0,0 +1,39 @@
+/**
+ * @file    TestCase_Comm_RecvBudget.h
+ * @author  Longwei Lai<lailongwei@126.com>
+ * @date    2026/10/18
+ * @version 1.0
+ *
+ * @brief   The llbc library poller recv budget fairness test case.
+ */
+#ifndef __LLBC_TEST_CASE_COMM_RECV_BUDGET_H__
+#define __LLBC_TEST_CASE_COMM_RECV_BUDGET_H__
+
+#include "llbc.h"
+using namespace llbc;
+
+class TestCase_Comm_RecvBudget : public LLBC_BaseTestCase
+{
+public:
+    TestCase_Comm_RecvBudget();
+    virtual ~TestCase_Comm_RecvBudget();
+
+public:
+    virtual int Run(int argc, char *argv[]);
+
+private:
+    void FetchArgs(int argc, char *argv[]);
+
+    int RunOnce(size_t budget, uint16 port);
+
+private:
+    LLBC_String _runIp;
+    int _runPort;
+
+    int _hogSessionCount;
+    int _pingSessionCount;
+    int _budget;
+    int _duration;
+};
+
+#endif // !__LLBC_TEST_CASE_COMM_RECV_BUDGET_H__
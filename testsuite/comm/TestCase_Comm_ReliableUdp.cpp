@@ -0,0 +1,254 @@
+/**
+ * @file    TestCase_Comm_ReliableUdp.cpp
+ * @author  Longwei Lai<lailongwei@126.com>
+ * @date    2026/10/18
+ * @version 1.0
+ *
+ * @brief
+ */
+
+#include "comm/TestCase_Comm_ReliableUdp.h"
+
+namespace
+{
+
+const int DATA_OPCODE = 1;
+
+const int MAX_PAYLOAD_SIZE = 4000;
+
+/**
+ * Build sequence payload, payload length is vary, some payloads exceed mtu.
+ */
+void BuildPayload(int seq, LLBC_String &payload)
+{
+    const int len = static_cast<int>(sizeof(int)) + (seq * 97) % MAX_PAYLOAD_SIZE;
+
+    payload.resize(len);
+    ::memcpy(&payload[0], &seq, sizeof(int));
+    for (int i = static_cast<int>(sizeof(int)); i < len; i++)
+        payload[i] = static_cast<char>((seq + i) % 251);
+}
+
+/**
+ * Check sequence payload, return the sequence if payload valid, otherwise return -1.
+ */
+int CheckPayload(LLBC_Packet &packet)
+{
+    if (packet.GetPayloadLength() < sizeof(int))
+        return -1;
+
+    int seq;
+    const char *data = reinterpret_cast<const char *>(packet.GetPayload());
+    ::memcpy(&seq, data, sizeof(int));
+
+    LLBC_String expected;
+    BuildPayload(seq, expected);
+    if (expected.size() != packet.GetPayloadLength() ||
+        ::memcmp(expected.data(), data, expected.size()) != 0)
+        return -1;
+
+    return seq;
+}
+
+class DataFacade : public LLBC_IFacade
+{
+public:
+    DataFacade(bool echo)
+    : _echo(echo)
+
+    , _sessionId(0)
+    , _destroyed(false)
+
+    , _packets(0)
+    , _badPackets(0)
+    {
+    }
+
+public:
+    virtual void OnSessionCreate(const LLBC_SessionInfo &sessionInfo)
+    {
+        if (!sessionInfo.IsListenSession())
+            _sessionId = sessionInfo.GetSessionId();
+    }
+
+    virtual void OnSessionDestroy(const LLBC_SessionDestroyInfo &destroyInfo)
+    {
+        if (destroyInfo.GetSessionId() == _sessionId)
+            _destroyed = true;
+    }
+
+public:
+    void OnData(LLBC_Packet &packet)
+    {
+        // Packets must be delivered in order and not corrupted.
+        if (CheckPayload(packet) != _packets)
+            _badPackets += 1;
+
+        _packets += 1;
+
+        if (_echo)
+            GetService()->Send(packet.GetSessionId(),
+                               DATA_OPCODE,
+                               packet.GetPayload(),
+                               packet.GetPayloadLength(),
+                               0);
+    }
+
+public:
+    int GetSessionId() const
+    {
+        return _sessionId;
+    }
+
+    bool IsDestroyed() const
+    {
+        return _destroyed;
+    }
+
+    int GetPackets() const
+    {
+        return _packets;
+    }
+
+    int GetBadPackets() const
+    {
+        return _badPackets;
+    }
+
+private:
+    bool _echo;
+
+    volatile int _sessionId;
+    volatile bool _destroyed;
+
+    volatile int _packets;
+    volatile int _badPackets;
+};
+
+/**
+ * Create reliable udp service.
+ */
+LLBC_IService *CreateService(const char *name, DataFacade *facade, const LLBC_ReliableUdpOptions &opts)
+{
+    LLBC_IService *svc = LLBC_IService::Create(LLBC_IService::Normal, name);
+    svc->RegisterFacade(facade);
+    svc->Subscribe(DATA_OPCODE, facade, &DataFacade::OnData);
+    svc->SuppressCoderNotFoundWarning();
+    svc->SetReliableUdpOptions(opts);
+
+    return svc;
+}
+
+}
+
+TestCase_Comm_ReliableUdp::TestCase_Comm_ReliableUdp()
+: _runIp("127.0.0.1")
+, _runPort(7788)
+
+, _packetCount(500)
+, _lossRate(0.1)
+, _latency(20)
+, _jitter(10)
+{
+}
+
+TestCase_Comm_ReliableUdp::~TestCase_Comm_ReliableUdp()
+{
+}
+
+int TestCase_Comm_ReliableUdp::Run(int argc, char *argv[])
+{
+    LLBC_PrintLine("Reliable udp session test:");
+    LLBC_PrintLine("  usage: ./a [ip] [port] [packetCount] [lossRate] [latency] [jitter]");
+
+    FetchArgs(argc, argv);
+
+    LLBC_ReliableUdpOptions opts;
+    opts.lossRate = _lossRate;
+    opts.latency = _latency;
+    opts.jitter = _jitter;
+    LLBC_PrintLine("Options: %s", opts.ToString().c_str());
+
+    DataFacade *svrFacade = LLBC_New1(DataFacade, true);
+    LLBC_IService *svr = CreateService("ReliableUdpSvr", svrFacade, opts);
+    if (svr->Start(1) != LLBC_OK ||
+        svr->ListenReliableUdp(_runIp.c_str(), _runPort) == 0)
+    {
+        LLBC_FilePrintLine(stderr, "Start server service failed, err: %s", LLBC_FormatLastError());
+        LLBC_Delete(svr);
+
+        return LLBC_FAILED;
+    }
+
+    DataFacade *cliFacade = LLBC_New1(DataFacade, false);
+    LLBC_IService *cli = CreateService("ReliableUdpCli", cliFacade, opts);
+    cli->Start(1);
+
+    const int sessionId = cli->ConnectReliableUdp(_runIp.c_str(), _runPort);
+    if (sessionId == 0)
+    {
+        LLBC_FilePrintLine(stderr, "Connect to server failed, err: %s", LLBC_FormatLastError());
+        LLBC_Delete(cli);
+        LLBC_Delete(svr);
+
+        return LLBC_FAILED;
+    }
+
+    // Send sequence packets, server check and echo back.
+    const sint64 begTime = LLBC_GetMilliSeconds();
+
+    LLBC_String payload;
+    for (int seq = 0; seq < _packetCount; seq++)
+    {
+        BuildPayload(seq, payload);
+        cli->Send(sessionId, DATA_OPCODE, payload.data(), payload.size(), 0);
+    }
+
+    while (cliFacade->GetPackets() < _packetCount &&
+        LLBC_GetMilliSeconds() - begTime < 60000)
+        LLBC_Sleep(10);
+
+    LLBC_PrintLine("Transfer finished, elapsed: %lld ms, server recv: %d(bad: %d), client recv echo: %d(bad: %d)",
+                   LLBC_GetMilliSeconds() - begTime,
+                   svrFacade->GetPackets(),
+                   svrFacade->GetBadPackets(),
+                   cliFacade->GetPackets(),
+                   cliFacade->GetBadPackets());
+
+    bool succeed = svrFacade->GetPackets() == _packetCount &&
+                   svrFacade->GetBadPackets() == 0 &&
+                   cliFacade->GetPackets() == _packetCount &&
+                   cliFacade->GetBadPackets() == 0;
+
+    // Delete client, the fin datagram will cause server session destroyed.
+    LLBC_Delete(cli);
+
+    const sint64 closeBegTime = LLBC_GetMilliSeconds();
+    while (!svrFacade->IsDestroyed() &&
+        LLBC_GetMilliSeconds() - closeBegTime < 5000)
+        LLBC_Sleep(10);
+
+    LLBC_PrintLine("Client deleted, server session destroyed: %s", svrFacade->IsDestroyed() ? "true" : "false");
+    if (!svrFacade->IsDestroyed())
+        succeed = false;
+
+    LLBC_Delete(svr);
+
+    return succeed ? LLBC_OK : LLBC_FAILED;
+}
+
+void TestCase_Comm_ReliableUdp::FetchArgs(int argc, char *argv[])
+{
+    if (argc > 1)
+        _runIp = argv[1];
+    if (argc > 2)
+        _runPort = LLBC_Str2Int32(argv[2]);
+    if (argc > 3)
+        _packetCount = MAX(LLBC_Str2Int32(argv[3]), 1);
+    if (argc > 4)
+        _lossRate = LLBC_Str2Double(argv[4]);
+    if (argc > 5)
+        _latency = MAX(LLBC_Str2Int32(argv[5]), 0);
+    if (argc > 6)
+        _jitter = MAX(LLBC_Str2Int32(argv[6]), 0);
+}
@@ -0,0 +1,37 @@
+/**
+ * @file    TestCase_Comm_ReliableUdp.h
+ * @author  Longwei Lai<lailongwei@126.com>
+ * @date    2026/10/18
+ * @version 1.0
+ *
+ * @brief   The llbc library reliable udp session test case.
+ */
+#ifndef __LLBC_TEST_CASE_COMM_RELIABLE_UDP_H__
+#define __LLBC_TEST_CASE_COMM_RELIABLE_UDP_H__
+
+#include "llbc.h"
+using namespace llbc;
+
+class TestCase_Comm_ReliableUdp : public LLBC_BaseTestCase
+{
+public:
+    TestCase_Comm_ReliableUdp();
+    virtual ~TestCase_Comm_ReliableUdp();
+
+public:
+    virtual int Run(int argc, char *argv[]);
+
+private:
+    void FetchArgs(int argc, char *argv[]);
+
+private:
+    LLBC_String _runIp;
+    int _runPort;
+
+    int _packetCount;
+    double _lossRate;
+    int _latency;
+    int _jitter;
+};
+
+#endif // !__LLBC_TEST_CASE_COMM_RELIABLE_UDP_H__
@@ -0,0 +1,157 @@
+/**
+ * @file    TestCase_Comm_ReusePortListen.cpp
+ * @author  Longwei Lai<lailongwei@126.com>
+ * @date    2026/10/18
+ * @version 1.0
+ *
+ * @brief
+ */
+
+#include "comm/TestCase_Comm_ReusePortListen.h"
+
+namespace
+{
+
+class SvrFacade : public LLBC_IFacade
+{
+public:
+    SvrFacade(int pollerCount)
+    : _pollerCount(pollerCount)
+    , _acceptedCount(0)
+    , _pollerAccepted(pollerCount, 0)
+    {
+    }
+
+public:
+    virtual void OnSessionCreate(const LLBC_SessionInfo &sessionInfo)
+    {
+        if (sessionInfo.IsListenSession())
+            return;
+
+        // Accepted session's owner poller is sessionId % pollerCount.
+        _pollerAccepted[sessionInfo.GetSessionId() % _pollerCount] += 1;
+        _acceptedCount += 1;
+    }
+
+    sint32 GetAcceptedCount() const
+    {
+        return _acceptedCount;
+    }
+
+    LLBC_String GetPollerAcceptedDesc() const
+    {
+        LLBC_String desc;
+        for (size_t i = 0; i < _pollerAccepted.size(); i++)
+            desc.append_format("%s%d", i == 0 ? "" : "/", _pollerAccepted[i]);
+
+        return desc;
+    }
+
+private:
+    const int _pollerCount;
+    volatile sint32 _acceptedCount;
+    std::vector<int> _pollerAccepted;
+};
+
+}
+
+TestCase_Comm_ReusePortListen::TestCase_Comm_ReusePortListen()
+: _runIp("127.0.0.1")
+, _runPort(7788)
+
+, _pollerCount(4)
+, _connCount(2000)
+{
+}
+
+TestCase_Comm_ReusePortListen::~TestCase_Comm_ReusePortListen()
+{
+}
+
+int TestCase_Comm_ReusePortListen::Run(int argc, char *argv[])
+{
+    LLBC_PrintLine("SO_REUSEPORT multi-acceptor listen test:");
+    LLBC_PrintLine("  usage: ./a [ip] [port] [pollerCount] [connCount]");
+
+    FetchArgs(argc, argv);
+
+    if (RunOnce(false, static_cast<uint16>(_runPort)) != LLBC_OK ||
+        RunOnce(true, static_cast<uint16>(_runPort + 1)) != LLBC_OK)
+        return LLBC_FAILED;
+
+    return LLBC_OK;
+}
+
+int TestCase_Comm_ReusePortListen::RunOnce(bool reusePort, uint16 port)
+{
+    const char *modeName = reusePort ? "reuseport" : "single";
+
+    // Create server service.
+    LLBC_IService *svr = LLBC_IService::Create(LLBC_IService::Normal, "ReusePortListenSvr");
+    SvrFacade *svrFacade = LLBC_New1(SvrFacade, _pollerCount);
+    svr->RegisterFacade(svrFacade);
+    svr->SuppressCoderNotFoundWarning();
+    if (svr->Start(_pollerCount) != LLBC_OK)
+    {
+        LLBC_FilePrintLine(stderr, "Start server service failed, err: %s", LLBC_FormatLastError());
+        LLBC_Delete(svr);
+
+        return LLBC_FAILED;
+    }
+
+    int listenRet;
+    LLBC_SessionIdList listenSessionIds;
+    if (reusePort)
+        listenRet = svr->ListenReusePort(_runIp.c_str(), port, listenSessionIds);
+    else
+        listenRet = svr->Listen(_runIp.c_str(), port) != 0 ? LLBC_OK : LLBC_FAILED;
+    if (listenRet != LLBC_OK)
+    {
+        LLBC_FilePrintLine(stderr, "[%s] Listen failed, err: %s", modeName, LLBC_FormatLastError());
+        LLBC_Delete(svr);
+
+        return LLBC_FAILED;
+    }
+
+    // Create client service and async connect to server, simulate login storm.
+    LLBC_IService *cli = LLBC_IService::Create(LLBC_IService::Normal, "ReusePortListenCli");
+    cli->SuppressCoderNotFoundWarning();
+    cli->Start(_pollerCount);
+
+    const sint64 begTime = LLBC_GetMicroSeconds();
+    for (int i = 0; i < _connCount; i++)
+        cli->AsyncConn(_runIp.c_str(), port);
+
+    while (svrFacade->GetAcceptedCount() < _connCount &&
+        LLBC_GetMicroSeconds() - begTime < 30 * 1000000LL)
+        LLBC_Sleep(1);
+    const sint64 elapsed = MAX(LLBC_GetMicroSeconds() - begTime, 1);
+
+    LLBC_PrintLine("[%s] listen sessions: %d, accepted: %d/%d, elapsed: %.3f ms, accept rate: %.0f conns/s",
+                   modeName,
+                   reusePort ? static_cast<int>(listenSessionIds.size()) : 1,
+                   svrFacade->GetAcceptedCount(),
+                   _connCount,
+                   elapsed / 1000.0,
+                   svrFacade->GetAcceptedCount() * 1000000.0 / elapsed);
+    LLBC_PrintLine("    sessions per poller: %s", svrFacade->GetPollerAcceptedDesc().c_str());
+
+    const bool succeed = svrFacade->GetAcceptedCount() == _connCount;
+
+    LLBC_Delete(cli);
+    LLBC_Delete(svr);
+
+    return succeed ? LLBC_OK : LLBC_FAILED;
+}
+
+void TestCase_Comm_ReusePortListen::FetchArgs(int argc, char *argv[])
+{
+    if (argc > 1)
+        _runIp = argv[1];
+    if (argc > 2)
+        _runPort = LLBC_Str2Int32(argv[2]);
+    if (argc > 3)
+        _pollerCount = MAX(LLBC_Str2Int32(argv[3]), 1);
+    if (argc > 4)
+        _connCount = MAX(LLBC_Str2Int32(argv[4]), 1);
+}
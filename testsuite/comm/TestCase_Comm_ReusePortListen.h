@@ -0,0 +1,37 @@
+/**
+ * @file    TestCase_Comm_ReusePortListen.h
+ * @author  Longwei Lai<lailongwei@126.com>
+ * @date    2026/10/18
+ * @version 1.0
+ *
+ * @brief   The llbc library SO_REUSEPORT multi-acceptor listen test case.
+ */
+#ifndef __LLBC_TEST_CASE_COMM_REUSE_PORT_LISTEN_H__
+#define __LLBC_TEST_CASE_COMM_REUSE_PORT_LISTEN_H__
+
+#include "llbc.h"
+using namespace llbc;
+
+class TestCase_Comm_ReusePortListen : public LLBC_BaseTestCase
+{
+public:
+    TestCase_Comm_ReusePortListen();
+    virtual ~TestCase_Comm_ReusePortListen();
+
+public:
+    virtual int Run(int argc, char *argv[]);
+
+private:
+    void FetchArgs(int argc, char *argv[]);
+
+    int RunOnce(bool reusePort, uint16 port);
+
+private:
+    LLBC_String _runIp;
+    int _runPort;
+
+    int _pollerCount;
+    int _connCount;
+};
+
+#endif // !__LLBC_TEST_CASE_COMM_REUSE_PORT_LISTEN_H__
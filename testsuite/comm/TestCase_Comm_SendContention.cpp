@@ -0,0 +1,210 @@
+/**
+ * @file    TestCase_Comm_SendContention.cpp
+ * @author  Longwei Lai<lailongwei@126.com>
+ * @date    2026/10/18
+ * @version 1.0
+ *
+ * @brief
+ */
+
+#include "comm/TestCase_Comm_SendContention.h"
+
+namespace
+{
+
+const int OPCODE = 1;
+const int PAYLOAD_SIZE = 64;
+const int MAX_SENDER_THREADS = 16;
+
+class RecvFacade : public LLBC_IFacade
+{
+public:
+    RecvFacade()
+    : _recvCount(0)
+    {
+    }
+
+public:
+    void OnRecv(LLBC_Packet &packet)
+    {
+        _recvCount += 1;
+    }
+
+    sint32 GetRecvCount() const
+    {
+        return _recvCount;
+    }
+
+    void ResetRecvCount()
+    {
+        _recvCount = 0;
+    }
+
+private:
+    volatile sint32 _recvCount;
+};
+
+class SendTask : public LLBC_BaseTask
+{
+public:
+    SendTask(LLBC_IService *svc, const std::vector<int> &sessionIds, int perThreadCount)
+    : _svc(svc)
+    , _sessionIds(sessionIds)
+    , _perThreadCount(perThreadCount)
+    , _threadIdx(0)
+    , _failedCount(0)
+    {
+        ::memset(_payload, 'a', sizeof(_payload));
+    }
+
+public:
+    virtual void Svc()
+    {
+        const int threadIdx = LLBC_AtomicFetchAndAdd(&_threadIdx, 1);
+        const size_t sessionCount = _sessionIds.size();
+
+        int failed = 0;
+        for (int i = 0; i < _perThreadCount; i++)
+        {
+            const int sessionId = _sessionIds[(threadIdx + i) % sessionCount];
+            if (_svc->Send(sessionId, OPCODE, _payload, sizeof(_payload), 0) != LLBC_OK)
+                failed += 1;
+        }
+
+        LLBC_AtomicFetchAndAdd(&_failedCount, failed);
+    }
+
+    virtual void Cleanup()
+    {
+    }
+
+public:
+    sint32 GetFailedCount()
+    {
+        return LLBC_AtomicGet(&_failedCount);
+    }
+
+private:
+    LLBC_IService *_svc;
+    const std::vector<int> &_sessionIds;
+    const int _perThreadCount;
+
+    volatile sint32 _threadIdx;
+    volatile sint32 _failedCount;
+
+    char _payload[PAYLOAD_SIZE];
+};
+
+}
+
+TestCase_Comm_SendContention::TestCase_Comm_SendContention()
+: _runIp("127.0.0.1")
+, _runPort(7788)
+
+, _sessionCount(32)
+, _packetCount(1000000)
+{
+}
+
+TestCase_Comm_SendContention::~TestCase_Comm_SendContention()
+{
+}
+
+int TestCase_Comm_SendContention::Run(int argc, char *argv[])
+{
+    LLBC_PrintLine("Service send contention benchmark:");
+    LLBC_PrintLine("  usage: ./a [ip] [port] [sessionCount] [packetCount]");
+
+    FetchArgs(argc, argv);
+
+    // Create server service.
+    LLBC_IService *svr = LLBC_IService::Create(LLBC_IService::Normal, "SendContentionSvr");
+    RecvFacade *facade = LLBC_New(RecvFacade);
+    svr->RegisterFacade(facade);
+    svr->Subscribe(OPCODE, facade, &RecvFacade::OnRecv);
+    svr->SuppressCoderNotFoundWarning();
+    svr->SetFPS(LLBC_CFG_COMM_MAX_SERVICE_FPS);
+    if (svr->Start(2) != LLBC_OK ||
+        svr->Listen(_runIp.c_str(), _runPort) == 0)
+    {
+        LLBC_FilePrintLine(stderr, "Start server service failed, err: %s", LLBC_FormatLastError());
+        LLBC_Delete(svr);
+
+        return LLBC_FAILED;
+    }
+
+    // Create client service and connect to server.
+    LLBC_IService *cli = LLBC_IService::Create(LLBC_IService::Normal, "SendContentionCli");
+    cli->SuppressCoderNotFoundWarning();
+    cli->Start(4);
+
+    std::vector<int> sessionIds;
+    for (int i = 0; i < _sessionCount; i++)
+    {
+        const int sessionId = cli->Connect(_runIp.c_str(), _runPort);
+        if (sessionId == 0)
+        {
+            LLBC_FilePrintLine(stderr, "Connect to %s:%d failed, err: %s",
+                _runIp.c_str(), _runPort, LLBC_FormatLastError());
+            LLBC_Delete(cli);
+            LLBC_Delete(svr);
+
+            return LLBC_FAILED;
+        }
+
+        sessionIds.push_back(sessionId);
+    }
+
+    // Wait all sessions created.
+    LLBC_Sleep(500);
+
+    LLBC_PrintLine("%8s %12s %14s %14s %8s", "threads", "packets", "send(pkt/s)", "e2e(pkt/s)", "failed");
+    for (int threads = 1; threads <= MAX_SENDER_THREADS; threads *= 2)
+    {
+        facade->ResetRecvCount();
+
+        const int perThreadCount = _packetCount / threads;
+        const int totalCount = perThreadCount * threads;
+        SendTask *task = LLBC_New3(SendTask, cli, sessionIds, perThreadCount);
+
+        const sint64 begTime = LLBC_GetMilliSeconds();
+        task->Activate(threads);
+        task->Wait();
+        const sint64 sendElapsed = MAX(LLBC_GetMilliSeconds() - begTime, 1);
+
+        const int failed = task->GetFailedCount();
+        const int expectRecv = totalCount - failed;
+
+        // Wait server received all packets(at most 30 seconds).
+        while (facade->GetRecvCount() < expectRecv &&
+            LLBC_GetMilliSeconds() - begTime < 30000)
+            LLBC_Sleep(1);
+        const sint64 e2eElapsed = MAX(LLBC_GetMilliSeconds() - begTime, 1);
+
+        LLBC_PrintLine("%8d %12d %14.0f %14.0f %8d",
+                       threads,
+                       totalCount,
+                       totalCount * 1000.0 / sendElapsed,
+                       facade->GetRecvCount() * 1000.0 / e2eElapsed,
+                       failed);
+
+        LLBC_Delete(task);
+    }
+
+    LLBC_Delete(cli);
+    LLBC_Delete(svr);
+
+    return LLBC_OK;
+}
+
+void TestCase_Comm_SendContention::FetchArgs(int argc, char *argv[])
+{
+    if (argc > 1)
+        _runIp = argv[1];
+    if (argc > 2)
+        _runPort = LLBC_Str2Int32(argv[2]);
+    if (argc > 3)
+        _sessionCount = MAX(LLBC_Str2Int32(argv[3]), 1);
+    if (argc > 4)
+        _packetCount = MAX(LLBC_Str2Int32(argv[4]), MAX_SENDER_THREADS);
+}
@@ -0,0 +1,35 @@
+/**
+ * @file    TestCase_Comm_SendContention.h
+ * @author  Longwei Lai<lailongwei@126.com>
+ * @date    2026/10/18
+ * @version 1.0
+ *
+ * @brief   The llbc library service multi-thread Send() contention benchmark test case.
+ */
+#ifndef __LLBC_TEST_CASE_COMM_SEND_CONTENTION_H__
+#define __LLBC_TEST_CASE_COMM_SEND_CONTENTION_H__
+
+#include "llbc.h"
+using namespace llbc;
+
+class TestCase_Comm_SendContention : public LLBC_BaseTestCase
+{
+public:
+    TestCase_Comm_SendContention();
+    virtual ~TestCase_Comm_SendContention();
+
+public:
+    virtual int Run(int argc, char *argv[]);
+
+private:
+    void FetchArgs(int argc, char *argv[]);
+
+private:
+    LLBC_String _runIp;
+    int _runPort;
+
+    int _sessionCount;
+    int _packetCount;
+};
+
+#endif // !__LLBC_TEST_CASE_COMM_SEND_CONTENTION_H__
@@ -0,0 +1,214 @@
+/**
+ * @file    TestCase_Comm_SendV.cpp
+ * @author  Longwei Lai<lailongwei@126.com>
+ * @date    2026/10/18
+ * @version 1.0
+ *
+ * @brief
+ */
+
+#include "comm/TestCase_Comm_SendV.h"
+
+namespace
+{
+
+const int OPCODE = 1;
+const int MIN_PAYLOAD_SIZE = 8;
+
+// Payload layout: [sint32 seq][sint32 len][fill bytes: (seq + idx) & 0xff].
+void FillPayload(std::vector<char> &payload, sint32 seq, int len)
+{
+    payload.resize(len);
+    ::memcpy(&payload[0], &seq, sizeof(seq));
+    ::memcpy(&payload[4], &len, sizeof(len));
+    for (int i = MIN_PAYLOAD_SIZE; i < len; i++)
+        payload[i] = static_cast<char>((seq + i) & 0xff);
+}
+
+class SvrFacade : public LLBC_IFacade
+{
+public:
+    SvrFacade()
+    : _recvCount(0)
+    , _badCount(0)
+    {
+    }
+
+public:
+    void OnRecv(LLBC_Packet &packet)
+    {
+        _recvCount += 1;
+
+        const char *payload = reinterpret_cast<const char *>(packet.GetPayload());
+        const size_t len = packet.GetPayloadLength();
+        if (len < static_cast<size_t>(MIN_PAYLOAD_SIZE))
+        {
+            _badCount += 1;
+            return;
+        }
+
+        // Check packet order and content, one session's packets must arrive in send order.
+        sint32 seq, payloadLen;
+        ::memcpy(&seq, payload, sizeof(seq));
+        ::memcpy(&payloadLen, payload + 4, sizeof(payloadLen));
+
+        sint32 &expectSeq = _expectSeqs[packet.GetSessionId()];
+        if (seq != expectSeq || payloadLen != static_cast<sint32>(len))
+        {
+            _badCount += 1;
+            expectSeq = seq + 1;
+            return;
+        }
+
+        expectSeq += 1;
+        for (size_t i = MIN_PAYLOAD_SIZE; i < len; i++)
+        {
+            if (payload[i] != static_cast<char>((seq + i) & 0xff))
+            {
+                _badCount += 1;
+                break;
+            }
+        }
+    }
+
+    sint32 GetRecvCount() const
+    {
+        return _recvCount;
+    }
+
+    sint32 GetBadCount() const
+    {
+        return _badCount;
+    }
+
+private:
+    volatile sint32 _recvCount;
+    volatile sint32 _badCount;
+
+    std::map<int, sint32> _expectSeqs;
+};
+
+}
+
+TestCase_Comm_SendV::TestCase_Comm_SendV()
+: _runIp("127.0.0.1")
+, _runPort(7788)
+
+, _sessionCount(4)
+, _packetCount(200000)
+, _maxPayloadSize(512)
+{
+}
+
+TestCase_Comm_SendV::~TestCase_Comm_SendV()
+{
+}
+
+int TestCase_Comm_SendV::Run(int argc, char *argv[])
+{
+    LLBC_PrintLine("Socket gather-send(writev) flush test:");
+    LLBC_PrintLine("  usage: ./a [ip] [port] [sessionCount] [packetCount] [maxPayloadSize]");
+
+    FetchArgs(argc, argv);
+
+    // Create server service.
+    LLBC_IService *svr = LLBC_IService::Create(LLBC_IService::Normal, "SendVSvr");
+    SvrFacade *svrFacade = LLBC_New(SvrFacade);
+    svr->RegisterFacade(svrFacade);
+    svr->Subscribe(OPCODE, svrFacade, &SvrFacade::OnRecv);
+    svr->SuppressCoderNotFoundWarning();
+    if (svr->Start(1) != LLBC_OK ||
+        svr->Listen(_runIp.c_str(), _runPort) == 0)
+    {
+        LLBC_FilePrintLine(stderr, "Start server service failed, err: %s", LLBC_FormatLastError());
+        LLBC_Delete(svr);
+
+        return LLBC_FAILED;
+    }
+
+    // Create client service and connect to server.
+    LLBC_IService *cli = LLBC_IService::Create(LLBC_IService::Normal, "SendVCli");
+    cli->SuppressCoderNotFoundWarning();
+    cli->Start(1);
+
+    std::vector<int> sessionIds;
+    for (int i = 0; i < _sessionCount; i++)
+    {
+        const int sessionId = cli->Connect(_runIp.c_str(), _runPort);
+        if (sessionId == 0)
+        {
+            LLBC_FilePrintLine(stderr, "Connect to server failed, err: %s", LLBC_FormatLastError());
+            break;
+        }
+
+        sessionIds.push_back(sessionId);
+    }
+
+    if (sessionIds.empty())
+    {
+        LLBC_Delete(cli);
+        LLBC_Delete(svr);
+
+        return LLBC_FAILED;
+    }
+
+    // Burst send random size packets, socket send buffer will be filled, queued blocks will flush
+    // by gather-send, and partial sent block will be resumed in next writable event.
+    std::vector<char> payload;
+    std::vector<sint32> seqs(sessionIds.size(), 0);
+
+    sint64 totalBytes = 0;
+    const sint64 begTime = LLBC_GetMicroSeconds();
+    for (int i = 0; i < _packetCount; i++)
+    {
+        const size_t sessionIdx = i % sessionIds.size();
+        const int len = static_cast<int>(LLBC_Random::RandInt32cmon(MIN_PAYLOAD_SIZE, _maxPayloadSize + 1));
+        FillPayload(payload, seqs[sessionIdx]++, len);
+        if (cli->Send(sessionIds[sessionIdx], OPCODE, &payload[0], payload.size(), 0) != LLBC_OK)
+        {
+            LLBC_FilePrintLine(stderr, "Send packet failed, err: %s", LLBC_FormatLastError());
+            break;
+        }
+
+        totalBytes += len;
+    }
+
+    while (svrFacade->GetRecvCount() < _packetCount &&
+        LLBC_GetMicroSeconds() - begTime < 60 * 1000000LL)
+        LLBC_Sleep(1);
+    const sint64 elapsed = MAX(LLBC_GetMicroSeconds() - begTime, 1);
+
+    LLBC_SendStat sendStat;
+    cli->GetSendStat(sendStat);
+
+    LLBC_PrintLine("sessions: %d, packets: %d, payload: [%d, %d] bytes",
+                   static_cast<int>(sessionIds.size()), _packetCount, MIN_PAYLOAD_SIZE, _maxPayloadSize);
+    LLBC_PrintLine("received: %d/%d, bad: %d, elapsed: %.3f ms, throughput: %.2f MB/s",
+                   svrFacade->GetRecvCount(),
+                   _packetCount,
+                   svrFacade->GetBadCount(),
+                   elapsed / 1000.0,
+                   totalBytes / (1024.0 * 1024.0) * 1000000.0 / elapsed);
+    LLBC_PrintLine("client send stat: %s", sendStat.ToString().c_str());
+
+    const bool succeed = svrFacade->GetRecvCount() == _packetCount && svrFacade->GetBadCount() == 0;
+
+    LLBC_Delete(cli);
+    LLBC_Delete(svr);
+
+    return succeed ? LLBC_OK : LLBC_FAILED;
+}
+
+void TestCase_Comm_SendV::FetchArgs(int argc, char *argv[])
+{
+    if (argc > 1)
+        _runIp = argv[1];
+    if (argc > 2)
+        _runPort = LLBC_Str2Int32(argv[2]);
+    if (argc > 3)
+        _sessionCount = MAX(LLBC_Str2Int32(argv[3]), 1);
+    if (argc > 4)
+        _packetCount = MAX(LLBC_Str2Int32(argv[4]), 1);
+    if (argc > 5)
+        _maxPayloadSize = MAX(LLBC_Str2Int32(argv[5]), MIN_PAYLOAD_SIZE);
+}
@@ -0,0 +1,36 @@
+/**
+ * @file    TestCase_Comm_SendV.h
+ * @author  Longwei Lai<lailongwei@126.com>
+ * @date    2026/10/18
+ * @version 1.0
+ *
+ * @brief   The llbc library socket gather-send(writev) flush test case.
+ */
+#ifndef __LLBC_TEST_CASE_COMM_SEND_V_H__
+#define __LLBC_TEST_CASE_COMM_SEND_V_H__
+
+#include "llbc.h"
+using namespace llbc;
+
+class TestCase_Comm_SendV : public LLBC_BaseTestCase
+{
+public:
+    TestCase_Comm_SendV();
+    virtual ~TestCase_Comm_SendV();
+
+public:
+    virtual int Run(int argc, char *argv[]);
+
+private:
+    void FetchArgs(int argc, char *argv[]);
+
+private:
+    LLBC_String _runIp;
+    int _runPort;
+
+    int _sessionCount;
+    int _packetCount;
+    int _maxPayloadSize;
+};
+
+#endif // !__LLBC_TEST_CASE_COMM_SEND_V_H__
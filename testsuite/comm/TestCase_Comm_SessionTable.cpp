@@ -0,0 +1,188 @@
+/**
+ * @file    TestCase_Comm_SessionTable.cpp
+ * @author  Longwei Lai<lailongwei@126.com>
+ * @date    2026/10/18
+ * @version 1.0
+ *
+ * @brief
+ */
+
+#include "comm/TestCase_Comm_SessionTable.h"
+
+namespace
+{
+
+const int OPCODE = 1;
+const int PAYLOAD_SIZE = 16;
+const int SESSION_COUNTS[] = {1000, 10000, 100000};
+
+class RecvFacade : public LLBC_IFacade
+{
+public:
+    RecvFacade()
+    : _recvCount(0)
+    , _sessionCount(0)
+    {
+    }
+
+public:
+    virtual void OnSessionCreate(const LLBC_SessionInfo &sessionInfo)
+    {
+        _sessionCount += 1;
+    }
+
+    virtual void OnSessionDestroy(const LLBC_SessionDestroyInfo &destroyInfo)
+    {
+        _sessionCount -= 1;
+    }
+
+    void OnRecv(LLBC_Packet &packet)
+    {
+        _recvCount += 1;
+    }
+
+    sint32 GetRecvCount() const
+    {
+        return _recvCount;
+    }
+
+    sint32 GetSessionCount() const
+    {
+        return _sessionCount;
+    }
+
+private:
+    volatile sint32 _recvCount;
+    volatile sint32 _sessionCount;
+};
+
+}
+
+TestCase_Comm_SessionTable::TestCase_Comm_SessionTable()
+: _runIp("127.0.0.1")
+, _runPort(7788)
+
+, _packetCount(1000000)
+{
+}
+
+TestCase_Comm_SessionTable::~TestCase_Comm_SessionTable()
+{
+}
+
+int TestCase_Comm_SessionTable::Run(int argc, char *argv[])
+{
+    LLBC_PrintLine("Poller session table benchmark:");
+    LLBC_PrintLine("  usage: ./a [ip] [port] [packetCount]");
+    LLBC_PrintLine("  note: every session use 2 fds in this process, raise `ulimit -n` to run 100k sessions");
+
+    FetchArgs(argc, argv);
+
+    LLBC_PrintLine("%10s %10s %10s %12s %14s", "sessions", "connected", "accepted", "packets", "events/s");
+    for (size_t i = 0; i < sizeof(SESSION_COUNTS) / sizeof(SESSION_COUNTS[0]); i++)
+    {
+        if (RunOnce(SESSION_COUNTS[i]) != LLBC_OK)
+            return LLBC_FAILED;
+
+        _runPort += 1;
+    }
+
+    return LLBC_OK;
+}
+
+void TestCase_Comm_SessionTable::FetchArgs(int argc, char *argv[])
+{
+    if (argc > 1)
+        _runIp = argv[1];
+    if (argc > 2)
+        _runPort = LLBC_Str2Int32(argv[2]);
+    if (argc > 3)
+        _packetCount = MAX(LLBC_Str2Int32(argv[3]), 1);
+}
+
+int TestCase_Comm_SessionTable::RunOnce(int sessionCount)
+{
+    // Create server service.
+    LLBC_IService *svr = LLBC_IService::Create(LLBC_IService::Normal, "SessionTableSvr");
+    RecvFacade *facade = LLBC_New(RecvFacade);
+    svr->RegisterFacade(facade);
+    svr->Subscribe(OPCODE, facade, &RecvFacade::OnRecv);
+    svr->SuppressCoderNotFoundWarning();
+    svr->SetFPS(LLBC_CFG_COMM_MAX_SERVICE_FPS);
+    if (svr->Start(2) != LLBC_OK ||
+        svr->Listen(_runIp.c_str(), _runPort) == 0)
+    {
+        LLBC_FilePrintLine(stderr, "Start server service failed, err: %s", LLBC_FormatLastError());
+        LLBC_Delete(svr);
+
+        return LLBC_FAILED;
+    }
+
+    // Create client service and connect to server, stop connect when fds exhausted.
+    LLBC_IService *cli = LLBC_IService::Create(LLBC_IService::Normal, "SessionTableCli");
+    cli->SuppressCoderNotFoundWarning();
+    cli->Start(2);
+
+    std::vector<int> sessionIds;
+    sessionIds.reserve(sessionCount);
+    for (int i = 0; i < sessionCount; i++)
+    {
+        const int sessionId = cli->Connect(_runIp.c_str(), _runPort);
+        if (sessionId == 0)
+            break;
+
+        sessionIds.push_back(sessionId);
+    }
+
+    if (sessionIds.empty())
+    {
+        LLBC_FilePrintLine(stderr, "Connect to %s:%d failed, err: %s",
+            _runIp.c_str(), _runPort, LLBC_FormatLastError());
+        LLBC_Delete(cli);
+        LLBC_Delete(svr);
+
+        return LLBC_FAILED;
+    }
+
+    // Wait all sessions created, if server fds exhausted, the not accepted sessions packets will lost.
+    const sint64 connectedTime = LLBC_GetMilliSeconds();
+    while (facade->GetSessionCount() < static_cast<sint32>(sessionIds.size()) &&
+        LLBC_GetMilliSeconds() - connectedTime < 5000)
+        LLBC_Sleep(10);
+    const int accepted = facade->GetSessionCount();
+
+    // Send packets to sessions in stride order, make every lookup touch different session.
+    char payload[PAYLOAD_SIZE];
+    ::memset(payload, 'a', sizeof(payload));
+
+    int sent = 0;
+    const size_t connected = sessionIds.size();
+    const sint64 begTime = LLBC_GetMilliSeconds();
+    for (int i = 0; i < _packetCount; i++)
+    {
+        const int sessionId = sessionIds[static_cast<size_t>(static_cast<uint64>(i) * 7919 % connected)];
+        if (cli->Send(sessionId, OPCODE, payload, sizeof(payload), 0) == LLBC_OK)
+            sent += 1;
+    }
+
+    // Wait server received all packets(at most 30 seconds).
+    while (facade->GetRecvCount() < sent &&
+        LLBC_GetMilliSeconds() - begTime < 30000)
+        LLBC_Sleep(1);
+    const sint64 elapsed = MAX(LLBC_GetMilliSeconds() - begTime, 1);
+
+    // If fds exhausted, label the row with the actual session count, not the requested one.
+    const bool exhausted = accepted < sessionCount;
+    LLBC_PrintLine("%10d %10d %10d %12d %14.0f%s",
+                   exhausted ? accepted : sessionCount,
+                   static_cast<int>(connected),
+                   accepted,
+                   facade->GetRecvCount(),
+                   facade->GetRecvCount() * 1000.0 / elapsed,
+                   exhausted ? LLBC_String().format("  (requested %d, fds exhausted)", sessionCount).c_str() : "");
+
+    LLBC_Delete(cli);
+    LLBC_Delete(svr);
+
+    return LLBC_OK;
+}
@@ -0,0 +1,35 @@
+/**
+ * @file    TestCase_Comm_SessionTable.h
+ * @author  Longwei Lai<lailongwei@126.com>
+ * @date    2026/10/18
+ * @version 1.0
+ *
+ * @brief   The llbc library poller session table lookup benchmark test case.
+ */
+#ifndef __LLBC_TEST_CASE_COMM_SESSION_TABLE_H__
+#define __LLBC_TEST_CASE_COMM_SESSION_TABLE_H__
+
+#include "llbc.h"
+using namespace llbc;
+
+class TestCase_Comm_SessionTable : public LLBC_BaseTestCase
+{
+public:
+    TestCase_Comm_SessionTable();
+    virtual ~TestCase_Comm_SessionTable();
+
+public:
+    virtual int Run(int argc, char *argv[]);
+
+private:
+    void FetchArgs(int argc, char *argv[]);
+    int RunOnce(int sessionCount);
+
+private:
+    LLBC_String _runIp;
+    int _runPort;
+
+    int _packetCount;
+};
+
+#endif // !__LLBC_TEST_CASE_COMM_SESSION_TABLE_H__
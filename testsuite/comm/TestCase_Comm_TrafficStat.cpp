@@ -0,0 +1,451 @@
+/**
+ * @file    TestCase_Comm_TrafficStat.cpp
+ * @author  Longwei Lai<lailongwei@126.com>
+ * @date    2026/10/18
+ * @version 1.0
+ *
+ * @brief
+ */
+
+#include "comm/TestCase_Comm_TrafficStat.h"
+
+namespace
+{
+
+const int ECHO_OPCODE = 1;
+const int QUERY_OPCODE = 2;
+
+// The 500k packets/s per-packet time budget, in nano-seconds.
+const double PACKET_BUDGET_NS = 1000000000.0 / 500000;
+
+/**
+ * The timed coder, encode/decode at least 2 micro-seconds, make sampled timing non-zero.
+ */
+class TimedCoder : public LLBC_ICoder
+{
+public:
+    virtual bool Encode(LLBC_Packet &packet)
+    {
+        Spin();
+        packet.Write(_data.data(), _data.size());
+
+        return true;
+    }
+
+    virtual bool Decode(LLBC_Packet &packet)
+    {
+        Spin();
+        _data.assign(reinterpret_cast<const char *>(packet.GetPayload()), packet.GetPayloadLength());
+
+        return true;
+    }
+
+    const LLBC_String &GetData() const
+    {
+        return _data;
+    }
+
+    void SetData(const LLBC_String &data)
+    {
+        _data = data;
+    }
+
+private:
+    static void Spin()
+    {
+        const sint64 begTime = LLBC_GetMicroSeconds();
+        while (LLBC_GetMicroSeconds() - begTime < 2);
+    }
+
+private:
+    LLBC_String _data;
+};
+
+class TimedCoderFactory : public LLBC_ICoderFactory
+{
+public:
+    virtual LLBC_ICoder *Create() const
+    {
+        return LLBC_New(TimedCoder);
+    }
+};
+
+class EchoFacade : public LLBC_IFacade
+{
+public:
+    void OnRecv(LLBC_Packet &packet)
+    {
+        // Decoded packet echo by timed coder, otherwise echo raw payload.
+        TimedCoder *decoder = static_cast<TimedCoder *>(packet.GetDecoder());
+        if (decoder)
+        {
+            TimedCoder *encoder = LLBC_New(TimedCoder);
+            encoder->SetData(decoder->GetData());
+            GetService()->Send(packet.GetSessionId(), packet.GetOpcode(), static_cast<LLBC_ICoder *>(encoder), 0);
+
+            return;
+        }
+
+        GetService()->Send(packet.GetSessionId(),
+                           packet.GetOpcode(),
+                           packet.GetPayload(),
+                           packet.GetPayloadLength(),
+                           0);
+    }
+};
+
+class CliFacade : public LLBC_IFacade
+{
+public:
+    CliFacade()
+    : _recved(0)
+    {
+    }
+
+public:
+    void OnRecv(LLBC_Packet &packet)
+    {
+        ++_recved;
+    }
+
+    int GetRecved() const
+    {
+        return _recved;
+    }
+
+private:
+    int _recved;
+};
+
+/**
+ * Check opcode counter, the server echo all packets, so sent equal to received.
+ */
+bool CheckCounter(const LLBC_TrafficCounter &counter, uint64 packets, uint64 bytes)
+{
+    return counter.recvPackets == packets &&
+           counter.recvBytes == bytes &&
+           counter.sentPackets == packets &&
+           counter.sentBytes == bytes &&
+           counter.handleSamples > 0 &&
+           counter.encodeSamples > 0;
+}
+
+/**
+ * Check timed coder encode/decode timing recorded.
+ */
+bool CheckCoderTiming(const LLBC_TrafficCounter &counter)
+{
+    return counter.encodeSamples > 0 &&
+           counter.encodeTime > 0 &&
+           counter.decodeSamples > 0 &&
+           counter.decodeTime > 0;
+}
+
+}
+
+TestCase_Comm_TrafficStat::TestCase_Comm_TrafficStat()
+: _runIp("127.0.0.1")
+, _runPort(7788)
+
+, _sessionCount(16)
+, _packetCount(500000)
+, _packetSize(64)
+, _windowSize(8192)
+, _rounds(5)
+{
+}
+
+TestCase_Comm_TrafficStat::~TestCase_Comm_TrafficStat()
+{
+}
+
+int TestCase_Comm_TrafficStat::Run(int argc, char *argv[])
+{
+    LLBC_PrintLine("Service traffic statistic test:");
+    LLBC_PrintLine("  usage: ./a [ip] [port] [sessionCount] [packetCount] [packetSize] [windowSize] [rounds]");
+
+    FetchArgs(argc, argv);
+
+    if (TestCounters(_runPort) != LLBC_OK)
+        return LLBC_FAILED;
+
+    if (BenchCollector() != LLBC_OK)
+        return LLBC_FAILED;
+
+    // Run rounds alternately, accumulate every mode elapsed time to smooth machine noise.
+    sint64 totalElapsed[2] = {0, 0};
+    for (int round = 0; round < _rounds; round++)
+    {
+        for (int mode = 0; mode < 2; mode++)
+        {
+            sint64 elapsed;
+            const int port = _runPort + 1 + round * 2 + mode;
+            if (RunBench(port, mode == 1, elapsed) != LLBC_OK)
+                return LLBC_FAILED;
+
+            totalElapsed[mode] += elapsed;
+        }
+    }
+
+    const double disabledThroughput = _packetCount * _rounds * 1000000.0 / totalElapsed[0];
+    const double enabledThroughput = _packetCount * _rounds * 1000000.0 / totalElapsed[1];
+    const double overhead = (totalElapsed[1] - totalElapsed[0]) * 100.0 / totalElapsed[0];
+    LLBC_PrintLine("[overhead] rounds: %d, avg throughput, disabled: %.0f packets/s, enabled: %.0f packets/s, "
+                   "overhead: %.2f%%(network noise included, collector cost checked above)",
+                   _rounds, disabledThroughput, enabledThroughput, overhead);
+
+    return LLBC_OK;
+}
+
+void TestCase_Comm_TrafficStat::FetchArgs(int argc, char *argv[])
+{
+    if (argc > 1)
+        _runIp = argv[1];
+    if (argc > 2)
+        _runPort = LLBC_Str2Int32(argv[2]);
+    if (argc > 3)
+        _sessionCount = MAX(LLBC_Str2Int32(argv[3]), 1);
+    if (argc > 4)
+        _packetCount = MAX(LLBC_Str2Int32(argv[4]), 1);
+    if (argc > 5)
+        _packetSize = MAX(LLBC_Str2Int32(argv[5]), 1);
+    if (argc > 6)
+        _windowSize = MAX(LLBC_Str2Int32(argv[6]), 1);
+    if (argc > 7)
+        _rounds = MAX(LLBC_Str2Int32(argv[7]), 1);
+}
+
+int TestCase_Comm_TrafficStat::TestCounters(int port)
+{
+    LLBC_PrintLine("[counters] echo packets on two opcodes, check server snapshot");
+
+    LLBC_IService *svr = LLBC_IService::Create(LLBC_IService::Normal, "TrafficStatSvr");
+    EchoFacade *svrFacade = LLBC_New(EchoFacade);
+    svr->RegisterFacade(svrFacade);
+    svr->Subscribe(ECHO_OPCODE, svrFacade, &EchoFacade::OnRecv);
+    svr->Subscribe(QUERY_OPCODE, svrFacade, &EchoFacade::OnRecv);
+    svr->RegisterCoder(ECHO_OPCODE, LLBC_New(TimedCoderFactory));
+    svr->SuppressCoderNotFoundWarning();
+    svr->SetTrafficStat(true);
+    if (svr->Start(1) != LLBC_OK ||
+        svr->Listen(_runIp.c_str(), port) == 0)
+    {
+        LLBC_FilePrintLine(stderr, "Start server service failed, err: %s", LLBC_FormatLastError());
+        LLBC_Delete(svr);
+
+        return LLBC_FAILED;
+    }
+
+    LLBC_IService *cli = LLBC_IService::Create(LLBC_IService::Normal, "TrafficStatCli");
+    CliFacade *cliFacade = LLBC_New(CliFacade);
+    cli->RegisterFacade(cliFacade);
+    cli->Subscribe(ECHO_OPCODE, cliFacade, &CliFacade::OnRecv);
+    cli->Subscribe(QUERY_OPCODE, cliFacade, &CliFacade::OnRecv);
+    cli->SuppressCoderNotFoundWarning();
+    cli->Start(1);
+
+    const int sessionId = cli->Connect(_runIp.c_str(), port);
+    if (sessionId == 0)
+    {
+        LLBC_FilePrintLine(stderr, "Connect to server failed, err: %s", LLBC_FormatLastError());
+        LLBC_Delete(cli);
+        LLBC_Delete(svr);
+
+        return LLBC_FAILED;
+    }
+
+    const int echoPackets = 1000;
+    const int queryPackets = 100;
+    const size_t echoSize = 100;
+    const size_t querySize = 1000;
+    std::vector<char> payload(querySize, 'q');
+    for (int i = 0; i < echoPackets; i++)
+        cli->Send(sessionId, ECHO_OPCODE, &payload[0], echoSize, 0);
+    for (int i = 0; i < queryPackets; i++)
+        cli->Send(sessionId, QUERY_OPCODE, &payload[0], querySize, 0);
+
+    const sint64 begTime = LLBC_GetMilliSeconds();
+    while (cliFacade->GetRecved() < echoPackets + queryPackets &&
+        LLBC_GetMilliSeconds() - begTime < 5000)
+        LLBC_Sleep(10);
+
+    LLBC_TrafficStat stat;
+    svr->GetTrafficStat(stat);
+    LLBC_PrintLine("%s", stat.ToString().c_str());
+
+    const bool succeed = stat.opcodes.size() == 2 &&
+                         stat.sessions.size() == 1 &&
+                         CheckCounter(stat.opcodes[ECHO_OPCODE], echoPackets, echoPackets * echoSize) &&
+                         CheckCounter(stat.opcodes[QUERY_OPCODE], queryPackets, queryPackets * querySize) &&
+                         CheckCoderTiming(stat.opcodes[ECHO_OPCODE]) &&
+                         stat.total.recvPackets == echoPackets + queryPackets &&
+                         stat.sessions.begin()->second.sentPackets == echoPackets + queryPackets &&
+                         CheckCoderTiming(stat.sessions.begin()->second);
+
+    // The statistic disabled service snapshot will fail.
+    LLBC_TrafficStat cliStat;
+    const bool cliFailed = cli->GetTrafficStat(cliStat) != LLBC_OK;
+
+    LLBC_Delete(cli);
+    LLBC_Delete(svr);
+
+    return succeed && cliFailed ? LLBC_OK : LLBC_FAILED;
+}
+
+int TestCase_Comm_TrafficStat::RunBench(int port, bool statEnabled, sint64 &elapsed)
+{
+    elapsed = 0;
+
+    LLBC_IService *svr = LLBC_IService::Create(LLBC_IService::Normal, "TrafficStatBenchSvr");
+    EchoFacade *svrFacade = LLBC_New(EchoFacade);
+    svr->RegisterFacade(svrFacade);
+    svr->Subscribe(ECHO_OPCODE, svrFacade, &EchoFacade::OnRecv);
+    svr->SuppressCoderNotFoundWarning();
+    svr->SetDriveMode(LLBC_IService::ExternalDrive);
+    svr->SetTrafficStat(statEnabled);
+    if (svr->Start(1) != LLBC_OK ||
+        svr->Listen(_runIp.c_str(), port) == 0)
+    {
+        LLBC_FilePrintLine(stderr, "Start server service failed, err: %s", LLBC_FormatLastError());
+        LLBC_Delete(svr);
+
+        return LLBC_FAILED;
+    }
+
+    LLBC_IService *cli = LLBC_IService::Create(LLBC_IService::Normal, "TrafficStatBenchCli");
+    CliFacade *cliFacade = LLBC_New(CliFacade);
+    cli->RegisterFacade(cliFacade);
+    cli->Subscribe(ECHO_OPCODE, cliFacade, &CliFacade::OnRecv);
+    cli->SuppressCoderNotFoundWarning();
+    cli->SetDriveMode(LLBC_IService::ExternalDrive);
+    cli->SetTrafficStat(statEnabled);
+    cli->Start(1);
+
+    std::vector<int> sessionIds;
+    for (int i = 0; i < _sessionCount; i++)
+    {
+        const int sessionId = cli->Connect(_runIp.c_str(), port);
+        if (sessionId == 0)
+        {
+            LLBC_FilePrintLine(stderr, "Connect to server failed, err: %s", LLBC_FormatLastError());
+            LLBC_Delete(cli);
+            LLBC_Delete(svr);
+
+            return LLBC_FAILED;
+        }
+
+        sessionIds.push_back(sessionId);
+    }
+
+    // Send packets window by window, the first window use to warm up(not count).
+    int sent = 0;
+    sint64 begTime = 0;
+    std::vector<char> payload(_packetSize, 'x');
+    const int totalCount = _packetCount + _windowSize;
+    while (sent < totalCount)
+    {
+        if (sent == _windowSize)
+            begTime = LLBC_GetMicroSeconds();
+
+        const int windowEnd = MIN(sent + _windowSize, totalCount);
+        for (; sent < windowEnd; sent++)
+            cli->Send(sessionIds[sent % _sessionCount], ECHO_OPCODE, &payload[0], payload.size(), 0);
+
+        const sint64 waitBegTime = LLBC_GetMilliSeconds();
+        while (cliFacade->GetRecved() < windowEnd &&
+               LLBC_GetMilliSeconds() - waitBegTime < 5000)
+        {
+            cli->OnSvc(false);
+            svr->OnSvc(false);
+        }
+
+        if (cliFacade->GetRecved() < windowEnd)
+            break;
+    }
+
+    elapsed = MAX(LLBC_GetMicroSeconds() - begTime, 1);
+    const int echoed = cliFacade->GetRecved() - _windowSize;
+    const double throughput = echoed * 1000000.0 / elapsed;
+    LLBC_PrintLine("[bench] traffic stat: %-8s, sessions: %d, packets: %d/%d, size: %d, elapsed: %.3f ms, "
+                   "throughput: %.0f packets/s",
+                   statEnabled ? "enabled" : "disabled",
+                   _sessionCount,
+                   echoed,
+                   _packetCount,
+                   _packetSize,
+                   elapsed / 1000.0,
+                   throughput);
+
+    if (statEnabled)
+    {
+        LLBC_TrafficStat stat;
+        svr->GetTrafficStat(stat);
+        LLBC_PrintLine("  server %s", stat.total.ToString().c_str());
+    }
+
+    LLBC_Delete(cli);
+    LLBC_Delete(svr);
+
+    return echoed == _packetCount ? LLBC_OK : LLBC_FAILED;
+}
+
+int TestCase_Comm_TrafficStat::BenchCollector()
+{
+    // Isolate collector cost: same dispatch-like loop(recv sample check, recv record, send sample check,
+    // send record), with and without collector calls, the difference is the collector cost per packet.
+    LLBC_PrintLine("[collector] %d sessions, %d packets x %d repetitions", _sessionCount, _packetCount, _rounds * 4);
+
+    sint64 baselineElapsed = LLONG_MAX, collectorElapsed = LLONG_MAX;
+    uint64 sum = 0;
+    for (int rep = 0; rep < _rounds * 4; rep++)
+    {
+        // Baseline loop, only read packet fields and read clock on sampled packets(same as collector loop).
+        sint64 begTime = LLBC_GetMicroSeconds();
+        for (int i = 0; i < _packetCount; i++)
+        {
+            const int sessionId = i % _sessionCount + 1;
+            if ((i & (LLBC_CFG_COMM_TRAFFIC_STAT_TIMING_SAMPLE - 1)) == 0)
+            {
+                const sint64 timingBegTime = LLBC_GetMicroSeconds();
+                sum += static_cast<uint64>(LLBC_GetMicroSeconds() - timingBegTime);
+            }
+            sum += sessionId + _packetSize;
+        }
+        baselineElapsed = MIN(baselineElapsed, LLBC_GetMicroSeconds() - begTime);
+
+        // Collector loop, new collector every repetition(same as service restart).
+        LLBC_TrafficStatCollector *collector = LLBC_New(LLBC_TrafficStatCollector);
+        begTime = LLBC_GetMicroSeconds();
+        for (int i = 0; i < _packetCount; i++)
+        {
+            const int sessionId = i % _sessionCount + 1;
+            const bool recvTiming = collector->IsRecvTimingSample();
+            const sint64 timingBegTime = recvTiming ? LLBC_GetMicroSeconds() : 0;
+            collector->OnRecved(sessionId, ECHO_OPCODE, _packetSize, recvTiming ? 0 : -1,
+                                recvTiming ? MAX(LLBC_GetMicroSeconds() - timingBegTime, 0) : -1);
+
+            const bool sendTiming = collector->IsSendTimingSample();
+            collector->OnSent(sessionId, ECHO_OPCODE, _packetSize, sendTiming ? 0 : -1);
+            sum += sessionId + _packetSize;
+        }
+        collectorElapsed = MIN(collectorElapsed, LLBC_GetMicroSeconds() - begTime);
+
+        LLBC_TrafficStat stat;
+        collector->Snapshot(stat);
+        sum += stat.total.recvPackets;
+        LLBC_Delete(collector);
+    }
+
+    const double costNs = MAX(collectorElapsed - baselineElapsed, 0) * 1000.0 / _packetCount;
+    const double costPercent = costNs * 100.0 / PACKET_BUDGET_NS;
+    LLBC_PrintLine("    baseline: %.1f ns/packet, with collector: %.1f ns/packet, collector cost: %.1f ns/packet, "
+                   "%.2f%% of 500k packets/s budget(target < 2%%): %s(checksum: %llu)",
+                   baselineElapsed * 1000.0 / _packetCount,
+                   collectorElapsed * 1000.0 / _packetCount,
+                   costNs,
+                   costPercent,
+                   costPercent < 2.0 ? "ok" : "exceeded",
+                   static_cast<unsigned long long>(sum));
+
+    return costPercent < 2.0 ? LLBC_OK : LLBC_FAILED;
+}
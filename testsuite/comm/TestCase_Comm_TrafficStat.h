@@ -0,0 +1,60 @@
+/**
+ * @file    TestCase_Comm_TrafficStat.h
+ * @author  Longwei Lai<lailongwei@126.com>
+ * @date    2026/10/18
+ * @version 1.0
+ *
+ * @brief   The llbc library service traffic statistic test case(include overhead benchmark).
+ */
+#ifndef __LLBC_TEST_CASE_COMM_TRAFFIC_STAT_H__
+#define __LLBC_TEST_CASE_COMM_TRAFFIC_STAT_H__
+
+#include "llbc.h"
+using namespace llbc;
+
+class TestCase_Comm_TrafficStat : public LLBC_BaseTestCase
+{
+public:
+    TestCase_Comm_TrafficStat();
+    virtual ~TestCase_Comm_TrafficStat();
+
+public:
+    virtual int Run(int argc, char *argv[]);
+
+private:
+    void FetchArgs(int argc, char *argv[]);
+
+    /**
+     * Test per-opcode and per-session counters correctness.
+     * @param[in] port - the listen port.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    int TestCounters(int port);
+
+    /**
+     * Benchmark traffic statistic collector cost in dispatch-like loop, without network and service.
+     * @return int - return 0 if collector cost less than 2% of 500k packets/s budget, otherwise return -1.
+     */
+    int BenchCollector();
+
+    /**
+     * Run echo benchmark.
+     * @param[in]  port        - the listen port.
+     * @param[in]  statEnabled - enable traffic statistic or not.
+     * @param[out] elapsed     - the benchmark elapsed time, in micro-seconds.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    int RunBench(int port, bool statEnabled, sint64 &elapsed);
+
+private:
+    LLBC_String _runIp;
+    int _runPort;
+
+    int _sessionCount;
+    int _packetCount;
+    int _packetSize;
+    int _windowSize;
+    int _rounds;
+};
+
+#endif // !__LLBC_TEST_CASE_COMM_TRAFFIC_STAT_H__
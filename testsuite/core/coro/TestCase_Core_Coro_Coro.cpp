@@ -0,0 +1,281 @@
+/**
+ * @file    TestCase_Core_Coro_Coro.cpp
+ * @author  Longwei Lai<lailongwei@126.com>
+ * @date    2026/10/18
+ * @version 1.0
+ *
+ * @brief
+ */
+
+#include "core/coro/TestCase_Core_Coro_Coro.h"
+
+namespace
+{
+
+/**
+ * Get process resident memory size, in bytes, if not supported, return -1.
+ */
+sint64 GetResidentMemory()
+{
+#if LLBC_TARGET_PLATFORM_LINUX
+    FILE *fp = ::fopen("/proc/self/statm", "r");
+    if (!fp)
+        return -1;
+
+    long pages = 0, residentPages = 0;
+    const int ret = ::fscanf(fp, "%ld %ld", &pages, &residentPages);
+    ::fclose(fp);
+
+    return ret == 2 ? static_cast<sint64>(residentPages) * ::sysconf(_SC_PAGESIZE) : -1;
+#else
+    return -1;
+#endif
+}
+
+/**
+ * The basic test task, suspend specified times, and record the steps.
+ */
+class StepTask
+{
+public:
+    StepTask(int suspendTimes, bool nested)
+    : _suspendTimes(suspendTimes)
+    , _nested(nested)
+    , _steps(0)
+    , _errors(0)
+    {
+    }
+
+public:
+    void Run()
+    {
+        LLBC_Coro *self = LLBC_Coro::GetCurrent();
+        if (!self || self->GetState() != LLBC_Coro::Running)
+            _errors += 1;
+
+        // Nested coroutine suspend back to this coroutine, not the thread.
+        if (_nested)
+        {
+            StepTask inner(1, false);
+            LLBC_Coro *innerCoro = LLBC_New1(LLBC_Coro, new LLBC_Delegate0<StepTask>(&inner, &StepTask::Run));
+            if (innerCoro->Resume() != LLBC_OK ||
+                LLBC_Coro::GetCurrent() != self ||
+                innerCoro->Resume() != LLBC_OK ||
+                innerCoro->GetState() != LLBC_Coro::Dead ||
+                inner.GetSteps() != 2 ||
+                inner.GetErrors() != 0)
+                _errors += 1;
+
+            LLBC_Delete(innerCoro);
+        }
+
+        for (int i = 0; i < _suspendTimes; i++)
+        {
+            _steps += 1;
+            if (LLBC_Coro::Suspend() != LLBC_OK ||
+                LLBC_Coro::GetCurrent() != self)
+                _errors += 1;
+        }
+
+        _steps += 1;
+    }
+
+public:
+    int GetSteps() const
+    {
+        return _steps;
+    }
+
+    int GetErrors() const
+    {
+        return _errors;
+    }
+
+private:
+    const int _suspendTimes;
+    const bool _nested;
+    int _steps;
+    int _errors;
+};
+
+/**
+ * The switch test task, suspend forever.
+ */
+class SwitchTask
+{
+public:
+    void Run()
+    {
+        while (true)
+            LLBC_Coro::Suspend();
+    }
+};
+
+}
+
+TestCase_Core_Coro_Coro::TestCase_Core_Coro_Coro()
+: _switchTimes(1000000)
+, _coroCount(10000)
+{
+}
+
+TestCase_Core_Coro_Coro::~TestCase_Core_Coro_Coro()
+{
+}
+
+int TestCase_Core_Coro_Coro::Run(int argc, char *argv[])
+{
+    LLBC_PrintLine("Stackful coroutine test:");
+    LLBC_PrintLine("  usage: ./a [switchTimes] [coroCount]");
+
+    FetchArgs(argc, argv);
+
+    if (TestBasic() != LLBC_OK ||
+        TestSwitchCost() != LLBC_OK ||
+        TestMemory() != LLBC_OK)
+        return LLBC_FAILED;
+
+    return LLBC_OK;
+}
+
+void TestCase_Core_Coro_Coro::FetchArgs(int argc, char *argv[])
+{
+    if (argc > 1)
+        _switchTimes = MAX(LLBC_Str2Int32(argv[1]), 1);
+    if (argc > 2)
+        _coroCount = MAX(LLBC_Str2Int32(argv[2]), 1);
+}
+
+int TestCase_Core_Coro_Coro::TestBasic()
+{
+    // Suspend not in coroutine will fail.
+    const bool suspendOutOk = LLBC_Coro::Suspend() != LLBC_OK &&
+                              LLBC_GetLastError() == LLBC_ERROR_ILLEGAL &&
+                              LLBC_Coro::GetCurrent() == NULL;
+
+    StepTask task(3, true);
+    LLBC_Coro *coro = LLBC_New1(LLBC_Coro, new LLBC_Delegate0<StepTask>(&task, &StepTask::Run));
+    bool stateOk = coro->GetState() == LLBC_Coro::Ready && coro->GetId() > 0;
+
+    int resumes = 0;
+    while (coro->GetState() != LLBC_Coro::Dead)
+    {
+        if (coro->Resume() != LLBC_OK)
+            break;
+
+        resumes += 1;
+        if (coro->GetState() != LLBC_Coro::Dead)
+            stateOk = stateOk &&
+                      coro->GetState() == LLBC_Coro::Suspended &&
+                      task.GetSteps() == resumes;
+    }
+
+    // Resume dead coroutine will fail.
+    const bool resumeDeadOk = coro->Resume() != LLBC_OK && LLBC_GetLastError() == LLBC_ERROR_END;
+    LLBC_Delete(coro);
+
+    LLBC_PrintLine("[basic] suspend out of coroutine: %s, resumes: %d, steps: %d, state: %s, "
+                   "resume dead coroutine: %s, task errors: %d",
+                   suspendOutOk ? "failed(ok)" : "succeed(bad)",
+                   resumes,
+                   task.GetSteps(),
+                   stateOk ? "ok" : "bad",
+                   resumeDeadOk ? "failed(ok)" : "succeed(bad)",
+                   task.GetErrors());
+
+    return suspendOutOk &&
+           resumes == 4 &&
+           task.GetSteps() == 4 &&
+           stateOk &&
+           resumeDeadOk &&
+           task.GetErrors() == 0 ? LLBC_OK : LLBC_FAILED;
+}
+
+int TestCase_Core_Coro_Coro::TestSwitchCost()
+{
+    SwitchTask task;
+    LLBC_Coro *coro = LLBC_New1(LLBC_Coro, new LLBC_Delegate0<SwitchTask>(&task, &SwitchTask::Run));
+
+    // Warm up, allocate stack and context.
+    if (coro->Resume() != LLBC_OK)
+    {
+        LLBC_FilePrintLine(stderr, "Resume coroutine failed, err: %s", LLBC_FormatLastError());
+        LLBC_Delete(coro);
+
+        return LLBC_FAILED;
+    }
+
+    const sint64 begTime = LLBC_GetMicroSeconds();
+    for (int i = 0; i < _switchTimes; i++)
+        coro->Resume();
+    const sint64 elapsed = MAX(LLBC_GetMicroSeconds() - begTime, 1);
+
+    LLBC_Delete(coro);
+
+    LLBC_PrintLine("[switch] resume+suspend times: %d, elapsed: %.3f ms, per round-trip: %.1f ns",
+                   _switchTimes,
+                   elapsed / 1000.0,
+                   elapsed * 1000.0 / _switchTimes);
+
+    return LLBC_OK;
+}
+
+int TestCase_Core_Coro_Coro::TestMemory()
+{
+    SwitchTask task;
+    std::vector<LLBC_Coro *> coros;
+    coros.reserve(_coroCount);
+
+    const size_t pooledBeg = LLBC_Coro::GetPooledStackCount();
+    const sint64 rssBeg = GetResidentMemory();
+    const sint64 begTime = LLBC_GetMicroSeconds();
+
+    int suspended = 0;
+    for (int i = 0; i < _coroCount; i++)
+    {
+        LLBC_Coro *coro = LLBC_New1(LLBC_Coro, new LLBC_Delegate0<SwitchTask>(&task, &SwitchTask::Run));
+        if (coro->Resume() == LLBC_OK &&
+            coro->GetState() == LLBC_Coro::Suspended)
+            suspended += 1;
+
+        coros.push_back(coro);
+    }
+
+    const sint64 createElapsed = MAX(LLBC_GetMicroSeconds() - begTime, 1);
+    const sint64 rssEnd = GetResidentMemory();
+
+    // Destroy suspended coroutines, stacks return to pool(until pool full).
+    for (size_t i = 0; i < coros.size(); i++)
+        LLBC_Delete(coros[i]);
+    const size_t pooledEnd = LLBC_Coro::GetPooledStackCount();
+
+    // Create again, reuse pooled stacks.
+    const sint64 reuseBegTime = LLBC_GetMicroSeconds();
+    const int reuseCount = static_cast<int>(MIN(pooledEnd, coros.size()));
+    for (int i = 0; i < reuseCount; i++)
+    {
+        coros[i] = LLBC_New1(LLBC_Coro, new LLBC_Delegate0<SwitchTask>(&task, &SwitchTask::Run));
+        coros[i]->Resume();
+    }
+    const sint64 reuseElapsed = MAX(LLBC_GetMicroSeconds() - reuseBegTime, 1);
+    for (int i = 0; i < reuseCount; i++)
+        LLBC_Delete(coros[i]);
+
+    const sint64 rssDelta = rssBeg >= 0 && rssEnd >= 0 ? rssEnd - rssBeg : -1;
+    LLBC_PrintLine("[memory] suspended coroutines: %d/%d, stack size: %lu, "
+                   "rss delta: %lld bytes, per coroutine: %.1f bytes",
+                   suspended,
+                   _coroCount,
+                   static_cast<unsigned long>(LLBC_CFG_CORE_CORO_DFT_STACK_SIZE),
+                   rssDelta,
+                   rssDelta >= 0 ? rssDelta / static_cast<double>(_coroCount) : -1.0);
+    LLBC_PrintLine("[memory] create+first resume per coroutine: %.1f ns, reuse pooled stack per coroutine: %.1f ns, "
+                   "pooled stacks: %lu -> %lu",
+                   createElapsed * 1000.0 / _coroCount,
+                   reuseCount > 0 ? reuseElapsed * 1000.0 / reuseCount : 0.0,
+                   static_cast<unsigned long>(pooledBeg),
+                   static_cast<unsigned long>(pooledEnd));
+
+    return suspended == _coroCount &&
+           pooledEnd <= LLBC_CFG_CORE_CORO_MAX_POOLED_STACKS ? LLBC_OK : LLBC_FAILED;
+}
@@ -0,0 +1,50 @@
+/**
+ * @file    TestCase_Core_Coro_Coro.h
+ * @author  Longwei Lai<lailongwei@126.com>
+ * @date    2026/10/18
+ * @version 1.0
+ *
+ * @brief   The llbc library stackful coroutine test case.
+ */
+#ifndef __LLBC_TEST_CASE_CORE_CORO_CORO_H__
+#define __LLBC_TEST_CASE_CORE_CORO_CORO_H__
+
+#include "llbc.h"
+using namespace llbc;
+
+class TestCase_Core_Coro_Coro : public LLBC_BaseTestCase
+{
+public:
+    TestCase_Core_Coro_Coro();
+    virtual ~TestCase_Core_Coro_Coro();
+
+public:
+    virtual int Run(int argc, char *argv[]);
+
+private:
+    void FetchArgs(int argc, char *argv[]);
+
+    /**
+     * Test coroutine state, resume/suspend, nested coroutine and illegal operations.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    int TestBasic();
+
+    /**
+     * Test coroutine context switch cost.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    int TestSwitchCost();
+
+    /**
+     * Test massive suspended coroutines memory cost.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    int TestMemory();
+
+private:
+    int _switchTimes;
+    int _coroCount;
+};
+
+#endif // !__LLBC_TEST_CASE_CORE_CORO_CORO_H__
@@ -0,0 +1,280 @@
+/**
+ * @file    TestCase_Core_Thread_MsgQueue.cpp
+ * @author  Longwei Lai<lailongwei@126.com>
+ * @date    2026/10/18
+ * @version 1.0
+ *
+ * @brief
+ */
+
+#include "core/thread/TestCase_Core_Thread_MsgQueue.h"
+
+namespace
+{
+
+const char *__modeNames[] = {"Locked", "MPSC", "SPSC"};
+
+class ConsumerTask : public LLBC_BaseTask
+{
+public:
+    ConsumerTask(int expected, bool latencyBench)
+    : _expected(expected)
+    , _latencyBench(latencyBench)
+
+    , _endTime(0)
+    {
+        _blocks.reserve(expected);
+        if (_latencyBench)
+            _latencies.reserve(expected);
+    }
+
+    virtual ~ConsumerTask()
+    {
+        for (size_t i = 0; i < _blocks.size(); i++)
+            LLBC_Delete(_blocks[i]);
+    }
+
+public:
+    virtual void Svc()
+    {
+        sint64 lastRecvTime = LLBC_GetMilliSeconds();
+        while (static_cast<int>(_blocks.size()) < _expected)
+        {
+            LLBC_MessageBlock *block;
+            if (TimedPop(block, 100) != LLBC_OK)
+            {
+                // Avoid dead wait if any message lost.
+                if (LLBC_GetMilliSeconds() - lastRecvTime > 5000)
+                    break;
+
+                continue;
+            }
+
+            if (_latencyBench)
+                _latencies.push_back(LLBC_GetMicroSeconds() -
+                    *reinterpret_cast<sint64 *>(block->GetData()));
+
+            _blocks.push_back(block);
+            lastRecvTime = LLBC_GetMilliSeconds();
+        }
+
+        _endTime = LLBC_GetMicroSeconds();
+    }
+
+    virtual void Cleanup()
+    {
+    }
+
+public:
+    int GetReceived() const
+    {
+        return static_cast<int>(_blocks.size());
+    }
+
+    sint64 GetEndTime() const
+    {
+        return _endTime;
+    }
+
+    std::vector<sint64> &GetLatencies()
+    {
+        return _latencies;
+    }
+
+private:
+    int _expected;
+    bool _latencyBench;
+
+    sint64 _endTime;
+    std::vector<LLBC_MessageBlock *> _blocks;
+    std::vector<sint64> _latencies;
+};
+
+class ProducerTask : public LLBC_BaseTask
+{
+public:
+    ProducerTask(ConsumerTask *consumer,
+                 int producerCount,
+                 int perProducerCount,
+                 int latencyPushInterval)
+    : _consumer(consumer)
+    , _perProducerCount(perProducerCount)
+    , _latencyPushInterval(latencyPushInterval)
+
+    , _nextIdx(0)
+    , _started(false)
+    , _beginTime(0)
+    {
+        // Prepare all blocks before benchmark, benchmark not count block allocation.
+        _blocks.resize(producerCount);
+        for (int i = 0; i < producerCount; i++)
+        {
+            for (int j = 0; j < perProducerCount; j++)
+                _blocks[i].push_back(new LLBC_MessageBlock(sizeof(sint64)));
+        }
+    }
+
+public:
+    virtual void Svc()
+    {
+        std::vector<LLBC_MessageBlock *> &blocks =
+            _blocks[LLBC_AtomicFetchAndAdd(&_nextIdx, 1)];
+        while (!_started)
+            LLBC_Sleep(0);
+
+        sint64 lastPushTime = 0;
+        for (int i = 0; i < _perProducerCount; i++)
+        {
+            LLBC_MessageBlock *block = blocks[i];
+            if (_latencyPushInterval > 0)
+            {
+                // Pace pushes(yield cpu), let consumer drain queue and go to wait state.
+                sint64 now;
+                while ((now = LLBC_GetMicroSeconds()) - lastPushTime < _latencyPushInterval)
+                    LLBC_Sleep(0);
+
+                lastPushTime = now;
+                block->Write(&now, sizeof(now));
+            }
+
+            _consumer->Push(block);
+        }
+    }
+
+    virtual void Cleanup()
+    {
+    }
+
+public:
+    void Start()
+    {
+        _beginTime = LLBC_GetMicroSeconds();
+        _started = true;
+    }
+
+    sint64 GetBeginTime() const
+    {
+        return _beginTime;
+    }
+
+private:
+    ConsumerTask *_consumer;
+    int _perProducerCount;
+    int _latencyPushInterval;
+
+    volatile sint32 _nextIdx;
+    volatile bool _started;
+    sint64 _beginTime;
+    std::vector<std::vector<LLBC_MessageBlock *> > _blocks;
+};
+
+}
+
+TestCase_Core_Thread_MsgQueue::TestCase_Core_Thread_MsgQueue()
+: _maxProducerCount(16)
+, _throughputMsgCount(1000000)
+, _latencyMsgCount(20000)
+, _latencyPushInterval(50)
+{
+}
+
+TestCase_Core_Thread_MsgQueue::~TestCase_Core_Thread_MsgQueue()
+{
+}
+
+int TestCase_Core_Thread_MsgQueue::Run(int argc, char *argv[])
+{
+    LLBC_PrintLine("core/thread/task message queue modes benchmark:");
+    LLBC_PrintLine("  usage: ./a [maxProducerCount] [throughputMsgCount] [latencyMsgCount] [latencyPushInterval(us)]");
+
+    FetchArgs(argc, argv);
+
+    const int modes[] = {LLBC_MessageQueueMode::Locked,
+                         LLBC_MessageQueueMode::MPSC,
+                         LLBC_MessageQueueMode::SPSC};
+    for (size_t i = 0; i < sizeof(modes) / sizeof(modes[0]); i++)
+    {
+        // SPSC mode only support single producer.
+        const int maxProducerCount =
+            modes[i] == LLBC_MessageQueueMode::SPSC ? 1 : _maxProducerCount;
+        for (int producerCount = 1; producerCount <= maxProducerCount; producerCount *= 2)
+        {
+            if (RunBench(modes[i], producerCount, false) != LLBC_OK ||
+                RunBench(modes[i], producerCount, true) != LLBC_OK)
+                return LLBC_FAILED;
+        }
+    }
+
+    return LLBC_OK;
+}
+
+void TestCase_Core_Thread_MsgQueue::FetchArgs(int argc, char *argv[])
+{
+    if (argc > 1)
+        _maxProducerCount = MAX(LLBC_Str2Int32(argv[1]), 1);
+    if (argc > 2)
+        _throughputMsgCount = MAX(LLBC_Str2Int32(argv[2]), 1);
+    if (argc > 3)
+        _latencyMsgCount = MAX(LLBC_Str2Int32(argv[3]), 1);
+    if (argc > 4)
+        _latencyPushInterval = MAX(LLBC_Str2Int32(argv[4]), 1);
+}
+
+int TestCase_Core_Thread_MsgQueue::RunBench(int mode, int producerCount, bool latencyBench)
+{
+    const int perProducerCount =
+        (latencyBench ? _latencyMsgCount : _throughputMsgCount) / producerCount;
+    const int totalCount = perProducerCount * producerCount;
+
+    ConsumerTask *consumer = new ConsumerTask(totalCount, latencyBench);
+    consumer->SetMsgQueueMode(mode);
+    ProducerTask *producer = new ProducerTask(consumer,
+                                              producerCount,
+                                              perProducerCount,
+                                              latencyBench ? _latencyPushInterval * producerCount : 0);
+
+    if (consumer->Activate(1) != LLBC_OK ||
+        producer->Activate(producerCount) != LLBC_OK)
+    {
+        LLBC_FilePrintLine(stderr, "Activate tasks failed, err: %s", LLBC_FormatLastError());
+        return LLBC_FAILED;
+    }
+
+    producer->Start();
+
+    producer->Wait();
+    consumer->Wait();
+
+    const int received = consumer->GetReceived();
+    const sint64 elapsed = MAX(consumer->GetEndTime() - producer->GetBeginTime(), 1);
+    if (!latencyBench)
+    {
+        LLBC_PrintLine("[throughput] mode: %-6s, producers: %2d, messages: %d/%d, elapsed: %.3f ms, throughput: %.3f M msgs/s",
+                       __modeNames[mode],
+                       producerCount,
+                       received,
+                       totalCount,
+                       elapsed / 1000.0,
+                       received / static_cast<double>(elapsed));
+    }
+    else
+    {
+        std::vector<sint64> &latencies = consumer->GetLatencies();
+        std::sort(latencies.begin(), latencies.end());
+
+        const size_t count = latencies.size();
+        LLBC_PrintLine("[latency]    mode: %-6s, producers: %2d, messages: %d/%d, p50: %lld us, p99: %lld us, max: %lld us",
+                       __modeNames[mode],
+                       producerCount,
+                       received,
+                       totalCount,
+                       count > 0 ? latencies[count / 2] : 0,
+                       count > 0 ? latencies[count * 99 / 100] : 0,
+                       count > 0 ? latencies[count - 1] : 0);
+    }
+
+    delete producer;
+    delete consumer;
+
+    return received == totalCount ? LLBC_OK : LLBC_FAILED;
+}
@@ -0,0 +1,36 @@
+/**
+ * @file    TestCase_Core_Thread_MsgQueue.h
+ * @author  Longwei Lai<lailongwei@126.com>
+ * @date    2026/10/18
+ * @version 1.0
+ *
+ * @brief   The llbc library task message queue modes throughput/latency benchmark test case.
+ */
+#ifndef __LLBC_TEST_CASE_CORE_THREAD_MSG_QUEUE_H__
+#define __LLBC_TEST_CASE_CORE_THREAD_MSG_QUEUE_H__
+
+#include "llbc.h"
+using namespace llbc;
+
+class TestCase_Core_Thread_MsgQueue : public LLBC_BaseTestCase
+{
+public:
+    TestCase_Core_Thread_MsgQueue();
+    virtual ~TestCase_Core_Thread_MsgQueue();
+
+public:
+    virtual int Run(int argc, char *argv[]);
+
+private:
+    void FetchArgs(int argc, char *argv[]);
+
+    int RunBench(int mode, int producerCount, bool latencyBench);
+
+private:
+    int _maxProducerCount;
+    int _throughputMsgCount;
+    int _latencyMsgCount;
+    int _latencyPushInterval;
+};
+
+#endif // !__LLBC_TEST_CASE_CORE_THREAD_MSG_QUEUE_H__
@@ -50,6 +50,42 @@ void TestCase_Core_Time_Time::OSTimeTest()
     gettimeofday(&tv, NULL);
     std::cout <<"WIN32 spec: gettimeofday(), tv_sec: " <<tv.tv_sec <<", tv_usec: " <<tv.tv_usec <<std::endl;
 #endif
+
+    // Monotonic time test.
+    std::cout <<"LLBC_GetMonoMilliSeconds(): " <<LLBC_GetMonoMilliSeconds() <<std::endl;
+    std::cout <<"LLBC_GetMonoMicroSeconds(): " <<LLBC_GetMonoMicroSeconds() <<std::endl;
+
+    // Cached monotonic time test.
+    const sint64 cachedTime = LLBC_CacheMonoMilliSeconds();
+    LLBC_Sleep(20);
+    std::cout <<"After cached and sleep 20ms, cached time elapsed: "
+        <<LLBC_GetCachedMonoMilliSeconds() - cachedTime <<"(expect 0)" <<std::endl;
+    LLBC_UncacheMonoMilliSeconds();
+    std::cout <<"After uncached, cached time elapsed: "
+        <<LLBC_GetCachedMonoMilliSeconds() - cachedTime <<"(expect >= 20)" <<std::endl;
+
+    // Clock read cost test.
+    const int readTimes = 1000000;
+    volatile sint64 readTime = 0;
+    sint64 begTime = LLBC_GetMonoMicroSeconds();
+    for (int i = 0; i < readTimes; i++)
+        readTime = LLBC_GetMilliSeconds();
+    std::cout <<"LLBC_GetMilliSeconds() cost: "
+        <<(LLBC_GetMonoMicroSeconds() - begTime) * 1000.0 / readTimes <<" ns" <<std::endl;
+
+    begTime = LLBC_GetMonoMicroSeconds();
+    for (int i = 0; i < readTimes; i++)
+        readTime = LLBC_GetMonoMilliSeconds();
+    std::cout <<"LLBC_GetMonoMilliSeconds() cost: "
+        <<(LLBC_GetMonoMicroSeconds() - begTime) * 1000.0 / readTimes <<" ns" <<std::endl;
+
+    LLBC_CacheMonoMilliSeconds();
+    begTime = LLBC_GetMonoMicroSeconds();
+    for (int i = 0; i < readTimes; i++)
+        readTime = LLBC_GetCachedMonoMilliSeconds();
+    std::cout <<"LLBC_GetCachedMonoMilliSeconds() cost: "
+        <<(LLBC_GetMonoMicroSeconds() - begTime) * 1000.0 / readTimes <<" ns" <<std::endl;
+    LLBC_UncacheMonoMilliSeconds();
 }
 
 void TestCase_Core_Time_Time::TimeClassTest()
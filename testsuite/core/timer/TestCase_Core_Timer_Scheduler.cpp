@@ -0,0 +1,372 @@
+/**
+ * @file    TestCase_Core_Timer_Scheduler.cpp
+ * @author  Longwei Lai<lailongwei@126.com>
+ * @date    2026/10/18
+ * @version 1.0
+ *
+ * @brief
+ */
+
+#include "core/timer/TestCase_Core_Timer_Scheduler.h"
+
+namespace
+{
+
+const char *GetSchedulerTypeName(LLBC_TimerScheduler::Type type)
+{
+    return type == LLBC_TimerScheduler::TimingWheel ? "TimingWheel" : "BinaryHeap";
+}
+
+/**
+ * The probe timer, record timeout times and lateness.
+ */
+class ProbeTimer : public LLBC_Timer
+{
+public:
+    ProbeTimer(LLBC_TimerScheduler *scheduler, bool oneShot)
+    : LLBC_Timer(NULL, NULL, scheduler)
+    , _oneShot(oneShot)
+    , _rescheduleTimes(0)
+    , _sibling(NULL)
+
+    , _expectedTime(0)
+    , _timeouts(0)
+    , _cancels(0)
+    , _earlies(0)
+    , _maxLateness(0)
+    {
+    }
+
+public:
+    void Start(uint64 dueTime, uint64 period = 0)
+    {
+        _expectedTime = LLBC_GetMonoMilliSeconds() + dueTime;
+        Schedule(dueTime, period);
+    }
+
+    void SetRescheduleTimes(int rescheduleTimes)
+    {
+        _rescheduleTimes = rescheduleTimes;
+    }
+
+    void SetSibling(ProbeTimer *sibling)
+    {
+        _sibling = sibling;
+    }
+
+public:
+    virtual void OnTimeout()
+    {
+        const sint64 now = LLBC_GetMonoMilliSeconds();
+        if (now < _expectedTime)
+            _earlies += 1;
+        else
+            _maxLateness = MAX(_maxLateness, now - _expectedTime);
+
+        _timeouts += 1;
+        _expectedTime += GetPeriod();
+
+        // Cancel the sibling timer which maybe in same bucket.
+        if (_sibling)
+            _sibling->Cancel();
+
+        if (_rescheduleTimes > 0)
+        {
+            _rescheduleTimes -= 1;
+            Start(GetDueTime());
+        }
+        else if (_oneShot)
+        {
+            Cancel();
+        }
+    }
+
+    virtual void OnCancel()
+    {
+        _cancels += 1;
+    }
+
+public:
+    int GetTimeouts() const
+    {
+        return _timeouts;
+    }
+
+    int GetCancels() const
+    {
+        return _cancels;
+    }
+
+    int GetEarlies() const
+    {
+        return _earlies;
+    }
+
+    sint64 GetMaxLateness() const
+    {
+        return _maxLateness;
+    }
+
+private:
+    const bool _oneShot;
+    int _rescheduleTimes;
+    ProbeTimer *_sibling;
+
+    sint64 _expectedTime;
+    int _timeouts;
+    int _cancels;
+    int _earlies;
+    sint64 _maxLateness;
+};
+
+/**
+ * The churn timer, do nothing when timeout.
+ */
+class ChurnTimer : public LLBC_Timer
+{
+public:
+    ChurnTimer(LLBC_TimerScheduler *scheduler)
+    : LLBC_Timer(NULL, NULL, scheduler)
+    {
+    }
+
+public:
+    virtual void OnTimeout()
+    {
+    }
+};
+
+}
+
+TestCase_Core_Timer_Scheduler::TestCase_Core_Timer_Scheduler()
+: _timerCount(500000)
+, _churnTimes(3)
+{
+}
+
+TestCase_Core_Timer_Scheduler::~TestCase_Core_Timer_Scheduler()
+{
+}
+
+int TestCase_Core_Timer_Scheduler::Run(int argc, char *argv[])
+{
+    LLBC_PrintLine("Timer scheduler test:");
+    LLBC_PrintLine("  usage: ./a [timerCount] [churnTimes]");
+
+    FetchArgs(argc, argv);
+
+    if (TestSchedule(LLBC_TimerScheduler::BinaryHeap) != LLBC_OK ||
+        TestSchedule(LLBC_TimerScheduler::TimingWheel) != LLBC_OK)
+        return LLBC_FAILED;
+
+    sint64 heapElapsed, wheelElapsed;
+    if (TestChurn(LLBC_TimerScheduler::BinaryHeap, heapElapsed) != LLBC_OK ||
+        TestChurn(LLBC_TimerScheduler::TimingWheel, wheelElapsed) != LLBC_OK)
+        return LLBC_FAILED;
+
+    LLBC_PrintLine("[compare] churn elapsed, BinaryHeap: %.3f ms, TimingWheel: %.3f ms, speedup: %.2fx",
+                   heapElapsed / 1000.0,
+                   wheelElapsed / 1000.0,
+                   heapElapsed / static_cast<double>(MAX(wheelElapsed, 1)));
+
+    return LLBC_OK;
+}
+
+void TestCase_Core_Timer_Scheduler::FetchArgs(int argc, char *argv[])
+{
+    if (argc > 1)
+        _timerCount = MAX(LLBC_Str2Int32(argv[1]), 1);
+    if (argc > 2)
+        _churnTimes = MAX(LLBC_Str2Int32(argv[2]), 0);
+}
+
+int TestCase_Core_Timer_Scheduler::TestSchedule(LLBC_TimerScheduler::Type type)
+{
+    LLBC_TimerScheduler *scheduler = LLBC_New1(LLBC_TimerScheduler, type);
+    if (scheduler->GetType() != type)
+    {
+        LLBC_Delete(scheduler);
+        return LLBC_FAILED;
+    }
+
+    // One-shot timers, spread in level 0 & level 1 buckets, cancel every 4th timer immediately.
+    const int oneShotCount = 1000;
+    std::vector<ProbeTimer *> oneShotTimers;
+    for (int i = 0; i < oneShotCount; i++)
+    {
+        ProbeTimer *timer = LLBC_New2(ProbeTimer, scheduler, true);
+        timer->Start(LLBC_Random::RandInt32cmcn(1, 1000));
+        if (i % 4 == 0)
+            timer->Cancel();
+
+        oneShotTimers.push_back(timer);
+    }
+
+    // Period timers.
+    const int periodCount = 10;
+    std::vector<ProbeTimer *> periodTimers;
+    for (int i = 0; i < periodCount; i++)
+    {
+        ProbeTimer *timer = LLBC_New2(ProbeTimer, scheduler, false);
+        timer->Start(100, 100);
+
+        periodTimers.push_back(timer);
+    }
+
+    // Sibling timers in same bucket, the first timeout one cancel the other one.
+    ProbeTimer *sibling1 = LLBC_New2(ProbeTimer, scheduler, true);
+    ProbeTimer *sibling2 = LLBC_New2(ProbeTimer, scheduler, true);
+    sibling1->SetSibling(sibling2);
+    sibling2->SetSibling(sibling1);
+    sibling1->Start(300);
+    sibling2->Start(300);
+
+    // Reschedule in timeout handler.
+    ProbeTimer *rescheduleTimer = LLBC_New2(ProbeTimer, scheduler, true);
+    rescheduleTimer->SetRescheduleTimes(2);
+    rescheduleTimer->Start(200);
+
+    // Long timers, cancel them before timeout.
+    std::vector<ProbeTimer *> longTimers;
+    for (int i = 0; i < 100; i++)
+    {
+        ProbeTimer *timer = LLBC_New2(ProbeTimer, scheduler, true);
+        timer->Start(i % 2 == 0 ? 3600 * 1000 : LLBC_CFG_CORE_TIMER_LONG_TIMEOUT_TIME + 1);
+
+        longTimers.push_back(timer);
+    }
+
+    // Nearest timeout time not later than the nearest timer.
+    const sint64 nextTimeoutTime = scheduler->GetNextTimeoutTime();
+    const bool nextTimeoutOk = nextTimeoutTime > 0 && nextTimeoutTime <= LLBC_GetMonoMilliSeconds() + 1000;
+
+    const size_t timerCount = scheduler->GetTimerCount();
+    for (size_t i = 0; i < longTimers.size(); i++)
+        longTimers[i]->Cancel();
+    const size_t cancelledLongTimerCount = scheduler->GetTimerCount();
+
+    const sint64 begTime = LLBC_GetMonoMilliSeconds();
+    while (LLBC_GetMonoMilliSeconds() - begTime < 1550)
+    {
+        scheduler->Update();
+        LLBC_Sleep(1);
+    }
+
+    int badOneShots = 0, earlies = 0;
+    sint64 maxLateness = 0;
+    for (int i = 0; i < oneShotCount; i++)
+    {
+        ProbeTimer *timer = oneShotTimers[i];
+        if (timer->GetTimeouts() != (i % 4 == 0 ? 0 : 1) ||
+            timer->GetCancels() != 1)
+            badOneShots += 1;
+
+        earlies += timer->GetEarlies();
+        maxLateness = MAX(maxLateness, timer->GetMaxLateness());
+    }
+
+    int badPeriods = 0;
+    for (int i = 0; i < periodCount; i++)
+    {
+        ProbeTimer *timer = periodTimers[i];
+        if (timer->GetTimeouts() < 13 || timer->GetTimeouts() > 16)
+            badPeriods += 1;
+
+        earlies += timer->GetEarlies();
+    }
+
+    const bool siblingOk = sibling1->GetTimeouts() + sibling2->GetTimeouts() == 1 &&
+                           sibling1->GetCancels() == 1 &&
+                           sibling2->GetCancels() == 1;
+    const bool rescheduleOk = rescheduleTimer->GetTimeouts() == 3 &&
+                              rescheduleTimer->GetEarlies() == 0;
+
+    int badLongTimers = 0;
+    for (size_t i = 0; i < longTimers.size(); i++)
+    {
+        if (longTimers[i]->GetTimeouts() != 0 || longTimers[i]->GetCancels() != 1)
+            badLongTimers += 1;
+    }
+
+    LLBC_PrintLine("[schedule] type: %-11s, timer count: %lu, after long timers cancelled: %lu, "
+                   "bad one-shots: %d, bad periods: %d, sibling: %s, reschedule: %s, bad long timers: %d, "
+                   "next timeout: %s, early timeouts: %d, max lateness: %lld ms",
+                   GetSchedulerTypeName(type),
+                   timerCount,
+                   cancelledLongTimerCount,
+                   badOneShots,
+                   badPeriods,
+                   siblingOk ? "ok" : "failed",
+                   rescheduleOk ? "ok" : "failed",
+                   badLongTimers,
+                   nextTimeoutOk ? "ok" : "failed",
+                   earlies,
+                   maxLateness);
+
+    // Timing wheel removes cancelled timers immediately.
+    const bool succeed = badOneShots == 0 &&
+                         badPeriods == 0 &&
+                         siblingOk &&
+                         rescheduleOk &&
+                         badLongTimers == 0 &&
+                         nextTimeoutOk &&
+                         earlies == 0 &&
+                         (type != LLBC_TimerScheduler::TimingWheel ||
+                            cancelledLongTimerCount + longTimers.size() == timerCount);
+
+    // Delete scheduler before timers, period timers will be cancelled by scheduler.
+    LLBC_Delete(scheduler);
+
+    LLBC_STLHelper::DeleteContainer(oneShotTimers);
+    LLBC_STLHelper::DeleteContainer(periodTimers);
+    LLBC_STLHelper::DeleteContainer(longTimers);
+    LLBC_Delete(sibling1);
+    LLBC_Delete(sibling2);
+    LLBC_Delete(rescheduleTimer);
+
+    return succeed ? LLBC_OK : LLBC_FAILED;
+}
+
+int TestCase_Core_Timer_Scheduler::TestChurn(LLBC_TimerScheduler::Type type, sint64 &elapsed)
+{
+    LLBC_TimerScheduler *scheduler = LLBC_New1(LLBC_TimerScheduler, type);
+
+    std::vector<ChurnTimer *> timers;
+    timers.reserve(_timerCount);
+    for (int i = 0; i < _timerCount; i++)
+        timers.push_back(LLBC_New1(ChurnTimer, scheduler));
+
+    // Schedule buff/cooldown like timers(1s ~ 1h), and reschedule them churnTimes.
+    const sint64 begTime = LLBC_GetMicroSeconds();
+    for (int churn = 0; churn <= _churnTimes; churn++)
+    {
+        for (int i = 0; i < _timerCount; i++)
+            timers[i]->Schedule(LLBC_Random::RandInt32cmcn(1000, 3600 * 1000));
+
+        scheduler->Update();
+    }
+
+    const size_t timerCount = scheduler->GetTimerCount();
+    for (int i = 0; i < _timerCount; i++)
+        timers[i]->Cancel();
+
+    scheduler->Update();
+    elapsed = MAX(LLBC_GetMicroSeconds() - begTime, 1);
+
+    LLBC_PrintLine("[churn] type: %-11s, timers: %d, churn times: %d, timer count(before/after cancel): %lu/%lu, "
+                   "elapsed: %.3f ms",
+                   GetSchedulerTypeName(type),
+                   _timerCount,
+                   _churnTimes,
+                   timerCount,
+                   scheduler->GetTimerCount(),
+                   elapsed / 1000.0);
+
+    const bool succeed = type != LLBC_TimerScheduler::TimingWheel ||
+                         (timerCount == static_cast<size_t>(_timerCount) && scheduler->GetTimerCount() == 0);
+
+    LLBC_STLHelper::DeleteContainer(timers);
+    LLBC_Delete(scheduler);
+
+    return succeed ? LLBC_OK : LLBC_FAILED;
+}
@@ -0,0 +1,47 @@
+/**
+ * @file    TestCase_Core_Timer_Scheduler.h
+ * @author  Longwei Lai<lailongwei@126.com>
+ * @date    2026/10/18
+ * @version 1.0
+ *
+ * @brief   The llbc library timer scheduler(binary heap & timing wheel) test case.
+ */
+#ifndef __LLBC_TEST_CASE_CORE_TIMER_SCHEDULER_H__
+#define __LLBC_TEST_CASE_CORE_TIMER_SCHEDULER_H__
+
+#include "llbc.h"
+using namespace llbc;
+
+class TestCase_Core_Timer_Scheduler : public LLBC_BaseTestCase
+{
+public:
+    TestCase_Core_Timer_Scheduler();
+    virtual ~TestCase_Core_Timer_Scheduler();
+
+public:
+    virtual int Run(int argc, char *argv[]);
+
+private:
+    void FetchArgs(int argc, char *argv[]);
+
+    /**
+     * Test timers timeout time, period, cancel and reschedule in timeout handler.
+     * @param[in] type - the scheduler type.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    int TestSchedule(LLBC_TimerScheduler::Type type);
+
+    /**
+     * Test massive long timers schedule/cancel churn performance.
+     * @param[in]  type    - the scheduler type.
+     * @param[out] elapsed - the elapsed time, in micro-seconds.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    int TestChurn(LLBC_TimerScheduler::Type type, sint64 &elapsed);
+
+private:
+    int _timerCount;
+    int _churnTimes;
+};
+
+#endif // !__LLBC_TEST_CASE_CORE_TIMER_SCHEDULER_H__
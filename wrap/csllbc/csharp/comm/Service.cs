@@ -81,6 +81,7 @@ namespace llbc
     {
         SelfDrive,
         ExternalDrive,
+        EventDrive,
     }
     #endregion
 